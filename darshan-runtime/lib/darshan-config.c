@@ -79,6 +79,90 @@ static uint64_t darshan_module_csv_to_flags(char *mod_csv)
     return(mod_flags);
 }
 
+/* module id bit field of the DXT modules, which environment variable DXT
+ * settings apply to
+ */
+#define DARSHAN_DXT_MOD_FLAGS ((1ULL << DXT_POSIX_MOD) | (1ULL << DXT_MPIIO_MOD))
+
+/* names of DXT segment fields, in DXT_SEG_* flag order */
+static char *dxt_seg_field_names[] = {"offset", "length", "start", "end"};
+
+/* helper to convert csv of DXT segment field names to DXT_SEG_* flags */
+static uint32_t darshan_dxt_field_csv_to_flags(char *field_csv)
+{
+    char *tok;
+    int i;
+    int found;
+    uint32_t fields = 0;
+
+    tok = strtok(field_csv, ",");
+    while(tok != NULL)
+    {
+        found = 0;
+        for(i = 0; i < 4; i++)
+        {
+            if(strcmp(tok, dxt_seg_field_names[i]) == 0)
+            {
+                fields |= (1 << i);
+                found = 1;
+            }
+        }
+        if(!found)
+            darshan_core_fprintf(stderr, "darshan library warning: "\
+                "unknown DXT segment field \"%s\" in Darshan config field csv\n", tok);
+
+        tok = strtok(NULL, ",");
+    }
+
+    return(fields);
+}
+
+/* helper to convert a DXT time precision in seconds to the nanoseconds
+ * stored in a dxt_segment_format, returning -1 if it is out of range
+ */
+static int64_t darshan_dxt_precision_to_ns(double precision)
+{
+    int64_t ns;
+
+    if(precision < 0 || precision * 1e9 > UINT32_MAX)
+    {
+        darshan_core_fprintf(stderr, "darshan library warning: "\
+            "invalid DXT time precision %lf s\n", precision);
+        return(-1);
+    }
+    ns = (int64_t)(precision * 1e9 + 0.5);
+    if(ns == 0 && precision > 0)
+        ns = 1;
+
+    return(ns);
+}
+
+/* helper to set the segment fields (if nonzero) and time precision (if not
+ * negative) of the DXT modules in a module id bit field
+ */
+static void darshan_set_dxt_seg_format(struct darshan_config *cfg,
+    uint64_t mod_flags, uint32_t fields, int64_t time_res_ns)
+{
+    struct dxt_segment_format *formats[2];
+    int i;
+
+    formats[0] = DARSHAN_MOD_FLAG_ISSET(mod_flags, DXT_POSIX_MOD) ?
+        &cfg->dxt_posix_seg_format : NULL;
+    formats[1] = DARSHAN_MOD_FLAG_ISSET(mod_flags, DXT_MPIIO_MOD) ?
+        &cfg->dxt_mpiio_seg_format : NULL;
+    for(i = 0; i < 2; i++)
+    {
+        if(!formats[i])
+            continue;
+        if(fields)
+            formats[i]->fields = fields;
+        if(time_res_ns >= 0)
+            formats[i]->time_res_ns = time_res_ns;
+    }
+
+    return;
+}
+
 void darshan_init_config(struct darshan_config *cfg)
 {
     cfg->mod_mem = DARSHAN_MOD_MEM_MAX;
@@ -92,9 +176,11 @@ void darshan_init_config(struct darshan_config *cfg)
 #ifdef __DARSHAN_ENABLE_MMAP_LOGS
     cfg->mmap_log_path = strdup(DARSHAN_DEF_MMAP_LOG_PATH);
 #endif
-    /* enable all modules except DXT by default */
+    /* enable all modules except DXT, SNAPSHOT and IMBALANCE by default */
     DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DXT_POSIX_MOD);
     DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DXT_MPIIO_MOD);
+    DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_SNAPSHOT_MOD);
+    DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_IMBALANCE_MOD);
 #ifndef DARSHAN_BGQ
     DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_BGQ_MOD);
 #endif
@@ -113,9 +199,21 @@ void darshan_init_config(struct darshan_config *cfg)
 #endif
 #ifndef DARSHAN_USE_APMPI
     DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_APMPI_MOD);
+#endif
+#ifndef DARSHAN_PROCIO
+    DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_PROCIO_MOD);
+#endif
+#ifndef DARSHAN_NFS
+    DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_NFS_MOD);
+#endif
+#ifndef DARSHAN_CUSTOM
+    DARSHAN_MOD_FLAG_SET(cfg->mod_disabled, DARSHAN_CUSTOM_MOD);
 #endif
     cfg->exclude_dirs = darshan_path_exclusions;
     cfg->include_dirs = darshan_path_inclusions;
+    /* DXT records every segment field at full precision by default */
+    cfg->dxt_posix_seg_format.fields = DXT_SEG_ALL_FIELDS;
+    cfg->dxt_mpiio_seg_format.fields = DXT_SEG_ALL_FIELDS;
 
     return;
 }
@@ -129,6 +227,7 @@ void darshan_parse_config_env(struct darshan_config *cfg)
     int ret;
     struct darshan_core_regex *regex, *tmp_regex;
     uint64_t tmp_mod_flags;
+    uint32_t tmp_fields;
     int success;
 
     /* allow override of memory quota for darshan modules' records */
@@ -442,12 +541,34 @@ void darshan_parse_config_env(struct darshan_config *cfg)
             }
         }
     }
+    envstr = getenv("DARSHAN_DXT_FIELDS");
+    if(envstr)
+    {
+        string = strdup(envstr);
+        if(string)
+        {
+            tmp_fields = darshan_dxt_field_csv_to_flags(string);
+            darshan_set_dxt_seg_format(cfg, DARSHAN_DXT_MOD_FLAGS, tmp_fields, -1);
+            free(string);
+        }
+    }
+    envstr = getenv("DARSHAN_DXT_TIME_PRECISION");
+    if(envstr)
+    {
+        double precision;
+        DARSHAN_PARSE_NUMBER_FROM_STR(envstr, double, precision, success);
+        if(success)
+            darshan_set_dxt_seg_format(cfg, DARSHAN_DXT_MOD_FLAGS, 0,
+                darshan_dxt_precision_to_ns(precision));
+    }
     if(getenv("DARSHAN_DUMP_CONFIG"))
         cfg->dump_config_flag = 1;
     if(getenv("DARSHAN_INTERNAL_TIMING"))
         cfg->internal_timing_flag = 1;
     if(getenv("DARSHAN_DISABLE_SHARED_REDUCTION"))
         cfg->disable_shared_redux_flag = 1;
+    if(getenv("DARSHAN_DISABLE_LOG_CHECKSUMS"))
+        cfg->disable_log_checksums_flag = 1;
 
     /* apply disabled/enabled module flags */
     cfg->mod_disabled |= cfg->mod_disabled_flags;
@@ -465,6 +586,7 @@ void darshan_parse_config_file(struct darshan_config *cfg)
     char *key, *val, *mods;
     char *token;
     uint64_t tmp_mod_flags;
+    uint32_t tmp_fields;
     size_t tmpmax;
     struct darshan_core_regex *regex;
     int i;
@@ -823,12 +945,41 @@ void darshan_parse_config_file(struct darshan_config *cfg)
                     }
                 }
             }
+            else if(strcmp(key, "DXT_FIELDS") == 0)
+            {
+                val = strtok(NULL, " \t");
+                mods = strtok(NULL, " \t");
+                if(val && mods)
+                {
+                    tmp_fields = darshan_dxt_field_csv_to_flags(val);
+                    tmp_mod_flags = darshan_module_csv_to_flags(mods);
+                    darshan_set_dxt_seg_format(cfg, tmp_mod_flags, tmp_fields, -1);
+                }
+            }
+            else if(strcmp(key, "DXT_TIME_PRECISION") == 0)
+            {
+                double precision;
+                val = strtok(NULL, " \t");
+                DARSHAN_PARSE_NUMBER_FROM_STR(val, double, precision, success);
+                if(success)
+                {
+                    mods = strtok(NULL, " \t");
+                    if(mods)
+                    {
+                        tmp_mod_flags = darshan_module_csv_to_flags(mods);
+                        darshan_set_dxt_seg_format(cfg, tmp_mod_flags, 0,
+                            darshan_dxt_precision_to_ns(precision));
+                    }
+                }
+            }
             else if(strcmp(key, "DUMP_CONFIG") == 0)
                 cfg->dump_config_flag = 1;
             else if(strcmp(key, "INTERNAL_TIMING") == 0)
                 cfg->internal_timing_flag = 1;
             else if(strcmp(key, "DISABLE_SHARED_REDUCTION") == 0)
                 cfg->disable_shared_redux_flag = 1;
+            else if(strcmp(key, "DISABLE_LOG_CHECKSUMS") == 0)
+                cfg->disable_log_checksums_flag = 1;
             else
             {
                 darshan_core_fprintf(stderr, "darshan library warning: "\
@@ -851,7 +1002,8 @@ void darshan_dump_config(struct darshan_config *cfg)
     int tmp_index = 0;
     int first;
     struct darshan_core_regex *regex;
-    int i;
+    struct dxt_segment_format *seg_format;
+    int i, j;
 
     fprintf(stderr, "##########################\n");
     fprintf(stderr, "##### DARSHAN CONFIG #####\n");
@@ -915,6 +1067,8 @@ void darshan_dump_config(struct darshan_config *cfg)
         cfg->rank_exclusions : "NONE");
     fprintf(stderr, "# RANK_INCLUDE = %s\n", (cfg->rank_inclusions) ?
         cfg->rank_inclusions : "NONE");
+    fprintf(stderr, "# LOG_CHECKSUMS = %s\n",
+        cfg->disable_log_checksums_flag ? "DISABLED" : "ENABLED");
     if(cfg->small_io_trigger)
     {
         fprintf(stderr, "# DXT_SMALL_IO_TRIGGER = %.2lf\n",
@@ -937,6 +1091,24 @@ void darshan_dump_config(struct darshan_config *cfg)
         if(cfg->mod_max_records_override[i] > 0)
             fprintf(stderr, "#      - MAX_RECORDS = %lu\n",
                 cfg->mod_max_records_override[i]);
+        if(i == DXT_POSIX_MOD || i == DXT_MPIIO_MOD)
+        {
+            seg_format = (i == DXT_POSIX_MOD) ?
+                &cfg->dxt_posix_seg_format : &cfg->dxt_mpiio_seg_format;
+            fprintf(stderr, "#      - DXT_FIELDS = ");
+            first = 1;
+            for(j = 0; j < 4; j++)
+            {
+                if(!(seg_format->fields & (1 << j)))
+                    continue;
+                fprintf(stderr, "%s%s", first ? "" : ",", dxt_seg_field_names[j]);
+                first = 0;
+            }
+            fprintf(stderr, "\n");
+            if(seg_format->time_res_ns)
+                fprintf(stderr, "#      - DXT_TIME_PRECISION = %g s\n",
+                    seg_format->time_res_ns * 1e-9);
+        }
         if(cfg->rec_exclusion_list)
         {
             first = 1;
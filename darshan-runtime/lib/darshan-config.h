@@ -37,8 +37,11 @@ struct darshan_config
     char *rank_inclusions;
     struct dxt_trigger *small_io_trigger;
     struct dxt_trigger *unaligned_io_trigger;
+    struct dxt_segment_format dxt_posix_seg_format;
+    struct dxt_segment_format dxt_mpiio_seg_format;
     int internal_timing_flag;
     int disable_shared_redux_flag;
+    int disable_log_checksums_flag;
     int dump_config_flag;
 };
 
@@ -21,6 +21,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <inttypes.h>
 #include <pthread.h>
 #include <fcntl.h>
 #include <stdarg.h>
@@ -29,6 +30,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/vfs.h>
 #include <ctype.h>
 #include <regex.h>
@@ -80,6 +82,18 @@ extern void bgq_runtime_initialize();
 extern void apxc_runtime_initialize();
 #endif
 
+#ifdef DARSHAN_PROCIO
+extern void procio_runtime_initialize();
+#endif
+
+#ifdef DARSHAN_NFS
+extern void nfs_runtime_initialize();
+#endif
+
+#ifdef DARSHAN_IMBALANCE
+extern void imbalance_runtime_initialize();
+#endif
+
 /* array of init functions for modules which need to be statically
  * initialized by darshan at startup time
  */
@@ -90,6 +104,15 @@ void (*mod_static_init_fns[])(void) =
 #endif
 #ifdef DARSHAN_USE_APXC
     &apxc_runtime_initialize,
+#endif
+#ifdef DARSHAN_PROCIO
+    &procio_runtime_initialize,
+#endif
+#ifdef DARSHAN_NFS
+    &nfs_runtime_initialize,
+#endif
+#ifdef DARSHAN_IMBALANCE
+    &imbalance_runtime_initialize,
 #endif
     NULL
 };
@@ -141,7 +164,7 @@ static int darshan_log_write_header(
     darshan_core_log_fh log_fh, struct darshan_core_runtime *core);
 static int darshan_log_append(
     darshan_core_log_fh log_fh, struct darshan_core_runtime *core,
-    void *buf, int count, uint64_t *inout_off);
+    void *buf, int count, uint64_t *inout_off, uint32_t *out_crc);
 void darshan_log_close(
     darshan_core_log_fh log_fh);
 void darshan_log_finalize(
@@ -230,8 +253,11 @@ void darshan_core_initialize(int argc, char **argv)
         }
 #endif
 
-        /* set PID that initialized Darshan runtime */
+        /* set PID that initialized Darshan runtime, and the PID of the
+         * process that forked or spawned it
+         */
         init_core->pid = getpid();
+        init_core->ppid = getppid();
 
         /* parse any user-supplied runtime configuration of Darshan */
         /* NOTE: as the ordering implies, environment variables override any
@@ -416,6 +442,10 @@ void darshan_core_shutdown(int write_log)
     double mod1[DARSHAN_KNOWN_MODULE_COUNT] = {0};
     double mod2[DARSHAN_KNOWN_MODULE_COUNT] = {0};
     double header1 = 0, header2 = 0;
+    double shared1 = 0, shared2 = 0;
+    double redux1[DARSHAN_KNOWN_MODULE_COUNT] = {0};
+    double redux2[DARSHAN_KNOWN_MODULE_COUNT] = {0};
+    int64_t rec_mem = 0;
     double tm_end;
     int active_mods[DARSHAN_KNOWN_MODULE_COUNT] = {0};
     uint64_t gz_fp = 0;
@@ -488,8 +518,13 @@ void darshan_core_shutdown(int write_log)
     for(i = 0; i < DARSHAN_KNOWN_MODULE_COUNT; i++)
     {
         if(final_core->mod_array[i])
+        {
             active_mods[i] = 1;
+            rec_mem += final_core->mod_array[i]->rec_buf_p -
+                final_core->mod_array[i]->rec_buf_start;
+        }
     }
+    rec_mem += final_core->name_mem_used;
 
 #ifdef HAVE_MPI
     if(using_mpi)
@@ -525,7 +560,11 @@ void darshan_core_shutdown(int write_log)
         PMPI_Op_free(&ts_max_op);
 
         /* get a list of records which are shared across all processes */
+        if(internal_timing_flag)
+            shared1 = darshan_core_wtime_absolute();
         darshan_get_shared_records(final_core, &shared_recs, &shared_rec_cnt);
+        if(internal_timing_flag)
+            shared2 = darshan_core_wtime_absolute();
 
         mod_shared_recs = malloc(shared_rec_cnt * sizeof(darshan_record_id));
         assert(mod_shared_recs);
@@ -550,6 +589,22 @@ void darshan_core_shutdown(int write_log)
         }
     }
 
+    /* in non-MPI mode, also save our own PID and our parent's PID in the log
+     * metadata, so that the process tree of a workflow made of forked and
+     * spawned processes can be reconstructed from its logs
+     */
+    if(!using_mpi)
+    {
+        meta_remain = DARSHAN_JOB_METADATA_LEN -
+            strlen(final_core->log_job_p->metadata) - 1;
+        if(meta_remain >= 32) // 32 bytes enough for meta strings + max PIDs (10 chars)
+        {
+            m = final_core->log_job_p->metadata +
+                strlen(final_core->log_job_p->metadata);
+            sprintf(m, "pid=%d\nppid=%d\n", final_core->pid, final_core->ppid);
+        }
+    }
+
     /* get the log file name */
     darshan_get_logfile_name(logfile_name, final_core);
     if(strlen(logfile_name) == 0)
@@ -593,6 +648,9 @@ void darshan_core_shutdown(int write_log)
         dxt_posix_apply_trace_filter(final_core->config.small_io_trigger);
     if(final_core->config.unaligned_io_trigger)
         dxt_posix_apply_trace_filter(final_core->config.unaligned_io_trigger);
+    /* and to encode trace segments with the configured fields and precision */
+    dxt_set_segment_format(DXT_POSIX_MOD, &final_core->config.dxt_posix_seg_format);
+    dxt_set_segment_format(DXT_MPIIO_MOD, &final_core->config.dxt_mpiio_seg_format);
 
     /* loop over globally used darshan modules and:
      *      - get final output buffer
@@ -654,8 +712,12 @@ void darshan_core_shutdown(int write_log)
                     if(!final_core->config.disable_shared_redux_flag ||
                        (i == DARSHAN_HEATMAP_MOD))
                     {
+                        if(internal_timing_flag)
+                            redux1[i] = darshan_core_wtime_absolute();
                         this_mod->mod_funcs.mod_redux_func(mod_buf, final_core->mpi_comm,
                             mod_shared_recs, mod_shared_rec_cnt);
+                        if(internal_timing_flag)
+                            redux2[i] = darshan_core_wtime_absolute();
                     }
                 }
             }
@@ -667,7 +729,8 @@ void darshan_core_shutdown(int write_log)
 
         /* append this module's data to the darshan log */
         final_core->log_hdr_p->mod_map[i].off = gz_fp;
-        ret = darshan_log_append(log_fh, final_core, mod_buf, mod_buf_sz, &gz_fp);
+        ret = darshan_log_append(log_fh, final_core, mod_buf, mod_buf_sz, &gz_fp,
+            &final_core->log_hdr_p->checksums.mod[i]);
         final_core->log_hdr_p->mod_map[i].len =
             gz_fp - final_core->log_hdr_p->mod_map[i].off;
 
@@ -699,6 +762,12 @@ void darshan_core_shutdown(int write_log)
         double job_tm;
         double rec_tm;
         double mod_tm[DARSHAN_KNOWN_MODULE_COUNT];
+        double redux_tm[DARSHAN_KNOWN_MODULE_COUNT];
+        /* shared record detection, deflate, and log append times */
+        double phase_tm[3];
+        /* peak resident set size and record memory, in bytes */
+        int64_t mem_hwm[2];
+        struct rusage ru;
         double all_tm;
 
         tm_end = darshan_core_wtime_absolute();
@@ -711,7 +780,15 @@ void darshan_core_shutdown(int write_log)
         for(i = 0; i < DARSHAN_KNOWN_MODULE_COUNT; i++)
         {
             mod_tm[i] = mod2[i] - mod1[i];
+            redux_tm[i] = redux2[i] - redux1[i];
         }
+        phase_tm[0] = shared2 - shared1;
+        phase_tm[1] = final_core->deflate_time;
+        phase_tm[2] = final_core->append_time;
+        /* ru_maxrss is reported in kilobytes on Linux */
+        getrusage(RUSAGE_SELF, &ru);
+        mem_hwm[0] = (int64_t)ru.ru_maxrss * 1024;
+        mem_hwm[1] = rec_mem;
 
 #ifdef HAVE_MPI
         if(using_mpi)
@@ -730,6 +807,12 @@ void darshan_core_shutdown(int write_log)
                     MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
                 PMPI_Reduce(MPI_IN_PLACE, mod_tm, DARSHAN_KNOWN_MODULE_COUNT,
                     MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
+                PMPI_Reduce(MPI_IN_PLACE, redux_tm, DARSHAN_KNOWN_MODULE_COUNT,
+                    MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
+                PMPI_Reduce(MPI_IN_PLACE, phase_tm, 3,
+                    MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
+                PMPI_Reduce(MPI_IN_PLACE, mem_hwm, 2,
+                    MPI_INT64_T, MPI_MAX, 0, final_core->mpi_comm);
             }
             else
             {
@@ -745,6 +828,12 @@ void darshan_core_shutdown(int write_log)
                     MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
                 PMPI_Reduce(mod_tm, mod_tm, DARSHAN_KNOWN_MODULE_COUNT,
                     MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
+                PMPI_Reduce(redux_tm, redux_tm, DARSHAN_KNOWN_MODULE_COUNT,
+                    MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
+                PMPI_Reduce(phase_tm, phase_tm, 3,
+                    MPI_DOUBLE, MPI_MAX, 0, final_core->mpi_comm);
+                PMPI_Reduce(mem_hwm, mem_hwm, 2,
+                    MPI_INT64_T, MPI_MAX, 0, final_core->mpi_comm);
 
                 /* let rank 0 report the timing info */
                 goto cleanup;
@@ -757,13 +846,25 @@ void darshan_core_shutdown(int write_log)
         darshan_core_fprintf(stderr, "darshan:job_write\t%d\t%f\n", nprocs, job_tm);
         darshan_core_fprintf(stderr, "darshan:hash_write\t%d\t%f\n", nprocs, rec_tm);
         darshan_core_fprintf(stderr, "darshan:header_write\t%d\t%f\n", nprocs, header_tm);
+        darshan_core_fprintf(stderr, "darshan:shared_rec_detect\t%d\t%f\n", nprocs, phase_tm[0]);
         for(i = 0; i < DARSHAN_KNOWN_MODULE_COUNT; i++)
         {
             if(active_mods[i])
                 darshan_core_fprintf(stderr, "darshan:%s_shutdown\t%d\t%f\n",
                     darshan_module_names[i], nprocs, mod_tm[i]);
         }
+        for(i = 0; i < DARSHAN_KNOWN_MODULE_COUNT; i++)
+        {
+            if(active_mods[i])
+                darshan_core_fprintf(stderr, "darshan:%s_redux\t%d\t%f\n",
+                    darshan_module_names[i], nprocs, redux_tm[i]);
+        }
+        darshan_core_fprintf(stderr, "darshan:deflate\t%d\t%f\n", nprocs, phase_tm[1]);
+        darshan_core_fprintf(stderr, "darshan:log_append\t%d\t%f\n", nprocs, phase_tm[2]);
         darshan_core_fprintf(stderr, "darshan:core_shutdown\t%d\t%f\n", nprocs, all_tm);
+        darshan_core_fprintf(stderr, "#darshan:<mem>\t<nprocs>\t<max bytes>\n");
+        darshan_core_fprintf(stderr, "darshan:max_rss\t%d\t%" PRId64 "\n", nprocs, mem_hwm[0]);
+        darshan_core_fprintf(stderr, "darshan:record_mem\t%d\t%" PRId64 "\n", nprocs, mem_hwm[1]);
     }
 
 cleanup:
@@ -1695,6 +1796,10 @@ static int darshan_log_write_job_record(darshan_core_log_fh log_fh,
     }
     else
     {
+        if(!core->config.disable_log_checksums_flag)
+            core->log_hdr_p->checksums.job =
+                crc32(0L, (Bytef *)core->comp_buf, comp_buf_sz);
+
         /* write the job information, preallocing space for the log header */
         *inout_off += sizeof(struct darshan_header);
 
@@ -1829,10 +1934,29 @@ static int darshan_log_write_name_record_hash(darshan_core_log_fh log_fh,
 
     /* collectively write out the record hash to the darshan log */
     ret = darshan_log_append(log_fh, core, core->log_name_p,
-        name_rec_buf_len, inout_off);
+        name_rec_buf_len, inout_off, &core->log_hdr_p->checksums.name);
     return(ret);
 }
 
+/* checksum the header once all of its fields are final; the checksum
+ * field itself is zeroed while computing it
+ */
+static void darshan_log_checksum_header(struct darshan_core_runtime *core)
+{
+    struct darshan_header *hdr = core->log_hdr_p;
+
+    if(core->config.disable_log_checksums_flag)
+    {
+        memset(&hdr->checksums, 0, sizeof(hdr->checksums));
+        return;
+    }
+
+    hdr->checksums.type = DARSHAN_CRC32_CHECKSUM;
+    hdr->checksums.header = 0;
+    hdr->checksums.header = crc32(0L, (Bytef *)hdr, sizeof(*hdr));
+    return;
+}
+
 static int darshan_log_write_header(darshan_core_log_fh log_fh,
     struct darshan_core_runtime *core)
 {
@@ -1870,6 +1994,8 @@ static int darshan_log_write_header(darshan_core_log_fh log_fh,
             return(0); /* only rank 0 writes the header */
         }
 
+        darshan_log_checksum_header(core);
+
         /* write the header using MPI */
         ret = PMPI_File_write_at(log_fh.mpi_fh, 0, core->log_hdr_p,
             sizeof(struct darshan_header), MPI_BYTE, &status);
@@ -1886,6 +2012,8 @@ static int darshan_log_write_header(darshan_core_log_fh log_fh,
     }
 #endif
 
+    darshan_log_checksum_header(core);
+
     /* write log header */
     ret = pwrite(log_fh.nompi_fd, core->log_hdr_p, sizeof(struct darshan_header), 0);
     if(ret != sizeof(struct darshan_header))
@@ -1901,21 +2029,56 @@ static int darshan_log_write_header(darshan_core_log_fh log_fh,
     return(ret);
 }
 
+#ifdef HAVE_MPI
+/* combine the (crc, length) pairs of consecutive pieces of a log region,
+ * in rank order, into that of their concatenation
+ */
+static void darshan_log_crc_combine(void *invec, void *inoutvec, int *len,
+    MPI_Datatype *dtype)
+{
+    uint64_t *in = invec;
+    uint64_t *inout = inoutvec;
+    int i;
+
+    for(i = 0; i < *len; i++, in += 2, inout += 2)
+    {
+        inout[0] = crc32_combine(in[0], inout[0], inout[1]);
+        inout[1] += in[1];
+    }
+    return;
+}
+#endif
+
 /* NOTE: inout_off contains the starting offset of this append at the beginning
  *       of the call, and contains the ending offset at the end of the call.
- *       This variable is only valid on the root rank (rank 0).
+ *       Likewise, out_crc is set to the checksum of the appended region.
+ *       These variables are only valid on the root rank (rank 0).
  */
 static int darshan_log_append(darshan_core_log_fh log_fh, struct darshan_core_runtime *core,
-    void *buf, int count, uint64_t *inout_off)
+    void *buf, int count, uint64_t *inout_off, uint32_t *out_crc)
 {
     int comp_buf_sz = core->config.mod_mem;
+    int crc_flag = !core->config.disable_log_checksums_flag;
+    uLong crc = 0;
+    double tm1 = 0, tm2 = 0;
     int ret;
 
     /* compress the input buffer */
+    if(core->config.internal_timing_flag)
+        tm1 = darshan_core_wtime_absolute();
     ret = darshan_deflate_buffer((void **)&buf, &count, 1,
         core->comp_buf, &comp_buf_sz);
     if(ret < 0)
         comp_buf_sz = 0;
+    if(core->config.internal_timing_flag)
+    {
+        tm2 = darshan_core_wtime_absolute();
+        core->deflate_time += tm2 - tm1;
+    }
+
+    /* checksum the compressed data as it will be laid out in the log */
+    if(crc_flag)
+        crc = crc32(0L, (Bytef *)core->comp_buf, comp_buf_sz);
 
 #ifdef HAVE_MPI
     MPI_Offset send_off, my_off;
@@ -1923,6 +2086,29 @@ static int darshan_log_append(darshan_core_log_fh log_fh, struct darshan_core_ru
 
     if(using_mpi)
     {
+        if(crc_flag && nprocs > 1)
+        {
+            /* each rank's compressed data follows that of lower ranks, so
+             * combine the checksums with an ordered (non-commutative)
+             * reduction, rather than gathering them at rank 0
+             */
+            uint64_t crc_len[2] = {crc, comp_buf_sz};
+            uint64_t region_crc_len[2] = {0, 0};
+            MPI_Datatype crc_type;
+            MPI_Op crc_op;
+
+            PMPI_Type_contiguous(2, MPI_UINT64_T, &crc_type);
+            PMPI_Type_commit(&crc_type);
+            PMPI_Op_create(darshan_log_crc_combine, 0, &crc_op);
+            PMPI_Reduce(crc_len, region_crc_len, 1, crc_type, crc_op, 0,
+                core->mpi_comm);
+            PMPI_Op_free(&crc_op);
+            PMPI_Type_free(&crc_type);
+            crc = region_crc_len[0];
+        }
+        if(my_rank == 0)
+            *out_crc = crc;
+
         /* figure out where everyone is writing using scan */
         send_off = comp_buf_sz;
         if(my_rank == 0)
@@ -1971,11 +2157,16 @@ static int darshan_log_append(darshan_core_log_fh log_fh, struct darshan_core_ru
             *inout_off = my_off + comp_buf_sz;
         }
 
+        if(core->config.internal_timing_flag)
+            core->append_time += darshan_core_wtime_absolute() - tm2;
         return(ret);
     }
 #endif
 
+    *out_crc = crc;
     ret = pwrite(log_fh.nompi_fd, core->comp_buf, comp_buf_sz, *inout_off);
+    if(core->config.internal_timing_flag)
+        core->append_time += darshan_core_wtime_absolute() - tm2;
     if(ret != comp_buf_sz)
         return(-1);
     *inout_off += comp_buf_sz;
@@ -2210,7 +2401,10 @@ static int darshan_core_name_is_excluded(const char *name, darshan_module_id mod
     /* set flag if this module's record names are based on file paths */
     name_is_path = 1;
     if((mod_id == DARSHAN_APMPI_MOD) || (mod_id == DARSHAN_APXC_MOD) ||
-       (mod_id == DARSHAN_HEATMAP_MOD) || (mod_id == DARSHAN_MDHIM_MOD))
+       (mod_id == DARSHAN_HEATMAP_MOD) || (mod_id == DARSHAN_MDHIM_MOD) ||
+       (mod_id == DARSHAN_PROCIO_MOD) || (mod_id == DARSHAN_NFS_MOD) ||
+       (mod_id == DARSHAN_CUSTOM_MOD) || (mod_id == DARSHAN_SNAPSHOT_MOD) ||
+       (mod_id == DARSHAN_IMBALANCE_MOD))
         name_is_path = 0;
 
     if(name_is_path)
@@ -2370,79 +2564,153 @@ static void darshan_core_reduce_max_time(void* in_time_v, void* inout_time_v,
 /* crude benchmarking hook into darshan-core to benchmark Darshan
  * shutdown overhead using a variety of application I/O workloads
  */
-extern void darshan_posix_shutdown_bench_setup();
-extern void darshan_mpiio_shutdown_bench_setup();
+extern void darshan_posix_shutdown_bench_setup(
+    struct darshan_shutdown_bench_workload *wl);
+extern void darshan_mpiio_shutdown_bench_setup(
+    struct darshan_shutdown_bench_workload *wl);
 #ifdef HAVE_MPI
-void darshan_shutdown_bench(int argc, char **argv)
+static void darshan_shutdown_bench_run(int argc, char **argv,
+    struct darshan_shutdown_bench_workload *wl)
 {
-    /* clear out existing core runtime structure */
-    if(__darshan_core)
-    {
-        darshan_core_cleanup(__darshan_core);
-        __darshan_core = NULL;
-    }
-
-    /***********************************************************/
     /* restart darshan */
     darshan_core_initialize(argc, argv);
 
-    darshan_posix_shutdown_bench_setup(1);
-    darshan_mpiio_shutdown_bench_setup(1);
-
-    if(my_rank == 0)
-        fprintf(stderr, "# 1 unique file per proc\n");
-    PMPI_Barrier(MPI_COMM_WORLD);
-    darshan_core_shutdown(1);
-    __darshan_core = NULL;
-
-    sleep(1);
-
-    /***********************************************************/
-    /* restart darshan */
-    darshan_core_initialize(argc, argv);
+    /* allow the modules to track every record of large workloads */
+    if(__darshan_core && wl->rec_count > DARSHAN_DEF_MOD_REC_COUNT)
+    {
+        if(!__darshan_core->config.mod_max_records_override[DARSHAN_POSIX_MOD])
+            __darshan_core->config.mod_max_records_override[DARSHAN_POSIX_MOD] =
+                wl->rec_count;
+        if(!__darshan_core->config.mod_max_records_override[DARSHAN_MPIIO_MOD])
+            __darshan_core->config.mod_max_records_override[DARSHAN_MPIIO_MOD] =
+                wl->rec_count;
+    }
 
-    darshan_posix_shutdown_bench_setup(2);
-    darshan_mpiio_shutdown_bench_setup(2);
+    darshan_posix_shutdown_bench_setup(wl);
+    darshan_mpiio_shutdown_bench_setup(wl);
 
     if(my_rank == 0)
-        fprintf(stderr, "# 1 shared file per proc\n");
+        fprintf(stderr, "# %d files per proc, %d%% shared, %d DXT segments "
+            "per file, name length %d-%d\n", wl->rec_count, wl->shared_pct,
+            wl->dxt_segs, wl->name_len_min, wl->name_len_max);
     PMPI_Barrier(MPI_COMM_WORLD);
     darshan_core_shutdown(1);
     __darshan_core = NULL;
 
     sleep(1);
 
-    /***********************************************************/
-    /* restart darshan */
-    darshan_core_initialize(argc, argv);
+    return;
+}
 
-    darshan_posix_shutdown_bench_setup(3);
-    darshan_mpiio_shutdown_bench_setup(3);
+/* with no arguments, the benchmark runs a fixed set of file-per-process and
+ * shared file workloads.  Otherwise, a single workload is synthesized from
+ * the following options and shut down the requested number of times:
+ *   -r <n>         records per process, for each of POSIX and MPI-IO
+ *   -s <pct>       percentage of records shared by all processes
+ *   -d <n>         DXT segments per record (enables DXT tracing)
+ *   -l <min>[:<max>] record name length range
+ *   -i <n>         iterations
+ * -r is required if any of the other options are given.
+ */
+void darshan_shutdown_bench(int argc, char **argv)
+{
+    struct darshan_shutdown_bench_workload presets[] = {
+        {1, 0, 0, 0, 0},
+        {1, 100, 0, 0, 0},
+        {1024, 0, 0, 0, 0},
+        {1024, 100, 0, 0, 0}
+    };
+    struct darshan_shutdown_bench_workload wl = {0};
+    char mem_str[32];
+    size_t mem_mib;
+    int iters = 1;
+    int configured = 0;
+    int workload_opts = 0;
+    int i, c;
 
-    if(my_rank == 0)
-        fprintf(stderr, "# 1024 unique files per proc\n");
-    PMPI_Barrier(MPI_COMM_WORLD);
-    darshan_core_shutdown(1);
-    __darshan_core = NULL;
+    /* clear out existing core runtime structure */
+    if(__darshan_core)
+    {
+        darshan_core_cleanup(__darshan_core);
+        __darshan_core = NULL;
+    }
 
-    sleep(1);
+    optind = 1;
+    while((c = getopt(argc, argv, "r:s:d:l:i:")) != -1)
+    {
+        switch(c)
+        {
+            case 'r':
+                wl.rec_count = atoi(optarg);
+                configured = 1;
+                break;
+            case 's':
+                wl.shared_pct = atoi(optarg);
+                workload_opts = 1;
+                break;
+            case 'd':
+                wl.dxt_segs = atoi(optarg);
+                workload_opts = 1;
+                break;
+            case 'l':
+                if(sscanf(optarg, "%d:%d", &wl.name_len_min,
+                    &wl.name_len_max) < 2)
+                    wl.name_len_max = wl.name_len_min;
+                workload_opts = 1;
+                break;
+            case 'i':
+                iters = atoi(optarg);
+                workload_opts = 1;
+                break;
+            default:
+                if(my_rank == 0)
+                    fprintf(stderr, "Error: invalid Darshan benchmark option.\n");
+                return;
+        }
+    }
 
-    /***********************************************************/
-    /* restart darshan */
-    darshan_core_initialize(argc, argv);
+    if(!configured && workload_opts)
+    {
+        if(my_rank == 0)
+            fprintf(stderr, "Error: Darshan benchmark options -s, -d, -l "
+                "and -i require -r.\n");
+        return;
+    }
 
-    darshan_posix_shutdown_bench_setup(4);
-    darshan_mpiio_shutdown_bench_setup(4);
+    if(!configured)
+    {
+        for(i = 0; i < (int)(sizeof(presets) / sizeof(presets[0])); i++)
+            darshan_shutdown_bench_run(argc, argv, &presets[i]);
+        return;
+    }
 
-    if(my_rank == 0)
-        fprintf(stderr, "# 1024 shared files per proc\n");
-    PMPI_Barrier(MPI_COMM_WORLD);
-    darshan_core_shutdown(1);
-    __darshan_core = NULL;
+    if(wl.rec_count < 0 || wl.shared_pct < 0 || wl.shared_pct > 100 ||
+        wl.dxt_segs < 0 || wl.name_len_min < 0 ||
+        wl.name_len_max < wl.name_len_min)
+    {
+        if(my_rank == 0)
+            fprintf(stderr, "Error: invalid Darshan benchmark workload.\n");
+        return;
+    }
 
-    sleep(1);
+    /* DXT must be enabled before the runtime starts up */
+    if(wl.dxt_segs > 0)
+        setenv("DXT_ENABLE_IO_TRACE", "1", 1);
 
-    /***********************************************************/
+    /* size the record and name memory for the workload, leaving room for
+     * the DXT and other modules' records, unless the user set them
+     */
+    mem_mib = ((size_t)wl.rec_count * (sizeof(struct darshan_posix_file) +
+        sizeof(struct darshan_mpiio_file))) / (1024 * 1024) + 8;
+    snprintf(mem_str, sizeof(mem_str), "%zu", mem_mib);
+    setenv(DARSHAN_MOD_MEM_OVERRIDE, mem_str, 0);
+    mem_mib = ((size_t)wl.rec_count * (sizeof(struct darshan_name_record) +
+        wl.name_len_max + 64)) / (1024 * 1024) + 1;
+    snprintf(mem_str, sizeof(mem_str), "%zu", mem_mib);
+    setenv(DARSHAN_NAME_MEM_OVERRIDE, mem_str, 0);
+
+    for(i = 0; i < iters; i++)
+        darshan_shutdown_bench_run(argc, argv, &wl);
 
     return;
 }
@@ -2455,6 +2723,51 @@ void darshan_shutdown_bench(int argc, char **argv)
 }
 #endif
 
+int darshan_shutdown_bench_rec_name(
+    struct darshan_shutdown_bench_workload *wl,
+    int rec_index,
+    char *name)
+{
+    char base[64];
+    uint32_t seed;
+    int shared;
+    int len, pad;
+    int i;
+
+    shared = rec_index < (int)((int64_t)wl->rec_count * wl->shared_pct / 100);
+    if(shared)
+    {
+        snprintf(base, sizeof(base), "shared-%d", rec_index);
+        seed = rec_index;
+    }
+    else
+    {
+        snprintf(base, sizeof(base), "fpp-%d_rank-%d", rec_index, my_rank);
+        seed = (uint32_t)rec_index * nprocs + my_rank;
+    }
+
+    /* the length depends only on the seed so that every process generates
+     * the same name for a shared record
+     */
+    len = wl->name_len_min;
+    if(wl->name_len_max > wl->name_len_min)
+        len += darshan_hashlittle(&seed, sizeof(seed), 0) %
+            (wl->name_len_max - wl->name_len_min + 1);
+    if(len > __DARSHAN_PATH_MAX - 1)
+        len = __DARSHAN_PATH_MAX - 1;
+
+    /* pad with leading directory components up to the requested length */
+    name[0] = '/';
+    pad = len - 1 - strlen(base);
+    if(pad < 2)
+        pad = 0;
+    for(i = 0; i < pad; i++)
+        name[i + 1] = ((i % 16) == 15 || i == pad - 1) ? '/' : 'd';
+    strcpy(&name[pad + 1], base);
+
+    return(shared);
+}
+
 /* ********************************************************* */
 
 int darshan_core_register_module(
@@ -2497,10 +2810,11 @@ int darshan_core_register_module(
     if(__darshan_core->config.mod_max_records_override[mod_id])
     {
         /* ignore overrides for modules with static record counts
-         * (i.e., HEATMAP, APMPI, APXC modules)
+         * (i.e., HEATMAP, APMPI, APXC, PROCIO, SNAPSHOT, IMBALANCE modules)
          */
         if((mod_id != DARSHAN_HEATMAP_MOD) && (mod_id != DARSHAN_APXC_MOD) &&
-            (mod_id != DARSHAN_APMPI_MOD))
+            (mod_id != DARSHAN_APMPI_MOD) && (mod_id != DARSHAN_PROCIO_MOD) &&
+            (mod_id != DARSHAN_SNAPSHOT_MOD) && (mod_id != DARSHAN_IMBALANCE_MOD))
             mod_recs_req = __darshan_core->config.mod_max_records_override[mod_id];
     }
 
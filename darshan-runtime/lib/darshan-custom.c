@@ -0,0 +1,641 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <darshan-runtime-config.h>
+#endif
+
+#define _XOPEN_SOURCE 500
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <assert.h>
+#ifdef HAVE_STDATOMIC_H
+#include <stdatomic.h>
+#endif
+
+#include "darshan.h"
+#include "darshan-custom.h"
+
+/*
+ * Module which stores application-defined counters, registered by name and
+ * updated through the public interface in darshan-custom.h.  This module
+ * does not intercept any functions.
+ *
+ * Registration is serialized by the module lock, but increments are not:
+ * when C11 atomics are available, each counter is accumulated in atomic
+ * runtime state and only copied into its Darshan record at shutdown time.
+ * Counter handles are indices into a table that is allocated once, when the
+ * module is initialized, so the increment path never has to search for the
+ * counter or allocate memory.
+ */
+
+#ifdef HAVE_STDATOMIC_H
+#define CUSTOM_ATOMIC _Atomic
+#else
+#define CUSTOM_ATOMIC
+#endif
+
+/* the custom_counter_ref structure holds the running values of a counter
+ * and the Darshan record they are stored in at shutdown
+ */
+struct custom_counter_ref
+{
+    CUSTOM_ATOMIC int64_t int_value;
+    CUSTOM_ATOMIC int64_t int_updates;
+    CUSTOM_ATOMIC double f_value;
+    CUSTOM_ATOMIC int64_t f_updates;
+    struct darshan_custom_record *record_p;
+};
+
+struct custom_runtime
+{
+    struct custom_counter_ref *refs;
+    int ref_count;
+    int ref_max;
+    void *rec_id_hash;
+    int frozen;
+};
+
+static struct custom_runtime *custom_runtime = NULL;
+static pthread_mutex_t custom_runtime_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int custom_runtime_init_attempted = 0;
+
+/* counter table and its size, as seen by the increment functions; these
+ * are cleared before the counters are copied into their records at
+ * shutdown, after which increments are dropped.  The increment functions
+ * count themselves in the updater shard of their counter while they use
+ * the table, so that it is only read or freed once every in-flight
+ * increment is done.  Each shard has a cache line of its own, so that
+ * increments of different counters do not contend on a shared count.
+ */
+#ifdef HAVE_STDATOMIC_H
+#define CUSTOM_UPDATER_SHARDS 64
+#define CUSTOM_CACHE_LINE_SIZE 64
+
+struct custom_updater_shard
+{
+    _Alignas(CUSTOM_CACHE_LINE_SIZE) _Atomic int count;
+};
+
+static struct custom_counter_ref *_Atomic custom_active_refs = NULL;
+static _Atomic int custom_active_max = 0;
+static struct custom_updater_shard custom_updaters[CUSTOM_UPDATER_SHARDS];
+
+#define CUSTOM_UPDATER_SHARD(__counter) \
+    (&custom_updaters[(unsigned int)(__counter) % CUSTOM_UPDATER_SHARDS].count)
+#endif
+
+/* my_rank indicates the MPI rank of this process */
+static int my_rank = -1;
+
+/* internal helper functions for the CUSTOM module */
+static void custom_runtime_initialize(void);
+static void custom_finalize_records(void);
+#ifdef HAVE_STDATOMIC_H
+static void custom_deactivate_refs(void);
+#endif
+
+/* forward declaration for functions needed to interface with darshan-core */
+#ifdef HAVE_MPI
+static void custom_mpi_redux(
+    void *custom_buf,
+    MPI_Comm mod_comm,
+    darshan_record_id *shared_recs,
+    int shared_rec_count);
+static void custom_record_reduction_op(
+    void* inrec_v,
+    void* inoutrec_v,
+    int *len,
+    MPI_Datatype *datatype);
+#endif
+static void custom_output(
+    void **custom_buf,
+    int *custom_buf_sz);
+static void custom_cleanup(
+    void);
+
+/* macros for obtaining/releasing the CUSTOM module lock */
+#define CUSTOM_LOCK() pthread_mutex_lock(&custom_runtime_mutex)
+#define CUSTOM_UNLOCK() pthread_mutex_unlock(&custom_runtime_mutex)
+
+/*****************************************************
+ * Public interface for application-defined counters *
+ *****************************************************/
+
+darshan_custom_counter darshan_custom_register(const char *name)
+{
+    struct custom_counter_ref *ref;
+    struct darshan_custom_record *rec;
+    darshan_record_id rec_id;
+    int *index_p;
+    int ret;
+
+    if(!name || !(*name))
+        return(DARSHAN_CUSTOM_INVALID);
+
+    CUSTOM_LOCK();
+    if(!custom_runtime && !custom_runtime_init_attempted &&
+       !darshan_core_disabled_instrumentation())
+        custom_runtime_initialize();
+    if(!custom_runtime || custom_runtime->frozen)
+    {
+        CUSTOM_UNLOCK();
+        return(DARSHAN_CUSTOM_INVALID);
+    }
+
+    /* return the existing handle if this counter is already registered */
+    rec_id = darshan_core_gen_record_id(name);
+    index_p = darshan_lookup_record_ref(custom_runtime->rec_id_hash,
+        &rec_id, sizeof(darshan_record_id));
+    if(index_p)
+    {
+        ret = *index_p;
+        CUSTOM_UNLOCK();
+        return(ret);
+    }
+
+    if(custom_runtime->ref_count == custom_runtime->ref_max)
+    {
+        CUSTOM_UNLOCK();
+        return(DARSHAN_CUSTOM_INVALID);
+    }
+
+    index_p = malloc(sizeof(*index_p));
+    if(!index_p)
+    {
+        CUSTOM_UNLOCK();
+        return(DARSHAN_CUSTOM_INVALID);
+    }
+    *index_p = custom_runtime->ref_count;
+
+    ret = darshan_add_record_ref(&(custom_runtime->rec_id_hash), &rec_id,
+        sizeof(darshan_record_id), index_p);
+    if(ret == 0)
+    {
+        free(index_p);
+        CUSTOM_UNLOCK();
+        return(DARSHAN_CUSTOM_INVALID);
+    }
+
+    rec = darshan_core_register_record(
+        rec_id,
+        name,
+        DARSHAN_CUSTOM_MOD,
+        sizeof(struct darshan_custom_record),
+        NULL);
+    if(!rec)
+    {
+        darshan_delete_record_ref(&(custom_runtime->rec_id_hash),
+            &rec_id, sizeof(darshan_record_id));
+        free(index_p);
+        CUSTOM_UNLOCK();
+        return(DARSHAN_CUSTOM_INVALID);
+    }
+
+    rec->base_rec.id = rec_id;
+    rec->base_rec.rank = my_rank;
+    rec->fcounters[CUSTOM_F_REGISTER_TIMESTAMP] = darshan_core_wtime();
+
+    ref = &(custom_runtime->refs[*index_p]);
+    ref->record_p = rec;
+    custom_runtime->ref_count++;
+    ret = *index_p;
+
+    CUSTOM_UNLOCK();
+    return(ret);
+}
+
+#ifdef HAVE_STDATOMIC_H
+
+/* look up the counter table entry for a handle, or NULL if the handle is
+ * invalid or the module is shutting down; unless NULL is returned, the
+ * entry must be released with custom_release_ref() once updated
+ */
+static inline struct custom_counter_ref *custom_active_ref(
+    darshan_custom_counter counter)
+{
+    _Atomic int *updaters = CUSTOM_UPDATER_SHARD(counter);
+    struct custom_counter_ref *refs;
+
+    /* announce this updater before loading the table (both sequentially
+     * consistent), so that custom_deactivate_refs() either waits for it or
+     * it sees the cleared table
+     */
+    atomic_fetch_add(updaters, 1);
+    refs = atomic_load(&custom_active_refs);
+    if(!refs || counter < 0 ||
+       counter >= atomic_load_explicit(&custom_active_max, memory_order_relaxed))
+    {
+        atomic_fetch_sub_explicit(updaters, 1, memory_order_release);
+        return(NULL);
+    }
+
+    return(&refs[counter]);
+}
+
+static inline void custom_release_ref(darshan_custom_counter counter)
+{
+    atomic_fetch_sub_explicit(CUSTOM_UPDATER_SHARD(counter), 1,
+        memory_order_release);
+}
+
+void darshan_custom_add_int(darshan_custom_counter counter, int64_t val)
+{
+    struct custom_counter_ref *ref = custom_active_ref(counter);
+
+    if(!ref)
+        return;
+
+    atomic_fetch_add_explicit(&ref->int_value, val, memory_order_relaxed);
+    atomic_fetch_add_explicit(&ref->int_updates, 1, memory_order_relaxed);
+    custom_release_ref(counter);
+
+    return;
+}
+
+void darshan_custom_add_float(darshan_custom_counter counter, double val)
+{
+    struct custom_counter_ref *ref = custom_active_ref(counter);
+    double old;
+
+    if(!ref)
+        return;
+
+    /* there is no atomic add for floating point types */
+    old = atomic_load_explicit(&ref->f_value, memory_order_relaxed);
+    while(!atomic_compare_exchange_weak_explicit(&ref->f_value, &old, old + val,
+        memory_order_relaxed, memory_order_relaxed));
+    atomic_fetch_add_explicit(&ref->f_updates, 1, memory_order_relaxed);
+    custom_release_ref(counter);
+
+    return;
+}
+
+#else
+
+void darshan_custom_add_int(darshan_custom_counter counter, int64_t val)
+{
+    CUSTOM_LOCK();
+    if(custom_runtime && !custom_runtime->frozen &&
+       counter >= 0 && counter < custom_runtime->ref_count)
+    {
+        custom_runtime->refs[counter].int_value += val;
+        custom_runtime->refs[counter].int_updates++;
+    }
+    CUSTOM_UNLOCK();
+
+    return;
+}
+
+void darshan_custom_add_float(darshan_custom_counter counter, double val)
+{
+    CUSTOM_LOCK();
+    if(custom_runtime && !custom_runtime->frozen &&
+       counter >= 0 && counter < custom_runtime->ref_count)
+    {
+        custom_runtime->refs[counter].f_value += val;
+        custom_runtime->refs[counter].f_updates++;
+    }
+    CUSTOM_UNLOCK();
+
+    return;
+}
+
+#endif
+
+/**********************************************************
+ * Internal functions for manipulating CUSTOM module state *
+ **********************************************************/
+
+/* must be called with the module lock held */
+static void custom_runtime_initialize()
+{
+    int ret;
+    size_t custom_rec_count;
+    darshan_module_funcs mod_funcs = {
+#ifdef HAVE_MPI
+        .mod_redux_func = &custom_mpi_redux,
+#endif
+        .mod_output_func = &custom_output,
+        .mod_cleanup_func = &custom_cleanup
+        };
+
+    /* if this attempt at initializing fails, we won't try again */
+    custom_runtime_init_attempted = 1;
+
+    /* try to store default number of records for this module */
+    custom_rec_count = DARSHAN_DEF_MOD_REC_COUNT;
+
+    /* register the CUSTOM module with darshan-core */
+    ret = darshan_core_register_module(
+        DARSHAN_CUSTOM_MOD,
+        mod_funcs,
+        sizeof(struct darshan_custom_record),
+        &custom_rec_count,
+        &my_rank,
+        NULL);
+    if(ret < 0)
+        return;
+
+    /* initialize module's global state; the counter table is sized to the
+     * number of records darshan-core granted us so that it never moves
+     */
+    custom_runtime = malloc(sizeof(*custom_runtime));
+    if(custom_runtime)
+    {
+        memset(custom_runtime, 0, sizeof(*custom_runtime));
+        custom_runtime->refs = calloc(custom_rec_count,
+            sizeof(*custom_runtime->refs));
+    }
+    if(!custom_runtime || !custom_runtime->refs)
+    {
+        darshan_core_unregister_module(DARSHAN_CUSTOM_MOD);
+        free(custom_runtime);
+        custom_runtime = NULL;
+        return;
+    }
+    custom_runtime->ref_max = custom_rec_count;
+
+#ifdef HAVE_STDATOMIC_H
+    atomic_store_explicit(&custom_active_max, custom_runtime->ref_max,
+        memory_order_relaxed);
+    atomic_store_explicit(&custom_active_refs, custom_runtime->refs,
+        memory_order_release);
+#endif
+
+    return;
+}
+
+#ifdef HAVE_STDATOMIC_H
+/* clear the counter table seen by the increment functions and wait for any
+ * increments still using it to finish
+ */
+static void custom_deactivate_refs()
+{
+    int i;
+
+    atomic_store(&custom_active_refs, NULL);
+    for(i = 0; i < CUSTOM_UPDATER_SHARDS; i++)
+    {
+        while(atomic_load(&custom_updaters[i].count) > 0)
+            sched_yield();
+    }
+
+    return;
+}
+#endif
+
+/* stop accepting updates and store each counter's running values in its
+ * record; must be called with the module lock held
+ */
+static void custom_finalize_records()
+{
+    struct custom_counter_ref *ref;
+    struct darshan_custom_record *rec;
+    int i;
+
+    if(custom_runtime->frozen)
+        return;
+    custom_runtime->frozen = 1;
+#ifdef HAVE_STDATOMIC_H
+    custom_deactivate_refs();
+#endif
+
+    for(i = 0; i < custom_runtime->ref_count; i++)
+    {
+        ref = &(custom_runtime->refs[i]);
+        rec = ref->record_p;
+
+        rec->counters[CUSTOM_INT_VALUE] = ref->int_value;
+        rec->counters[CUSTOM_INT_UPDATES] = ref->int_updates;
+        rec->counters[CUSTOM_F_UPDATES] = ref->f_updates;
+        rec->fcounters[CUSTOM_F_VALUE] = ref->f_value;
+
+        /* this rank is both the min and max until the records are reduced */
+        rec->counters[CUSTOM_INT_RANK_MIN] = rec->counters[CUSTOM_INT_VALUE];
+        rec->counters[CUSTOM_INT_RANK_MAX] = rec->counters[CUSTOM_INT_VALUE];
+        rec->fcounters[CUSTOM_F_RANK_MIN] = rec->fcounters[CUSTOM_F_VALUE];
+        rec->fcounters[CUSTOM_F_RANK_MAX] = rec->fcounters[CUSTOM_F_VALUE];
+        rec->counters[CUSTOM_RANKS] = 1;
+    }
+
+    return;
+}
+
+/********************************************************************************
+ * shutdown functions exported by this module for coordinating with darshan-core *
+ ********************************************************************************/
+
+#ifdef HAVE_MPI
+static void custom_record_reduction_op(
+    void* inrec_v,
+    void* inoutrec_v,
+    int *len,
+    MPI_Datatype *datatype)
+{
+    struct darshan_custom_record tmp_rec;
+    struct darshan_custom_record *inrec = inrec_v;
+    struct darshan_custom_record *inoutrec = inoutrec_v;
+    int i;
+
+    for(i = 0; i < *len; i++)
+    {
+        memset(&tmp_rec, 0, sizeof(struct darshan_custom_record));
+        tmp_rec.base_rec.id = inrec->base_rec.id;
+        tmp_rec.base_rec.rank = -1;
+
+        /* sum */
+        tmp_rec.counters[CUSTOM_INT_VALUE] = inrec->counters[CUSTOM_INT_VALUE] +
+            inoutrec->counters[CUSTOM_INT_VALUE];
+        tmp_rec.counters[CUSTOM_INT_UPDATES] = inrec->counters[CUSTOM_INT_UPDATES] +
+            inoutrec->counters[CUSTOM_INT_UPDATES];
+        tmp_rec.counters[CUSTOM_F_UPDATES] = inrec->counters[CUSTOM_F_UPDATES] +
+            inoutrec->counters[CUSTOM_F_UPDATES];
+        tmp_rec.counters[CUSTOM_RANKS] = inrec->counters[CUSTOM_RANKS] +
+            inoutrec->counters[CUSTOM_RANKS];
+        tmp_rec.fcounters[CUSTOM_F_VALUE] = inrec->fcounters[CUSTOM_F_VALUE] +
+            inoutrec->fcounters[CUSTOM_F_VALUE];
+
+        /* min */
+        if(inrec->counters[CUSTOM_INT_RANK_MIN] < inoutrec->counters[CUSTOM_INT_RANK_MIN])
+            tmp_rec.counters[CUSTOM_INT_RANK_MIN] = inrec->counters[CUSTOM_INT_RANK_MIN];
+        else
+            tmp_rec.counters[CUSTOM_INT_RANK_MIN] = inoutrec->counters[CUSTOM_INT_RANK_MIN];
+        if(inrec->fcounters[CUSTOM_F_RANK_MIN] < inoutrec->fcounters[CUSTOM_F_RANK_MIN])
+            tmp_rec.fcounters[CUSTOM_F_RANK_MIN] = inrec->fcounters[CUSTOM_F_RANK_MIN];
+        else
+            tmp_rec.fcounters[CUSTOM_F_RANK_MIN] = inoutrec->fcounters[CUSTOM_F_RANK_MIN];
+        if(inrec->fcounters[CUSTOM_F_REGISTER_TIMESTAMP] <
+           inoutrec->fcounters[CUSTOM_F_REGISTER_TIMESTAMP])
+            tmp_rec.fcounters[CUSTOM_F_REGISTER_TIMESTAMP] =
+                inrec->fcounters[CUSTOM_F_REGISTER_TIMESTAMP];
+        else
+            tmp_rec.fcounters[CUSTOM_F_REGISTER_TIMESTAMP] =
+                inoutrec->fcounters[CUSTOM_F_REGISTER_TIMESTAMP];
+
+        /* max */
+        if(inrec->counters[CUSTOM_INT_RANK_MAX] > inoutrec->counters[CUSTOM_INT_RANK_MAX])
+            tmp_rec.counters[CUSTOM_INT_RANK_MAX] = inrec->counters[CUSTOM_INT_RANK_MAX];
+        else
+            tmp_rec.counters[CUSTOM_INT_RANK_MAX] = inoutrec->counters[CUSTOM_INT_RANK_MAX];
+        if(inrec->fcounters[CUSTOM_F_RANK_MAX] > inoutrec->fcounters[CUSTOM_F_RANK_MAX])
+            tmp_rec.fcounters[CUSTOM_F_RANK_MAX] = inrec->fcounters[CUSTOM_F_RANK_MAX];
+        else
+            tmp_rec.fcounters[CUSTOM_F_RANK_MAX] = inoutrec->fcounters[CUSTOM_F_RANK_MAX];
+
+        /* update pointers */
+        *inoutrec = tmp_rec;
+        inoutrec++;
+        inrec++;
+    }
+
+    return;
+}
+
+static void custom_mpi_redux(
+    void *custom_buf,
+    MPI_Comm mod_comm,
+    darshan_record_id *shared_recs,
+    int shared_rec_count)
+{
+    int custom_rec_count;
+    int *index_p;
+    struct darshan_custom_record *custom_rec_buf =
+        (struct darshan_custom_record *)custom_buf;
+    struct darshan_custom_record *red_send_buf = NULL;
+    struct darshan_custom_record *red_recv_buf = NULL;
+    MPI_Datatype red_type;
+    MPI_Op red_op;
+    int i;
+
+    CUSTOM_LOCK();
+    assert(custom_runtime);
+
+    custom_finalize_records();
+    custom_rec_count = custom_runtime->ref_count;
+
+    /* necessary initialization of shared records */
+    for(i = 0; i < shared_rec_count; i++)
+    {
+        index_p = darshan_lookup_record_ref(custom_runtime->rec_id_hash,
+            &shared_recs[i], sizeof(darshan_record_id));
+        assert(index_p);
+
+        custom_runtime->refs[*index_p].record_p->base_rec.rank = -1;
+    }
+
+    /* sort the array of records descending by rank so that we get all of
+     * the shared records (marked by rank -1) in a contiguous portion at end
+     * of the array
+     */
+    darshan_record_sort(custom_rec_buf, custom_rec_count,
+        sizeof(struct darshan_custom_record));
+
+    /* make *send_buf point to the shared records at the end of sorted array */
+    red_send_buf = &(custom_rec_buf[custom_rec_count-shared_rec_count]);
+
+    /* allocate memory for the reduction output on rank 0 */
+    if(my_rank == 0)
+    {
+        red_recv_buf = malloc(shared_rec_count * sizeof(struct darshan_custom_record));
+        if(!red_recv_buf)
+        {
+            CUSTOM_UNLOCK();
+            return;
+        }
+    }
+
+    /* construct a datatype for a CUSTOM record.  This is serving no purpose
+     * except to make sure we can do a reduction on proper boundaries
+     */
+    PMPI_Type_contiguous(sizeof(struct darshan_custom_record),
+        MPI_BYTE, &red_type);
+    PMPI_Type_commit(&red_type);
+
+    /* register a CUSTOM record reduction operator */
+    PMPI_Op_create(custom_record_reduction_op, 1, &red_op);
+
+    /* reduce shared CUSTOM records */
+    PMPI_Reduce(red_send_buf, red_recv_buf,
+        shared_rec_count, red_type, red_op, 0, mod_comm);
+
+    /* update module state to account for shared record reduction */
+    if(my_rank == 0)
+    {
+        /* overwrite local shared records with globally reduced records */
+        int tmp_ndx = custom_rec_count - shared_rec_count;
+        memcpy(&(custom_rec_buf[tmp_ndx]), red_recv_buf,
+            shared_rec_count * sizeof(struct darshan_custom_record));
+        free(red_recv_buf);
+    }
+    else
+    {
+        /* drop shared records on non-zero ranks */
+        custom_runtime->ref_count -= shared_rec_count;
+    }
+
+    PMPI_Type_free(&red_type);
+    PMPI_Op_free(&red_op);
+
+    CUSTOM_UNLOCK();
+    return;
+}
+#endif
+
+static void custom_output(
+    void **custom_buf,
+    int *custom_buf_sz)
+{
+    CUSTOM_LOCK();
+    assert(custom_runtime);
+
+    /* the records may not have been finalized yet if there was no reduction */
+    custom_finalize_records();
+
+    *custom_buf_sz = custom_runtime->ref_count * sizeof(struct darshan_custom_record);
+
+    CUSTOM_UNLOCK();
+    return;
+}
+
+static void custom_cleanup()
+{
+    CUSTOM_LOCK();
+    assert(custom_runtime);
+
+    /* no increment may be using the counter table once it is freed */
+    custom_runtime->frozen = 1;
+#ifdef HAVE_STDATOMIC_H
+    custom_deactivate_refs();
+    atomic_store_explicit(&custom_active_max, 0, memory_order_relaxed);
+#endif
+
+    /* cleanup internal structures used for instrumenting */
+    darshan_clear_record_refs(&(custom_runtime->rec_id_hash), 1);
+
+    free(custom_runtime->refs);
+    free(custom_runtime);
+    custom_runtime = NULL;
+    custom_runtime_init_attempted = 0;
+
+    CUSTOM_UNLOCK();
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
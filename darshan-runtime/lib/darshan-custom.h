@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_CUSTOM_H
+#define __DARSHAN_CUSTOM_H
+
+/* Public interface to the Darshan CUSTOM module, which lets applications
+ * record their own counters (e.g., checkpoint numbers, bytes serialized by
+ * an I/O library, or time spent in a staging layer) in the Darshan log
+ * alongside the I/O characterization of the job.
+ *
+ * Counters are identified by name.  Registering the same name on more than
+ * one rank (or thread) refers to the same counter, and counters registered
+ * by all ranks are reduced across the job at shutdown, like shared files.
+ *
+ * Applications using this interface should link against libdarshan.  To
+ * support running with or without Darshan (e.g., when Darshan is only
+ * preloaded in some runs), define DARSHAN_CUSTOM_WEAK before including this
+ * header and check that darshan_custom_register is non-NULL before calling
+ * any of these functions.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef DARSHAN_CUSTOM_WEAK
+#define __DARSHAN_CUSTOM_DECL __attribute__((weak))
+#else
+#define __DARSHAN_CUSTOM_DECL
+#endif
+
+/* handle returned for counters that could not be registered; it is safe to
+ * pass this to the increment functions, which will ignore it
+ */
+#define DARSHAN_CUSTOM_INVALID (-1)
+
+typedef int darshan_custom_counter;
+
+/* darshan_custom_register()
+ *
+ * Registers the counter 'name' (or looks it up, if it was already
+ * registered by this process) and returns a handle for updating it.
+ * Returns DARSHAN_CUSTOM_INVALID if Darshan is not active (e.g., before
+ * MPI_Init or after MPI_Finalize), if the counter name matches a
+ * NAME_EXCLUDE rule for the CUSTOM module in the Darshan configuration
+ * (directory exclusions do not apply to counter names), or if the module's
+ * record limit has been reached.
+ */
+darshan_custom_counter darshan_custom_register(
+    const char *name) __DARSHAN_CUSTOM_DECL;
+
+/* darshan_custom_add_int()
+ *
+ * Adds 'val' to the integer value of the given counter.
+ */
+void darshan_custom_add_int(
+    darshan_custom_counter counter,
+    int64_t val) __DARSHAN_CUSTOM_DECL;
+
+/* darshan_custom_add_float()
+ *
+ * Adds 'val' to the floating point value of the given counter.
+ */
+void darshan_custom_add_float(
+    darshan_custom_counter counter,
+    double val) __DARSHAN_CUSTOM_DECL;
+
+/* NOTE: the increment functions do not acquire any locks when the compiler
+ * supports C11 atomics, so they are cheap enough to call from performance
+ * critical code and from multiple threads concurrently.  Updates made while
+ * Darshan is shutting down may not be reflected in the log.
+ */
+
+#undef __DARSHAN_CUSTOM_DECL
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DARSHAN_CUSTOM_H */
@@ -94,6 +94,7 @@ struct dxt_runtime
     size_t mem_used;
     char *record_buf;
     int record_buf_size;
+    struct dxt_segment_format seg_format;
     int frozen; /* flag to indicate that the counters should no longer be modified */
 };
 
@@ -175,6 +176,7 @@ void dxt_posix_runtime_initialize()
     memset(dxt_posix_runtime, 0, sizeof(*dxt_posix_runtime));
     dxt_posix_runtime->mem_used = 0;
     dxt_posix_runtime->mem_allocated = dxt_psx_rec_count * DXT_DEF_RECORD_SIZE;
+    dxt_posix_runtime->seg_format.fields = DXT_SEG_ALL_FIELDS;
     DXT_UNLOCK();
 
     return;
@@ -217,6 +219,7 @@ void dxt_mpiio_runtime_initialize()
     memset(dxt_mpiio_runtime, 0, sizeof(*dxt_mpiio_runtime));
     dxt_mpiio_runtime->mem_used = 0;
     dxt_mpiio_runtime->mem_allocated = dxt_mpiio_rec_count * DXT_DEF_RECORD_SIZE;
+    dxt_mpiio_runtime->seg_format.fields = DXT_SEG_ALL_FIELDS;
     DXT_UNLOCK();
 
     return;
@@ -496,6 +499,25 @@ void dxt_posix_apply_trace_filter(
     return;
 }
 
+void dxt_set_segment_format(darshan_module_id mod_id,
+        struct dxt_segment_format *format)
+{
+    struct dxt_runtime *runtime;
+
+    DXT_LOCK();
+
+    runtime = (mod_id == DXT_POSIX_MOD) ? dxt_posix_runtime : dxt_mpiio_runtime;
+    if(runtime && format->fields)
+    {
+        runtime->seg_format.fields = format->fields & DXT_SEG_ALL_FIELDS;
+        runtime->seg_format.time_res_ns = format->time_res_ns;
+    }
+
+    DXT_UNLOCK();
+
+    return;
+}
+
 /***********************************
  *  internal DXT helper routines   *
  ***********************************/
@@ -773,14 +795,119 @@ static void dxt_free_record_data(void *rec_ref_p, void *user_ptr)
  *     functions exported by this module for coordinating with darshan-core     *
  ********************************************************************************/
 
-static void dxt_serialize_posix_records(void *rec_ref_p, void *user_ptr)
+/* convert a time to the nearest integer multiple of 'time_res_ns' */
+static int64_t dxt_time_to_ticks(double t, uint32_t time_res_ns)
+{
+    double ticks = t * 1e9 / time_res_ns;
+
+    return((int64_t)(ticks < 0 ? ticks - 0.5 : ticks + 0.5));
+}
+
+/* get the value of an integer encoded segment field */
+static int64_t dxt_segment_value(segment_info *seg, int field,
+    struct dxt_segment_format *format)
+{
+    int64_t ticks;
+
+    switch(field)
+    {
+        case DXT_SEG_OFFSET:
+            return(seg->offset);
+        case DXT_SEG_LENGTH:
+            return(seg->length);
+        case DXT_SEG_START_TIME:
+            return(dxt_time_to_ticks(seg->start_time, format->time_res_ns));
+        default:
+            ticks = dxt_time_to_ticks(seg->end_time, format->time_res_ns);
+            if(format->fields & DXT_SEG_START_TIME)
+                ticks -= dxt_time_to_ticks(seg->start_time, format->time_res_ns);
+            return(ticks);
+    }
+}
+
+/* flag the fields of 'segs' that need 8 bytes in the format's 'wide' field */
+static void dxt_set_wide_fields(segment_info *segs, int64_t count,
+    struct dxt_segment_format *format)
+{
+    int64_t val;
+    int64_t i;
+    int field;
+
+    for(field = DXT_SEG_OFFSET; field <= DXT_SEG_END_TIME; field <<= 1)
+    {
+        if(!(format->fields & field) || (format->wide & field))
+            continue;
+        if(field >= DXT_SEG_START_TIME && format->time_res_ns == 0)
+        {
+            /* full precision times are stored as doubles */
+            format->wide |= field;
+            continue;
+        }
+        for(i = 0; i < count; i++)
+        {
+            val = dxt_segment_value(&segs[i], field, format);
+            if(val < 0 || val > UINT32_MAX)
+            {
+                format->wide |= field;
+                break;
+            }
+        }
+    }
+
+    return;
+}
+
+/* encode segments in the given format, returning the end of the encoding */
+static char *dxt_encode_segments(segment_info *segs, int64_t count,
+    struct dxt_segment_format *format, char *buf)
+{
+    int64_t val;
+    uint32_t val32;
+    double t;
+    int64_t i;
+    int field;
+
+    for(i = 0; i < count; i++)
+    {
+        for(field = DXT_SEG_OFFSET; field <= DXT_SEG_END_TIME; field <<= 1)
+        {
+            if(!(format->fields & field))
+                continue;
+            if(field >= DXT_SEG_START_TIME && format->time_res_ns == 0)
+            {
+                t = (field == DXT_SEG_START_TIME) ?
+                    segs[i].start_time : segs[i].end_time;
+                memcpy(buf, &t, sizeof(t));
+                buf += sizeof(t);
+                continue;
+            }
+            val = dxt_segment_value(&segs[i], field, format);
+            if(format->wide & field)
+            {
+                memcpy(buf, &val, sizeof(val));
+                buf += sizeof(val);
+            }
+            else
+            {
+                val32 = (uint32_t)val;
+                memcpy(buf, &val32, sizeof(val32));
+                buf += sizeof(val32);
+            }
+        }
+    }
+
+    return(buf);
+}
+
+static void dxt_serialize_records(void *rec_ref_p, void *user_ptr)
 {
     struct dxt_file_record_ref *rec_ref = (struct dxt_file_record_ref *)rec_ref_p;
+    struct dxt_runtime *runtime = (struct dxt_runtime *)user_ptr;
     struct dxt_file_record *file_rec;
-    int64_t record_size = 0;
+    struct dxt_segment_format format;
     int64_t record_write_count = 0;
     int64_t record_read_count = 0;
-    void *tmp_buf_ptr;
+    char *tmp_buf_ptr;
 
     assert(rec_ref);
     file_rec = rec_ref->file_rec;
@@ -791,52 +918,58 @@ static void dxt_serialize_posix_records(void *rec_ref_p, void *user_ptr)
     if (record_write_count == 0 && record_read_count == 0)
         return;
 
+    /* store each field in 4 bytes unless one of its values needs 8 */
+    format = runtime->seg_format;
+    format.wide = 0;
+    dxt_set_wide_fields(rec_ref->write_traces, record_write_count, &format);
+    dxt_set_wide_fields(rec_ref->read_traces, record_read_count, &format);
+
     /*
      * Buffer format:
-     * dxt_file_record + write_traces + read_traces
+     * dxt_file_record + dxt_segment_format + write_traces + read_traces
      */
-    record_size = sizeof(struct dxt_file_record) +
-            (record_write_count + record_read_count) * sizeof(segment_info);
-
-    tmp_buf_ptr = (void *)(dxt_posix_runtime->record_buf +
-        dxt_posix_runtime->record_buf_size);
+    tmp_buf_ptr = runtime->record_buf + runtime->record_buf_size;
 
     /*Copy struct dxt_file_record */
     memcpy(tmp_buf_ptr, (void *)file_rec, sizeof(struct dxt_file_record));
-    tmp_buf_ptr = (void *)(tmp_buf_ptr + sizeof(struct dxt_file_record));
+    tmp_buf_ptr += sizeof(struct dxt_file_record);
 
-    /*Copy write record */
-    memcpy(tmp_buf_ptr, (void *)(rec_ref->write_traces),
-            record_write_count * sizeof(segment_info));
-    tmp_buf_ptr = (void *)(tmp_buf_ptr +
-                record_write_count * sizeof(segment_info));
+    memcpy(tmp_buf_ptr, &format, sizeof(format));
+    tmp_buf_ptr += sizeof(format);
 
-    /*Copy read record */
-    memcpy(tmp_buf_ptr, (void *)(rec_ref->read_traces),
-            record_read_count * sizeof(segment_info));
-    tmp_buf_ptr = (void *)(tmp_buf_ptr +
-                record_read_count * sizeof(segment_info));
+    /* encode write and read segments */
+    tmp_buf_ptr = dxt_encode_segments(rec_ref->write_traces,
+        record_write_count, &format, tmp_buf_ptr);
+    tmp_buf_ptr = dxt_encode_segments(rec_ref->read_traces,
+        record_read_count, &format, tmp_buf_ptr);
 
-    dxt_posix_runtime->record_buf_size += record_size;
+    runtime->record_buf_size = tmp_buf_ptr - runtime->record_buf;
 }
 
 static void dxt_posix_output(
     void **dxt_posix_buf,
     int *dxt_posix_buf_sz)
 {
+    size_t buf_size;
+
     assert(dxt_posix_runtime);
 
     *dxt_posix_buf_sz = 0;
 
-    dxt_posix_runtime->record_buf = malloc(dxt_posix_runtime->mem_allocated);
+    /* each record's segment format is stored in addition to the memory
+     * DXT accounts for
+     */
+    buf_size = dxt_posix_runtime->mem_allocated +
+        dxt_posix_runtime->file_rec_count * sizeof(struct dxt_segment_format);
+    dxt_posix_runtime->record_buf = malloc(buf_size);
     if(!(dxt_posix_runtime->record_buf))
         return;
-    memset(dxt_posix_runtime->record_buf, 0, dxt_posix_runtime->mem_allocated);
+    memset(dxt_posix_runtime->record_buf, 0, buf_size);
     dxt_posix_runtime->record_buf_size = 0;
 
     /* iterate all dxt posix records and serialize them to the output buffer */
     darshan_iter_record_refs(dxt_posix_runtime->rec_id_hash,
-        dxt_serialize_posix_records, NULL);
+        dxt_serialize_records, dxt_posix_runtime);
 
     /* set output */
     *dxt_posix_buf = dxt_posix_runtime->record_buf;
@@ -864,70 +997,30 @@ static void dxt_posix_cleanup()
     return;
 }
 
-static void dxt_serialize_mpiio_records(void *rec_ref_p, void *user_ptr)
-{
-    struct dxt_file_record_ref *rec_ref = (struct dxt_file_record_ref *)rec_ref_p;
-    struct dxt_file_record *file_rec;
-    int64_t record_size = 0;
-    int64_t record_write_count = 0;
-    int64_t record_read_count = 0;
-    void *tmp_buf_ptr;
-
-    assert(rec_ref);
-    file_rec = rec_ref->file_rec;
-    assert(file_rec);
-
-    record_write_count = file_rec->write_count;
-    record_read_count = file_rec->read_count;
-    if (record_write_count == 0 && record_read_count == 0)
-        return;
-
-    /*
-     * Buffer format:
-     * dxt_file_record + write_traces + read_traces
-     */
-    record_size = sizeof(struct dxt_file_record) +
-            (record_write_count + record_read_count) * sizeof(segment_info);
-
-    tmp_buf_ptr = (void *)(dxt_mpiio_runtime->record_buf +
-        dxt_mpiio_runtime->record_buf_size);
-
-    /*Copy struct dxt_file_record */
-    memcpy(tmp_buf_ptr, (void *)file_rec, sizeof(struct dxt_file_record));
-    tmp_buf_ptr = (void *)(tmp_buf_ptr + sizeof(struct dxt_file_record));
-
-    /*Copy write record */
-    memcpy(tmp_buf_ptr, (void *)(rec_ref->write_traces),
-            record_write_count * sizeof(segment_info));
-    tmp_buf_ptr = (void *)(tmp_buf_ptr +
-                record_write_count * sizeof(segment_info));
-
-    /*Copy read record */
-    memcpy(tmp_buf_ptr, (void *)(rec_ref->read_traces),
-            record_read_count * sizeof(segment_info));
-    tmp_buf_ptr = (void *)(tmp_buf_ptr +
-                record_read_count * sizeof(segment_info));
-
-    dxt_mpiio_runtime->record_buf_size += record_size;
-}
-
 static void dxt_mpiio_output(
     void **dxt_mpiio_buf,
     int *dxt_mpiio_buf_sz)
 {
+    size_t buf_size;
+
     assert(dxt_mpiio_runtime);
 
     *dxt_mpiio_buf_sz = 0;
 
-    dxt_mpiio_runtime->record_buf = malloc(dxt_mpiio_runtime->mem_allocated);
+    /* each record's segment format is stored in addition to the memory
+     * DXT accounts for
+     */
+    buf_size = dxt_mpiio_runtime->mem_allocated +
+        dxt_mpiio_runtime->file_rec_count * sizeof(struct dxt_segment_format);
+    dxt_mpiio_runtime->record_buf = malloc(buf_size);
     if(!(dxt_mpiio_runtime->record_buf))
         return;
-    memset(dxt_mpiio_runtime->record_buf, 0, dxt_mpiio_runtime->mem_allocated);
+    memset(dxt_mpiio_runtime->record_buf, 0, buf_size);
     dxt_mpiio_runtime->record_buf_size = 0;
 
     /* iterate all dxt posix records and serialize them to the output buffer */
     darshan_iter_record_refs(dxt_mpiio_runtime->rec_id_hash,
-        dxt_serialize_mpiio_records, NULL);
+        dxt_serialize_records, dxt_mpiio_runtime);
 
     /* set output */
     *dxt_mpiio_buf = dxt_mpiio_runtime->record_buf;
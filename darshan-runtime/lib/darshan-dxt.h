@@ -72,4 +72,12 @@ void dxt_mpiio_read(darshan_record_id rec_id, int64_t offset,
 
 void dxt_posix_apply_trace_filter(struct dxt_trigger *trigger);
 
+/* dxt_set_segment_format()
+ *
+ * Set the segment fields (DXT_SEG_* flags) and time precision (0 for full
+ * precision) written to the log for the DXT module 'mod_id'.
+ */
+void dxt_set_segment_format(darshan_module_id mod_id,
+        struct dxt_segment_format *format);
+
 #endif /* __DARSHAN_DXT_H */
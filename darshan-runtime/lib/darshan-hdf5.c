@@ -78,9 +78,33 @@ struct hdf5_dataset_record_ref
     double last_meta_end;
     void *access_root;
     int access_count;
+    /* dataspace extent and chunk dimensions (slowest varying first) used
+     * to estimate the chunks touched by each access; chunk_ndims is 0 for
+     * datasets that are not chunked, and -1 if the estimate is unavailable
+     */
+    int chunk_ndims;
+    hsize_t dims[H5D_MAX_NDIMS];
+    hsize_t chunk_dims[H5D_MAX_NDIMS];
 #ifdef HAVE_LDMS
     int64_t close_counts;
 #endif
+    /* protects the fields of this record ref and its dataset record */
+    pthread_mutex_t lock;
+};
+
+/* file dataspace selection of an H5Dread/H5Dwrite call; this is queried
+ * before taking any locks, so that threads accessing different datasets
+ * do not serialize on the HDF5 selection queries
+ */
+struct hdf5_selection
+{
+    hssize_t npoints;
+    H5S_sel_type type;
+    int regular; /* set if the regular hyperslab fields below are valid */
+    hsize_t start[H5D_MAX_NDIMS];
+    hsize_t stride[H5D_MAX_NDIMS];
+    hsize_t count[H5D_MAX_NDIMS];
+    hsize_t block[H5D_MAX_NDIMS];
 };
 
 /* struct to encapsulate runtime state for the HDF5 module */
@@ -102,6 +126,16 @@ static struct hdf5_dataset_record_ref *hdf5_track_new_dataset_record(
     darshan_record_id rec_id, const char *rec_name);
 static void hdf5_finalize_dataset_records(
     void *rec_ref_p, void *user_ptr);
+static void hdf5_wait_dataset_record(
+    void *rec_ref_p, void *user_ptr);
+static void hdf5_record_dataset_chunking(
+    struct hdf5_dataset_record_ref *rec_ref, hid_t dset_id, hid_t space_id,
+    hid_t dcpl_id);
+static void hdf5_query_selection(
+    hid_t file_space_id, struct hdf5_selection *sel);
+static void hdf5_record_chunks_touched(
+    struct hdf5_dataset_record_ref *rec_ref, hid_t file_space_id,
+    struct hdf5_selection *sel, int chunks_counter);
 #ifdef HAVE_MPI
 static void hdf5_file_record_reduction_op(
     void* inrec_v, void* inoutrec_v, int *len, MPI_Datatype *datatype);
@@ -136,6 +170,16 @@ static int my_rank = -1;
 #define HDF5_LOCK() pthread_mutex_lock(&hdf5_runtime_mutex)
 #define HDF5_UNLOCK() pthread_mutex_unlock(&hdf5_runtime_mutex)
 
+/* dataset records are updated holding only their own lock, so that threads
+ * accessing different datasets only contend on the module lock while looking
+ * up their records.  A record lock may only be acquired while holding the
+ * module lock (which may then be dropped), and the module lock is never
+ * acquired while holding a record lock.  This lets the shutdown path wait out
+ * any in-progress updates by cycling through the record locks.
+ */
+#define H5D_REC_LOCK(__rec_ref) pthread_mutex_lock(&(__rec_ref)->lock)
+#define H5D_REC_UNLOCK(__rec_ref) pthread_mutex_unlock(&(__rec_ref)->lock)
+
 #define HDF5_WTIME() \
     __darshan_disabled ? 0 : darshan_core_wtime();
 
@@ -487,6 +531,12 @@ herr_t DARSHAN_DECL(H5Fclose)(hid_t file_id)
     HDF5_UNLOCK(); \
 } while(0)
 
+/* note that this macro acquires and releases the module lock itself (using
+ * the PRE/POST_RECORD() macros), holding it only while looking up or
+ * registering the dataset record.  The dataset name is resolved before
+ * taking the lock, and the dataset's properties are queried holding only the
+ * record's lock.
+ */
 #define H5D_RECORD_OPEN(__ret, __loc_id, __name, __type_id, __space_id, __dcpl_id, __use_depr,  __tm1, __tm2) do { \
     char *__file_path, *__tmp_ptr; \
     char __rec_name[DARSHAN_HDF5_MAX_NAME_LEN] = {0}; \
@@ -520,8 +570,14 @@ herr_t DARSHAN_DECL(H5Fclose)(hid_t file_id)
         } \
     } \
     __rec_id = darshan_core_gen_record_id(__rec_name); \
+    H5D_PRE_RECORD(); \
     __rec_ref = darshan_lookup_record_ref(hdf5_dataset_runtime->rec_id_hash, &__rec_id, sizeof(darshan_record_id)); \
     if(!__rec_ref) __rec_ref = hdf5_track_new_dataset_record(__rec_id, __rec_name); \
+    if(__rec_ref) { \
+        darshan_add_record_ref(&(hdf5_dataset_runtime->hid_hash), &__ret, sizeof(hid_t), __rec_ref); \
+        H5D_REC_LOCK(__rec_ref); \
+    } \
+    H5D_POST_RECORD(); \
     if(!__rec_ref) break; \
     __rec_ref->dataset_rec->counters[H5D_OPENS] += 1; \
     __rec_ref->dataset_rec->counters[H5D_USE_DEPRECATED] = __use_depr; \
@@ -540,12 +596,13 @@ herr_t DARSHAN_DECL(H5Fclose)(hid_t file_id)
             __rec_ref->dataset_rec->counters[H5D_CHUNK_SIZE_D1 + __i] = __chunk_dims[__n_chunk_dims - __i - 1]; \
     } \
     __rec_ref->dataset_rec->counters[H5D_DATATYPE_SIZE] = H5Tget_size(__type_id); \
+    hdf5_record_dataset_chunking(__rec_ref, __ret, __space_id, __dcpl_id); \
     __rec_ref->dataset_rec->file_rec_id = __file_rec_id; \
-    darshan_add_record_ref(&(hdf5_dataset_runtime->hid_hash), &__ret, sizeof(hid_t), __rec_ref); \
     /* LDMS to publish runtime h5d tracing information to daemon*/ \
     if(dC.ldms_lib)\
         if(dC.hdf5_enable_ldms)\
             darshan_ldms_connector_send(__rec_ref->dataset_rec->base_rec.id, __rec_ref->dataset_rec->base_rec.rank,__rec_ref->dataset_rec->counters[H5D_OPENS], "open", -1, -1, -1, -1, __rec_ref->dataset_rec->counters[H5D_FLUSHES], __tm1, __tm2, __rec_ref->dataset_rec->fcounters[H5D_F_META_TIME], "H5D", "MET");\
+    H5D_REC_UNLOCK(__rec_ref); \
 } while(0)
 
 hid_t DARSHAN_DECL(H5Dcreate1)(hid_t loc_id, const char *name, hid_t type_id, hid_t space_id, hid_t dcpl_id)
@@ -561,9 +618,7 @@ hid_t DARSHAN_DECL(H5Dcreate1)(hid_t loc_id, const char *name, hid_t type_id, hi
 
     if(ret >= 0)
     {
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, name, type_id, space_id, dcpl_id, 1, tm1, tm2);
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -583,9 +638,7 @@ hid_t DARSHAN_DECL(H5Dcreate2)(hid_t loc_id, const char *name, hid_t dtype_id, h
 
     if(ret >= 0)
     {
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, name, dtype_id, space_id, dcpl_id, 0, tm1, tm2);
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -625,9 +678,7 @@ hid_t DARSHAN_DECL(H5Dopen1)(hid_t loc_id, const char *name)
             return(ret);
         }
 
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, name, dtype_id, space_id, dcpl_id, 1, tm1, tm2);
-        H5D_POST_RECORD();
 
         H5Tclose(dtype_id);
         H5Sclose(space_id);
@@ -671,9 +722,7 @@ hid_t DARSHAN_DECL(H5Dopen2)(hid_t loc_id, const char *name, hid_t dapl_id)
             return(ret);
         }
 
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, name, dtype_id, space_id, dcpl_id, 0, tm1, tm2);
-        H5D_POST_RECORD();
 
         H5Tclose(dtype_id);
         H5Sclose(space_id);
@@ -689,8 +738,8 @@ herr_t DARSHAN_DECL(H5Dread)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spac
     struct hdf5_dataset_record_ref *rec_ref;
     size_t access_size;
     size_t type_size;
-    ssize_t file_sel_npoints;
-    H5S_sel_type file_sel_type;
+    struct hdf5_selection file_sel;
+    int use_collective = 0;
     int64_t common_access_vals[H5D_MAX_NDIMS+H5D_MAX_NDIMS+1] = {0};
     struct darshan_common_val_counter *cvc;
     int i;
@@ -706,45 +755,48 @@ herr_t DARSHAN_DECL(H5Dread)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spac
 
     if(ret >= 0)
     {
+        /* query the selection and transfer mode before taking any locks */
+        hdf5_query_selection(file_space_id, &file_sel);
+#ifdef DARSHAN_HDF5_PAR_BUILD
+        if(xfer_plist_id != H5P_DEFAULT)
+        {
+            herr_t tmp_ret;
+            H5FD_mpio_xfer_t xfer_mode;
+            tmp_ret = H5Pget_dxpl_mpio(xfer_plist_id, &xfer_mode);
+            if(tmp_ret >= 0 && xfer_mode == H5FD_MPIO_COLLECTIVE)
+                use_collective = 1;
+        }
+#endif
+
         H5D_PRE_RECORD();
         rec_ref = darshan_lookup_record_ref(hdf5_dataset_runtime->hid_hash,
             &dataset_id, sizeof(hid_t));
+        if(rec_ref)
+            H5D_REC_LOCK(rec_ref);
+        H5D_POST_RECORD();
+
         if(rec_ref)
         {
             rec_ref->dataset_rec->counters[H5D_READS] += 1;
             if(rec_ref->last_io_type == DARSHAN_IO_WRITE)
                 rec_ref->dataset_rec->counters[H5D_RW_SWITCHES] += 1;
             rec_ref->last_io_type = DARSHAN_IO_READ;
-            if(file_space_id == H5S_ALL)
-            {
-                file_sel_npoints = rec_ref->dataset_rec->counters[H5D_DATASPACE_NPOINTS];
-                file_sel_type = H5S_SEL_ALL;
-            }
-            else
-            {
-                file_sel_npoints = H5Sget_select_npoints(file_space_id);
-                file_sel_type = H5Sget_select_type(file_space_id);
-            }
-            if(file_sel_type == H5S_SEL_POINTS)
+            if(file_sel.type == H5S_SEL_ALL)
+                file_sel.npoints = rec_ref->dataset_rec->counters[H5D_DATASPACE_NPOINTS];
+            if(file_sel.type == H5S_SEL_POINTS)
                 rec_ref->dataset_rec->counters[H5D_POINT_SELECTS] += 1;
-            else if (file_sel_type == H5S_SEL_HYPERSLABS)
+            else if (file_sel.type == H5S_SEL_HYPERSLABS)
             {
 #ifdef HAVE_H5SGET_REGULAR_HYPERSLAB
-                if(H5Sis_regular_hyperslab(file_space_id))
+                if(file_sel.regular)
                 {
-                    hsize_t start_dims[H5D_MAX_NDIMS] = {0};
-                    hsize_t stride_dims[H5D_MAX_NDIMS] = {0};
-                    hsize_t count_dims[H5D_MAX_NDIMS] = {0};
-                    hsize_t block_dims[H5D_MAX_NDIMS] = {0};
                     rec_ref->dataset_rec->counters[H5D_REGULAR_HYPERSLAB_SELECTS] += 1;
-                    H5Sget_regular_hyperslab(file_space_id,
-                        start_dims, stride_dims, count_dims, block_dims);
                     for(i = 0; i < H5D_MAX_NDIMS; i++)
                     {
-                        common_access_vals[1+i] = count_dims[H5D_MAX_NDIMS - i - 1] *
-                            block_dims[H5D_MAX_NDIMS - i - 1];
+                        common_access_vals[1+i] = file_sel.count[H5D_MAX_NDIMS - i - 1] *
+                            file_sel.block[H5D_MAX_NDIMS - i - 1];
                         common_access_vals[1+i+H5D_MAX_NDIMS] =
-                            stride_dims[H5D_MAX_NDIMS - i - 1];
+                            file_sel.stride[H5D_MAX_NDIMS - i - 1];
                     }
                 }
                 else
@@ -758,8 +810,10 @@ herr_t DARSHAN_DECL(H5Dread)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spac
 #endif
             }
             type_size = rec_ref->dataset_rec->counters[H5D_DATATYPE_SIZE];
-            access_size = file_sel_npoints * type_size;
+            access_size = file_sel.npoints * type_size;
             rec_ref->dataset_rec->counters[H5D_BYTES_READ] += access_size;
+            hdf5_record_chunks_touched(rec_ref, file_space_id, &file_sel,
+                H5D_CHUNKS_READ);
             DARSHAN_BUCKET_INC(
                 &(rec_ref->dataset_rec->counters[H5D_SIZE_READ_AGG_0_100]), access_size);
             common_access_vals[0] = access_size;
@@ -769,16 +823,8 @@ herr_t DARSHAN_DECL(H5Dread)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spac
                 &(rec_ref->dataset_rec->counters[H5D_ACCESS1_ACCESS]),
                 &(rec_ref->dataset_rec->counters[H5D_ACCESS1_COUNT]),
                 cvc->vals, cvc->nvals, cvc->freq, 0);
-#ifdef DARSHAN_HDF5_PAR_BUILD
-            if(xfer_plist_id != H5P_DEFAULT)
-            {
-                herr_t tmp_ret;
-                H5FD_mpio_xfer_t xfer_mode;
-                tmp_ret = H5Pget_dxpl_mpio(xfer_plist_id, &xfer_mode);
-                if(tmp_ret >= 0 && xfer_mode == H5FD_MPIO_COLLECTIVE)
-                    rec_ref->dataset_rec->counters[H5D_USE_MPIIO_COLLECTIVE] = 1;
-            }
-#endif
+            if(use_collective)
+                rec_ref->dataset_rec->counters[H5D_USE_MPIIO_COLLECTIVE] = 1;
             if(rec_ref->dataset_rec->fcounters[H5D_F_READ_START_TIMESTAMP] == 0 ||
              rec_ref->dataset_rec->fcounters[H5D_F_READ_START_TIMESTAMP] > tm1)
                 rec_ref->dataset_rec->fcounters[H5D_F_READ_START_TIMESTAMP] = tm1;
@@ -807,8 +853,8 @@ herr_t DARSHAN_DECL(H5Dread)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spac
                 }
             }
 #endif
+            H5D_REC_UNLOCK(rec_ref);
         }
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -820,8 +866,8 @@ herr_t DARSHAN_DECL(H5Dwrite)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spa
     struct hdf5_dataset_record_ref *rec_ref;
     size_t access_size;
     size_t type_size;
-    ssize_t file_sel_npoints;
-    H5S_sel_type file_sel_type;
+    struct hdf5_selection file_sel;
+    int use_collective = 0;
     int64_t common_access_vals[H5D_MAX_NDIMS+H5D_MAX_NDIMS+1] = {0};
     struct darshan_common_val_counter *cvc;
     int i;
@@ -837,45 +883,48 @@ herr_t DARSHAN_DECL(H5Dwrite)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spa
 
     if(ret >= 0)
     {
+        /* query the selection and transfer mode before taking any locks */
+        hdf5_query_selection(file_space_id, &file_sel);
+#ifdef DARSHAN_HDF5_PAR_BUILD
+        if(xfer_plist_id != H5P_DEFAULT)
+        {
+            herr_t tmp_ret;
+            H5FD_mpio_xfer_t xfer_mode;
+            tmp_ret = H5Pget_dxpl_mpio(xfer_plist_id, &xfer_mode);
+            if(tmp_ret >= 0 && xfer_mode == H5FD_MPIO_COLLECTIVE)
+                use_collective = 1;
+        }
+#endif
+
         H5D_PRE_RECORD();
         rec_ref = darshan_lookup_record_ref(hdf5_dataset_runtime->hid_hash,
             &dataset_id, sizeof(hid_t));
+        if(rec_ref)
+            H5D_REC_LOCK(rec_ref);
+        H5D_POST_RECORD();
+
         if(rec_ref)
         {
             rec_ref->dataset_rec->counters[H5D_WRITES] += 1;
             if(rec_ref->last_io_type == DARSHAN_IO_READ)
                 rec_ref->dataset_rec->counters[H5D_RW_SWITCHES] += 1;
             rec_ref->last_io_type = DARSHAN_IO_WRITE;
-            if(file_space_id == H5S_ALL)
-            {
-                file_sel_npoints = rec_ref->dataset_rec->counters[H5D_DATASPACE_NPOINTS];
-                file_sel_type = H5S_SEL_ALL;
-            }
-            else
-            {
-                file_sel_npoints = H5Sget_select_npoints(file_space_id);
-                file_sel_type = H5Sget_select_type(file_space_id);
-            }
-            if(file_sel_type == H5S_SEL_POINTS)
+            if(file_sel.type == H5S_SEL_ALL)
+                file_sel.npoints = rec_ref->dataset_rec->counters[H5D_DATASPACE_NPOINTS];
+            if(file_sel.type == H5S_SEL_POINTS)
                 rec_ref->dataset_rec->counters[H5D_POINT_SELECTS] += 1;
-            else if (file_sel_type == H5S_SEL_HYPERSLABS)
+            else if (file_sel.type == H5S_SEL_HYPERSLABS)
             {
 #ifdef HAVE_H5SGET_REGULAR_HYPERSLAB
-                if(H5Sis_regular_hyperslab(file_space_id))
+                if(file_sel.regular)
                 {
-                    hsize_t start_dims[H5D_MAX_NDIMS] = {0};
-                    hsize_t stride_dims[H5D_MAX_NDIMS] = {0};
-                    hsize_t count_dims[H5D_MAX_NDIMS] = {0};
-                    hsize_t block_dims[H5D_MAX_NDIMS] = {0};
                     rec_ref->dataset_rec->counters[H5D_REGULAR_HYPERSLAB_SELECTS] += 1;
-                    H5Sget_regular_hyperslab(file_space_id,
-                        start_dims, stride_dims, count_dims, block_dims);
                     for(i = 0; i < H5D_MAX_NDIMS; i++)
                     {
-                        common_access_vals[1+i] = count_dims[H5D_MAX_NDIMS - i - 1] *
-                            block_dims[H5D_MAX_NDIMS - i - 1];
+                        common_access_vals[1+i] = file_sel.count[H5D_MAX_NDIMS - i - 1] *
+                            file_sel.block[H5D_MAX_NDIMS - i - 1];
                         common_access_vals[1+i+H5D_MAX_NDIMS] =
-                            stride_dims[H5D_MAX_NDIMS - i - 1];
+                            file_sel.stride[H5D_MAX_NDIMS - i - 1];
                     }
                 }
                 else
@@ -889,8 +938,10 @@ herr_t DARSHAN_DECL(H5Dwrite)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spa
 #endif
             }
             type_size = rec_ref->dataset_rec->counters[H5D_DATATYPE_SIZE];
-            access_size = file_sel_npoints * type_size;
+            access_size = file_sel.npoints * type_size;
             rec_ref->dataset_rec->counters[H5D_BYTES_WRITTEN] += access_size;
+            hdf5_record_chunks_touched(rec_ref, file_space_id, &file_sel,
+                H5D_CHUNKS_WRITTEN);
             DARSHAN_BUCKET_INC(
                 &(rec_ref->dataset_rec->counters[H5D_SIZE_WRITE_AGG_0_100]), access_size);
             common_access_vals[0] = access_size;
@@ -900,16 +951,8 @@ herr_t DARSHAN_DECL(H5Dwrite)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spa
                 &(rec_ref->dataset_rec->counters[H5D_ACCESS1_ACCESS]),
                 &(rec_ref->dataset_rec->counters[H5D_ACCESS1_COUNT]),
                 cvc->vals, cvc->nvals, cvc->freq, 0);
-#ifdef DARSHAN_HDF5_PAR_BUILD
-            if(xfer_plist_id != H5P_DEFAULT)
-            {
-                herr_t tmp_ret;
-                H5FD_mpio_xfer_t xfer_mode;
-                tmp_ret = H5Pget_dxpl_mpio(xfer_plist_id, &xfer_mode);
-                if(tmp_ret >= 0 && xfer_mode == H5FD_MPIO_COLLECTIVE)
-                    rec_ref->dataset_rec->counters[H5D_USE_MPIIO_COLLECTIVE] = 1;
-            }
-#endif
+            if(use_collective)
+                rec_ref->dataset_rec->counters[H5D_USE_MPIIO_COLLECTIVE] = 1;
             if(rec_ref->dataset_rec->fcounters[H5D_F_WRITE_START_TIMESTAMP] == 0 ||
              rec_ref->dataset_rec->fcounters[H5D_F_WRITE_START_TIMESTAMP] > tm1)
                 rec_ref->dataset_rec->fcounters[H5D_F_WRITE_START_TIMESTAMP] = tm1;
@@ -938,8 +981,8 @@ herr_t DARSHAN_DECL(H5Dwrite)(hid_t dataset_id, hid_t mem_type_id, hid_t mem_spa
                 }
             }
 #endif
+            H5D_REC_UNLOCK(rec_ref);
         }
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -963,14 +1006,18 @@ herr_t DARSHAN_DECL(H5Dflush)(hid_t dataset_id)
         H5D_PRE_RECORD();
         rec_ref = darshan_lookup_record_ref(hdf5_dataset_runtime->hid_hash,
             &dataset_id, sizeof(hid_t));
+        if(rec_ref)
+            H5D_REC_LOCK(rec_ref);
+        H5D_POST_RECORD();
+
         if(rec_ref)
         {
             rec_ref->dataset_rec->counters[H5D_FLUSHES] += 1;
             DARSHAN_TIMER_INC_NO_OVERLAP(
                 rec_ref->dataset_rec->fcounters[H5D_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
+            H5D_REC_UNLOCK(rec_ref);
         }
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -992,8 +1039,12 @@ herr_t DARSHAN_DECL(H5Dclose)(hid_t dataset_id)
     if(ret >= 0)
     {
         H5D_PRE_RECORD();
-        rec_ref = darshan_lookup_record_ref(hdf5_dataset_runtime->hid_hash,
+        rec_ref = darshan_delete_record_ref(&(hdf5_dataset_runtime->hid_hash),
             &dataset_id, sizeof(hid_t));
+        if(rec_ref)
+            H5D_REC_LOCK(rec_ref);
+        H5D_POST_RECORD();
+
         if(rec_ref)
         {
             if(rec_ref->dataset_rec->fcounters[H5D_F_CLOSE_START_TIMESTAMP] == 0 ||
@@ -1002,7 +1053,6 @@ herr_t DARSHAN_DECL(H5Dclose)(hid_t dataset_id)
             rec_ref->dataset_rec->fcounters[H5D_F_CLOSE_END_TIMESTAMP] = tm2;
             DARSHAN_TIMER_INC_NO_OVERLAP(rec_ref->dataset_rec->fcounters[H5D_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
-            darshan_delete_record_ref(&(hdf5_dataset_runtime->hid_hash), &dataset_id, sizeof(hid_t));
 
 #ifdef HAVE_LDMS
             rec_ref->close_counts++;
@@ -1011,8 +1061,8 @@ herr_t DARSHAN_DECL(H5Dclose)(hid_t dataset_id)
                 if(dC.hdf5_enable_ldms)
                     darshan_ldms_connector_send(rec_ref->dataset_rec->base_rec.id, rec_ref->dataset_rec->base_rec.rank, rec_ref->close_counts, "close", -1, -1, -1, -1, rec_ref->dataset_rec->counters[H5D_FLUSHES], tm1, tm2, rec_ref->dataset_rec->fcounters[H5D_F_META_TIME], "H5D", "MOD");
 #endif
+            H5D_REC_UNLOCK(rec_ref);
         }
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -1059,9 +1109,7 @@ hid_t DARSHAN_DECL(H5Oopen)(hid_t loc_id, const char *name, hid_t lapl_id)
             return(ret);
         }
 
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, name, dtype_id, space_id, dcpl_id, 0, tm1, tm2);
-        H5D_POST_RECORD();
 
         H5Tclose(dtype_id);
         H5Sclose(space_id);
@@ -1121,9 +1169,7 @@ hid_t DARSHAN_DECL(H5Oopen_by_addr)(hid_t loc_id, haddr_t addr)
             return(ret);
         }
 
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, ds_name, dtype_id, space_id, dcpl_id, 0, tm1, tm2);
-        H5D_POST_RECORD();
 
         H5Tclose(dtype_id);
         H5Sclose(space_id);
@@ -1184,9 +1230,7 @@ hid_t DARSHAN_DECL(H5Oopen_by_idx)(hid_t loc_id, const char * group_name,
             return(ret);
         }
 
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, ds_name, dtype_id, space_id, dcpl_id, 0, tm1, tm2);
-        H5D_POST_RECORD();
 
         H5Tclose(dtype_id);
         H5Sclose(space_id);
@@ -1247,9 +1291,7 @@ hid_t DARSHAN_DECL(H5Oopen_by_token)(hid_t loc_id, H5O_token_t token)
             return(ret);
         }
 
-        H5D_PRE_RECORD();
         H5D_RECORD_OPEN(ret, loc_id, ds_name, dtype_id, space_id, dcpl_id, 0, tm1, tm2);
-        H5D_POST_RECORD();
 
         H5Tclose(dtype_id);
         H5Sclose(space_id);
@@ -1278,8 +1320,12 @@ herr_t DARSHAN_DECL(H5Oclose)(hid_t object_id)
         /* no need to check if object is a dataset, we just look for it
          * in our hash of open dataset IDs
          */
-        rec_ref = darshan_lookup_record_ref(hdf5_dataset_runtime->hid_hash,
+        rec_ref = darshan_delete_record_ref(&(hdf5_dataset_runtime->hid_hash),
             &object_id, sizeof(hid_t));
+        if(rec_ref)
+            H5D_REC_LOCK(rec_ref);
+        H5D_POST_RECORD();
+
         if(rec_ref)
         {
             if(rec_ref->dataset_rec->fcounters[H5D_F_CLOSE_START_TIMESTAMP] == 0 ||
@@ -1288,9 +1334,8 @@ herr_t DARSHAN_DECL(H5Oclose)(hid_t object_id)
             rec_ref->dataset_rec->fcounters[H5D_F_CLOSE_END_TIMESTAMP] = tm2;
             DARSHAN_TIMER_INC_NO_OVERLAP(rec_ref->dataset_rec->fcounters[H5D_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
-            darshan_delete_record_ref(&(hdf5_dataset_runtime->hid_hash), &object_id, sizeof(hid_t));
+            H5D_REC_UNLOCK(rec_ref);
         }
-        H5D_POST_RECORD();
     }
 
     return(ret);
@@ -1472,6 +1517,7 @@ static struct hdf5_dataset_record_ref *hdf5_track_new_dataset_record(
     dataset_rec->base_rec.id = rec_id;
     dataset_rec->base_rec.rank = my_rank;
     rec_ref->dataset_rec = dataset_rec;
+    pthread_mutex_init(&rec_ref->lock, NULL);
     hdf5_dataset_runtime->rec_count++;
 
 #ifndef HAVE_H5DFLUSH
@@ -1485,12 +1531,245 @@ static struct hdf5_dataset_record_ref *hdf5_track_new_dataset_record(
     return(rec_ref);
 }
 
+/* record chunk cache and filter configuration of a newly opened dataset, and
+ * cache its extent and chunk dimensions for estimating chunks touched later
+ */
+static void hdf5_record_dataset_chunking(
+    struct hdf5_dataset_record_ref *rec_ref, hid_t dset_id, hid_t space_id,
+    hid_t dcpl_id)
+{
+    int64_t *counters = rec_ref->dataset_rec->counters;
+    hid_t dapl_id;
+    size_t nslots, nbytes;
+    double w0;
+    unsigned int flags;
+    size_t cd_nelmts;
+    H5Z_filter_t filter;
+    int nfilters;
+    int ndims;
+    int i;
+
+    rec_ref->chunk_ndims = 0;
+    if(dcpl_id == H5P_DEFAULT || H5Pget_layout(dcpl_id) != H5D_CHUNKED)
+        return;
+
+    /* filters are only applicable to chunked datasets */
+    nfilters = H5Pget_nfilters(dcpl_id);
+    if(nfilters >= 0)
+    {
+        counters[H5D_FILTERS] = nfilters;
+        counters[H5D_COMPRESSION] = 0;
+        for(i = 0; i < nfilters; i++)
+        {
+            cd_nelmts = 0;
+            filter = H5Pget_filter2(dcpl_id, i, &flags, &cd_nelmts, NULL, 0,
+                NULL, NULL);
+            /* shuffle and checksum filters do not reduce data size */
+            if(filter >= 0 && filter != H5Z_FILTER_SHUFFLE &&
+               filter != H5Z_FILTER_FLETCHER32)
+                counters[H5D_COMPRESSION] = 1;
+        }
+    }
+
+    /* the access property list reflects the chunk cache actually in use,
+     * including any defaults inherited from the file access property list
+     */
+    dapl_id = H5Dget_access_plist(dset_id);
+    if(dapl_id >= 0)
+    {
+        if(H5Pget_chunk_cache(dapl_id, &nslots, &nbytes, &w0) >= 0)
+        {
+            counters[H5D_CHUNK_CACHE_NSLOTS] = nslots;
+            counters[H5D_CHUNK_CACHE_NBYTES] = nbytes;
+        }
+        H5Pclose(dapl_id);
+    }
+
+    ndims = H5Sget_simple_extent_ndims(space_id);
+    if(ndims <= 0 || ndims > H5D_MAX_NDIMS ||
+       H5Sget_simple_extent_dims(space_id, rec_ref->dims, NULL) != ndims ||
+       H5Pget_chunk(dcpl_id, H5D_MAX_NDIMS, rec_ref->chunk_dims) != ndims)
+    {
+        rec_ref->chunk_ndims = -1;
+        return;
+    }
+    for(i = 0; i < ndims; i++)
+    {
+        if(rec_ref->chunk_dims[i] == 0)
+        {
+            rec_ref->chunk_ndims = -1;
+            return;
+        }
+    }
+    rec_ref->chunk_ndims = ndims;
+
+    return;
+}
+
+#ifdef HAVE_H5SGET_REGULAR_HYPERSLAB
+/* upper bound on the number of hyperslab blocks examined per dimension when
+ * counting chunks touched by a regular hyperslab selection
+ */
+#define H5D_MAX_CHUNK_SCAN_BLOCKS 4096
+
+/* count the distinct chunk indices covered by a regular hyperslab selection
+ * along a single dimension, falling back to the bounding range if the
+ * selection has too many blocks to examine cheaply
+ */
+static int64_t hdf5_regular_dim_chunks(
+    hsize_t start, hsize_t stride, hsize_t count, hsize_t block,
+    hsize_t chunk)
+{
+    hsize_t first, last, prev_last = 0;
+    int64_t nchunks = 0;
+    hsize_t k;
+
+    if(count == 0 || block == 0)
+        return(0);
+    if(count == 1 || stride <= block || count > H5D_MAX_CHUNK_SCAN_BLOCKS)
+    {
+        first = start / chunk;
+        last = (start + (count - 1) * stride + block - 1) / chunk;
+        return(last - first + 1);
+    }
+
+    /* blocks are visited in increasing order, so chunk ranges only ever
+     * overlap with the range of the preceding block
+     */
+    for(k = 0; k < count; k++)
+    {
+        first = (start + k * stride) / chunk;
+        last = (start + k * stride + block - 1) / chunk;
+        if(k > 0 && first <= prev_last)
+            first = prev_last + 1;
+        if(last >= first)
+            nchunks += last - first + 1;
+        if(k == 0 || last > prev_last)
+            prev_last = last;
+    }
+
+    return(nchunks);
+}
+#endif
+
+/* query the file dataspace selection of a dataset access; the number of
+ * points in H5S_ALL selections is left to be filled in from the dataset record
+ */
+static void hdf5_query_selection(
+    hid_t file_space_id, struct hdf5_selection *sel)
+{
+    memset(sel, 0, sizeof(*sel));
+    if(file_space_id == H5S_ALL)
+    {
+        sel->type = H5S_SEL_ALL;
+        return;
+    }
+
+    sel->npoints = H5Sget_select_npoints(file_space_id);
+    sel->type = H5Sget_select_type(file_space_id);
+#ifdef HAVE_H5SGET_REGULAR_HYPERSLAB
+    if(sel->type == H5S_SEL_HYPERSLABS &&
+       H5Sis_regular_hyperslab(file_space_id) > 0 &&
+       H5Sget_regular_hyperslab(file_space_id, sel->start, sel->stride,
+           sel->count, sel->block) >= 0)
+        sel->regular = 1;
+#endif
+
+    return;
+}
+
+/* estimate the number of chunks touched by a dataset access, and whether
+ * that working set exceeds the dataset's chunk cache
+ */
+static void hdf5_record_chunks_touched(
+    struct hdf5_dataset_record_ref *rec_ref, hid_t file_space_id,
+    struct hdf5_selection *sel, int chunks_counter)
+{
+    int64_t *counters = rec_ref->dataset_rec->counters;
+    hsize_t start[H5D_MAX_NDIMS];
+    hsize_t end[H5D_MAX_NDIMS];
+    int64_t nchunks = 1;
+    int64_t chunk_bytes;
+    int i;
+
+    if(rec_ref->chunk_ndims == 0 || counters[chunks_counter] < 0)
+        return;
+    if(rec_ref->chunk_ndims < 0 || sel->npoints < 0)
+    {
+        counters[chunks_counter] = -1;
+        return;
+    }
+    if(sel->npoints == 0 || sel->type == H5S_SEL_NONE)
+        return;
+
+    if(sel->type == H5S_SEL_ALL)
+    {
+        for(i = 0; i < rec_ref->chunk_ndims; i++)
+        {
+            start[i] = 0;
+            end[i] = rec_ref->dims[i] ? rec_ref->dims[i] - 1 : 0;
+        }
+    }
+    else if(H5Sget_simple_extent_ndims(file_space_id) != rec_ref->chunk_ndims ||
+            H5Sget_select_bounds(file_space_id, start, end) < 0)
+    {
+        counters[chunks_counter] = -1;
+        return;
+    }
+
+    /* chunks intersecting the bounding box of the selection */
+    for(i = 0; i < rec_ref->chunk_ndims; i++)
+        nchunks *= end[i] / rec_ref->chunk_dims[i] -
+            start[i] / rec_ref->chunk_dims[i] + 1;
+
+#ifdef HAVE_H5SGET_REGULAR_HYPERSLAB
+    /* strided selections may skip over chunks inside the bounding box */
+    if(sel->regular)
+    {
+        nchunks = 1;
+        for(i = 0; i < rec_ref->chunk_ndims; i++)
+            nchunks *= hdf5_regular_dim_chunks(sel->start[i], sel->stride[i],
+                sel->count[i], sel->block[i], rec_ref->chunk_dims[i]);
+    }
+#endif
+
+    /* every selected element lies in exactly one chunk */
+    if(nchunks > sel->npoints)
+        nchunks = sel->npoints;
+    counters[chunks_counter] += nchunks;
+
+    chunk_bytes = counters[H5D_DATATYPE_SIZE];
+    for(i = 0; i < rec_ref->chunk_ndims; i++)
+        chunk_bytes *= rec_ref->chunk_dims[i];
+    if(counters[H5D_CHUNK_CACHE_NBYTES] > 0 &&
+       counters[H5D_CHUNK_CACHE_OVERFLOWS] >= 0 &&
+       nchunks * chunk_bytes > counters[H5D_CHUNK_CACHE_NBYTES])
+        counters[H5D_CHUNK_CACHE_OVERFLOWS] += 1;
+
+    return;
+}
+
 static void hdf5_finalize_dataset_records(void *rec_ref_p, void *user_ptr)
 {
     struct hdf5_dataset_record_ref *rec_ref =
         (struct hdf5_dataset_record_ref *)rec_ref_p;
 
     tdestroy(rec_ref->access_root, free);
+    pthread_mutex_destroy(&rec_ref->lock);
+    return;
+}
+
+/* wait for any thread still updating the given dataset record to finish;
+ * must be called with the module lock held, after which no thread can
+ * acquire the record lock until the module lock is released
+ */
+static void hdf5_wait_dataset_record(void *rec_ref_p, void *user_ptr)
+{
+    struct hdf5_dataset_record_ref *rec_ref =
+        (struct hdf5_dataset_record_ref *)rec_ref_p;
+
+    H5D_REC_LOCK(rec_ref);
+    H5D_REC_UNLOCK(rec_ref);
     return;
 }
 
@@ -1633,6 +1912,24 @@ static void hdf5_dataset_record_reduction_op(void* inrec_v, void* inoutrec_v,
                 inrec->counters[H5D_USE_DEPRECATED] == 1)
             tmp_dataset.counters[H5D_USE_DEPRECATED] = 1;
 
+        /* max (chunk cache and filter configuration) */
+        for(j=H5D_CHUNK_CACHE_NBYTES; j<=H5D_COMPRESSION; j++)
+        {
+            if(inrec->counters[j] > inoutrec->counters[j])
+                tmp_dataset.counters[j] = inrec->counters[j];
+            else
+                tmp_dataset.counters[j] = inoutrec->counters[j];
+        }
+
+        /* sum (if available) */
+        for(j=H5D_CHUNKS_READ; j<=H5D_CHUNK_CACHE_OVERFLOWS; j++)
+        {
+            if(inrec->counters[j] < 0 || inoutrec->counters[j] < 0)
+                tmp_dataset.counters[j] = -1;
+            else
+                tmp_dataset.counters[j] = inrec->counters[j] + inoutrec->counters[j];
+        }
+
         /* min non-zero (if available) value */
         for(j=H5D_F_OPEN_START_TIMESTAMP; j<=H5D_F_CLOSE_START_TIMESTAMP; j++)
         {
@@ -1937,6 +2234,10 @@ static void hdf5_dataset_mpi_redux(
     HDF5_LOCK();
     assert(hdf5_dataset_runtime);
 
+    /* wait out any updates to dataset records that are still in progress */
+    darshan_iter_record_refs(hdf5_dataset_runtime->rec_id_hash,
+        &hdf5_wait_dataset_record, NULL);
+
     rec_count = hdf5_dataset_runtime->rec_count;
 
     /* necessary initialization of shared records */
@@ -2066,7 +2367,12 @@ static void hdf5_dataset_output(
     rec_count = hdf5_dataset_runtime->rec_count;
     *hdf5_buf_sz = rec_count * sizeof(struct darshan_hdf5_dataset);
 
+    /* no new updates can start once the counters are frozen, so this is
+     * the last time we need to wait for updates in progress
+     */
     hdf5_dataset_runtime->frozen = 1;
+    darshan_iter_record_refs(hdf5_dataset_runtime->rec_id_hash,
+        &hdf5_wait_dataset_record, NULL);
 
     HDF5_UNLOCK();
     return;
@@ -0,0 +1,440 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <darshan-runtime-config.h>
+#endif
+
+#define _XOPEN_SOURCE 500
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <assert.h>
+#include <stdint.h>
+
+#include "darshan.h"
+#include "darshan-imbalance.h"
+
+/*
+ * Job-level module which keeps, for records shared by all ranks, the
+ * distribution across nodes (or ranks) of I/O time and bytes moved.  The
+ * POSIX, MPI-IO and STDIO modules only keep the fastest and slowest rank
+ * and a variance of their shared records, which cannot tell a single
+ * straggler node apart from a bimodal split or a long tail.
+ *
+ * This module does not intercept any functions and has no records of its
+ * own until shutdown: the shared record reductions of the other modules
+ * call imbalance_reduce(), which reduces the samples of each rank and
+ * leaves the resulting records on rank 0.  The IMBALANCE module is ordered
+ * after those modules, so its records are ready by the time its output
+ * function is called.  Records are named by the id of the shared record
+ * they describe, whose name is already stored by the other module.
+ */
+
+struct imbalance_runtime
+{
+    struct darshan_imbalance_record *recs;
+    int rec_count;
+    int rec_max;
+    int by_node;
+};
+
+/* the slowest units of a shared record, slowest first */
+struct imbalance_slowest
+{
+    double time[IMBALANCE_NUM_SLOWEST];
+    int64_t rank[IMBALANCE_NUM_SLOWEST];
+    int64_t bytes[IMBALANCE_NUM_SLOWEST];
+};
+
+static struct imbalance_runtime *imbalance_runtime = NULL;
+static pthread_mutex_t imbalance_runtime_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* my_rank indicates the MPI rank of this process */
+static int my_rank = -1;
+
+/* internal helper functions for the IMBALANCE module */
+void imbalance_runtime_initialize(void);
+
+/* forward declaration for functions needed to interface with darshan-core */
+static void imbalance_output(
+    void **buffer,
+    int *size);
+static void imbalance_cleanup(
+    void);
+
+/* macros for obtaining/releasing the IMBALANCE module lock */
+#define IMBALANCE_LOCK() pthread_mutex_lock(&imbalance_runtime_mutex)
+#define IMBALANCE_UNLOCK() pthread_mutex_unlock(&imbalance_runtime_mutex)
+
+/*************************************************************
+ * Internal functions for manipulating IMBALANCE module state *
+ *************************************************************/
+
+void imbalance_runtime_initialize()
+{
+    int ret;
+    size_t imbalance_rec_count;
+    char *envstr;
+    darshan_module_funcs mod_funcs = {
+        .mod_output_func = &imbalance_output,
+        .mod_cleanup_func = &imbalance_cleanup
+        };
+
+    IMBALANCE_LOCK();
+
+    /* don't do anything if already initialized */
+    if(imbalance_runtime)
+    {
+        IMBALANCE_UNLOCK();
+        return;
+    }
+
+    /* records are only created at shutdown time, in memory owned by this
+     * module, so nothing is requested from the darshan-core memory pool
+     */
+    imbalance_rec_count = 0;
+
+    /* register the IMBALANCE module with the darshan-core component */
+    ret = darshan_core_register_module(
+        DARSHAN_IMBALANCE_MOD,
+        mod_funcs,
+        sizeof(struct darshan_imbalance_record),
+        &imbalance_rec_count,
+        &my_rank,
+        NULL);
+    if(ret < 0)
+    {
+        IMBALANCE_UNLOCK();
+        return;
+    }
+
+    /* initialize module's global state */
+    imbalance_runtime = malloc(sizeof(*imbalance_runtime));
+    if(!imbalance_runtime)
+    {
+        darshan_core_unregister_module(DARSHAN_IMBALANCE_MOD);
+        IMBALANCE_UNLOCK();
+        return;
+    }
+    memset(imbalance_runtime, 0, sizeof(*imbalance_runtime));
+
+    /* distributions are taken across nodes unless ranks are requested */
+    imbalance_runtime->by_node = 1;
+    envstr = getenv("DARSHAN_IMBALANCE_UNIT");
+    if(envstr)
+    {
+        if(strcmp(envstr, "rank") == 0)
+            imbalance_runtime->by_node = 0;
+        else if(strcmp(envstr, "node") != 0)
+            darshan_core_fprintf(stderr, "darshan library warning: "
+                "unknown DARSHAN_IMBALANCE_UNIT \"%s\" (expected node or rank)\n",
+                envstr);
+    }
+
+    IMBALANCE_UNLOCK();
+    return;
+}
+
+int imbalance_enabled()
+{
+    int enabled;
+
+    IMBALANCE_LOCK();
+    enabled = (imbalance_runtime != NULL);
+    IMBALANCE_UNLOCK();
+
+    return(enabled);
+}
+
+#ifdef HAVE_MPI
+/* histogram bin of 'val' relative to the largest value 'max' */
+static int imbalance_bin(double val, double max)
+{
+    int bin;
+
+    if(max <= 0)
+        return(0);
+
+    bin = (int)(val / max * IMBALANCE_NUM_BINS);
+    if(bin < 0)
+        bin = 0;
+    else if(bin >= IMBALANCE_NUM_BINS)
+        bin = IMBALANCE_NUM_BINS - 1;
+
+    return(bin);
+}
+
+/* merge the slowest units of two sets of shared records, keeping the
+ * slowest IMBALANCE_NUM_SLOWEST of each (ties go to the lowest rank)
+ */
+static void imbalance_slowest_reduction_op(
+    void* in_v,
+    void* inout_v,
+    int *len,
+    MPI_Datatype *datatype)
+{
+    struct imbalance_slowest *in = in_v;
+    struct imbalance_slowest *inout = inout_v;
+    struct imbalance_slowest tmp;
+    int i, j, a, b;
+    int take_a;
+
+    for(i = 0; i < *len; i++)
+    {
+        a = b = 0;
+        for(j = 0; j < IMBALANCE_NUM_SLOWEST; j++)
+        {
+            if(in[i].rank[a] < 0)
+                take_a = 0;
+            else if(inout[i].rank[b] < 0)
+                take_a = 1;
+            else
+                take_a = (in[i].time[a] > inout[i].time[b]) ||
+                    (in[i].time[a] == inout[i].time[b] &&
+                     in[i].rank[a] < inout[i].rank[b]);
+
+            if(take_a)
+            {
+                tmp.time[j] = in[i].time[a];
+                tmp.rank[j] = in[i].rank[a];
+                tmp.bytes[j] = in[i].bytes[a];
+                a++;
+            }
+            else
+            {
+                tmp.time[j] = inout[i].time[b];
+                tmp.rank[j] = inout[i].rank[b];
+                tmp.bytes[j] = inout[i].bytes[b];
+                b++;
+            }
+        }
+        inout[i] = tmp;
+    }
+
+    return;
+}
+
+void imbalance_reduce(darshan_module_id mod_id, MPI_Comm mod_comm,
+    struct darshan_imbalance_sample *samples, int count)
+{
+    MPI_Comm node_comm = MPI_COMM_NULL;
+    MPI_Comm unit_comm = MPI_COMM_NULL;
+    MPI_Datatype slowest_type;
+    MPI_Op slowest_op;
+    struct darshan_imbalance_record *rec, *tmp_recs;
+    struct imbalance_slowest *slowest = NULL;
+    struct imbalance_slowest *slowest_out = NULL;
+    double *times = NULL, *unit_times = NULL, *max_times = NULL;
+    double *sum_times = NULL;
+    int64_t *bytes = NULL, *unit_bytes = NULL, *max_bytes = NULL;
+    int64_t *hist = NULL, *hist_out = NULL;
+    int node_rank = 0;
+    int unit_rank;
+    int nunits;
+    int i, j;
+
+    IMBALANCE_LOCK();
+    if(!imbalance_runtime || count <= 0)
+    {
+        IMBALANCE_UNLOCK();
+        return;
+    }
+
+    times = malloc(count * sizeof(*times));
+    bytes = malloc(count * sizeof(*bytes));
+    unit_times = malloc(count * sizeof(*unit_times));
+    unit_bytes = malloc(count * sizeof(*unit_bytes));
+    max_times = malloc(count * sizeof(*max_times));
+    max_bytes = malloc(count * sizeof(*max_bytes));
+    sum_times = malloc(count * sizeof(*sum_times));
+    hist = malloc(count * 2 * IMBALANCE_NUM_BINS * sizeof(*hist));
+    hist_out = malloc(count * 2 * IMBALANCE_NUM_BINS * sizeof(*hist_out));
+    slowest = malloc(count * sizeof(*slowest));
+    slowest_out = malloc(count * sizeof(*slowest_out));
+    /* NOTE: every rank must take part in the reductions below, so failing
+     * here would hang the job if other ranks succeed
+     */
+    assert(times && bytes && unit_times && unit_bytes && max_times &&
+        max_bytes && sum_times && hist && hist_out && slowest && slowest_out);
+
+    for(i = 0; i < count; i++)
+    {
+        times[i] = samples[i].time;
+        bytes[i] = samples[i].bytes;
+    }
+
+    if(imbalance_runtime->by_node)
+    {
+        /* the time of a node is that of its slowest rank, and its bytes are
+         * the total of its ranks; the lowest rank of each node stands for it
+         */
+        PMPI_Comm_split_type(mod_comm, MPI_COMM_TYPE_SHARED, my_rank,
+            MPI_INFO_NULL, &node_comm);
+        PMPI_Comm_rank(node_comm, &node_rank);
+        PMPI_Reduce(times, unit_times, count, MPI_DOUBLE, MPI_MAX, 0,
+            node_comm);
+        PMPI_Reduce(bytes, unit_bytes, count, MPI_INT64_T, MPI_SUM, 0,
+            node_comm);
+        PMPI_Comm_split(mod_comm, (node_rank == 0) ? 0 : MPI_UNDEFINED,
+            my_rank, &unit_comm);
+        PMPI_Comm_free(&node_comm);
+        if(node_rank != 0)
+            goto done;
+    }
+    else
+    {
+        memcpy(unit_times, times, count * sizeof(*times));
+        memcpy(unit_bytes, bytes, count * sizeof(*bytes));
+        PMPI_Comm_dup(mod_comm, &unit_comm);
+    }
+    PMPI_Comm_size(unit_comm, &nunits);
+    PMPI_Comm_rank(unit_comm, &unit_rank);
+
+    /* histograms are relative to the largest time and bytes of any unit */
+    PMPI_Allreduce(unit_times, max_times, count, MPI_DOUBLE, MPI_MAX,
+        unit_comm);
+    PMPI_Allreduce(unit_bytes, max_bytes, count, MPI_INT64_T, MPI_MAX,
+        unit_comm);
+
+    memset(hist, 0, count * 2 * IMBALANCE_NUM_BINS * sizeof(*hist));
+    for(i = 0; i < count; i++)
+    {
+        hist[i * 2 * IMBALANCE_NUM_BINS +
+            imbalance_bin(unit_times[i], max_times[i])] = 1;
+        hist[i * 2 * IMBALANCE_NUM_BINS + IMBALANCE_NUM_BINS +
+            imbalance_bin((double)unit_bytes[i], (double)max_bytes[i])] = 1;
+
+        slowest[i].time[0] = unit_times[i];
+        slowest[i].rank[0] = my_rank;
+        slowest[i].bytes[0] = unit_bytes[i];
+        for(j = 1; j < IMBALANCE_NUM_SLOWEST; j++)
+        {
+            slowest[i].time[j] = -1;
+            slowest[i].rank[j] = -1;
+            slowest[i].bytes[j] = -1;
+        }
+    }
+    PMPI_Reduce(hist, hist_out, count * 2 * IMBALANCE_NUM_BINS, MPI_INT64_T,
+        MPI_SUM, 0, unit_comm);
+    PMPI_Reduce(unit_times, sum_times, count, MPI_DOUBLE, MPI_SUM, 0,
+        unit_comm);
+
+    PMPI_Type_contiguous(sizeof(struct imbalance_slowest), MPI_BYTE,
+        &slowest_type);
+    PMPI_Type_commit(&slowest_type);
+    PMPI_Op_create(imbalance_slowest_reduction_op, 1, &slowest_op);
+    PMPI_Reduce(slowest, slowest_out, count, slowest_type, slowest_op, 0,
+        unit_comm);
+    PMPI_Type_free(&slowest_type);
+    PMPI_Op_free(&slowest_op);
+
+    /* the lowest rank of the job is also the lowest unit, so rank 0 ends up
+     * with the results; a distribution over a single unit is of no interest
+     */
+    if(unit_rank != 0 || nunits < 2)
+        goto done;
+
+    if(imbalance_runtime->rec_count + count > imbalance_runtime->rec_max)
+    {
+        tmp_recs = realloc(imbalance_runtime->recs,
+            (imbalance_runtime->rec_count + count) * sizeof(*tmp_recs));
+        if(!tmp_recs)
+            goto done;
+        imbalance_runtime->recs = tmp_recs;
+        imbalance_runtime->rec_max = imbalance_runtime->rec_count + count;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        rec = &imbalance_runtime->recs[imbalance_runtime->rec_count++];
+        memset(rec, 0, sizeof(*rec));
+        rec->base_rec.id = samples[i].id;
+        rec->base_rec.rank = -1;
+        rec->counters[IMBALANCE_MODULE] = mod_id;
+        rec->counters[IMBALANCE_BY_NODE] = imbalance_runtime->by_node;
+        rec->counters[IMBALANCE_UNITS] = nunits;
+        rec->counters[IMBALANCE_MAX_BYTES] = max_bytes[i];
+        for(j = 0; j < IMBALANCE_NUM_BINS; j++)
+        {
+            rec->counters[IMBALANCE_TIME_BIN_0 + j] =
+                hist_out[i * 2 * IMBALANCE_NUM_BINS + j];
+            rec->counters[IMBALANCE_BYTES_BIN_0 + j] =
+                hist_out[i * 2 * IMBALANCE_NUM_BINS + IMBALANCE_NUM_BINS + j];
+        }
+        for(j = 0; j < IMBALANCE_NUM_SLOWEST; j++)
+        {
+            rec->counters[IMBALANCE_SLOWEST_1_RANK + j] = slowest_out[i].rank[j];
+            rec->counters[IMBALANCE_SLOWEST_1_BYTES + j] = slowest_out[i].bytes[j];
+            rec->fcounters[IMBALANCE_F_SLOWEST_1_TIME + j] = slowest_out[i].time[j];
+        }
+        rec->fcounters[IMBALANCE_F_MAX_TIME] = max_times[i];
+        rec->fcounters[IMBALANCE_F_MEAN_TIME] = sum_times[i] / nunits;
+    }
+
+done:
+    if(unit_comm != MPI_COMM_NULL)
+        PMPI_Comm_free(&unit_comm);
+    free(times);
+    free(bytes);
+    free(unit_times);
+    free(unit_bytes);
+    free(max_times);
+    free(max_bytes);
+    free(sum_times);
+    free(hist);
+    free(hist_out);
+    free(slowest);
+    free(slowest_out);
+
+    IMBALANCE_UNLOCK();
+    return;
+}
+#endif
+
+/********************************************************************************
+ * shutdown functions exported by this module for coordinating with darshan-core *
+ ********************************************************************************/
+
+static void imbalance_output(
+    void **buffer,
+    int *size)
+{
+    IMBALANCE_LOCK();
+    assert(imbalance_runtime);
+
+    /* hand over the records reduced on rank 0 (other ranks have none) */
+    *buffer = imbalance_runtime->recs;
+    *size = imbalance_runtime->rec_count * sizeof(struct darshan_imbalance_record);
+
+    IMBALANCE_UNLOCK();
+    return;
+}
+
+static void imbalance_cleanup()
+{
+    IMBALANCE_LOCK();
+    assert(imbalance_runtime);
+
+    free(imbalance_runtime->recs);
+    free(imbalance_runtime);
+    imbalance_runtime = NULL;
+
+    IMBALANCE_UNLOCK();
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
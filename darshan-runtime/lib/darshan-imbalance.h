@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_IMBALANCE_H
+#define __DARSHAN_IMBALANCE_H
+
+/* I/O time and bytes moved by this rank for a shared record */
+struct darshan_imbalance_sample
+{
+    darshan_record_id id;
+    double time;
+    int64_t bytes;
+};
+
+#ifdef DARSHAN_IMBALANCE
+
+/* imbalance_enabled()
+ *
+ * returns 1 if the IMBALANCE module is recording distributions of shared
+ * records, 0 otherwise.  The result is the same on every rank.
+ */
+int imbalance_enabled(void);
+
+#ifdef HAVE_MPI
+/* imbalance_reduce()
+ *
+ * collectively computes the distribution across nodes (or ranks) of the
+ * I/O time and bytes of 'count' records shared by all ranks of 'mod_comm',
+ * given this rank's 'samples' of them (in the same order on every rank).
+ * The results are stored in the log by rank 0 as IMBALANCE records
+ * attributed to module 'mod_id'.  Must be called by all ranks of 'mod_comm'
+ * from the module's shared record reduction.
+ */
+void imbalance_reduce(darshan_module_id mod_id, MPI_Comm mod_comm,
+    struct darshan_imbalance_sample *samples, int count);
+#endif
+
+#else
+
+/* provide stubs when the IMBALANCE module is disabled so that
+ * instrumentation modules calling into it do not need preprocessor guards
+ */
+#define imbalance_enabled() 0
+
+#define imbalance_reduce(mod_id, mod_comm, samples, count) do {} while(0)
+
+#endif
+
+#endif /* __DARSHAN_IMBALANCE_H */
@@ -29,6 +29,7 @@
 #include "darshan-dynamic.h"
 #include "darshan-dxt.h"
 #include "darshan-heatmap.h"
+#include "darshan-imbalance.h"
 #include "darshan-ldms.h"
 
 DARSHAN_FORWARD_DECL(PMPI_File_close, int, (MPI_File *fh));
@@ -116,6 +117,16 @@ DARSHAN_FORWARD_DECL(PMPI_File_write_shared, int, (MPI_File fh, const void *buf,
 DARSHAN_FORWARD_DECL(PMPI_File_write_shared, int, (MPI_File fh, void *buf, int count, MPI_Datatype datatype, MPI_Status *status));
 #endif
 
+DARSHAN_FORWARD_DECL(PMPI_Wait, int, (MPI_Request *request, MPI_Status *status));
+DARSHAN_FORWARD_DECL(PMPI_Test, int, (MPI_Request *request, int *flag, MPI_Status *status));
+DARSHAN_FORWARD_DECL(PMPI_Waitall, int, (int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]));
+DARSHAN_FORWARD_DECL(PMPI_Testall, int, (int count, MPI_Request array_of_requests[], int *flag, MPI_Status array_of_statuses[]));
+DARSHAN_FORWARD_DECL(PMPI_Waitany, int, (int count, MPI_Request array_of_requests[], int *index, MPI_Status *status));
+DARSHAN_FORWARD_DECL(PMPI_Testany, int, (int count, MPI_Request array_of_requests[], int *index, int *flag, MPI_Status *status));
+DARSHAN_FORWARD_DECL(PMPI_Waitsome, int, (int incount, MPI_Request array_of_requests[], int *outcount, int array_of_indices[], MPI_Status array_of_statuses[]));
+DARSHAN_FORWARD_DECL(PMPI_Testsome, int, (int incount, MPI_Request array_of_requests[], int *outcount, int array_of_indices[], MPI_Status array_of_statuses[]));
+DARSHAN_FORWARD_DECL(PMPI_Request_free, int, (MPI_Request *request));
+
 /* The mpiio_file_record_ref structure maintains necessary runtime metadata
  * for the MPIIO file record (darshan_mpiio_file structure, defined in
  * darshan-mpiio-log-format.h) pointed to by 'file_rec'. This metadata
@@ -145,6 +156,10 @@ struct mpiio_file_record_ref
     double last_meta_end;
     double last_read_end;
     double last_write_end;
+    double last_nb_read_end;
+    double last_nb_write_end;
+    double last_nb_wait_end;
+    double last_nb_overlap_end;
     void *access_root;
     int access_count;
 #ifdef HAVE_LDMS
@@ -152,6 +167,21 @@ struct mpiio_file_record_ref
 #endif
 };
 
+/* The mpiio_nb_request_ref structure tracks a posted nonblocking MPI-IO
+ * operation until its request is completed by one of the MPI_Wait or
+ * MPI_Test family of functions. These structures are indexed by MPI
+ * request handle in the runtime's req_hash.
+ */
+struct mpiio_nb_request_ref
+{
+    struct mpiio_file_record_ref *rec_ref;
+    enum darshan_io_type io_type;
+    int64_t offset;
+    int64_t length;
+    double post_start;
+    double post_end;
+};
+
 /* The mpiio_runtime structure maintains necessary state for storing
  * MPI-IO file records and for coordinating with darshan-core at
  * shutdown time.
@@ -160,6 +190,7 @@ struct mpiio_runtime
 {
     void *rec_id_hash;
     void *fh_hash;
+    void *req_hash;
     int file_rec_count;
     darshan_record_id heatmap_id;
     int frozen; /* flag to indicate that the counters should no longer be modified */
@@ -171,12 +202,22 @@ static struct mpiio_file_record_ref *mpiio_track_new_file_record(
     darshan_record_id rec_id, const char *path);
 static void mpiio_finalize_file_records(
     void *rec_ref_p, void *user_ptr);
+static int mpiio_nb_track_request(
+    struct mpiio_file_record_ref *rec_ref, __D_MPI_REQUEST *request,
+    enum darshan_io_type io_type, int64_t offset, int64_t length,
+    double tm1, double tm2);
+static void mpiio_nb_complete_requests(
+    MPI_Request *reqs, int *indices, int count, double tm1, double tm2);
+static void mpiio_nb_drop_requests(
+    MPI_Request *reqs, MPI_Request *cur_reqs, int count);
 #ifdef HAVE_MPI
 static void mpiio_record_reduction_op(
     void* infile_v, void* inoutfile_v, int *len, MPI_Datatype *datatype);
 static void mpiio_shared_record_variance(
     MPI_Comm mod_comm, struct darshan_mpiio_file *inrec_array,
     struct darshan_mpiio_file *outrec_array, int shared_rec_count);
+static void mpiio_shared_record_imbalance(
+    MPI_Comm mod_comm, struct darshan_mpiio_file *inrec_array, int shared_rec_count);
 static void mpiio_mpi_redux(
     void *mpiio_buf, MPI_Comm mod_comm,
     darshan_record_id *shared_recs, int shared_rec_count);
@@ -191,6 +232,18 @@ static pthread_mutex_t mpiio_runtime_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER
 static int mpiio_runtime_init_attempted = 0;
 static int my_rank = -1;
 
+/* nonblocking request completion tracking is enabled at runtime using the
+ * DARSHAN_MPIIO_NB_COMPLETION environment variable
+ */
+static int mpiio_nb_completion_enabled = 0;
+static int mpiio_nb_pending_count = 0;
+
+/* maximum number of outstanding nonblocking requests to track */
+#define MPIIO_NB_MAX_PENDING 8192
+
+/* number of request handles that completion wrappers save on the stack */
+#define MPIIO_NB_REQ_BUF_SIZE 32
+
 #define MPIIO_LOCK() pthread_mutex_lock(&mpiio_runtime_mutex)
 #define MPIIO_UNLOCK() pthread_mutex_unlock(&mpiio_runtime_mutex)
 
@@ -264,7 +317,7 @@ static int get_byte_offset = 1;
 static int get_byte_offset = 0;
 #endif
 
-#define MPIIO_RECORD_READ(__ret, __fh, __count, __datatype, __offset, __counter, __tm1, __tm2) do { \
+#define MPIIO_RECORD_READ(__ret, __fh, __count, __datatype, __offset, __counter, __request, __tm1, __tm2) do { \
     struct mpiio_file_record_ref *rec_ref; \
     int size = 0; \
     MPI_Offset displacement=-1;\
@@ -279,8 +332,10 @@ static int get_byte_offset = 0;
         size = size * __count; \
     } \
     if(get_byte_offset) MPI_File_get_byte_offset(__fh, __offset, &displacement);\
-    /* DXT to record detailed read tracing information */ \
-    dxt_mpiio_read(rec_ref->file_rec->base_rec.id, displacement, size, __tm1, __tm2); \
+    /* DXT to record detailed read tracing information (deferred until \
+     * completion for tracked nonblocking operations) */ \
+    if(!mpiio_nb_track_request(rec_ref, __request, DARSHAN_IO_READ, displacement, size, __tm1, __tm2)) \
+        dxt_mpiio_read(rec_ref->file_rec->base_rec.id, displacement, size, __tm1, __tm2); \
     /* heatmap to record traffic summary */ \
     heatmap_update(mpiio_runtime->heatmap_id, HEATMAP_READ, size, __tm1, __tm2); \
     DARSHAN_BUCKET_INC(&(rec_ref->file_rec->counters[MPIIO_SIZE_READ_AGG_0_100]), size); \
@@ -311,7 +366,7 @@ static int get_byte_offset = 0;
             darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->file_rec->counters[__counter], "read", displacement, size, -1, rec_ref->file_rec->counters[MPIIO_RW_SWITCHES], -1, __tm1, __tm2, rec_ref->file_rec->fcounters[MPIIO_F_READ_TIME], "MPIIO", "MOD");\
 } while(0)
 
-#define MPIIO_RECORD_WRITE(__ret, __fh, __count, __datatype, __offset, __counter, __tm1, __tm2) do { \
+#define MPIIO_RECORD_WRITE(__ret, __fh, __count, __datatype, __offset, __counter, __request, __tm1, __tm2) do { \
     struct mpiio_file_record_ref *rec_ref; \
     int size = 0; \
     MPI_Offset displacement=-1; \
@@ -326,8 +381,10 @@ static int get_byte_offset = 0;
         size = size * __count; \
     } \
     if(get_byte_offset) MPI_File_get_byte_offset(__fh, __offset, &displacement); \
-    /* DXT to record detailed write tracing information */ \
-    dxt_mpiio_write(rec_ref->file_rec->base_rec.id, displacement, size, __tm1, __tm2); \
+    /* DXT to record detailed write tracing information (deferred until \
+     * completion for tracked nonblocking operations) */ \
+    if(!mpiio_nb_track_request(rec_ref, __request, DARSHAN_IO_WRITE, displacement, size, __tm1, __tm2)) \
+        dxt_mpiio_write(rec_ref->file_rec->base_rec.id, displacement, size, __tm1, __tm2); \
     /* heatmap to record traffic summary */ \
     heatmap_update(mpiio_runtime->heatmap_id, HEATMAP_WRITE, size, __tm1, __tm2); \
     DARSHAN_BUCKET_INC(&(rec_ref->file_rec->counters[MPIIO_SIZE_WRITE_AGG_0_100]), size); \
@@ -417,7 +474,7 @@ int DARSHAN_DECL(MPI_File_read)(MPI_File fh, void *buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_INDEP_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_INDEP_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -445,7 +502,7 @@ int DARSHAN_DECL(MPI_File_write)(MPI_File fh, void *buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_INDEP_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_INDEP_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -472,7 +529,7 @@ int DARSHAN_DECL(MPI_File_read_at)(MPI_File fh, MPI_Offset offset, void *buf,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_INDEP_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_INDEP_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -499,7 +556,7 @@ int DARSHAN_DECL(MPI_File_write_at)(MPI_File fh, MPI_Offset offset, void *buf,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_INDEP_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_INDEP_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -527,7 +584,7 @@ int DARSHAN_DECL(MPI_File_read_all)(MPI_File fh, void * buf, int count, MPI_Data
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_COLL_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_COLL_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -554,7 +611,7 @@ int DARSHAN_DECL(MPI_File_write_all)(MPI_File fh, void * buf, int count, MPI_Dat
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_COLL_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_COLL_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -581,7 +638,7 @@ int DARSHAN_DECL(MPI_File_read_at_all)(MPI_File fh, MPI_Offset offset, void * bu
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_COLL_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_COLL_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -609,7 +666,7 @@ int DARSHAN_DECL(MPI_File_write_at_all)(MPI_File fh, MPI_Offset offset, void * b
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_COLL_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_COLL_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -639,7 +696,7 @@ int DARSHAN_DECL(MPI_File_read_shared)(MPI_File fh, void * buf, int count, MPI_D
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_INDEP_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_INDEP_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -666,7 +723,7 @@ int DARSHAN_DECL(MPI_File_write_shared)(MPI_File fh, void * buf, int count, MPI_
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_INDEP_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_INDEP_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -696,7 +753,7 @@ int DARSHAN_DECL(MPI_File_read_ordered)(MPI_File fh, void * buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_COLL_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_COLL_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -726,7 +783,7 @@ int DARSHAN_DECL(MPI_File_write_ordered)(MPI_File fh, void * buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_COLL_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_COLL_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -755,7 +812,7 @@ int DARSHAN_DECL(MPI_File_read_all_begin)(MPI_File fh, void * buf, int count, MP
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_SPLIT_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_SPLIT_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -782,7 +839,7 @@ int DARSHAN_DECL(MPI_File_write_all_begin)(MPI_File fh, void * buf, int count, M
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_SPLIT_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_SPLIT_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -809,7 +866,7 @@ int DARSHAN_DECL(MPI_File_read_at_all_begin)(MPI_File fh, MPI_Offset offset, voi
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_SPLIT_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_SPLIT_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -836,7 +893,7 @@ int DARSHAN_DECL(MPI_File_write_at_all_begin)(MPI_File fh, MPI_Offset offset, vo
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_SPLIT_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_SPLIT_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -864,7 +921,7 @@ int DARSHAN_DECL(MPI_File_read_ordered_begin)(MPI_File fh, void * buf, int count
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_SPLIT_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_SPLIT_READS, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -891,7 +948,7 @@ int DARSHAN_DECL(MPI_File_write_ordered_begin)(MPI_File fh, void * buf, int coun
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_SPLIT_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_SPLIT_WRITES, NULL, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -918,7 +975,7 @@ int DARSHAN_DECL(MPI_File_iread)(MPI_File fh, void * buf, int count, MPI_Datatyp
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_NB_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_NB_READS, request, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -946,7 +1003,7 @@ int DARSHAN_DECL(MPI_File_iwrite)(MPI_File fh, void * buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_NB_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_NB_WRITES, request, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -975,7 +1032,7 @@ int DARSHAN_DECL(MPI_File_iread_at)(MPI_File fh, MPI_Offset offset, void * buf,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_NB_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_NB_READS, request, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -1003,7 +1060,7 @@ int DARSHAN_DECL(MPI_File_iwrite_at)(MPI_File fh, MPI_Offset offset, void * buf,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_NB_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_NB_WRITES, request, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -1034,7 +1091,7 @@ int DARSHAN_DECL(MPI_File_iread_shared)(MPI_File fh, void * buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_NB_READS, tm1, tm2);
+    MPIIO_RECORD_READ(ret, fh, count, datatype, offset, MPIIO_NB_READS, request, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -1064,7 +1121,7 @@ int DARSHAN_DECL(MPI_File_iwrite_shared)(MPI_File fh, void * buf, int count,
     tm2 = MPIIO_WTIME();
 
     MPIIO_PRE_RECORD();
-    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_NB_WRITES, tm1, tm2);
+    MPIIO_RECORD_WRITE(ret, fh, count, datatype, offset, MPIIO_NB_WRITES, request, tm1, tm2);
     MPIIO_POST_RECORD();
 
     return(ret);
@@ -1200,6 +1257,299 @@ int DARSHAN_DECL(MPI_File_close)(MPI_File *fh)
 }
 DARSHAN_WRAPPER_MAP(PMPI_File_close, int, (MPI_File *fh), MPI_File_close)
 
+/* The following MPI request completion functions are wrapped so that the
+ * true completion time of nonblocking MPI-IO operations can be attributed
+ * to the corresponding file records. These wrappers add no work beyond a
+ * single branch unless nonblocking MPI-IO requests are outstanding.
+ *
+ * If a completion call fails, the requests it did complete (those reset to
+ * MPI_REQUEST_NULL) are no longer tracked, so that their handles can't be
+ * matched when MPI reuses them for unrelated requests.
+ *
+ * NOTE: mpiio_nb_pending_count is read without holding the MPI-IO lock;
+ * a stale value only causes a completion call to take the slow path, or
+ * a request posted concurrently by another thread to be missed.
+ */
+
+/* save a copy of the given request handles, which MPI resets to
+ * MPI_REQUEST_NULL upon completion
+ */
+static MPI_Request *mpiio_nb_save_requests(int count, MPI_Request *reqs,
+    MPI_Request *req_buf)
+{
+    MPI_Request *saved = req_buf;
+
+    if(count > MPIIO_NB_REQ_BUF_SIZE)
+    {
+        saved = malloc(count * sizeof(*saved));
+        if(!saved)
+            return(NULL);
+    }
+    memcpy(saved, reqs, count * sizeof(*saved));
+
+    return(saved);
+}
+
+int DARSHAN_DECL(MPI_Wait)(MPI_Request *request, MPI_Status *status)
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req;
+
+    MAP_OR_FAIL(PMPI_Wait);
+
+    if(!mpiio_nb_pending_count)
+        return(__real_PMPI_Wait(request, status));
+
+    req = *request;
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Wait(request, status);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_complete_requests(&req, NULL, 1, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(&req, request, 1);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Wait, int, (MPI_Request *request, MPI_Status *status), MPI_Wait)
+
+int DARSHAN_DECL(MPI_Test)(MPI_Request *request, int *flag, MPI_Status *status)
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req;
+
+    MAP_OR_FAIL(PMPI_Test);
+
+    if(!mpiio_nb_pending_count)
+        return(__real_PMPI_Test(request, flag, status));
+
+    req = *request;
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Test(request, flag, status);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && *flag && !__darshan_disabled)
+        mpiio_nb_complete_requests(&req, NULL, 1, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(&req, request, 1);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Test, int, (MPI_Request *request, int *flag, MPI_Status *status), MPI_Test)
+
+int DARSHAN_DECL(MPI_Waitall)(int count, MPI_Request array_of_requests[],
+    MPI_Status array_of_statuses[])
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req_buf[MPIIO_NB_REQ_BUF_SIZE];
+    MPI_Request *reqs;
+
+    MAP_OR_FAIL(PMPI_Waitall);
+
+    if(!mpiio_nb_pending_count || count <= 0 ||
+       !(reqs = mpiio_nb_save_requests(count, array_of_requests, req_buf)))
+        return(__real_PMPI_Waitall(count, array_of_requests, array_of_statuses));
+
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Waitall(count, array_of_requests, array_of_statuses);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_complete_requests(reqs, NULL, count, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(reqs, array_of_requests, count);
+    if(reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Waitall, int, (int count, MPI_Request array_of_requests[],
+    MPI_Status array_of_statuses[]), MPI_Waitall)
+
+int DARSHAN_DECL(MPI_Testall)(int count, MPI_Request array_of_requests[],
+    int *flag, MPI_Status array_of_statuses[])
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req_buf[MPIIO_NB_REQ_BUF_SIZE];
+    MPI_Request *reqs;
+
+    MAP_OR_FAIL(PMPI_Testall);
+
+    if(!mpiio_nb_pending_count || count <= 0 ||
+       !(reqs = mpiio_nb_save_requests(count, array_of_requests, req_buf)))
+        return(__real_PMPI_Testall(count, array_of_requests, flag,
+            array_of_statuses));
+
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Testall(count, array_of_requests, flag, array_of_statuses);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && *flag && !__darshan_disabled)
+        mpiio_nb_complete_requests(reqs, NULL, count, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(reqs, array_of_requests, count);
+    if(reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Testall, int, (int count, MPI_Request array_of_requests[],
+    int *flag, MPI_Status array_of_statuses[]), MPI_Testall)
+
+int DARSHAN_DECL(MPI_Waitany)(int count, MPI_Request array_of_requests[],
+    int *index, MPI_Status *status)
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req_buf[MPIIO_NB_REQ_BUF_SIZE];
+    MPI_Request *reqs;
+
+    MAP_OR_FAIL(PMPI_Waitany);
+
+    if(!mpiio_nb_pending_count || count <= 0 ||
+       !(reqs = mpiio_nb_save_requests(count, array_of_requests, req_buf)))
+        return(__real_PMPI_Waitany(count, array_of_requests, index, status));
+
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Waitany(count, array_of_requests, index, status);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && *index != MPI_UNDEFINED && !__darshan_disabled)
+        mpiio_nb_complete_requests(reqs, index, 1, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(reqs, array_of_requests, count);
+    if(reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Waitany, int, (int count, MPI_Request array_of_requests[],
+    int *index, MPI_Status *status), MPI_Waitany)
+
+int DARSHAN_DECL(MPI_Testany)(int count, MPI_Request array_of_requests[],
+    int *index, int *flag, MPI_Status *status)
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req_buf[MPIIO_NB_REQ_BUF_SIZE];
+    MPI_Request *reqs;
+
+    MAP_OR_FAIL(PMPI_Testany);
+
+    if(!mpiio_nb_pending_count || count <= 0 ||
+       !(reqs = mpiio_nb_save_requests(count, array_of_requests, req_buf)))
+        return(__real_PMPI_Testany(count, array_of_requests, index, flag,
+            status));
+
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Testany(count, array_of_requests, index, flag, status);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && *flag && *index != MPI_UNDEFINED &&
+       !__darshan_disabled)
+        mpiio_nb_complete_requests(reqs, index, 1, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(reqs, array_of_requests, count);
+    if(reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Testany, int, (int count, MPI_Request array_of_requests[],
+    int *index, int *flag, MPI_Status *status), MPI_Testany)
+
+int DARSHAN_DECL(MPI_Waitsome)(int incount, MPI_Request array_of_requests[],
+    int *outcount, int array_of_indices[], MPI_Status array_of_statuses[])
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req_buf[MPIIO_NB_REQ_BUF_SIZE];
+    MPI_Request *reqs;
+
+    MAP_OR_FAIL(PMPI_Waitsome);
+
+    if(!mpiio_nb_pending_count || incount <= 0 ||
+       !(reqs = mpiio_nb_save_requests(incount, array_of_requests, req_buf)))
+        return(__real_PMPI_Waitsome(incount, array_of_requests, outcount,
+            array_of_indices, array_of_statuses));
+
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Waitsome(incount, array_of_requests, outcount,
+        array_of_indices, array_of_statuses);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && *outcount != MPI_UNDEFINED && !__darshan_disabled)
+        mpiio_nb_complete_requests(reqs, array_of_indices, *outcount, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(reqs, array_of_requests, incount);
+    if(reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Waitsome, int, (int incount, MPI_Request array_of_requests[],
+    int *outcount, int array_of_indices[], MPI_Status array_of_statuses[]), MPI_Waitsome)
+
+int DARSHAN_DECL(MPI_Testsome)(int incount, MPI_Request array_of_requests[],
+    int *outcount, int array_of_indices[], MPI_Status array_of_statuses[])
+{
+    int ret;
+    double tm1, tm2;
+    MPI_Request req_buf[MPIIO_NB_REQ_BUF_SIZE];
+    MPI_Request *reqs;
+
+    MAP_OR_FAIL(PMPI_Testsome);
+
+    if(!mpiio_nb_pending_count || incount <= 0 ||
+       !(reqs = mpiio_nb_save_requests(incount, array_of_requests, req_buf)))
+        return(__real_PMPI_Testsome(incount, array_of_requests, outcount,
+            array_of_indices, array_of_statuses));
+
+    tm1 = MPIIO_WTIME();
+    ret = __real_PMPI_Testsome(incount, array_of_requests, outcount,
+        array_of_indices, array_of_statuses);
+    tm2 = MPIIO_WTIME();
+
+    if(ret == MPI_SUCCESS && *outcount != MPI_UNDEFINED && !__darshan_disabled)
+        mpiio_nb_complete_requests(reqs, array_of_indices, *outcount, tm1, tm2);
+    else if(ret != MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(reqs, array_of_requests, incount);
+    if(reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Testsome, int, (int incount, MPI_Request array_of_requests[],
+    int *outcount, int array_of_indices[], MPI_Status array_of_statuses[]), MPI_Testsome)
+
+/* the completion of a freed request cannot be observed, so it is no longer
+ * tracked once the request is freed
+ */
+int DARSHAN_DECL(MPI_Request_free)(MPI_Request *request)
+{
+    int ret;
+    MPI_Request req;
+
+    MAP_OR_FAIL(PMPI_Request_free);
+
+    if(!mpiio_nb_pending_count)
+        return(__real_PMPI_Request_free(request));
+
+    req = *request;
+    ret = __real_PMPI_Request_free(request);
+
+    if(ret == MPI_SUCCESS && !__darshan_disabled)
+        mpiio_nb_drop_requests(&req, NULL, 1);
+
+    return(ret);
+}
+DARSHAN_WRAPPER_MAP(PMPI_Request_free, int, (MPI_Request *request), MPI_Request_free)
+
 /***********************************************************
  * Internal functions for manipulating MPI-IO module state *
  ***********************************************************/
@@ -1220,6 +1570,10 @@ static void mpiio_runtime_initialize()
     /* if this attempt at initializing fails, we won't try again */
     mpiio_runtime_init_attempted = 1;
 
+    /* check whether nonblocking request completion should be tracked */
+    if(getenv("DARSHAN_MPIIO_NB_COMPLETION"))
+        mpiio_nb_completion_enabled = 1;
+
     /* try and store the default number of records for this module */
     mpiio_rec_count = DARSHAN_DEF_MOD_REC_COUNT;
 
@@ -1296,6 +1650,16 @@ static struct mpiio_file_record_ref *mpiio_track_new_file_record(
     rec_ref->file_rec = file_rec;
     mpiio_runtime->file_rec_count++;
 
+    if(!mpiio_nb_completion_enabled)
+    {
+        file_rec->counters[MPIIO_NB_READ_COMPLETIONS] = -1;
+        file_rec->counters[MPIIO_NB_WRITE_COMPLETIONS] = -1;
+        file_rec->fcounters[MPIIO_F_NB_READ_TIME] = -1;
+        file_rec->fcounters[MPIIO_F_NB_WRITE_TIME] = -1;
+        file_rec->fcounters[MPIIO_F_NB_WAIT_TIME] = -1;
+        file_rec->fcounters[MPIIO_F_NB_OVERLAP_TIME] = -1;
+    }
+
     return(rec_ref);
 }
 
@@ -1308,6 +1672,152 @@ static void mpiio_finalize_file_records(void *rec_ref_p, void *user_ptr)
     return;
 }
 
+/* start tracking a posted nonblocking operation, if completion tracking is
+ * enabled; returns 1 if the operation will be recorded in DXT once its
+ * request completes, or 0 if the caller should record it in DXT now
+ */
+static int mpiio_nb_track_request(
+    struct mpiio_file_record_ref *rec_ref, __D_MPI_REQUEST *request,
+    enum darshan_io_type io_type, int64_t offset, int64_t length,
+    double tm1, double tm2)
+{
+    struct mpiio_nb_request_ref *nb_ref;
+    MPI_Request req;
+    int ret;
+
+    /* requests can only be matched at completion if nonblocking MPI-IO
+     * operations return generalized MPI requests
+     */
+    if(!request || !mpiio_nb_completion_enabled ||
+       sizeof(__D_MPI_REQUEST) != sizeof(MPI_Request))
+        return(0);
+    memcpy(&req, request, sizeof(req));
+    if(req == MPI_REQUEST_NULL)
+        return(0);
+
+    /* drop any stale reference left by a completion we did not observe
+     * that happens to share this handle
+     */
+    nb_ref = darshan_delete_record_ref(&(mpiio_runtime->req_hash),
+        &req, sizeof(MPI_Request));
+    if(nb_ref)
+    {
+        free(nb_ref);
+        mpiio_nb_pending_count--;
+    }
+    if(mpiio_nb_pending_count >= MPIIO_NB_MAX_PENDING)
+        return(0);
+
+    nb_ref = malloc(sizeof(*nb_ref));
+    if(!nb_ref)
+        return(0);
+    nb_ref->rec_ref = rec_ref;
+    nb_ref->io_type = io_type;
+    nb_ref->offset = offset;
+    nb_ref->length = length;
+    nb_ref->post_start = tm1;
+    nb_ref->post_end = tm2;
+
+    ret = darshan_add_record_ref(&(mpiio_runtime->req_hash), &req,
+        sizeof(MPI_Request), nb_ref);
+    if(ret == 0)
+    {
+        free(nb_ref);
+        return(0);
+    }
+    mpiio_nb_pending_count++;
+
+    return(1);
+}
+
+/* attribute the completion of the given requests (or the subset of them
+ * selected by 'indices') to the file records they were posted on
+ */
+static void mpiio_nb_complete_requests(
+    MPI_Request *reqs, int *indices, int count, double tm1, double tm2)
+{
+    struct mpiio_nb_request_ref *nb_ref;
+    struct darshan_mpiio_file *file_rec;
+    int i;
+
+    MPIIO_LOCK();
+    if(!mpiio_runtime || mpiio_runtime->frozen)
+    {
+        MPIIO_UNLOCK();
+        return;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        nb_ref = darshan_delete_record_ref(&(mpiio_runtime->req_hash),
+            indices ? &reqs[indices[i]] : &reqs[i], sizeof(MPI_Request));
+        if(!nb_ref)
+            continue;
+        mpiio_nb_pending_count--;
+
+        file_rec = nb_ref->rec_ref->file_rec;
+        if(nb_ref->io_type == DARSHAN_IO_READ)
+        {
+            file_rec->counters[MPIIO_NB_READ_COMPLETIONS] += 1;
+            DARSHAN_TIMER_INC_NO_OVERLAP(file_rec->fcounters[MPIIO_F_NB_READ_TIME],
+                nb_ref->post_start, tm2, nb_ref->rec_ref->last_nb_read_end);
+            dxt_mpiio_read(file_rec->base_rec.id, nb_ref->offset,
+                nb_ref->length, nb_ref->post_start, tm2);
+        }
+        else
+        {
+            file_rec->counters[MPIIO_NB_WRITE_COMPLETIONS] += 1;
+            DARSHAN_TIMER_INC_NO_OVERLAP(file_rec->fcounters[MPIIO_F_NB_WRITE_TIME],
+                nb_ref->post_start, tm2, nb_ref->rec_ref->last_nb_write_end);
+            dxt_mpiio_write(file_rec->base_rec.id, nb_ref->offset,
+                nb_ref->length, nb_ref->post_start, tm2);
+        }
+        DARSHAN_TIMER_INC_NO_OVERLAP(file_rec->fcounters[MPIIO_F_NB_WAIT_TIME],
+            tm1, tm2, nb_ref->rec_ref->last_nb_wait_end);
+        if(tm1 > nb_ref->post_end)
+            DARSHAN_TIMER_INC_NO_OVERLAP(file_rec->fcounters[MPIIO_F_NB_OVERLAP_TIME],
+                nb_ref->post_end, tm1, nb_ref->rec_ref->last_nb_overlap_end);
+
+        free(nb_ref);
+    }
+
+    MPIIO_UNLOCK();
+    return;
+}
+
+/* stop tracking the given requests without attributing a completion to
+ * them; if 'cur_reqs' is given, only the requests that MPI has since reset
+ * to MPI_REQUEST_NULL in it are dropped
+ */
+static void mpiio_nb_drop_requests(
+    MPI_Request *reqs, MPI_Request *cur_reqs, int count)
+{
+    struct mpiio_nb_request_ref *nb_ref;
+    int i;
+
+    MPIIO_LOCK();
+    if(!mpiio_runtime)
+    {
+        MPIIO_UNLOCK();
+        return;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if(cur_reqs && cur_reqs[i] != MPI_REQUEST_NULL)
+            continue;
+        nb_ref = darshan_delete_record_ref(&(mpiio_runtime->req_hash),
+            &reqs[i], sizeof(MPI_Request));
+        if(!nb_ref)
+            continue;
+        mpiio_nb_pending_count--;
+        free(nb_ref);
+    }
+
+    MPIIO_UNLOCK();
+    return;
+}
+
 #ifdef HAVE_MPI
 static void mpiio_record_reduction_op(void* infile_v, void* inoutfile_v,
     int *len, MPI_Datatype *datatype)
@@ -1401,6 +1911,22 @@ static void mpiio_record_reduction_op(void* infile_v, void* inoutfile_v,
             tmp_file.fcounters[j] = infile->fcounters[j] + inoutfile->fcounters[j];
         }
 
+        /* sum (if available) */
+        for(j=MPIIO_NB_READ_COMPLETIONS; j<=MPIIO_NB_WRITE_COMPLETIONS; j++)
+        {
+            if(infile->counters[j] < 0 || inoutfile->counters[j] < 0)
+                tmp_file.counters[j] = -1;
+            else
+                tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
+        }
+        for(j=MPIIO_F_NB_READ_TIME; j<=MPIIO_F_NB_OVERLAP_TIME; j++)
+        {
+            if(infile->fcounters[j] < 0 || inoutfile->fcounters[j] < 0)
+                tmp_file.fcounters[j] = -1;
+            else
+                tmp_file.fcounters[j] = infile->fcounters[j] + inoutfile->fcounters[j];
+        }
+
         /* max (special case) */
         if(infile->fcounters[MPIIO_F_MAX_READ_TIME] >
             inoutfile->fcounters[MPIIO_F_MAX_READ_TIME])
@@ -1485,6 +2011,37 @@ static void mpiio_record_reduction_op(void* infile_v, void* inoutfile_v,
     return;
 }
 
+static void mpiio_shared_record_imbalance(MPI_Comm mod_comm,
+    struct darshan_mpiio_file *inrec_array, int shared_rec_count)
+{
+    struct darshan_imbalance_sample *samples;
+    int i;
+
+    if(!imbalance_enabled())
+        return;
+
+    samples = malloc(shared_rec_count * sizeof(*samples));
+    assert(samples);
+
+    /* hand this rank's i/o time and bytes of each shared record to the
+     * IMBALANCE module, which keeps their distribution across nodes
+     */
+    for(i=0; i<shared_rec_count; i++)
+    {
+        samples[i].id = inrec_array[i].base_rec.id;
+        samples[i].time = inrec_array[i].fcounters[MPIIO_F_READ_TIME] +
+                          inrec_array[i].fcounters[MPIIO_F_WRITE_TIME] +
+                          inrec_array[i].fcounters[MPIIO_F_META_TIME];
+        samples[i].bytes = inrec_array[i].counters[MPIIO_BYTES_READ] +
+                           inrec_array[i].counters[MPIIO_BYTES_WRITTEN];
+    }
+
+    imbalance_reduce(DARSHAN_MPIIO_MOD, mod_comm, samples, shared_rec_count);
+
+    free(samples);
+    return;
+}
+
 static void mpiio_shared_record_variance(MPI_Comm mod_comm,
     struct darshan_mpiio_file *inrec_array, struct darshan_mpiio_file *outrec_array,
     int shared_rec_count)
@@ -1569,89 +2126,55 @@ static void mpiio_shared_record_variance(MPI_Comm mod_comm,
 #endif
 
 /* mpiio module shutdown benchmark routine */
-void darshan_mpiio_shutdown_bench_setup(int test_case)
+void darshan_mpiio_shutdown_bench_setup(
+    struct darshan_shutdown_bench_workload *wl)
 {
-    char filepath[256];
-    MPI_File *fh_array;
+    char *filepath;
+    MPI_File fh;
     MPI_Offset *offset_array;
+    MPI_Offset offset;
     int64_t *size_array;
-    int i;
-    intptr_t j;
+    int shared;
+    int i, j;
 
     if(mpiio_runtime)
         mpiio_cleanup();
 
     mpiio_runtime_initialize();
+    if(!mpiio_runtime)
+        return;
 
     srand(my_rank);
-    fh_array = malloc(1024 * sizeof(MPI_File));
+    filepath = malloc(__DARSHAN_PATH_MAX);
     size_array = malloc(DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT * sizeof(int64_t));
     offset_array = malloc(DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT *sizeof(MPI_Offset));
-    assert(fh_array && size_array);
+    assert(filepath && size_array && offset_array);
 
-    for(j = 0; j < 1024; j++)
-        fh_array[j] = (MPI_File)j;
     for(i = 0; i < DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT; i++) {
         offset_array[i] = rand();
         size_array[i] = rand();
     }
 
-    switch(test_case)
+    for(i = 0; i < wl->rec_count; i++)
     {
-        case 1: /* single file-per-process */
-            snprintf(filepath, 256, "fpp-0_rank-%d", my_rank);
-
-            MPIIO_RECORD_OPEN(MPI_SUCCESS, filepath, fh_array[0], MPI_COMM_SELF,
-                2, MPI_INFO_NULL, 0, 1);
-            MPIIO_RECORD_WRITE(MPI_SUCCESS, fh_array[0], size_array[0], MPI_BYTE,
-                offset_array[0], MPIIO_INDEP_WRITES, 1, 2);
-
-            break;
-        case 2: /* single shared file */
-            snprintf(filepath, 256, "shared-0");
-
-            MPIIO_RECORD_OPEN(MPI_SUCCESS, filepath, fh_array[0], MPI_COMM_WORLD,
-                2, MPI_INFO_NULL, 0, 1);
-            MPIIO_RECORD_WRITE(MPI_SUCCESS, fh_array[0], size_array[0], MPI_BYTE,
-                offset_array[0], MPIIO_COLL_WRITES, 1, 2);
-
-            break;
-        case 3: /* 1024 unique files per proc */
-            for(i = 0; i < 1024; i++)
-            {
-                snprintf(filepath, 256, "fpp-%d_rank-%d", i , my_rank);
-
-                MPIIO_RECORD_OPEN(MPI_SUCCESS, filepath, fh_array[i], MPI_COMM_SELF,
-                    2, MPI_INFO_NULL, 0, 1);
-                MPIIO_RECORD_WRITE(MPI_SUCCESS, fh_array[i],
-                    size_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT],
-                    MPI_BYTE,
-                    offset_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT],
-                    MPIIO_INDEP_WRITES, 1, 2);
-            }
-
-            break;
-        case 4: /* 1024 shared files per proc */
-            for(i = 0; i < 1024; i++)
-            {
-                snprintf(filepath, 256, "shared-%d", i);
-
-                MPIIO_RECORD_OPEN(MPI_SUCCESS, filepath, fh_array[i], MPI_COMM_WORLD,
-                    2, MPI_INFO_NULL, 0, 1);
-                MPIIO_RECORD_WRITE(MPI_SUCCESS, fh_array[i],
-                    size_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT],
-                    MPI_BYTE,
-                    offset_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT],
-                    MPIIO_COLL_WRITES, 1, 2);
-            }
-            break;
-        default:
-            fprintf(stderr, "Error: invalid Darshan benchmark test case.\n");
-            return;
+        shared = darshan_shutdown_bench_rec_name(wl, i, filepath);
+        fh = (MPI_File)(intptr_t)i;
+        offset = offset_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT];
+
+        MPIIO_RECORD_OPEN(MPI_SUCCESS, filepath, fh,
+            shared ? MPI_COMM_WORLD : MPI_COMM_SELF, 2, MPI_INFO_NULL, 0, 1);
+        /* every write adds one DXT segment when tracing is enabled */
+        j = 0;
+        do {
+            MPIIO_RECORD_WRITE(MPI_SUCCESS, fh,
+                size_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT], MPI_BYTE, offset,
+                shared ? MPIIO_COLL_WRITES : MPIIO_INDEP_WRITES, NULL, 1, 2);
+        } while(++j < wl->dxt_segs);
     }
 
-    free(fh_array);
+    free(filepath);
     free(size_array);
+    free(offset_array);
 
     return;
 }
@@ -1755,6 +2278,9 @@ static void mpiio_mpi_redux(
     mpiio_shared_record_variance(mod_comm, red_send_buf, red_recv_buf,
         shared_rec_count);
 
+    /* get the distribution of time and bytes across nodes for shared files */
+    mpiio_shared_record_imbalance(mod_comm, red_send_buf, shared_rec_count);
+
     /* update module state to account for shared file reduction */
     if(my_rank == 0)
     {
@@ -1806,7 +2332,9 @@ static void mpiio_cleanup()
     darshan_iter_record_refs(mpiio_runtime->rec_id_hash,
         &mpiio_finalize_file_records, NULL);
     darshan_clear_record_refs(&(mpiio_runtime->fh_hash), 0);
+    darshan_clear_record_refs(&(mpiio_runtime->req_hash), 1);
     darshan_clear_record_refs(&(mpiio_runtime->rec_id_hash), 1);
+    mpiio_nb_pending_count = 0;
 
     free(mpiio_runtime);
     mpiio_runtime = NULL;
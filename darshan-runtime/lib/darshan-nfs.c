@@ -0,0 +1,815 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <darshan-runtime-config.h>
+#endif
+
+#define _XOPEN_SOURCE 500
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <assert.h>
+#include <sys/syscall.h>
+
+#include "darshan.h"
+#include "darshan-nfs.h"
+
+/*
+ * Job-level module which captures NFS client statistics for each NFS mount
+ * visible to the job, as reported by the kernel in /proc/self/mountstats:
+ * cache revalidation events, application and server byte counts, and per
+ * operation RPC counts, retransmissions, and queue/round trip/execution
+ * times.  These expose metadata-heavy access patterns on NFS home and
+ * project directories (e.g., GETATTR and LOOKUP storms) that are otherwise
+ * invisible in file-level counters.
+ *
+ * This module does not intercept any functions.  Snapshots are taken at
+ * initialization and shutdown time and, if enabled, periodically whenever
+ * an instrumented I/O operation completes after the sampling interval has
+ * elapsed (see nfs_sample()).  Since the kernel keeps these statistics per
+ * mount rather than per process, records are reduced across the ranks
+ * sharing a node rather than across the whole job.
+ */
+
+/* location of the NFS client statistics; can be overridden with the
+ * DARSHAN_NFS_MOUNTSTATS_PATH environment variable (e.g., to point the
+ * module at a fixture file for testing)
+ */
+#define DARSHAN_NFS_DEF_MOUNTSTATS_PATH "/proc/self/mountstats"
+
+/* initial size of the buffer used to read the mountstats file; it is grown
+ * as needed, up to the maximum size
+ */
+#define DARSHAN_NFS_INIT_BUF_SIZE (64*1024)
+#define DARSHAN_NFS_MAX_BUF_SIZE (16*1024*1024)
+
+/* cumulative kernel statistics for a single NFS mount */
+struct nfs_mount_stats
+{
+    int64_t counters[NFS_NUM_INDICES];
+    /* RPC times, in milliseconds */
+    int64_t times_ms[NFS_F_NUM_INDICES];
+};
+
+/* the nfs_mount_ref structure is used to associate an NFS mount with its
+ * Darshan record and the snapshots used to compute its deltas
+ */
+struct nfs_mount_ref
+{
+    struct darshan_nfs_record *record;
+    char *mnt_pt;
+    struct nfs_mount_stats start;
+    struct nfs_mount_stats last;
+    double last_time;
+};
+
+struct nfs_runtime
+{
+    struct nfs_mount_ref *mnt_refs;
+    int mnt_count;
+    char *mountstats_path;
+    double sample_interval;
+    double next_sample;
+    int frozen;
+    int reduced;
+};
+
+/* mapping of the per-op statistics lines of the mountstats file onto the
+ * counters kept by this module.  NFSv3 READDIRPLUS is folded into READDIR
+ */
+#define NFS_OP_MAP(__name, __op) \
+    {__name, NFS_##__op##_OPS, NFS_##__op##_RETRANS, NFS_F_##__op##_QUEUE_TIME, \
+     NFS_F_##__op##_RTT_TIME, NFS_F_##__op##_EXEC_TIME}
+static const struct nfs_op_map
+{
+    const char *name;
+    int ops;
+    int retrans;
+    int queue_time;
+    int rtt_time;
+    int exec_time;
+} nfs_op_maps[] = {
+    NFS_OP_MAP("GETATTR", GETATTR),
+    NFS_OP_MAP("SETATTR", SETATTR),
+    NFS_OP_MAP("LOOKUP", LOOKUP),
+    NFS_OP_MAP("ACCESS", ACCESS),
+    NFS_OP_MAP("READ", READ),
+    NFS_OP_MAP("WRITE", WRITE),
+    NFS_OP_MAP("COMMIT", COMMIT),
+    NFS_OP_MAP("OPEN", OPEN),
+    NFS_OP_MAP("CLOSE", CLOSE),
+    NFS_OP_MAP("CREATE", CREATE),
+    NFS_OP_MAP("REMOVE", REMOVE),
+    NFS_OP_MAP("READDIR", READDIR),
+    NFS_OP_MAP("READDIRPLUS", READDIR),
+};
+#define NFS_OP_MAP_COUNT (sizeof(nfs_op_maps)/sizeof(nfs_op_maps[0]))
+
+/* callback invoked for each NFS mount found in the mountstats file */
+typedef void (*nfs_mount_visitor)(const char *mnt_pt,
+    struct nfs_mount_stats *stats, void *arg);
+
+static struct nfs_runtime *nfs_runtime = NULL;
+static pthread_mutex_t nfs_runtime_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* timestamp of the next scheduled periodic sample (0 if none); this is
+ * checked without holding the module lock so that nfs_sample() is cheap
+ * for the common case.  A stale read only delays or repeats the check.
+ */
+static volatile double nfs_next_sample = 0;
+
+/* my_rank indicates the MPI rank of this process */
+static int my_rank = -1;
+
+/* internal helper functions for the NFS module */
+void nfs_runtime_initialize(void);
+static int nfs_read_mountstats(const char *path, nfs_mount_visitor visit,
+    void *arg);
+static void nfs_count_mount(const char *mnt_pt, struct nfs_mount_stats *stats,
+    void *arg);
+static void nfs_register_mount(const char *mnt_pt, struct nfs_mount_stats *stats,
+    void *arg);
+static void nfs_update_mount(const char *mnt_pt, struct nfs_mount_stats *stats,
+    void *arg);
+static void nfs_finalize_records(void);
+static int nfs_record_is_active(struct darshan_nfs_record *rec);
+
+/* forward declaration for functions needed to interface with darshan-core */
+#ifdef HAVE_MPI
+static void nfs_mpi_redux(
+    void *buffer,
+    MPI_Comm mod_comm,
+    darshan_record_id *shared_recs,
+    int shared_rec_count);
+#endif
+static void nfs_output(
+    void **buffer,
+    int *size);
+static void nfs_cleanup(
+    void);
+
+/* macros for obtaining/releasing the NFS module lock */
+#define NFS_LOCK() pthread_mutex_lock(&nfs_runtime_mutex)
+#define NFS_UNLOCK() pthread_mutex_unlock(&nfs_runtime_mutex)
+
+/*******************************************************
+ * Internal functions for manipulating NFS module state *
+ *******************************************************/
+
+void nfs_runtime_initialize()
+{
+    int ret;
+    size_t nfs_rec_count = 0;
+    const char *path;
+    char *envstr;
+    double interval;
+    int success;
+    darshan_module_funcs mod_funcs = {
+#ifdef HAVE_MPI
+        .mod_redux_func = &nfs_mpi_redux,
+#endif
+        .mod_output_func = &nfs_output,
+        .mod_cleanup_func = &nfs_cleanup
+        };
+
+    path = getenv("DARSHAN_NFS_MOUNTSTATS_PATH");
+    if(!path)
+        path = DARSHAN_NFS_DEF_MOUNTSTATS_PATH;
+
+    /* don't bother registering if there are no NFS mounts to report on */
+    if(nfs_read_mountstats(path, nfs_count_mount, &nfs_rec_count) < 0 ||
+       nfs_rec_count == 0)
+        return;
+
+    NFS_LOCK();
+
+    /* don't do anything if already initialized */
+    if(nfs_runtime)
+    {
+        NFS_UNLOCK();
+        return;
+    }
+
+    /* register the NFS module with the darshan-core component */
+    ret = darshan_core_register_module(
+        DARSHAN_NFS_MOD,
+        mod_funcs,
+        sizeof(struct darshan_nfs_record),
+        &nfs_rec_count,
+        &my_rank,
+        NULL);
+    if(ret < 0)
+    {
+        NFS_UNLOCK();
+        return;
+    }
+
+    /* initialize module's global state */
+    nfs_runtime = malloc(sizeof(*nfs_runtime));
+    if(!nfs_runtime)
+    {
+        darshan_core_unregister_module(DARSHAN_NFS_MOD);
+        NFS_UNLOCK();
+        return;
+    }
+    memset(nfs_runtime, 0, sizeof(*nfs_runtime));
+    nfs_runtime->mountstats_path = strdup(path);
+    nfs_runtime->mnt_refs = calloc(nfs_rec_count, sizeof(*nfs_runtime->mnt_refs));
+    if(!nfs_runtime->mountstats_path || !nfs_runtime->mnt_refs)
+    {
+        darshan_core_unregister_module(DARSHAN_NFS_MOD);
+        free(nfs_runtime->mountstats_path);
+        free(nfs_runtime->mnt_refs);
+        free(nfs_runtime);
+        nfs_runtime = NULL;
+        NFS_UNLOCK();
+        return;
+    }
+
+    /* register a record for each NFS mount, up to the number of records
+     * darshan-core was able to give us
+     */
+    nfs_read_mountstats(path, nfs_register_mount, &nfs_rec_count);
+    if(nfs_runtime->mnt_count == 0)
+    {
+        darshan_core_unregister_module(DARSHAN_NFS_MOD);
+        free(nfs_runtime->mountstats_path);
+        free(nfs_runtime->mnt_refs);
+        free(nfs_runtime);
+        nfs_runtime = NULL;
+        NFS_UNLOCK();
+        return;
+    }
+
+    /* determine periodic sampling interval (disabled by default) */
+    envstr = getenv("DARSHAN_NFS_SAMPLE_INTERVAL");
+    if(envstr)
+    {
+        DARSHAN_PARSE_NUMBER_FROM_STR(envstr, double, interval, success);
+        if(success && interval > 0)
+        {
+            nfs_runtime->sample_interval = interval;
+            nfs_runtime->next_sample = darshan_core_wtime() + interval;
+            nfs_next_sample = nfs_runtime->next_sample;
+        }
+    }
+
+    NFS_UNLOCK();
+
+    return;
+}
+
+/* read the given mountstats file using raw system calls, so that this
+ * module never re-enters Darshan's own POSIX/STDIO wrappers (this may be
+ * called while another module's lock is held), and invoke the visitor
+ * function on the statistics of each NFS mount found
+ */
+static int nfs_read_mountstats(const char *path, nfs_mount_visitor visit,
+    void *arg)
+{
+    int fd;
+    char *buf, *tmp_buf;
+    size_t buf_size = DARSHAN_NFS_INIT_BUF_SIZE;
+    ssize_t ret, total = 0;
+    char *line, *next, *p, *q;
+    char *mnt_pt = NULL;
+    int in_ops = 0;
+    struct nfs_mount_stats stats;
+    long long vals[8];
+    int nvals;
+    size_t i;
+
+    fd = syscall(SYS_openat, AT_FDCWD, path, O_RDONLY);
+    if(fd < 0)
+        return(-1);
+
+    buf = malloc(buf_size);
+    if(!buf)
+    {
+        syscall(SYS_close, fd);
+        return(-1);
+    }
+    while(1)
+    {
+        if(total == (ssize_t)buf_size - 1)
+        {
+            if(buf_size * 2 > DARSHAN_NFS_MAX_BUF_SIZE)
+                break;
+            tmp_buf = realloc(buf, buf_size * 2);
+            if(!tmp_buf)
+                break;
+            buf = tmp_buf;
+            buf_size *= 2;
+        }
+        ret = syscall(SYS_read, fd, buf + total, buf_size - 1 - total);
+        if(ret < 0 && errno == EINTR)
+            continue;
+        if(ret <= 0)
+            break;
+        total += ret;
+    }
+    syscall(SYS_close, fd);
+    buf[total] = '\0';
+
+    for(line = buf; line && *line; line = next)
+    {
+        next = strchr(line, '\n');
+        if(next)
+            *next++ = '\0';
+
+        /* each mount starts with a line of the form:
+         * "device <dev> mounted on <mnt_pt> with fstype <type> [statvers=<v>]"
+         */
+        if(strncmp(line, "device ", 7) == 0)
+        {
+            if(mnt_pt)
+                visit(mnt_pt, &stats, arg);
+            mnt_pt = NULL;
+            in_ops = 0;
+
+            p = strstr(line, " mounted on ");
+            if(!p)
+                continue;
+            p += strlen(" mounted on ");
+            q = strstr(p, " with fstype ");
+            if(!q)
+                continue;
+            *q = '\0';
+            q += strlen(" with fstype ");
+
+            /* only NFS client mounts (not e.g. the nfsd control fs) */
+            if(strncmp(q, "nfs ", 4) && strcmp(q, "nfs") &&
+               strncmp(q, "nfs4 ", 5) && strcmp(q, "nfs4"))
+                continue;
+
+            mnt_pt = p;
+            memset(&stats, 0, sizeof(stats));
+            stats.counters[NFS_VERSION] = (strncmp(q, "nfs4", 4) == 0) ? 4 : 3;
+            continue;
+        }
+        if(!mnt_pt)
+            continue;
+
+        while(isspace((unsigned char)*line))
+            line++;
+
+        if(strncmp(line, "opts:", 5) == 0)
+        {
+            /* NOTE: don't match NFSv3 "mountvers=" */
+            p = strstr(line, ",vers=");
+            if(p)
+                stats.counters[NFS_VERSION] = atoi(p + 6);
+        }
+        else if(strncmp(line, "events:", 7) == 0)
+        {
+            nvals = sscanf(line + 7, "%lld %lld %lld %lld",
+                &vals[0], &vals[1], &vals[2], &vals[3]);
+            for(i = 0; (int)i < nvals; i++)
+                stats.counters[NFS_INODE_REVALIDATES + i] = vals[i];
+        }
+        else if(strncmp(line, "bytes:", 6) == 0)
+        {
+            nvals = sscanf(line + 6, "%lld %lld %lld %lld %lld %lld",
+                &vals[0], &vals[1], &vals[2], &vals[3], &vals[4], &vals[5]);
+            for(i = 0; (int)i < nvals; i++)
+                stats.counters[NFS_NORMAL_READ_BYTES + i] = vals[i];
+        }
+        else if(strcmp(line, "per-op statistics") == 0)
+        {
+            in_ops = 1;
+        }
+        else if(in_ops && (p = strchr(line, ':')))
+        {
+            /* "<OP>: ops trans timeouts bytes_sent bytes_recv queue rtt execute" */
+            *p++ = '\0';
+            nvals = sscanf(p, "%lld %lld %lld %lld %lld %lld %lld %lld",
+                &vals[0], &vals[1], &vals[2], &vals[3], &vals[4], &vals[5],
+                &vals[6], &vals[7]);
+            if(nvals != 8)
+                continue;
+
+            stats.counters[NFS_RPC_OPS] += vals[0];
+            stats.counters[NFS_RPC_RETRANS] += vals[1] - vals[0];
+            stats.counters[NFS_RPC_TIMEOUTS] += vals[2];
+            stats.counters[NFS_RPC_BYTES_SENT] += vals[3];
+            stats.counters[NFS_RPC_BYTES_RECV] += vals[4];
+            stats.times_ms[NFS_F_RPC_QUEUE_TIME] += vals[5];
+            stats.times_ms[NFS_F_RPC_RTT_TIME] += vals[6];
+            stats.times_ms[NFS_F_RPC_EXEC_TIME] += vals[7];
+
+            for(i = 0; i < NFS_OP_MAP_COUNT; i++)
+            {
+                if(strcmp(line, nfs_op_maps[i].name) == 0)
+                {
+                    stats.counters[nfs_op_maps[i].ops] += vals[0];
+                    stats.counters[nfs_op_maps[i].retrans] += vals[1] - vals[0];
+                    stats.times_ms[nfs_op_maps[i].queue_time] += vals[5];
+                    stats.times_ms[nfs_op_maps[i].rtt_time] += vals[6];
+                    stats.times_ms[nfs_op_maps[i].exec_time] += vals[7];
+                    break;
+                }
+            }
+        }
+    }
+    if(mnt_pt)
+        visit(mnt_pt, &stats, arg);
+
+    free(buf);
+    return(0);
+}
+
+static void nfs_count_mount(const char *mnt_pt, struct nfs_mount_stats *stats,
+    void *arg)
+{
+    size_t *count = (size_t *)arg;
+
+    (*count)++;
+    return;
+}
+
+/* register a record for the given mount; called with the module lock held */
+static void nfs_register_mount(const char *mnt_pt, struct nfs_mount_stats *stats,
+    void *arg)
+{
+    size_t *avail = (size_t *)arg;
+    struct nfs_mount_ref *ref;
+    darshan_record_id rec_id;
+    int i;
+
+    if((size_t)nfs_runtime->mnt_count >= *avail)
+        return;
+
+    /* the same mount point may be listed more than once if file systems
+     * are stacked on it; only the topmost mount is visible to the job
+     */
+    for(i = 0; i < nfs_runtime->mnt_count; i++)
+    {
+        if(strcmp(nfs_runtime->mnt_refs[i].mnt_pt, mnt_pt) == 0)
+        {
+            nfs_runtime->mnt_refs[i].start = *stats;
+            nfs_runtime->mnt_refs[i].last = *stats;
+            return;
+        }
+    }
+
+    ref = &nfs_runtime->mnt_refs[nfs_runtime->mnt_count];
+    ref->mnt_pt = strdup(mnt_pt);
+    if(!ref->mnt_pt)
+        return;
+
+    /* NOTE: records are named by mount point so that darshan-core identifies
+     * mounts common to all ranks as shared and gives us a chance to reduce
+     * them at shutdown
+     */
+    rec_id = darshan_core_gen_record_id(mnt_pt);
+    ref->record = darshan_core_register_record(
+        rec_id,
+        ref->mnt_pt,
+        DARSHAN_NFS_MOD,
+        sizeof(struct darshan_nfs_record),
+        NULL);
+    if(!ref->record)
+    {
+        free(ref->mnt_pt);
+        ref->mnt_pt = NULL;
+        return;
+    }
+
+    ref->record->base_rec.id = rec_id;
+    ref->record->base_rec.rank = my_rank;
+    ref->record->counters[NFS_VERSION] = stats->counters[NFS_VERSION];
+    ref->record->counters[NFS_PROCS] = 1;
+    ref->record->counters[NFS_SAMPLES] = 1;
+    ref->record->fcounters[NFS_F_START_TIMESTAMP] = darshan_core_wtime();
+    ref->record->fcounters[NFS_F_MAX_RPC_RATE] = -1;
+    ref->start = *stats;
+    ref->last = *stats;
+    ref->last_time = ref->record->fcounters[NFS_F_START_TIMESTAMP];
+    nfs_runtime->mnt_count++;
+
+    return;
+}
+
+/* store a new snapshot for the given mount, if we are tracking it; the
+ * visitor argument is the timestamp of the snapshot
+ */
+static void nfs_update_mount(const char *mnt_pt, struct nfs_mount_stats *stats,
+    void *arg)
+{
+    double now = *(double *)arg;
+    struct nfs_mount_ref *ref;
+    struct darshan_nfs_record *rec;
+    int64_t ops;
+    double rate;
+    int i;
+
+    for(i = 0; i < nfs_runtime->mnt_count; i++)
+    {
+        ref = &nfs_runtime->mnt_refs[i];
+        if(strcmp(ref->mnt_pt, mnt_pt) != 0)
+            continue;
+
+        rec = ref->record;
+        rec->counters[NFS_SAMPLES] += 1;
+        /* the RPC rate is only tracked when periodic sampling is enabled */
+        ops = stats->counters[NFS_RPC_OPS] - ref->last.counters[NFS_RPC_OPS];
+        if(nfs_runtime->sample_interval > 0 && ops >= 0 && now > ref->last_time)
+        {
+            rate = (double)ops / (now - ref->last_time);
+            if(rate > rec->fcounters[NFS_F_MAX_RPC_RATE])
+                rec->fcounters[NFS_F_MAX_RPC_RATE] = rate;
+        }
+        ref->last = *stats;
+        ref->last_time = now;
+        return;
+    }
+
+    return;
+}
+
+/* take the final snapshot and convert each record's counters to deltas;
+ * must be called with the module lock held
+ */
+static void nfs_finalize_records()
+{
+    struct nfs_mount_ref *ref;
+    struct darshan_nfs_record *rec;
+    double now;
+    int64_t delta;
+    int i, j;
+
+    if(nfs_runtime->frozen)
+        return;
+    nfs_runtime->frozen = 1;
+    nfs_next_sample = 0;
+
+    /* NOTE: mounts that disappeared before shutdown keep their last snapshot */
+    now = darshan_core_wtime();
+    nfs_read_mountstats(nfs_runtime->mountstats_path, nfs_update_mount, &now);
+
+    for(i = 0; i < nfs_runtime->mnt_count; i++)
+    {
+        ref = &nfs_runtime->mnt_refs[i];
+        rec = ref->record;
+
+        rec->fcounters[NFS_F_END_TIMESTAMP] = now;
+
+        /* counters that went backwards indicate the mount was replaced */
+        for(j = NFS_INODE_REVALIDATES; j < NFS_NUM_INDICES; j++)
+        {
+            delta = ref->last.counters[j] - ref->start.counters[j];
+            rec->counters[j] = (delta < 0) ? -1 : delta;
+        }
+        for(j = NFS_F_RPC_QUEUE_TIME; j < NFS_F_NUM_INDICES; j++)
+        {
+            delta = ref->last.times_ms[j] - ref->start.times_ms[j];
+            rec->fcounters[j] = (delta < 0) ? -1 : (double)delta / 1000.0;
+        }
+    }
+
+    return;
+}
+
+/* determine whether a record saw any activity during the job */
+static int nfs_record_is_active(struct darshan_nfs_record *rec)
+{
+    int i;
+
+    for(i = NFS_INODE_REVALIDATES; i < NFS_NUM_INDICES; i++)
+    {
+        if(rec->counters[i] != 0)
+            return(1);
+    }
+
+    return(0);
+}
+
+void nfs_sample(double now)
+{
+    if(nfs_next_sample <= 0 || now < nfs_next_sample)
+        return;
+
+    NFS_LOCK();
+    if(!nfs_runtime || nfs_runtime->frozen ||
+       now < nfs_runtime->next_sample)
+    {
+        NFS_UNLOCK();
+        return;
+    }
+
+    /* schedule the next sample before doing anything else so that a
+     * failed snapshot does not cause us to retry on every operation
+     */
+    nfs_runtime->next_sample = now + nfs_runtime->sample_interval;
+    nfs_next_sample = nfs_runtime->next_sample;
+
+    nfs_read_mountstats(nfs_runtime->mountstats_path, nfs_update_mount, &now);
+
+    NFS_UNLOCK();
+    return;
+}
+
+/********************************************************************************
+ *      functions exported by this module for coordinating with darshan-core    *
+ ********************************************************************************/
+
+#ifdef HAVE_MPI
+static void nfs_mpi_redux(
+    void *nfs_buf,
+    MPI_Comm mod_comm,
+    darshan_record_id *shared_recs,
+    int shared_rec_count)
+{
+#if MPI_VERSION >= 3
+    MPI_Comm node_comm;
+    int node_rank, node_size;
+    int my_count;
+    int *counts = NULL, *displs = NULL;
+    struct darshan_nfs_record *recv_buf = NULL;
+    struct darshan_nfs_record *inrec, *rec;
+    int total = 0;
+    int i, j, k;
+
+    NFS_LOCK();
+    assert(nfs_runtime);
+
+    nfs_finalize_records();
+
+    /* NFS statistics are kept per mount on each node, so every process on a
+     * node observes (roughly) the same deltas.  Rather than summing records
+     * across the job, reduce them onto the lowest rank of each node.
+     */
+    PMPI_Comm_split_type(mod_comm, MPI_COMM_TYPE_SHARED, my_rank,
+        MPI_INFO_NULL, &node_comm);
+    PMPI_Comm_rank(node_comm, &node_rank);
+    PMPI_Comm_size(node_comm, &node_size);
+    if(node_size == 1)
+    {
+        PMPI_Comm_free(&node_comm);
+        NFS_UNLOCK();
+        return;
+    }
+
+    my_count = nfs_runtime->mnt_count * sizeof(struct darshan_nfs_record);
+    if(node_rank == 0)
+    {
+        counts = malloc(node_size * sizeof(*counts));
+        displs = malloc(node_size * sizeof(*displs));
+        assert(counts && displs);
+    }
+    PMPI_Gather(&my_count, 1, MPI_INT, counts, 1, MPI_INT, 0, node_comm);
+    if(node_rank == 0)
+    {
+        for(i = 0; i < node_size; i++)
+        {
+            displs[i] = total;
+            total += counts[i];
+        }
+        recv_buf = malloc(total);
+        assert(recv_buf);
+    }
+
+    /* NOTE: records are contiguous in the module buffer provided by
+     * darshan-core, in the order they were registered
+     */
+    PMPI_Gatherv(nfs_buf, my_count, MPI_BYTE, recv_buf, counts, displs,
+        MPI_BYTE, 0, node_comm);
+
+    if(node_rank == 0)
+    {
+        /* skip over our own records and merge the rest into ours */
+        for(i = counts[0] / sizeof(*inrec);
+            i < (int)(total / sizeof(*inrec)); i++)
+        {
+            inrec = &recv_buf[i];
+            for(j = 0; j < nfs_runtime->mnt_count; j++)
+            {
+                rec = nfs_runtime->mnt_refs[j].record;
+                if(rec->base_rec.id != inrec->base_rec.id)
+                    continue;
+
+                /* max of the (overlapping) deltas; -1 loses to valid values */
+                for(k = NFS_INODE_REVALIDATES; k < NFS_NUM_INDICES; k++)
+                {
+                    if(inrec->counters[k] > rec->counters[k])
+                        rec->counters[k] = inrec->counters[k];
+                }
+                for(k = NFS_F_MAX_RPC_RATE; k < NFS_F_NUM_INDICES; k++)
+                {
+                    if(inrec->fcounters[k] > rec->fcounters[k])
+                        rec->fcounters[k] = inrec->fcounters[k];
+                }
+
+                if(inrec->counters[NFS_VERSION] > rec->counters[NFS_VERSION])
+                    rec->counters[NFS_VERSION] = inrec->counters[NFS_VERSION];
+                rec->counters[NFS_PROCS] += inrec->counters[NFS_PROCS];
+                rec->counters[NFS_SAMPLES] += inrec->counters[NFS_SAMPLES];
+                if(inrec->fcounters[NFS_F_START_TIMESTAMP] <
+                   rec->fcounters[NFS_F_START_TIMESTAMP])
+                    rec->fcounters[NFS_F_START_TIMESTAMP] =
+                        inrec->fcounters[NFS_F_START_TIMESTAMP];
+                if(inrec->fcounters[NFS_F_END_TIMESTAMP] >
+                   rec->fcounters[NFS_F_END_TIMESTAMP])
+                    rec->fcounters[NFS_F_END_TIMESTAMP] =
+                        inrec->fcounters[NFS_F_END_TIMESTAMP];
+                break;
+            }
+            /* NOTE: mounts not visible to the node's lowest rank are dropped */
+        }
+
+        free(counts);
+        free(displs);
+        free(recv_buf);
+    }
+    else
+    {
+        nfs_runtime->reduced = 1;
+    }
+
+    PMPI_Comm_free(&node_comm);
+
+    NFS_UNLOCK();
+#endif
+    return;
+}
+#endif
+
+/* Pass output data for the NFS module back to darshan-core to log to file. */
+static void nfs_output(
+    void **nfs_buf,
+    int *nfs_buf_sz)
+{
+    struct darshan_nfs_record *recs;
+    int i, count = 0;
+
+    NFS_LOCK();
+    assert(nfs_runtime);
+
+    /* take the final snapshot now if no reduction occurred */
+    nfs_finalize_records();
+
+    /* processes whose records were reduced onto another rank on the same
+     * node don't write anything
+     */
+    if(nfs_runtime->reduced)
+    {
+        *nfs_buf = NULL;
+        *nfs_buf_sz = 0;
+        NFS_UNLOCK();
+        return;
+    }
+
+    /* compact the buffer, leaving out mounts that saw no activity */
+    recs = (struct darshan_nfs_record *)*nfs_buf;
+    for(i = 0; i < nfs_runtime->mnt_count; i++)
+    {
+        if(!nfs_record_is_active(&recs[i]))
+            continue;
+        if(i != count)
+            memcpy(&recs[count], &recs[i], sizeof(*recs));
+        count++;
+    }
+    *nfs_buf_sz = count * sizeof(struct darshan_nfs_record);
+
+    NFS_UNLOCK();
+    return;
+}
+
+static void nfs_cleanup()
+{
+    int i;
+
+    NFS_LOCK();
+    assert(nfs_runtime);
+
+    for(i = 0; i < nfs_runtime->mnt_count; i++)
+        free(nfs_runtime->mnt_refs[i].mnt_pt);
+    free(nfs_runtime->mnt_refs);
+    free(nfs_runtime->mountstats_path);
+    free(nfs_runtime);
+    nfs_runtime = NULL;
+    nfs_next_sample = 0;
+
+    NFS_UNLOCK();
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_NFS_H
+#define __DARSHAN_NFS_H
+
+#ifdef DARSHAN_NFS
+
+/* nfs_sample()
+ *
+ * gives the NFS module an opportunity to take a periodic snapshot of
+ * /proc/self/mountstats.  'now' is a Darshan timestamp (e.g., the end time
+ * of an I/O operation that was just instrumented).  This returns immediately
+ * unless periodic sampling is enabled and the sampling interval has elapsed.
+ */
+void nfs_sample(double now);
+
+#else
+
+/* provide a stub when the NFS module is disabled so that instrumentation
+ * modules calling into it do not need preprocessor guards
+ */
+#define nfs_sample(now) do {} while(0)
+
+#endif
+
+#endif /* __DARSHAN_NFS_H */
@@ -240,6 +240,8 @@ int DARSHAN_DECL(APINAME($1,$2,$3,$4))(int ncid, int varid, ArgKind($2)BufArgs($
         PNETCDF_VAR_PRE_RECORD();
         struct pnetcdf_var_record_ref *rec_ref;
         rec_ref = darshan_lookup_record_ref(pnetcdf_var_runtime->varid_hash, &varid, sizeof(int));
+        if (rec_ref) PNETCDF_VAR_REC_LOCK(rec_ref);
+        PNETCDF_VAR_POST_RECORD();
         if (rec_ref) {
             struct darshan_common_val_counter *cvc;
             int64_t common_access_vals[PNETCDF_VAR_MAX_NDIMS+PNETCDF_VAR_MAX_NDIMS+1] = {0};
@@ -247,8 +249,8 @@ int DARSHAN_DECL(APINAME($1,$2,$3,$4))(int ncid, int varid, ArgKind($2)BufArgs($
             CALC_ACCESS_INFO($2,ncid,access_size)
             UPDATE_GETPUT_COUNTERS($1,$2,access_size)
             UPDATE_INDEPCOLL_RW_COUNTER($1,$4);
+            PNETCDF_VAR_REC_UNLOCK(rec_ref);
         }
-        PNETCDF_VAR_POST_RECORD();
     }
     return(ret);
 }
@@ -283,6 +285,8 @@ int DARSHAN_DECL(APINAME($1,n,$2,$3))(int ncid, int varid, int num, MPI_Offset*
         PNETCDF_VAR_PRE_RECORD();
         struct pnetcdf_var_record_ref *rec_ref;
         rec_ref = darshan_lookup_record_ref(pnetcdf_var_runtime->varid_hash, &varid, sizeof(int));
+        if (rec_ref) PNETCDF_VAR_REC_LOCK(rec_ref);
+        PNETCDF_VAR_POST_RECORD();
         if (rec_ref) {
             struct darshan_common_val_counter *cvc;
             int64_t common_access_vals[PNETCDF_VAR_MAX_NDIMS+PNETCDF_VAR_MAX_NDIMS+1] = {0};
@@ -290,8 +294,8 @@ int DARSHAN_DECL(APINAME($1,n,$2,$3))(int ncid, int varid, int num, MPI_Offset*
             CALC_ACCESS_INFO(n,ncid,access_size)
             UPDATE_GETPUT_COUNTERS($1,n,access_size)
             UPDATE_INDEPCOLL_RW_COUNTER($1,$3);
+            PNETCDF_VAR_REC_UNLOCK(rec_ref);
         }
-        PNETCDF_VAR_POST_RECORD();
     }
     return(ret);
 }
@@ -325,6 +329,8 @@ int DARSHAN_DECL(ncmpi_$1_vard$2)(int ncid, int varid, MPI_Datatype filetype, if
         PNETCDF_VAR_PRE_RECORD();
         struct pnetcdf_var_record_ref *rec_ref;
         rec_ref = darshan_lookup_record_ref(pnetcdf_var_runtime->varid_hash, &varid, sizeof(int));
+        if (rec_ref) PNETCDF_VAR_REC_LOCK(rec_ref);
+        PNETCDF_VAR_POST_RECORD();
         if (rec_ref) {
             struct darshan_common_val_counter *cvc;
             int64_t common_access_vals[PNETCDF_VAR_MAX_NDIMS+PNETCDF_VAR_MAX_NDIMS+1] = {0};
@@ -332,8 +338,8 @@ int DARSHAN_DECL(ncmpi_$1_vard$2)(int ncid, int varid, MPI_Datatype filetype, if
             CALC_ACCESS_INFO(d,ncid,access_size)
             UPDATE_GETPUT_COUNTERS($1,d,access_size)
             UPDATE_INDEPCOLL_RW_COUNTER($1,$2);
+            PNETCDF_VAR_REC_UNLOCK(rec_ref);
         }
-        PNETCDF_VAR_POST_RECORD();
     }
     return(ret);
 }
@@ -370,11 +376,16 @@ int DARSHAN_DECL(APINAME($1,$2,$3))(int ncid, int varid, ArgKind($2)BufArgs($1,$
             struct darshan_common_val_counter *cvc;
             int64_t common_access_vals[PNETCDF_VAR_MAX_NDIMS+PNETCDF_VAR_MAX_NDIMS+1] = {0};
             size_t access_size;
+            PNETCDF_VAR_REC_LOCK(rec_ref);
             CALC_ACCESS_INFO($2,ncid,access_size)
             UPDATE_GETPUT_COUNTERS($1,$2,access_size)
             ifelse($1,`iget',
             `rec_ref->var_rec->counters[PNETCDF_VAR_NB_READS] += 1;',
             `rec_ref->var_rec->counters[PNETCDF_VAR_NB_WRITES] += 1;')
+            pnetcdf_nb_track_request(ncid, reqid, rec_ref,
+                ifelse($1,`iget',`DARSHAN_IO_READ',`DARSHAN_IO_WRITE'),
+                ifelse($1,`bput',`1',`0'), access_size);
+            PNETCDF_VAR_REC_UNLOCK(rec_ref);
         }
         PNETCDF_VAR_POST_RECORD();
     }
@@ -414,11 +425,16 @@ int DARSHAN_DECL(APINAME($1,n,$2))(int ncid, int varid, int num, MPI_Offset* con
             struct darshan_common_val_counter *cvc;
             int64_t common_access_vals[PNETCDF_VAR_MAX_NDIMS+PNETCDF_VAR_MAX_NDIMS+1] = {0};
             size_t access_size;
+            PNETCDF_VAR_REC_LOCK(rec_ref);
             CALC_ACCESS_INFO(n,ncid,access_size)
             UPDATE_GETPUT_COUNTERS($1,n,access_size)
             ifelse($1,`iget',
             `rec_ref->var_rec->counters[PNETCDF_VAR_NB_READS] += 1;',
             `rec_ref->var_rec->counters[PNETCDF_VAR_NB_WRITES] += 1;')
+            pnetcdf_nb_track_request(ncid, reqid, rec_ref,
+                ifelse($1,`iget',`DARSHAN_IO_READ',`DARSHAN_IO_WRITE'),
+                ifelse($1,`bput',`1',`0'), access_size);
+            PNETCDF_VAR_REC_UNLOCK(rec_ref);
         }
         PNETCDF_VAR_POST_RECORD();
     }
@@ -542,6 +558,10 @@ int DARSHAN_DECL(ncmpi_close)(int ncid)
     tm2 = PNETCDF_WTIME();
 
     if (ret == NC_NOERR) {
+        /* stop tracking any requests left pending on this file */
+        if (pnetcdf_nb_pending_count && !__darshan_disabled)
+            pnetcdf_nb_complete_requests(ncid, NC_REQ_ALL, NULL, NULL, 0, 0, 0);
+
         PNETCDF_FILE_PRE_RECORD();
         rec_ref = darshan_lookup_record_ref(pnetcdf_file_runtime->ncid_hash,
             &ncid, sizeof(int));
@@ -632,13 +652,27 @@ int DARSHAN_DECL(ncmpi_wait)(int ncid, int num, int array_of_requests[],
 {
     int ret;
     double tm1, tm2;
+    int req_buf[PNETCDF_NB_REQ_BUF_SIZE];
+    int *reqs = NULL;
 
     MAP_OR_FAIL(ncmpi_wait);
 
+    /* save request IDs so completed requests can be matched to the
+     * variables that posted them
+     */
+    if (pnetcdf_nb_pending_count && num > 0 && array_of_requests)
+        reqs = pnetcdf_nb_save_requests(num, array_of_requests, req_buf);
+
     tm1 = PNETCDF_WTIME();
     ret = __real_ncmpi_wait(ncid, num, array_of_requests, array_of_statuses);
     tm2 = PNETCDF_WTIME();
 
+    if (pnetcdf_nb_pending_count && (reqs || num < 0) && !__darshan_disabled)
+        pnetcdf_nb_complete_requests(ncid, num, reqs, array_of_statuses,
+            (ret == NC_NOERR), tm1, tm2);
+    if (reqs != req_buf)
+        free(reqs);
+
     PNETCDF_FILE_PRE_RECORD();
     struct pnetcdf_file_record_ref *rec_ref;
     rec_ref = darshan_lookup_record_ref(pnetcdf_file_runtime->ncid_hash, &ncid, sizeof(int));
@@ -668,13 +702,27 @@ int DARSHAN_DECL(ncmpi_wait_all)(int ncid, int num, int array_of_requests[],
 {
     int ret;
     double tm1, tm2;
+    int req_buf[PNETCDF_NB_REQ_BUF_SIZE];
+    int *reqs = NULL;
 
     MAP_OR_FAIL(ncmpi_wait_all);
 
+    /* save request IDs so completed requests can be matched to the
+     * variables that posted them
+     */
+    if (pnetcdf_nb_pending_count && num > 0 && array_of_requests)
+        reqs = pnetcdf_nb_save_requests(num, array_of_requests, req_buf);
+
     tm1 = PNETCDF_WTIME();
     ret = __real_ncmpi_wait_all(ncid, num, array_of_requests, array_of_statuses);
     tm2 = PNETCDF_WTIME();
 
+    if (pnetcdf_nb_pending_count && (reqs || num < 0) && !__darshan_disabled)
+        pnetcdf_nb_complete_requests(ncid, num, reqs, array_of_statuses,
+            (ret == NC_NOERR), tm1, tm2);
+    if (reqs != req_buf)
+        free(reqs);
+
     PNETCDF_FILE_PRE_RECORD();
     struct pnetcdf_file_record_ref *rec_ref;
     rec_ref = darshan_lookup_record_ref(pnetcdf_file_runtime->ncid_hash, &ncid, sizeof(int));
@@ -697,6 +745,53 @@ int DARSHAN_DECL(ncmpi_wait_all)(int ncid, int num, int array_of_requests[],
     return(ret);
 }
 
+DARSHAN_FORWARD_DECL(ncmpi_cancel, int, (int ncid, int num, int *requests, int *statuses));
+
+int DARSHAN_DECL(ncmpi_cancel)(int ncid, int num, int *requests, int *statuses)
+{
+    int ret;
+    int req_buf[PNETCDF_NB_REQ_BUF_SIZE];
+    int *reqs = NULL;
+
+    MAP_OR_FAIL(ncmpi_cancel);
+
+    if (pnetcdf_nb_pending_count && num > 0 && requests)
+        reqs = pnetcdf_nb_save_requests(num, requests, req_buf);
+
+    ret = __real_ncmpi_cancel(ncid, num, requests, statuses);
+
+    /* cancelled requests no longer count as pending, but no wait time is
+     * attributed to them
+     */
+    if (pnetcdf_nb_pending_count && (reqs || num < 0) && !__darshan_disabled)
+        pnetcdf_nb_complete_requests(ncid, num, reqs, statuses, 0, 0, 0);
+    if (reqs != req_buf)
+        free(reqs);
+
+    return(ret);
+}
+
+DARSHAN_FORWARD_DECL(ncmpi_buffer_attach, int, (int ncid, MPI_Offset bufsize));
+
+int DARSHAN_DECL(ncmpi_buffer_attach)(int ncid, MPI_Offset bufsize)
+{
+    int ret;
+
+    MAP_OR_FAIL(ncmpi_buffer_attach);
+
+    ret = __real_ncmpi_buffer_attach(ncid, bufsize);
+
+    if (ret == NC_NOERR) {
+        PNETCDF_FILE_PRE_RECORD();
+        struct pnetcdf_file_record_ref *rec_ref;
+        rec_ref = darshan_lookup_record_ref(pnetcdf_file_runtime->ncid_hash, &ncid, sizeof(int));
+        if (rec_ref && bufsize > rec_ref->file_rec->counters[PNETCDF_FILE_BUFFER_ATTACH_SIZE])
+            rec_ref->file_rec->counters[PNETCDF_FILE_BUFFER_ATTACH_SIZE] = bufsize;
+        PNETCDF_FILE_POST_RECORD();
+    }
+    return(ret);
+}
+
 DARSHAN_FORWARD_DECL(ncmpi_sync, int, (int ncid));
 
 int DARSHAN_DECL(ncmpi_sync)(int ncid)
@@ -758,6 +853,7 @@ define(`PNETCDF_VAR_RECORD_OPEN',`
         if (!rec_ref) rec_ref = pnetcdf_var_track_new_record(rec_id, rec_name);
         free(rec_name);
         if (!rec_ref) break;
+        PNETCDF_VAR_REC_LOCK(rec_ref);
         rec_ref->var_rec->counters[PNETCDF_VAR_OPENS] += 1;
         if (rec_ref->var_rec->fcounters[PNETCDF_VAR_F_OPEN_START_TIMESTAMP] == 0 ||
             rec_ref->var_rec->fcounters[PNETCDF_VAR_F_OPEN_START_TIMESTAMP] > $7)
@@ -786,6 +882,7 @@ define(`PNETCDF_VAR_RECORD_OPEN',`
         else type_size = 8;
         rec_ref->var_rec->counters[PNETCDF_VAR_DATATYPE_SIZE] = type_size;
         rec_ref->var_rec->file_rec_id = file_rec_id;
+        PNETCDF_VAR_REC_UNLOCK(rec_ref);
         darshan_add_record_ref(&(pnetcdf_var_runtime->varid_hash), $6, sizeof(int), rec_ref);
     } while (0);
 ')dnl
@@ -35,6 +35,8 @@ struct pnetcdf_file_record_ref
     struct darshan_pnetcdf_file* file_rec;
     double last_meta_end;
     double last_wait_end;
+    int64_t nb_pending;
+    int64_t bput_pending_bytes;
 };
 
 /* structure that can track i/o stats for a given PnetCDF variable record at runtime */
@@ -48,6 +50,40 @@ struct pnetcdf_var_record_ref
     void *access_root;
     int access_count;
     int unlimdimid;
+    int64_t nb_pending;
+    /* protects the fields of this record ref and its variable record */
+    pthread_mutex_t lock;
+};
+
+/* key identifying a PnetCDF nonblocking request; request IDs are only
+ * unique within a given file
+ */
+struct pnetcdf_nb_request_key
+{
+    int ncid;
+    int reqid;
+};
+
+/* structure to track a posted PnetCDF nonblocking request until it is
+ * completed by ncmpi_wait/ncmpi_wait_all
+ */
+struct pnetcdf_nb_request_ref
+{
+    struct pnetcdf_nb_request_key key;
+    struct pnetcdf_var_record_ref *var_ref;
+    enum darshan_io_type io_type;
+    int is_bput;
+    int failed;
+    int64_t length;
+};
+
+/* list of pending requests gathered while iterating the request hash */
+struct pnetcdf_nb_request_list
+{
+    int ncid;
+    int num;
+    struct pnetcdf_nb_request_ref **refs;
+    int count;
 };
 
 /* struct to encapsulate runtime state for the PnetCDF file module */
@@ -64,6 +100,7 @@ struct pnetcdf_var_runtime
 {
     void *rec_id_hash;
     void *varid_hash;
+    void *req_hash;
     int rec_count;
     int frozen; /* flag to indicate that the counters should no longer be modified */
 };
@@ -76,6 +113,16 @@ static struct pnetcdf_var_record_ref *pnetcdf_var_track_new_record(
     darshan_record_id rec_id, const char *path);
 static void pnetcdf_var_finalize_records(
     void *rec_ref_p, void *user_ptr);
+static void pnetcdf_var_wait_record(
+    void *rec_ref_p, void *user_ptr);
+static void pnetcdf_nb_track_request(
+    int ncid, int *reqid, struct pnetcdf_var_record_ref *var_ref,
+    enum darshan_io_type io_type, int is_bput, int64_t length);
+static int *pnetcdf_nb_save_requests(
+    int num, int *reqs, int *req_buf);
+static void pnetcdf_nb_complete_requests(
+    int ncid, int num, int *reqs, int *statuses, int attribute,
+    double tm1, double tm2);
 static void pnetcdf_file_record_reduction_op(
     void* infile_v, void* inoutfile_v, int *len, MPI_Datatype *datatype);
 static void pnetcdf_var_record_reduction_op(
@@ -104,9 +151,33 @@ static int pnetcdf_var_runtime_init_attempted = 0;
 static pthread_mutex_t pnetcdf_runtime_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
 static int my_rank = -1;
 
+/* number of nonblocking requests currently tracked; lets the wait wrappers
+ * skip saving request IDs when nothing is pending
+ */
+static int pnetcdf_nb_pending_count = 0;
+
+/* limit on pending nonblocking requests tracked per process, to bound the
+ * memory used by applications that never wait on their requests
+ */
+#define PNETCDF_NB_MAX_PENDING 8192
+/* request IDs passed to wait calls are saved on the stack up to this count */
+#define PNETCDF_NB_REQ_BUF_SIZE 32
+
 #define PNETCDF_LOCK() pthread_mutex_lock(&pnetcdf_runtime_mutex)
 #define PNETCDF_UNLOCK() pthread_mutex_unlock(&pnetcdf_runtime_mutex)
 
+/* variable records are updated by blocking get/put calls holding only their
+ * own lock, so that threads accessing different variables only contend on
+ * the module lock while looking up their records.  A record lock may only be
+ * acquired while holding the module lock (which may then be dropped), and the
+ * module lock is never acquired while holding a record lock.  This lets the
+ * shutdown path wait out any in-progress updates by cycling through the
+ * record locks.  Nonblocking calls keep holding the module lock as well, as
+ * they update the request tracking state shared with the wait calls.
+ */
+#define PNETCDF_VAR_REC_LOCK(__rec_ref) pthread_mutex_lock(&(__rec_ref)->lock)
+#define PNETCDF_VAR_REC_UNLOCK(__rec_ref) pthread_mutex_unlock(&(__rec_ref)->lock)
+
 #define PNETCDF_WTIME() \
     __darshan_disabled ? 0 : darshan_core_wtime();
 
@@ -326,6 +397,7 @@ static struct pnetcdf_var_record_ref *pnetcdf_var_track_new_record(
     var_rec->base_rec.id = rec_id;
     var_rec->base_rec.rank = my_rank;
     rec_ref->var_rec = var_rec;
+    pthread_mutex_init(&rec_ref->lock, NULL);
     pnetcdf_var_runtime->rec_count++;
 
     return(rec_ref);
@@ -337,6 +409,240 @@ static void pnetcdf_var_finalize_records(void *rec_ref_p, void *user_ptr)
         (struct pnetcdf_var_record_ref *)rec_ref_p;
 
     tdestroy(rec_ref->access_root, free);
+    pthread_mutex_destroy(&rec_ref->lock);
+    return;
+}
+
+/* wait for any thread still updating the given variable record to finish;
+ * must be called with the PnetCDF lock held, after which no thread can
+ * acquire the record lock until the PnetCDF lock is released
+ */
+static void pnetcdf_var_wait_record(void *rec_ref_p, void *user_ptr)
+{
+    struct pnetcdf_var_record_ref *rec_ref =
+        (struct pnetcdf_var_record_ref *)rec_ref_p;
+
+    PNETCDF_VAR_REC_LOCK(rec_ref);
+    PNETCDF_VAR_REC_UNLOCK(rec_ref);
+    return;
+}
+
+/* start tracking a nonblocking request posted by an iput/iget/bput call so
+ * that the time spent completing it in a later wait call can be attributed
+ * back to its variable; must be called with the PnetCDF lock held
+ */
+static void pnetcdf_nb_track_request(
+    int ncid, int *reqid, struct pnetcdf_var_record_ref *var_ref,
+    enum darshan_io_type io_type, int is_bput, int64_t length)
+{
+    struct pnetcdf_nb_request_ref *req_ref;
+    struct pnetcdf_file_record_ref *file_ref = NULL;
+
+    /* requests without an ID (or zero-length requests, which PnetCDF
+     * completes immediately) are never individually waited on
+     */
+    if(!reqid || *reqid == NC_REQ_NULL)
+        return;
+    if(pnetcdf_nb_pending_count >= PNETCDF_NB_MAX_PENDING)
+        return;
+
+    req_ref = calloc(1, sizeof(*req_ref));
+    if(!req_ref)
+        return;
+    req_ref->key.ncid = ncid;
+    req_ref->key.reqid = *reqid;
+    req_ref->var_ref = var_ref;
+    req_ref->io_type = io_type;
+    req_ref->is_bput = is_bput;
+    req_ref->length = length;
+
+    /* drop any stale entry for a request ID that PnetCDF has reused */
+    free(darshan_delete_record_ref(&(pnetcdf_var_runtime->req_hash),
+        &req_ref->key, sizeof(req_ref->key)));
+    if(!darshan_add_record_ref(&(pnetcdf_var_runtime->req_hash),
+        &req_ref->key, sizeof(req_ref->key), req_ref))
+    {
+        free(req_ref);
+        return;
+    }
+    pnetcdf_nb_pending_count++;
+
+    var_ref->nb_pending++;
+    if(var_ref->nb_pending > var_ref->var_rec->counters[PNETCDF_VAR_NB_MAX_PENDING])
+        var_ref->var_rec->counters[PNETCDF_VAR_NB_MAX_PENDING] = var_ref->nb_pending;
+
+    if(pnetcdf_file_runtime)
+        file_ref = darshan_lookup_record_ref(pnetcdf_file_runtime->ncid_hash,
+            &ncid, sizeof(int));
+    if(file_ref)
+    {
+        file_ref->nb_pending++;
+        if(file_ref->nb_pending > file_ref->file_rec->counters[PNETCDF_FILE_NB_MAX_PENDING])
+            file_ref->file_rec->counters[PNETCDF_FILE_NB_MAX_PENDING] = file_ref->nb_pending;
+        if(is_bput)
+        {
+            file_ref->bput_pending_bytes += length;
+            if(file_ref->bput_pending_bytes >
+                file_ref->file_rec->counters[PNETCDF_FILE_BPUT_MAX_PENDING_BYTES])
+                file_ref->file_rec->counters[PNETCDF_FILE_BPUT_MAX_PENDING_BYTES] =
+                    file_ref->bput_pending_bytes;
+        }
+    }
+
+    return;
+}
+
+/* copy the request IDs passed to a wait call, since PnetCDF overwrites
+ * them with NC_REQ_NULL as the requests complete
+ */
+static int *pnetcdf_nb_save_requests(int num, int *reqs, int *req_buf)
+{
+    int *saved = req_buf;
+
+    if(num > PNETCDF_NB_REQ_BUF_SIZE)
+    {
+        saved = malloc(num * sizeof(*saved));
+        if(!saved)
+            return(NULL);
+    }
+    memcpy(saved, reqs, num * sizeof(*saved));
+
+    return(saved);
+}
+
+static void pnetcdf_nb_gather_requests(void *ref_p, void *user_ptr)
+{
+    struct pnetcdf_nb_request_ref *req_ref = ref_p;
+    struct pnetcdf_nb_request_list *list = user_ptr;
+
+    if(req_ref->key.ncid != list->ncid)
+        return;
+    if((list->num == NC_GET_REQ_ALL && req_ref->io_type != DARSHAN_IO_READ) ||
+       (list->num == NC_PUT_REQ_ALL && req_ref->io_type != DARSHAN_IO_WRITE))
+        return;
+    list->refs[list->count++] = req_ref;
+
+    return;
+}
+
+/* stop tracking the given requests on file 'ncid'.  'num' may be one of
+ * PnetCDF's NC_*REQ_ALL selectors, in which case 'reqs' is ignored and all
+ * matching pending requests on the file are selected.  If 'attribute' is
+ * set, the time between tm1 and tm2 is split among the variables of the
+ * successfully completed requests in proportion to their sizes.
+ */
+static void pnetcdf_nb_complete_requests(
+    int ncid, int num, int *reqs, int *statuses, int attribute,
+    double tm1, double tm2)
+{
+    struct pnetcdf_nb_request_list list;
+    struct pnetcdf_nb_request_ref *req_ref;
+    struct pnetcdf_file_record_ref *file_ref = NULL;
+    struct pnetcdf_nb_request_key key;
+    int64_t total_bytes = 0;
+    int completed = 0;
+    double share;
+    int i;
+
+    PNETCDF_LOCK();
+    if(!pnetcdf_var_runtime || pnetcdf_var_runtime->frozen ||
+       !pnetcdf_nb_pending_count)
+    {
+        PNETCDF_UNLOCK();
+        return;
+    }
+
+    /* collect the tracked requests being completed */
+    list.ncid = ncid;
+    list.num = num;
+    list.count = 0;
+    if(num == NC_REQ_ALL || num == NC_GET_REQ_ALL || num == NC_PUT_REQ_ALL)
+    {
+        list.refs = malloc(pnetcdf_nb_pending_count * sizeof(*list.refs));
+        if(list.refs)
+            darshan_iter_record_refs(pnetcdf_var_runtime->req_hash,
+                &pnetcdf_nb_gather_requests, &list);
+        /* no per-request status is available for these selectors */
+        statuses = NULL;
+    }
+    else
+    {
+        list.refs = (num > 0) ? malloc(num * sizeof(*list.refs)) : NULL;
+        for(i = 0; list.refs && i < num; i++)
+        {
+            key.ncid = ncid;
+            key.reqid = reqs[i];
+            req_ref = darshan_lookup_record_ref(pnetcdf_var_runtime->req_hash,
+                &key, sizeof(key));
+            if(!req_ref)
+                continue;
+            /* only attribute requests that completed successfully */
+            if(statuses && statuses[i] != NC_NOERR)
+                req_ref->failed = 1;
+            list.refs[list.count++] = req_ref;
+        }
+    }
+    if(!list.refs)
+    {
+        PNETCDF_UNLOCK();
+        return;
+    }
+
+    for(i = 0; i < list.count; i++)
+    {
+        if(list.refs[i]->failed)
+            continue;
+        total_bytes += list.refs[i]->length;
+        completed++;
+    }
+
+    if(pnetcdf_file_runtime)
+        file_ref = darshan_lookup_record_ref(pnetcdf_file_runtime->ncid_hash,
+            &ncid, sizeof(int));
+
+    for(i = 0; i < list.count; i++)
+    {
+        req_ref = list.refs[i];
+        darshan_delete_record_ref(&(pnetcdf_var_runtime->req_hash),
+            &req_ref->key, sizeof(req_ref->key));
+        pnetcdf_nb_pending_count--;
+        req_ref->var_ref->nb_pending--;
+        if(file_ref)
+        {
+            file_ref->nb_pending--;
+            if(req_ref->is_bput)
+                file_ref->bput_pending_bytes -= req_ref->length;
+        }
+
+        if(attribute && !req_ref->failed)
+        {
+            /* requests of zero total size get an equal share */
+            if(total_bytes > 0)
+                share = (tm2 - tm1) * ((double)req_ref->length / total_bytes);
+            else
+                share = (tm2 - tm1) / completed;
+
+            if(req_ref->io_type == DARSHAN_IO_READ)
+            {
+                req_ref->var_ref->var_rec->counters[PNETCDF_VAR_NB_WAIT_BYTES_READ] +=
+                    req_ref->length;
+                req_ref->var_ref->var_rec->fcounters[PNETCDF_VAR_F_NB_READ_WAIT_TIME] +=
+                    share;
+            }
+            else
+            {
+                req_ref->var_ref->var_rec->counters[PNETCDF_VAR_NB_WAIT_BYTES_WRITTEN] +=
+                    req_ref->length;
+                req_ref->var_ref->var_rec->fcounters[PNETCDF_VAR_F_NB_WRITE_WAIT_TIME] +=
+                    share;
+            }
+        }
+
+        free(req_ref);
+    }
+
+    free(list.refs);
+    PNETCDF_UNLOCK();
     return;
 }
 
@@ -357,11 +663,20 @@ static void pnetcdf_file_record_reduction_op(void* infile_v, void* inoutfile_v,
         tmp_file.base_rec.rank = -1;
 
         /* sum */
-        for(j=PNETCDF_FILE_CREATES; j<PNETCDF_FILE_NUM_INDICES; j++)
+        for(j=PNETCDF_FILE_CREATES; j<=PNETCDF_FILE_WAIT_FAILURES; j++)
         {
             tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
         }
 
+        /* max */
+        for(j=PNETCDF_FILE_NB_MAX_PENDING; j<=PNETCDF_FILE_BPUT_MAX_PENDING_BYTES; j++)
+        {
+            if(infile->counters[j] > inoutfile->counters[j])
+                tmp_file.counters[j] = infile->counters[j];
+            else
+                tmp_file.counters[j] = inoutfile->counters[j];
+        }
+
         /* min non-zero (if available) value */
         for(j=PNETCDF_FILE_F_OPEN_START_TIMESTAMP; j<=PNETCDF_FILE_F_WAIT_START_TIMESTAMP; j++)
         {
@@ -472,6 +787,21 @@ static void pnetcdf_var_record_reduction_op(void* inrec_v, void* inoutrec_v,
                 inrec->counters[PNETCDF_VAR_IS_RECORD_VAR] == 1)
             tmp_var.counters[PNETCDF_VAR_IS_RECORD_VAR] = 1;
 
+        /* sum */
+        for(j=PNETCDF_VAR_NB_WAIT_BYTES_READ; j<=PNETCDF_VAR_NB_WAIT_BYTES_WRITTEN; j++)
+        {
+            tmp_var.counters[j] = inrec->counters[j] + inoutrec->counters[j];
+        }
+
+        /* max */
+        if(inrec->counters[PNETCDF_VAR_NB_MAX_PENDING] >
+            inoutrec->counters[PNETCDF_VAR_NB_MAX_PENDING])
+            tmp_var.counters[PNETCDF_VAR_NB_MAX_PENDING] =
+                inrec->counters[PNETCDF_VAR_NB_MAX_PENDING];
+        else
+            tmp_var.counters[PNETCDF_VAR_NB_MAX_PENDING] =
+                inoutrec->counters[PNETCDF_VAR_NB_MAX_PENDING];
+
         /* min non-zero (if available) value */
         for(j=PNETCDF_VAR_F_OPEN_START_TIMESTAMP; j<=PNETCDF_VAR_F_CLOSE_START_TIMESTAMP; j++)
         {
@@ -497,6 +827,12 @@ static void pnetcdf_var_record_reduction_op(void* inrec_v, void* inoutrec_v,
             tmp_var.fcounters[j] = inrec->fcounters[j] + inoutrec->fcounters[j];
         }
 
+        /* sum */
+        for(j=PNETCDF_VAR_F_NB_READ_WAIT_TIME; j<=PNETCDF_VAR_F_NB_WRITE_WAIT_TIME; j++)
+        {
+            tmp_var.fcounters[j] = inrec->fcounters[j] + inoutrec->fcounters[j];
+        }
+
         /* max (special case) */
         if(inrec->fcounters[PNETCDF_VAR_F_MAX_READ_TIME] >
             inoutrec->fcounters[PNETCDF_VAR_F_MAX_READ_TIME])
@@ -772,6 +1108,10 @@ static void pnetcdf_var_mpi_redux(
     PNETCDF_LOCK();
     assert(pnetcdf_var_runtime);
 
+    /* wait out any updates to variable records that are still in progress */
+    darshan_iter_record_refs(pnetcdf_var_runtime->rec_id_hash,
+        &pnetcdf_var_wait_record, NULL);
+
     rec_count = pnetcdf_var_runtime->rec_count;
 
     /* necessary initialization of shared records */
@@ -901,7 +1241,12 @@ static void pnetcdf_var_output(
     rec_count = pnetcdf_var_runtime->rec_count;
     *pnetcdf_buf_sz = rec_count * sizeof(struct darshan_pnetcdf_var);
 
+    /* no new updates can start once the counters are frozen, so this is
+     * the last time we need to wait for updates in progress
+     */
     pnetcdf_var_runtime->frozen = 1;
+    darshan_iter_record_refs(pnetcdf_var_runtime->rec_id_hash,
+        &pnetcdf_var_wait_record, NULL);
 
     PNETCDF_UNLOCK();
     return;
@@ -936,6 +1281,8 @@ static void pnetcdf_var_cleanup(void)
         &pnetcdf_var_finalize_records, NULL);
 
     /* cleanup internal structures used for instrumenting */
+    darshan_clear_record_refs(&(pnetcdf_var_runtime->req_hash), 1);
+    pnetcdf_nb_pending_count = 0;
     darshan_clear_record_refs(&(pnetcdf_var_runtime->varid_hash), 0);
     darshan_clear_record_refs(&(pnetcdf_var_runtime->rec_id_hash), 1);
 
@@ -29,12 +29,19 @@
 #include <aio.h>
 #include <pthread.h>
 #include <limits.h>
+#ifdef HAVE_LIBAIO_H
+#include <libaio.h>
+#endif
 
 #include "utlist.h"
 #include "darshan.h"
 #include "darshan-dynamic.h"
 #include "darshan-dxt.h"
 #include "darshan-heatmap.h"
+#include "darshan-procio.h"
+#include "darshan-nfs.h"
+#include "darshan-snapshot.h"
+#include "darshan-imbalance.h"
 #include "darshan-ldms.h"
 
 #ifndef HAVE_OFF64_T
@@ -92,12 +99,50 @@ DARSHAN_FORWARD_DECL(__lxstat, int, (int vers, const char* path, struct stat *bu
 DARSHAN_FORWARD_DECL(__lxstat64, int, (int vers, const char* path, struct stat64 *buf));
 DARSHAN_FORWARD_DECL(__fxstat, int, (int vers, int fd, struct stat *buf));
 DARSHAN_FORWARD_DECL(__fxstat64, int, (int vers, int fd, struct stat64 *buf));
+DARSHAN_FORWARD_DECL(__fxstatat, int, (int vers, int dirfd, const char *path, struct stat *buf, int flags));
+DARSHAN_FORWARD_DECL(__fxstatat64, int, (int vers, int dirfd, const char *path, struct stat64 *buf, int flags));
+#ifdef HAVE_STAT_SYMBOLS
+/* glibc 2.33 and later export the stat family directly rather than as
+ * inline wrappers around the __xstat family above
+ */
+DARSHAN_FORWARD_DECL(stat, int, (const char *path, struct stat *buf));
+DARSHAN_FORWARD_DECL(stat64, int, (const char *path, struct stat64 *buf));
+DARSHAN_FORWARD_DECL(lstat, int, (const char *path, struct stat *buf));
+DARSHAN_FORWARD_DECL(lstat64, int, (const char *path, struct stat64 *buf));
+DARSHAN_FORWARD_DECL(fstat, int, (int fd, struct stat *buf));
+DARSHAN_FORWARD_DECL(fstat64, int, (int fd, struct stat64 *buf));
+DARSHAN_FORWARD_DECL(fstatat, int, (int dirfd, const char *path, struct stat *buf, int flags));
+DARSHAN_FORWARD_DECL(fstatat64, int, (int dirfd, const char *path, struct stat64 *buf, int flags));
+#endif
+#ifdef HAVE_STATX
+DARSHAN_FORWARD_DECL(statx, int, (int dirfd, const char *path, int flags, unsigned int mask, struct statx *buf));
+#endif
 #ifdef DARSHAN_WRAP_MMAP
 DARSHAN_FORWARD_DECL(mmap, void*, (void *addr, size_t length, int prot, int flags, int fd, off_t offset));
 DARSHAN_FORWARD_DECL(mmap64, void*, (void *addr, size_t length, int prot, int flags, int fd, off64_t offset));
 #endif /* DARSHAN_WRAP_MMAP */
+DARSHAN_FORWARD_DECL(fcntl, int, (int fd, int cmd, ...));
+#ifdef HAVE_FCNTL64
+DARSHAN_FORWARD_DECL(fcntl64, int, (int fd, int cmd, ...));
+#endif
 DARSHAN_FORWARD_DECL(fsync, int, (int fd));
 DARSHAN_FORWARD_DECL(fdatasync, int, (int fd));
+DARSHAN_FORWARD_DECL(posix_fadvise, int, (int fd, off_t offset, off_t len, int advice));
+DARSHAN_FORWARD_DECL(posix_fadvise64, int, (int fd, off64_t offset, off64_t len, int advice));
+DARSHAN_FORWARD_DECL(readahead, ssize_t, (int fd, off64_t offset, size_t count));
+DARSHAN_FORWARD_DECL(fallocate, int, (int fd, int mode, off_t offset, off_t len));
+DARSHAN_FORWARD_DECL(fallocate64, int, (int fd, int mode, off64_t offset, off64_t len));
+DARSHAN_FORWARD_DECL(posix_fallocate, int, (int fd, off_t offset, off_t len));
+DARSHAN_FORWARD_DECL(posix_fallocate64, int, (int fd, off64_t offset, off64_t len));
+DARSHAN_FORWARD_DECL(ftruncate, int, (int fd, off_t length));
+DARSHAN_FORWARD_DECL(ftruncate64, int, (int fd, off64_t length));
+DARSHAN_FORWARD_DECL(truncate, int, (const char *path, off_t length));
+DARSHAN_FORWARD_DECL(truncate64, int, (const char *path, off64_t length));
+DARSHAN_FORWARD_DECL(sync_file_range, int, (int fd, off64_t offset, off64_t nbytes, unsigned int flags));
+#ifdef DARSHAN_WRAP_MMAP
+DARSHAN_FORWARD_DECL(madvise, int, (void *addr, size_t length, int advice));
+DARSHAN_FORWARD_DECL(munmap, int, (void *addr, size_t length));
+#endif /* DARSHAN_WRAP_MMAP */
 DARSHAN_FORWARD_DECL(close, int, (int fd));
 DARSHAN_FORWARD_DECL(aio_read, int, (struct aiocb *aiocbp));
 DARSHAN_FORWARD_DECL(aio_write, int, (struct aiocb *aiocbp));
@@ -108,6 +153,19 @@ DARSHAN_FORWARD_DECL(aio_return64, ssize_t, (struct aiocb64 *aiocbp));
 DARSHAN_FORWARD_DECL(lio_listio, int, (int mode, struct aiocb *const aiocb_list[], int nitems, struct sigevent *sevp));
 DARSHAN_FORWARD_DECL(lio_listio64, int, (int mode, struct aiocb64 *const aiocb_list[], int nitems, struct sigevent *sevp));
 DARSHAN_FORWARD_DECL(rename, int, (const char *oldpath, const char *newpath));
+#ifdef HAVE_LIBAIO_H
+DARSHAN_FORWARD_DECL(io_submit, int, (io_context_t ctx, long nr, struct iocb *ios[]));
+DARSHAN_FORWARD_DECL(io_getevents, int, (io_context_t ctx, long min_nr, long nr, struct io_event *events, struct timespec *timeout));
+DARSHAN_FORWARD_DECL(io_cancel, int, (io_context_t ctx, struct iocb *iocb, struct io_event *evt));
+#ifndef DARSHAN_PRELOAD
+/* libaio is not part of the C library, so statically linked executables
+ * that never reference it must still be able to resolve these symbols
+ */
+#pragma weak __real_io_submit
+#pragma weak __real_io_getevents
+#pragma weak __real_io_cancel
+#endif
+#endif
 
 /* The posix_file_record_ref structure maintains necessary runtime metadata
  * for the POSIX file record (darshan_posix_file structure, defined in
@@ -146,6 +204,9 @@ struct posix_file_record_ref
     void *stride_root;
     int stride_count;
     struct posix_aio_tracker* aio_list;
+    int64_t last_access_end; /* end of the previous read/write, for POSIX_DELTA_* */
+    struct posix_access_window *reuse_window;
+    int open_flags; /* status flags of the most recent open or F_SETFL */
     int fs_type; /* same as darshan_fs_info->fs_type */
 #ifdef HAVE_LDMS
     int64_t close_counts;
@@ -160,19 +221,64 @@ struct posix_runtime
 {
     void *rec_id_hash;
     void *fd_hash;
+    void *libaio_hash;
     int file_rec_count;
     darshan_record_id heatmap_id;
+    darshan_record_id snapshot_id;
+#ifdef DARSHAN_WRAP_MMAP
+    struct posix_mmap_region *mmap_regions;
+#endif
     int frozen; /* flag to indicate that the counters should no longer be modified */
 };
 
+#ifdef DARSHAN_WRAP_MMAP
+/* file-backed mapping, used to attribute madvise() calls on the mapped
+ * memory to the file record it was mapped from
+ */
+struct posix_mmap_region
+{
+    char *addr;
+    size_t length;
+    struct posix_file_record_ref *rec_ref;
+    struct posix_mmap_region *next;
+};
+#endif
+
+/* ring of the byte ranges of the most recent reads and writes to a file,
+ * searched to find the reuse distance of each new access
+ */
+struct posix_access_window
+{
+    int64_t start[POSIX_REUSE_WINDOW];
+    int64_t end[POSIX_REUSE_WINDOW];
+    int next; /* slot for the next access */
+    int count;
+};
+
 /* struct to track information about aio operations in flight */
 struct posix_aio_tracker
 {
     double tm1;
     void *aiocbp;
+    int direct_flag;
     struct posix_aio_tracker *next;
 };
 
+/* struct to track information about Linux native aio (libaio) operations
+ * in flight. These are indexed by iocb pointer in the runtime's libaio_hash
+ * rather than attached to a file record, since io_getevents() only hands
+ * back the iocb.
+ */
+struct posix_libaio_tracker
+{
+    double tm1;
+    int fd;
+    int rw_type; /* DARSHAN_IO_READ or DARSHAN_IO_WRITE */
+    int64_t offset;
+    int aligned_flag;
+    int direct_flag;
+};
+
 static void posix_runtime_initialize(
     void);
 static struct posix_file_record_ref *posix_track_new_file_record(
@@ -181,6 +287,23 @@ static void posix_aio_tracker_add(
     int fd, void *aiocbp);
 static struct posix_aio_tracker* posix_aio_tracker_del(
     int fd, void *aiocbp);
+static void posix_record_access_pattern(
+    struct posix_file_record_ref *rec_ref, int64_t offset, int64_t len);
+static int64_t posix_bytes_to_eof(
+    int fd, int64_t offset);
+static void posix_record_stat_at(
+    int dirfd, const char *path, int flags, double tm1, double tm2);
+static void posix_record_direct_io(
+    struct posix_file_record_ref *rec_ref, ssize_t ret, int rw_type,
+    int pread_flag, int64_t offset, const struct iovec *iov, int iovcnt);
+#ifdef DARSHAN_WRAP_MMAP
+static void posix_mmap_region_add(
+    struct posix_file_record_ref *rec_ref, void *addr, size_t length);
+static void posix_mmap_region_del(
+    void *addr, size_t length);
+static struct posix_mmap_region *posix_mmap_region_find(
+    void *addr);
+#endif
 static void posix_finalize_file_records(
     void *rec_ref_p, void *user_ptr);
 #ifdef HAVE_MPI
@@ -189,6 +312,8 @@ static void posix_record_reduction_op(
 static void posix_shared_record_variance(
     MPI_Comm mod_comm, struct darshan_posix_file *inrec_array,
     struct darshan_posix_file *outrec_array, int shared_rec_count);
+static void posix_shared_record_imbalance(
+    MPI_Comm mod_comm, struct darshan_posix_file *inrec_array, int shared_rec_count);
 static void posix_mpi_redux(
     void *posix_buf, MPI_Comm mod_comm,
     darshan_record_id *shared_recs, int shared_rec_count);
@@ -206,6 +331,10 @@ static pthread_mutex_t posix_runtime_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER
 static int posix_runtime_init_attempted = 0;
 static int my_rank = -1;
 static int darshan_mem_alignment = 1;
+static int posix_access_patterns_enabled = 0;
+
+/* file status flags that fcntl(F_SETFL) can change */
+#define POSIX_SETFL_MASK (O_APPEND|O_ASYNC|O_DIRECT|O_NOATIME|O_NONBLOCK)
 
 #define POSIX_LOCK() pthread_mutex_lock(&posix_runtime_mutex)
 #define POSIX_UNLOCK() pthread_mutex_unlock(&posix_runtime_mutex)
@@ -233,7 +362,7 @@ static int darshan_mem_alignment = 1;
     POSIX_UNLOCK(); \
 } while(0)
 
-#define POSIX_RECORD_OPEN(__ret, __path, __mode, __tm1, __tm2) do { \
+#define POSIX_RECORD_OPEN(__ret, __path, __mode, __flags, __tm1, __tm2) do { \
     darshan_record_id __rec_id; \
     struct posix_file_record_ref *__rec_ref; \
     char *__newpath; \
@@ -247,7 +376,7 @@ static int darshan_mem_alignment = 1;
         if(__newpath != __path) free(__newpath); \
         break; \
     } \
-    _POSIX_RECORD_OPEN(__ret, __rec_ref, __mode, __tm1, __tm2, 1, -1); \
+    _POSIX_RECORD_OPEN(__ret, __rec_ref, __mode, __flags, __tm1, __tm2, 1, -1); \
     if(__newpath != __path) free(__newpath); \
     /* LDMS to publish realtime open tracing information to daemon*/ \
     if(dC.ldms_lib)\
@@ -257,17 +386,31 @@ static int darshan_mem_alignment = 1;
 
 #define POSIX_RECORD_REFOPEN(__ret, __rec_ref, __tm1, __tm2, __ref_counter) do { \
     if(__ret < 0 || !__rec_ref) break; \
-    _POSIX_RECORD_OPEN(__ret, __rec_ref, 0, __tm1, __tm2, 0, __ref_counter); \
+    _POSIX_RECORD_OPEN(__ret, __rec_ref, 0, -1, __tm1, __tm2, 0, __ref_counter); \
 } while(0)
 
-#define _POSIX_RECORD_OPEN(__ret, __rec_ref, __mode, __tm1, __tm2, __reset_flag, __ref_counter) do { \
+/* __flags is -1 for dup() and fileno(), which share the status flags of
+ * an existing open
+ */
+#define _POSIX_RECORD_OPEN(__ret, __rec_ref, __mode, __flags, __tm1, __tm2, __reset_flag, __ref_counter) do { \
     if(__mode) __rec_ref->file_rec->counters[POSIX_MODE] = __mode; \
+    if((__flags) != -1) { \
+        __rec_ref->open_flags = (__flags); \
+        if((__flags) & O_DIRECT) __rec_ref->file_rec->counters[POSIX_OPENS_DIRECT] += 1; \
+        if(((__flags) & O_SYNC) == O_SYNC) __rec_ref->file_rec->counters[POSIX_OPENS_SYNC] += 1; \
+        else if((__flags) & O_DSYNC) __rec_ref->file_rec->counters[POSIX_OPENS_DSYNC] += 1; \
+        if((__flags) & O_APPEND) __rec_ref->file_rec->counters[POSIX_OPENS_APPEND] += 1; \
+        if((__flags) & O_TRUNC) __rec_ref->file_rec->counters[POSIX_OPENS_TRUNC] += 1; \
+        if((__flags) & O_CREAT) __rec_ref->file_rec->counters[POSIX_OPENS_CREAT] += 1; \
+    } \
     if(__reset_flag) { \
         __rec_ref->offset = 0; \
         __rec_ref->last_byte_written = 0; \
         __rec_ref->last_byte_read = 0; \
+        __rec_ref->last_access_end = 0; \
     } \
     __rec_ref->file_rec->counters[POSIX_OPENS] += 1; \
+    snapshot_update(posix_runtime->snapshot_id, SNAPSHOT_OPENS, 1, __tm2); \
     if(__ref_counter >= 0) __rec_ref->file_rec->counters[__ref_counter] += 1; \
     if(__rec_ref->file_rec->fcounters[POSIX_F_OPEN_START_TIMESTAMP] == 0 || \
      __rec_ref->file_rec->fcounters[POSIX_F_OPEN_START_TIMESTAMP] > __tm1) \
@@ -278,16 +421,35 @@ static int darshan_mem_alignment = 1;
     darshan_add_record_ref(&(posix_runtime->fd_hash), &__ret, sizeof(int), __rec_ref); \
 } while(0)
 
-#define POSIX_RECORD_READ(__ret, __fd, __pread_flag, __pread_offset, __aligned, __tm1, __tm2) do { \
+#define POSIX_RECORD_AIO(__ret, __fd, __rw_type, __direct_flag) do { \
+    struct posix_file_record_ref* rec_ref; \
+    if(__ret < 0) break; \
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &(__fd), sizeof(int)); \
+    if(!rec_ref) break; \
+    if(__rw_type == DARSHAN_IO_WRITE) { \
+        rec_ref->file_rec->counters[POSIX_AIO_WRITES] += 1; \
+        if(__direct_flag) rec_ref->file_rec->counters[POSIX_AIO_DIRECT_WRITES] += 1; \
+    } \
+    else { \
+        rec_ref->file_rec->counters[POSIX_AIO_READS] += 1; \
+        if(__direct_flag) rec_ref->file_rec->counters[POSIX_AIO_DIRECT_READS] += 1; \
+    } \
+} while(0)
+
+#define POSIX_RECORD_READ(__ret, __fd, __pread_flag, __pread_offset, __aligned, __iov, __iovcnt, __tm1, __tm2) do { \
     struct posix_file_record_ref* rec_ref; \
     int64_t stride; \
     int64_t this_offset; \
     int64_t file_alignment; \
     struct darshan_common_val_counter *cvc; \
     double __elapsed = __tm2-__tm1; \
-    if(__ret < 0) break; \
     rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &(__fd), sizeof(int)); \
     if(!rec_ref) break; \
+    /* direct I/O is checked before the offset advances, and for failed calls */ \
+    if((__iovcnt) > 0 && (rec_ref->open_flags & O_DIRECT)) \
+        posix_record_direct_io(rec_ref, __ret, DARSHAN_IO_READ, __pread_flag, __pread_offset, \
+            __iov, __iovcnt); \
+    if(__ret < 0) break; \
     if(__pread_flag) \
         this_offset = __pread_offset; \
     else \
@@ -296,6 +458,10 @@ static int darshan_mem_alignment = 1;
     dxt_posix_read(rec_ref->file_rec->base_rec.id, this_offset, __ret, __tm1, __tm2); \
     /* heatmap to record traffic summary */ \
     heatmap_update(posix_runtime->heatmap_id, HEATMAP_READ, __ret, __tm1, __tm2); \
+    snapshot_update_rw(posix_runtime->snapshot_id, SNAPSHOT_READ, __ret, __tm2); \
+    /* periodic page cache and NFS client snapshots, if due */ \
+    procio_sample(__tm2); \
+    nfs_sample(__tm2); \
     if(this_offset > rec_ref->last_byte_read) \
         rec_ref->file_rec->counters[POSIX_SEQ_READS] += 1;  \
     if(this_offset == (rec_ref->last_byte_read + 1)) \
@@ -305,6 +471,8 @@ static int darshan_mem_alignment = 1;
         stride = this_offset - rec_ref->last_byte_read - 1; \
     else \
         stride = 0; \
+    if(posix_access_patterns_enabled) \
+        posix_record_access_pattern(rec_ref, this_offset, __ret); \
     rec_ref->last_byte_read = this_offset + __ret - 1; \
     rec_ref->offset = this_offset + __ret; \
     if(rec_ref->file_rec->counters[POSIX_MAX_BYTE_READ] < (this_offset + __ret - 1)) \
@@ -347,16 +515,20 @@ static int darshan_mem_alignment = 1;
             darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->file_rec->counters[POSIX_READS], "read", this_offset, __ret, rec_ref->file_rec->counters[POSIX_MAX_BYTE_READ],rec_ref->file_rec->counters[POSIX_RW_SWITCHES], -1,  __tm1, __tm2, rec_ref->file_rec->fcounters[POSIX_F_READ_TIME], "POSIX", "MOD");\
 } while(0)
 
-#define POSIX_RECORD_WRITE(__ret, __fd, __pwrite_flag, __pwrite_offset, __aligned, __tm1, __tm2) do { \
+#define POSIX_RECORD_WRITE(__ret, __fd, __pwrite_flag, __pwrite_offset, __aligned, __iov, __iovcnt, __tm1, __tm2) do { \
     struct posix_file_record_ref* rec_ref; \
     int64_t stride; \
     int64_t this_offset; \
     int64_t file_alignment; \
     struct darshan_common_val_counter *cvc; \
     double __elapsed = __tm2-__tm1; \
-    if(__ret < 0) break; \
     rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &__fd, sizeof(int)); \
     if(!rec_ref) break; \
+    /* direct I/O is checked before the offset advances, and for failed calls */ \
+    if((__iovcnt) > 0 && (rec_ref->open_flags & O_DIRECT)) \
+        posix_record_direct_io(rec_ref, __ret, DARSHAN_IO_WRITE, __pwrite_flag, __pwrite_offset, \
+            __iov, __iovcnt); \
+    if(__ret < 0) break; \
     if(__pwrite_flag) \
         this_offset = __pwrite_offset; \
     else \
@@ -365,6 +537,10 @@ static int darshan_mem_alignment = 1;
     dxt_posix_write(rec_ref->file_rec->base_rec.id, this_offset, __ret, __tm1, __tm2); \
     /* heatmap to record traffic summary */ \
     heatmap_update(posix_runtime->heatmap_id, HEATMAP_WRITE, __ret, __tm1, __tm2); \
+    snapshot_update_rw(posix_runtime->snapshot_id, SNAPSHOT_WRITE, __ret, __tm2); \
+    /* periodic page cache and NFS client snapshots, if due */ \
+    procio_sample(__tm2); \
+    nfs_sample(__tm2); \
     if(this_offset > rec_ref->last_byte_written) \
         rec_ref->file_rec->counters[POSIX_SEQ_WRITES] += 1; \
     if(this_offset == (rec_ref->last_byte_written + 1)) \
@@ -374,6 +550,8 @@ static int darshan_mem_alignment = 1;
         stride = this_offset - rec_ref->last_byte_written - 1; \
     else \
         stride = 0; \
+    if(posix_access_patterns_enabled) \
+        posix_record_access_pattern(rec_ref, this_offset, __ret); \
     rec_ref->last_byte_written = this_offset + __ret - 1; \
     rec_ref->offset = this_offset + __ret; \
     if(rec_ref->file_rec->counters[POSIX_MAX_BYTE_WRITTEN] < (this_offset + __ret - 1)) \
@@ -416,6 +594,20 @@ static int darshan_mem_alignment = 1;
             darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->file_rec->counters[POSIX_WRITES], "write", this_offset, __ret, rec_ref->file_rec->counters[POSIX_MAX_BYTE_WRITTEN], rec_ref->file_rec->counters[POSIX_RW_SWITCHES], -1, __tm1, __tm2, rec_ref->file_rec->fcounters[POSIX_F_WRITE_TIME], "POSIX", "MOD");\
 } while(0)
 
+/* the iovec of a single buffer I/O, for POSIX_RECORD_READ/WRITE */
+#define POSIX_IOV(__buf, __count) (&(struct iovec){(void *)(__buf), (__count)})
+
+#define POSIX_RECORD_SETFL(__fd, __flags, __tm1, __tm2) do { \
+    struct posix_file_record_ref* rec_ref; \
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &(__fd), sizeof(int)); \
+    if(!rec_ref) break; \
+    rec_ref->file_rec->counters[POSIX_SETFLS] += 1; \
+    rec_ref->open_flags = (rec_ref->open_flags & ~POSIX_SETFL_MASK) | \
+        ((__flags) & POSIX_SETFL_MASK); \
+    DARSHAN_TIMER_INC_NO_OVERLAP(rec_ref->file_rec->fcounters[POSIX_F_META_TIME], \
+        __tm1, __tm2, rec_ref->last_meta_end); \
+} while(0)
+
 #define POSIX_LOOKUP_RECORD_STAT(__path, __statbuf, __tm1, __tm2) do { \
     darshan_record_id rec_id; \
     struct posix_file_record_ref* rec_ref; \
@@ -432,10 +624,66 @@ static int darshan_mem_alignment = 1;
 
 #define POSIX_RECORD_STAT(__rec_ref, __statbuf, __tm1, __tm2) do { \
     (__rec_ref)->file_rec->counters[POSIX_STATS] += 1; \
+    snapshot_update(posix_runtime->snapshot_id, SNAPSHOT_STATS, 1, __tm2); \
+    DARSHAN_TIMER_INC_NO_OVERLAP((__rec_ref)->file_rec->fcounters[POSIX_F_META_TIME], \
+        __tm1, __tm2, (__rec_ref)->last_meta_end); \
+} while(0)
+
+/* record a page cache hint or space management call covering __len bytes
+ * from __offset (a length of 0 covers the rest of the file); its time is
+ * kept in __timer and also counted as metadata time
+ */
+#define POSIX_RECORD_RANGE_CALL(__rec_ref, __fd, __offset, __len, __counter, __bytes_counter, __timer, __tm1, __tm2) do { \
+    int64_t __bytes = (__len); \
+    if(__bytes == 0) __bytes = posix_bytes_to_eof(__fd, __offset); \
+    (__rec_ref)->file_rec->counters[__counter] += 1; \
+    (__rec_ref)->file_rec->counters[__bytes_counter] += __bytes; \
+    (__rec_ref)->file_rec->fcounters[__timer] += (__tm2) - (__tm1); \
+    DARSHAN_TIMER_INC_NO_OVERLAP((__rec_ref)->file_rec->fcounters[POSIX_F_META_TIME], \
+        __tm1, __tm2, (__rec_ref)->last_meta_end); \
+} while(0)
+
+#define POSIX_RECORD_FADVISE(__fd, __offset, __len, __advice, __tm1, __tm2) do { \
+    struct posix_file_record_ref* rec_ref; \
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &(__fd), sizeof(int)); \
+    if(!rec_ref) break; \
+    POSIX_RECORD_RANGE_CALL(rec_ref, __fd, __offset, __len, POSIX_FADVISES, \
+        POSIX_FADVISE_BYTES, POSIX_F_FADVISE_TIME, __tm1, __tm2); \
+    if((__advice) == POSIX_FADV_DONTNEED) \
+        rec_ref->file_rec->counters[POSIX_FADVISE_DONTNEEDS] += 1; \
+} while(0)
+
+#define POSIX_RECORD_FALLOCATE(__fd, __offset, __len, __tm1, __tm2) do { \
+    struct posix_file_record_ref* rec_ref; \
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &(__fd), sizeof(int)); \
+    if(!rec_ref) break; \
+    POSIX_RECORD_RANGE_CALL(rec_ref, __fd, __offset, __len, POSIX_FALLOCATES, \
+        POSIX_FALLOCATE_BYTES, POSIX_F_FALLOCATE_TIME, __tm1, __tm2); \
+} while(0)
+
+#define POSIX_RECORD_TRUNCATE(__rec_ref, __length, __tm1, __tm2) do { \
+    (__rec_ref)->file_rec->counters[POSIX_TRUNCATES] += 1; \
+    if((__length) == 0) \
+        (__rec_ref)->file_rec->counters[POSIX_TRUNCATES_TO_ZERO] += 1; \
+    (__rec_ref)->file_rec->fcounters[POSIX_F_TRUNCATE_TIME] += (__tm2) - (__tm1); \
     DARSHAN_TIMER_INC_NO_OVERLAP((__rec_ref)->file_rec->fcounters[POSIX_F_META_TIME], \
         __tm1, __tm2, (__rec_ref)->last_meta_end); \
 } while(0)
 
+#define POSIX_LOOKUP_RECORD_TRUNCATE(__path, __length, __tm1, __tm2) do { \
+    darshan_record_id rec_id; \
+    struct posix_file_record_ref* rec_ref; \
+    char *newpath = darshan_clean_file_path(__path); \
+    if(!newpath) newpath = (char *)__path; \
+    rec_id = darshan_core_gen_record_id(newpath); \
+    rec_ref = darshan_lookup_record_ref(posix_runtime->rec_id_hash, &rec_id, sizeof(darshan_record_id)); \
+    if(!rec_ref) rec_ref = posix_track_new_file_record(rec_id, newpath); \
+    if(newpath != __path) free(newpath); \
+    if(rec_ref) { \
+        POSIX_RECORD_TRUNCATE(rec_ref, __length, __tm1, __tm2); \
+    } \
+} while(0)
+
 
 /**********************************************************
  *      Wrappers for POSIX I/O functions of interest      *
@@ -468,7 +716,7 @@ int DARSHAN_DECL(open)(const char *path, int flags, ...)
     }
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, path, mode, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, path, mode, flags, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -486,7 +734,7 @@ int DARSHAN_DECL(__open_2)(const char *path, int oflag)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, path, 0, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, path, 0, oflag, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -519,7 +767,7 @@ int DARSHAN_DECL(open64)(const char *path, int flags, ...)
     }
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, path, mode, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, path, mode, flags, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -561,7 +809,7 @@ int DARSHAN_DECL(openat)(int dirfd, const char *pathname, int flags, ...)
          *    - absolute path
          *    - dirfd equal to CWD
          */
-        POSIX_RECORD_OPEN(ret, pathname, mode, tm1, tm2);
+        POSIX_RECORD_OPEN(ret, pathname, mode, flags, tm1, tm2);
     }
     else
     {
@@ -589,12 +837,12 @@ int DARSHAN_DECL(openat)(int dirfd, const char *pathname, int flags, ...)
         if(dirpath)
         {
             /* we were able to construct an absolute path */
-            POSIX_RECORD_OPEN(ret, tmp_path, mode, tm1, tm2);
+            POSIX_RECORD_OPEN(ret, tmp_path, mode, flags, tm1, tm2);
         }
         else
         {
             /* fallback to relative path if Darshan doesn't know dirfd path */
-            POSIX_RECORD_OPEN(ret, pathname, mode, tm1, tm2);
+            POSIX_RECORD_OPEN(ret, pathname, mode, flags, tm1, tm2);
         }
     }
     POSIX_POST_RECORD();
@@ -638,7 +886,7 @@ int DARSHAN_DECL(openat64)(int dirfd, const char *pathname, int flags, ...)
          *    - absolute path
          *    - dirfd equal to CWD
          */
-        POSIX_RECORD_OPEN(ret, pathname, mode, tm1, tm2);
+        POSIX_RECORD_OPEN(ret, pathname, mode, flags, tm1, tm2);
     }
     else
     {
@@ -666,12 +914,12 @@ int DARSHAN_DECL(openat64)(int dirfd, const char *pathname, int flags, ...)
         if(dirpath)
         {
             /* we were able to construct an absolute path */
-            POSIX_RECORD_OPEN(ret, tmp_path, mode, tm1, tm2);
+            POSIX_RECORD_OPEN(ret, tmp_path, mode, flags, tm1, tm2);
         }
         else
         {
             /* fallback to relative path if Darshan doesn't know dirfd path */
-            POSIX_RECORD_OPEN(ret, pathname, mode, tm1, tm2);
+            POSIX_RECORD_OPEN(ret, pathname, mode, flags, tm1, tm2);
         }
     }
     POSIX_POST_RECORD();
@@ -691,7 +939,7 @@ int DARSHAN_DECL(creat)(const char* path, mode_t mode)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, path, mode, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, path, mode, O_CREAT|O_WRONLY|O_TRUNC, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -709,7 +957,7 @@ int DARSHAN_DECL(creat64)(const char* path, mode_t mode)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, path, mode, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, path, mode, O_CREAT|O_WRONLY|O_TRUNC, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -832,7 +1080,7 @@ int DARSHAN_DECL(mkstemp)(char* template)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, template, 0, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, template, 0, O_RDWR|O_CREAT|O_EXCL, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -850,7 +1098,7 @@ int DARSHAN_DECL(mkostemp)(char* template, int flags)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, template, 0, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, template, 0, flags|O_RDWR|O_CREAT|O_EXCL, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -868,7 +1116,7 @@ int DARSHAN_DECL(mkstemps)(char* template, int suffixlen)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, template, 0, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, template, 0, O_RDWR|O_CREAT|O_EXCL, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -886,7 +1134,7 @@ int DARSHAN_DECL(mkostemps)(char* template, int suffixlen, int flags)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_OPEN(ret, template, 0, tm1, tm2);
+    POSIX_RECORD_OPEN(ret, template, 0, flags|O_RDWR|O_CREAT|O_EXCL, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -907,7 +1155,8 @@ ssize_t DARSHAN_DECL(read)(int fd, void *buf, size_t count)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 0, 0, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 0, 0, aligned_flag,
+        POSIX_IOV(buf, count), 1, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -928,7 +1177,8 @@ ssize_t DARSHAN_DECL(write)(int fd, const void *buf, size_t count)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 0, 0, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 0, 0, aligned_flag,
+        POSIX_IOV(buf, count), 1, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -949,7 +1199,8 @@ ssize_t DARSHAN_DECL(pread)(int fd, void *buf, size_t count, off_t offset)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag,
+        POSIX_IOV(buf, count), 1, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -970,7 +1221,8 @@ ssize_t DARSHAN_DECL(pwrite)(int fd, const void *buf, size_t count, off_t offset
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag,
+        POSIX_IOV(buf, count), 1, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -991,7 +1243,8 @@ ssize_t DARSHAN_DECL(pread64)(int fd, void *buf, size_t count, off64_t offset)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag,
+        POSIX_IOV(buf, count), 1, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1012,7 +1265,8 @@ ssize_t DARSHAN_DECL(pwrite64)(int fd, const void *buf, size_t count, off64_t of
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag,
+        POSIX_IOV(buf, count), 1, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1038,7 +1292,8 @@ ssize_t DARSHAN_DECL(readv)(int fd, const struct iovec *iov, int iovcnt)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 0, 0, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 0, 0, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1065,7 +1320,8 @@ ssize_t DARSHAN_DECL(preadv)(int fd, const struct iovec *iov, int iovcnt, off_t
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1091,7 +1347,8 @@ ssize_t DARSHAN_DECL(preadv64)(int fd, const struct iovec *iov, int iovcnt, off6
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1120,7 +1377,8 @@ ssize_t DARSHAN_DECL(preadv2)(int fd, const struct iovec *iov, int iovcnt, off_t
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1146,7 +1404,8 @@ ssize_t DARSHAN_DECL(preadv64v2)(int fd, const struct iovec *iov, int iovcnt, of
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_READ(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1173,7 +1432,8 @@ ssize_t DARSHAN_DECL(writev)(int fd, const struct iovec *iov, int iovcnt)
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 0, 0, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 0, 0, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1200,7 +1460,8 @@ ssize_t DARSHAN_DECL(pwritev)(int fd, const struct iovec *iov, int iovcnt, off_t
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1226,7 +1487,8 @@ ssize_t DARSHAN_DECL(pwritev64)(int fd, const struct iovec *iov, int iovcnt, off
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1254,7 +1516,8 @@ ssize_t DARSHAN_DECL(pwritev2)(int fd, const struct iovec *iov, int iovcnt, off_
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1280,7 +1543,8 @@ ssize_t DARSHAN_DECL(pwritev64v2)(int fd, const struct iovec *iov, int iovcnt, o
     tm2 = POSIX_WTIME();
 
     POSIX_PRE_RECORD();
-    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag, tm1, tm2);
+    POSIX_RECORD_WRITE(ret, fd, 1, offset, aligned_flag,
+        iov, iovcnt, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
@@ -1311,6 +1575,7 @@ off_t DARSHAN_DECL(lseek)(int fd, off_t offset, int whence)
                 rec_ref->file_rec->fcounters[POSIX_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[POSIX_SEEKS] += 1;
+            snapshot_update(posix_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         POSIX_POST_RECORD();
     }
@@ -1341,6 +1606,7 @@ off64_t DARSHAN_DECL(lseek64)(int fd, off64_t offset, int whence)
                 rec_ref->file_rec->fcounters[POSIX_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[POSIX_SEEKS] += 1;
+            snapshot_update(posix_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         POSIX_POST_RECORD();
     }
@@ -1484,228 +1750,884 @@ int DARSHAN_DECL(__fxstat64)(int vers, int fd, struct stat64 *buf)
     return(ret);
 }
 
-#ifdef DARSHAN_WRAP_MMAP
-void* DARSHAN_DECL(mmap)(void *addr, size_t length, int prot, int flags,
-    int fd, off_t offset)
+int DARSHAN_DECL(__fxstatat)(int vers, int dirfd, const char *path, struct stat *buf,
+    int flags)
 {
-    void* ret;
-    struct posix_file_record_ref *rec_ref;
+    int ret;
+    double tm1, tm2;
 
-    MAP_OR_FAIL(mmap);
-    (void)__darshan_disabled;
+    MAP_OR_FAIL(__fxstatat);
 
-    if(fd < 0 || (flags & MAP_ANONYMOUS))
-    {
-        /* mmap is not associated with a backing file; skip all Darshan
-         * characterization attempts.
-         */
-        return(__real_mmap(addr, length, prot, flags, fd, offset));
-    }
+    tm1 = POSIX_WTIME();
+    ret = __real___fxstatat(vers, dirfd, path, buf, flags);
+    tm2 = POSIX_WTIME();
 
-    ret = __real_mmap(addr, length, prot, flags, fd, offset);
-    if(ret == MAP_FAILED)
+    if(ret < 0 || !S_ISREG(buf->st_mode))
         return(ret);
 
     POSIX_PRE_RECORD();
-    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
-    if(rec_ref)
-    {
-        rec_ref->file_rec->counters[POSIX_MMAPS] += 1;
-    }
+    posix_record_stat_at(dirfd, path, flags, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
 }
-#endif /* DARSHAN_WRAP_MMAP */
 
-#ifdef DARSHAN_WRAP_MMAP
-void* DARSHAN_DECL(mmap64)(void *addr, size_t length, int prot, int flags,
-    int fd, off64_t offset)
+int DARSHAN_DECL(__fxstatat64)(int vers, int dirfd, const char *path,
+    struct stat64 *buf, int flags)
 {
-    void* ret;
-    struct posix_file_record_ref *rec_ref;
+    int ret;
+    double tm1, tm2;
 
-    MAP_OR_FAIL(mmap64);
+    MAP_OR_FAIL(__fxstatat64);
 
-    if(fd < 0 || (flags & MAP_ANONYMOUS))
-    {
-        /* mmap is not associated with a backing file; skip all Darshan
-         * characterization attempts.
-         */
-        return(__real_mmap64(addr, length, prot, flags, fd, offset));
-    }
+    tm1 = POSIX_WTIME();
+    ret = __real___fxstatat64(vers, dirfd, path, buf, flags);
+    tm2 = POSIX_WTIME();
 
-    ret = __real_mmap64(addr, length, prot, flags, fd, offset);
-    if(ret == MAP_FAILED)
+    if(ret < 0 || !S_ISREG(buf->st_mode))
         return(ret);
 
     POSIX_PRE_RECORD();
-    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
-    if(rec_ref)
-    {
-        rec_ref->file_rec->counters[POSIX_MMAPS] += 1;
-    }
+    posix_record_stat_at(dirfd, path, flags, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
 }
-#endif /* DARSHAN_WRAP_MMAP */
 
-int DARSHAN_DECL(fsync)(int fd)
+#ifdef HAVE_STAT_SYMBOLS
+int DARSHAN_DECL(stat)(const char *path, struct stat *buf)
 {
     int ret;
-    struct posix_file_record_ref *rec_ref;
     double tm1, tm2;
 
-    MAP_OR_FAIL(fsync);
+    MAP_OR_FAIL(stat);
 
     tm1 = POSIX_WTIME();
-    ret = __real_fsync(fd);
+    ret = __real_stat(path, buf);
     tm2 = POSIX_WTIME();
 
-    if(ret < 0)
+    if(ret < 0 || !S_ISREG(buf->st_mode))
         return(ret);
 
     POSIX_PRE_RECORD();
-    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
-    if(rec_ref)
-    {
-        DARSHAN_TIMER_INC_NO_OVERLAP(
-            rec_ref->file_rec->fcounters[POSIX_F_WRITE_TIME],
-            tm1, tm2, rec_ref->last_write_end);
-        rec_ref->file_rec->counters[POSIX_FSYNCS] += 1;
-    }
+    POSIX_LOOKUP_RECORD_STAT(path, buf, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
 }
 
-int DARSHAN_DECL(fdatasync)(int fd)
+int DARSHAN_DECL(stat64)(const char *path, struct stat64 *buf)
 {
     int ret;
-    struct posix_file_record_ref *rec_ref;
     double tm1, tm2;
 
-    MAP_OR_FAIL(fdatasync);
+    MAP_OR_FAIL(stat64);
 
     tm1 = POSIX_WTIME();
-    ret = __real_fdatasync(fd);
+    ret = __real_stat64(path, buf);
     tm2 = POSIX_WTIME();
 
-    if(ret < 0)
+    if(ret < 0 || !S_ISREG(buf->st_mode))
         return(ret);
 
     POSIX_PRE_RECORD();
-    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
-    if(rec_ref)
-    {
-        DARSHAN_TIMER_INC_NO_OVERLAP(
-            rec_ref->file_rec->fcounters[POSIX_F_WRITE_TIME],
-            tm1, tm2, rec_ref->last_write_end);
-        rec_ref->file_rec->counters[POSIX_FDSYNCS] += 1;
-    }
+    POSIX_LOOKUP_RECORD_STAT(path, buf, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
 }
 
-int DARSHAN_DECL(close)(int fd)
+int DARSHAN_DECL(lstat)(const char *path, struct stat *buf)
 {
     int ret;
-    struct posix_file_record_ref *rec_ref;
     double tm1, tm2;
 
-    MAP_OR_FAIL(close);
-
-    if(!__darshan_disabled)
-    {
-        POSIX_LOCK();
-        if(posix_runtime && !posix_runtime->frozen)
-        {
-            rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash,
-                &fd, sizeof(int));
-            if(rec_ref)
-            {
-                darshan_instrument_fs_data(rec_ref->fs_type,
-                    rec_ref->file_rec->base_rec.id, fd);
-            }
-        }
-        POSIX_UNLOCK();
-    }
+    MAP_OR_FAIL(lstat);
 
     tm1 = POSIX_WTIME();
-    ret = __real_close(fd);
+    ret = __real_lstat(path, buf);
     tm2 = POSIX_WTIME();
 
-    POSIX_PRE_RECORD();
-    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
-    if(rec_ref)
-    {
-        rec_ref->last_byte_written = 0;
-        rec_ref->last_byte_read = 0;
-        if(rec_ref->file_rec->fcounters[POSIX_F_CLOSE_START_TIMESTAMP] == 0 ||
-         rec_ref->file_rec->fcounters[POSIX_F_CLOSE_START_TIMESTAMP] > tm1)
-           rec_ref->file_rec->fcounters[POSIX_F_CLOSE_START_TIMESTAMP] = tm1;
-        rec_ref->file_rec->fcounters[POSIX_F_CLOSE_END_TIMESTAMP] = tm2;
-        DARSHAN_TIMER_INC_NO_OVERLAP(
-            rec_ref->file_rec->fcounters[POSIX_F_META_TIME],
-            tm1, tm2, rec_ref->last_meta_end);
-        darshan_delete_record_ref(&(posix_runtime->fd_hash), &fd, sizeof(int));
+    if(ret < 0 || !S_ISREG(buf->st_mode))
+        return(ret);
 
-#ifdef HAVE_LDMS
-        rec_ref->close_counts++;
-        /* publish close information for posix */
-        if(dC.ldms_lib)
-            if(dC.posix_enable_ldms)
-                darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->close_counts, "close", -1, -1, -1, -1, -1, tm1, tm2, rec_ref->file_rec->fcounters[POSIX_F_META_TIME], "POSIX", "MOD");
-#endif
-    }
+    POSIX_PRE_RECORD();
+    POSIX_LOOKUP_RECORD_STAT(path, buf, tm1, tm2);
     POSIX_POST_RECORD();
 
     return(ret);
 }
 
-int DARSHAN_DECL(aio_read)(struct aiocb *aiocbp)
+int DARSHAN_DECL(lstat64)(const char *path, struct stat64 *buf)
 {
     int ret;
+    double tm1, tm2;
 
-    MAP_OR_FAIL(aio_read);
+    MAP_OR_FAIL(lstat64);
 
-    ret = __real_aio_read(aiocbp);
-    if(ret == 0)
-    {
-        POSIX_PRE_RECORD();
-        posix_aio_tracker_add(aiocbp->aio_fildes, aiocbp);
-        POSIX_POST_RECORD();
-    }
+    tm1 = POSIX_WTIME();
+    ret = __real_lstat64(path, buf);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0 || !S_ISREG(buf->st_mode))
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_LOOKUP_RECORD_STAT(path, buf, tm1, tm2);
+    POSIX_POST_RECORD();
 
     return(ret);
 }
 
-int DARSHAN_DECL(aio_write)(struct aiocb *aiocbp)
+int DARSHAN_DECL(fstat)(int fd, struct stat *buf)
 {
     int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
 
-    MAP_OR_FAIL(aio_write);
+    MAP_OR_FAIL(fstat);
 
-    ret = __real_aio_write(aiocbp);
-    if(ret == 0)
+    tm1 = POSIX_WTIME();
+    ret = __real_fstat(fd, buf);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0 || !S_ISREG(buf->st_mode))
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
     {
-        POSIX_PRE_RECORD();
-        posix_aio_tracker_add(aiocbp->aio_fildes, aiocbp);
-        POSIX_POST_RECORD();
+        POSIX_RECORD_STAT(rec_ref, buf, tm1, tm2);
     }
+    POSIX_POST_RECORD();
 
     return(ret);
 }
 
-int DARSHAN_DECL(aio_read64)(struct aiocb64 *aiocbp)
+int DARSHAN_DECL(fstat64)(int fd, struct stat64 *buf)
 {
     int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
 
-    MAP_OR_FAIL(aio_read64);
+    MAP_OR_FAIL(fstat64);
 
-    ret = __real_aio_read64(aiocbp);
+    tm1 = POSIX_WTIME();
+    ret = __real_fstat64(fd, buf);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0 || !S_ISREG(buf->st_mode))
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        POSIX_RECORD_STAT(rec_ref, buf, tm1, tm2);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(fstatat)(int dirfd, const char *path, struct stat *buf, int flags)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fstatat);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fstatat(dirfd, path, buf, flags);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0 || !S_ISREG(buf->st_mode))
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    posix_record_stat_at(dirfd, path, flags, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(fstatat64)(int dirfd, const char *path, struct stat64 *buf,
+    int flags)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fstatat64);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fstatat64(dirfd, path, buf, flags);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0 || !S_ISREG(buf->st_mode))
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    posix_record_stat_at(dirfd, path, flags, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+#endif /* HAVE_STAT_SYMBOLS */
+
+#ifdef HAVE_STATX
+int DARSHAN_DECL(statx)(int dirfd, const char *path, int flags,
+    unsigned int mask, struct statx *buf)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(statx);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_statx(dirfd, path, flags, mask, buf);
+    tm2 = POSIX_WTIME();
+
+    /* the file type is always returned, whatever the mask */
+    if(ret < 0 || !S_ISREG(buf->stx_mode))
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    posix_record_stat_at(dirfd, path, flags, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+#endif /* HAVE_STATX */
+
+#ifdef DARSHAN_WRAP_MMAP
+void* DARSHAN_DECL(mmap)(void *addr, size_t length, int prot, int flags,
+    int fd, off_t offset)
+{
+    void* ret;
+    struct posix_file_record_ref *rec_ref;
+
+    MAP_OR_FAIL(mmap);
+    (void)__darshan_disabled;
+
+    if(fd < 0 || (flags & MAP_ANONYMOUS))
+    {
+        /* mmap is not associated with a backing file; skip all Darshan
+         * characterization attempts.
+         */
+        return(__real_mmap(addr, length, prot, flags, fd, offset));
+    }
+
+    ret = __real_mmap(addr, length, prot, flags, fd, offset);
+    if(ret == MAP_FAILED)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        rec_ref->file_rec->counters[POSIX_MMAPS] += 1;
+        posix_mmap_region_add(rec_ref, ret, length);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+#endif /* DARSHAN_WRAP_MMAP */
+
+#ifdef DARSHAN_WRAP_MMAP
+void* DARSHAN_DECL(mmap64)(void *addr, size_t length, int prot, int flags,
+    int fd, off64_t offset)
+{
+    void* ret;
+    struct posix_file_record_ref *rec_ref;
+
+    MAP_OR_FAIL(mmap64);
+
+    if(fd < 0 || (flags & MAP_ANONYMOUS))
+    {
+        /* mmap is not associated with a backing file; skip all Darshan
+         * characterization attempts.
+         */
+        return(__real_mmap64(addr, length, prot, flags, fd, offset));
+    }
+
+    ret = __real_mmap64(addr, length, prot, flags, fd, offset);
+    if(ret == MAP_FAILED)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        rec_ref->file_rec->counters[POSIX_MMAPS] += 1;
+        posix_mmap_region_add(rec_ref, ret, length);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+#endif /* DARSHAN_WRAP_MMAP */
+
+int DARSHAN_DECL(fcntl)(int fd, int cmd, ...)
+{
+    int ret;
+    void *arg;
+    va_list ap;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fcntl);
+
+    /* every command takes at most one argument, an int or a pointer */
+    va_start(ap, cmd);
+    arg = va_arg(ap, void *);
+    va_end(ap);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fcntl(fd, cmd, arg);
+    tm2 = POSIX_WTIME();
+
+    /* only changes to the file status flags are recorded */
+    if(ret < 0 || cmd != F_SETFL)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_SETFL(fd, (int)(intptr_t)arg, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+#ifdef HAVE_FCNTL64
+int DARSHAN_DECL(fcntl64)(int fd, int cmd, ...)
+{
+    int ret;
+    void *arg;
+    va_list ap;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fcntl64);
+
+    va_start(ap, cmd);
+    arg = va_arg(ap, void *);
+    va_end(ap);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fcntl64(fd, cmd, arg);
+    tm2 = POSIX_WTIME();
+
+    /* only changes to the file status flags are recorded */
+    if(ret < 0 || cmd != F_SETFL)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_SETFL(fd, (int)(intptr_t)arg, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+#endif
+
+int DARSHAN_DECL(fsync)(int fd)
+{
+    int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fsync);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fsync(fd);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        DARSHAN_TIMER_INC_NO_OVERLAP(
+            rec_ref->file_rec->fcounters[POSIX_F_WRITE_TIME],
+            tm1, tm2, rec_ref->last_write_end);
+        rec_ref->file_rec->counters[POSIX_FSYNCS] += 1;
+        snapshot_update(posix_runtime->snapshot_id, SNAPSHOT_FSYNCS, 1, tm2);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(fdatasync)(int fd)
+{
+    int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fdatasync);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fdatasync(fd);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        DARSHAN_TIMER_INC_NO_OVERLAP(
+            rec_ref->file_rec->fcounters[POSIX_F_WRITE_TIME],
+            tm1, tm2, rec_ref->last_write_end);
+        rec_ref->file_rec->counters[POSIX_FDSYNCS] += 1;
+        snapshot_update(posix_runtime->snapshot_id, SNAPSHOT_FSYNCS, 1, tm2);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(posix_fadvise)(int fd, off_t offset, off_t len, int advice)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(posix_fadvise);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_posix_fadvise(fd, offset, len, advice);
+    tm2 = POSIX_WTIME();
+
+    /* returns an error number rather than setting errno */
+    if(ret != 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_FADVISE(fd, offset, len, advice, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(posix_fadvise64)(int fd, off64_t offset, off64_t len, int advice)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(posix_fadvise64);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_posix_fadvise64(fd, offset, len, advice);
+    tm2 = POSIX_WTIME();
+
+    if(ret != 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_FADVISE(fd, offset, len, advice, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+ssize_t DARSHAN_DECL(readahead)(int fd, off64_t offset, size_t count)
+{
+    ssize_t ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(readahead);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_readahead(fd, offset, count);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        POSIX_RECORD_RANGE_CALL(rec_ref, fd, offset, count, POSIX_READAHEADS,
+            POSIX_READAHEAD_BYTES, POSIX_F_READAHEAD_TIME, tm1, tm2);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(fallocate)(int fd, int mode, off_t offset, off_t len)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fallocate);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fallocate(fd, mode, offset, len);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_FALLOCATE(fd, offset, len, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(fallocate64)(int fd, int mode, off64_t offset, off64_t len)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(fallocate64);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_fallocate64(fd, mode, offset, len);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_FALLOCATE(fd, offset, len, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(posix_fallocate)(int fd, off_t offset, off_t len)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(posix_fallocate);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_posix_fallocate(fd, offset, len);
+    tm2 = POSIX_WTIME();
+
+    /* returns an error number rather than setting errno */
+    if(ret != 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_FALLOCATE(fd, offset, len, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(posix_fallocate64)(int fd, off64_t offset, off64_t len)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(posix_fallocate64);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_posix_fallocate64(fd, offset, len);
+    tm2 = POSIX_WTIME();
+
+    if(ret != 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_RECORD_FALLOCATE(fd, offset, len, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(ftruncate)(int fd, off_t length)
+{
+    int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(ftruncate);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_ftruncate(fd, length);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        POSIX_RECORD_TRUNCATE(rec_ref, length, tm1, tm2);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(ftruncate64)(int fd, off64_t length)
+{
+    int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(ftruncate64);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_ftruncate64(fd, length);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        POSIX_RECORD_TRUNCATE(rec_ref, length, tm1, tm2);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(truncate)(const char *path, off_t length)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(truncate);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_truncate(path, length);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_LOOKUP_RECORD_TRUNCATE(path, length, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(truncate64)(const char *path, off64_t length)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(truncate64);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_truncate64(path, length);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    POSIX_LOOKUP_RECORD_TRUNCATE(path, length, tm1, tm2);
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(sync_file_range)(int fd, off64_t offset, off64_t nbytes,
+    unsigned int flags)
+{
+    int ret;
+    struct posix_file_record_ref *rec_ref;
+    int64_t bytes = nbytes;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(sync_file_range);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_sync_file_range(fd, offset, nbytes, flags);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        /* flushing is counted as write time, as for fsync/fdatasync */
+        if(bytes == 0)
+            bytes = posix_bytes_to_eof(fd, offset);
+        rec_ref->file_rec->counters[POSIX_SYNC_FILE_RANGES] += 1;
+        rec_ref->file_rec->counters[POSIX_SYNC_FILE_RANGE_BYTES] += bytes;
+        rec_ref->file_rec->fcounters[POSIX_F_SYNC_FILE_RANGE_TIME] += tm2 - tm1;
+        DARSHAN_TIMER_INC_NO_OVERLAP(
+            rec_ref->file_rec->fcounters[POSIX_F_WRITE_TIME],
+            tm1, tm2, rec_ref->last_write_end);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+#ifdef DARSHAN_WRAP_MMAP
+int DARSHAN_DECL(madvise)(void *addr, size_t length, int advice)
+{
+    int ret;
+    struct posix_mmap_region *region;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(madvise);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_madvise(addr, length, advice);
+    tm2 = POSIX_WTIME();
+
+    if(ret < 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    region = posix_mmap_region_find(addr);
+    if(region)
+    {
+        region->rec_ref->file_rec->counters[POSIX_MADVISES] += 1;
+        region->rec_ref->file_rec->counters[POSIX_MADVISE_BYTES] += length;
+        region->rec_ref->file_rec->fcounters[POSIX_F_MADVISE_TIME] += tm2 - tm1;
+        DARSHAN_TIMER_INC_NO_OVERLAP(
+            region->rec_ref->file_rec->fcounters[POSIX_F_META_TIME],
+            tm1, tm2, region->rec_ref->last_meta_end);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(munmap)(void *addr, size_t length)
+{
+    int ret;
+
+    MAP_OR_FAIL(munmap);
+
+    ret = __real_munmap(addr, length);
+    if(ret < 0)
+        return(ret);
+
+    /* not recorded; only keeps madvise() from being attributed to a file
+     * that is no longer mapped there
+     */
+    if(!__darshan_disabled)
+    {
+        POSIX_LOCK();
+        if(posix_runtime)
+            posix_mmap_region_del(addr, length);
+        POSIX_UNLOCK();
+    }
+
+    return(ret);
+}
+#endif /* DARSHAN_WRAP_MMAP */
+
+int DARSHAN_DECL(close)(int fd)
+{
+    int ret;
+    struct posix_file_record_ref *rec_ref;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(close);
+
+    if(!__darshan_disabled)
+    {
+        POSIX_LOCK();
+        if(posix_runtime && !posix_runtime->frozen)
+        {
+            rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash,
+                &fd, sizeof(int));
+            if(rec_ref)
+            {
+                darshan_instrument_fs_data(rec_ref->fs_type,
+                    rec_ref->file_rec->base_rec.id, fd);
+            }
+        }
+        POSIX_UNLOCK();
+    }
+
+    tm1 = POSIX_WTIME();
+    ret = __real_close(fd);
+    tm2 = POSIX_WTIME();
+
+    POSIX_PRE_RECORD();
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash, &fd, sizeof(int));
+    if(rec_ref)
+    {
+        rec_ref->last_byte_written = 0;
+        rec_ref->last_byte_read = 0;
+        if(rec_ref->file_rec->fcounters[POSIX_F_CLOSE_START_TIMESTAMP] == 0 ||
+         rec_ref->file_rec->fcounters[POSIX_F_CLOSE_START_TIMESTAMP] > tm1)
+           rec_ref->file_rec->fcounters[POSIX_F_CLOSE_START_TIMESTAMP] = tm1;
+        rec_ref->file_rec->fcounters[POSIX_F_CLOSE_END_TIMESTAMP] = tm2;
+        DARSHAN_TIMER_INC_NO_OVERLAP(
+            rec_ref->file_rec->fcounters[POSIX_F_META_TIME],
+            tm1, tm2, rec_ref->last_meta_end);
+        darshan_delete_record_ref(&(posix_runtime->fd_hash), &fd, sizeof(int));
+
+#ifdef HAVE_LDMS
+        rec_ref->close_counts++;
+        /* publish close information for posix */
+        if(dC.ldms_lib)
+            if(dC.posix_enable_ldms)
+                darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->close_counts, "close", -1, -1, -1, -1, -1, tm1, tm2, rec_ref->file_rec->fcounters[POSIX_F_META_TIME], "POSIX", "MOD");
+#endif
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(aio_read)(struct aiocb *aiocbp)
+{
+    int ret;
+
+    MAP_OR_FAIL(aio_read);
+
+    ret = __real_aio_read(aiocbp);
+    if(ret == 0)
+    {
+        POSIX_PRE_RECORD();
+        posix_aio_tracker_add(aiocbp->aio_fildes, aiocbp);
+        POSIX_POST_RECORD();
+    }
+
+    return(ret);
+}
+
+int DARSHAN_DECL(aio_write)(struct aiocb *aiocbp)
+{
+    int ret;
+
+    MAP_OR_FAIL(aio_write);
+
+    ret = __real_aio_write(aiocbp);
+    if(ret == 0)
+    {
+        POSIX_PRE_RECORD();
+        posix_aio_tracker_add(aiocbp->aio_fildes, aiocbp);
+        POSIX_POST_RECORD();
+    }
+
+    return(ret);
+}
+
+int DARSHAN_DECL(aio_read64)(struct aiocb64 *aiocbp)
+{
+    int ret;
+
+    MAP_OR_FAIL(aio_read64);
+
+    ret = __real_aio_read64(aiocbp);
     if(ret == 0)
     {
         POSIX_PRE_RECORD();
@@ -1754,14 +2676,18 @@ ssize_t DARSHAN_DECL(aio_return)(struct aiocb *aiocbp)
         if(aiocbp->aio_lio_opcode == LIO_WRITE)
         {
             POSIX_RECORD_WRITE(ret, aiocbp->aio_fildes,
-                1, aiocbp->aio_offset, aligned_flag,
+                1, aiocbp->aio_offset, aligned_flag, NULL, 0,
                 tmp->tm1, tm2);
+            POSIX_RECORD_AIO(ret, aiocbp->aio_fildes, DARSHAN_IO_WRITE,
+                tmp->direct_flag);
         }
         else if(aiocbp->aio_lio_opcode == LIO_READ)
         {
             POSIX_RECORD_READ(ret, aiocbp->aio_fildes,
-                1, aiocbp->aio_offset, aligned_flag,
+                1, aiocbp->aio_offset, aligned_flag, NULL, 0,
                 tmp->tm1, tm2);
+            POSIX_RECORD_AIO(ret, aiocbp->aio_fildes, DARSHAN_IO_READ,
+                tmp->direct_flag);
         }
         free(tmp);
     }
@@ -1791,14 +2717,18 @@ ssize_t DARSHAN_DECL(aio_return64)(struct aiocb64 *aiocbp)
         if(aiocbp->aio_lio_opcode == LIO_WRITE)
         {
             POSIX_RECORD_WRITE(ret, aiocbp->aio_fildes,
-                1, aiocbp->aio_offset, aligned_flag,
+                1, aiocbp->aio_offset, aligned_flag, NULL, 0,
                 tmp->tm1, tm2);
+            POSIX_RECORD_AIO(ret, aiocbp->aio_fildes, DARSHAN_IO_WRITE,
+                tmp->direct_flag);
         }
         else if(aiocbp->aio_lio_opcode == LIO_READ)
         {
             POSIX_RECORD_READ(ret, aiocbp->aio_fildes,
-                1, aiocbp->aio_offset, aligned_flag,
+                1, aiocbp->aio_offset, aligned_flag, NULL, 0,
                 tmp->tm1, tm2);
+            POSIX_RECORD_AIO(ret, aiocbp->aio_fildes, DARSHAN_IO_READ,
+                tmp->direct_flag);
         }
         free(tmp);
     }
@@ -1851,6 +2781,152 @@ int DARSHAN_DECL(lio_listio64)(int mode, struct aiocb64 *const aiocb_list[],
     return(ret);
 }
 
+#ifdef HAVE_LIBAIO_H
+int DARSHAN_DECL(io_submit)(io_context_t ctx, long nr, struct iocb *ios[])
+{
+    int ret;
+    double tm1;
+    long i;
+    int j;
+    struct posix_file_record_ref *rec_ref;
+    struct posix_libaio_tracker *tracker;
+
+    MAP_OR_FAIL(io_submit);
+
+    tm1 = POSIX_WTIME();
+    ret = __real_io_submit(ctx, nr, ios);
+    if(ret <= 0)
+        return(ret);
+
+    /* track every iocb the kernel accepted while holding the lock once for
+     * the whole batch, rather than once per iocb
+     */
+    POSIX_PRE_RECORD();
+    for(i = 0; i < ret; i++)
+    {
+        struct iocb *iocbp = ios[i];
+        short opcode = iocbp->aio_lio_opcode;
+
+        if(opcode != IO_CMD_PREAD && opcode != IO_CMD_PWRITE &&
+           opcode != IO_CMD_PREADV && opcode != IO_CMD_PWRITEV)
+            continue;
+        rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash,
+            &iocbp->aio_fildes, sizeof(int));
+        if(!rec_ref)
+            continue;
+
+        tracker = malloc(sizeof(*tracker));
+        if(!tracker)
+            break;
+        tracker->tm1 = tm1;
+        tracker->fd = iocbp->aio_fildes;
+        tracker->aligned_flag = 1;
+        tracker->direct_flag = (rec_ref->open_flags & O_DIRECT) ? 1 : 0;
+        if(opcode == IO_CMD_PREAD || opcode == IO_CMD_PWRITE)
+        {
+            tracker->offset = iocbp->u.c.offset;
+            if(((unsigned long)iocbp->u.c.buf % darshan_mem_alignment) != 0)
+                tracker->aligned_flag = 0;
+        }
+        else
+        {
+            tracker->offset = iocbp->u.v.offset;
+            for(j = 0; j < iocbp->u.v.nr; j++)
+            {
+                if(((unsigned long)iocbp->u.v.vec[j].iov_base % darshan_mem_alignment) != 0)
+                    tracker->aligned_flag = 0;
+            }
+        }
+        if(opcode == IO_CMD_PWRITE || opcode == IO_CMD_PWRITEV)
+            tracker->rw_type = DARSHAN_IO_WRITE;
+        else
+            tracker->rw_type = DARSHAN_IO_READ;
+
+        /* the application may resubmit an iocb whose completion we never
+         * observed (e.g., if it reaped the completion ring directly), so
+         * drop any stale tracker before adding the new one
+         */
+        free(darshan_delete_record_ref(&(posix_runtime->libaio_hash),
+            &iocbp, sizeof(iocbp)));
+        if(!darshan_add_record_ref(&(posix_runtime->libaio_hash),
+            &iocbp, sizeof(iocbp), tracker))
+            free(tracker);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(io_getevents)(io_context_t ctx, long min_nr, long nr,
+    struct io_event *events, struct timespec *timeout)
+{
+    int ret;
+    double tm2;
+    int i;
+    ssize_t res;
+    struct posix_libaio_tracker *tracker;
+
+    MAP_OR_FAIL(io_getevents);
+
+    ret = __real_io_getevents(ctx, min_nr, nr, events, timeout);
+    tm2 = POSIX_WTIME();
+    if(ret <= 0)
+        return(ret);
+
+    POSIX_PRE_RECORD();
+    for(i = 0; i < ret; i++)
+    {
+        tracker = darshan_delete_record_ref(&(posix_runtime->libaio_hash),
+            &events[i].obj, sizeof(events[i].obj));
+        if(!tracker)
+            continue;
+
+        /* the kernel reports the number of bytes transferred or a negative
+         * errno value in the res field
+         */
+        res = (ssize_t)(long)events[i].res;
+        if(tracker->rw_type == DARSHAN_IO_WRITE)
+        {
+            POSIX_RECORD_WRITE(res, tracker->fd, 1, tracker->offset,
+                tracker->aligned_flag, NULL, 0, tracker->tm1, tm2);
+        }
+        else
+        {
+            POSIX_RECORD_READ(res, tracker->fd, 1, tracker->offset,
+                tracker->aligned_flag, NULL, 0, tracker->tm1, tm2);
+        }
+        POSIX_RECORD_AIO(res, tracker->fd, tracker->rw_type,
+            tracker->direct_flag);
+        free(tracker);
+    }
+    POSIX_POST_RECORD();
+
+    return(ret);
+}
+
+int DARSHAN_DECL(io_cancel)(io_context_t ctx, struct iocb *iocb,
+    struct io_event *evt)
+{
+    int ret;
+
+    MAP_OR_FAIL(io_cancel);
+
+    ret = __real_io_cancel(ctx, iocb, evt);
+    if(ret == 0)
+    {
+        /* a successfully canceled operation will never be returned by
+         * io_getevents(), so just stop tracking it
+         */
+        POSIX_PRE_RECORD();
+        free(darshan_delete_record_ref(&(posix_runtime->libaio_hash),
+            &iocb, sizeof(iocb)));
+        POSIX_POST_RECORD();
+    }
+
+    return(ret);
+}
+#endif
+
 int DARSHAN_DECL(rename)(const char *oldpath, const char *newpath)
 {
     int ret;
@@ -1938,6 +3014,10 @@ static void posix_runtime_initialize()
     /* if this attempt at initializing fails, we won't try again */
     posix_runtime_init_attempted = 1;
 
+    /* check whether access pattern histograms should be collected */
+    if(getenv("DARSHAN_POSIX_ACCESS_PATTERNS"))
+        posix_access_patterns_enabled = 1;
+
     /* try and store a default number of records for this module */
     psx_rec_count = DARSHAN_DEF_MOD_REC_COUNT;
 
@@ -1966,6 +3046,9 @@ static void posix_runtime_initialize()
     /* register a heatmap */
     posix_runtime->heatmap_id = heatmap_register("heatmap:POSIX");
 
+    /* register a time series of counter snapshots */
+    posix_runtime->snapshot_id = snapshot_register("snapshot:POSIX");
+
     return;
 }
 
@@ -1976,6 +3059,7 @@ static struct posix_file_record_ref *posix_track_new_file_record(
     struct posix_file_record_ref *rec_ref = NULL;
     struct darshan_fs_info fs_info;
     int ret;
+    int i;
 
     rec_ref = malloc(sizeof(*rec_ref));
     if(!rec_ref)
@@ -2017,7 +3101,15 @@ static struct posix_file_record_ref *posix_track_new_file_record(
 #ifndef DARSHAN_WRAP_MMAP
     /* set invalid value here if MMAP instrumentation is disabled */
     file_rec->counters[POSIX_MMAPS] = -1;
+    file_rec->counters[POSIX_MADVISES] = -1;
+    file_rec->counters[POSIX_MADVISE_BYTES] = -1;
+    file_rec->fcounters[POSIX_F_MADVISE_TIME] = -1;
 #endif /* undefined DARSHAN_WRAP_MMAP */
+    if(!posix_access_patterns_enabled)
+    {
+        for(i = POSIX_DELTA_BACK_4G_PLUS; i <= POSIX_REUSE_8_16; i++)
+            file_rec->counters[i] = -1;
+    }
     rec_ref->fs_type = fs_info.fs_type;
     rec_ref->file_rec = file_rec;
     posix_runtime->file_rec_count++;
@@ -2066,6 +3158,7 @@ static void posix_aio_tracker_add(int fd, void *aiocbp)
         {
             tracker->tm1 = darshan_core_wtime();
             tracker->aiocbp = aiocbp;
+            tracker->direct_flag = (rec_ref->open_flags & O_DIRECT) ? 1 : 0;
             LL_PREPEND(rec_ref->aio_list, tracker);
         }
     }
@@ -2073,6 +3166,256 @@ static void posix_aio_tracker_add(int fd, void *aiocbp)
     return;
 }
 
+/* updates the POSIX_DELTA_* and POSIX_REUSE_* histograms of a file record
+ * for a read or write of 'len' bytes at 'offset'
+ */
+static void posix_record_access_pattern(struct posix_file_record_ref *rec_ref,
+    int64_t offset, int64_t len)
+{
+    struct posix_access_window *win;
+    int64_t *counters = rec_ref->file_rec->counters;
+    int64_t delta = offset - rec_ref->last_access_end;
+    uint64_t mag;
+    int bucket;
+    int slot;
+    int d;
+
+    if(delta == 0)
+        counters[POSIX_DELTA_ZERO] += 1;
+    else
+    {
+        /* power of 16 buckets, with all distances under 4 KiB in the first */
+        mag = (delta > 0) ? delta : -delta;
+        for(bucket = 0, mag >>= 12; mag && bucket < 6; mag >>= 4)
+            bucket++;
+        if(delta > 0)
+            counters[POSIX_DELTA_FWD_0_4K + bucket] += 1;
+        else
+            counters[POSIX_DELTA_BACK_0_4K - bucket] += 1;
+    }
+    rec_ref->last_access_end = offset + len;
+
+    if(len <= 0)
+        return;
+    if(!rec_ref->reuse_window)
+    {
+        rec_ref->reuse_window = calloc(1, sizeof(*rec_ref->reuse_window));
+        if(!rec_ref->reuse_window)
+            return;
+    }
+    win = rec_ref->reuse_window;
+
+    /* look back, most recent access first, for one that overlaps this one */
+    for(d = 1; d <= win->count; d++)
+    {
+        slot = (win->next - d + POSIX_REUSE_WINDOW) % POSIX_REUSE_WINDOW;
+        if(win->start[slot] < offset + len && offset < win->end[slot])
+        {
+            if(d == 1)
+                counters[POSIX_REUSE_1] += 1;
+            else if(d <= 3)
+                counters[POSIX_REUSE_2_3] += 1;
+            else if(d <= 7)
+                counters[POSIX_REUSE_4_7] += 1;
+            else
+                counters[POSIX_REUSE_8_16] += 1;
+            break;
+        }
+    }
+
+    win->start[win->next] = offset;
+    win->end[win->next] = offset + len;
+    win->next = (win->next + 1) % POSIX_REUSE_WINDOW;
+    if(win->count < POSIX_REUSE_WINDOW)
+        win->count++;
+
+    return;
+}
+
+/* records a stat of 'path' relative to 'dirfd', as for the *at() calls */
+static void posix_record_stat_at(int dirfd, const char *path, int flags,
+    double tm1, double tm2)
+{
+    struct posix_file_record_ref *rec_ref;
+    char tmp_path[__DARSHAN_PATH_MAX] = {0};
+    char *dirpath = NULL;
+
+    if((flags & AT_EMPTY_PATH) && path[0] == '\0')
+    {
+        /* stat of dirfd itself */
+        rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash,
+            &dirfd, sizeof(dirfd));
+        if(rec_ref)
+            POSIX_RECORD_STAT(rec_ref, NULL, tm1, tm2);
+        return;
+    }
+
+    if(path[0] == '/' || dirfd == AT_FDCWD)
+    {
+        POSIX_LOOKUP_RECORD_STAT(path, NULL, tm1, tm2);
+        return;
+    }
+
+    /* construct path relative to dirfd, as for openat() */
+    rec_ref = darshan_lookup_record_ref(posix_runtime->fd_hash,
+        &dirfd, sizeof(dirfd));
+    if(rec_ref)
+    {
+        dirpath = darshan_core_lookup_record_name(rec_ref->file_rec->base_rec.id);
+        if(dirpath && (strlen(dirpath) + strlen(path) + 2) < __DARSHAN_PATH_MAX)
+        {
+            strcat(tmp_path, dirpath);
+            if(dirpath[strlen(dirpath)-1] != '/')
+                strcat(tmp_path, "/");
+            strcat(tmp_path, path);
+        }
+        else
+            dirpath = NULL;
+    }
+
+    if(dirpath)
+        POSIX_LOOKUP_RECORD_STAT(tmp_path, NULL, tm1, tm2);
+    else
+        /* fallback to relative path if Darshan doesn't know dirfd path */
+        POSIX_LOOKUP_RECORD_STAT(path, NULL, tm1, tm2);
+
+    return;
+}
+
+/* counts reads and writes issued while the file is in O_DIRECT mode, and
+ * those whose buffers, offset, or length are not aligned as direct I/O
+ * requires; depending on the file system, these either fail with EINVAL
+ * or are quietly served through the page cache
+ */
+static void posix_record_direct_io(struct posix_file_record_ref *rec_ref,
+    ssize_t ret, int rw_type, int pread_flag, int64_t offset,
+    const struct iovec *iov, int iovcnt)
+{
+    int64_t this_offset;
+    int unaligned = 0;
+    int err = errno;
+    int i;
+
+    /* preadv2/pwritev2 use the file offset when given an offset of -1 */
+    this_offset = (pread_flag && offset >= 0) ? offset : rec_ref->offset;
+    if(this_offset % POSIX_DIRECT_ALIGNMENT)
+        unaligned = 1;
+    for(i = 0; i < iovcnt; i++)
+    {
+        if(((unsigned long)iov[i].iov_base % POSIX_DIRECT_ALIGNMENT) ||
+           (iov[i].iov_len % POSIX_DIRECT_ALIGNMENT))
+            unaligned = 1;
+    }
+
+    if(rw_type == DARSHAN_IO_READ)
+    {
+        if(ret >= 0)
+            rec_ref->file_rec->counters[POSIX_DIRECT_READS] += 1;
+        if(unaligned)
+            rec_ref->file_rec->counters[POSIX_DIRECT_UNALIGNED_READS] += 1;
+    }
+    else
+    {
+        if(ret >= 0)
+            rec_ref->file_rec->counters[POSIX_DIRECT_WRITES] += 1;
+        if(unaligned)
+            rec_ref->file_rec->counters[POSIX_DIRECT_UNALIGNED_WRITES] += 1;
+    }
+    if(ret < 0 && err == EINVAL)
+        rec_ref->file_rec->counters[POSIX_DIRECT_FAILURES] += 1;
+
+    return;
+}
+
+/* returns the extent of a "rest of the file" range from 'offset', using the
+ * current size of the file open as 'fd' (0 if it cannot be determined)
+ */
+static int64_t posix_bytes_to_eof(int fd, int64_t offset)
+{
+    struct stat sbuf;
+    int err = errno;
+    int ret;
+
+#ifdef HAVE_STAT_SYMBOLS
+    MAP_OR_FAIL(fstat);
+#else
+    /* fstat is an inline wrapper around __fxstat before glibc 2.33 */
+    MAP_OR_FAIL(__fxstat);
+#endif
+    if(__darshan_disabled)
+        return(0);
+
+#ifdef HAVE_STAT_SYMBOLS
+    ret = __real_fstat(fd, &sbuf);
+#else
+    ret = __real___fxstat(_STAT_VER, fd, &sbuf);
+#endif
+    if(ret < 0)
+    {
+        errno = err;
+        return(0);
+    }
+
+    return((sbuf.st_size > offset) ? sbuf.st_size - offset : 0);
+}
+
+#ifdef DARSHAN_WRAP_MMAP
+static void posix_mmap_region_add(struct posix_file_record_ref *rec_ref,
+    void *addr, size_t length)
+{
+    struct posix_mmap_region *region;
+
+    /* a MAP_FIXED mapping may replace existing ones */
+    posix_mmap_region_del(addr, length);
+
+    region = malloc(sizeof(*region));
+    if(!region)
+        return;
+    region->addr = addr;
+    region->length = length;
+    region->rec_ref = rec_ref;
+    region->next = posix_runtime->mmap_regions;
+    posix_runtime->mmap_regions = region;
+
+    return;
+}
+
+static void posix_mmap_region_del(void *addr, size_t length)
+{
+    struct posix_mmap_region **pp = &posix_runtime->mmap_regions;
+    struct posix_mmap_region *region;
+    char *start = addr;
+
+    /* drop any mapping overlapping [addr, addr+length) */
+    while((region = *pp))
+    {
+        if(region->addr < start + length && start < region->addr + region->length)
+        {
+            *pp = region->next;
+            free(region);
+        }
+        else
+            pp = &region->next;
+    }
+
+    return;
+}
+
+static struct posix_mmap_region *posix_mmap_region_find(void *addr)
+{
+    struct posix_mmap_region *region;
+    char *p = addr;
+
+    for(region = posix_runtime->mmap_regions; region; region = region->next)
+    {
+        if(p >= region->addr && p < region->addr + region->length)
+            return(region);
+    }
+
+    return(NULL);
+}
+#endif /* DARSHAN_WRAP_MMAP */
+
 static void posix_finalize_file_records(void *rec_ref_p, void *user_ptr)
 {
     struct posix_file_record_ref *rec_ref =
@@ -2080,6 +3423,7 @@ static void posix_finalize_file_records(void *rec_ref_p, void *user_ptr)
 
     tdestroy(rec_ref->access_root, free);
     tdestroy(rec_ref->stride_root, free);
+    free(rec_ref->reuse_window);
     return;
 }
 
@@ -2311,6 +3655,40 @@ static void posix_record_reduction_op(void* infile_v, void* inoutfile_v,
                 inoutfile->fcounters[POSIX_F_SLOWEST_RANK_TIME];
         }
 
+        /* sum */
+        for(j=POSIX_AIO_READS; j<=POSIX_AIO_DIRECT_WRITES; j++)
+        {
+            tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
+        }
+
+        /* sum, histograms are mergeable bucket by bucket */
+        for(j=POSIX_DELTA_BACK_4G_PLUS; j<=POSIX_REUSE_8_16; j++)
+        {
+            tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
+            if(tmp_file.counters[j] < 0) /* make sure invalid counters are -1 exactly */
+                tmp_file.counters[j] = -1;
+        }
+
+        /* sum */
+        for(j=POSIX_FADVISES; j<=POSIX_SYNC_FILE_RANGE_BYTES; j++)
+        {
+            tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
+            if(tmp_file.counters[j] < 0) /* make sure invalid counters are -1 exactly */
+                tmp_file.counters[j] = -1;
+        }
+        for(j=POSIX_F_FADVISE_TIME; j<=POSIX_F_SYNC_FILE_RANGE_TIME; j++)
+        {
+            tmp_file.fcounters[j] = infile->fcounters[j] + inoutfile->fcounters[j];
+            if(tmp_file.fcounters[j] < 0)
+                tmp_file.fcounters[j] = -1;
+        }
+
+        /* sum */
+        for(j=POSIX_OPENS_DIRECT; j<=POSIX_DIRECT_FAILURES; j++)
+        {
+            tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
+        }
+
         /* update pointers */
         *inoutfile = tmp_file;
         inoutfile++;
@@ -2320,6 +3698,37 @@ static void posix_record_reduction_op(void* infile_v, void* inoutfile_v,
     return;
 }
 
+static void posix_shared_record_imbalance(MPI_Comm mod_comm,
+    struct darshan_posix_file *inrec_array, int shared_rec_count)
+{
+    struct darshan_imbalance_sample *samples;
+    int i;
+
+    if(!imbalance_enabled())
+        return;
+
+    samples = malloc(shared_rec_count * sizeof(*samples));
+    assert(samples);
+
+    /* hand this rank's i/o time and bytes of each shared record to the
+     * IMBALANCE module, which keeps their distribution across nodes
+     */
+    for(i=0; i<shared_rec_count; i++)
+    {
+        samples[i].id = inrec_array[i].base_rec.id;
+        samples[i].time = inrec_array[i].fcounters[POSIX_F_READ_TIME] +
+                          inrec_array[i].fcounters[POSIX_F_WRITE_TIME] +
+                          inrec_array[i].fcounters[POSIX_F_META_TIME];
+        samples[i].bytes = inrec_array[i].counters[POSIX_BYTES_READ] +
+                           inrec_array[i].counters[POSIX_BYTES_WRITTEN];
+    }
+
+    imbalance_reduce(DARSHAN_POSIX_MOD, mod_comm, samples, shared_rec_count);
+
+    free(samples);
+    return;
+}
+
 static void posix_shared_record_variance(MPI_Comm mod_comm,
     struct darshan_posix_file *inrec_array, struct darshan_posix_file *outrec_array,
     int shared_rec_count)
@@ -2434,72 +3843,45 @@ struct darshan_posix_file *darshan_posix_rec_id_to_file(darshan_record_id rec_id
 }
 
 /* posix module shutdown benchmark routine */
-void darshan_posix_shutdown_bench_setup(int test_case)
+void darshan_posix_shutdown_bench_setup(
+    struct darshan_shutdown_bench_workload *wl)
 {
-    char filepath[256];
-    int *fd_array;
+    char *filepath;
     int64_t *size_array;
-    int i;
+    int64_t size;
+    int i, j;
+    int fd;
 
     if(posix_runtime)
         posix_cleanup();
 
     posix_runtime_initialize();
+    if(!posix_runtime)
+        return;
 
     srand(my_rank);
-    fd_array = malloc(1024 * sizeof(int));
+    filepath = malloc(__DARSHAN_PATH_MAX);
     size_array = malloc(DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT * sizeof(int64_t));
-    assert(fd_array && size_array);
+    assert(filepath && size_array);
 
-    for(i = 0; i < 1024; i++)
-        fd_array[i] = i;
     for(i = 0; i < DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT; i++)
         size_array[i] = rand();
 
-    switch(test_case)
+    for(i = 0; i < wl->rec_count; i++)
     {
-        case 1: /* single file-per-process */
-            snprintf(filepath, 256, "fpp-0_rank-%d", my_rank);
-
-            POSIX_RECORD_OPEN(fd_array[0], filepath, 777, 0, 1);
-            POSIX_RECORD_WRITE(size_array[0], fd_array[0], 0, 0, 1, 1, 2);
-
-            break;
-        case 2: /* single shared file */
-            snprintf(filepath, 256, "shared-0");
-
-            POSIX_RECORD_OPEN(fd_array[0], filepath, 777, 0, 1);
-            POSIX_RECORD_WRITE(size_array[0], fd_array[0], 0, 0, 1, 1, 2);
-
-            break;
-        case 3: /* 1024 unique files per proc */
-            for(i = 0; i < 1024; i++)
-            {
-                snprintf(filepath, 256, "fpp-%d_rank-%d", i , my_rank);
-
-                POSIX_RECORD_OPEN(fd_array[i], filepath, 777, 0, 1);
-                POSIX_RECORD_WRITE(size_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT],
-                    fd_array[i], 0, 0, 1, 1, 2);
-            }
-
-            break;
-        case 4: /* 1024 shared files per proc */
-            for(i = 0; i < 1024; i++)
-            {
-                snprintf(filepath, 256, "shared-%d", i);
-
-                POSIX_RECORD_OPEN(fd_array[i], filepath, 777, 0, 1);
-                POSIX_RECORD_WRITE(size_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT],
-                    fd_array[i], 0, 0, 1, 1, 2);
-            }
+        darshan_shutdown_bench_rec_name(wl, i, filepath);
+        size = size_array[i % DARSHAN_COMMON_VAL_MAX_RUNTIME_COUNT];
+        fd = i;
 
-            break;
-        default:
-            fprintf(stderr, "Error: invalid Darshan benchmark test case.\n");
-            return;
+        POSIX_RECORD_OPEN(fd, filepath, 777, O_CREAT|O_WRONLY, 0, 1);
+        /* every write adds one DXT segment when tracing is enabled */
+        j = 0;
+        do {
+            POSIX_RECORD_WRITE(size, fd, 0, 0, 1, NULL, 0, 1, 2);
+        } while(++j < wl->dxt_segs);
     }
 
-    free(fd_array);
+    free(filepath);
     free(size_array);
 
     return;
@@ -2604,6 +3986,9 @@ static void posix_mpi_redux(
     posix_shared_record_variance(mod_comm, red_send_buf, red_recv_buf,
         shared_rec_count);
 
+    /* get the distribution of time and bytes across nodes for shared files */
+    posix_shared_record_imbalance(mod_comm, red_send_buf, shared_rec_count);
+
     /* update module state to account for shared file reduction */
     if(my_rank == 0)
     {
@@ -2655,7 +4040,16 @@ static void posix_cleanup()
     darshan_iter_record_refs(posix_runtime->rec_id_hash,
         &posix_finalize_file_records, NULL);
     darshan_clear_record_refs(&(posix_runtime->fd_hash), 0);
+    darshan_clear_record_refs(&(posix_runtime->libaio_hash), 1);
     darshan_clear_record_refs(&(posix_runtime->rec_id_hash), 1);
+#ifdef DARSHAN_WRAP_MMAP
+    while(posix_runtime->mmap_regions)
+    {
+        struct posix_mmap_region *next = posix_runtime->mmap_regions->next;
+        free(posix_runtime->mmap_regions);
+        posix_runtime->mmap_regions = next;
+    }
+#endif
 
     free(posix_runtime);
     posix_runtime = NULL;
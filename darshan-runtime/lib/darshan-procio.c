@@ -0,0 +1,578 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <darshan-runtime-config.h>
+#endif
+
+#define _XOPEN_SOURCE 500
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <assert.h>
+#include <sys/syscall.h>
+
+#include "darshan.h"
+#include "darshan-procio.h"
+
+/*
+ * Job-level module which captures the kernel's view of each process's I/O
+ * activity from /proc/self/io (and the block I/O delay from /proc/self/stat).
+ * Comparing the bytes passed to read()-style system calls (rchar) with the
+ * bytes actually fetched from storage (read_bytes) gives an estimate of how
+ * effective the page cache was for the job.
+ *
+ * This module does not intercept any functions.  Snapshots are taken at
+ * initialization and shutdown time, and periodically thereafter whenever
+ * an instrumented I/O operation completes after the sampling interval has
+ * elapsed (see procio_sample()).
+ */
+
+/* default number of seconds between periodic samples; can be overridden
+ * with the DARSHAN_PROCIO_SAMPLE_INTERVAL environment variable (a value of
+ * 0 disables periodic sampling)
+ */
+#define DARSHAN_PROCIO_DEF_SAMPLE_INTERVAL 10.0
+
+/* number of /proc/self/io and /proc/self/stat values captured per snapshot.
+ * these map directly onto the first counters of the PROCIO record.
+ */
+#define PROCIO_SNAPSHOT_COUNT (PROCIO_IOWAIT_TICKS + 1)
+
+struct procio_snapshot
+{
+    int64_t vals[PROCIO_SNAPSHOT_COUNT];
+};
+
+struct procio_runtime
+{
+    struct darshan_procio_record *record;
+    struct procio_snapshot start;
+    struct procio_snapshot last;
+    double sample_interval;
+    double next_sample;
+    int frozen;
+    int reduced;
+};
+
+static struct procio_runtime *procio_runtime = NULL;
+static pthread_mutex_t procio_runtime_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* timestamp of the next scheduled periodic sample (0 if none); this is
+ * checked without holding the module lock so that procio_sample() is cheap
+ * for the common case.  A stale read only delays or repeats the check.
+ */
+static volatile double procio_next_sample = 0;
+
+/* my_rank indicates the MPI rank of this process */
+static int my_rank = -1;
+
+/* internal helper functions for the PROCIO module */
+void procio_runtime_initialize(void);
+static int procio_take_snapshot(struct procio_snapshot *snap);
+static void procio_finalize_record(void);
+
+/* forward declaration for functions needed to interface with darshan-core */
+#ifdef HAVE_MPI
+static void procio_mpi_redux(
+    void *buffer,
+    MPI_Comm mod_comm,
+    darshan_record_id *shared_recs,
+    int shared_rec_count);
+static void procio_record_reduction_op(
+    void* infile_v,
+    void* inoutfile_v,
+    int *len,
+    MPI_Datatype *datatype);
+#endif
+static void procio_output(
+    void **buffer,
+    int *size);
+static void procio_cleanup(
+    void);
+
+/* macros for obtaining/releasing the PROCIO module lock */
+#define PROCIO_LOCK() pthread_mutex_lock(&procio_runtime_mutex)
+#define PROCIO_UNLOCK() pthread_mutex_unlock(&procio_runtime_mutex)
+
+/**********************************************************
+ * Internal functions for manipulating PROCIO module state *
+ **********************************************************/
+
+void procio_runtime_initialize()
+{
+    int ret;
+    size_t procio_rec_count;
+    darshan_record_id rec_id;
+    struct procio_snapshot snap;
+    char *envstr;
+    double interval;
+    int success;
+    long clk_tck;
+    darshan_module_funcs mod_funcs = {
+#ifdef HAVE_MPI
+        .mod_redux_func = &procio_mpi_redux,
+#endif
+        .mod_output_func = &procio_output,
+        .mod_cleanup_func = &procio_cleanup
+        };
+
+    /* don't bother registering if the kernel doesn't expose per-process I/O
+     * accounting (e.g., not Linux, or CONFIG_TASK_IO_ACCOUNTING not set)
+     */
+    if(procio_take_snapshot(&snap) < 0)
+        return;
+
+    PROCIO_LOCK();
+
+    /* don't do anything if already initialized */
+    if(procio_runtime)
+    {
+        PROCIO_UNLOCK();
+        return;
+    }
+
+    /* we just need to store one single record */
+    procio_rec_count = 1;
+
+    /* register the PROCIO module with the darshan-core component */
+    ret = darshan_core_register_module(
+        DARSHAN_PROCIO_MOD,
+        mod_funcs,
+        sizeof(struct darshan_procio_record),
+        &procio_rec_count,
+        &my_rank,
+        NULL);
+    if(ret < 0)
+    {
+        PROCIO_UNLOCK();
+        return;
+    }
+
+    /* initialize module's global state */
+    procio_runtime = malloc(sizeof(*procio_runtime));
+    if(!procio_runtime)
+    {
+        darshan_core_unregister_module(DARSHAN_PROCIO_MOD);
+        PROCIO_UNLOCK();
+        return;
+    }
+    memset(procio_runtime, 0, sizeof(*procio_runtime));
+
+    /* NOTE: the record is registered with a name so that darshan-core can
+     * identify it as shared by all ranks and reduce it at shutdown
+     */
+    rec_id = darshan_core_gen_record_id("darshan-procio-record");
+    procio_runtime->record = darshan_core_register_record(
+        rec_id,
+        "darshan-procio-record",
+        DARSHAN_PROCIO_MOD,
+        sizeof(struct darshan_procio_record),
+        NULL);
+    if(!(procio_runtime->record))
+    {
+        darshan_core_unregister_module(DARSHAN_PROCIO_MOD);
+        free(procio_runtime);
+        procio_runtime = NULL;
+        PROCIO_UNLOCK();
+        return;
+    }
+
+    procio_runtime->record->base_rec.id = rec_id;
+    procio_runtime->record->base_rec.rank = my_rank;
+    clk_tck = sysconf(_SC_CLK_TCK);
+    procio_runtime->record->counters[PROCIO_CLK_TCK] = (clk_tck > 0) ? clk_tck : -1;
+    procio_runtime->record->counters[PROCIO_SAMPLES] = 1;
+    procio_runtime->record->counters[PROCIO_PROCS] = 1;
+    procio_runtime->record->fcounters[PROCIO_F_START_TIMESTAMP] = darshan_core_wtime();
+    procio_runtime->record->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] = -1;
+    procio_runtime->start = snap;
+    procio_runtime->last = snap;
+
+    /* determine periodic sampling interval */
+    procio_runtime->sample_interval = DARSHAN_PROCIO_DEF_SAMPLE_INTERVAL;
+    envstr = getenv("DARSHAN_PROCIO_SAMPLE_INTERVAL");
+    if(envstr)
+    {
+        DARSHAN_PARSE_NUMBER_FROM_STR(envstr, double, interval, success);
+        if(success && interval >= 0)
+            procio_runtime->sample_interval = interval;
+    }
+    if(procio_runtime->sample_interval > 0)
+    {
+        procio_runtime->next_sample =
+            procio_runtime->record->fcounters[PROCIO_F_START_TIMESTAMP] +
+            procio_runtime->sample_interval;
+        procio_next_sample = procio_runtime->next_sample;
+    }
+
+    PROCIO_UNLOCK();
+
+    return;
+}
+
+/* read a small /proc file into the given buffer using raw system calls, so
+ * that this module never re-enters Darshan's own POSIX/STDIO wrappers (this
+ * may be called while another module's lock is held)
+ */
+static ssize_t procio_read_proc_file(const char *path, char *buf, size_t len)
+{
+    int fd;
+    ssize_t ret, total = 0;
+
+    fd = syscall(SYS_openat, AT_FDCWD, path, O_RDONLY);
+    if(fd < 0)
+        return(-1);
+
+    while(total < (ssize_t)len - 1)
+    {
+        ret = syscall(SYS_read, fd, buf + total, len - 1 - total);
+        if(ret < 0 && errno == EINTR)
+            continue;
+        if(ret <= 0)
+            break;
+        total += ret;
+    }
+    syscall(SYS_close, fd);
+    buf[total] = '\0';
+
+    return(total);
+}
+
+static int procio_take_snapshot(struct procio_snapshot *snap)
+{
+    static const struct {
+        const char *key;
+        int index;
+    } io_keys[] = {
+        {"rchar:", PROCIO_RCHAR},
+        {"wchar:", PROCIO_WCHAR},
+        {"syscr:", PROCIO_SYSCR},
+        {"syscw:", PROCIO_SYSCW},
+        {"read_bytes:", PROCIO_READ_BYTES},
+        {"write_bytes:", PROCIO_WRITE_BYTES},
+        {"cancelled_write_bytes:", PROCIO_CANCELLED_WRITE_BYTES},
+    };
+    char buf[1024];
+    char *line, *p;
+    int i, field;
+    int found = 0;
+    ssize_t ret;
+
+    for(i = 0; i < PROCIO_SNAPSHOT_COUNT; i++)
+        snap->vals[i] = -1;
+
+    ret = procio_read_proc_file("/proc/self/io", buf, sizeof(buf));
+    if(ret <= 0)
+        return(-1);
+
+    /* each line is of the form "<key>: <value>" */
+    for(line = buf; line && *line; line = p)
+    {
+        p = strchr(line, '\n');
+        if(p)
+            *p++ = '\0';
+        for(i = 0; i < (int)(sizeof(io_keys)/sizeof(io_keys[0])); i++)
+        {
+            if(strncmp(line, io_keys[i].key, strlen(io_keys[i].key)) == 0)
+            {
+                snap->vals[io_keys[i].index] =
+                    strtoll(line + strlen(io_keys[i].key), NULL, 10);
+                found++;
+                break;
+            }
+        }
+    }
+    if(!found)
+        return(-1);
+
+    /* the aggregated block I/O delay is field 42 of /proc/self/stat.  the
+     * second field (the command name) may contain spaces, so start counting
+     * fields after its closing parenthesis
+     */
+    ret = procio_read_proc_file("/proc/self/stat", buf, sizeof(buf));
+    if(ret > 0 && (p = strrchr(buf, ')')))
+    {
+        field = 2;
+        while(*p && field < 42)
+        {
+            p++;
+            if(*p == ' ')
+                field++;
+        }
+        if(field == 42)
+            snap->vals[PROCIO_IOWAIT_TICKS] = strtoll(p, NULL, 10);
+    }
+
+    return(0);
+}
+
+/* compute the page cache read hit ratio between two snapshots, or -1 if it
+ * cannot be determined (no read activity, or counters unavailable)
+ */
+static double procio_hit_ratio(struct procio_snapshot *from,
+    struct procio_snapshot *to)
+{
+    int64_t rchar, read_bytes;
+    double ratio;
+
+    if(from->vals[PROCIO_RCHAR] < 0 || to->vals[PROCIO_RCHAR] < 0 ||
+       from->vals[PROCIO_READ_BYTES] < 0 || to->vals[PROCIO_READ_BYTES] < 0)
+        return(-1);
+
+    rchar = to->vals[PROCIO_RCHAR] - from->vals[PROCIO_RCHAR];
+    read_bytes = to->vals[PROCIO_READ_BYTES] - from->vals[PROCIO_READ_BYTES];
+    if(rchar <= 0)
+        return(-1);
+
+    /* readahead can fetch more from storage than was requested */
+    ratio = 1.0 - ((double)read_bytes / (double)rchar);
+    if(ratio < 0)
+        ratio = 0;
+
+    return(ratio);
+}
+
+/* take the final snapshot and convert the record's counters to deltas;
+ * must be called with the module lock held
+ */
+static void procio_finalize_record()
+{
+    struct darshan_procio_record *rec = procio_runtime->record;
+    struct procio_snapshot end;
+    int i;
+
+    if(procio_runtime->frozen)
+        return;
+    procio_runtime->frozen = 1;
+    procio_next_sample = 0;
+
+    if(procio_take_snapshot(&end) < 0)
+        end = procio_runtime->last;
+    else
+        rec->counters[PROCIO_SAMPLES] += 1;
+    rec->fcounters[PROCIO_F_END_TIMESTAMP] = darshan_core_wtime();
+
+    for(i = 0; i < PROCIO_SNAPSHOT_COUNT; i++)
+    {
+        if(procio_runtime->start.vals[i] < 0 || end.vals[i] < 0)
+            rec->counters[i] = -1;
+        else
+            rec->counters[i] = end.vals[i] - procio_runtime->start.vals[i];
+    }
+
+    return;
+}
+
+void procio_sample(double now)
+{
+    struct procio_snapshot snap;
+    struct darshan_procio_record *rec;
+    double ratio;
+
+    if(procio_next_sample <= 0 || now < procio_next_sample)
+        return;
+
+    PROCIO_LOCK();
+    if(!procio_runtime || procio_runtime->frozen ||
+       now < procio_runtime->next_sample)
+    {
+        PROCIO_UNLOCK();
+        return;
+    }
+
+    /* schedule the next sample before doing anything else so that a
+     * failed snapshot does not cause us to retry on every operation
+     */
+    procio_runtime->next_sample = now + procio_runtime->sample_interval;
+    procio_next_sample = procio_runtime->next_sample;
+
+    if(procio_take_snapshot(&snap) == 0)
+    {
+        rec = procio_runtime->record;
+        rec->counters[PROCIO_SAMPLES] += 1;
+        ratio = procio_hit_ratio(&procio_runtime->last, &snap);
+        if(ratio >= 0 &&
+           (rec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] < 0 ||
+            ratio < rec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO]))
+            rec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] = ratio;
+        procio_runtime->last = snap;
+    }
+
+    PROCIO_UNLOCK();
+    return;
+}
+
+/********************************************************************************
+ *      functions exported by this module for coordinating with darshan-core    *
+ ********************************************************************************/
+
+#ifdef HAVE_MPI
+static void procio_mpi_redux(
+    void *procio_buf,
+    MPI_Comm mod_comm,
+    darshan_record_id *shared_recs,
+    int shared_rec_count)
+{
+    struct darshan_procio_record red_recv_buf;
+    MPI_Datatype red_type;
+    MPI_Op red_op;
+
+    PROCIO_LOCK();
+    assert(procio_runtime);
+
+    procio_finalize_record();
+
+    /* construct a datatype for a PROCIO record.  This is serving no purpose
+     * except to make sure we can do a reduction on proper boundaries
+     */
+    PMPI_Type_contiguous(sizeof(struct darshan_procio_record),
+        MPI_BYTE, &red_type);
+    PMPI_Type_commit(&red_type);
+
+    /* register a PROCIO record reduction operator */
+    PMPI_Op_create(procio_record_reduction_op, 1, &red_op);
+
+    /* reduce the PROCIO record from all ranks onto rank 0 */
+    PMPI_Reduce(procio_runtime->record, &red_recv_buf,
+        1, red_type, red_op, 0, mod_comm);
+
+    if(my_rank == 0)
+        memcpy(procio_runtime->record, &red_recv_buf, sizeof(red_recv_buf));
+    procio_runtime->reduced = 1;
+
+    PMPI_Type_free(&red_type);
+    PMPI_Op_free(&red_op);
+
+    PROCIO_UNLOCK();
+    return;
+}
+#endif
+
+/* Pass output data for the PROCIO module back to darshan-core to log to file. */
+static void procio_output(
+    void **buffer,
+    int *size)
+{
+    PROCIO_LOCK();
+    assert(procio_runtime);
+
+    /* take the final snapshot now if no reduction occurred */
+    procio_finalize_record();
+
+    /* non-zero ranks throw out their PROCIO record if it was reduced */
+    if(procio_runtime->reduced && my_rank != 0)
+    {
+        *buffer = NULL;
+        *size   = 0;
+    }
+
+    PROCIO_UNLOCK();
+    return;
+}
+
+static void procio_cleanup()
+{
+    PROCIO_LOCK();
+    assert(procio_runtime);
+
+    free(procio_runtime);
+    procio_runtime = NULL;
+    procio_next_sample = 0;
+
+    PROCIO_UNLOCK();
+    return;
+}
+
+#ifdef HAVE_MPI
+static void procio_record_reduction_op(
+    void* infile_v,
+    void* inoutfile_v,
+    int *len,
+    MPI_Datatype *datatype)
+{
+    struct darshan_procio_record tmp_rec;
+    struct darshan_procio_record *inrec = infile_v;
+    struct darshan_procio_record *inoutrec = inoutfile_v;
+    int i, j;
+
+    for(i=0; i<*len; i++)
+    {
+        memset(&tmp_rec, 0, sizeof(struct darshan_procio_record));
+        tmp_rec.base_rec.id = inrec->base_rec.id;
+        tmp_rec.base_rec.rank = -1;
+
+        /* sum, unless a counter could not be captured on some process */
+        for(j=PROCIO_RCHAR; j<=PROCIO_IOWAIT_TICKS; j++)
+        {
+            if(inrec->counters[j] < 0 || inoutrec->counters[j] < 0)
+                tmp_rec.counters[j] = -1;
+            else
+                tmp_rec.counters[j] = inrec->counters[j] + inoutrec->counters[j];
+        }
+
+        /* max */
+        tmp_rec.counters[PROCIO_CLK_TCK] = inrec->counters[PROCIO_CLK_TCK];
+        if(inoutrec->counters[PROCIO_CLK_TCK] > tmp_rec.counters[PROCIO_CLK_TCK])
+            tmp_rec.counters[PROCIO_CLK_TCK] = inoutrec->counters[PROCIO_CLK_TCK];
+
+        /* sum */
+        for(j=PROCIO_SAMPLES; j<=PROCIO_PROCS; j++)
+        {
+            tmp_rec.counters[j] = inrec->counters[j] + inoutrec->counters[j];
+        }
+
+        /* min (start timestamp) */
+        tmp_rec.fcounters[PROCIO_F_START_TIMESTAMP] =
+            (inrec->fcounters[PROCIO_F_START_TIMESTAMP] <
+             inoutrec->fcounters[PROCIO_F_START_TIMESTAMP]) ?
+            inrec->fcounters[PROCIO_F_START_TIMESTAMP] :
+            inoutrec->fcounters[PROCIO_F_START_TIMESTAMP];
+
+        /* max (end timestamp) */
+        tmp_rec.fcounters[PROCIO_F_END_TIMESTAMP] =
+            (inrec->fcounters[PROCIO_F_END_TIMESTAMP] >
+             inoutrec->fcounters[PROCIO_F_END_TIMESTAMP]) ?
+            inrec->fcounters[PROCIO_F_END_TIMESTAMP] :
+            inoutrec->fcounters[PROCIO_F_END_TIMESTAMP];
+
+        /* min, ignoring processes with no interval measurements */
+        if(inrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] < 0)
+            tmp_rec.fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] =
+                inoutrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO];
+        else if(inoutrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] < 0 ||
+                inrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] <
+                inoutrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO])
+            tmp_rec.fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] =
+                inrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO];
+        else
+            tmp_rec.fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] =
+                inoutrec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO];
+
+        /* update pointers */
+        *inoutrec = tmp_rec;
+        inoutrec++;
+        inrec++;
+    }
+
+    return;
+}
+#endif
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_PROCIO_H
+#define __DARSHAN_PROCIO_H
+
+#ifdef DARSHAN_PROCIO
+
+/* procio_sample()
+ *
+ * gives the PROCIO module an opportunity to take a periodic snapshot of
+ * /proc/self/io.  'now' is a Darshan timestamp (e.g., the end time of an
+ * I/O operation that was just instrumented).  This is cheap to call on
+ * every I/O operation; a snapshot is only taken once per sampling interval.
+ */
+void procio_sample(double now);
+
+#else
+
+/* provide a stub when the PROCIO module is disabled so that instrumentation
+ * modules calling into it do not need preprocessor guards
+ */
+#define procio_sample(now) do {} while(0)
+
+#endif
+
+#endif /* __DARSHAN_PROCIO_H */
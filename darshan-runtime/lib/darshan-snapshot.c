@@ -0,0 +1,569 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include <darshan-runtime-config.h>
+#endif
+
+#define _XOPEN_SOURCE 500
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <assert.h>
+#include <stdint.h>
+#ifdef HAVE_STDATOMIC_H
+#include <stdatomic.h>
+#endif
+
+#include "darshan.h"
+#include "darshan-snapshot.h"
+
+/* The SNAPSHOT module keeps a per-rank time series of selected counters of
+ * the modules that use it (e.g., opens, stats, fsyncs and bytes moved by
+ * POSIX).  Updates are accumulated into the current interval, and the
+ * deltas of an interval are stored as one snapshot in a fixed-size ring the
+ * first time an update for a later interval comes through the wrapper path,
+ * so no helper thread or timer is needed.  Intervals without any activity
+ * take no space, and once the ring is full the oldest snapshots are
+ * overwritten.
+ */
+
+/* default length of each snapshot interval, as floating point seconds */
+#define DARSHAN_DEF_SNAPSHOT_INTERVAL 1.0
+
+/* default and maximum number of snapshots kept per record; the maximum
+ * keeps the largest possible record within the default record buffer size
+ * of darshan-util
+ */
+#define DARSHAN_DEF_SNAPSHOT_SLOTS 256
+#define DARSHAN_MAX_SNAPSHOT_SLOTS 1024
+
+/* maximum number of distinct time series that we will track (there is one
+ * per module that interacts with it, not per file)
+ */
+#define DARSHAN_MAX_SNAPSHOTS 8
+
+#define SNAPSHOT_MASK(__counter) (((int64_t)1) << (__counter))
+
+/* counters captured unless DARSHAN_SNAPSHOT_COUNTERS says otherwise */
+#define DARSHAN_DEF_SNAPSHOT_COUNTERS ( \
+    SNAPSHOT_MASK(SNAPSHOT_OPENS) | SNAPSHOT_MASK(SNAPSHOT_STATS) | \
+    SNAPSHOT_MASK(SNAPSHOT_FSYNCS) | SNAPSHOT_MASK(SNAPSHOT_BYTES_READ) | \
+    SNAPSHOT_MASK(SNAPSHOT_BYTES_WRITTEN))
+
+#define X(a) #a,
+static const char *snapshot_counter_names[] = {
+    SNAPSHOT_COUNTERS
+};
+#undef X
+
+/* structure to track time series at runtime */
+struct snapshot_record_ref
+{
+    struct darshan_snapshot_record *snapshot_rec;
+    int64_t interval;                       /* index of the current interval */
+    int64_t current[SNAPSHOT_NUM_INDICES];  /* deltas of the current interval */
+    int active;                             /* set if the current interval has updates */
+    int64_t next_slot;                      /* ring slot of the next snapshot */
+    int64_t taken;                          /* number of snapshots taken so far */
+};
+
+/* The snapshot_runtime structure maintains necessary state for storing
+ * snapshot records and for coordinating with darshan-core at shutdown time.
+ */
+struct snapshot_runtime
+{
+    void *rec_id_hash;
+    int rec_count;
+    int frozen; /* flag to indicate that the counters should no longer be modified */
+    double interval_seconds;
+    int64_t counter_mask;
+    int ncounters;
+    int slots;
+};
+
+static struct snapshot_runtime *snapshot_runtime = NULL;
+static int my_rank = -1;
+
+/* counters captured by this process; read without holding the module lock
+ * so that updates of counters that are not captured return immediately
+ */
+static int64_t snapshot_counter_mask = 0;
+
+static struct snapshot_record_ref *snapshot_track_new_record(
+    darshan_record_id rec_id, const char *name);
+static size_t snapshot_rec_size(struct snapshot_runtime *runtime);
+static void snapshot_store(struct snapshot_record_ref *rec_ref);
+
+#ifdef HAVE_STDATOMIC_H
+atomic_flag snapshot_runtime_mutex;
+#define SNAPSHOT_LOCK() \
+    while (atomic_flag_test_and_set(&snapshot_runtime_mutex))
+#define SNAPSHOT_UNLOCK() \
+    atomic_flag_clear(&snapshot_runtime_mutex)
+#else
+static pthread_mutex_t snapshot_runtime_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define SNAPSHOT_LOCK() pthread_mutex_lock(&snapshot_runtime_mutex)
+#define SNAPSHOT_UNLOCK() pthread_mutex_unlock(&snapshot_runtime_mutex)
+#endif
+
+/* NOTE: as in the HEATMAP module, the PRE_RECORD here does not attempt to
+ * initialize this module.  That is done in the _register() call, which
+ * makes it safe to use atomics or spinlocks in the critical wrapper path.
+ */
+#define SNAPSHOT_PRE_RECORD_VOID() do { \
+    SNAPSHOT_LOCK(); \
+    if(snapshot_runtime && !snapshot_runtime->frozen) break; \
+    SNAPSHOT_UNLOCK(); \
+    return; \
+} while(0)
+
+#define SNAPSHOT_POST_RECORD() do { \
+    SNAPSHOT_UNLOCK(); \
+} while(0)
+
+/* move on to the interval containing 'timestamp', storing the snapshot of
+ * the current interval first; updates that arrive late (e.g., from another
+ * thread) are counted in the current interval
+ */
+#define SNAPSHOT_ADVANCE(__rec_ref, __timestamp) do { \
+    int64_t __interval = 0; \
+    if((__timestamp) > 0) \
+        __interval = (int64_t)((__timestamp) / snapshot_runtime->interval_seconds); \
+    if(__interval > (__rec_ref)->interval) { \
+        snapshot_store(__rec_ref); \
+        (__rec_ref)->interval = __interval; \
+    } \
+} while(0)
+
+static void snapshot_output(
+    void **snapshot_buf,
+    int *snapshot_buf_sz)
+{
+    struct darshan_snapshot_record *rec;
+    struct snapshot_record_ref *rec_ref;
+    void *contig_buf_ptr;
+    size_t stride, this_size;
+    double *times;
+    int64_t *deltas;
+    int64_t first, slot;
+    int nc;
+    int i, j;
+
+    SNAPSHOT_LOCK();
+    assert(snapshot_runtime);
+
+    *snapshot_buf_sz = 0;
+
+    /* freeze instrumentation if it's not already */
+    snapshot_runtime->frozen = 1;
+
+    stride = snapshot_rec_size(snapshot_runtime);
+    nc = snapshot_runtime->ncounters;
+    times = malloc(snapshot_runtime->slots * sizeof(*times));
+    deltas = malloc(snapshot_runtime->slots * nc * sizeof(*deltas));
+
+    /* store the last (partial) interval of each time series, then unroll
+     * the ring into chronological order and compact each record so that
+     * the deltas immediately follow the snapshot times
+     */
+    contig_buf_ptr = *snapshot_buf;
+    for(i = 0; i < snapshot_runtime->rec_count; i++)
+    {
+        rec = (struct darshan_snapshot_record *)((uintptr_t)*snapshot_buf + i*stride);
+        rec_ref = darshan_lookup_record_ref(snapshot_runtime->rec_id_hash,
+            &rec->base_rec.id, sizeof(darshan_record_id));
+        if(!rec_ref || !times || !deltas)
+            continue;
+
+        snapshot_store(rec_ref);
+        if(rec_ref->taken == 0)
+            continue; /* drop time series without any activity */
+
+        if(rec_ref->taken > snapshot_runtime->slots)
+        {
+            rec->nsnapshots = snapshot_runtime->slots;
+            first = rec_ref->next_slot;
+        }
+        else
+        {
+            rec->nsnapshots = rec_ref->taken;
+            first = 0;
+        }
+        rec->dropped = rec_ref->taken - rec->nsnapshots;
+
+        for(j = 0; j < rec->nsnapshots; j++)
+        {
+            slot = (first + j) % snapshot_runtime->slots;
+            times[j] = rec->times[slot];
+            memcpy(&deltas[j*nc], &rec->deltas[slot*nc], nc * sizeof(*deltas));
+        }
+        rec->times = (double *)((uintptr_t)rec + sizeof(*rec));
+        rec->deltas = (int64_t *)((uintptr_t)rec->times +
+            rec->nsnapshots * sizeof(*times));
+        memcpy(rec->times, times, rec->nsnapshots * sizeof(*times));
+        memcpy(rec->deltas, deltas, rec->nsnapshots * nc * sizeof(*deltas));
+
+        /* now shift the entire record + snapshots as a contiguous block
+         * down in the buffer so that the entire buffer is contiguous
+         */
+        this_size = sizeof(*rec) + rec->nsnapshots * (sizeof(*times) +
+            nc * sizeof(*deltas));
+        memmove(contig_buf_ptr, rec, this_size);
+        contig_buf_ptr = (void *)((uintptr_t)contig_buf_ptr + this_size);
+        *snapshot_buf_sz += this_size;
+    }
+
+    free(times);
+    free(deltas);
+
+    SNAPSHOT_UNLOCK();
+
+    return;
+}
+
+static void snapshot_cleanup()
+{
+    SNAPSHOT_LOCK();
+    assert(snapshot_runtime);
+
+    /* cleanup internal structures used for instrumenting */
+    darshan_clear_record_refs(&(snapshot_runtime->rec_id_hash), 1);
+
+    free(snapshot_runtime);
+    snapshot_runtime = NULL;
+    snapshot_counter_mask = 0;
+
+    SNAPSHOT_UNLOCK();
+    return;
+}
+
+/* parse the comma separated list of counters to capture, given with or
+ * without their SNAPSHOT_ prefix
+ */
+static int64_t snapshot_parse_counters(const char *counters_str)
+{
+    char *string, *tok, *saveptr = NULL;
+    const char *name;
+    int64_t mask = 0;
+    int i, found;
+
+    string = strdup(counters_str);
+    if(!string)
+        return(DARSHAN_DEF_SNAPSHOT_COUNTERS);
+
+    for(tok = strtok_r(string, ",", &saveptr); tok;
+        tok = strtok_r(NULL, ",", &saveptr))
+    {
+        found = 0;
+        for(i = 0; i < SNAPSHOT_NUM_INDICES; i++)
+        {
+            name = snapshot_counter_names[i];
+            if(strcmp(tok, name) == 0 ||
+               strcmp(tok, name + strlen("SNAPSHOT_")) == 0)
+            {
+                mask |= SNAPSHOT_MASK(i);
+                found = 1;
+            }
+        }
+        if(!found)
+            darshan_core_fprintf(stderr, "darshan library warning: "
+                "unknown counter \"%s\" in DARSHAN_SNAPSHOT_COUNTERS\n", tok);
+    }
+    free(string);
+
+    return(mask);
+}
+
+static struct snapshot_runtime* snapshot_runtime_initialize(void)
+{
+    struct snapshot_runtime* tmp_runtime;
+    size_t snapshot_rec_count = DARSHAN_MAX_SNAPSHOTS;
+    char *envstr;
+    double interval;
+    int slots;
+    int success;
+    int ret;
+    int i;
+
+    darshan_module_funcs mod_funcs = {
+        .mod_output_func = snapshot_output,
+        .mod_cleanup_func = snapshot_cleanup
+    };
+
+    tmp_runtime = malloc(sizeof(*tmp_runtime));
+    if(!tmp_runtime)
+        return(NULL);
+    memset(tmp_runtime, 0, sizeof(*tmp_runtime));
+    tmp_runtime->interval_seconds = DARSHAN_DEF_SNAPSHOT_INTERVAL;
+    tmp_runtime->slots = DARSHAN_DEF_SNAPSHOT_SLOTS;
+    tmp_runtime->counter_mask = DARSHAN_DEF_SNAPSHOT_COUNTERS;
+
+    /* the record size depends on these settings, so they must be known
+     * before registering with darshan-core
+     */
+    envstr = getenv("DARSHAN_SNAPSHOT_INTERVAL");
+    if(envstr)
+    {
+        DARSHAN_PARSE_NUMBER_FROM_STR(envstr, double, interval, success);
+        if(success && interval > 0)
+            tmp_runtime->interval_seconds = interval;
+    }
+    envstr = getenv("DARSHAN_SNAPSHOT_SLOTS");
+    if(envstr)
+    {
+        DARSHAN_PARSE_NUMBER_FROM_STR(envstr, int, slots, success);
+        if(success && slots > 0)
+        {
+            if(slots > DARSHAN_MAX_SNAPSHOT_SLOTS)
+                slots = DARSHAN_MAX_SNAPSHOT_SLOTS;
+            tmp_runtime->slots = slots;
+        }
+    }
+    envstr = getenv("DARSHAN_SNAPSHOT_COUNTERS");
+    if(envstr)
+        tmp_runtime->counter_mask = snapshot_parse_counters(envstr);
+    for(i = 0; i < SNAPSHOT_NUM_INDICES; i++)
+    {
+        if(tmp_runtime->counter_mask & SNAPSHOT_MASK(i))
+            tmp_runtime->ncounters++;
+    }
+    if(tmp_runtime->ncounters == 0)
+    {
+        free(tmp_runtime);
+        return(NULL);
+    }
+
+    /* register the snapshot module with darshan core */
+    /* note that we aren't holding a lock in this module at this point, but
+     * the core will serialize internally and return if this module is
+     * already registered (or disabled, which is the default)
+     */
+    ret = darshan_core_register_module(
+        DARSHAN_SNAPSHOT_MOD,
+        mod_funcs,
+        snapshot_rec_size(tmp_runtime),
+        &snapshot_rec_count,
+        &my_rank,
+        NULL);
+    if(ret < 0)
+    {
+        free(tmp_runtime);
+        return(NULL);
+    }
+
+    return(tmp_runtime);
+}
+
+darshan_record_id snapshot_register(const char* name)
+{
+    struct snapshot_record_ref *rec_ref;
+    darshan_record_id ret = 0;
+    struct snapshot_runtime* tmp_runtime;
+
+    SNAPSHOT_LOCK();
+
+    if(!snapshot_runtime) {
+        /* module not initialized. Drop atomic lock and try to do so */
+        SNAPSHOT_UNLOCK();
+
+        tmp_runtime = snapshot_runtime_initialize();
+
+        SNAPSHOT_LOCK();
+        /* see if someone beat us to it */
+        if(snapshot_runtime && tmp_runtime)
+            free(tmp_runtime);
+        else if(tmp_runtime)
+        {
+            snapshot_runtime = tmp_runtime;
+            snapshot_counter_mask = snapshot_runtime->counter_mask;
+        }
+    }
+
+    /* if we exit the above logic without anyone initializing, then we
+     * silently return
+     */
+    if(!snapshot_runtime || snapshot_runtime->frozen) {
+        SNAPSHOT_UNLOCK();
+        return(0);
+    }
+
+    /* generate id for this time series */
+    ret = darshan_core_gen_record_id(name);
+
+    /* instantiate a record now, rather than waiting until the first
+     * _update() call
+     */
+    rec_ref = darshan_lookup_record_ref(snapshot_runtime->rec_id_hash, &ret,
+        sizeof(darshan_record_id));
+    if(!rec_ref) rec_ref = snapshot_track_new_record(ret, name);
+    if(!rec_ref) ret = 0;
+
+    SNAPSHOT_UNLOCK();
+
+    return(ret);
+}
+
+void snapshot_update(darshan_record_id snapshot_id, int counter,
+    int64_t value, double timestamp)
+{
+    struct snapshot_record_ref *rec_ref;
+
+    /* return early for disabled time series and counters not captured */
+    if(!snapshot_id || !(snapshot_counter_mask & SNAPSHOT_MASK(counter)))
+        return;
+
+    SNAPSHOT_PRE_RECORD_VOID();
+
+    rec_ref = darshan_lookup_record_ref(snapshot_runtime->rec_id_hash,
+        &snapshot_id, sizeof(darshan_record_id));
+    if(!rec_ref) { SNAPSHOT_POST_RECORD(); return; }
+
+    SNAPSHOT_ADVANCE(rec_ref, timestamp);
+    rec_ref->current[counter] += value;
+    rec_ref->active = 1;
+
+    SNAPSHOT_POST_RECORD();
+
+    return;
+}
+
+void snapshot_update_rw(darshan_record_id snapshot_id, int rw_flag,
+    int64_t size, double timestamp)
+{
+    struct snapshot_record_ref *rec_ref;
+    int op_counter, bytes_counter;
+
+    if(rw_flag == SNAPSHOT_WRITE)
+    {
+        op_counter = SNAPSHOT_WRITES;
+        bytes_counter = SNAPSHOT_BYTES_WRITTEN;
+    }
+    else
+    {
+        op_counter = SNAPSHOT_READS;
+        bytes_counter = SNAPSHOT_BYTES_READ;
+    }
+
+    /* return early for disabled time series and counters not captured */
+    if(!snapshot_id || !(snapshot_counter_mask &
+        (SNAPSHOT_MASK(op_counter) | SNAPSHOT_MASK(bytes_counter))))
+        return;
+
+    SNAPSHOT_PRE_RECORD_VOID();
+
+    rec_ref = darshan_lookup_record_ref(snapshot_runtime->rec_id_hash,
+        &snapshot_id, sizeof(darshan_record_id));
+    if(!rec_ref) { SNAPSHOT_POST_RECORD(); return; }
+
+    SNAPSHOT_ADVANCE(rec_ref, timestamp);
+    rec_ref->current[op_counter] += 1;
+    if(size > 0)
+        rec_ref->current[bytes_counter] += size;
+    rec_ref->active = 1;
+
+    SNAPSHOT_POST_RECORD();
+
+    return;
+}
+
+/* size of a record holding a full ring of snapshots */
+static size_t snapshot_rec_size(struct snapshot_runtime *runtime)
+{
+    return(sizeof(struct darshan_snapshot_record) + runtime->slots *
+        (sizeof(double) + runtime->ncounters * sizeof(int64_t)));
+}
+
+/* store the deltas of the current interval, if any, in the next ring slot */
+static void snapshot_store(struct snapshot_record_ref *rec_ref)
+{
+    struct darshan_snapshot_record *rec = rec_ref->snapshot_rec;
+    int64_t *slot_deltas;
+    int i, j;
+
+    if(!rec_ref->active)
+        return;
+
+    rec->times[rec_ref->next_slot] =
+        rec_ref->interval * snapshot_runtime->interval_seconds;
+    slot_deltas = &rec->deltas[rec_ref->next_slot * snapshot_runtime->ncounters];
+    for(i = 0, j = 0; i < SNAPSHOT_NUM_INDICES; i++)
+    {
+        if(snapshot_runtime->counter_mask & SNAPSHOT_MASK(i))
+            slot_deltas[j++] = rec_ref->current[i];
+    }
+
+    memset(rec_ref->current, 0, sizeof(rec_ref->current));
+    rec_ref->active = 0;
+    rec_ref->next_slot = (rec_ref->next_slot + 1) % snapshot_runtime->slots;
+    rec_ref->taken++;
+
+    return;
+}
+
+static struct snapshot_record_ref *snapshot_track_new_record(
+    darshan_record_id rec_id, const char *name)
+{
+    struct darshan_snapshot_record *snapshot_rec = NULL;
+    struct snapshot_record_ref *rec_ref = NULL;
+    int ret;
+
+    rec_ref = malloc(sizeof(*rec_ref));
+    if(!rec_ref)
+        return(NULL);
+    memset(rec_ref, 0, sizeof(*rec_ref));
+
+    /* add a reference to this record */
+    ret = darshan_add_record_ref(&(snapshot_runtime->rec_id_hash), &rec_id,
+        sizeof(darshan_record_id), rec_ref);
+    if(ret == 0)
+    {
+        free(rec_ref);
+        return(NULL);
+    }
+
+    /* register with darshan-core so it is persisted in the log file */
+    /* include enough space for a full ring of snapshots */
+    snapshot_rec = darshan_core_register_record(
+        rec_id,
+        name,
+        DARSHAN_SNAPSHOT_MOD,
+        snapshot_rec_size(snapshot_runtime),
+        NULL);
+
+    if(!snapshot_rec)
+    {
+        darshan_delete_record_ref(&(snapshot_runtime->rec_id_hash),
+            &rec_id, sizeof(darshan_record_id));
+        free(rec_ref);
+        return(NULL);
+    }
+
+    /* registering this record was successful, so initialize some fields */
+    snapshot_rec->base_rec.id = rec_id;
+    snapshot_rec->base_rec.rank = my_rank;
+    snapshot_rec->interval_seconds = snapshot_runtime->interval_seconds;
+    snapshot_rec->counter_mask = snapshot_runtime->counter_mask;
+    snapshot_rec->times = (double*)((uintptr_t)snapshot_rec + sizeof(*snapshot_rec));
+    snapshot_rec->deltas = (int64_t*)((uintptr_t)snapshot_rec->times +
+        snapshot_runtime->slots * sizeof(double));
+    rec_ref->snapshot_rec = snapshot_rec;
+    snapshot_runtime->rec_count++;
+
+    return(rec_ref);
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_SNAPSHOT_H
+#define __DARSHAN_SNAPSHOT_H
+
+#include <stdint.h>
+
+#define SNAPSHOT_READ 1
+#define SNAPSHOT_WRITE 2
+
+#ifdef DARSHAN_SNAPSHOT
+
+/* snapshot_register()
+ *
+ * registers a time series of counter snapshots with specified name.
+ * Returns record id to use for subsequent updates, or 0 if snapshots are
+ * not enabled.
+ */
+darshan_record_id snapshot_register(const char* name);
+
+/* snapshot_update()
+ *
+ * adds 'value' to the given counter (a SNAPSHOT_* counter index) in the
+ * snapshot interval containing 'timestamp'.  The snapshot of the previous
+ * interval is stored once an update for a later interval arrives.
+ */
+void snapshot_update(darshan_record_id snapshot_id, int counter,
+    int64_t value, double timestamp);
+
+/* snapshot_update_rw()
+ *
+ * records a read or write operation of 'size' bytes, updating both the
+ * operation and byte counters of the snapshot at once
+ */
+void snapshot_update_rw(darshan_record_id snapshot_id, int rw_flag,
+    int64_t size, double timestamp);
+
+#else
+
+/* provide stubs when the SNAPSHOT module is disabled so that
+ * instrumentation modules calling into it do not need preprocessor guards
+ */
+
+static inline darshan_record_id snapshot_register(const char* name) {
+    return(0);
+}
+
+#define snapshot_update(snapshot_id, counter, value, timestamp) \
+do {} while(0)
+
+#define snapshot_update_rw(snapshot_id, rw_flag, size, timestamp) \
+do {} while(0)
+
+#endif
+
+#endif /* __DARSHAN_SNAPSHOT_H */
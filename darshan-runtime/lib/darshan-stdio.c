@@ -51,6 +51,13 @@
  * int      fsetpos64(FILE *, const fpos_t *);              DONE
  * void     rewind(FILE *);                                 DONE
  *
+ * functions for controlling stream buffering
+ * --------------
+ * int      setvbuf(FILE *, char *, int, size_t);           DONE
+ * void     setbuf(FILE *, char *);                         DONE
+ * void     setbuffer(FILE *, char *, size_t);              DONE
+ * void     setlinebuf(FILE *);                             DONE
+ *
  * Omissions:
  *   - _unlocked() variants of the various flush, read, and write
  *     functions.  There are many of these, but they are not available on all
@@ -83,10 +90,17 @@
 #include <pthread.h>
 #include <stdint.h>
 #include <limits.h>
+#ifdef HAVE_STDIO_BUFFER_INTERNALS
+#include <stdio_ext.h>
+#endif
 
 #include "darshan.h"
 #include "darshan-dynamic.h"
 #include "darshan-heatmap.h"
+#include "darshan-procio.h"
+#include "darshan-nfs.h"
+#include "darshan-snapshot.h"
+#include "darshan-imbalance.h"
 #include "darshan-ldms.h"
 
 #ifndef HAVE_OFF64_T
@@ -126,6 +140,10 @@ DARSHAN_FORWARD_DECL(fseeko64, int, (FILE *stream, off64_t offset, int whence));
 DARSHAN_FORWARD_DECL(fsetpos, int, (FILE *stream, const fpos_t *pos));
 DARSHAN_FORWARD_DECL(fsetpos64, int, (FILE *stream, const fpos64_t *pos));
 DARSHAN_FORWARD_DECL(rewind, void, (FILE *stream));
+DARSHAN_FORWARD_DECL(setvbuf, int, (FILE *stream, char *buf, int mode, size_t size));
+DARSHAN_FORWARD_DECL(setbuf, void, (FILE *stream, char *buf));
+DARSHAN_FORWARD_DECL(setbuffer, void, (FILE *stream, char *buf, size_t size));
+DARSHAN_FORWARD_DECL(setlinebuf, void, (FILE *stream));
 
 /* structure to track stdio stats at runtime */
 struct stdio_file_record_ref
@@ -151,6 +169,7 @@ struct stdio_runtime
     void *stream_hash;
     int file_rec_count;
     darshan_record_id heatmap_id;
+    darshan_record_id snapshot_id;
     int frozen; /* flag to indicate that the counters should no longer be modified */
 };
 
@@ -164,12 +183,17 @@ static void stdio_runtime_initialize(
     void);
 static struct stdio_file_record_ref *stdio_track_new_file_record(
     darshan_record_id rec_id, const char *path);
+static void stdio_record_buffering(
+    struct darshan_stdio_file *file_rec, FILE *fp, int rw_flag,
+    int64_t bytes, int64_t buffered_before);
 #ifdef HAVE_MPI
 static void stdio_record_reduction_op(void* infile_v, void* inoutfile_v,
     int *len, MPI_Datatype *datatype);
 static void stdio_shared_record_variance(
     MPI_Comm mod_comm, struct darshan_stdio_file *inrec_array,
     struct darshan_stdio_file *outrec_array, int shared_rec_count);
+static void stdio_shared_record_imbalance(
+    MPI_Comm mod_comm, struct darshan_stdio_file *inrec_array, int shared_rec_count);
 static void stdio_mpi_redux(
     void *stdio_buf, MPI_Comm mod_comm,
     darshan_record_id *shared_recs, int shared_rec_count);
@@ -195,6 +219,25 @@ extern int __real_fileno(FILE *stream);
 #define STDIO_WTIME() \
     __darshan_disabled ? 0 : darshan_core_wtime();
 
+/* The stdio library issues its read()/write() system calls internally,
+ * where they cannot be intercepted by the POSIX module.  Instead, we sample
+ * how many bytes are buffered in a stream before and after each operation:
+ * if the change does not match the number of bytes moved by the operation,
+ * then the library must have drained or refilled the buffer in between.
+ * These macros return the number of bytes waiting to be written to (or
+ * available to be read from) a stream's buffer, or -1 if the buffer state
+ * cannot be inspected on this platform.
+ */
+#ifdef HAVE_STDIO_BUFFER_INTERNALS
+#define STDIO_BUFFERED_OUT(__fp) \
+    ((__fp) ? (int64_t)__fpending(__fp) : -1)
+#define STDIO_BUFFERED_IN(__fp) \
+    ((__fp) ? (int64_t)((__fp)->_IO_read_end - (__fp)->_IO_read_ptr) : -1)
+#else
+#define STDIO_BUFFERED_OUT(__fp) ((void)(__fp), (int64_t)-1)
+#define STDIO_BUFFERED_IN(__fp) ((void)(__fp), (int64_t)-1)
+#endif
+
 /* note that if the break condition is triggered in this macro, then it
  * will exit the do/while loop holding a lock that will be released in
  * POST_RECORD().  Otherwise it will release the lock here (if held) and
@@ -211,6 +254,18 @@ extern int __real_fileno(FILE *stream);
     return(ret); \
 } while(0)
 
+/* variant of STDIO_PRE_RECORD() for wrappers with no return value */
+#define STDIO_VOID_PRE_RECORD() do { \
+    if(__darshan_disabled) return; \
+    STDIO_LOCK(); \
+    if(!stdio_runtime && !stdio_runtime_init_attempted) \
+        stdio_runtime_initialize(); \
+    if(!stdio_runtime || stdio_runtime->frozen) { \
+        STDIO_UNLOCK(); \
+        return; \
+    } \
+} while(0)
+
 #define STDIO_POST_RECORD() do { \
     STDIO_UNLOCK(); \
 } while(0)
@@ -247,6 +302,7 @@ extern int __real_fileno(FILE *stream);
 #define _STDIO_RECORD_OPEN(__ret, __rec_ref, __tm1, __tm2, __reset_flag, __ref_counter) do { \
     if(__reset_flag) __rec_ref->offset = 0; \
     __rec_ref->file_rec->counters[STDIO_OPENS] += 1; \
+    snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_OPENS, 1, __tm2); \
     if(__ref_counter >= 0) __rec_ref->file_rec->counters[__ref_counter] += 1; \
     if(__rec_ref->file_rec->fcounters[STDIO_F_OPEN_START_TIMESTAMP] == 0 || \
      __rec_ref->file_rec->fcounters[STDIO_F_OPEN_START_TIMESTAMP] > __tm1) \
@@ -257,7 +313,7 @@ extern int __real_fileno(FILE *stream);
 } while(0)
 
 
-#define STDIO_RECORD_READ(__fp, __bytes,  __tm1, __tm2) do{ \
+#define STDIO_RECORD_READ(__fp, __bytes,  __tm1, __tm2, __buffered) do{ \
     struct stdio_file_record_ref* rec_ref; \
     int64_t this_offset; \
     rec_ref = darshan_lookup_record_ref(stdio_runtime->stream_hash, &(__fp), sizeof(__fp)); \
@@ -266,10 +322,15 @@ extern int __real_fileno(FILE *stream);
     rec_ref->offset = this_offset + __bytes; \
     /* heatmap to record traffic summary */ \
     heatmap_update(stdio_runtime->heatmap_id, HEATMAP_READ, __bytes, __tm1, __tm2); \
+    snapshot_update_rw(stdio_runtime->snapshot_id, SNAPSHOT_READ, __bytes, __tm2); \
+    /* periodic page cache and NFS client snapshots, if due */ \
+    procio_sample(__tm2); \
+    nfs_sample(__tm2); \
     if(rec_ref->file_rec->counters[STDIO_MAX_BYTE_READ] < (this_offset + __bytes - 1)) \
         rec_ref->file_rec->counters[STDIO_MAX_BYTE_READ] = (this_offset + __bytes - 1); \
     rec_ref->file_rec->counters[STDIO_BYTES_READ] += __bytes; \
     rec_ref->file_rec->counters[STDIO_READS] += 1; \
+    stdio_record_buffering(rec_ref->file_rec, __fp, DARSHAN_IO_READ, __bytes, __buffered); \
     if(rec_ref->file_rec->fcounters[STDIO_F_READ_START_TIMESTAMP] == 0 || \
      rec_ref->file_rec->fcounters[STDIO_F_READ_START_TIMESTAMP] > __tm1) \
         rec_ref->file_rec->fcounters[STDIO_F_READ_START_TIMESTAMP] = __tm1; \
@@ -281,7 +342,7 @@ extern int __real_fileno(FILE *stream);
             darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->file_rec->counters[STDIO_READS], "read", this_offset, __bytes, rec_ref->file_rec->counters[STDIO_MAX_BYTE_READ], -1, -1, __tm1, __tm2, rec_ref->file_rec->fcounters[STDIO_F_READ_TIME],"STDIO", "MOD"); \
 } while(0)
 
-#define STDIO_RECORD_WRITE(__fp, __bytes,  __tm1, __tm2, __fflush_flag) do{ \
+#define STDIO_RECORD_WRITE(__fp, __bytes,  __tm1, __tm2, __fflush_flag, __buffered) do{ \
     struct stdio_file_record_ref* rec_ref; \
     int64_t this_offset; \
     rec_ref = darshan_lookup_record_ref(stdio_runtime->stream_hash, &(__fp), sizeof(__fp)); \
@@ -290,6 +351,16 @@ extern int __real_fileno(FILE *stream);
     rec_ref->offset = this_offset + __bytes; \
     /* heatmap to record traffic summary */ \
     heatmap_update(stdio_runtime->heatmap_id, HEATMAP_WRITE, __bytes, __tm1, __tm2); \
+    /* fflush is counted as an fsync in counter snapshots */ \
+    if(__fflush_flag) { \
+        snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_FSYNCS, 1, __tm2); \
+        snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_BYTES_WRITTEN, __bytes, __tm2); \
+    } \
+    else \
+        snapshot_update_rw(stdio_runtime->snapshot_id, SNAPSHOT_WRITE, __bytes, __tm2); \
+    /* periodic page cache and NFS client snapshots, if due */ \
+    procio_sample(__tm2); \
+    nfs_sample(__tm2); \
     if(rec_ref->file_rec->counters[STDIO_MAX_BYTE_WRITTEN] < (this_offset + __bytes - 1)) \
         rec_ref->file_rec->counters[STDIO_MAX_BYTE_WRITTEN] = (this_offset + __bytes - 1); \
     rec_ref->file_rec->counters[STDIO_BYTES_WRITTEN] += __bytes; \
@@ -297,6 +368,7 @@ extern int __real_fileno(FILE *stream);
         rec_ref->file_rec->counters[STDIO_FLUSHES] += 1; \
     else \
         rec_ref->file_rec->counters[STDIO_WRITES] += 1; \
+    stdio_record_buffering(rec_ref->file_rec, __fp, DARSHAN_IO_WRITE, __bytes, __buffered); \
     if(rec_ref->file_rec->fcounters[STDIO_F_WRITE_START_TIMESTAMP] == 0 || \
      rec_ref->file_rec->fcounters[STDIO_F_WRITE_START_TIMESTAMP] > __tm1) \
         rec_ref->file_rec->fcounters[STDIO_F_WRITE_START_TIMESTAMP] = __tm1; \
@@ -308,6 +380,21 @@ extern int __real_fileno(FILE *stream);
             darshan_ldms_connector_send(rec_ref->file_rec->base_rec.id, rec_ref->file_rec->base_rec.rank, rec_ref->file_rec->counters[STDIO_WRITES], "write", this_offset, __bytes, rec_ref->file_rec->counters[STDIO_MAX_BYTE_WRITTEN], -1, rec_ref->file_rec->counters[STDIO_FLUSHES], __tm1, __tm2,  rec_ref->file_rec->fcounters[STDIO_F_WRITE_TIME], "STDIO", "MOD"); \
 } while(0)
 
+/* record an explicit change to the buffering of a stream; a __size of -1
+ * means that the library chooses the buffer size, which is observed the next
+ * time the stream is used
+ */
+#define STDIO_RECORD_SETVBUF(__fp, __mode, __size, __tm1, __tm2) do{ \
+    struct stdio_file_record_ref* rec_ref; \
+    rec_ref = darshan_lookup_record_ref(stdio_runtime->stream_hash, &(__fp), sizeof(__fp)); \
+    if(!rec_ref) break; \
+    rec_ref->file_rec->counters[STDIO_SETVBUFS] += 1; \
+    rec_ref->file_rec->counters[STDIO_BUF_MODE] = __mode; \
+    if(__size >= 0) rec_ref->file_rec->counters[STDIO_BUF_SIZE] = __size; \
+    stdio_record_buffering(rec_ref->file_rec, __fp, 0, 0, -1); \
+    DARSHAN_TIMER_INC_NO_OVERLAP(rec_ref->file_rec->fcounters[STDIO_F_META_TIME], __tm1, __tm2, rec_ref->last_meta_end); \
+} while(0)
+
 FILE* DARSHAN_DECL(fopen)(const char *path, const char *mode)
 {
     FILE* ret;
@@ -418,17 +505,19 @@ FILE* DARSHAN_DECL(freopen64)(const char *path, const char *mode, FILE *stream)
 int DARSHAN_DECL(fflush)(FILE *fp)
 {
     double tm1, tm2;
+    int64_t buffered;
     int ret;
 
     MAP_OR_FAIL(fflush);
 
+    buffered = STDIO_BUFFERED_OUT(fp);
     tm1 = STDIO_WTIME();
     ret = __real_fflush(fp);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret >= 0)
-        STDIO_RECORD_WRITE(fp, 0, tm1, tm2, 1);
+        STDIO_RECORD_WRITE(fp, 0, tm1, tm2, 1, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -454,6 +543,9 @@ int DARSHAN_DECL(fclose)(FILE *fp)
 		int fd = __real_fileno(fp);
                 darshan_instrument_fs_data(rec_ref->fs_type,
                     rec_ref->file_rec->base_rec.id, fd);
+                /* fclose() writes out anything still buffered */
+                if(STDIO_BUFFERED_OUT(fp) > 0)
+                    rec_ref->file_rec->counters[STDIO_POSIX_WRITES] += 1;
             }
         }
         STDIO_UNLOCK();
@@ -493,16 +585,18 @@ size_t DARSHAN_DECL(fwrite)(const void *ptr, size_t size, size_t nmemb, FILE *st
 {
     size_t ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(fwrite);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     ret = __real_fwrite(ptr, size, nmemb, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret > 0)
-        STDIO_RECORD_WRITE(stream, size*ret, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, size*ret, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -513,16 +607,18 @@ int DARSHAN_DECL(fputc)(int c, FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(fputc);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     ret = __real_fputc(c, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF)
-        STDIO_RECORD_WRITE(stream, 1, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, 1, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -532,16 +628,18 @@ int DARSHAN_DECL(putw)(int w, FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(putw);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     ret = __real_putw(w, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF)
-        STDIO_RECORD_WRITE(stream, sizeof(int), tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, sizeof(int), tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -553,16 +651,18 @@ int DARSHAN_DECL(fputs)(const char *s, FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(fputs);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     ret = __real_fputs(s, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF && ret > 0)
-        STDIO_RECORD_WRITE(stream, strlen(s), tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, strlen(s), tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -572,16 +672,18 @@ int DARSHAN_DECL(vprintf)(const char *format, va_list ap)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(vprintf);
 
+    buffered = STDIO_BUFFERED_OUT(stdout);
     tm1 = STDIO_WTIME();
     ret = __real_vprintf(format, ap);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret > 0)
-        STDIO_RECORD_WRITE(stdout, ret, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stdout, ret, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -591,16 +693,18 @@ int DARSHAN_DECL(vfprintf)(FILE *stream, const char *format, va_list ap)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(vfprintf);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     ret = __real_vfprintf(stream, format, ap);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret > 0)
-        STDIO_RECORD_WRITE(stream, ret, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, ret, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -611,10 +715,12 @@ int DARSHAN_DECL(printf)(const char *format, ...)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
     va_list ap;
 
     MAP_OR_FAIL(vprintf);
 
+    buffered = STDIO_BUFFERED_OUT(stdout);
     tm1 = STDIO_WTIME();
     /* NOTE: we intentionally switch to vprintf here to handle the variable
      * length arguments.
@@ -626,7 +732,7 @@ int DARSHAN_DECL(printf)(const char *format, ...)
 
     STDIO_PRE_RECORD();
     if(ret > 0)
-        STDIO_RECORD_WRITE(stdout, ret, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stdout, ret, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -636,10 +742,12 @@ int DARSHAN_DECL(fprintf)(FILE *stream, const char *format, ...)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
     va_list ap;
 
     MAP_OR_FAIL(vfprintf);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     /* NOTE: we intentionally switch to vfprintf here to handle the variable
      * length arguments.
@@ -651,7 +759,7 @@ int DARSHAN_DECL(fprintf)(FILE *stream, const char *format, ...)
 
     STDIO_PRE_RECORD();
     if(ret > 0)
-        STDIO_RECORD_WRITE(stream, ret, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, ret, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -661,16 +769,18 @@ size_t DARSHAN_DECL(fread)(void *ptr, size_t size, size_t nmemb, FILE *stream)
 {
     size_t ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(fread);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     ret = __real_fread(ptr, size, nmemb, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret > 0)
-        STDIO_RECORD_READ(stream, size*ret, tm1, tm2);
+        STDIO_RECORD_READ(stream, size*ret, tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -680,16 +790,18 @@ int DARSHAN_DECL(fgetc)(FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(fgetc);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     ret = __real_fgetc(stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF)
-        STDIO_RECORD_READ(stream, 1, tm1, tm2);
+        STDIO_RECORD_READ(stream, 1, tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -700,16 +812,18 @@ int DARSHAN_DECL(_IO_getc)(FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(_IO_getc);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     ret = __real__IO_getc(stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF)
-        STDIO_RECORD_READ(stream, 1, tm1, tm2);
+        STDIO_RECORD_READ(stream, 1, tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -720,16 +834,18 @@ int DARSHAN_DECL(_IO_putc)(int c, FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(_IO_putc);
 
+    buffered = STDIO_BUFFERED_OUT(stream);
     tm1 = STDIO_WTIME();
     ret = __real__IO_putc(c, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF)
-        STDIO_RECORD_WRITE(stream, 1, tm1, tm2, 0);
+        STDIO_RECORD_WRITE(stream, 1, tm1, tm2, 0, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -739,16 +855,18 @@ int DARSHAN_DECL(getw)(FILE *stream)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(getw);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     ret = __real_getw(stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != EOF || ferror(stream) == 0)
-        STDIO_RECORD_READ(stream, sizeof(int), tm1, tm2);
+        STDIO_RECORD_READ(stream, sizeof(int), tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -762,11 +880,13 @@ int DARSHAN_DECL(__isoc99_fscanf)(FILE *stream, const char *format, ...)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
     va_list ap;
     long start_off, end_off;
 
     MAP_OR_FAIL(vfscanf);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     /* NOTE: we intentionally switch to vfscanf here to handle the variable
      * length arguments.
@@ -780,7 +900,7 @@ int DARSHAN_DECL(__isoc99_fscanf)(FILE *stream, const char *format, ...)
 
     STDIO_PRE_RECORD();
     if(ret != 0)
-        STDIO_RECORD_READ(stream, (end_off-start_off), tm1, tm2);
+        STDIO_RECORD_READ(stream, (end_off-start_off), tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -790,11 +910,13 @@ int DARSHAN_DECL(fscanf)(FILE *stream, const char *format, ...)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
     va_list ap;
     long start_off, end_off;
 
     MAP_OR_FAIL(vfscanf);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     /* NOTE: we intentionally switch to vfscanf here to handle the variable
      * length arguments.
@@ -808,7 +930,7 @@ int DARSHAN_DECL(fscanf)(FILE *stream, const char *format, ...)
 
     STDIO_PRE_RECORD();
     if(ret != 0)
-        STDIO_RECORD_READ(stream, (end_off-start_off), tm1, tm2);
+        STDIO_RECORD_READ(stream, (end_off-start_off), tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -819,10 +941,12 @@ int DARSHAN_DECL(vfscanf)(FILE *stream, const char *format, va_list ap)
 {
     int ret;
     double tm1, tm2;
+    int64_t buffered;
     long start_off, end_off;
 
     MAP_OR_FAIL(vfscanf);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     start_off = ftell(stream);
     ret = __real_vfscanf(stream, format, ap);
@@ -831,7 +955,7 @@ int DARSHAN_DECL(vfscanf)(FILE *stream, const char *format, va_list ap)
 
     STDIO_PRE_RECORD();
     if(ret != 0)
-        STDIO_RECORD_READ(stream, end_off-start_off, tm1, tm2);
+        STDIO_RECORD_READ(stream, end_off-start_off, tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -842,16 +966,18 @@ char* DARSHAN_DECL(fgets)(char *s, int size, FILE *stream)
 {
     char *ret;
     double tm1, tm2;
+    int64_t buffered;
 
     MAP_OR_FAIL(fgets);
 
+    buffered = STDIO_BUFFERED_IN(stream);
     tm1 = STDIO_WTIME();
     ret = __real_fgets(s, size, stream);
     tm2 = STDIO_WTIME();
 
     STDIO_PRE_RECORD();
     if(ret != NULL)
-        STDIO_RECORD_READ(stream, strlen(ret), tm1, tm2);
+        STDIO_RECORD_READ(stream, strlen(ret), tm1, tm2, buffered);
     STDIO_POST_RECORD();
 
     return(ret);
@@ -892,6 +1018,7 @@ void DARSHAN_DECL(rewind)(FILE *stream)
             rec_ref->file_rec->fcounters[STDIO_F_META_TIME],
             tm1, tm2, rec_ref->last_meta_end);
         rec_ref->file_rec->counters[STDIO_SEEKS] += 1;
+        snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
     }
     STDIO_POST_RECORD();
 
@@ -921,6 +1048,7 @@ int DARSHAN_DECL(fseek)(FILE *stream, long offset, int whence)
                 rec_ref->file_rec->fcounters[STDIO_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[STDIO_SEEKS] += 1;
+            snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         STDIO_POST_RECORD();
     }
@@ -951,6 +1079,7 @@ int DARSHAN_DECL(fseeko)(FILE *stream, off_t offset, int whence)
                 rec_ref->file_rec->fcounters[STDIO_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[STDIO_SEEKS] += 1;
+            snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         STDIO_POST_RECORD();
     }
@@ -981,6 +1110,7 @@ int DARSHAN_DECL(fseeko64)(FILE *stream, off64_t offset, int whence)
                 rec_ref->file_rec->fcounters[STDIO_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[STDIO_SEEKS] += 1;
+            snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         STDIO_POST_RECORD();
     }
@@ -1011,6 +1141,7 @@ int DARSHAN_DECL(fsetpos)(FILE *stream, const fpos_t *pos)
                 rec_ref->file_rec->fcounters[STDIO_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[STDIO_SEEKS] += 1;
+            snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         STDIO_POST_RECORD();
     }
@@ -1041,6 +1172,7 @@ int DARSHAN_DECL(fsetpos64)(FILE *stream, const fpos64_t *pos)
                 rec_ref->file_rec->fcounters[STDIO_F_META_TIME],
                 tm1, tm2, rec_ref->last_meta_end);
             rec_ref->file_rec->counters[STDIO_SEEKS] += 1;
+            snapshot_update(stdio_runtime->snapshot_id, SNAPSHOT_SEEKS, 1, tm2);
         }
         STDIO_POST_RECORD();
     }
@@ -1048,6 +1180,89 @@ int DARSHAN_DECL(fsetpos64)(FILE *stream, const fpos64_t *pos)
     return(ret);
 }
 
+int DARSHAN_DECL(setvbuf)(FILE *stream, char *buf, int mode, size_t size)
+{
+    int ret;
+    double tm1, tm2;
+
+    MAP_OR_FAIL(setvbuf);
+
+    tm1 = STDIO_WTIME();
+    ret = __real_setvbuf(stream, buf, mode, size);
+    tm2 = STDIO_WTIME();
+
+    STDIO_PRE_RECORD();
+    if(ret == 0)
+    {
+        if(mode == _IONBF)
+            STDIO_RECORD_SETVBUF(stream, STDIO_BUF_MODE_NONE, 0, tm1, tm2);
+        else
+            STDIO_RECORD_SETVBUF(stream,
+                (mode == _IOLBF) ? STDIO_BUF_MODE_LINE : STDIO_BUF_MODE_FULL,
+                buf ? (int64_t)size : -1, tm1, tm2);
+    }
+    STDIO_POST_RECORD();
+
+    return(ret);
+}
+
+void DARSHAN_DECL(setbuf)(FILE *stream, char *buf)
+{
+    double tm1, tm2;
+
+    MAP_OR_FAIL(setbuf);
+
+    tm1 = STDIO_WTIME();
+    __real_setbuf(stream, buf);
+    tm2 = STDIO_WTIME();
+
+    STDIO_VOID_PRE_RECORD();
+    if(buf)
+        STDIO_RECORD_SETVBUF(stream, STDIO_BUF_MODE_FULL, BUFSIZ, tm1, tm2);
+    else
+        STDIO_RECORD_SETVBUF(stream, STDIO_BUF_MODE_NONE, 0, tm1, tm2);
+    STDIO_POST_RECORD();
+
+    return;
+}
+
+void DARSHAN_DECL(setbuffer)(FILE *stream, char *buf, size_t size)
+{
+    double tm1, tm2;
+
+    MAP_OR_FAIL(setbuffer);
+
+    tm1 = STDIO_WTIME();
+    __real_setbuffer(stream, buf, size);
+    tm2 = STDIO_WTIME();
+
+    STDIO_VOID_PRE_RECORD();
+    if(buf)
+        STDIO_RECORD_SETVBUF(stream, STDIO_BUF_MODE_FULL, (int64_t)size, tm1, tm2);
+    else
+        STDIO_RECORD_SETVBUF(stream, STDIO_BUF_MODE_NONE, 0, tm1, tm2);
+    STDIO_POST_RECORD();
+
+    return;
+}
+
+void DARSHAN_DECL(setlinebuf)(FILE *stream)
+{
+    double tm1, tm2;
+
+    MAP_OR_FAIL(setlinebuf);
+
+    tm1 = STDIO_WTIME();
+    __real_setlinebuf(stream);
+    tm2 = STDIO_WTIME();
+
+    STDIO_VOID_PRE_RECORD();
+    STDIO_RECORD_SETVBUF(stream, STDIO_BUF_MODE_LINE, -1, tm1, tm2);
+    STDIO_POST_RECORD();
+
+    return;
+}
+
 /**********************************************************
  * Internal functions for manipulating STDIO module state *
  **********************************************************/
@@ -1098,6 +1313,9 @@ static void stdio_runtime_initialize()
     /* register a heatmap */
     stdio_runtime->heatmap_id = heatmap_register("heatmap:STDIO");
 
+    /* register a time series of counter snapshots */
+    stdio_runtime->snapshot_id = snapshot_register("snapshot:STDIO");
+
     return;
 }
 
@@ -1144,6 +1362,11 @@ static struct stdio_file_record_ref *stdio_track_new_file_record(
     /* registering this file record was successful, so initialize some fields */
     file_rec->base_rec.id = rec_id;
     file_rec->base_rec.rank = my_rank;
+#ifndef HAVE_STDIO_BUFFER_INTERNALS
+    /* the stdio library's own system calls can not be estimated */
+    file_rec->counters[STDIO_POSIX_READS] = -1;
+    file_rec->counters[STDIO_POSIX_WRITES] = -1;
+#endif
     rec_ref->fs_type = fs_info.fs_type;
     rec_ref->file_rec = file_rec;
     stdio_runtime->file_rec_count++;
@@ -1151,6 +1374,61 @@ static struct stdio_file_record_ref *stdio_track_new_file_record(
     return(rec_ref);
 }
 
+/* update the buffering counters of a STDIO record after 'bytes' bytes were
+ * moved by an operation on stream 'fp'.  'buffered_before' is the buffer
+ * occupancy sampled with STDIO_BUFFERED_IN/OUT before the operation (or -1
+ * to only refresh the observed buffer mode and size).  At most one system
+ * call is counted per stdio operation, so the POSIX_READS and POSIX_WRITES
+ * counters are a lower bound.
+ */
+static void stdio_record_buffering(
+    struct darshan_stdio_file *file_rec, FILE *fp, int rw_flag,
+    int64_t bytes, int64_t buffered_before)
+{
+#ifdef HAVE_STDIO_BUFFER_INTERNALS
+    size_t buf_size;
+
+    if(buffered_before >= 0)
+    {
+        if(rw_flag == DARSHAN_IO_WRITE &&
+           STDIO_BUFFERED_OUT(fp) != buffered_before + bytes)
+            file_rec->counters[STDIO_POSIX_WRITES] += 1;
+        else if(rw_flag == DARSHAN_IO_READ &&
+           STDIO_BUFFERED_IN(fp) != buffered_before - bytes)
+            file_rec->counters[STDIO_POSIX_READS] += 1;
+    }
+
+    /* the buffer is allocated lazily on first use */
+    buf_size = __fbufsize(fp);
+    if(buf_size == 0)
+        return;
+    if(__flbf(fp))
+    {
+        file_rec->counters[STDIO_BUF_MODE] = STDIO_BUF_MODE_LINE;
+        file_rec->counters[STDIO_BUF_SIZE] = buf_size;
+    }
+    else if(buf_size == 1)
+    {
+        /* glibc backs unbuffered streams with a single byte buffer */
+        file_rec->counters[STDIO_BUF_MODE] = STDIO_BUF_MODE_NONE;
+        file_rec->counters[STDIO_BUF_SIZE] = 0;
+    }
+    else
+    {
+        file_rec->counters[STDIO_BUF_MODE] = STDIO_BUF_MODE_FULL;
+        file_rec->counters[STDIO_BUF_SIZE] = buf_size;
+    }
+#else
+    (void)file_rec;
+    (void)fp;
+    (void)rw_flag;
+    (void)bytes;
+    (void)buffered_before;
+#endif
+
+    return;
+}
+
 #ifdef HAVE_MPI
 static void stdio_record_reduction_op(void* infile_v, void* inoutfile_v,
     int *len, MPI_Datatype *datatype)
@@ -1183,6 +1461,32 @@ static void stdio_record_reduction_op(void* infile_v, void* inoutfile_v,
                 tmp_file.counters[j] = inoutfile->counters[j];
         }
 
+        /* sum */
+        tmp_file.counters[STDIO_SETVBUFS] = infile->counters[STDIO_SETVBUFS] +
+            inoutfile->counters[STDIO_SETVBUFS];
+
+        /* sum, unless unknown on either side */
+        for(j=STDIO_POSIX_READS; j<=STDIO_POSIX_WRITES; j++)
+        {
+            if(infile->counters[j] < 0 || inoutfile->counters[j] < 0)
+                tmp_file.counters[j] = -1;
+            else
+                tmp_file.counters[j] = infile->counters[j] + inoutfile->counters[j];
+        }
+
+        /* max (i.e., the most restrictive buffering mode) */
+        if(infile->counters[STDIO_BUF_MODE] > inoutfile->counters[STDIO_BUF_MODE])
+            tmp_file.counters[STDIO_BUF_MODE] = infile->counters[STDIO_BUF_MODE];
+        else
+            tmp_file.counters[STDIO_BUF_MODE] = inoutfile->counters[STDIO_BUF_MODE];
+
+        /* min non-zero (if available) value */
+        if((infile->counters[STDIO_BUF_SIZE] < inoutfile->counters[STDIO_BUF_SIZE] &&
+           infile->counters[STDIO_BUF_SIZE] > 0) || inoutfile->counters[STDIO_BUF_SIZE] == 0)
+            tmp_file.counters[STDIO_BUF_SIZE] = infile->counters[STDIO_BUF_SIZE];
+        else
+            tmp_file.counters[STDIO_BUF_SIZE] = inoutfile->counters[STDIO_BUF_SIZE];
+
         /* sum */
         for(j=STDIO_F_META_TIME; j<=STDIO_F_READ_TIME; j++)
         {
@@ -1259,6 +1563,37 @@ static void stdio_record_reduction_op(void* infile_v, void* inoutfile_v,
     return;
 }
 
+static void stdio_shared_record_imbalance(MPI_Comm mod_comm,
+    struct darshan_stdio_file *inrec_array, int shared_rec_count)
+{
+    struct darshan_imbalance_sample *samples;
+    int i;
+
+    if(!imbalance_enabled())
+        return;
+
+    samples = malloc(shared_rec_count * sizeof(*samples));
+    assert(samples);
+
+    /* hand this rank's i/o time and bytes of each shared record to the
+     * IMBALANCE module, which keeps their distribution across nodes
+     */
+    for(i=0; i<shared_rec_count; i++)
+    {
+        samples[i].id = inrec_array[i].base_rec.id;
+        samples[i].time = inrec_array[i].fcounters[STDIO_F_READ_TIME] +
+                          inrec_array[i].fcounters[STDIO_F_WRITE_TIME] +
+                          inrec_array[i].fcounters[STDIO_F_META_TIME];
+        samples[i].bytes = inrec_array[i].counters[STDIO_BYTES_READ] +
+                           inrec_array[i].counters[STDIO_BYTES_WRITTEN];
+    }
+
+    imbalance_reduce(DARSHAN_STDIO_MOD, mod_comm, samples, shared_rec_count);
+
+    free(samples);
+    return;
+}
+
 static void stdio_shared_record_variance(MPI_Comm mod_comm,
     struct darshan_stdio_file *inrec_array, struct darshan_stdio_file *outrec_array,
     int shared_rec_count)
@@ -1459,6 +1794,9 @@ static void stdio_mpi_redux(
     stdio_shared_record_variance(mod_comm, red_send_buf, red_recv_buf,
         shared_rec_count);
 
+    /* get the distribution of time and bytes across nodes for shared files */
+    stdio_shared_record_imbalance(mod_comm, red_send_buf, shared_rec_count);
+
     /* update module state to account for shared file reduction */
     if(my_rank == 0)
     {
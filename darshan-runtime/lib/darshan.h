@@ -142,6 +142,11 @@ struct darshan_core_runtime
     struct darshan_core_name_record_ref *name_hash;
     size_t name_mem_used;
     char *comp_buf;
+    /* time spent compressing and appending log data at shutdown; only
+     * accumulated when internal timing is enabled
+     */
+    double deflate_time;
+    double append_time;
 #ifdef __DARSHAN_ENABLE_MMAP_LOGS
     char mmap_log_name[__DARSHAN_PATH_MAX];
 #endif
@@ -149,6 +154,7 @@ struct darshan_core_runtime
     MPI_Comm mpi_comm;
 #endif
     int pid;
+    int ppid;
 };
 
 /* core constructs for use in macros and inline functions; the __ prefix
@@ -453,6 +459,33 @@ void darshan_core_fprintf(
 void darshan_core_initialize(int argc, char **argv);
 void darshan_core_shutdown(int write_log);
 
+/* synthetic workload generated by the shutdown benchmark (see
+ * darshan_shutdown_bench()); each participating module creates rec_count
+ * records per process, the first shared_pct percent of which are opened
+ * by every process
+ */
+struct darshan_shutdown_bench_workload
+{
+    int rec_count;
+    int shared_pct;
+    /* DXT trace segments written to each record */
+    int dxt_segs;
+    /* record name lengths are drawn uniformly from this range */
+    int name_len_min;
+    int name_len_max;
+};
+
+/* darshan_shutdown_bench_rec_name()
+ *
+ * Generates the name of the rec_index'th record of a shutdown benchmark
+ * workload into the given buffer of size __DARSHAN_PATH_MAX. Returns 1 if
+ * the record is shared by all processes, 0 otherwise.
+ */
+int darshan_shutdown_bench_rec_name(
+    struct darshan_shutdown_bench_workload *wl,
+    int rec_index,
+    char *name);
+
 uint32_t darshan_hashlittle(const void *key, size_t length, uint32_t initval);
 uint64_t darshan_hash(const register unsigned char *k, register uint64_t length, register uint64_t level);
 
@@ -3,8 +3,17 @@
  *      See COPYRIGHT in top-level directory.
  */
 
-/* Arguments: an integer specifying the number of iterations to run of each
- * test phase
+/* With no arguments, runs a fixed set of file-per-process and shared file
+ * workloads.  Otherwise synthesizes a single workload:
+ *   -r <n>             records per process, for each of POSIX and MPI-IO
+ *   -s <pct>           percentage of records shared by all processes
+ *   -d <n>             DXT segments per record (enables DXT tracing)
+ *   -l <min>[:<max>]   record name length range
+ *   -i <n>             number of times to shut down the workload
+ * -r is required if any of the other options are given.
+ *
+ * Set DARSHAN_INTERNAL_TIMING to get the per-phase shutdown timing and
+ * memory high-water marks; see run-shutdown-bench.sh.
  */
 
 #include <stdio.h>
@@ -26,9 +35,11 @@ int main(int argc, char **argv)
 {
     MPI_Init(&argc, &argv);
 
-    if(argc != 1)
+    if(argc > 1 && argv[1][0] != '-')
     {
-        fprintf(stderr, "Usage: %s\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-r <records> [-s <shared pct>] "
+            "[-d <dxt segments>] [-l <min>[:<max>]] [-i <iterations>]]\n",
+            argv[0]);
         MPI_Finalize();
         return(-1);
     }
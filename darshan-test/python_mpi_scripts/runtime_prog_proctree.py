@@ -0,0 +1,33 @@
+#!/usr/bin/env python
+
+import os
+import sys
+import subprocess
+
+def write_file(name, nbytes):
+    with open(name, "w") as f:
+        f.write("x" * nbytes)
+
+def fork_child(name, nbytes):
+    pid = os.fork()
+    if pid == 0:
+        write_file(name, nbytes)
+        os._exit(0)
+    os.waitpid(pid, 0)
+
+def workflow():
+    # the workflow root writes a file, forks a child and spawns another
+    # python process, which forks a grandchild of its own
+    write_file("./root", 1)
+    fork_child("./forked-child", 2)
+    subprocess.check_call([sys.executable, __file__, "spawned"])
+
+def spawned():
+    write_file("./spawned-child", 4)
+    fork_child("./forked-grandchild", 8)
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1 and sys.argv[1] == "spawned":
+        spawned()
+    else:
+        workflow()
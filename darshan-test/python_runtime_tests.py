@@ -231,3 +231,44 @@ def test_forked_process_mpi(tmpdir):
     # regression test for gh-786, mpi version
     darshan_install_path = os.environ.get("DARSHAN_INSTALL_PATH")
     do_forked_process_test(tmpdir, darshan_install_path)
+
+def test_process_tree_nonmpi(tmpdir):
+    # the logs of a forked and spawned non-MPI workflow are linked into
+    # a single process tree
+    from darshan.lib.proctree import (read_process_info, process_tree,
+                                      critical_path)
+    root_path = os.environ.get("DARSHAN_ROOT_PATH")
+    darshan_install_path = os.environ.get("DARSHAN_NONMPI_INSTALL_PATH")
+    test_script_path = os.path.join(root_path,
+                                    "darshan-test",
+                                    "python_mpi_scripts",
+                                    "runtime_prog_proctree.py")
+    darshan_lib_path = os.path.join(darshan_install_path,
+                                    "lib",
+                                    "libdarshan.so")
+
+    with tmpdir.as_cwd():
+        cwd = os.getcwd()
+        python_exe = sys.executable
+        subprocess.check_output([
+                     python_exe,
+                     f"{test_script_path}"],
+                     env={'LD_PRELOAD': darshan_lib_path,
+                          'DARSHAN_ENABLE_NONMPI': "1",
+                          'DARSHAN_LOGPATH': cwd})
+
+        log_file_list = glob.glob("*.darshan")
+        # root, forked child, spawned child and forked grandchild
+        assert len(log_file_list) == 4
+        infos, errors = read_process_info(log_file_list)
+        assert not errors
+        tree = process_tree(infos)
+        assert list(tree["parent"]) == [-1, 0, 0, 2]
+        assert list(tree["depth"]) == [0, 1, 1, 2]
+        assert list(tree["forked"]) == [False, True, False, True]
+        root = tree.iloc[0]
+        assert root["subtree_procs"] == 4
+        assert root["subtree_bytes_written"] == 1 + 2 + 4 + 8
+        # the root waits for all of its descendants
+        assert critical_path(tree, 0) == [0]
+        assert root["critical_path_time"] >= tree.iloc[2]["critical_path_time"]
@@ -0,0 +1,115 @@
+#!/bin/bash
+
+PROG=custom-counter-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC -I$DARSHAN_RUNTIME_PATH/include $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG} -lpthread
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -t 4 -i 1000
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# skip the remaining checks if Darshan was built without the CUSTOM module
+if ! grep -q "^CUSTOM" $DARSHAN_TMP/${PROG}.darshan.txt; then
+    echo "Warning: Darshan was built without the CUSTOM module, skipping counter checks" 1>&2
+    exit 0
+fi
+
+# look up a counter value for the given counter name and record name
+custom_counter() {
+    grep "^CUSTOM" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "	$1	" | grep -F "	$2	" | cut -f 5
+}
+
+# 4 threads on each rank each incremented the shared counter 1000 times
+CUSTOM_INT_VALUE=`custom_counter CUSTOM_INT_VALUE app.checkpoints`
+if [ ! "$CUSTOM_INT_VALUE" -eq $((DARSHAN_DEFAULT_NPROCS*4000)) ]; then
+    echo "Error: checkpoint counter value of $CUSTOM_INT_VALUE is incorrect" 1>&2
+    exit 1
+fi
+CUSTOM_INT_UPDATES=`custom_counter CUSTOM_INT_UPDATES app.checkpoints`
+if [ ! "$CUSTOM_INT_UPDATES" -eq $((DARSHAN_DEFAULT_NPROCS*4000)) ]; then
+    echo "Error: checkpoint counter update count of $CUSTOM_INT_UPDATES is incorrect" 1>&2
+    exit 1
+fi
+CUSTOM_RANKS=`custom_counter CUSTOM_RANKS app.checkpoints`
+if [ ! "$CUSTOM_RANKS" -eq $DARSHAN_DEFAULT_NPROCS ]; then
+    echo "Error: checkpoint counter rank count of $CUSTOM_RANKS is incorrect" 1>&2
+    exit 1
+fi
+CUSTOM_F_VALUE=`custom_counter CUSTOM_F_VALUE app.stage_seconds`
+if [ "$CUSTOM_F_VALUE" != "$((DARSHAN_DEFAULT_NPROCS*2000)).000000" ]; then
+    echo "Error: staging time counter value of $CUSTOM_F_VALUE is incorrect" 1>&2
+    exit 1
+fi
+
+# each rank added (rank+1)*100 to the per-rank counter
+CUSTOM_INT_RANK_MIN=`custom_counter CUSTOM_INT_RANK_MIN app.rank_bytes`
+if [ ! "$CUSTOM_INT_RANK_MIN" -eq 100 ]; then
+    echo "Error: per-rank minimum of $CUSTOM_INT_RANK_MIN is incorrect" 1>&2
+    exit 1
+fi
+CUSTOM_INT_RANK_MAX=`custom_counter CUSTOM_INT_RANK_MAX app.rank_bytes`
+if [ ! "$CUSTOM_INT_RANK_MAX" -eq $((DARSHAN_DEFAULT_NPROCS*100)) ]; then
+    echo "Error: per-rank maximum of $CUSTOM_INT_RANK_MAX is incorrect" 1>&2
+    exit 1
+fi
+
+# the counter registered only by rank 0 is not reduced
+CUSTOM_RANK=`grep "^CUSTOM" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "	CUSTOM_INT_VALUE	" | grep -F "	app.rank0_only	" | cut -f 2`
+if [ ! "$CUSTOM_RANK" -eq 0 ]; then
+    echo "Error: rank of unshared counter ($CUSTOM_RANK) is incorrect" 1>&2
+    exit 1
+fi
+CUSTOM_INT_VALUE=`custom_counter CUSTOM_INT_VALUE app.rank0_only`
+if [ ! "$CUSTOM_INT_VALUE" -eq 7 ]; then
+    echo "Error: unshared counter value of $CUSTOM_INT_VALUE is incorrect" 1>&2
+    exit 1
+fi
+
+# counter names are subject to NAME_EXCLUDE rules for the CUSTOM module
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}-exclude.darshan
+rm -f ${DARSHAN_LOGFILE}
+export DARSHAN_CONFIG_PATH=$DARSHAN_TMP/${PROG}.conf
+echo "NAME_EXCLUDE ^app\.rank0 CUSTOM" > $DARSHAN_CONFIG_PATH
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -t 1 -i 10
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG} with excluded counters" 1>&2
+    exit 1
+fi
+unset DARSHAN_CONFIG_PATH
+
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}-exclude.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+if grep "^CUSTOM" $DARSHAN_TMP/${PROG}-exclude.darshan.txt | grep -qF "	app.rank0_only	"; then
+    echo "Error: excluded counter app.rank0_only was recorded" 1>&2
+    exit 1
+fi
+if ! grep "^CUSTOM" $DARSHAN_TMP/${PROG}-exclude.darshan.txt | grep -qF "	app.checkpoints	"; then
+    echo "Error: counter app.checkpoints was not recorded with exclusions set" 1>&2
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,56 @@
+#!/bin/bash
+
+PROG=hdf5-chunk-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile; skip this test if HDF5 is not available on this system
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG} -lhdf5
+if [ $? -ne 0 ]; then
+    echo "Warning: unable to compile ${PROG} (is HDF5 installed?), skipping" 1>&2
+    exit 0
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.h5
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# Darshan must be built with the HDF5 module for these counters to be set;
+# skip the remaining checks if it wasn't
+if ! grep -vE "^#" $DARSHAN_TMP/${PROG}.darshan.txt | grep -q H5D_OPENS; then
+    echo "Warning: Darshan was built without HDF5 support, skipping counter checks" 1>&2
+    exit 0
+fi
+
+check_counter() {
+    VAL=`grep $1 $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.h5 | cut -f 5`
+    if [ ! "$VAL" -eq $2 ]; then
+        echo "Error: $1 value of $VAL is incorrect (expected $2)" 1>&2
+        exit 1
+    fi
+}
+
+check_counter H5D_OPENS 2
+check_counter H5D_FILTERS 2
+check_counter H5D_COMPRESSION 1
+check_counter H5D_CHUNK_CACHE_NBYTES 4000
+check_counter H5D_CHUNK_CACHE_NSLOTS 101
+check_counter H5D_CHUNKS_WRITTEN 100
+check_counter H5D_CHUNKS_READ 100
+check_counter H5D_CHUNK_CACHE_OVERFLOWS 1
+
+exit 0
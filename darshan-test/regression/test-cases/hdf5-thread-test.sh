@@ -0,0 +1,65 @@
+#!/bin/bash
+
+PROG=hdf5-thread-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile; skip this test if HDF5 is not available on this system
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG} -lhdf5 -lpthread
+if [ $? -ne 0 ]; then
+    echo "Warning: unable to compile ${PROG} (is HDF5 installed?), skipping" 1>&2
+    exit 0
+fi
+
+# execute; phases run with 1, 2, and 4 threads
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.h5 -t 4 -i 100
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# Darshan must be built with the HDF5 module for these counters to be set;
+# skip the remaining checks if it wasn't
+if ! grep -vE "^#" $DARSHAN_TMP/${PROG}.darshan.txt | grep -q H5D_OPENS; then
+    echo "Warning: Darshan was built without HDF5 support, skipping counter checks" 1>&2
+    exit 0
+fi
+
+# look up a counter value for the given counter name and dataset name
+check_counter() {
+    VAL=`grep -vE "^#" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "	$1	" | grep -F "${PROG}.tmp.h5:/$2	" | cut -f 5`
+    if [ ! "$VAL" -eq $3 ]; then
+        echo "Error: $1 value of $VAL for dataset $2 is incorrect (expected $3)" 1>&2
+        exit 1
+    fi
+}
+
+# the shared dataset is opened once and read 100 times by each thread of
+# each phase, 7 threads in total (and opened once more when it is
+# created); no updates may be lost to races
+check_counter H5D_OPENS shared 8
+check_counter H5D_READS shared 700
+check_counter H5D_BYTES_READ shared $((700*64*8))
+
+# thread N's dataset is used in every phase with more than N threads, and
+# is also opened and written once when it is created
+check_counter H5D_OPENS thread0 4
+check_counter H5D_WRITES thread0 301
+check_counter H5D_READS thread0 300
+check_counter H5D_WRITES thread1 201
+check_counter H5D_READS thread1 200
+check_counter H5D_WRITES thread3 101
+check_counter H5D_READS thread3 100
+
+exit 0
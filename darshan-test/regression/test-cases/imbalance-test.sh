@@ -0,0 +1,89 @@
+#!/bin/bash
+
+PROG=imbalance-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute with distributions taken across ranks, since the test may run on
+# a single node; the last process writes 8 blocks of 1000 bytes to the
+# shared file and every other process writes 1
+export DARSHAN_MOD_ENABLE=IMBALANCE
+export DARSHAN_IMBALANCE_UNIT=rank
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat -n 8 -b 1000
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# skip the remaining checks if Darshan was built without the IMBALANCE module
+if ! grep -q "^IMBALANCE" $DARSHAN_TMP/${PROG}.darshan.txt; then
+    echo "Warning: Darshan was built without the IMBALANCE module, skipping imbalance checks" 1>&2
+    exit 0
+fi
+
+# value of a counter of the IMBALANCE record of the shared file
+imbalance_counter() {
+    grep "^IMBALANCE" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "${PROG}.tmp.dat" | awk -F'\t' -v c=$1 '$4 == c {print $5}'
+}
+
+UNITS=`imbalance_counter IMBALANCE_UNITS`
+if [ ! "$UNITS" -eq $DARSHAN_DEFAULT_NPROCS ]; then
+    echo "Error: IMBALANCE_UNITS of $UNITS is incorrect (expected $DARSHAN_DEFAULT_NPROCS)" 1>&2
+    exit 1
+fi
+
+MAX_BYTES=`imbalance_counter IMBALANCE_MAX_BYTES`
+if [ ! "$MAX_BYTES" -eq 8000 ]; then
+    echo "Error: IMBALANCE_MAX_BYTES of $MAX_BYTES is incorrect (expected 8000)" 1>&2
+    exit 1
+fi
+
+# the straggler is alone in the last bytes bin, and the other processes,
+# with 1/8 of its bytes, all fall in bin 2
+BIN=`imbalance_counter IMBALANCE_BYTES_BIN_15`
+if [ ! "$BIN" -eq 1 ]; then
+    echo "Error: IMBALANCE_BYTES_BIN_15 of $BIN is incorrect (expected 1)" 1>&2
+    exit 1
+fi
+BIN=`imbalance_counter IMBALANCE_BYTES_BIN_2`
+if [ ! "$BIN" -eq $((DARSHAN_DEFAULT_NPROCS-1)) ]; then
+    echo "Error: IMBALANCE_BYTES_BIN_2 of $BIN is incorrect (expected $((DARSHAN_DEFAULT_NPROCS-1)))" 1>&2
+    exit 1
+fi
+
+# every process is counted once in the time histogram
+TOTAL=`grep "^IMBALANCE" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "${PROG}.tmp.dat" | awk -F'\t' 'index($4, "IMBALANCE_TIME_BIN_") == 1 {s += $5} END {print s+0}'`
+if [ ! "$TOTAL" -eq $DARSHAN_DEFAULT_NPROCS ]; then
+    echo "Error: IMBALANCE_TIME_BIN_* total of $TOTAL is incorrect (expected $DARSHAN_DEFAULT_NPROCS)" 1>&2
+    exit 1
+fi
+
+# the slowest ranks must be distinct, valid ranks
+RANK1=`imbalance_counter IMBALANCE_SLOWEST_1_RANK`
+RANK2=`imbalance_counter IMBALANCE_SLOWEST_2_RANK`
+if [ "$RANK1" -lt 0 ] || [ "$RANK1" -ge $DARSHAN_DEFAULT_NPROCS ] || \
+   [ "$RANK2" -lt 0 ] || [ "$RANK2" -ge $DARSHAN_DEFAULT_NPROCS ] || \
+   [ "$RANK1" -eq "$RANK2" ]; then
+    echo "Error: IMBALANCE_SLOWEST_1_RANK ($RANK1) and IMBALANCE_SLOWEST_2_RANK ($RANK2) are incorrect" 1>&2
+    exit 1
+fi
+
+exit 0
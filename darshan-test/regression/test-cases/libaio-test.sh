@@ -0,0 +1,64 @@
+#!/bin/bash
+
+PROG=libaio-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile; skip this test if libaio is not available on this system
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG} -laio
+if [ $? -ne 0 ]; then
+    echo "Warning: unable to compile ${PROG} (is libaio installed?), skipping" 1>&2
+    exit 0
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# Darshan must be built with libaio support for these counters to be set;
+# skip the remaining checks if it wasn't
+POSIX_AIO_WRITES=`grep POSIX_AIO_WRITES $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if [ "$POSIX_AIO_WRITES" -eq 0 ]; then
+    echo "Warning: Darshan was built without libaio support, skipping counter checks" 1>&2
+    exit 0
+fi
+if [ ! "$POSIX_AIO_WRITES" -eq 4 ]; then
+    echo "Error: POSIX aio write count of $POSIX_AIO_WRITES is incorrect" 1>&2
+    exit 1
+fi
+POSIX_AIO_READS=`grep POSIX_AIO_READS $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if [ ! "$POSIX_AIO_READS" -eq 4 ]; then
+    echo "Error: POSIX aio read count of $POSIX_AIO_READS is incorrect" 1>&2
+    exit 1
+fi
+POSIX_BYTES_WRITTEN=`grep POSIX_BYTES_WRITTEN $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if [ ! "$POSIX_BYTES_WRITTEN" -eq 16384 ]; then
+    echo "Error: POSIX bytes written count of $POSIX_BYTES_WRITTEN is incorrect" 1>&2
+    exit 1
+fi
+POSIX_BYTES_READ=`grep POSIX_BYTES_READ $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if [ ! "$POSIX_BYTES_READ" -eq 16384 ]; then
+    echo "Error: POSIX bytes read count of $POSIX_BYTES_READ is incorrect" 1>&2
+    exit 1
+fi
+POSIX_F_WRITE_TIME=`grep POSIX_F_WRITE_TIME $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if [ ! $(echo "$POSIX_F_WRITE_TIME > 0" | bc -l) ]; then
+    echo "Error: counter is incorrect" 1>&2
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,54 @@
+#!/bin/bash
+
+PROG=mpi-io-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}-dxt-fields.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# enable dxt tracing, recording only offsets and lengths of segments
+export DXT_ENABLE_IO_TRACE=
+export DARSHAN_DXT_FIELDS=offset,length
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+unset DXT_ENABLE_IO_TRACE
+unset DARSHAN_DXT_FIELDS
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-dxt-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}-dxt-fields.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# segments are traced for both DXT modules
+for MOD in X_POSIX X_MPIIO; do
+    if ! grep -q "^ *$MOD " $DARSHAN_TMP/${PROG}-dxt-fields.darshan.txt; then
+        echo "Error: no $MOD segments found in ${DARSHAN_LOGFILE}" 1>&2
+        exit 1
+    fi
+done
+
+# lengths are recorded, while start and end times read back as -1
+BAD=`awk '$1 ~ /^X_/ && ($6 <= 0 || $7 != -1 || $8 != -1)' $DARSHAN_TMP/${PROG}-dxt-fields.darshan.txt | wc -l`
+if [ ! "$BAD" -eq 0 ]; then
+    echo "Error: $BAD segments have unexpected lengths or times in ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,58 @@
+#!/bin/bash
+
+PROG=mpiio-nb-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# enable nonblocking request completion tracking
+export DARSHAN_MPIIO_NB_COMPLETION=1
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+check_counter() {
+    VAL=`grep $1 $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+    if [ ! "$VAL" -eq $2 ]; then
+        echo "Error: $1 value of $VAL is incorrect (expected $2)" 1>&2
+        exit 1
+    fi
+}
+
+# the freed write request is never counted as completed, nor is the
+# point-to-point request completed after it
+check_counter MPIIO_NB_WRITES 5
+check_counter MPIIO_NB_READS 4
+check_counter MPIIO_NB_WRITE_COMPLETIONS 4
+check_counter MPIIO_NB_READ_COMPLETIONS 4
+
+# the test "computes" for at least 0.1 seconds between posting and
+# completing each batch of requests
+MPIIO_F_NB_OVERLAP_TIME=`grep MPIIO_F_NB_OVERLAP_TIME $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if ! awk "BEGIN { exit !($MPIIO_F_NB_OVERLAP_TIME >= 0.1) }"; then
+    echo "Error: MPIIO_F_NB_OVERLAP_TIME value of $MPIIO_F_NB_OVERLAP_TIME is incorrect" 1>&2
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,96 @@
+#!/bin/bash
+
+PROG=nfs-mountstats-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# point the NFS module at a scratch copy of the initial mountstats fixture;
+# the test program swaps in the final fixture before shutting down
+export DARSHAN_NFS_MOUNTSTATS_PATH=$DARSHAN_TMP/${PROG}.mountstats
+cp $DARSHAN_TESTDIR/test-cases/src/nfs-mountstats-start.txt $DARSHAN_NFS_MOUNTSTATS_PATH
+if [ $? -ne 0 ]; then
+    echo "Error: failed to copy mountstats fixture" 1>&2
+    exit 1
+fi
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -e $DARSHAN_TESTDIR/test-cases/src/nfs-mountstats-end.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# skip the remaining checks if Darshan was built without the NFS module
+if ! grep -q "^NFS" $DARSHAN_TMP/${PROG}.darshan.txt; then
+    echo "Warning: Darshan was built without the NFS module, skipping counter checks" 1>&2
+    exit 0
+fi
+
+# mounts without any activity between the two snapshots are not recorded
+if grep "^NFS" $DARSHAN_TMP/${PROG}.darshan.txt | grep -q "/proj"; then
+    echo "Error: idle NFS mount /proj should not be recorded" 1>&2
+    exit 1
+fi
+
+# all ranks ran on one node, so expect a single /home record (per-node
+# deltas are not summed across the ranks sharing the node)
+NFS_PROCS=`grep NFS_PROCS $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_PROCS" -eq $DARSHAN_DEFAULT_NPROCS ]; then
+    echo "Error: NFS process count of $NFS_PROCS is incorrect" 1>&2
+    exit 1
+fi
+NFS_VERSION=`grep NFS_VERSION $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_VERSION" -eq 4 ]; then
+    echo "Error: NFS version of $NFS_VERSION is incorrect" 1>&2
+    exit 1
+fi
+NFS_GETATTR_OPS=`grep NFS_GETATTR_OPS $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_GETATTR_OPS" -eq 1000 ]; then
+    echo "Error: NFS GETATTR count of $NFS_GETATTR_OPS is incorrect" 1>&2
+    exit 1
+fi
+NFS_GETATTR_RETRANS=`grep NFS_GETATTR_RETRANS $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_GETATTR_RETRANS" -eq 2 ]; then
+    echo "Error: NFS GETATTR retransmission count of $NFS_GETATTR_RETRANS is incorrect" 1>&2
+    exit 1
+fi
+NFS_RPC_OPS=`grep NFS_RPC_OPS $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_RPC_OPS" -eq 1110 ]; then
+    echo "Error: NFS RPC count of $NFS_RPC_OPS is incorrect" 1>&2
+    exit 1
+fi
+NFS_INODE_REVALIDATES=`grep NFS_INODE_REVALIDATES $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_INODE_REVALIDATES" -eq 1000 ]; then
+    echo "Error: NFS inode revalidation count of $NFS_INODE_REVALIDATES is incorrect" 1>&2
+    exit 1
+fi
+NFS_SERVER_READ_BYTES=`grep NFS_SERVER_READ_BYTES $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ ! "$NFS_SERVER_READ_BYTES" -eq 4194304 ]; then
+    echo "Error: NFS server read byte count of $NFS_SERVER_READ_BYTES is incorrect" 1>&2
+    exit 1
+fi
+NFS_F_GETATTR_RTT_TIME=`grep NFS_F_GETATTR_RTT_TIME $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep /home | cut -f 5`
+if [ "$NFS_F_GETATTR_RTT_TIME" != "1.000000" ]; then
+    echo "Error: NFS GETATTR round trip time of $NFS_F_GETATTR_RTT_TIME is incorrect" 1>&2
+    exit 1
+fi
+
+exit 0
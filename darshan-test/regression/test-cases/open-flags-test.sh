@@ -0,0 +1,49 @@
+#!/bin/bash
+
+PROG=open-flags-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results; rank 0 creates the file and every process reopens it
+# O_APPEND|O_DSYNC, then clears O_APPEND with fcntl(F_SETFL)
+check_counter()
+{
+    VAL=`grep -E "$1\s" $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+    if [ ! "$VAL" -eq "$2" ]; then
+        echo "Error: $1 of $VAL is incorrect (expected $2)" 1>&2
+        exit 1
+    fi
+}
+
+check_counter POSIX_OPENS $((DARSHAN_DEFAULT_NPROCS+1))
+check_counter POSIX_OPENS_CREAT 1
+check_counter POSIX_OPENS_TRUNC 1
+check_counter POSIX_OPENS_APPEND $DARSHAN_DEFAULT_NPROCS
+check_counter POSIX_OPENS_DSYNC $DARSHAN_DEFAULT_NPROCS
+check_counter POSIX_OPENS_SYNC 0
+check_counter POSIX_SETFLS $DARSHAN_DEFAULT_NPROCS
+
+exit 0
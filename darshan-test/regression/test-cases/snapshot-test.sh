@@ -0,0 +1,81 @@
+#!/bin/bash
+
+PROG=snapshot-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute with counter snapshots enabled; the program sleeps 300 ms between
+# 4 iterations, each writing 1000 bytes per process, so every iteration
+# falls in its own 100 ms snapshot interval
+export DARSHAN_MOD_ENABLE=SNAPSHOT
+export DARSHAN_SNAPSHOT_INTERVAL=0.1
+export DARSHAN_SNAPSHOT_COUNTERS=OPENS,STATS,FSYNCS,WRITES,BYTES_WRITTEN
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat -i 4 -s 300 -b 1000
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+
+# skip the remaining checks if Darshan was built without the SNAPSHOT module
+if ! grep -q "^SNAPSHOT" $DARSHAN_TMP/${PROG}.darshan.txt; then
+    echo "Warning: Darshan was built without the SNAPSHOT module, skipping snapshot checks" 1>&2
+    exit 0
+fi
+
+# sum a POSIX counter over all records
+posix_total() {
+    grep "^POSIX" $DARSHAN_TMP/${PROG}.darshan.txt | awk -F'\t' -v c=$1 '$4 == c {s += $5} END {print s+0}'
+}
+
+# sum the POSIX snapshots of a counter over all ranks and intervals
+snapshot_total() {
+    grep "^SNAPSHOT" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "snapshot:POSIX" | awk -F'\t' -v c=$1 'index($4, c "_") == 1 && substr($4, length(c) + 2) ~ /^[0-9]+$/ {s += $5} END {print s+0}'
+}
+
+for counter in OPENS STATS FSYNCS WRITES BYTES_WRITTEN; do
+    expected=`posix_total POSIX_${counter}`
+    actual=`snapshot_total SNAPSHOT_${counter}`
+    if [ ! "$actual" -eq "$expected" ]; then
+        echo "Error: SNAPSHOT_${counter} total of $actual is incorrect (expected $expected)" 1>&2
+        exit 1
+    fi
+done
+
+BYTES=`snapshot_total SNAPSHOT_BYTES_WRITTEN`
+if [ ! "$BYTES" -ge $((DARSHAN_DEFAULT_NPROCS*4*1000)) ]; then
+    echo "Error: SNAPSHOT_BYTES_WRITTEN total of $BYTES is incorrect (expected at least $((DARSHAN_DEFAULT_NPROCS*4*1000)))" 1>&2
+    exit 1
+fi
+
+# counters that were not selected must not be captured
+if grep "^SNAPSHOT" $DARSHAN_TMP/${PROG}.darshan.txt | grep -q "SNAPSHOT_READS_"; then
+    echo "Error: SNAPSHOT_READS captured although it was not selected" 1>&2
+    exit 1
+fi
+
+# each process should have one POSIX snapshot per iteration
+NSNAPS=`grep "^SNAPSHOT" $DARSHAN_TMP/${PROG}.darshan.txt | grep -F "snapshot:POSIX" | grep -c "SNAPSHOT_F_TIME_"`
+if [ ! "$NSNAPS" -ge $((DARSHAN_DEFAULT_NPROCS*4)) ]; then
+    echo "Error: $NSNAPS POSIX snapshots recorded (expected at least $((DARSHAN_DEFAULT_NPROCS*4)))" 1>&2
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+/* Exercises the Darshan CUSTOM module: every rank registers a set of
+ * shared counters and updates them from several threads at once, and
+ * rank 0 also registers a counter of its own.  Darshan is looked up
+ * through weak symbols so that the test also works with LD_PRELOAD.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+#include <mpi.h>
+#include <getopt.h>
+
+#define DARSHAN_CUSTOM_WEAK
+#include <darshan-custom.h>
+
+/* DEFAULT VALUES FOR OPTIONS */
+static int opt_threads = 4;
+static int opt_iters = 1000;
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static void *thread_fn(void *arg);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+static darshan_custom_counter ckpt_counter;
+static darshan_custom_counter stage_counter;
+
+int main(int argc, char **argv)
+{
+   pthread_t *threads;
+   darshan_custom_counter counter;
+   int provided;
+   int i;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if(!darshan_custom_register)
+   {
+      if(mynod == 0)
+         fprintf(stderr, "Warning: Darshan CUSTOM module not available.\n");
+      MPI_Finalize();
+      return(0);
+   }
+
+   /* shared counters updated concurrently by all threads */
+   ckpt_counter = darshan_custom_register("app.checkpoints");
+   stage_counter = darshan_custom_register("app.stage_seconds");
+   if(ckpt_counter == DARSHAN_CUSTOM_INVALID ||
+      stage_counter == DARSHAN_CUSTOM_INVALID)
+   {
+      fprintf(stderr, "Error: failed to register counters.\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   threads = malloc(opt_threads * sizeof(*threads));
+   if(!threads)
+   {
+      perror("malloc");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   for(i = 0; i < opt_threads; i++)
+      pthread_create(&threads[i], NULL, thread_fn, NULL);
+   for(i = 0; i < opt_threads; i++)
+      pthread_join(threads[i], NULL);
+   free(threads);
+
+   /* shared counter with a different value on each rank */
+   counter = darshan_custom_register("app.rank_bytes");
+   darshan_custom_add_int(counter, (mynod + 1) * 100);
+
+   /* counter that only exists on rank 0 */
+   if(mynod == 0)
+   {
+      counter = darshan_custom_register("app.rank0_only");
+      darshan_custom_add_int(counter, 7);
+      darshan_custom_add_float(counter, 0.25);
+   }
+
+   /* updates through an invalid handle are ignored */
+   darshan_custom_add_int(DARSHAN_CUSTOM_INVALID, 1);
+
+   MPI_Finalize();
+   return(0);
+}
+
+static void *thread_fn(void *arg)
+{
+   darshan_custom_counter counter;
+   int i;
+
+   /* registering an existing name returns the same handle */
+   counter = darshan_custom_register("app.checkpoints");
+   if(counter != ckpt_counter)
+   {
+      fprintf(stderr, "Error: counter handle mismatch.\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   for(i = 0; i < opt_iters; i++)
+   {
+      darshan_custom_add_int(counter, 1);
+      darshan_custom_add_float(stage_counter, 0.5);
+   }
+
+   return(NULL);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+
+   while ((c = getopt(argc, argv, "t:i:")) != EOF) {
+      switch (c) {
+         case 't': /* threads per rank */
+            opt_threads = atoi(optarg);
+            break;
+         case 'i': /* increments per thread */
+            opt_iters = atoi(optarg);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+               usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+   fprintf(stderr, "Usage: custom-counter-test [-t threads] [-i iterations]\n");
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+/* Exercises the H5D chunk cache and filter counters. Rank 0 writes a
+ * 100x100 dataset of doubles stored in 10x10 compressed chunks, then reads
+ * every 20th row back twice: once with the default chunk cache and once
+ * after reopening the dataset with a chunk cache too small to hold the
+ * chunks touched by the read.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi.h>
+#include <getopt.h>
+#include <hdf5.h>
+
+#define DIM 100
+#define CHUNK_DIM 10
+#define ROW_STRIDE 20
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.h5";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static int run_test(void);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   int ret = 0;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if(mynod == 0)
+      ret = run_test();
+   MPI_Bcast(&ret, 1, MPI_INT, 0, MPI_COMM_WORLD);
+   if(ret != 0)
+   {
+      if(mynod == 0)
+         fprintf(stderr, "Error: HDF5 operations on %s failed.\n", opt_file);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   MPI_Finalize();
+   return(0);
+}
+
+static int run_test(void)
+{
+   hsize_t dims[2] = {DIM, DIM};
+   hsize_t chunk_dims[2] = {CHUNK_DIM, CHUNK_DIM};
+   hsize_t start[2] = {0, 0};
+   hsize_t stride[2] = {ROW_STRIDE, 1};
+   hsize_t count[2] = {DIM / ROW_STRIDE, 1};
+   hsize_t block[2] = {1, DIM};
+   hsize_t mem_dims[1] = {(DIM / ROW_STRIDE) * DIM};
+   static double buf[DIM * DIM];
+   hid_t file_id, space_id, mem_space_id, dcpl_id, dapl_id, dset_id;
+   herr_t err = 0;
+   int i;
+
+   for(i = 0; i < DIM * DIM; i++)
+      buf[i] = i;
+
+   file_id = H5Fcreate(opt_file, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+   if(file_id < 0)
+      return(-1);
+   space_id = H5Screate_simple(2, dims, NULL);
+   mem_space_id = H5Screate_simple(1, mem_dims, NULL);
+
+   /* shuffle + deflate pipeline */
+   dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+   H5Pset_chunk(dcpl_id, 2, chunk_dims);
+   H5Pset_shuffle(dcpl_id);
+   H5Pset_deflate(dcpl_id, 4);
+
+   /* whole dataset write touches all 100 chunks */
+   dset_id = H5Dcreate2(file_id, "chunked", H5T_NATIVE_DOUBLE, space_id,
+      H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+   if(dset_id < 0)
+      return(-1);
+   err |= H5Dwrite(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+      H5P_DEFAULT, buf);
+
+   /* every 20th row touches 5 rows of 10 chunks each */
+   err |= H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, stride,
+      count, block);
+   err |= H5Dread(dset_id, H5T_NATIVE_DOUBLE, mem_space_id, space_id,
+      H5P_DEFAULT, buf);
+   err |= H5Dclose(dset_id);
+
+   /* a 4000 byte cache cannot hold even five 800 byte chunks */
+   dapl_id = H5Pcreate(H5P_DATASET_ACCESS);
+   H5Pset_chunk_cache(dapl_id, 101, 4000, 0.75);
+   dset_id = H5Dopen2(file_id, "chunked", dapl_id);
+   if(dset_id < 0)
+      return(-1);
+   err |= H5Dread(dset_id, H5T_NATIVE_DOUBLE, mem_space_id, space_id,
+      H5P_DEFAULT, buf);
+   err |= H5Dclose(dset_id);
+
+   H5Pclose(dapl_id);
+   H5Pclose(dcpl_id);
+   H5Sclose(mem_space_id);
+   H5Sclose(space_id);
+   err |= H5Fclose(file_id);
+
+   return(err < 0 ? -1 : 0);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+
+   while ((c = getopt(argc, argv, "f:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: hdf5-chunk-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: test.h5]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
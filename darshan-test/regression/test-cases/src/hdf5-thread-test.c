@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+/* Exercises the H5D module from multiple threads.  Rank 0 creates one
+ * dataset per thread plus a dataset shared by all threads, then runs a
+ * series of phases with increasing thread counts (1, 2, 4, ... up to the
+ * requested number of threads).  In each phase every thread opens its own
+ * dataset and the shared one, writes and reads hyperslabs of its own
+ * dataset, and reads a hyperslab of the shared dataset.  The elapsed time of
+ * each phase is reported so that the scaling of the instrumented calls can
+ * be compared across thread counts.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <mpi.h>
+#include <getopt.h>
+#include <hdf5.h>
+
+#define DIM 1024
+#define SEL_LEN 64
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.h5";
+static int     opt_threads = 4;
+static int     opt_iters = 100;
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static int run_test(void);
+static int run_phase(int nthreads, double *elapsed);
+static void *thread_fn(void *arg);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+static hid_t file_id = -1;
+
+/* serializes HDF5 calls if the library was not built thread-safe, in which
+ * case the test still checks the counters but not concurrent updates
+ */
+static hbool_t threadsafe = 0;
+static pthread_mutex_t hdf5_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define TEST_HDF5_LOCK() do { \
+   if(!threadsafe) pthread_mutex_lock(&hdf5_mutex); \
+} while(0)
+#define TEST_HDF5_UNLOCK() do { \
+   if(!threadsafe) pthread_mutex_unlock(&hdf5_mutex); \
+} while(0)
+
+struct thread_args
+{
+   int id;
+   int err;
+};
+
+int main(int argc, char **argv)
+{
+   int provided;
+   int ret = 0;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if(mynod == 0)
+      ret = run_test();
+   MPI_Bcast(&ret, 1, MPI_INT, 0, MPI_COMM_WORLD);
+   if(ret != 0)
+   {
+      if(mynod == 0)
+         fprintf(stderr, "Error: HDF5 operations on %s failed.\n", opt_file);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   MPI_Finalize();
+   return(0);
+}
+
+static int run_test(void)
+{
+   hsize_t dims[1] = {DIM};
+   static double buf[DIM];
+   char name[32];
+   hid_t space_id, dset_id;
+   double elapsed, base_elapsed = 0;
+   herr_t err = 0;
+   int nthreads;
+   int i;
+
+   H5is_library_threadsafe(&threadsafe);
+   if(!threadsafe)
+      fprintf(stderr, "Warning: HDF5 library is not thread-safe, serializing HDF5 calls.\n");
+
+   for(i = 0; i < DIM; i++)
+      buf[i] = i;
+
+   /* one dataset per thread, plus one shared by all threads */
+   file_id = H5Fcreate(opt_file, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+   if(file_id < 0)
+      return(-1);
+   space_id = H5Screate_simple(1, dims, NULL);
+   for(i = 0; i <= opt_threads; i++)
+   {
+      if(i < opt_threads)
+         snprintf(name, sizeof(name), "thread%d", i);
+      else
+         snprintf(name, sizeof(name), "shared");
+      dset_id = H5Dcreate2(file_id, name, H5T_NATIVE_DOUBLE, space_id,
+         H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      if(dset_id < 0)
+         return(-1);
+      err |= H5Dwrite(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+         H5P_DEFAULT, buf);
+      err |= H5Dclose(dset_id);
+   }
+   H5Sclose(space_id);
+
+   for(nthreads = 1; err >= 0; nthreads *= 2)
+   {
+      if(nthreads > opt_threads)
+         nthreads = opt_threads;
+      if(run_phase(nthreads, &elapsed) < 0)
+         return(-1);
+      if(nthreads == 1)
+         base_elapsed = elapsed;
+      printf("threads: %d\titerations: %d\ttime: %f\tspeedup: %.2f\n",
+         nthreads, opt_iters, elapsed,
+         elapsed > 0 ? nthreads * base_elapsed / elapsed : 0);
+      if(nthreads == opt_threads)
+         break;
+   }
+
+   err |= H5Fclose(file_id);
+
+   return(err < 0 ? -1 : 0);
+}
+
+static int run_phase(int nthreads, double *elapsed)
+{
+   pthread_t *threads;
+   struct thread_args *args;
+   double start;
+   int ret = 0;
+   int i;
+
+   threads = malloc(nthreads * sizeof(*threads));
+   args = malloc(nthreads * sizeof(*args));
+   if(!threads || !args)
+   {
+      perror("malloc");
+      free(threads);
+      free(args);
+      return(-1);
+   }
+
+   start = MPI_Wtime();
+   for(i = 0; i < nthreads; i++)
+   {
+      args[i].id = i;
+      args[i].err = 0;
+      pthread_create(&threads[i], NULL, thread_fn, &args[i]);
+   }
+   for(i = 0; i < nthreads; i++)
+   {
+      pthread_join(threads[i], NULL);
+      if(args[i].err)
+         ret = -1;
+   }
+   *elapsed = MPI_Wtime() - start;
+
+   free(threads);
+   free(args);
+   return(ret);
+}
+
+static void *thread_fn(void *arg)
+{
+   struct thread_args *targs = arg;
+   hsize_t start[1], count[1] = {SEL_LEN};
+   hsize_t mem_dims[1] = {SEL_LEN};
+   double buf[SEL_LEN];
+   char name[32];
+   hid_t dset_id, shared_id, space_id, mem_space_id;
+   herr_t err = 0;
+   int i;
+
+   snprintf(name, sizeof(name), "thread%d", targs->id);
+   TEST_HDF5_LOCK();
+   dset_id = H5Dopen2(file_id, name, H5P_DEFAULT);
+   shared_id = H5Dopen2(file_id, "shared", H5P_DEFAULT);
+   space_id = H5Dget_space(dset_id);
+   mem_space_id = H5Screate_simple(1, mem_dims, NULL);
+   TEST_HDF5_UNLOCK();
+   if(dset_id < 0 || shared_id < 0 || space_id < 0 || mem_space_id < 0)
+   {
+      targs->err = 1;
+      return(NULL);
+   }
+
+   for(i = 0; i < opt_iters; i++)
+   {
+      /* walk through the dataset a selection at a time */
+      start[0] = (i * SEL_LEN) % DIM;
+
+      TEST_HDF5_LOCK();
+      err |= H5Sselect_hyperslab(space_id, H5S_SELECT_SET, start, NULL,
+         count, NULL);
+      err |= H5Dwrite(dset_id, H5T_NATIVE_DOUBLE, mem_space_id, space_id,
+         H5P_DEFAULT, buf);
+      err |= H5Dread(dset_id, H5T_NATIVE_DOUBLE, mem_space_id, space_id,
+         H5P_DEFAULT, buf);
+      err |= H5Dread(shared_id, H5T_NATIVE_DOUBLE, mem_space_id, space_id,
+         H5P_DEFAULT, buf);
+      TEST_HDF5_UNLOCK();
+   }
+
+   TEST_HDF5_LOCK();
+   H5Sclose(mem_space_id);
+   H5Sclose(space_id);
+   err |= H5Dclose(shared_id);
+   err |= H5Dclose(dset_id);
+   TEST_HDF5_UNLOCK();
+
+   if(err < 0)
+      targs->err = 1;
+   return(NULL);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+
+   while ((c = getopt(argc, argv, "f:t:i:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case 't': /* maximum number of threads */
+            opt_threads = atoi(optarg);
+            break;
+         case 'i': /* iterations per thread */
+            opt_iters = atoi(optarg);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   if(opt_threads < 1)
+      opt_threads = 1;
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: hdf5-thread-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: test.h5]\n");
+    printf(" -t       maximum number of threads [default: 4]\n");
+    printf(" -i       iterations per thread [default: 100]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
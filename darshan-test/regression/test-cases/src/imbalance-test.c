@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <mpi.h>
+#include <errno.h>
+#include <getopt.h>
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.out";
+static int     opt_blocks = 8;
+static int     opt_size = 1000;
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static void check(int ret, const char *call);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   char *buf;
+   int nblocks;
+   int fd;
+   int i;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   buf = malloc(opt_size);
+   if(!buf)
+   {
+      perror("malloc");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+   memset(buf, mynod, opt_size);
+
+   if (mynod == 0)
+   {
+      fd = open(opt_file, O_CREAT|O_RDWR|O_TRUNC, 0644);
+      check(fd, "open");
+      close(fd);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   /* every process writes one block of a shared file, except the last one,
+    * which straggles behind writing (and syncing) opt_blocks blocks
+    */
+   nblocks = (mynod == nprocs - 1) ? opt_blocks : 1;
+   fd = open(opt_file, O_WRONLY);
+   check(fd, "open");
+   for(i = 0; i < nblocks; i++)
+   {
+      check(pwrite(fd, buf, opt_size,
+         ((off_t)mynod * opt_blocks + i) * opt_size), "pwrite");
+      check(fsync(fd), "fsync");
+   }
+   close(fd);
+
+   free(buf);
+
+   MPI_Finalize();
+   return(0);
+}
+
+static void check(int ret, const char *call)
+{
+   if(ret < 0)
+   {
+      perror(call);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+   
+   while ((c = getopt(argc, argv, "f:n:b:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case 'n': /* blocks written by the last process */
+            opt_blocks = atoi(optarg);
+            break;
+         case 'b': /* bytes per block */
+            opt_size = atoi(optarg);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: imbalance-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: test.out]\n");
+    printf(" -n       blocks written by the last process [default: 8]\n");
+    printf(" -b       bytes per block [default: 1000]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
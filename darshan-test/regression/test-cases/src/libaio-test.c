@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2024 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <mpi.h>
+#include <errno.h>
+#include <getopt.h>
+#include <libaio.h>
+
+#define NUM_BLOCKS 4
+#define BLOCK_SIZE 4096
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.out";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static int run_batch(io_context_t ctx, int fd, char **bufs, int write_flag);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   io_context_t ctx = 0;
+   char *bufs[NUM_BLOCKS];
+   int fd;
+   int i;
+   int ret;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if (mynod == 0) printf("# Using libaio calls.\n");
+
+   if (mynod == 0)
+   {
+      /* prefer O_DIRECT, but fall back to buffered I/O on file systems
+       * that do not support it (e.g., tmpfs)
+       */
+      fd = open(opt_file, O_CREAT|O_RDWR|O_TRUNC|O_DIRECT, 0644);
+      if(fd < 0 && errno == EINVAL)
+         fd = open(opt_file, O_CREAT|O_RDWR|O_TRUNC, 0644);
+      if(fd < 0)
+      {
+         perror("open");
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+
+      for(i = 0; i < NUM_BLOCKS; i++)
+      {
+         if(posix_memalign((void **)&bufs[i], BLOCK_SIZE, BLOCK_SIZE) != 0)
+         {
+            fprintf(stderr, "Error: posix_memalign failed\n");
+            MPI_Abort(MPI_COMM_WORLD, 1);
+         }
+         memset(bufs[i], 'a' + i, BLOCK_SIZE);
+      }
+
+      ret = io_setup(NUM_BLOCKS, &ctx);
+      if(ret < 0)
+      {
+         fprintf(stderr, "Error: io_setup: %s\n", strerror(-ret));
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+
+      /* submit all writes in one batch, then read them back in another */
+      if(run_batch(ctx, fd, bufs, 1) < 0 || run_batch(ctx, fd, bufs, 0) < 0)
+         MPI_Abort(MPI_COMM_WORLD, 1);
+
+      io_destroy(ctx);
+      close(fd);
+      for(i = 0; i < NUM_BLOCKS; i++)
+         free(bufs[i]);
+   }
+
+   MPI_Finalize();
+   return(0);
+}
+
+static int run_batch(io_context_t ctx, int fd, char **bufs, int write_flag)
+{
+   struct iocb iocbs[NUM_BLOCKS];
+   struct iocb *iocbps[NUM_BLOCKS];
+   struct io_event events[NUM_BLOCKS];
+   int i;
+   int ret;
+   int completed = 0;
+
+   for(i = 0; i < NUM_BLOCKS; i++)
+   {
+      if(write_flag)
+         io_prep_pwrite(&iocbs[i], fd, bufs[i], BLOCK_SIZE, (long long)i * BLOCK_SIZE);
+      else
+         io_prep_pread(&iocbs[i], fd, bufs[i], BLOCK_SIZE, (long long)i * BLOCK_SIZE);
+      iocbps[i] = &iocbs[i];
+   }
+
+   ret = io_submit(ctx, NUM_BLOCKS, iocbps);
+   if(ret != NUM_BLOCKS)
+   {
+      fprintf(stderr, "Error: io_submit returned %d\n", ret);
+      return(-1);
+   }
+
+   while(completed < NUM_BLOCKS)
+   {
+      ret = io_getevents(ctx, 1, NUM_BLOCKS - completed, events, NULL);
+      if(ret < 0)
+      {
+         fprintf(stderr, "Error: io_getevents: %s\n", strerror(-ret));
+         return(-1);
+      }
+      for(i = 0; i < ret; i++)
+      {
+         if((long)events[i].res != BLOCK_SIZE)
+         {
+            fprintf(stderr, "Error: short aio operation (%ld)\n",
+               (long)events[i].res);
+            return(-1);
+         }
+      }
+      completed += ret;
+   }
+
+   return(0);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+   
+   while ((c = getopt(argc, argv, "f:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: libaio-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: /foo/test.out]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+/* Exercises the MPI-IO nonblocking completion counters. Rank 0 posts
+ * NB_COUNT nonblocking writes, "computes" for a while, and completes them
+ * with MPI_Waitall; it then posts the same number of nonblocking reads and
+ * completes them one at a time with MPI_Test and MPI_Wait. Finally it posts
+ * one more write and frees its request, then completes a point-to-point
+ * request, which MPI may give the freed handle, with MPI_Wait.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <mpi.h>
+#include <getopt.h>
+
+#define NB_COUNT 4
+#define NB_SIZE 4096
+#define COMPUTE_USECS 100000
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.out";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static int run_test(void);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   int ret = 0;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if(mynod == 0)
+      ret = run_test();
+   MPI_Bcast(&ret, 1, MPI_INT, 0, MPI_COMM_WORLD);
+   if(ret != 0)
+   {
+      if(mynod == 0)
+         fprintf(stderr, "Error: MPI-IO operations on %s failed.\n", opt_file);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   MPI_Finalize();
+   return(0);
+}
+
+static int run_test(void)
+{
+   static char buf[NB_COUNT][NB_SIZE];
+   MPI_Request reqs[NB_COUNT];
+   MPI_Request req;
+   MPI_File fh;
+   int msg = 0;
+   int flag = 0;
+   int err = 0;
+   int i;
+
+   memset(buf, 'a', sizeof(buf));
+
+   err = MPI_File_open(MPI_COMM_SELF, opt_file,
+      MPI_MODE_CREATE | MPI_MODE_RDWR, MPI_INFO_NULL, &fh);
+   if(err != MPI_SUCCESS)
+      return(-1);
+
+   for(i = 0; i < NB_COUNT; i++)
+      err |= MPI_File_iwrite_at(fh, (MPI_Offset)i * NB_SIZE, buf[i],
+         NB_SIZE, MPI_BYTE, &reqs[i]);
+   usleep(COMPUTE_USECS);
+   err |= MPI_Waitall(NB_COUNT, reqs, MPI_STATUSES_IGNORE);
+
+   for(i = 0; i < NB_COUNT; i++)
+   {
+      err |= MPI_File_iread_at(fh, (MPI_Offset)i * NB_SIZE, buf[i],
+         NB_SIZE, MPI_BYTE, &reqs[i]);
+      usleep(COMPUTE_USECS);
+      err |= MPI_Test(&reqs[i], &flag, MPI_STATUS_IGNORE);
+      if(!flag)
+         err |= MPI_Wait(&reqs[i], MPI_STATUS_IGNORE);
+   }
+
+   err |= MPI_File_iwrite_at(fh, 0, buf[0], NB_SIZE, MPI_BYTE, &req);
+   err |= MPI_Request_free(&req);
+   err |= MPI_File_sync(fh);
+   err |= MPI_Isend(&mynod, 1, MPI_INT, 0, 0, MPI_COMM_SELF, &req);
+   err |= MPI_Recv(&msg, 1, MPI_INT, 0, 0, MPI_COMM_SELF, MPI_STATUS_IGNORE);
+   err |= MPI_Wait(&req, MPI_STATUS_IGNORE);
+
+   err |= MPI_File_close(&fh);
+
+   return(err != MPI_SUCCESS ? -1 : 0);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+
+   while ((c = getopt(argc, argv, "f:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: mpiio-nb-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: test.out]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+/* Exercises the NFS module against fixture copies of /proc/self/mountstats.
+ * Darshan must be pointed at a scratch copy of the "start" fixture with
+ * DARSHAN_NFS_MOUNTSTATS_PATH; once every rank has taken its initial
+ * snapshot, rank 0 replaces it with the "end" fixture so that shutdown
+ * sees the updated counters.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <mpi.h>
+#include <getopt.h>
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_end_file[256] = "";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static int replace_file(const char *src, const char *dst);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   char *stats_path;
+   int ret = 0;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   stats_path = getenv("DARSHAN_NFS_MOUNTSTATS_PATH");
+   if(!stats_path || !strlen(opt_end_file))
+   {
+      if(mynod == 0)
+      {
+         fprintf(stderr, "Error: DARSHAN_NFS_MOUNTSTATS_PATH and -e are required.\n");
+         usage();
+      }
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   /* every rank has taken its initial snapshot once MPI_Init returns */
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   if(mynod == 0)
+      ret = replace_file(opt_end_file, stats_path);
+   MPI_Bcast(&ret, 1, MPI_INT, 0, MPI_COMM_WORLD);
+   if(ret != 0)
+   {
+      if(mynod == 0)
+         fprintf(stderr, "Error: unable to replace %s with %s.\n",
+            stats_path, opt_end_file);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   MPI_Finalize();
+   return(0);
+}
+
+/* copy src to a temporary file next to dst, then atomically rename it over
+ * dst so that no rank can observe a partially written file
+ */
+static int replace_file(const char *src, const char *dst)
+{
+   char tmp_path[512];
+   char buf[4096];
+   FILE *in, *out;
+   size_t n;
+
+   snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", dst);
+
+   in = fopen(src, "r");
+   if(!in)
+      return(-1);
+   out = fopen(tmp_path, "w");
+   if(!out)
+   {
+      fclose(in);
+      return(-1);
+   }
+   while((n = fread(buf, 1, sizeof(buf), in)) > 0)
+   {
+      if(fwrite(buf, 1, n, out) != n)
+      {
+         fclose(in);
+         fclose(out);
+         return(-1);
+      }
+   }
+   fclose(in);
+   if(fclose(out) != 0)
+      return(-1);
+
+   return(rename(tmp_path, dst));
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+
+   while ((c = getopt(argc, argv, "e:")) != EOF) {
+      switch (c) {
+         case 'e': /* end fixture */
+            strncpy(opt_end_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: nfs-mountstats-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -e       mountstats fixture to install before shutdown\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
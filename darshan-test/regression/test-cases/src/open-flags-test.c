@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <mpi.h>
+#include <errno.h>
+#include <getopt.h>
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.out";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static void check(int ret, const char *call);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   char buf[16] = "darshan";
+   int fd;
+   int flags;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   /* one creating open in total */
+   if (mynod == 0)
+   {
+      fd = open(opt_file, O_CREAT|O_WRONLY|O_TRUNC, 0644);
+      check(fd, "open");
+      close(fd);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   /* one O_APPEND|O_DSYNC open per process, then O_APPEND is dropped with
+    * fcntl(F_SETFL) before writing
+    */
+   fd = open(opt_file, O_WRONLY|O_APPEND|O_DSYNC);
+   check(fd, "open");
+   flags = fcntl(fd, F_GETFL);
+   check(flags, "fcntl");
+   check(fcntl(fd, F_SETFL, flags & ~O_APPEND), "fcntl");
+   check(pwrite(fd, buf, sizeof(buf), mynod * sizeof(buf)), "pwrite");
+   close(fd);
+
+   MPI_Finalize();
+   return(0);
+}
+
+static void check(int ret, const char *call)
+{
+   if(ret < 0)
+   {
+      perror(call);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+   
+   while ((c = getopt(argc, argv, "f:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: open-flags-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: /foo/test.out]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
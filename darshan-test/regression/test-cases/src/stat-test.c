@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2024 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <libgen.h>
+#include <sys/stat.h>
+#include <mpi.h>
+#include <errno.h>
+#include <getopt.h>
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.out";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static void check(int ret, const char *call);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   struct stat sb;
+   char dir[256];
+   char base[256];
+   int fd;
+   int dirfd;
+   int nstats = 0;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if (mynod == 0)
+   {
+      fd = open(opt_file, O_CREAT|O_RDWR|O_TRUNC, 0644);
+      check(fd, "open");
+      close(fd);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   strcpy(dir, opt_file);
+   strcpy(base, opt_file);
+   fd = open(opt_file, O_RDONLY);
+   check(fd, "open");
+   dirfd = open(dirname(dir), O_RDONLY|O_DIRECTORY);
+   check(dirfd, "open");
+
+   /* every entry point of the stat family, each stat'ing the same file */
+   check(stat(opt_file, &sb), "stat"); nstats++;
+   check(lstat(opt_file, &sb), "lstat"); nstats++;
+   check(fstat(fd, &sb), "fstat"); nstats++;
+   check(fstatat(AT_FDCWD, opt_file, &sb, 0), "fstatat"); nstats++;
+   check(fstatat(dirfd, basename(base), &sb, AT_SYMLINK_NOFOLLOW), "fstatat"); nstats++;
+   check(fstatat(fd, "", &sb, AT_EMPTY_PATH), "fstatat"); nstats++;
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 28)
+   {
+      struct statx sx;
+      check(statx(AT_FDCWD, opt_file, 0, STATX_BASIC_STATS, &sx), "statx"); nstats++;
+   }
+#endif
+
+   close(dirfd);
+   close(fd);
+
+   if (mynod == 0) printf("# stat calls per process: %d\n", nstats);
+
+   MPI_Finalize();
+   return(0);
+}
+
+static void check(int ret, const char *call)
+{
+   if(ret < 0)
+   {
+      perror(call);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+   
+   while ((c = getopt(argc, argv, "f:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: stat-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: /foo/test.out]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2024 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <mpi.h>
+#include <errno.h>
+#include <getopt.h>
+
+#define NUM_BLOCKS 4
+#define BLOCK_SIZE 4096
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char    opt_file[256] = "test.out";
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+
+/* global vars */
+static int mynod = 0;
+static int nprocs = 1;
+
+int main(int argc, char **argv)
+{
+   char buf[BLOCK_SIZE];
+   off_t offset;
+   int fd;
+   int i;
+   int ret;
+
+   /* startup MPI and determine the rank of this process */
+   MPI_Init(&argc,&argv);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+
+   /* parse the command line arguments */
+   parse_args(argc, argv);
+
+   if (mynod == 0) printf("# Using storage hint and space management calls.\n");
+
+   /* rank 0 empties the file before anyone writes to it */
+   if (mynod == 0)
+   {
+      fd = open(opt_file, O_CREAT|O_RDWR, 0644);
+      if(fd < 0 || ftruncate(fd, 0) < 0)
+      {
+         perror("ftruncate");
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+      close(fd);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   fd = open(opt_file, O_RDWR);
+   if(fd < 0)
+   {
+      perror("open");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   /* each rank preallocates, writes, flushes and drops its own region */
+   offset = (off_t)mynod * NUM_BLOCKS * BLOCK_SIZE;
+   ret = posix_fallocate(fd, offset, NUM_BLOCKS * BLOCK_SIZE);
+   if(ret != 0)
+   {
+      fprintf(stderr, "Error: posix_fallocate: %s\n", strerror(ret));
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   /* advise on the rest of the file (a length of 0) once every region is
+    * allocated, before this rank has accessed any of it
+    */
+   MPI_Barrier(MPI_COMM_WORLD);
+   ret = posix_fadvise(fd, offset, 0, POSIX_FADV_SEQUENTIAL);
+   if(ret != 0)
+   {
+      fprintf(stderr, "Error: posix_fadvise: %s\n", strerror(ret));
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   memset(buf, 'a' + mynod % 26, BLOCK_SIZE);
+   for(i = 0; i < NUM_BLOCKS; i++)
+   {
+      if(pwrite(fd, buf, BLOCK_SIZE, offset + i * BLOCK_SIZE) != BLOCK_SIZE)
+      {
+         perror("pwrite");
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+   }
+
+   if(sync_file_range(fd, offset, NUM_BLOCKS * BLOCK_SIZE,
+      SYNC_FILE_RANGE_WAIT_BEFORE|SYNC_FILE_RANGE_WRITE|SYNC_FILE_RANGE_WAIT_AFTER) < 0)
+   {
+      perror("sync_file_range");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   ret = posix_fadvise(fd, offset, NUM_BLOCKS * BLOCK_SIZE, POSIX_FADV_DONTNEED);
+   if(ret != 0)
+   {
+      fprintf(stderr, "Error: posix_fadvise: %s\n", strerror(ret));
+      MPI_Abort(MPI_COMM_WORLD, 1);
+   }
+
+   close(fd);
+
+   MPI_Finalize();
+   return(0);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+   
+   while ((c = getopt(argc, argv, "f:")) != EOF) {
+      switch (c) {
+         case 'f': /* filename */
+            strncpy(opt_file, optarg, 255);
+            break;
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: storage-hint-test [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -f       filename [default: /foo/test.out]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+PROG=stat-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute; the program reports how many stat calls each process made,
+# which depends on the entry points offered by the local C library
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat > $DARSHAN_TMP/${PROG}.out
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+NSTATS=`grep "stat calls per process" $DARSHAN_TMP/${PROG}.out | cut -d: -f 2`
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results
+POSIX_STATS=`grep POSIX_STATS $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+if [ ! "$POSIX_STATS" -eq $((DARSHAN_DEFAULT_NPROCS*NSTATS)) ]; then
+    echo "Error: POSIX stat count of $POSIX_STATS is incorrect (expected $((DARSHAN_DEFAULT_NPROCS*NSTATS)))" 1>&2
+    exit 1
+fi
+
+exit 0
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+PROG=storage-hint-test
+
+# set log file path; remove previous log if present
+export DARSHAN_LOGFILE=$DARSHAN_TMP/${PROG}.darshan
+rm -f ${DARSHAN_LOGFILE}
+
+# compile
+$DARSHAN_CC $DARSHAN_TESTDIR/test-cases/src/${PROG}.c -o $DARSHAN_TMP/${PROG}
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile ${PROG}" 1>&2
+    exit 1
+fi
+
+# execute
+$DARSHAN_RUNJOB $DARSHAN_TMP/${PROG} -f $DARSHAN_TMP/${PROG}.tmp.dat
+if [ $? -ne 0 ]; then
+    echo "Error: failed to execute ${PROG}" 1>&2
+    exit 1
+fi
+
+# parse log
+$DARSHAN_UTIL_PATH/bin/darshan-parser $DARSHAN_LOGFILE > $DARSHAN_TMP/${PROG}.darshan.txt
+if [ $? -ne 0 ]; then
+    echo "Error: failed to parse ${DARSHAN_LOGFILE}" 1>&2
+    exit 1
+fi
+
+# check results; the file is shared, so each counter is summed over all ranks
+check_counter() {
+    VALUE=`grep "$1\s" $DARSHAN_TMP/${PROG}.darshan.txt | grep -vE "^#" | grep ${PROG}.tmp.dat | cut -f 5`
+    if [ ! "$VALUE" -eq $2 ]; then
+        echo "Error: $1 count of $VALUE is incorrect (expected $2)" 1>&2
+        exit 1
+    fi
+}
+
+REGION=16384
+check_counter POSIX_TRUNCATES 1
+check_counter POSIX_TRUNCATES_TO_ZERO 1
+check_counter POSIX_FALLOCATES $DARSHAN_DEFAULT_NPROCS
+check_counter POSIX_FALLOCATE_BYTES $((DARSHAN_DEFAULT_NPROCS*REGION))
+check_counter POSIX_SYNC_FILE_RANGES $DARSHAN_DEFAULT_NPROCS
+check_counter POSIX_SYNC_FILE_RANGE_BYTES $((DARSHAN_DEFAULT_NPROCS*REGION))
+check_counter POSIX_FADVISES $((DARSHAN_DEFAULT_NPROCS*2))
+check_counter POSIX_FADVISE_DONTNEEDS $DARSHAN_DEFAULT_NPROCS
+# each rank also advises from the start of its region to the end of the file
+check_counter POSIX_FADVISE_BYTES $((DARSHAN_DEFAULT_NPROCS*REGION + REGION*DARSHAN_DEFAULT_NPROCS*(DARSHAN_DEFAULT_NPROCS+1)/2))
+check_counter POSIX_READAHEADS 0
+
+exit 0
@@ -0,0 +1,51 @@
+#!/bin/bash
+#
+#  Build darshan-shutdown-bench against a Darshan installation and run it
+#  with a local MPI launcher, printing the per-phase shutdown timing and
+#  memory high-water marks reported by the runtime.
+#
+#  Usage: run-shutdown-bench.sh <nprocs> [darshan-shutdown-bench options]
+#
+#  Environment:
+#    DARSHAN_LIBDIR  directory containing libdarshan.so (default: the lib
+#                    directory next to the darshan-config found in PATH)
+#    MPICC           MPI compiler wrapper (default: mpicc)
+#    MPIEXEC         MPI launcher (default: mpiexec)
+#
+#  The benchmark sizes DARSHAN_MODMEM and DARSHAN_NAMEMEM to the workload
+#  unless they are already set.  DXT segment volume is still bounded by the
+#  runtime's DXT memory limit.
+#
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <nprocs> [darshan-shutdown-bench options]" 1>&2
+    exit 1
+fi
+
+NPROCS=$1
+shift
+
+SRCDIR=$(cd $(dirname $0) && pwd)
+MPICC=${MPICC:-mpicc}
+MPIEXEC=${MPIEXEC:-mpiexec}
+if [ -z "$DARSHAN_LIBDIR" ]; then
+    DARSHAN_LIBDIR=$(dirname $(which darshan-config))/../lib
+fi
+
+TMPDIR=$(mktemp -d ${TMPDIR:-/tmp}/darshan-shutdown-bench.XXXXXX)
+trap "rm -rf $TMPDIR" EXIT
+
+$MPICC $SRCDIR/darshan-shutdown-bench.c -o $TMPDIR/darshan-shutdown-bench \
+    -L$DARSHAN_LIBDIR -Wl,-rpath,$DARSHAN_LIBDIR -ldarshan
+if [ $? -ne 0 ]; then
+    echo "Error: failed to compile darshan-shutdown-bench" 1>&2
+    exit 1
+fi
+
+# each shutdown writes a new log; keep them out of the production log path
+# (with the date-formatted subdirectories used by --with-log-path)
+export DARSHAN_LOGPATH=$TMPDIR
+mkdir -p $TMPDIR/$(date +%Y)/$(date +%-m)/$(date +%-d)
+export DARSHAN_INTERNAL_TIMING=1
+
+$MPIEXEC -n $NPROCS $TMPDIR/darshan-shutdown-bench "$@" 2>&1
@@ -0,0 +1,63 @@
+#!/bin/bash
+#
+#  Run wrapper-bench uninstrumented, with libdarshan.so in LD_PRELOAD, and
+#  (if it was built) with the wrappers linked statically through --wrap.
+#  The instrumented runs are compared against the uninstrumented one.
+#
+#  Usage: run-wrapper-bench.sh <path to libdarshan.so> [wrapper-bench options]
+#
+#  The JSON results of each run are written to $OUTDIR (default: the
+#  current directory) as wrapper-bench-<mode>.json.  Set MPIEXEC to change
+#  how the benchmark is launched (it always runs as a single process).
+#
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <path to libdarshan.so> [wrapper-bench options]" 1>&2
+    exit 1
+fi
+
+DARSHAN_LIB=$1
+shift
+
+BENCHDIR=$(cd $(dirname $0) && pwd)
+MPIEXEC=${MPIEXEC:-"mpiexec -n 1"}
+OUTDIR=${OUTDIR:-.}
+
+if [ ! -x $BENCHDIR/wrapper-bench ]; then
+    echo "Error: $BENCHDIR/wrapper-bench not found; run make first" 1>&2
+    exit 1
+fi
+
+# Darshan excludes /dev/ by default, which would hide the tmpfs files used
+# by the benchmark and understate the wrapper overhead
+export DARSHAN_EXCLUDE_DIRS=none
+
+# keep the logs out of the way
+export DARSHAN_LOGFILE=$(mktemp ${TMPDIR:-/tmp}/wrapper-bench.XXXXXX)
+trap "rm -f $DARSHAN_LOGFILE" EXIT
+
+$MPIEXEC $BENCHDIR/wrapper-bench -m baseline "$@" > $OUTDIR/wrapper-bench-baseline.json
+if [ $? -ne 0 ]; then
+    echo "Error: baseline run failed" 1>&2
+    exit 1
+fi
+
+$MPIEXEC env LD_PRELOAD=$DARSHAN_LIB $BENCHDIR/wrapper-bench -m preload \
+    -b $OUTDIR/wrapper-bench-baseline.json "$@" > $OUTDIR/wrapper-bench-preload.json
+if [ $? -ne 0 ]; then
+    echo "Error: LD_PRELOAD run failed" 1>&2
+    exit 1
+fi
+
+if [ -x $BENCHDIR/wrapper-bench-static ]; then
+    $MPIEXEC $BENCHDIR/wrapper-bench-static -m static \
+        -b $OUTDIR/wrapper-bench-baseline.json "$@" > $OUTDIR/wrapper-bench-static.json
+    if [ $? -ne 0 ]; then
+        echo "Error: static (--wrap) run failed" 1>&2
+        exit 1
+    fi
+fi
+
+cat $OUTDIR/wrapper-bench-*.json
+
+exit 0
@@ -0,0 +1,488 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+/* wrapper-bench.c
+ *
+ * Measures the per-call cost of Darshan's I/O wrappers.  Each selected
+ * operation is issued in a tight loop by 1..N threads, each thread working
+ * on its own file in the target directory (tmpfs by default, so that the
+ * cost of the file system itself is as small as possible).  The same
+ * binary is meant to be run uninstrumented, with libdarshan in LD_PRELOAD,
+ * and (when built with wrapper-bench-static) with the wrappers linked in
+ * via --wrap; see run-wrapper-bench.sh.
+ *
+ * Results are written to stdout as JSON, one result object per line.  If a
+ * previous uninstrumented run's output is given with -b, each result also
+ * reports the baseline cost and the overhead relative to it.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <mpi.h>
+
+#define MAX_OP_NAME 16
+#define MAX_BASELINE 256
+
+/* present only when the instrumentation library is loaded or linked in; it
+ * is never called, only used to report whether Darshan was active
+ */
+extern void darshan_core_register_module(void) __attribute__((weak));
+
+enum bench_op
+{
+   OP_OPEN = 0,
+   OP_READ,
+   OP_WRITE,
+   OP_STAT,
+   OP_FOPEN,
+   OP_MPIIO_WRITE,
+   OP_COUNT
+};
+
+static const char *op_names[OP_COUNT] =
+{
+   "open",
+   "read",
+   "write",
+   "stat",
+   "fopen",
+   "mpiio-write"
+};
+
+struct thread_arg
+{
+   enum bench_op op;
+   int tid;
+   long iters;
+   char path[512];
+   double elapsed_ns;
+   int err;
+};
+
+struct baseline_result
+{
+   char op[MAX_OP_NAME];
+   int threads;
+   double ns_per_op;
+};
+
+/* DEFAULT VALUES FOR OPTIONS */
+static char opt_dir[256] = "/dev/shm";
+static char opt_mode[32] = "";
+static char opt_ops[128] = "open,read,write,stat,fopen";
+static char *opt_baseline = NULL;
+static long opt_iters = 100000;
+static int opt_threads = 4;
+static int opt_size = 1;
+
+/* global vars */
+static pthread_barrier_t start_barrier;
+static struct baseline_result baseline[MAX_BASELINE];
+static int baseline_count = 0;
+static int thread_level = MPI_THREAD_SINGLE;
+static int mynod = 0;
+
+/* function prototypes */
+static int parse_args(int argc, char **argv);
+static void usage(void);
+static int read_baseline(const char *file);
+static double lookup_baseline(const char *op, int threads);
+static int run_op(enum bench_op op, int nthreads);
+static void *bench_thread(void *arg);
+static int bench_loop(struct thread_arg *targ, long iters);
+
+int main(int argc, char **argv)
+{
+   int nprocs;
+   int selected[OP_COUNT] = {0};
+   char ops[128];
+   char *tok, *saveptr;
+   int i, t, ret = 0;
+
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &thread_level);
+   MPI_Comm_rank(MPI_COMM_WORLD, &mynod);
+   MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+   parse_args(argc, argv);
+
+   if(nprocs != 1)
+   {
+      if(mynod == 0)
+         fprintf(stderr, "Error: wrapper-bench must be run with a single process.\n");
+      MPI_Finalize();
+      return(1);
+   }
+
+   strcpy(ops, opt_ops);
+   for(tok = strtok_r(ops, ",", &saveptr); tok;
+      tok = strtok_r(NULL, ",", &saveptr))
+   {
+      for(i = 0; i < OP_COUNT; i++)
+      {
+         if(strcmp(tok, op_names[i]) == 0)
+         {
+            selected[i] = 1;
+            break;
+         }
+      }
+      if(i == OP_COUNT)
+      {
+         fprintf(stderr, "Error: unknown operation '%s'.\n", tok);
+         usage();
+         MPI_Finalize();
+         return(1);
+      }
+   }
+
+   if(opt_baseline && read_baseline(opt_baseline) < 0)
+   {
+      fprintf(stderr, "Error: unable to read baseline results from %s.\n",
+         opt_baseline);
+      MPI_Finalize();
+      return(1);
+   }
+
+   printf("{\"mode\": \"%s\", \"darshan\": %s, \"dir\": \"%s\", "
+      "\"iterations\": %ld, \"access_size\": %d, \"results\": [\n",
+      opt_mode[0] ? opt_mode : (darshan_core_register_module ? "darshan" : "baseline"),
+      darshan_core_register_module ? "true" : "false", opt_dir, opt_iters, opt_size);
+
+   /* thread counts are the powers of two up to opt_threads, plus
+    * opt_threads itself
+    */
+   for(i = 0; i < OP_COUNT && ret == 0; i++)
+   {
+      if(!selected[i])
+         continue;
+      for(t = 1; t <= opt_threads && ret == 0;
+         t = (t < opt_threads && t * 2 > opt_threads) ? opt_threads : t * 2)
+      {
+         if(i == OP_MPIIO_WRITE && t > 1 &&
+            thread_level < MPI_THREAD_MULTIPLE)
+         {
+            fprintf(stderr, "Warning: MPI_THREAD_MULTIPLE not provided, "
+               "skipping mpiio-write with %d threads.\n", t);
+            break;
+         }
+         ret = run_op(i, t);
+      }
+   }
+
+   printf("\n]}\n");
+
+   MPI_Finalize();
+   return(ret ? 1 : 0);
+}
+
+static int run_op(enum bench_op op, int nthreads)
+{
+   static int first_result = 1;
+   struct thread_arg *targs;
+   pthread_t *threads;
+   double total_ns = 0, max_ns = 0, ns_per_op, base;
+   int i, ret = 0;
+
+   targs = calloc(nthreads, sizeof(*targs));
+   threads = calloc(nthreads, sizeof(*threads));
+   if(!targs || !threads)
+      return(-1);
+
+   pthread_barrier_init(&start_barrier, NULL, nthreads);
+   for(i = 0; i < nthreads; i++)
+   {
+      targs[i].op = op;
+      targs[i].tid = i;
+      targs[i].iters = opt_iters;
+      snprintf(targs[i].path, sizeof(targs[i].path),
+         "%s/wrapper-bench.%d.%s.%d", opt_dir, (int)getpid(), op_names[op], i);
+      if(pthread_create(&threads[i], NULL, bench_thread, &targs[i]) != 0)
+      {
+         /* can't recover from a partially started barrier */
+         fprintf(stderr, "Error: pthread_create failed.\n");
+         MPI_Abort(MPI_COMM_WORLD, 1);
+      }
+   }
+   for(i = 0; i < nthreads; i++)
+   {
+      pthread_join(threads[i], NULL);
+      if(targs[i].err)
+         ret = -1;
+      total_ns += targs[i].elapsed_ns;
+      if(targs[i].elapsed_ns > max_ns)
+         max_ns = targs[i].elapsed_ns;
+   }
+   pthread_barrier_destroy(&start_barrier);
+
+   if(ret == 0)
+   {
+      ns_per_op = total_ns / ((double)nthreads * opt_iters);
+      printf("%s  {\"op\": \"%s\", \"threads\": %d, \"ns_per_op\": %.2f, "
+         "\"ops_per_sec\": %.1f", first_result ? "" : ",\n", op_names[op],
+         nthreads, ns_per_op,
+         (double)nthreads * opt_iters / (max_ns / 1e9));
+      base = lookup_baseline(op_names[op], nthreads);
+      if(base > 0)
+         printf(", \"baseline_ns_per_op\": %.2f, \"overhead_ns_per_op\": %.2f, "
+            "\"overhead_pct\": %.1f", base, ns_per_op - base,
+            (ns_per_op - base) / base * 100.0);
+      printf("}");
+      fflush(stdout);
+      first_result = 0;
+   }
+
+   free(targs);
+   free(threads);
+   return(ret);
+}
+
+static void *bench_thread(void *arg)
+{
+   struct thread_arg *targ = arg;
+   struct timespec start, end;
+   char *buf;
+   int fd;
+
+   /* every thread gets its own file, populated so that reads succeed */
+   buf = calloc(1, opt_size);
+   fd = open(targ->path, O_CREAT|O_TRUNC|O_RDWR, S_IRUSR|S_IWUSR);
+   if(!buf || fd < 0 || write(fd, buf, opt_size) != opt_size)
+   {
+      perror(targ->path);
+      targ->err = 1;
+   }
+   if(fd >= 0)
+      close(fd);
+   free(buf);
+
+   /* warm up, so that one time record creation costs are excluded */
+   if(!targ->err && bench_loop(targ, targ->iters / 10 + 1) < 0)
+      targ->err = 1;
+
+   pthread_barrier_wait(&start_barrier);
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   if(!targ->err && bench_loop(targ, targ->iters) < 0)
+      targ->err = 1;
+   clock_gettime(CLOCK_MONOTONIC, &end);
+
+   targ->elapsed_ns = (end.tv_sec - start.tv_sec) * 1e9 +
+      (end.tv_nsec - start.tv_nsec);
+   unlink(targ->path);
+   return(NULL);
+}
+
+/* issue the selected operation iters times; open-style operations are timed
+ * together with their matching close
+ */
+static int bench_loop(struct thread_arg *targ, long iters)
+{
+   char *buf;
+   struct stat statbuf;
+   MPI_File fh = MPI_FILE_NULL;
+   FILE *fp;
+   long i;
+   int fd = -1;
+   int ret = 0;
+
+   buf = calloc(1, opt_size);
+   if(!buf)
+      return(-1);
+
+   if(targ->op == OP_READ || targ->op == OP_WRITE)
+   {
+      fd = open(targ->path, O_RDWR);
+      if(fd < 0)
+      {
+         perror(targ->path);
+         free(buf);
+         return(-1);
+      }
+   }
+   else if(targ->op == OP_MPIIO_WRITE)
+   {
+      if(MPI_File_open(MPI_COMM_SELF, targ->path, MPI_MODE_RDWR,
+         MPI_INFO_NULL, &fh) != MPI_SUCCESS)
+      {
+         fprintf(stderr, "Error: MPI_File_open of %s failed.\n", targ->path);
+         free(buf);
+         return(-1);
+      }
+   }
+
+   for(i = 0; i < iters && ret == 0; i++)
+   {
+      switch(targ->op)
+      {
+         case OP_OPEN:
+            fd = open(targ->path, O_RDONLY);
+            if(fd < 0)
+               ret = -1;
+            else
+               close(fd);
+            break;
+         case OP_READ:
+            if(pread(fd, buf, opt_size, 0) != opt_size)
+               ret = -1;
+            break;
+         case OP_WRITE:
+            if(pwrite(fd, buf, opt_size, 0) != opt_size)
+               ret = -1;
+            break;
+         case OP_STAT:
+            if(stat(targ->path, &statbuf) < 0)
+               ret = -1;
+            break;
+         case OP_FOPEN:
+            fp = fopen(targ->path, "r");
+            if(!fp)
+               ret = -1;
+            else
+               fclose(fp);
+            break;
+         case OP_MPIIO_WRITE:
+            if(MPI_File_write_at(fh, 0, buf, opt_size, MPI_BYTE,
+               MPI_STATUS_IGNORE) != MPI_SUCCESS)
+               ret = -1;
+            break;
+         default:
+            ret = -1;
+            break;
+      }
+   }
+   if(ret < 0)
+      fprintf(stderr, "Error: %s of %s failed: %s\n", op_names[targ->op],
+         targ->path, strerror(errno));
+
+   if(targ->op == OP_READ || targ->op == OP_WRITE)
+      close(fd);
+   else if(targ->op == OP_MPIIO_WRITE)
+      MPI_File_close(&fh);
+   free(buf);
+   return(ret);
+}
+
+/* reads the per-result lines of a previous run's JSON output */
+static int read_baseline(const char *file)
+{
+   struct baseline_result *res;
+   char line[512];
+   char *start;
+   FILE *fp;
+
+   fp = fopen(file, "r");
+   if(!fp)
+      return(-1);
+
+   while(fgets(line, sizeof(line), fp) && baseline_count < MAX_BASELINE)
+   {
+      start = strstr(line, "{\"op\":");
+      if(!start)
+         continue;
+      res = &baseline[baseline_count];
+      if(sscanf(start, "{\"op\": \"%15[^\"]\", \"threads\": %d, "
+         "\"ns_per_op\": %lf", res->op, &res->threads, &res->ns_per_op) == 3)
+         baseline_count++;
+   }
+
+   fclose(fp);
+   return(0);
+}
+
+static double lookup_baseline(const char *op, int threads)
+{
+   int i;
+
+   for(i = 0; i < baseline_count; i++)
+   {
+      if(strcmp(baseline[i].op, op) == 0 && baseline[i].threads == threads)
+         return(baseline[i].ns_per_op);
+   }
+   return(-1);
+}
+
+static int parse_args(int argc, char **argv)
+{
+   int c;
+
+   while ((c = getopt(argc, argv, "b:d:i:m:o:s:t:h")) != EOF) {
+      switch (c) {
+         case 'b': /* baseline results */
+            opt_baseline = optarg;
+            break;
+         case 'd': /* directory */
+            strncpy(opt_dir, optarg, 255);
+            break;
+         case 'i': /* iterations */
+            opt_iters = atol(optarg);
+            break;
+         case 'm': /* mode label */
+            strncpy(opt_mode, optarg, 31);
+            break;
+         case 'o': /* operations */
+            strncpy(opt_ops, optarg, 127);
+            break;
+         case 's': /* access size */
+            opt_size = atoi(optarg);
+            break;
+         case 't': /* max threads */
+            opt_threads = atoi(optarg);
+            break;
+         case 'h':
+            if (mynod == 0)
+                usage();
+            exit(0);
+         case '?': /* unknown */
+            if (mynod == 0)
+                usage();
+            exit(1);
+         default:
+            break;
+      }
+   }
+
+   if(opt_iters < 1 || opt_threads < 1 || opt_size < 1)
+   {
+      if (mynod == 0)
+         usage();
+      exit(1);
+   }
+   return(0);
+}
+
+static void usage(void)
+{
+    printf("Usage: wrapper-bench [<OPTIONS>...]\n");
+    printf("\n<OPTIONS> is one of\n");
+    printf(" -b       baseline results file (JSON output of an uninstrumented run)\n");
+    printf(" -d       directory to create files in [default: /dev/shm]\n");
+    printf(" -i       iterations per thread for each operation [default: 100000]\n");
+    printf(" -m       mode label to record in the output [default: darshan or baseline]\n");
+    printf(" -o       comma separated operations to run [default: open,read,write,stat,fopen]\n");
+    printf("          (also available: mpiio-write)\n");
+    printf(" -s       access size in bytes for read and write [default: 1]\n");
+    printf(" -t       maximum number of threads [default: 4]\n");
+    printf(" -h       print this help\n");
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 3
+ *  c-basic-offset: 3
+ *  tab-width: 3
+ *
+ * vim: ts=3
+ * End:
+ */
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "darshan-logutils.h"
+
+/* counter name strings for the CUSTOM module */
+#define X(a) #a,
+char *custom_counter_names[] = {
+    CUSTOM_COUNTERS
+};
+
+char *custom_f_counter_names[] = {
+    CUSTOM_F_COUNTERS
+};
+#undef X
+
+static int darshan_log_get_custom_rec(darshan_fd fd, void** custom_buf_p);
+static int darshan_log_put_custom_rec(darshan_fd fd, void* custom_buf);
+static void darshan_log_print_custom_rec(void *file_rec,
+    char *file_name, char *mnt_pt, char *fs_type);
+static void darshan_log_print_custom_description(int ver);
+static void darshan_log_print_custom_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2);
+static void darshan_log_agg_custom_recs(void *rec, void *agg_rec, int init_flag);
+
+struct darshan_mod_logutil_funcs custom_logutils =
+{
+    .log_get_record = &darshan_log_get_custom_rec,
+    .log_put_record = &darshan_log_put_custom_rec,
+    .log_print_record = &darshan_log_print_custom_rec,
+    .log_print_description = &darshan_log_print_custom_description,
+    .log_print_diff = &darshan_log_print_custom_rec_diff,
+    .log_agg_records = &darshan_log_agg_custom_recs
+};
+
+static int darshan_log_get_custom_rec(darshan_fd fd, void** custom_buf_p)
+{
+    struct darshan_custom_record *rec = *((struct darshan_custom_record **)custom_buf_p);
+    int rec_len;
+    int i;
+    int ret = -1;
+
+    if(fd->mod_map[DARSHAN_CUSTOM_MOD].len == 0)
+        return(0);
+
+    if(fd->mod_ver[DARSHAN_CUSTOM_MOD] == 0 ||
+        fd->mod_ver[DARSHAN_CUSTOM_MOD] > DARSHAN_CUSTOM_VER)
+    {
+        fprintf(stderr, "Error: Invalid CUSTOM module version number (got %d)\n",
+            fd->mod_ver[DARSHAN_CUSTOM_MOD]);
+        return(-1);
+    }
+
+    if(*custom_buf_p == NULL)
+    {
+        rec = malloc(sizeof(*rec));
+        if(!rec)
+            return(-1);
+    }
+
+    rec_len = sizeof(struct darshan_custom_record);
+    ret = darshan_log_get_mod(fd, DARSHAN_CUSTOM_MOD, rec, rec_len);
+
+    if(*custom_buf_p == NULL)
+    {
+        if(ret == rec_len)
+            *custom_buf_p = rec;
+        else
+            free(rec);
+    }
+
+    if(ret < 0)
+        return(-1);
+    else if(ret < rec_len)
+        return(0);
+    else
+    {
+        if(fd->swap_flag)
+        {
+            /* swap bytes if necessary */
+            DARSHAN_BSWAP64(&(rec->base_rec.id));
+            DARSHAN_BSWAP64(&(rec->base_rec.rank));
+            for(i=0; i<CUSTOM_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->counters[i]);
+            for(i=0; i<CUSTOM_F_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->fcounters[i]);
+        }
+
+        return(1);
+    }
+}
+
+static int darshan_log_put_custom_rec(darshan_fd fd, void* custom_buf)
+{
+    struct darshan_custom_record *rec = (struct darshan_custom_record *)custom_buf;
+    int ret;
+
+    ret = darshan_log_put_mod(fd, DARSHAN_CUSTOM_MOD, rec,
+        sizeof(struct darshan_custom_record), DARSHAN_CUSTOM_VER);
+    if(ret < 0)
+        return(-1);
+
+    return(0);
+}
+
+static void darshan_log_print_custom_rec(void *file_rec, char *file_name,
+    char *mnt_pt, char *fs_type)
+{
+    int i;
+    struct darshan_custom_record *custom_rec =
+        (struct darshan_custom_record *)file_rec;
+
+    for(i=0; i<CUSTOM_NUM_INDICES; i++)
+    {
+        DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+            custom_rec->base_rec.rank, custom_rec->base_rec.id,
+            custom_counter_names[i], custom_rec->counters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    for(i=0; i<CUSTOM_F_NUM_INDICES; i++)
+    {
+        DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+            custom_rec->base_rec.rank, custom_rec->base_rec.id,
+            custom_f_counter_names[i], custom_rec->fcounters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    return;
+}
+
+static void darshan_log_print_custom_description(int ver)
+{
+    printf("\n# description of CUSTOM counters:\n");
+    printf("#   CUSTOM_*: application-defined counters, registered by name through the\n");
+    printf("#       Darshan CUSTOM module interface (darshan-custom.h). Counters registered\n");
+    printf("#       by all ranks are reduced across the job (rank -1).\n");
+    printf("#   CUSTOM_INT_VALUE, CUSTOM_F_VALUE: sum of integer/floating point increments.\n");
+    printf("#   CUSTOM_INT_UPDATES, CUSTOM_F_UPDATES: number of integer/floating point increments.\n");
+    printf("#   CUSTOM_INT_RANK_MIN, CUSTOM_INT_RANK_MAX: smallest/largest integer value\n");
+    printf("#       accumulated by a single rank.\n");
+    printf("#   CUSTOM_F_RANK_MIN, CUSTOM_F_RANK_MAX: smallest/largest floating point value\n");
+    printf("#       accumulated by a single rank.\n");
+    printf("#   CUSTOM_RANKS: number of ranks that registered the counter.\n");
+    printf("#   CUSTOM_F_REGISTER_TIMESTAMP: time the counter was first registered.\n");
+
+    return;
+}
+
+static void darshan_log_print_custom_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2)
+{
+    struct darshan_custom_record *file1 = (struct darshan_custom_record *)file_rec1;
+    struct darshan_custom_record *file2 = (struct darshan_custom_record *)file_rec2;
+    int i;
+
+    /* NOTE: we assume that both input records are the same module format version */
+
+    for(i=0; i<CUSTOM_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file1->base_rec.rank, file1->base_rec.id, custom_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file2->base_rec.rank, file2->base_rec.id, custom_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+        else if(file1->counters[i] != file2->counters[i])
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file1->base_rec.rank, file1->base_rec.id, custom_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file2->base_rec.rank, file2->base_rec.id, custom_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+    }
+
+    for(i=0; i<CUSTOM_F_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file1->base_rec.rank, file1->base_rec.id, custom_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file2->base_rec.rank, file2->base_rec.id, custom_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+        else if(file1->fcounters[i] != file2->fcounters[i])
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file1->base_rec.rank, file1->base_rec.id, custom_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_CUSTOM_MOD],
+                file2->base_rec.rank, file2->base_rec.id, custom_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+    }
+
+    return;
+}
+
+static void darshan_log_agg_custom_recs(void *rec, void *agg_rec, int init_flag)
+{
+    struct darshan_custom_record *custom_rec = (struct darshan_custom_record *)rec;
+    struct darshan_custom_record *agg_custom_rec = (struct darshan_custom_record *)agg_rec;
+    int i;
+
+    if(init_flag)
+    {
+        /* when initializing, just copy over the first record */
+        memcpy(agg_custom_rec, custom_rec, sizeof(struct darshan_custom_record));
+        return;
+    }
+
+    for(i = 0; i < CUSTOM_NUM_INDICES; i++)
+    {
+        switch(i)
+        {
+            case CUSTOM_INT_RANK_MIN:
+                /* minimum */
+                if(custom_rec->counters[i] < agg_custom_rec->counters[i])
+                    agg_custom_rec->counters[i] = custom_rec->counters[i];
+                break;
+            case CUSTOM_INT_RANK_MAX:
+                /* maximum */
+                if(custom_rec->counters[i] > agg_custom_rec->counters[i])
+                    agg_custom_rec->counters[i] = custom_rec->counters[i];
+                break;
+            default:
+                /* sum */
+                agg_custom_rec->counters[i] += custom_rec->counters[i];
+                break;
+        }
+    }
+
+    for(i = 0; i < CUSTOM_F_NUM_INDICES; i++)
+    {
+        switch(i)
+        {
+            case CUSTOM_F_VALUE:
+                /* sum */
+                agg_custom_rec->fcounters[i] += custom_rec->fcounters[i];
+                break;
+            case CUSTOM_F_RANK_MIN:
+            case CUSTOM_F_REGISTER_TIMESTAMP:
+                /* minimum */
+                if(custom_rec->fcounters[i] < agg_custom_rec->fcounters[i])
+                    agg_custom_rec->fcounters[i] = custom_rec->fcounters[i];
+                break;
+            case CUSTOM_F_RANK_MAX:
+                /* maximum */
+                if(custom_rec->fcounters[i] > agg_custom_rec->fcounters[i])
+                    agg_custom_rec->fcounters[i] = custom_rec->fcounters[i];
+                break;
+            default:
+                break;
+        }
+    }
+
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -34,7 +34,10 @@ static void dxt_log_print_mpiio_file_darshan(void *file_rec,
             char *file_name, char *mnt_pt, char *fs_type);
 
 static void dxt_swap_file_record(struct dxt_file_record *file_rec);
-static void dxt_swap_file_record(struct dxt_file_record *file_rec);
+static int dxt_log_get_segments(darshan_fd fd, darshan_module_id mod_id,
+            int compact_flag, int64_t count, segment_info *segs);
+static int dxt_log_put_file(darshan_fd fd, darshan_module_id mod_id,
+            int ver, struct dxt_file_record *file_rec);
 
 struct darshan_mod_logutil_funcs dxt_posix_logutils =
 {
@@ -65,20 +68,248 @@ static void dxt_swap_file_record(struct dxt_file_record *file_rec)
     DARSHAN_BSWAP64(&file_rec->read_count);
 }
 
-static void dxt_swap_segments(struct dxt_file_record *file_rec)
+/* read the 'count' segments of a record into 'segs', decoding them from the
+ * compact encoding described by the dxt_segment_format that precedes them
+ * if 'compact_flag' is set
+ *
+ * returns 0 on success, -1 on failure
+ */
+static int dxt_log_get_segments(darshan_fd fd, darshan_module_id mod_id,
+    int compact_flag, int64_t count, segment_info *segs)
 {
-    int i;
-    segment_info *tmp_seg;
+    struct dxt_segment_format format;
+    int64_t seg_size = 0;
+    int64_t buf_size;
+    int64_t val, start_ticks;
+    uint32_t val32;
+    double res_s, t;
+    char *buf, *p;
+    int64_t i;
+    int field;
+    int ret;
+
+    if(!compact_flag)
+    {
+        buf_size = count * sizeof(segment_info);
+        if(buf_size == 0)
+            return(0);
+        ret = darshan_log_get_mod(fd, mod_id, segs, buf_size);
+        if(ret < buf_size)
+            return(-1);
+        if(fd->swap_flag)
+        {
+            /* byte swap trace data if necessary */
+            for(i = 0; i < count; i++)
+            {
+                DARSHAN_BSWAP64(&segs[i].offset);
+                DARSHAN_BSWAP64(&segs[i].length);
+                DARSHAN_BSWAP64(&segs[i].start_time);
+                DARSHAN_BSWAP64(&segs[i].end_time);
+            }
+        }
+        return(0);
+    }
+
+    ret = darshan_log_get_mod(fd, mod_id, &format, sizeof(format));
+    if(ret < (int)sizeof(format))
+        return(-1);
+    if(fd->swap_flag)
+    {
+        DARSHAN_BSWAP32(&format.fields);
+        DARSHAN_BSWAP32(&format.wide);
+        DARSHAN_BSWAP32(&format.time_res_ns);
+    }
+    if(format.fields == 0 || (format.fields & ~DXT_SEG_ALL_FIELDS))
+    {
+        fprintf(stderr, "Error: invalid DXT segment fields (got %#x)\n",
+            format.fields);
+        return(-1);
+    }
+
+    for(field = DXT_SEG_OFFSET; field <= DXT_SEG_END_TIME; field <<= 1)
+    {
+        if(!(format.fields & field))
+            continue;
+        if((field >= DXT_SEG_START_TIME && format.time_res_ns == 0) ||
+            (format.wide & field))
+            seg_size += 8;
+        else
+            seg_size += 4;
+    }
+
+    buf_size = count * seg_size;
+    if(buf_size == 0)
+        return(0);
+    buf = malloc(buf_size);
+    if(!buf)
+        return(-1);
+    ret = darshan_log_get_mod(fd, mod_id, buf, buf_size);
+    if(ret < buf_size)
+    {
+        free(buf);
+        return(-1);
+    }
 
-    tmp_seg = (segment_info *)((void *)file_rec + sizeof(struct dxt_file_record));
-    for(i = 0; i < (file_rec->write_count + file_rec->read_count); i++)
+    res_s = format.time_res_ns * 1e-9;
+    p = buf;
+    for(i = 0; i < count; i++)
     {
-        DARSHAN_BSWAP64(&tmp_seg->offset);
-        DARSHAN_BSWAP64(&tmp_seg->length);
-        DARSHAN_BSWAP64(&tmp_seg->start_time);
-        DARSHAN_BSWAP64(&tmp_seg->end_time);
-        tmp_seg++;
+        /* fields that were not recorded are left at -1 */
+        segs[i].offset = -1;
+        segs[i].length = -1;
+        segs[i].start_time = -1;
+        segs[i].end_time = -1;
+        start_ticks = 0;
+
+        for(field = DXT_SEG_OFFSET; field <= DXT_SEG_END_TIME; field <<= 1)
+        {
+            if(!(format.fields & field))
+                continue;
+            if(field >= DXT_SEG_START_TIME && format.time_res_ns == 0)
+            {
+                memcpy(&t, p, sizeof(t));
+                p += sizeof(t);
+                if(fd->swap_flag)
+                    DARSHAN_BSWAP64(&t);
+                if(field == DXT_SEG_START_TIME)
+                    segs[i].start_time = t;
+                else
+                    segs[i].end_time = t;
+                continue;
+            }
+            if(format.wide & field)
+            {
+                memcpy(&val, p, sizeof(val));
+                p += sizeof(val);
+                if(fd->swap_flag)
+                    DARSHAN_BSWAP64(&val);
+            }
+            else
+            {
+                memcpy(&val32, p, sizeof(val32));
+                p += sizeof(val32);
+                if(fd->swap_flag)
+                    DARSHAN_BSWAP32(&val32);
+                val = val32;
+            }
+            switch(field)
+            {
+                case DXT_SEG_OFFSET:
+                    segs[i].offset = val;
+                    break;
+                case DXT_SEG_LENGTH:
+                    segs[i].length = val;
+                    break;
+                case DXT_SEG_START_TIME:
+                    start_ticks = val;
+                    segs[i].start_time = val * res_s;
+                    break;
+                default:
+                    /* end times are relative to start times, if stored */
+                    segs[i].end_time = (start_ticks + val) * res_s;
+                    break;
+            }
+        }
     }
+
+    free(buf);
+    return(0);
+}
+
+/* write a DXT record with its segments in the compact encoding: fields that
+ * are -1 in every segment (i.e., that were not recorded) are left out, times
+ * are kept at full precision, and offsets and lengths take 4 bytes unless
+ * one of their values needs 8
+ *
+ * returns 0 on success, -1 on failure
+ */
+static int dxt_log_put_file(darshan_fd fd, darshan_module_id mod_id,
+    int ver, struct dxt_file_record *file_rec)
+{
+    segment_info *segs = (segment_info *)
+        ((void *)file_rec + sizeof(struct dxt_file_record));
+    int64_t count = file_rec->write_count + file_rec->read_count;
+    struct dxt_segment_format format;
+    uint32_t val32;
+    char *buf, *p;
+    int64_t i;
+    int ret;
+
+    memset(&format, 0, sizeof(format));
+    for(i = 0; i < count; i++)
+    {
+        if(segs[i].offset != -1)
+            format.fields |= DXT_SEG_OFFSET;
+        if(segs[i].length != -1)
+            format.fields |= DXT_SEG_LENGTH;
+        if(segs[i].start_time != -1)
+            format.fields |= DXT_SEG_START_TIME;
+        if(segs[i].end_time != -1)
+            format.fields |= DXT_SEG_END_TIME;
+        if(segs[i].offset < 0 || segs[i].offset > UINT32_MAX)
+            format.wide |= DXT_SEG_OFFSET;
+        if(segs[i].length < 0 || segs[i].length > UINT32_MAX)
+            format.wide |= DXT_SEG_LENGTH;
+    }
+    if(format.fields == 0)
+        format.fields = DXT_SEG_ALL_FIELDS;
+    format.wide = (format.wide | DXT_SEG_START_TIME | DXT_SEG_END_TIME) &
+        format.fields;
+
+    buf = malloc(sizeof(*file_rec) + sizeof(format) + count * sizeof(segment_info));
+    if(!buf)
+        return(-1);
+    memcpy(buf, file_rec, sizeof(*file_rec));
+    memcpy(buf + sizeof(*file_rec), &format, sizeof(format));
+    p = buf + sizeof(*file_rec) + sizeof(format);
+    for(i = 0; i < count; i++)
+    {
+        if(format.fields & DXT_SEG_OFFSET)
+        {
+            if(format.wide & DXT_SEG_OFFSET)
+            {
+                memcpy(p, &segs[i].offset, sizeof(int64_t));
+                p += sizeof(int64_t);
+            }
+            else
+            {
+                val32 = (uint32_t)segs[i].offset;
+                memcpy(p, &val32, sizeof(val32));
+                p += sizeof(val32);
+            }
+        }
+        if(format.fields & DXT_SEG_LENGTH)
+        {
+            if(format.wide & DXT_SEG_LENGTH)
+            {
+                memcpy(p, &segs[i].length, sizeof(int64_t));
+                p += sizeof(int64_t);
+            }
+            else
+            {
+                val32 = (uint32_t)segs[i].length;
+                memcpy(p, &val32, sizeof(val32));
+                p += sizeof(val32);
+            }
+        }
+        if(format.fields & DXT_SEG_START_TIME)
+        {
+            memcpy(p, &segs[i].start_time, sizeof(double));
+            p += sizeof(double);
+        }
+        if(format.fields & DXT_SEG_END_TIME)
+        {
+            memcpy(p, &segs[i].end_time, sizeof(double));
+            p += sizeof(double);
+        }
+    }
+
+    ret = darshan_log_put_mod(fd, mod_id, buf, p - buf, ver);
+    free(buf);
+    if(ret < 0)
+        return(-1);
+
+    return(0);
 }
 
 static int dxt_log_get_posix_file(darshan_fd fd, void** dxt_posix_buf_p)
@@ -123,28 +354,13 @@ static int dxt_log_get_posix_file(darshan_fd fd, void** dxt_posix_buf_p)
     }
     memcpy(rec, &tmp_rec, sizeof(struct dxt_file_record));
 
-    if (io_trace_size > 0)
-    {
-        void *tmp_p = (void *)rec + sizeof(struct dxt_file_record);
-
-        ret = darshan_log_get_mod(fd, DXT_POSIX_MOD, tmp_p,
-                    io_trace_size);
-        if (ret < io_trace_size)
-            ret = -1;
-        else
-        {
-            ret = 1;
-            if(fd->swap_flag)
-            {
-                /* byte swap trace data if necessary */
-                dxt_swap_segments(rec);
-            }
-        }
-    }
-    else
-    {
+    /* segments are stored compactly since version 2 */
+    ret = dxt_log_get_segments(fd, DXT_POSIX_MOD,
+        fd->mod_ver[DXT_POSIX_MOD] >= 2,
+        tmp_rec.write_count + tmp_rec.read_count,
+        (segment_info *)((void *)rec + sizeof(struct dxt_file_record)));
+    if(ret == 0)
         ret = 1;
-    }
 
     if(*dxt_posix_buf_p == NULL)
     {   
@@ -161,6 +377,7 @@ static int dxt_log_get_mpiio_file(darshan_fd fd, void** dxt_mpiio_buf_p)
 {
     struct dxt_file_record *rec = *((struct dxt_file_record **)dxt_mpiio_buf_p);
     struct dxt_file_record tmp_rec;
+    segment_info *tmp_p;
     int i;
     int ret;
     int64_t io_trace_size;
@@ -200,37 +417,23 @@ static int dxt_log_get_mpiio_file(darshan_fd fd, void** dxt_mpiio_buf_p)
     }
     memcpy(rec, &tmp_rec, sizeof(struct dxt_file_record));
 
-    if (io_trace_size > 0)
+    /* segments are stored compactly since version 3 */
+    tmp_p = (segment_info *)((void *)rec + sizeof(struct dxt_file_record));
+    ret = dxt_log_get_segments(fd, DXT_MPIIO_MOD,
+        fd->mod_ver[DXT_MPIIO_MOD] >= 3,
+        tmp_rec.write_count + tmp_rec.read_count, tmp_p);
+    if(ret == 0)
     {
-        void *tmp_p = (void *)rec + sizeof(struct dxt_file_record);
-
-        ret = darshan_log_get_mod(fd, DXT_MPIIO_MOD, tmp_p,
-                    io_trace_size);
-        if (ret < io_trace_size)
-            ret = -1;
-        else
+        ret = 1;
+        if(fd->mod_ver[DXT_MPIIO_MOD] == 1)
         {
-            ret = 1;
-            if(fd->swap_flag)
+            /* make sure to indicate offsets are invalid in version 1 */
+            for(i = 0; i < (tmp_rec.write_count + tmp_rec.read_count); i++)
             {
-                /* byte swap trace data if necessary */
-                dxt_swap_segments(rec);
-            }
-
-            if(fd->mod_ver[DXT_MPIIO_MOD] == 1)
-            {
-                /* make sure to indicate offsets are invalid in version 1 */
-                for(i = 0; i < (tmp_rec.write_count + tmp_rec.read_count); i++)
-                {
-                    ((segment_info *)tmp_p)[i].offset = -1;
-                }
+                tmp_p[i].offset = -1;
             }
         }
     }
-    else
-    {
-        ret = 1;
-    }
 
     if(*dxt_mpiio_buf_p == NULL)
     {
@@ -245,34 +448,14 @@ static int dxt_log_get_mpiio_file(darshan_fd fd, void** dxt_mpiio_buf_p)
 
 static int dxt_log_put_posix_file(darshan_fd fd, void* dxt_posix_buf)
 {
-    struct dxt_file_record *file_rec =
-                (struct dxt_file_record *)dxt_posix_buf;
-    int rec_size = sizeof(struct dxt_file_record) + (sizeof(segment_info) * 
-        (file_rec->write_count + file_rec->read_count));
-    int ret;
-
-    ret = darshan_log_put_mod(fd, DXT_POSIX_MOD, file_rec,
-                rec_size, DXT_POSIX_VER);
-    if(ret < 0)
-        return(-1);
-
-    return(0);
+    return(dxt_log_put_file(fd, DXT_POSIX_MOD, DXT_POSIX_VER,
+        (struct dxt_file_record *)dxt_posix_buf));
 }
 
 static int dxt_log_put_mpiio_file(darshan_fd fd, void* dxt_mpiio_buf)
 {
-    struct dxt_file_record *file_rec =
-                (struct dxt_file_record *)dxt_mpiio_buf;
-    int rec_size = sizeof(struct dxt_file_record) + (sizeof(segment_info) * 
-        (file_rec->write_count + file_rec->read_count));
-    int ret;
-
-    ret = darshan_log_put_mod(fd, DXT_MPIIO_MOD, file_rec,
-                rec_size, DXT_MPIIO_VER);
-    if(ret < 0)
-        return(-1);
-
-    return(0);
+    return(dxt_log_put_file(fd, DXT_MPIIO_MOD, DXT_MPIIO_VER,
+        (struct dxt_file_record *)dxt_mpiio_buf));
 }
 
 static void dxt_log_print_posix_file_darshan(void *file_rec, char *file_name,
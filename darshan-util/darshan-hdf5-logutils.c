@@ -43,6 +43,7 @@ char *h5d_f_counter_names[] = {
 #define DARSHAN_H5F_FILE_SIZE_2 56
 
 #define DARSHAN_H5D_DATASET_SIZE_1 904
+#define DARSHAN_H5D_DATASET_SIZE_2 912
 
 static int darshan_log_get_hdf5_file(darshan_fd fd, void** hdf5_buf_p);
 static int darshan_log_put_hdf5_file(darshan_fd fd, void* hdf5_buf);
@@ -229,8 +230,7 @@ static int darshan_log_get_hdf5_dataset(darshan_fd fd, void** hdf5_buf_p)
     {
         fprintf(stderr, "Error: Invalid H5D module version number (got %d)\n",
             fd->mod_ver[DARSHAN_H5D_MOD]);
-        ret = -1;
-        goto exit;
+        return(-1);
     }
 
     if(*hdf5_buf_p == NULL)
@@ -272,6 +272,24 @@ static int darshan_log_get_hdf5_dataset(darshan_fd fd, void** hdf5_buf_p)
             /* set FILE_REC_ID to 0 */
             *((uint64_t *)src_p) = 0;
         }
+        else
+        {
+            /* the version was checked above, so this is version 2 */
+            rec_len = DARSHAN_H5D_DATASET_SIZE_2;
+            ret = darshan_log_get_mod(fd, DARSHAN_H5D_MOD, scratch, rec_len);
+            if(ret != rec_len)
+                goto exit;
+        }
+
+        /* upconvert version 2 to version 3 in-place */
+        dest_p = scratch + sizeof(struct darshan_base_record) +
+            sizeof(uint64_t) + ((H5D_CHUNK_CACHE_OVERFLOWS + 1) * sizeof(int64_t));
+        src_p = dest_p - (7 * sizeof(int64_t));
+        len = H5D_F_NUM_INDICES * sizeof(double);
+        memmove(dest_p, src_p, len);
+        /* set H5D_CHUNK_CACHE_NBYTES through H5D_CHUNK_CACHE_OVERFLOWS to -1 */
+        for(i = 0; i < 7; i++)
+            *((int64_t *)(src_p + (i * sizeof(int64_t)))) = -1;
 
         memcpy(ds, scratch, sizeof(struct darshan_hdf5_dataset));
     }
@@ -302,7 +320,15 @@ exit:
             if(fd->mod_ver[DARSHAN_H5F_MOD] >= 2)
                 DARSHAN_BSWAP64(&ds->file_rec_id);
             for(i=0; i<H5D_NUM_INDICES; i++)
+            {
+                /* skip counters we explicitly set to -1 since they don't
+                 * need to be byte swapped
+                 */
+                if((fd->mod_ver[DARSHAN_H5D_MOD] <= 2) &&
+                    (i >= H5D_CHUNK_CACHE_NBYTES) && (i <= H5D_CHUNK_CACHE_OVERFLOWS))
+                    continue;
                 DARSHAN_BSWAP64(&ds->counters[i]);
+            }
             for(i=0; i<H5D_F_NUM_INDICES; i++)
                 DARSHAN_BSWAP64(&ds->fcounters[i]);
         }
@@ -443,6 +469,11 @@ static void darshan_log_print_hdf5_dataset_description(int ver)
     printf("#   H5D_USE_DEPRECATED: flag indicating whether deprecated H5D calls were used.\n");
     printf("#   H5D_*_RANK: rank of the processes that were the fastest and slowest at I/O (for shared datasets).\n");
     printf("#   H5D_*_RANK_BYTES: total bytes transferred at H5D layer by the fastest and slowest ranks (for shared datasets).\n");
+    printf("#   H5D_CHUNK_CACHE_NBYTES/NSLOTS: size in bytes and number of hash slots of the chunk cache (chunked datasets only).\n");
+    printf("#   H5D_FILTERS: number of filters in the dataset's filter pipeline.\n");
+    printf("#   H5D_COMPRESSION: flag indicating whether the filter pipeline includes a compression filter.\n");
+    printf("#   H5D_CHUNKS_READ/WRITTEN: estimated number of chunks touched by read and write operations.\n");
+    printf("#   H5D_CHUNK_CACHE_OVERFLOWS: number of operations touching more chunk data than fits in the chunk cache.\n");
     printf("#   H5D_F_*_START_TIMESTAMP: timestamp of first HDF5 dataset open/read/write/close.\n");
     printf("#   H5D_F_*_END_TIMESTAMP: timestamp of last HDF5 datset open/read/write/close.\n");
     printf("#   H5D_F_READ/WRITE/META_TIME: cumulative time spent in H5D read, write, or metadata operations.\n");
@@ -456,6 +487,17 @@ static void darshan_log_print_hdf5_dataset_description(int ver)
         printf("\n# WARNING: H5D module log format version 1 does not support the following counters:\n");
         printf("# - H5D_FILE_REC_ID\n");
     }
+    if(ver <= 2)
+    {
+        printf("\n# WARNING: H5D module log format version <=2 does not support the following counters:\n");
+        printf("# - H5D_CHUNK_CACHE_NBYTES\n");
+        printf("# - H5D_CHUNK_CACHE_NSLOTS\n");
+        printf("# - H5D_FILTERS\n");
+        printf("# - H5D_COMPRESSION\n");
+        printf("# - H5D_CHUNKS_READ\n");
+        printf("# - H5D_CHUNKS_WRITTEN\n");
+        printf("# - H5D_CHUNK_CACHE_OVERFLOWS\n");
+    }
 
     return;
 }
@@ -890,6 +932,23 @@ static void darshan_log_agg_hdf5_datasets(void *rec, void *agg_rec, int init_fla
                 if(hdf5_rec->counters[i] > 0)
                     agg_hdf5_rec->counters[i] = 1;
                 break;
+            case H5D_CHUNK_CACHE_NBYTES:
+            case H5D_CHUNK_CACHE_NSLOTS:
+            case H5D_FILTERS:
+            case H5D_COMPRESSION:
+                /* maximum */
+                if(hdf5_rec->counters[i] > agg_hdf5_rec->counters[i])
+                    agg_hdf5_rec->counters[i] = hdf5_rec->counters[i];
+                break;
+            case H5D_CHUNKS_READ:
+            case H5D_CHUNKS_WRITTEN:
+            case H5D_CHUNK_CACHE_OVERFLOWS:
+                /* sum, unless the value is unknown */
+                if(hdf5_rec->counters[i] < 0 || agg_hdf5_rec->counters[i] < 0)
+                    agg_hdf5_rec->counters[i] = -1;
+                else
+                    agg_hdf5_rec->counters[i] += hdf5_rec->counters[i];
+                break;
             default:
                 agg_hdf5_rec->counters[i] = -1;
                 break;
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "darshan-logutils.h"
+
+/* counter name strings for the IMBALANCE module */
+#define X(a) #a,
+char *imbalance_counter_names[] = {
+    IMBALANCE_COUNTERS
+};
+
+char *imbalance_f_counter_names[] = {
+    IMBALANCE_F_COUNTERS
+};
+#undef X
+
+static int darshan_log_get_imbalance_rec(darshan_fd fd, void** imbalance_buf_p);
+static int darshan_log_put_imbalance_rec(darshan_fd fd, void* imbalance_buf);
+static void darshan_log_print_imbalance_rec(void *file_rec,
+    char *file_name, char *mnt_pt, char *fs_type);
+static void darshan_log_print_imbalance_description(int ver);
+static void darshan_log_print_imbalance_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2);
+
+struct darshan_mod_logutil_funcs imbalance_logutils =
+{
+    .log_get_record = &darshan_log_get_imbalance_rec,
+    .log_put_record = &darshan_log_put_imbalance_rec,
+    .log_print_record = &darshan_log_print_imbalance_rec,
+    .log_print_description = &darshan_log_print_imbalance_description,
+    .log_print_diff = &darshan_log_print_imbalance_rec_diff,
+    .log_agg_records = NULL
+};
+
+static int darshan_log_get_imbalance_rec(darshan_fd fd, void** imbalance_buf_p)
+{
+    struct darshan_imbalance_record *rec = *((struct darshan_imbalance_record **)imbalance_buf_p);
+    int rec_len;
+    int i;
+    int ret = -1;
+
+    if(fd->mod_map[DARSHAN_IMBALANCE_MOD].len == 0)
+        return(0);
+
+    if(fd->mod_ver[DARSHAN_IMBALANCE_MOD] == 0 ||
+        fd->mod_ver[DARSHAN_IMBALANCE_MOD] > DARSHAN_IMBALANCE_VER)
+    {
+        fprintf(stderr, "Error: Invalid IMBALANCE module version number (got %d)\n",
+            fd->mod_ver[DARSHAN_IMBALANCE_MOD]);
+        return(-1);
+    }
+
+    if(*imbalance_buf_p == NULL)
+    {
+        rec = malloc(sizeof(*rec));
+        if(!rec)
+            return(-1);
+    }
+
+    rec_len = sizeof(struct darshan_imbalance_record);
+    ret = darshan_log_get_mod(fd, DARSHAN_IMBALANCE_MOD, rec, rec_len);
+
+    if(*imbalance_buf_p == NULL)
+    {
+        if(ret == rec_len)
+            *imbalance_buf_p = rec;
+        else
+            free(rec);
+    }
+
+    if(ret < 0)
+        return(-1);
+    else if(ret < rec_len)
+        return(0);
+    else
+    {
+        if(fd->swap_flag)
+        {
+            /* swap bytes if necessary */
+            DARSHAN_BSWAP64(&(rec->base_rec.id));
+            DARSHAN_BSWAP64(&(rec->base_rec.rank));
+            for(i=0; i<IMBALANCE_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->counters[i]);
+            for(i=0; i<IMBALANCE_F_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->fcounters[i]);
+        }
+
+        return(1);
+    }
+}
+
+static int darshan_log_put_imbalance_rec(darshan_fd fd, void* imbalance_buf)
+{
+    struct darshan_imbalance_record *rec = (struct darshan_imbalance_record *)imbalance_buf;
+    int ret;
+
+    ret = darshan_log_put_mod(fd, DARSHAN_IMBALANCE_MOD, rec,
+        sizeof(struct darshan_imbalance_record), DARSHAN_IMBALANCE_VER);
+    if(ret < 0)
+        return(-1);
+
+    return(0);
+}
+
+static void darshan_log_print_imbalance_rec(void *file_rec, char *file_name,
+    char *mnt_pt, char *fs_type)
+{
+    int i;
+    struct darshan_imbalance_record *imbalance_rec =
+        (struct darshan_imbalance_record *)file_rec;
+
+    for(i=0; i<IMBALANCE_NUM_INDICES; i++)
+    {
+        DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+            imbalance_rec->base_rec.rank, imbalance_rec->base_rec.id,
+            imbalance_counter_names[i], imbalance_rec->counters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    for(i=0; i<IMBALANCE_F_NUM_INDICES; i++)
+    {
+        DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+            imbalance_rec->base_rec.rank, imbalance_rec->base_rec.id,
+            imbalance_f_counter_names[i], imbalance_rec->fcounters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    return;
+}
+
+static void darshan_log_print_imbalance_description(int ver)
+{
+    printf("\n# description of IMBALANCE counters:\n");
+    printf("#   IMBALANCE_*: distribution across nodes (or ranks) of the I/O time and\n");
+    printf("#       bytes of a record shared by all ranks. Records are named after the\n");
+    printf("#       shared record they describe. The I/O time of a node is that of its\n");
+    printf("#       slowest rank (read, write and meta time), its bytes are summed over\n");
+    printf("#       its ranks, and a node is identified by its lowest rank.\n");
+    printf("#   IMBALANCE_MODULE: id of the module the shared record belongs to.\n");
+    printf("#   IMBALANCE_BY_NODE: 1 if units are nodes, 0 if units are ranks.\n");
+    printf("#   IMBALANCE_UNITS: number of nodes (or ranks).\n");
+    printf("#   IMBALANCE_MAX_BYTES: largest bytes read and written by a unit.\n");
+    printf("#   IMBALANCE_TIME_BIN_*, IMBALANCE_BYTES_BIN_*: number of units whose time\n");
+    printf("#       (bytes) falls within [i/16, (i+1)/16) of the largest; the last bin\n");
+    printf("#       includes the largest.\n");
+    printf("#   IMBALANCE_SLOWEST_*_RANK, IMBALANCE_SLOWEST_*_BYTES: rank and bytes of the\n");
+    printf("#       slowest units, slowest first (-1 if there are fewer units).\n");
+    printf("#   IMBALANCE_F_MAX_TIME, IMBALANCE_F_MEAN_TIME: largest and mean unit time.\n");
+    printf("#   IMBALANCE_F_SLOWEST_*_TIME: time of the slowest units.\n");
+
+    return;
+}
+
+static void darshan_log_print_imbalance_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2)
+{
+    struct darshan_imbalance_record *file1 = (struct darshan_imbalance_record *)file_rec1;
+    struct darshan_imbalance_record *file2 = (struct darshan_imbalance_record *)file_rec2;
+    int i;
+
+    /* NOTE: we assume that both input records are the same module format version */
+
+    for(i=0; i<IMBALANCE_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file1->base_rec.rank, file1->base_rec.id, imbalance_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file2->base_rec.rank, file2->base_rec.id, imbalance_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+        else if(file1->counters[i] != file2->counters[i])
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file1->base_rec.rank, file1->base_rec.id, imbalance_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file2->base_rec.rank, file2->base_rec.id, imbalance_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+    }
+
+    for(i=0; i<IMBALANCE_F_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file1->base_rec.rank, file1->base_rec.id, imbalance_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file2->base_rec.rank, file2->base_rec.id, imbalance_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+        else if(file1->fcounters[i] != file2->fcounters[i])
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file1->base_rec.rank, file1->base_rec.id, imbalance_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_IMBALANCE_MOD],
+                file2->base_rec.rank, file2->base_rec.id, imbalance_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+    }
+
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
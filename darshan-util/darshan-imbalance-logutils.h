@@ -0,0 +1,15 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_IMBALANCE_LOG_UTILS_H
+#define __DARSHAN_IMBALANCE_LOG_UTILS_H
+
+extern char *imbalance_counter_names[];
+extern char *imbalance_f_counter_names[];
+
+extern struct darshan_mod_logutil_funcs imbalance_logutils;
+
+#endif
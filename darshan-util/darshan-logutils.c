@@ -10,6 +10,7 @@
 
 #define _GNU_SOURCE
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
 #include <assert.h>
 #include <stdlib.h>
@@ -51,6 +52,13 @@ struct darshan_dz_state
     int eor;
     /* the region id we last tried reading/writing */
     int prev_reg_id;
+    /* for reading logs, whether the region being read is checked against
+     * its checksum, the expected checksum, and the checksum of the data
+     * read from the region so far
+     */
+    int crc_check;
+    uint32_t crc_expected;
+    uLong crc;
 };
 
 /* internal fd data structure */
@@ -73,6 +81,12 @@ struct darshan_fd_int_state
      */
     int (*get_namerecs)(void *, int, int, struct darshan_name_record_ref **,
                         darshan_record_id *, int);
+    /* flag indicating whether the log was opened for salvaging, in which
+     * case reads stop quietly at damaged data rather than failing
+     */
+    int salvage_flag;
+    /* where to record damage to the header when opening for salvaging */
+    struct darshan_log_damage *damage;
 
     /* compression/decompression stream read/write state */
     struct darshan_dz_state dz;
@@ -93,6 +107,12 @@ static int darshan_log_get_namerecs(void *name_rec_buf, int buf_len,
     darshan_record_id *whitelist, int whitelist_count);
 static int darshan_log_get_format_version(char *ver_str, int *maj_num, int *min_num);
 static int darshan_log_get_header(darshan_fd fd);
+static int darshan_log_check_maps(darshan_fd fd, struct darshan_log_damage *damage);
+static int darshan_log_check_checksums(darshan_fd fd, struct darshan_log_damage *damage);
+static uint32_t *darshan_log_map_checksum(darshan_fd fd, struct darshan_log_map *map_p);
+static int darshan_log_region_crc(darshan_fd fd, struct darshan_log_map *map_p, uLong *crc_p);
+static darshan_fd darshan_log_open_internal(const char *name,
+    struct darshan_log_damage *damage);
 static int darshan_log_put_header(darshan_fd fd);
 static int darshan_log_seek(darshan_fd fd, off_t offset);
 static int darshan_log_read(darshan_fd fd, void *buf, int len);
@@ -136,6 +156,15 @@ static char *darshan_util_lib_ver = PACKAGE_VERSION;
  * returns file descriptor on success, NULL on failure
  */
 darshan_fd darshan_log_open(const char *name)
+{
+    return(darshan_log_open_internal(name, NULL));
+}
+
+/* open a darshan log file for reading; a header that does not match its
+ * checksum fails the open, unless 'damage' is given to record it in
+ */
+static darshan_fd darshan_log_open_internal(const char *name,
+    struct darshan_log_damage *damage)
 {
     darshan_fd tmp_fd;
     int ret;
@@ -157,20 +186,21 @@ darshan_fd darshan_log_open(const char *name)
     tmp_fd->state->fildes = open(name, O_RDONLY);
     if(tmp_fd->state->fildes < 0)
     {
-        fprintf(stderr, "Error: %s failed to open darshan log file %s: %s.\n", __func__,
+        fprintf(stderr, "Error: darshan_log_open failed to open darshan log file %s: %s.\n",
                 name, strerror(errno));
         free(tmp_fd->state);
         free(tmp_fd);
         return(NULL);
     }
     strncpy(tmp_fd->state->logfile_path, name, __DARSHAN_PATH_MAX);
+    tmp_fd->state->damage = damage;
 
     /* read the header from the log file to init fd data structures */
     ret = darshan_log_get_header(tmp_fd);
     if(ret < 0)
     {
-        fprintf(stderr, "Error: %s failed to read darshan log file header: %s.\n",
-                __func__, strerror(errno));
+        fprintf(stderr, "Error: darshan_log_open failed to read darshan log file header: %s.\n",
+                strerror(errno));
         close(tmp_fd->state->fildes);
         free(tmp_fd->state);
         free(tmp_fd);
@@ -191,6 +221,79 @@ darshan_fd darshan_log_open(const char *name)
     return(tmp_fd);
 }
 
+/* darshan_log_open_salvage()
+ *
+ * open an existing, possibly damaged, darshan log file for reading only.
+ * The region maps stored in the log header are checked against the size
+ * of the file: regions that run past the end of the file are cut short,
+ * and regions that start past the end of the file or overlap another
+ * region are ignored. Regions of logs that carry checksums are then
+ * verified against them, and a header that does not match its checksum
+ * does not fail the open. The outcome for each region is returned in
+ * 'damage'. Reads of name records from the returned file descriptor keep
+ * every complete record found ahead of damaged data.
+ *
+ * returns file descriptor on success, NULL on failure
+ */
+darshan_fd darshan_log_open_salvage(const char *name,
+    struct darshan_log_damage *damage)
+{
+    darshan_fd tmp_fd;
+    int ret;
+
+    memset(damage, 0, sizeof(*damage));
+
+    tmp_fd = darshan_log_open_internal(name, damage);
+    if(!tmp_fd)
+        return(NULL);
+    tmp_fd->state->damage = NULL;
+
+    ret = darshan_log_check_maps(tmp_fd, damage);
+    if(ret == 0)
+        ret = darshan_log_check_checksums(tmp_fd, damage);
+    if(ret < 0)
+    {
+        fprintf(stderr, "Error: unable to check darshan log file regions.\n");
+        darshan_log_close(tmp_fd);
+        return(NULL);
+    }
+    tmp_fd->state->salvage_flag = 1;
+
+    return(tmp_fd);
+}
+
+/* darshan_log_verify()
+ *
+ * check the header and region maps of a darshan log file, and the
+ * checksums of its header and regions if the log carries them, without
+ * decompressing any of its data. The outcome for each region is returned
+ * in 'damage'.
+ *
+ * returns 0 if the log is intact, 1 if it is damaged, -1 on failure
+ */
+int darshan_log_verify(const char *name, struct darshan_log_damage *damage)
+{
+    darshan_fd tmp_fd;
+    int i;
+
+    tmp_fd = darshan_log_open_salvage(name, damage);
+    if(!tmp_fd)
+        return(-1);
+    darshan_log_close(tmp_fd);
+
+    if(damage->header_status != DARSHAN_REGION_INTACT ||
+        damage->job_status != DARSHAN_REGION_INTACT ||
+        damage->name_status != DARSHAN_REGION_INTACT)
+        return(1);
+    for(i = 0; i < DARSHAN_MAX_MODS; i++)
+    {
+        if(damage->mod_status[i] != DARSHAN_REGION_INTACT)
+            return(1);
+    }
+
+    return(0);
+}
+
 /* darshan_log_create()
  *
  * create a darshan log file for writing with the given compression method
@@ -284,6 +387,9 @@ int darshan_log_get_job(darshan_fd fd, struct darshan_job *job)
     }
     state = fd->state;
     assert(state);
+    /* the job region of a salvaged log may be missing altogether */
+    if(state->salvage_flag && fd->job_map.len == 0)
+        return(-1);
     assert(fd->job_map.len > 0 && fd->job_map.off > 0);
 
     /* get major/minor version numbers */
@@ -668,6 +774,9 @@ int darshan_log_get_filtered_namehash(darshan_fd fd,
             name_rec_buf + buf_len, read_req_sz);
         if(read < 0)
         {
+            /* keep the name records read ahead of damaged data */
+            if(state->salvage_flag)
+                break;
             fprintf(stderr, "Error: failed to read name hash from darshan log file.\n");
             free(name_rec_buf);
             return(-1);
@@ -686,7 +795,8 @@ int darshan_log_get_filtered_namehash(darshan_fd fd,
          * read all of the record hash
          */
     } while(read == read_req_sz);
-    assert(buf_len == 0);
+    /* a name record cut short in a damaged log is dropped */
+    assert(buf_len == 0 || state->salvage_flag);
 
     free(name_rec_buf);
     return(0);
@@ -1082,10 +1192,14 @@ static int darshan_log_get_format_version(char *ver_str, int *maj_num, int *min_
 static int darshan_log_get_header(darshan_fd fd)
 {
     struct darshan_header header;
+    struct darshan_header raw_header;
     int log_ver_maj, log_ver_min;
+    uint32_t crc;
     int i;
     int ret;
 
+    memset(&raw_header, 0, sizeof(raw_header));
+
     ret = darshan_log_seek(fd, 0);
     if(ret < 0)
     {
@@ -1118,7 +1232,8 @@ static int darshan_log_get_header(darshan_fd fd)
                 ((log_ver_min == 10) ||
                  (log_ver_min == 20) ||
                  (log_ver_min == 21) ||
-                 (log_ver_min == 41)))
+                 (log_ver_min == 41) ||
+                 (log_ver_min == 42)))
     {
         fd->state->get_namerecs = darshan_log_get_namerecs;
     }
@@ -1140,7 +1255,8 @@ static int darshan_log_get_header(darshan_fd fd)
 
     /* read uncompressed header from log file */
     /* NOTE: header bumped from 16 to 64 modules at log ver 3.41 */
-    if(((log_ver_maj == 3) && (log_ver_min >= 41)) || (log_ver_maj > 3))
+    /* NOTE: region checksums added to header at log ver 3.42 */
+    if(((log_ver_maj == 3) && (log_ver_min >= 42)) || (log_ver_maj > 3))
     {
         ret = darshan_log_read(fd, &header, sizeof(header));
         if(ret != (int)sizeof(header))
@@ -1148,9 +1264,24 @@ static int darshan_log_get_header(darshan_fd fd)
             fprintf(stderr, "Error: failed to read darshan log file header.\n");
             return(-1);
         }
+        memcpy(&raw_header, &header, sizeof(header));
 
         fd->job_map.off = sizeof(struct darshan_header);
     }
+    else if((log_ver_maj == 3) && (log_ver_min == 41))
+    {
+        size_t header_3_41_sz = offsetof(struct darshan_header, checksums);
+
+        memset(&header, 0, sizeof(header));
+        ret = darshan_log_read(fd, &header, header_3_41_sz);
+        if(ret != (int)header_3_41_sz)
+        {
+            fprintf(stderr, "Error: failed to read darshan log file header.\n");
+            return(-1);
+        }
+
+        fd->job_map.off = header_3_41_sz;
+    }
     else
     {
         /* backwards compatibility with 3.00 version of Darshan header */
@@ -1209,7 +1340,12 @@ static int darshan_log_get_header(darshan_fd fd)
                 DARSHAN_BSWAP64(&(header.mod_map[i].off));
                 DARSHAN_BSWAP64(&(header.mod_map[i].len));
                 DARSHAN_BSWAP32(&(header.mod_ver[i]));
+                DARSHAN_BSWAP32(&(header.checksums.mod[i]));
             }
+            DARSHAN_BSWAP32(&(header.checksums.type));
+            DARSHAN_BSWAP32(&(header.checksums.header));
+            DARSHAN_BSWAP32(&(header.checksums.job));
+            DARSHAN_BSWAP32(&(header.checksums.name));
         }
         else
         {
@@ -1219,10 +1355,37 @@ static int darshan_log_get_header(darshan_fd fd)
         }
     }
 
+    if(header.checksums.type == DARSHAN_CRC32_CHECKSUM)
+    {
+        /* the header checksum covers the header as stored in the file,
+         * with the checksum itself zeroed
+         */
+        raw_header.checksums.header = 0;
+        crc = crc32(0L, (Bytef *)&raw_header, sizeof(raw_header));
+        if(crc != header.checksums.header)
+        {
+            if(fd->state->damage)
+            {
+                fd->state->damage->header_status = DARSHAN_REGION_CORRUPT;
+            }
+            else
+            {
+                fprintf(stderr, "Error: darshan log file header does not match its checksum.\n");
+                return(-1);
+            }
+        }
+    }
+    else if(header.checksums.type != DARSHAN_NO_CHECKSUM)
+    {
+        /* a checksum method we don't know, ignore the checksums */
+        memset(&header.checksums, 0, sizeof(header.checksums));
+    }
+
     /* set some fd fields based on what's stored in the header */
     fd->comp_type = header.comp_type;
     fd->partial_flag = header.partial_flag;
     memcpy(fd->mod_ver, header.mod_ver, DARSHAN_MAX_MODS * sizeof(uint32_t));
+    memcpy(&fd->checksums, &header.checksums, sizeof(header.checksums));
 
     /* save the mapping of data within log file to this file descriptor */
     memcpy(&fd->name_map, &(header.name_map), sizeof(struct darshan_log_map));
@@ -1302,6 +1465,167 @@ static int darshan_log_get_header(darshan_fd fd)
     return(0);
 }
 
+/* check the region maps read from the log header against the size of
+ * the log file, cutting short regions that run past the end of the file
+ * and dropping regions that start past it or overlap an earlier region
+ *
+ * returns 0 on success, -1 on failure
+ */
+static int darshan_log_check_maps(darshan_fd fd, struct darshan_log_damage *damage)
+{
+    struct darshan_log_map *maps[DARSHAN_MAX_MODS+2];
+    enum darshan_region_status *status[DARSHAN_MAX_MODS+2];
+    struct stat sbuf;
+    int64_t file_size;
+    int64_t off, len, end;
+    int i, j;
+
+    if(fstat(fd->state->fildes, &sbuf) != 0)
+        return(-1);
+    file_size = sbuf.st_size;
+
+    damage->file_size = file_size;
+
+    /* regions are listed in the order they are laid out in the log */
+    maps[0] = &fd->job_map;
+    status[0] = &damage->job_status;
+    maps[1] = &fd->name_map;
+    status[1] = &damage->name_status;
+    for(i = 0; i < DARSHAN_MAX_MODS; i++)
+    {
+        maps[i+2] = &fd->mod_map[i];
+        status[i+2] = &damage->mod_status[i];
+    }
+
+    for(i = 0; i < DARSHAN_MAX_MODS+2; i++)
+    {
+        off = (int64_t)maps[i]->off;
+        len = (int64_t)maps[i]->len;
+        if(len == 0)
+            continue;
+
+        if(off < (int64_t)fd->job_map.off || off >= file_size || len < 0 ||
+            (i >= 2 && i-2 >= DARSHAN_KNOWN_MODULE_COUNT))
+        {
+            *status[i] = DARSHAN_REGION_INVALID;
+        }
+        else
+        {
+            for(j = 0; j < i; j++)
+            {
+                /* regions dropped or emptied above can't overlap */
+                if(maps[j]->len == 0)
+                    continue;
+                end = (int64_t)(maps[j]->off + maps[j]->len);
+                if(off < end && (int64_t)maps[j]->off < off + len)
+                {
+                    *status[i] = DARSHAN_REGION_INVALID;
+                    break;
+                }
+            }
+            if(*status[i] == DARSHAN_REGION_INTACT && len > file_size - off)
+            {
+                *status[i] = DARSHAN_REGION_TRUNCATED;
+                maps[i]->len = file_size - off;
+            }
+        }
+
+        if(*status[i] == DARSHAN_REGION_INVALID)
+        {
+            maps[i]->off = 0;
+            maps[i]->len = 0;
+        }
+    }
+
+    return(0);
+}
+
+/* check the data of each intact region against its checksum, if the log
+ * carries checksums, marking the regions that don't match as corrupt.
+ * Only the compressed data is read, it is never decompressed.
+ *
+ * returns 0 on success, -1 on failure
+ */
+static int darshan_log_check_checksums(darshan_fd fd, struct darshan_log_damage *damage)
+{
+    struct darshan_log_map *maps[DARSHAN_MAX_MODS+2];
+    enum darshan_region_status *status[DARSHAN_MAX_MODS+2];
+    uLong crc;
+    int i;
+    int ret;
+
+    damage->checksum_type = fd->checksums.type;
+    if(fd->checksums.type != DARSHAN_CRC32_CHECKSUM)
+        return(0);
+
+    maps[0] = &fd->job_map;
+    status[0] = &damage->job_status;
+    maps[1] = &fd->name_map;
+    status[1] = &damage->name_status;
+    for(i = 0; i < DARSHAN_MAX_MODS; i++)
+    {
+        maps[i+2] = &fd->mod_map[i];
+        status[i+2] = &damage->mod_status[i];
+    }
+
+    for(i = 0; i < DARSHAN_MAX_MODS+2; i++)
+    {
+        if(maps[i]->len == 0 || *status[i] != DARSHAN_REGION_INTACT)
+            continue;
+
+        ret = darshan_log_region_crc(fd, maps[i], &crc);
+        if(ret < 0)
+            return(-1);
+
+        if(crc != *darshan_log_map_checksum(fd, maps[i]))
+            *status[i] = DARSHAN_REGION_CORRUPT;
+    }
+
+    return(0);
+}
+
+/* compute the checksum of the compressed data of the given log file region,
+ * staging it through the decompression buffer
+ *
+ * returns 0 on success, -1 on failure
+ */
+static int darshan_log_region_crc(darshan_fd fd, struct darshan_log_map *map_p, uLong *crc_p)
+{
+    uint64_t remaining;
+    unsigned int read_size;
+    int ret;
+
+    ret = darshan_log_seek(fd, map_p->off);
+    if(ret < 0)
+        return(-1);
+
+    *crc_p = crc32(0L, Z_NULL, 0);
+    remaining = map_p->len;
+    while(remaining > 0)
+    {
+        read_size = (remaining > DARSHAN_DEF_COMP_BUF_SZ) ?
+            DARSHAN_DEF_COMP_BUF_SZ : remaining;
+        ret = darshan_log_read(fd, fd->state->dz.buf, read_size);
+        if(ret != (int)read_size)
+            return(-1);
+        *crc_p = crc32(*crc_p, fd->state->dz.buf, read_size);
+        remaining -= read_size;
+    }
+
+    return(0);
+}
+
+/* returns a pointer to the checksum of the given log file region */
+static uint32_t *darshan_log_map_checksum(darshan_fd fd, struct darshan_log_map *map_p)
+{
+    if(map_p == &fd->job_map)
+        return(&fd->checksums.job);
+    else if(map_p == &fd->name_map)
+        return(&fd->checksums.name);
+    else
+        return(&fd->checksums.mod[map_p - fd->mod_map]);
+}
+
 /* write a darshan header to log file
  *
  * returns 0 on success, -1 on failure
@@ -1327,6 +1651,12 @@ static int darshan_log_put_header(darshan_fd fd)
     memcpy(header.mod_map, fd->mod_map, DARSHAN_MAX_MODS * sizeof(struct darshan_log_map));
     memcpy(header.mod_ver, fd->mod_ver, DARSHAN_MAX_MODS * sizeof(uint32_t));
 
+    /* region checksums were computed as the regions were written */
+    memcpy(&header.checksums, &fd->checksums, sizeof(header.checksums));
+    header.checksums.type = DARSHAN_CRC32_CHECKSUM;
+    header.checksums.header = 0;
+    header.checksums.header = crc32(0L, (Bytef *)&header, sizeof(header));
+
     /* write header to file */
     ret = darshan_log_write(fd, &header, sizeof(header));
     if(ret != (int)sizeof(header))
@@ -1546,20 +1876,33 @@ static int darshan_log_dzread(darshan_fd fd, int region_id, void *buf, int len)
     int reset_strm_flag = 0;
     int ret;
 
+    if(region_id == DARSHAN_JOB_REGION_ID)
+        map = fd->job_map;
+    else if(region_id == DARSHAN_NAME_MAP_REGION_ID)
+        map = fd->name_map;
+    else
+        map = fd->mod_map[region_id];
+
     /* if new log region, we reload buffers and clear eor flag */
     if(region_id != state->dz.prev_reg_id)
     {
         state->dz.eor = 0;
         state->dz.size = 0;
         reset_strm_flag = 1; /* reset libz/bzip2 streams */
-    }
 
-    if(region_id == DARSHAN_JOB_REGION_ID)
-        map = fd->job_map;
-    else if(region_id == DARSHAN_NAME_MAP_REGION_ID)
-        map = fd->name_map;
-    else
-        map = fd->mod_map[region_id];
+        /* regions of salvaged logs have been checked already, and may
+         * have been cut short
+         */
+        state->dz.crc_check = (fd->checksums.type == DARSHAN_CRC32_CHECKSUM) &&
+            !state->salvage_flag;
+        if(region_id == DARSHAN_JOB_REGION_ID)
+            state->dz.crc_expected = fd->checksums.job;
+        else if(region_id == DARSHAN_NAME_MAP_REGION_ID)
+            state->dz.crc_expected = fd->checksums.name;
+        else
+            state->dz.crc_expected = fd->checksums.mod[region_id];
+        state->dz.crc = crc32(0L, Z_NULL, 0);
+    }
 
     switch(fd->comp_type)
     {
@@ -2028,6 +2371,32 @@ static int darshan_log_dzload(darshan_fd fd, struct darshan_log_map map)
     int ret;
     unsigned int remaining;
     unsigned int read_size;
+    uLong crc;
+
+    /* regions that do not fit in the staging buffer are checked in full
+     * before any of their data is decompressed, so that none of it is
+     * returned if it does not match its checksum; smaller regions are
+     * checked below, as they are loaded
+     */
+    if(state->dz.crc_check && map.len > DARSHAN_DEF_COMP_BUF_SZ &&
+       ((state->pos <= map.off) || (state->pos >= (map.off + map.len))))
+    {
+        ret = darshan_log_region_crc(fd, &map, &crc);
+        if(ret < 0)
+        {
+            fprintf(stderr, "Error: unable to read compressed data from file.\n");
+            return(-1);
+        }
+        if(crc != state->dz.crc_expected)
+        {
+            fprintf(stderr, "Error: darshan log file region does not match its checksum.\n");
+            return(-1);
+        }
+        /* the region has been read through, so it is read again from its
+         * start below
+         */
+        state->dz.crc_check = 0;
+    }
 
     /* seek to the appropriate portion of the log file, if out of range */
     if((state->pos < map.off) || (state->pos >= (map.off + map.len)))
@@ -2038,6 +2407,8 @@ static int darshan_log_dzload(darshan_fd fd, struct darshan_log_map map)
             fprintf(stderr, "Error: unable to seek in darshan log file.\n");
             return(-1);
         }
+        /* (re)starting to read the region */
+        state->dz.crc = crc32(0L, Z_NULL, 0);
     }
 
     /* read more compressed data from file to staging buffer */
@@ -2052,9 +2423,19 @@ static int darshan_log_dzload(darshan_fd fd, struct darshan_log_map map)
         return(-1);
     }
 
+    if(state->dz.crc_check)
+        state->dz.crc = crc32(state->dz.crc, state->dz.buf, read_size);
+
     if(ret == (int)remaining)
     {
         state->dz.eor = 1;
+
+        /* the whole region has been read, make sure it is intact */
+        if(state->dz.crc_check && state->dz.crc != state->dz.crc_expected)
+        {
+            fprintf(stderr, "Error: darshan log file region does not match its checksum.\n");
+            return(-1);
+        }
     }
     state->dz.size = read_size;
     return(0);
@@ -2063,11 +2444,14 @@ static int darshan_log_dzload(darshan_fd fd, struct darshan_log_map map)
 static int darshan_log_dzunload(darshan_fd fd, struct darshan_log_map *map_p)
 {
     struct darshan_fd_int_state *state = fd->state;
+    uint32_t *crc_p = darshan_log_map_checksum(fd, map_p);
     int ret;
 
     /* initialize map structure for this log region */
     if(map_p->off == 0)
         map_p->off = state->pos;
+    if(map_p->len == 0)
+        *crc_p = crc32(0L, Z_NULL, 0);
 
     /* write more compressed data from staging buffer to file */
     ret = darshan_log_write(fd, state->dz.buf, state->dz.size);
@@ -2076,6 +2460,7 @@ static int darshan_log_dzunload(darshan_fd fd, struct darshan_log_map *map_p)
         fprintf(stderr, "Error: unable to write compressed data to file.\n");
         return(-1);
     }
+    *crc_p = crc32(*crc_p, state->dz.buf, state->dz.size);
 
     map_p->len += state->dz.size;
     state->dz.size = 0;
@@ -40,6 +40,8 @@ struct darshan_fd_s
     struct darshan_log_map mod_map[DARSHAN_MAX_MODS];
     /* module-specific log-format versions contained in log */
     uint32_t mod_ver[DARSHAN_MAX_MODS];
+    /* checksums of each log file region (if type is set) */
+    struct darshan_log_checksums checksums;
 
     /* KEEP OUT -- remaining state hidden in logutils source */
     struct darshan_fd_int_state *state;
@@ -80,6 +82,33 @@ struct darshan_mod_info
     int partial_flag;
 };
 
+/* status of a log file region, as found by darshan_log_open_salvage() */
+enum darshan_region_status
+{
+    DARSHAN_REGION_INTACT = 0,
+    /* region runs past the end of the log file */
+    DARSHAN_REGION_TRUNCATED,
+    /* region starts past the end of the log file, overlaps another
+     * region, or belongs to an unknown module
+     */
+    DARSHAN_REGION_INVALID,
+    /* region data does not match its checksum */
+    DARSHAN_REGION_CORRUPT
+};
+
+/* damage found in the region maps and checksums of a log file */
+struct darshan_log_damage
+{
+    int64_t file_size;
+    /* checksums the regions were verified against, if any */
+    enum darshan_checksum_type checksum_type;
+    /* the header can only be intact or corrupt */
+    enum darshan_region_status header_status;
+    enum darshan_region_status job_status;
+    enum darshan_region_status name_status;
+    enum darshan_region_status mod_status[DARSHAN_MAX_MODS];
+};
+
 struct darshan_name_record_info
 {
     darshan_record_id id;
@@ -183,6 +212,11 @@ extern struct darshan_mod_logutil_funcs *mod_logutils[];
 #include "darshan-lustre-logutils.h"
 #include "darshan-stdio-logutils.h"
 #include "darshan-heatmap-logutils.h"
+#include "darshan-procio-logutils.h"
+#include "darshan-nfs-logutils.h"
+#include "darshan-custom-logutils.h"
+#include "darshan-snapshot-logutils.h"
+#include "darshan-imbalance-logutils.h"
 
 /* DXT */
 #include "darshan-dxt-logutils.h"
@@ -196,6 +230,9 @@ extern struct darshan_mod_logutil_funcs *mod_logutils[];
 #endif
 
 darshan_fd darshan_log_open(const char *name);
+darshan_fd darshan_log_open_salvage(const char *name,
+    struct darshan_log_damage *damage);
+int darshan_log_verify(const char *name, struct darshan_log_damage *damage);
 darshan_fd darshan_log_create(const char *name, enum darshan_comp_type comp_type,
     int partial_flag);
 int darshan_log_get_job(darshan_fd fd, struct darshan_job *job);
@@ -36,6 +36,7 @@ char *mpiio_f_counter_names[] = {
 #undef X
 
 #define DARSHAN_MPIIO_FILE_SIZE_1 544
+#define DARSHAN_MPIIO_FILE_SIZE_3 560
 
 static int darshan_log_get_mpiio_file(darshan_fd fd, void** mpiio_buf_p);
 static int darshan_log_put_mpiio_file(darshan_fd fd, void* mpiio_buf);
@@ -167,20 +168,46 @@ static int darshan_log_get_mpiio_file(darshan_fd fd, void** mpiio_buf_p)
         char *src_p, *dest_p;
         int len;
 
-        rec_len = DARSHAN_MPIIO_FILE_SIZE_1;
-        ret = darshan_log_get_mod(fd, DARSHAN_MPIIO_MOD, scratch, rec_len);
-        if(ret != rec_len)
-            goto exit;
-
-        /* upconvert versions 1/2 to version 3 in-place */
-        dest_p = scratch + (sizeof(struct darshan_base_record) +
-            (51 * sizeof(int64_t)) + (5 * sizeof(double)));
-        src_p = dest_p - (2 * sizeof(double));
-        len = (12 * sizeof(double));
-        memmove(dest_p, src_p, len);
-        /* set F_CLOSE_START and F_OPEN_END to -1 */
-        *((double *)src_p) = -1;
-        *((double *)(src_p + sizeof(double))) = -1;
+        if(fd->mod_ver[DARSHAN_MPIIO_MOD] < 3)
+        {
+            rec_len = DARSHAN_MPIIO_FILE_SIZE_1;
+            ret = darshan_log_get_mod(fd, DARSHAN_MPIIO_MOD, scratch, rec_len);
+            if(ret != rec_len)
+                goto exit;
+
+            /* upconvert versions 1/2 to version 3 in-place */
+            dest_p = scratch + (sizeof(struct darshan_base_record) +
+                (51 * sizeof(int64_t)) + (5 * sizeof(double)));
+            src_p = dest_p - (2 * sizeof(double));
+            len = (12 * sizeof(double));
+            memmove(dest_p, src_p, len);
+            /* set F_CLOSE_START and F_OPEN_END to -1 */
+            *((double *)src_p) = -1;
+            *((double *)(src_p + sizeof(double))) = -1;
+        }
+        if(fd->mod_ver[DARSHAN_MPIIO_MOD] <= 3)
+        {
+            if(fd->mod_ver[DARSHAN_MPIIO_MOD] == 3)
+            {
+                rec_len = DARSHAN_MPIIO_FILE_SIZE_3;
+                ret = darshan_log_get_mod(fd, DARSHAN_MPIIO_MOD, scratch, rec_len);
+                if(ret != rec_len)
+                    goto exit;
+            }
+
+            /* upconvert version 3 to version 4 in-place */
+            dest_p = scratch + (sizeof(struct darshan_base_record) +
+                (53 * sizeof(int64_t)));
+            src_p = dest_p - (2 * sizeof(int64_t));
+            len = (17 * sizeof(double));
+            memmove(dest_p, src_p, len);
+            /* set MPIIO_NB_*_COMPLETIONS to -1 */
+            *((int64_t *)src_p) = -1;
+            *((int64_t *)(src_p + sizeof(int64_t))) = -1;
+            /* set MPIIO_F_NB_* to -1 */
+            for(i = 17; i < 21; i++)
+                *((double *)(dest_p + (i * sizeof(double)))) = -1;
+        }
 
         memcpy(file, scratch, sizeof(struct darshan_mpiio_file));
     }
@@ -206,7 +233,16 @@ exit:
             DARSHAN_BSWAP64(&(file->base_rec.id));
             DARSHAN_BSWAP64(&(file->base_rec.rank));
             for(i=0; i<MPIIO_NUM_INDICES; i++)
+            {
+                /* skip counters we explicitly set to -1 since they don't
+                 * need to be byte swapped
+                 */
+                if((fd->mod_ver[DARSHAN_MPIIO_MOD] < 4) &&
+                    ((i == MPIIO_NB_READ_COMPLETIONS) ||
+                     (i == MPIIO_NB_WRITE_COMPLETIONS)))
+                    continue;
                 DARSHAN_BSWAP64(&file->counters[i]);
+            }
             for(i=0; i<MPIIO_F_NUM_INDICES; i++)
             {
                 /* skip counters we explicitly set to -1 since they don't
@@ -216,6 +252,9 @@ exit:
                     ((i == MPIIO_F_CLOSE_START_TIMESTAMP) ||
                      (i == MPIIO_F_OPEN_END_TIMESTAMP)))
                     continue;
+                if((fd->mod_ver[DARSHAN_MPIIO_MOD] < 4) &&
+                    (i >= MPIIO_F_NB_READ_TIME))
+                    continue;
                 DARSHAN_BSWAP64(&file->fcounters[i]);
             }
         }
@@ -289,6 +328,11 @@ static void darshan_log_print_mpiio_description(int ver)
     printf("#   MPIIO_F_MAX_*_TIME: duration of the slowest MPI-IO read and write operations.\n");
     printf("#   MPIIO_F_*_RANK_TIME: fastest and slowest I/O time for a single rank (for shared files).\n");
     printf("#   MPIIO_F_VARIANCE_RANK_*: variance of total I/O time and bytes moved for all ranks (for shared files).\n");
+    printf("#   MPIIO_NB_*_COMPLETIONS: number of non blocking reads and writes whose completion was observed.\n");
+    printf("#   MPIIO_F_NB_READ/WRITE_TIME: cumulative time non blocking reads and writes were outstanding (post to completion).\n");
+    printf("#   MPIIO_F_NB_WAIT_TIME: cumulative time blocked in MPI_Wait/MPI_Test calls that completed non blocking I/O.\n");
+    printf("#   MPIIO_F_NB_OVERLAP_TIME: cumulative time between posting non blocking I/O and the call that completed it.\n");
+    printf("#   NOTE: MPIIO_NB_*_COMPLETIONS and MPIIO_F_NB_* counters are -1 unless DARSHAN_MPIIO_NB_COMPLETION is set at runtime.\n");
 
     if(ver == 1)
     {
@@ -301,6 +345,16 @@ static void darshan_log_print_mpiio_description(int ver)
         printf("# - MPIIO_F_CLOSE_START_TIMESTAMP\n");
         printf("# - MPIIO_F_OPEN_END_TIMESTAMP\n");
     }
+    if(ver <= 3)
+    {
+        printf("\n# WARNING: MPIIO module log format version <=3 does not support the following counters:\n");
+        printf("# - MPIIO_NB_READ_COMPLETIONS\n");
+        printf("# - MPIIO_NB_WRITE_COMPLETIONS\n");
+        printf("# - MPIIO_F_NB_READ_TIME\n");
+        printf("# - MPIIO_F_NB_WRITE_TIME\n");
+        printf("# - MPIIO_F_NB_WAIT_TIME\n");
+        printf("# - MPIIO_F_NB_OVERLAP_TIME\n");
+    }
 
     return;
 }
@@ -602,6 +656,14 @@ static void darshan_log_agg_mpiio_files(void *rec, void *agg_rec, int init_flag)
             case MPIIO_ACCESS4_COUNT:
                 /* these are set all at once with common counters above */
                 break;
+            case MPIIO_NB_READ_COMPLETIONS:
+            case MPIIO_NB_WRITE_COMPLETIONS:
+                /* sum, unless the value is unknown */
+                if(mpi_rec->counters[i] < 0 || agg_mpi_rec->counters[i] < 0)
+                    agg_mpi_rec->counters[i] = -1;
+                else
+                    agg_mpi_rec->counters[i] += mpi_rec->counters[i];
+                break;
             /* intentionally do not include a default block; we want to
              * get a compile-time warning in this function when new
              * counters are added to the enumeration to make sure we
@@ -625,6 +687,16 @@ static void darshan_log_agg_mpiio_files(void *rec, void *agg_rec, int init_flag)
                 /* sum */
                 agg_mpi_rec->fcounters[i] += mpi_rec->fcounters[i];
                 break;
+            case MPIIO_F_NB_READ_TIME:
+            case MPIIO_F_NB_WRITE_TIME:
+            case MPIIO_F_NB_WAIT_TIME:
+            case MPIIO_F_NB_OVERLAP_TIME:
+                /* sum, unless the value is unknown */
+                if(mpi_rec->fcounters[i] < 0 || agg_mpi_rec->fcounters[i] < 0)
+                    agg_mpi_rec->fcounters[i] = -1;
+                else
+                    agg_mpi_rec->fcounters[i] += mpi_rec->fcounters[i];
+                break;
             case MPIIO_F_OPEN_START_TIMESTAMP:
             case MPIIO_F_READ_START_TIMESTAMP:
             case MPIIO_F_WRITE_START_TIMESTAMP:
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "darshan-logutils.h"
+
+/* counter name strings for the NFS module */
+#define X(a) #a,
+char *nfs_counter_names[] = {
+    NFS_COUNTERS
+};
+
+char *nfs_f_counter_names[] = {
+    NFS_F_COUNTERS
+};
+#undef X
+
+static int darshan_log_get_nfs_rec(darshan_fd fd, void** nfs_buf_p);
+static int darshan_log_put_nfs_rec(darshan_fd fd, void* nfs_buf);
+static void darshan_log_print_nfs_rec(void *file_rec,
+    char *file_name, char *mnt_pt, char *fs_type);
+static void darshan_log_print_nfs_description(int ver);
+static void darshan_log_print_nfs_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2);
+static void darshan_log_agg_nfs_recs(void *rec, void *agg_rec, int init_flag);
+
+struct darshan_mod_logutil_funcs nfs_logutils =
+{
+    .log_get_record = &darshan_log_get_nfs_rec,
+    .log_put_record = &darshan_log_put_nfs_rec,
+    .log_print_record = &darshan_log_print_nfs_rec,
+    .log_print_description = &darshan_log_print_nfs_description,
+    .log_print_diff = &darshan_log_print_nfs_rec_diff,
+    .log_agg_records = &darshan_log_agg_nfs_recs
+};
+
+static int darshan_log_get_nfs_rec(darshan_fd fd, void** nfs_buf_p)
+{
+    struct darshan_nfs_record *rec = *((struct darshan_nfs_record **)nfs_buf_p);
+    int rec_len;
+    int i;
+    int ret = -1;
+
+    if(fd->mod_map[DARSHAN_NFS_MOD].len == 0)
+        return(0);
+
+    if(fd->mod_ver[DARSHAN_NFS_MOD] == 0 ||
+        fd->mod_ver[DARSHAN_NFS_MOD] > DARSHAN_NFS_VER)
+    {
+        fprintf(stderr, "Error: Invalid NFS module version number (got %d)\n",
+            fd->mod_ver[DARSHAN_NFS_MOD]);
+        return(-1);
+    }
+
+    if(*nfs_buf_p == NULL)
+    {
+        rec = malloc(sizeof(*rec));
+        if(!rec)
+            return(-1);
+    }
+
+    rec_len = sizeof(struct darshan_nfs_record);
+    ret = darshan_log_get_mod(fd, DARSHAN_NFS_MOD, rec, rec_len);
+
+    if(*nfs_buf_p == NULL)
+    {
+        if(ret == rec_len)
+            *nfs_buf_p = rec;
+        else
+            free(rec);
+    }
+
+    if(ret < 0)
+        return(-1);
+    else if(ret < rec_len)
+        return(0);
+    else
+    {
+        if(fd->swap_flag)
+        {
+            /* swap bytes if necessary */
+            DARSHAN_BSWAP64(&(rec->base_rec.id));
+            DARSHAN_BSWAP64(&(rec->base_rec.rank));
+            for(i=0; i<NFS_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->counters[i]);
+            for(i=0; i<NFS_F_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->fcounters[i]);
+        }
+
+        return(1);
+    }
+}
+
+static int darshan_log_put_nfs_rec(darshan_fd fd, void* nfs_buf)
+{
+    struct darshan_nfs_record *rec = (struct darshan_nfs_record *)nfs_buf;
+    int ret;
+
+    ret = darshan_log_put_mod(fd, DARSHAN_NFS_MOD, rec,
+        sizeof(struct darshan_nfs_record), DARSHAN_NFS_VER);
+    if(ret < 0)
+        return(-1);
+
+    return(0);
+}
+
+static void darshan_log_print_nfs_rec(void *file_rec, char *file_name,
+    char *mnt_pt, char *fs_type)
+{
+    int i;
+    struct darshan_nfs_record *nfs_rec =
+        (struct darshan_nfs_record *)file_rec;
+
+    for(i=0; i<NFS_NUM_INDICES; i++)
+    {
+        DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+            nfs_rec->base_rec.rank, nfs_rec->base_rec.id,
+            nfs_counter_names[i], nfs_rec->counters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    for(i=0; i<NFS_F_NUM_INDICES; i++)
+    {
+        DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+            nfs_rec->base_rec.rank, nfs_rec->base_rec.id,
+            nfs_f_counter_names[i], nfs_rec->fcounters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    return;
+}
+
+static void darshan_log_print_nfs_description(int ver)
+{
+    printf("\n# description of NFS counters:\n");
+    printf("#   NFS_*: NFS client statistics from /proc/self/mountstats, one record per\n");
+    printf("#       NFS mount per node. Values are deltas between Darshan startup and\n");
+    printf("#       shutdown and include activity by any process on the node that used\n");
+    printf("#       the mount (not just the job's processes).\n");
+    printf("#   NFS_VERSION: NFS protocol major version of the mount.\n");
+    printf("#   NFS_PROCS: number of processes on the node contributing to the record.\n");
+    printf("#   NFS_SAMPLES: number of snapshots taken across all contributing processes.\n");
+    printf("#   NFS_INODE_REVALIDATES, NFS_DENTRY_REVALIDATES: cached inode attribute and\n");
+    printf("#       directory entry revalidations.\n");
+    printf("#   NFS_DATA_INVALIDATES, NFS_ATTR_INVALIDATES: page cache and attribute cache\n");
+    printf("#       invalidations.\n");
+    printf("#   NFS_NORMAL_*_BYTES, NFS_DIRECT_*_BYTES: bytes read/written by applications\n");
+    printf("#       through the page cache and with O_DIRECT, respectively.\n");
+    printf("#   NFS_SERVER_*_BYTES: bytes read from/written to the server by READ/WRITE RPCs.\n");
+    printf("#   NFS_RPC_*: RPCs issued, retransmitted, timed out, and bytes sent/received,\n");
+    printf("#       across all operation types.\n");
+    printf("#   NFS_<OP>_OPS, NFS_<OP>_RETRANS: RPCs issued and retransmitted for the given\n");
+    printf("#       operation type (READDIR includes NFSv3 READDIRPLUS).\n");
+    printf("#   NFS_F_START_TIMESTAMP, NFS_F_END_TIMESTAMP: time of first/last snapshot.\n");
+    printf("#   NFS_F_MAX_RPC_RATE: highest RPCs per second observed between any two\n");
+    printf("#       consecutive periodic snapshots (-1 if periodic sampling was disabled).\n");
+    printf("#   NFS_F_*_QUEUE_TIME, NFS_F_*_RTT_TIME, NFS_F_*_EXEC_TIME: cumulative time (in\n");
+    printf("#       seconds) RPCs spent queued for transmission, waiting for a server reply,\n");
+    printf("#       and in total.\n");
+    printf("#   NOTE: a value of -1 means the counter could not be determined (e.g., the\n");
+    printf("#       mount was replaced during the job).\n");
+
+    return;
+}
+
+static void darshan_log_print_nfs_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2)
+{
+    struct darshan_nfs_record *file1 = (struct darshan_nfs_record *)file_rec1;
+    struct darshan_nfs_record *file2 = (struct darshan_nfs_record *)file_rec2;
+    int i;
+
+    /* NOTE: we assume that both input records are the same module format version */
+
+    for(i=0; i<NFS_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file1->base_rec.rank, file1->base_rec.id, nfs_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file2->base_rec.rank, file2->base_rec.id, nfs_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+        else if(file1->counters[i] != file2->counters[i])
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file1->base_rec.rank, file1->base_rec.id, nfs_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file2->base_rec.rank, file2->base_rec.id, nfs_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+    }
+
+    for(i=0; i<NFS_F_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file1->base_rec.rank, file1->base_rec.id, nfs_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file2->base_rec.rank, file2->base_rec.id, nfs_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+        else if(file1->fcounters[i] != file2->fcounters[i])
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file1->base_rec.rank, file1->base_rec.id, nfs_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_NFS_MOD],
+                file2->base_rec.rank, file2->base_rec.id, nfs_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+    }
+
+    return;
+}
+
+static void darshan_log_agg_nfs_recs(void *rec, void *agg_rec, int init_flag)
+{
+    struct darshan_nfs_record *nfs_rec = (struct darshan_nfs_record *)rec;
+    struct darshan_nfs_record *agg_nfs_rec = (struct darshan_nfs_record *)agg_rec;
+    int i;
+
+    if(init_flag)
+    {
+        /* when initializing, just copy over the first record */
+        memcpy(agg_nfs_rec, nfs_rec, sizeof(struct darshan_nfs_record));
+        return;
+    }
+
+    /* NOTE: records are per node, so counters from different records are
+     * independent and can be summed
+     */
+    for(i = 0; i < NFS_NUM_INDICES; i++)
+    {
+        switch(i)
+        {
+            case NFS_VERSION:
+                /* max */
+                if(nfs_rec->counters[i] > agg_nfs_rec->counters[i])
+                    agg_nfs_rec->counters[i] = nfs_rec->counters[i];
+                break;
+            case NFS_PROCS:
+            case NFS_SAMPLES:
+                /* sum */
+                agg_nfs_rec->counters[i] += nfs_rec->counters[i];
+                break;
+            default:
+                /* sum, unless undetermined for either record */
+                if(nfs_rec->counters[i] < 0 || agg_nfs_rec->counters[i] < 0)
+                    agg_nfs_rec->counters[i] = -1;
+                else
+                    agg_nfs_rec->counters[i] += nfs_rec->counters[i];
+                break;
+        }
+    }
+
+    for(i = 0; i < NFS_F_NUM_INDICES; i++)
+    {
+        switch(i)
+        {
+            case NFS_F_START_TIMESTAMP:
+                /* minimum */
+                if(nfs_rec->fcounters[i] < agg_nfs_rec->fcounters[i])
+                    agg_nfs_rec->fcounters[i] = nfs_rec->fcounters[i];
+                break;
+            case NFS_F_END_TIMESTAMP:
+            case NFS_F_MAX_RPC_RATE:
+                /* maximum */
+                if(nfs_rec->fcounters[i] > agg_nfs_rec->fcounters[i])
+                    agg_nfs_rec->fcounters[i] = nfs_rec->fcounters[i];
+                break;
+            default:
+                /* sum, unless undetermined for either record */
+                if(nfs_rec->fcounters[i] < 0 || agg_nfs_rec->fcounters[i] < 0)
+                    agg_nfs_rec->fcounters[i] = -1;
+                else
+                    agg_nfs_rec->fcounters[i] += nfs_rec->fcounters[i];
+                break;
+        }
+    }
+
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
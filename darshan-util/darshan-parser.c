@@ -51,6 +51,8 @@
 void posix_print_total_file(struct darshan_posix_file *pfile, int posix_ver);
 void mpiio_print_total_file(struct darshan_mpiio_file *mfile, int mpiio_ver);
 void stdio_print_total_file(struct darshan_stdio_file *pfile, int stdio_ver);
+void procio_print_perf(struct darshan_procio_record *prec);
+void stdio_print_buffering(struct darshan_stdio_file *pfile);
 
 int usage (char *exename)
 {
@@ -149,6 +151,8 @@ int main(int argc, char **argv)
 
     darshan_accumulator acc = NULL;
     struct darshan_derived_metrics metrics;
+    struct darshan_procio_record procio_rec;
+    int procio_rec_found = 0;
 
     mask = parse_args(argc, argv, &filename);
 
@@ -319,10 +323,11 @@ int main(int argc, char **argv)
         else if (i == DXT_POSIX_MOD || i == DXT_MPIIO_MOD)
             continue;
         /* currently only POSIX, MPIIO, and STDIO modules support non-base
-         * parsing
+         * parsing (PROCIO only contributes to the performance output)
          */
         else if((i != DARSHAN_POSIX_MOD) && (i != DARSHAN_MPIIO_MOD) &&
-                (i != DARSHAN_STDIO_MOD) && !(mask & OPTION_BASE))
+                (i != DARSHAN_STDIO_MOD) && !(mask & OPTION_BASE) &&
+                !((i == DARSHAN_PROCIO_MOD) && (mask & OPTION_PERF)))
             continue;
 
         /* this module has data to be parsed and printed */
@@ -444,6 +449,14 @@ int main(int argc, char **argv)
             /* accumulated and derived metrics, if supported */
             if(acc)
                 darshan_accumulator_inject(acc, mod_buf, 1);
+
+            /* keep a running aggregate of the job-level PROCIO record(s) */
+            if(i == DARSHAN_PROCIO_MOD)
+            {
+                mod_logutils[i]->log_agg_records(mod_buf, &procio_rec,
+                    !procio_rec_found);
+                procio_rec_found = 1;
+            }
         }
         if(ret == -1)
             continue; /* move on to the next module if there was an error with this one */
@@ -452,6 +465,10 @@ int main(int argc, char **argv)
         if(acc)
             darshan_accumulator_emit(acc, &metrics, mod_buf);
 
+        /* PROCIO page cache statistics are reported with the perf option */
+        if(i == DARSHAN_PROCIO_MOD && procio_rec_found && (mask & OPTION_PERF))
+            procio_print_perf(&procio_rec);
+
         /* we calculate more detailed stats for POSIX and MPI-IO modules, 
          * if the parser is executed with more than the base option
          */
@@ -548,6 +565,10 @@ int main(int argc, char **argv)
             printf("# ...........................\n");
             printf("# agg_time_by_slowest: %lf # seconds\n", metrics.agg_time_by_slowest);
             printf("# agg_perf_by_slowest: %lf # MiB/s\n", metrics.agg_perf_by_slowest);
+
+            /* STDIO stream buffering effectiveness, from the aggregate record */
+            if(i == DARSHAN_STDIO_MOD)
+                stdio_print_buffering((struct darshan_stdio_file*)mod_buf);
         }
 
         if(acc) {
@@ -580,6 +601,73 @@ int main(int argc, char **argv)
     return(ret);
 }
 
+void procio_print_perf(struct darshan_procio_record *prec)
+{
+    double hit_ratio;
+    int64_t rchar = prec->counters[PROCIO_RCHAR];
+    int64_t wchar = prec->counters[PROCIO_WCHAR];
+    int64_t read_bytes = prec->counters[PROCIO_READ_BYTES];
+    int64_t write_bytes = prec->counters[PROCIO_WRITE_BYTES];
+
+    printf("\n# page cache performance\n");
+    printf("# -----------------------\n");
+    printf("# rchar: %" PRId64 " # bytes requested by read system calls\n", rchar);
+    printf("# read_bytes: %" PRId64 " # bytes fetched from storage\n", read_bytes);
+    printf("# wchar: %" PRId64 " # bytes passed to write system calls\n", wchar);
+    printf("# write_bytes: %" PRId64 " # bytes written back to storage\n", write_bytes);
+
+    hit_ratio = darshan_procio_cache_hit_ratio(prec);
+    if(hit_ratio < 0)
+        printf("# read_cache_hit_ratio: N/A\n");
+    else
+        printf("# read_cache_hit_ratio: %lf\n", hit_ratio);
+    if(prec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO] < 0)
+        printf("# min_interval_read_cache_hit_ratio: N/A\n");
+    else
+        printf("# min_interval_read_cache_hit_ratio: %lf\n",
+            prec->fcounters[PROCIO_F_MIN_INTERVAL_HIT_RATIO]);
+    if(prec->counters[PROCIO_IOWAIT_TICKS] >= 0 && prec->counters[PROCIO_CLK_TCK] > 0)
+        printf("# block_io_wait_time: %lf # seconds, summed across processes\n",
+            (double)prec->counters[PROCIO_IOWAIT_TICKS] /
+            (double)prec->counters[PROCIO_CLK_TCK]);
+    else
+        printf("# block_io_wait_time: N/A\n");
+
+    return;
+}
+
+void stdio_print_buffering(struct darshan_stdio_file *pfile)
+{
+    int64_t stdio_ops = pfile->counters[STDIO_READS] +
+        pfile->counters[STDIO_WRITES] + pfile->counters[STDIO_FLUSHES];
+    int64_t posix_ops = pfile->counters[STDIO_POSIX_READS] +
+        pfile->counters[STDIO_POSIX_WRITES];
+    double ratio;
+
+    printf("#\n");
+    printf("# STDIO buffering:\n");
+    printf("# ...........................\n");
+    printf("# stdio_ops: %" PRId64 " # reads, writes, and flushes\n", stdio_ops);
+    ratio = darshan_stdio_posix_ops_per_op(pfile);
+    if(ratio < 0)
+    {
+        printf("# posix_ops: N/A\n");
+        printf("# posix_ops_per_stdio_op: N/A\n");
+        printf("# bytes_per_posix_op: N/A\n");
+        return;
+    }
+    printf("# posix_ops: %" PRId64 " # estimated read/write system calls (lower bound)\n", posix_ops);
+    printf("# posix_ops_per_stdio_op: %lf\n", ratio);
+    if(posix_ops > 0)
+        printf("# bytes_per_posix_op: %lf\n",
+            (double)(pfile->counters[STDIO_BYTES_READ] +
+            pfile->counters[STDIO_BYTES_WRITTEN]) / (double)posix_ops);
+    else
+        printf("# bytes_per_posix_op: N/A\n");
+
+    return;
+}
+
 void stdio_print_total_file(struct darshan_stdio_file *pfile, int stdio_ver)
 {
     int i;
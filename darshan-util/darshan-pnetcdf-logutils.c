@@ -43,6 +43,9 @@ char *pnetcdf_var_f_counter_names[] = {
 
 #define DARSHAN_PNETCDF_FILE_SIZE_1 48
 #define DARSHAN_PNETCDF_FILE_SIZE_2 64
+#define DARSHAN_PNETCDF_FILE_SIZE_3 152
+
+#define DARSHAN_PNETCDF_VAR_SIZE_1 1120
 
 static int darshan_log_get_pnetcdf_file(darshan_fd fd, void** pnetcdf_buf_p);
 static int darshan_log_put_pnetcdf_file(darshan_fd fd, void* pnetcdf_buf);
@@ -189,6 +192,29 @@ static int darshan_log_get_pnetcdf_file(darshan_fd fd, void** pnetcdf_buf_p)
             dest_p += sizeof(double);
             *(double *)dest_p = -1;
         }
+        if(fd->mod_ver[DARSHAN_PNETCDF_FILE_MOD] <= 3)
+        {
+            if(fd->mod_ver[DARSHAN_PNETCDF_FILE_MOD] == 3)
+            {
+                rec_len = DARSHAN_PNETCDF_FILE_SIZE_3;
+                ret = darshan_log_get_mod(fd, DARSHAN_PNETCDF_FILE_MOD, scratch, rec_len);
+                if(ret != rec_len)
+                    goto exit;
+            }
+
+            /* upconvert version 3 to version 4 in-place */
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                (9 * sizeof(int64_t));
+            dest_p = src_p + (3 * sizeof(int64_t));
+            len = PNETCDF_FILE_F_NUM_INDICES * sizeof(double);
+            memmove(dest_p, src_p, len);
+            /* set new NB_MAX_PENDING .. BPUT_MAX_PENDING_BYTES to -1 */
+            for(i = 0; i < 3; i++)
+            {
+                *((int64_t *)src_p) = -1;
+                src_p += sizeof(int64_t);
+            }
+        }
 
         memcpy(file, scratch, sizeof(struct darshan_pnetcdf_file));
     }
@@ -224,6 +250,11 @@ exit:
                      (i == PNETCDF_FILE_SYNCS) || (i == PNETCDF_FILE_BYTES_READ) ||
                      (i == PNETCDF_FILE_BYTES_WRITTEN) || (i == PNETCDF_FILE_WAIT_FAILURES)))
                     continue;
+                if((fd->mod_ver[DARSHAN_PNETCDF_FILE_MOD] < 4) &&
+                    ((i == PNETCDF_FILE_NB_MAX_PENDING) ||
+                     (i == PNETCDF_FILE_BUFFER_ATTACH_SIZE) ||
+                     (i == PNETCDF_FILE_BPUT_MAX_PENDING_BYTES)))
+                    continue;
                 DARSHAN_BSWAP64(&file->counters[i]);
             }
             for(i=0; i<PNETCDF_FILE_F_NUM_INDICES; i++)
@@ -281,6 +312,40 @@ static int darshan_log_get_pnetcdf_var(darshan_fd fd, void** pnetcdf_buf_p)
         rec_len = sizeof(struct darshan_pnetcdf_var);
         ret = darshan_log_get_mod(fd, DARSHAN_PNETCDF_VAR_MOD, var, rec_len);
     }
+    else
+    {
+        char scratch[2048] = {0};
+        char *src_p, *dest_p;
+        int len;
+
+        if(fd->mod_ver[DARSHAN_PNETCDF_VAR_MOD] == 1)
+        {
+            rec_len = DARSHAN_PNETCDF_VAR_SIZE_1;
+            ret = darshan_log_get_mod(fd, DARSHAN_PNETCDF_VAR_MOD, scratch, rec_len);
+            if(ret != rec_len)
+                goto exit;
+
+            /* upconvert version 1 to version 2 in-place */
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                sizeof(uint64_t) + (PNETCDF_VAR_NB_WAIT_BYTES_READ * sizeof(int64_t));
+            dest_p = src_p + (3 * sizeof(int64_t));
+            len = PNETCDF_VAR_F_NB_READ_WAIT_TIME * sizeof(double);
+            memmove(dest_p, src_p, len);
+            /* set new NB_WAIT_BYTES_READ .. NB_MAX_PENDING to -1 */
+            for(i = 0; i < 3; i++)
+            {
+                *((int64_t *)src_p) = -1;
+                src_p += sizeof(int64_t);
+            }
+            /* set new F_NB_READ_WAIT_TIME and F_NB_WRITE_WAIT_TIME to -1 */
+            dest_p += len;
+            *((double *)dest_p) = -1;
+            dest_p += sizeof(double);
+            *((double *)dest_p) = -1;
+        }
+
+        memcpy(var, scratch, sizeof(struct darshan_pnetcdf_var));
+    }
 
 exit:
     if(*pnetcdf_buf_p == NULL)
@@ -304,9 +369,25 @@ exit:
             DARSHAN_BSWAP64(&(var->base_rec.rank));
             DARSHAN_BSWAP64(&(var->file_rec_id));
             for(i=0; i<PNETCDF_VAR_NUM_INDICES; i++)
+            {
+                /* skip counters we explicitly set to -1 since they don't
+                 * need to be byte swapped
+                 */
+                if((fd->mod_ver[DARSHAN_PNETCDF_VAR_MOD] == 1) &&
+                    ((i == PNETCDF_VAR_NB_WAIT_BYTES_READ) ||
+                     (i == PNETCDF_VAR_NB_WAIT_BYTES_WRITTEN) ||
+                     (i == PNETCDF_VAR_NB_MAX_PENDING)))
+                    continue;
                 DARSHAN_BSWAP64(&var->counters[i]);
+            }
             for(i=0; i<PNETCDF_VAR_F_NUM_INDICES; i++)
+            {
+                if((fd->mod_ver[DARSHAN_PNETCDF_VAR_MOD] == 1) &&
+                    ((i == PNETCDF_VAR_F_NB_READ_WAIT_TIME) ||
+                     (i == PNETCDF_VAR_F_NB_WRITE_WAIT_TIME)))
+                    continue;
                 DARSHAN_BSWAP64(&var->fcounters[i]);
+            }
         }
 
         return(1);
@@ -408,6 +489,9 @@ static void darshan_log_print_pnetcdf_file_description(int ver)
     printf("#   PNETCDF_FILE_BYTES_READ: PnetCDF total bytes read for all file variables.\n");
     printf("#   PNETCDF_FILE_BYTES_WRITTEN: PnetCDF total bytes written for all file variables.\n");
     printf("#   PNETCDF_FILE_WAIT_FAILURES: PnetCDF file wait operation failure counts.\n");
+    printf("#   PNETCDF_FILE_NB_MAX_PENDING: maximum number of nonblocking requests pending at once.\n");
+    printf("#   PNETCDF_FILE_BUFFER_ATTACH_SIZE: largest buffer size attached for buffered (bput) writes.\n");
+    printf("#   PNETCDF_FILE_BPUT_MAX_PENDING_BYTES: maximum bytes of buffered (bput) writes pending at once.\n");
     printf("#   PNETCDF_FILE_F_*_START_TIMESTAMP: timestamp of first PnetCDF file open/close/wait operation.\n");
     printf("#   PNETCDF_FILE_F_*_END_TIMESTAMP: timestamp of last PnetCDF file open/close/wait operation.\n");
     printf("#   PNETCDF_FILE_F_META_TIME: Cumulative time spent in file metadata operations.\n");
@@ -435,6 +519,13 @@ static void darshan_log_print_pnetcdf_file_description(int ver)
         printf("# - PNETCDF_FILE_F_META_TIME\n");
         printf("# - PNETCDF_FILE_F_WAIT_TIME\n");
     }
+    if(ver <= 3)
+    {
+        printf("\n# WARNING: PnetCDF file module log format version <=3 does not support the following counters:\n");
+        printf("# - PNETCDF_FILE_NB_MAX_PENDING\n");
+        printf("# - PNETCDF_FILE_BUFFER_ATTACH_SIZE\n");
+        printf("# - PNETCDF_FILE_BPUT_MAX_PENDING_BYTES\n");
+    }
 
     return;
 }
@@ -465,14 +556,27 @@ static void darshan_log_print_pnetcdf_var_description(int ver)
     printf("#   PNETCDF_VAR_DATATYPE_SIZE: size of each variable element.\n");
     printf("#   PNETCDF_VAR_*_RANK: rank of the processes that were the fastest and slowest at I/O (for shared datasets).\n");
     printf("#   PNETCDF_VAR_*_RANK_BYTES: total bytes transferred at PnetCDF layer by the fastest and slowest ranks (for shared datasets).\n");
+    printf("#   PNETCDF_VAR_NB_WAIT_BYTES_*: bytes of nonblocking reads and writes completed by ncmpi_wait/ncmpi_wait_all.\n");
+    printf("#   PNETCDF_VAR_NB_MAX_PENDING: maximum number of the variable's nonblocking requests pending at once.\n");
     printf("#   PNETCDF_VAR_F_*_START_TIMESTAMP: timestamp of first PnetCDF variable open/read/write/close.\n");
     printf("#   PNETCDF_VAR_F_*_END_TIMESTAMP: timestamp of last PnetCDF variable open/read/write/close.\n");
     printf("#   PNETCDF_VAR_F_READ/WRITE/META_TIME: cumulative time spent in PnetCDF read, write, or metadata operations.\n");
     printf("#   PNETCDF_VAR_F_MAX_*_TIME: duration of the slowest PnetCDF read and write operations.\n");
     printf("#   PNETCDF_VAR_F_*_RANK_TIME: fastest and slowest I/O time for a single rank (for shared datasets).\n");
     printf("#   PNETCDF_VAR_F_VARIANCE_RANK_*: variance of total I/O time and bytes moved for all ranks (for shared datasets).\n");
+    printf("#   PNETCDF_VAR_F_NB_*_WAIT_TIME: share of ncmpi_wait/ncmpi_wait_all time spent completing the variable's nonblocking reads and writes (split by request size).\n");
     printf("#   PNETCDF_VAR_FILE_REC_ID: Darshan file record ID of the file the variable belongs to.\n");
 
+    if(ver == 1)
+    {
+        printf("\n# WARNING: PnetCDF variable module log format version 1 does not support the following counters:\n");
+        printf("# - PNETCDF_VAR_NB_WAIT_BYTES_READ\n");
+        printf("# - PNETCDF_VAR_NB_WAIT_BYTES_WRITTEN\n");
+        printf("# - PNETCDF_VAR_NB_MAX_PENDING\n");
+        printf("# - PNETCDF_VAR_F_NB_READ_WAIT_TIME\n");
+        printf("# - PNETCDF_VAR_F_NB_WRITE_WAIT_TIME\n");
+    }
+
     return;
 }
 
@@ -642,6 +746,13 @@ static void darshan_log_agg_pnetcdf_files(void *rec, void *agg_rec, int init_fla
                 /* sum */
                 agg_pnetcdf_rec->counters[i] += pnetcdf_rec->counters[i];
                 break;
+            case PNETCDF_FILE_NB_MAX_PENDING:
+            case PNETCDF_FILE_BUFFER_ATTACH_SIZE:
+            case PNETCDF_FILE_BPUT_MAX_PENDING_BYTES:
+                /* maximum */
+                if(pnetcdf_rec->counters[i] > agg_pnetcdf_rec->counters[i])
+                    agg_pnetcdf_rec->counters[i] = pnetcdf_rec->counters[i];
+                break;
             default:
                 agg_pnetcdf_rec->counters[i] = -1;
                 break;
@@ -936,6 +1047,19 @@ static void darshan_log_agg_pnetcdf_vars(void *rec, void *agg_rec, int init_flag
                 if(pnetcdf_rec->counters[i] > 0)
                     agg_pnetcdf_rec->counters[i] = 1;
                 break;
+            case PNETCDF_VAR_NB_WAIT_BYTES_READ:
+            case PNETCDF_VAR_NB_WAIT_BYTES_WRITTEN:
+                /* sum (-1 if not supported by any input record) */
+                if(pnetcdf_rec->counters[i] < 0 || agg_pnetcdf_rec->counters[i] < 0)
+                    agg_pnetcdf_rec->counters[i] = -1;
+                else
+                    agg_pnetcdf_rec->counters[i] += pnetcdf_rec->counters[i];
+                break;
+            case PNETCDF_VAR_NB_MAX_PENDING:
+                /* maximum */
+                if(pnetcdf_rec->counters[i] > agg_pnetcdf_rec->counters[i])
+                    agg_pnetcdf_rec->counters[i] = pnetcdf_rec->counters[i];
+                break;
             default:
                 agg_pnetcdf_rec->counters[i] = -1;
                 break;
@@ -952,6 +1076,14 @@ static void darshan_log_agg_pnetcdf_vars(void *rec, void *agg_rec, int init_flag
                 /* sum */
                 agg_pnetcdf_rec->fcounters[i] += pnetcdf_rec->fcounters[i];
                 break;
+            case PNETCDF_VAR_F_NB_READ_WAIT_TIME:
+            case PNETCDF_VAR_F_NB_WRITE_WAIT_TIME:
+                /* sum (-1 if not supported by any input record) */
+                if(pnetcdf_rec->fcounters[i] < 0 || agg_pnetcdf_rec->fcounters[i] < 0)
+                    agg_pnetcdf_rec->fcounters[i] = -1;
+                else
+                    agg_pnetcdf_rec->fcounters[i] += pnetcdf_rec->fcounters[i];
+                break;
             case PNETCDF_VAR_F_OPEN_START_TIMESTAMP:
             case PNETCDF_VAR_F_READ_START_TIMESTAMP:
             case PNETCDF_VAR_F_WRITE_START_TIMESTAMP:
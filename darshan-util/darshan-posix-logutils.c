@@ -38,6 +38,10 @@ char *posix_f_counter_names[] = {
 #define DARSHAN_POSIX_FILE_SIZE_1 680
 #define DARSHAN_POSIX_FILE_SIZE_2 648
 #define DARSHAN_POSIX_FILE_SIZE_3 664
+#define DARSHAN_POSIX_FILE_SIZE_4 704
+#define DARSHAN_POSIX_FILE_SIZE_5 736
+#define DARSHAN_POSIX_FILE_SIZE_6 888
+#define DARSHAN_POSIX_FILE_SIZE_7 1040
 
 static int darshan_log_get_posix_file(darshan_fd fd, void** posix_buf_p);
 static int darshan_log_put_posix_file(darshan_fd fd, void* posix_buf);
@@ -164,7 +168,7 @@ static int darshan_log_get_posix_file(darshan_fd fd, void** posix_buf_p)
     }
     else
     {
-        char scratch[1024] = {0};
+        char scratch[2048] = {0};
         char *src_p, *dest_p;
         int len;
 
@@ -247,6 +251,92 @@ static int darshan_log_get_posix_file(darshan_fd fd, void** posix_buf_p)
             /* set RENAMED_FROM to 0 (-1 not possible since this is a uint) */
             *((int64_t *)(src_p + (2 * sizeof(int64_t)))) = 0;
         }
+        if(fd->mod_ver[DARSHAN_POSIX_MOD] <= 4)
+        {
+            if(fd->mod_ver[DARSHAN_POSIX_MOD] == 4)
+            {
+                rec_len = DARSHAN_POSIX_FILE_SIZE_4;
+                ret = darshan_log_get_mod(fd, DARSHAN_POSIX_MOD, scratch, rec_len);
+                if(ret != rec_len)
+                    goto exit;
+            }
+
+            /* upconvert version 4 to version 5 in-place */
+            dest_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_DELTA_BACK_4G_PLUS * sizeof(int64_t));
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_AIO_READS * sizeof(int64_t));
+            len = (17 * sizeof(double));
+            memmove(dest_p, src_p, len);
+            /* set counters added in version 5 to -1 */
+            for(i = POSIX_AIO_READS; i < POSIX_DELTA_BACK_4G_PLUS; i++)
+                *((int64_t *)(src_p + ((i - POSIX_AIO_READS) * sizeof(int64_t)))) = -1;
+        }
+        if(fd->mod_ver[DARSHAN_POSIX_MOD] <= 5)
+        {
+            if(fd->mod_ver[DARSHAN_POSIX_MOD] == 5)
+            {
+                rec_len = DARSHAN_POSIX_FILE_SIZE_5;
+                ret = darshan_log_get_mod(fd, DARSHAN_POSIX_MOD, scratch, rec_len);
+                if(ret != rec_len)
+                    goto exit;
+            }
+
+            /* upconvert version 5 to version 6 in-place */
+            dest_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_FADVISES * sizeof(int64_t));
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_DELTA_BACK_4G_PLUS * sizeof(int64_t));
+            len = (17 * sizeof(double));
+            memmove(dest_p, src_p, len);
+            /* set counters added in version 6 to -1 */
+            for(i = POSIX_DELTA_BACK_4G_PLUS; i < POSIX_FADVISES; i++)
+                *((int64_t *)(src_p + ((i - POSIX_DELTA_BACK_4G_PLUS) * sizeof(int64_t)))) = -1;
+        }
+        if(fd->mod_ver[DARSHAN_POSIX_MOD] <= 6)
+        {
+            if(fd->mod_ver[DARSHAN_POSIX_MOD] == 6)
+            {
+                rec_len = DARSHAN_POSIX_FILE_SIZE_6;
+                ret = darshan_log_get_mod(fd, DARSHAN_POSIX_MOD, scratch, rec_len);
+                if(ret != rec_len)
+                    goto exit;
+            }
+
+            /* upconvert version 6 to version 7 in-place */
+            dest_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_OPENS_DIRECT * sizeof(int64_t));
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_FADVISES * sizeof(int64_t));
+            len = (17 * sizeof(double));
+            memmove(dest_p, src_p, len);
+            /* set counters and timers added in version 7 to -1 */
+            for(i = POSIX_FADVISES; i < POSIX_OPENS_DIRECT; i++)
+                *((int64_t *)(src_p + ((i - POSIX_FADVISES) * sizeof(int64_t)))) = -1;
+            for(i = POSIX_F_FADVISE_TIME; i < POSIX_F_NUM_INDICES; i++)
+                *((double *)(dest_p + (i * sizeof(double)))) = -1;
+        }
+        if(fd->mod_ver[DARSHAN_POSIX_MOD] <= 7)
+        {
+            if(fd->mod_ver[DARSHAN_POSIX_MOD] == 7)
+            {
+                rec_len = DARSHAN_POSIX_FILE_SIZE_7;
+                ret = darshan_log_get_mod(fd, DARSHAN_POSIX_MOD, scratch, rec_len);
+                if(ret != rec_len)
+                    goto exit;
+            }
+
+            /* upconvert version 7 to version 8 in-place */
+            dest_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_NUM_INDICES * sizeof(int64_t));
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                (POSIX_OPENS_DIRECT * sizeof(int64_t));
+            len = (POSIX_F_NUM_INDICES * sizeof(double));
+            memmove(dest_p, src_p, len);
+            /* set counters added in version 8 to -1 */
+            for(i = POSIX_OPENS_DIRECT; i < POSIX_NUM_INDICES; i++)
+                *((int64_t *)(src_p + ((i - POSIX_OPENS_DIRECT) * sizeof(int64_t)))) = -1;
+        }
         
         memcpy(file, scratch, sizeof(struct darshan_posix_file));
     }
@@ -272,7 +362,24 @@ exit:
             DARSHAN_BSWAP64(&file->base_rec.id);
             DARSHAN_BSWAP64(&file->base_rec.rank);
             for(i=0; i<POSIX_NUM_INDICES; i++)
+            {
+                /* skip counters we explicitly set since they don't
+                 * need to be byte swapped
+                 */
+                if((fd->mod_ver[DARSHAN_POSIX_MOD] < 5) &&
+                    (i >= POSIX_AIO_READS))
+                    continue;
+                if((fd->mod_ver[DARSHAN_POSIX_MOD] < 6) &&
+                    (i >= POSIX_DELTA_BACK_4G_PLUS))
+                    continue;
+                if((fd->mod_ver[DARSHAN_POSIX_MOD] < 7) &&
+                    (i >= POSIX_FADVISES))
+                    continue;
+                if((fd->mod_ver[DARSHAN_POSIX_MOD] < 8) &&
+                    (i >= POSIX_OPENS_DIRECT))
+                    continue;
                 DARSHAN_BSWAP64(&file->counters[i]);
+            }
             for(i=0; i<POSIX_F_NUM_INDICES; i++)
             {
                 /* skip counters we explicitly set since they don't
@@ -286,6 +393,9 @@ exit:
                      ((i == POSIX_RENAME_SOURCES) || (i == POSIX_RENAME_TARGETS) ||
                       (i == POSIX_RENAMED_FROM)))
                     continue;
+                if((fd->mod_ver[DARSHAN_POSIX_MOD] < 7) &&
+                    (i >= POSIX_F_FADVISE_TIME))
+                    continue;
                 DARSHAN_BSWAP64(&file->fcounters[i]);
             }
         }
@@ -362,12 +472,29 @@ static void darshan_log_print_posix_description(int ver)
     printf("#   POSIX_ACCESS*_COUNT: count of the four most common access sizes.\n");
     printf("#   POSIX_*_RANK: rank of the processes that were the fastest and slowest at I/O (for shared files).\n");
     printf("#   POSIX_*_RANK_BYTES: bytes transferred by the fastest and slowest ranks (for shared files).\n");
+    printf("#   POSIX_AIO_READS/WRITES: reads and writes completed through asynchronous interfaces (POSIX aio or Linux native aio).\n");
+    printf("#   POSIX_AIO_DIRECT_READS/WRITES: asynchronous reads and writes issued to file descriptors opened with O_DIRECT.\n");
+    printf("#   POSIX_DELTA_*: histogram of the distance from the end of the previous read or write to the start of the next, backward (BACK), none (ZERO), or forward (FWD).\n");
+    printf("#   POSIX_REUSE_*: histogram of the number of accesses since the last one to touch any of the same bytes (within the last %d accesses).\n", POSIX_REUSE_WINDOW);
+    printf("#   NOTE: POSIX_DELTA_* and POSIX_REUSE_* are -1 unless the DARSHAN_POSIX_ACCESS_PATTERNS environment variable was set.\n");
     printf("#   POSIX_F_*_START_TIMESTAMP: timestamp of first open/read/write/close.\n");
     printf("#   POSIX_F_*_END_TIMESTAMP: timestamp of last open/read/write/close.\n");
     printf("#   POSIX_F_READ/WRITE/META_TIME: cumulative time spent in read, write, or metadata operations.\n");
     printf("#   POSIX_F_MAX_*_TIME: duration of the slowest read and write operations.\n");
     printf("#   POSIX_F_*_RANK_TIME: fastest and slowest I/O time for a single rank (for shared files).\n");
     printf("#   POSIX_F_VARIANCE_RANK_*: variance of total I/O time and bytes moved for all ranks (for shared files).\n");
+    printf("#   POSIX_FADVISES, POSIX_FADVISE_DONTNEEDS, POSIX_FADVISE_BYTES: posix_fadvise calls, those with POSIX_FADV_DONTNEED, and bytes covered.\n");
+    printf("#   POSIX_MADVISES, POSIX_MADVISE_BYTES: madvise calls on mappings of the file and bytes covered (-1 if mmap is not instrumented).\n");
+    printf("#   POSIX_READAHEADS, POSIX_READAHEAD_BYTES: readahead calls and bytes requested.\n");
+    printf("#   POSIX_FALLOCATES, POSIX_FALLOCATE_BYTES: fallocate and posix_fallocate calls and bytes covered.\n");
+    printf("#   POSIX_TRUNCATES, POSIX_TRUNCATES_TO_ZERO: truncate and ftruncate calls, and those truncating the file to 0 bytes.\n");
+    printf("#   POSIX_SYNC_FILE_RANGES, POSIX_SYNC_FILE_RANGE_BYTES: sync_file_range calls and bytes covered.\n");
+    printf("#   POSIX_F_FADVISE/MADVISE/READAHEAD/FALLOCATE/TRUNCATE/SYNC_FILE_RANGE_TIME: cumulative time spent in each of the above calls.\n");
+    printf("#   POSIX_OPENS_DIRECT/SYNC/DSYNC/APPEND/TRUNC/CREAT: opens with O_DIRECT, O_SYNC, O_DSYNC (but not O_SYNC), O_APPEND, O_TRUNC, and O_CREAT.\n");
+    printf("#   POSIX_SETFLS: fcntl(F_SETFL) calls changing the file status flags.\n");
+    printf("#   POSIX_DIRECT_READS/WRITES: reads and writes while the file was in O_DIRECT mode.\n");
+    printf("#   POSIX_DIRECT_UNALIGNED_READS/WRITES: O_DIRECT reads and writes with a buffer, offset, or length not aligned to %d bytes.\n", POSIX_DIRECT_ALIGNMENT);
+    printf("#   POSIX_DIRECT_FAILURES: O_DIRECT reads and writes that failed with EINVAL.\n");
 
     if(ver == 1)
     {
@@ -394,6 +521,39 @@ static void darshan_log_print_posix_description(int ver)
         printf("# \t- POSIX_RENAMED_FROM\n");
     }
 
+    if(ver <= 4)
+    {
+        printf("\n# WARNING: POSIX module log format version <=4 has the following limitations:\n");
+        printf("# - No support for the following counters to properly instrument asynchronous I/O operations:\n");
+        printf("# \t- POSIX_AIO_READS\n");
+        printf("# \t- POSIX_AIO_WRITES\n");
+        printf("# \t- POSIX_AIO_DIRECT_READS\n");
+        printf("# \t- POSIX_AIO_DIRECT_WRITES\n");
+    }
+
+    if(ver <= 5)
+    {
+        printf("\n# WARNING: POSIX module log format version <=5 has the following limitations:\n");
+        printf("# - No support for the POSIX_DELTA_* and POSIX_REUSE_* access pattern histograms\n");
+    }
+
+    if(ver <= 6)
+    {
+        printf("\n# WARNING: POSIX module log format version <=6 has the following limitations:\n");
+        printf("# - No support for the following counters and timers to instrument page cache hint and space management calls:\n");
+        printf("# \t- POSIX_FADVISE*, POSIX_MADVISE*, POSIX_READAHEAD*, POSIX_FALLOCATE*, POSIX_TRUNCATE*, POSIX_SYNC_FILE_RANGE*\n");
+        printf("# \t- POSIX_F_FADVISE_TIME, POSIX_F_MADVISE_TIME, POSIX_F_READAHEAD_TIME, POSIX_F_FALLOCATE_TIME, POSIX_F_TRUNCATE_TIME, POSIX_F_SYNC_FILE_RANGE_TIME\n");
+    }
+
+    if(ver <= 7)
+    {
+        printf("\n# WARNING: POSIX module log format version <=7 has the following limitations:\n");
+        printf("# - No support for the following counters to instrument open flags and direct I/O:\n");
+        printf("# \t- POSIX_OPENS_DIRECT, POSIX_OPENS_SYNC, POSIX_OPENS_DSYNC, POSIX_OPENS_APPEND, POSIX_OPENS_TRUNC, POSIX_OPENS_CREAT\n");
+        printf("# \t- POSIX_SETFLS\n");
+        printf("# \t- POSIX_DIRECT_READS, POSIX_DIRECT_WRITES, POSIX_DIRECT_UNALIGNED_READS, POSIX_DIRECT_UNALIGNED_WRITES, POSIX_DIRECT_FAILURES\n");
+    }
+
     if(ver >= 4)
     {
         printf("\n# WARNING: POSIX_OPENS counter includes both POSIX_FILENOS and POSIX_DUPS counts\n");
@@ -631,6 +791,54 @@ static void darshan_log_agg_posix_files(void *rec, void *agg_rec, int init_flag)
             case POSIX_SIZE_WRITE_10M_100M:
             case POSIX_SIZE_WRITE_100M_1G:
             case POSIX_SIZE_WRITE_1G_PLUS:
+            case POSIX_AIO_READS:
+            case POSIX_AIO_WRITES:
+            case POSIX_AIO_DIRECT_READS:
+            case POSIX_AIO_DIRECT_WRITES:
+            case POSIX_DELTA_BACK_4G_PLUS:
+            case POSIX_DELTA_BACK_256M_4G:
+            case POSIX_DELTA_BACK_16M_256M:
+            case POSIX_DELTA_BACK_1M_16M:
+            case POSIX_DELTA_BACK_64K_1M:
+            case POSIX_DELTA_BACK_4K_64K:
+            case POSIX_DELTA_BACK_0_4K:
+            case POSIX_DELTA_ZERO:
+            case POSIX_DELTA_FWD_0_4K:
+            case POSIX_DELTA_FWD_4K_64K:
+            case POSIX_DELTA_FWD_64K_1M:
+            case POSIX_DELTA_FWD_1M_16M:
+            case POSIX_DELTA_FWD_16M_256M:
+            case POSIX_DELTA_FWD_256M_4G:
+            case POSIX_DELTA_FWD_4G_PLUS:
+            case POSIX_REUSE_1:
+            case POSIX_REUSE_2_3:
+            case POSIX_REUSE_4_7:
+            case POSIX_REUSE_8_16:
+            case POSIX_FADVISES:
+            case POSIX_FADVISE_DONTNEEDS:
+            case POSIX_FADVISE_BYTES:
+            case POSIX_MADVISES:
+            case POSIX_MADVISE_BYTES:
+            case POSIX_READAHEADS:
+            case POSIX_READAHEAD_BYTES:
+            case POSIX_FALLOCATES:
+            case POSIX_FALLOCATE_BYTES:
+            case POSIX_TRUNCATES:
+            case POSIX_TRUNCATES_TO_ZERO:
+            case POSIX_SYNC_FILE_RANGES:
+            case POSIX_SYNC_FILE_RANGE_BYTES:
+            case POSIX_OPENS_DIRECT:
+            case POSIX_OPENS_SYNC:
+            case POSIX_OPENS_DSYNC:
+            case POSIX_OPENS_APPEND:
+            case POSIX_OPENS_TRUNC:
+            case POSIX_OPENS_CREAT:
+            case POSIX_SETFLS:
+            case POSIX_DIRECT_READS:
+            case POSIX_DIRECT_WRITES:
+            case POSIX_DIRECT_UNALIGNED_READS:
+            case POSIX_DIRECT_UNALIGNED_WRITES:
+            case POSIX_DIRECT_FAILURES:
                 /* sum */
                 agg_psx_rec->counters[i] += psx_rec->counters[i];
                 if(agg_psx_rec->counters[i] < 0) /* make sure invalid counters are -1 exactly */
@@ -776,6 +984,17 @@ static void darshan_log_agg_posix_files(void *rec, void *agg_rec, int init_flag)
                 /* sum */
                 agg_psx_rec->fcounters[i] += psx_rec->fcounters[i];
                 break;
+            case POSIX_F_FADVISE_TIME:
+            case POSIX_F_MADVISE_TIME:
+            case POSIX_F_READAHEAD_TIME:
+            case POSIX_F_FALLOCATE_TIME:
+            case POSIX_F_TRUNCATE_TIME:
+            case POSIX_F_SYNC_FILE_RANGE_TIME:
+                /* sum */
+                agg_psx_rec->fcounters[i] += psx_rec->fcounters[i];
+                if(agg_psx_rec->fcounters[i] < 0) /* make sure invalid counters are -1 exactly */
+                    agg_psx_rec->fcounters[i] = -1;
+                break;
             case POSIX_F_OPEN_START_TIMESTAMP:
             case POSIX_F_READ_START_TIMESTAMP:
             case POSIX_F_WRITE_START_TIMESTAMP:
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "darshan-logutils.h"
+
+/* counter name strings for the PROCIO module */
+#define X(a) #a,
+char *procio_counter_names[] = {
+    PROCIO_COUNTERS
+};
+
+char *procio_f_counter_names[] = {
+    PROCIO_F_COUNTERS
+};
+#undef X
+
+static int darshan_log_get_procio_rec(darshan_fd fd, void** procio_buf_p);
+static int darshan_log_put_procio_rec(darshan_fd fd, void* procio_buf);
+static void darshan_log_print_procio_rec(void *file_rec,
+    char *file_name, char *mnt_pt, char *fs_type);
+static void darshan_log_print_procio_description(int ver);
+static void darshan_log_print_procio_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2);
+static void darshan_log_agg_procio_recs(void *rec, void *agg_rec, int init_flag);
+
+struct darshan_mod_logutil_funcs procio_logutils =
+{
+    .log_get_record = &darshan_log_get_procio_rec,
+    .log_put_record = &darshan_log_put_procio_rec,
+    .log_print_record = &darshan_log_print_procio_rec,
+    .log_print_description = &darshan_log_print_procio_description,
+    .log_print_diff = &darshan_log_print_procio_rec_diff,
+    .log_agg_records = &darshan_log_agg_procio_recs
+};
+
+static int darshan_log_get_procio_rec(darshan_fd fd, void** procio_buf_p)
+{
+    struct darshan_procio_record *rec = *((struct darshan_procio_record **)procio_buf_p);
+    int rec_len;
+    int i;
+    int ret = -1;
+
+    if(fd->mod_map[DARSHAN_PROCIO_MOD].len == 0)
+        return(0);
+
+    if(fd->mod_ver[DARSHAN_PROCIO_MOD] == 0 ||
+        fd->mod_ver[DARSHAN_PROCIO_MOD] > DARSHAN_PROCIO_VER)
+    {
+        fprintf(stderr, "Error: Invalid PROCIO module version number (got %d)\n",
+            fd->mod_ver[DARSHAN_PROCIO_MOD]);
+        return(-1);
+    }
+
+    if(*procio_buf_p == NULL)
+    {
+        rec = malloc(sizeof(*rec));
+        if(!rec)
+            return(-1);
+    }
+
+    rec_len = sizeof(struct darshan_procio_record);
+    ret = darshan_log_get_mod(fd, DARSHAN_PROCIO_MOD, rec, rec_len);
+
+    if(*procio_buf_p == NULL)
+    {
+        if(ret == rec_len)
+            *procio_buf_p = rec;
+        else
+            free(rec);
+    }
+
+    if(ret < 0)
+        return(-1);
+    else if(ret < rec_len)
+        return(0);
+    else
+    {
+        if(fd->swap_flag)
+        {
+            /* swap bytes if necessary */
+            DARSHAN_BSWAP64(&(rec->base_rec.id));
+            DARSHAN_BSWAP64(&(rec->base_rec.rank));
+            for(i=0; i<PROCIO_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->counters[i]);
+            for(i=0; i<PROCIO_F_NUM_INDICES; i++)
+                DARSHAN_BSWAP64(&rec->fcounters[i]);
+        }
+
+        return(1);
+    }
+}
+
+static int darshan_log_put_procio_rec(darshan_fd fd, void* procio_buf)
+{
+    struct darshan_procio_record *rec = (struct darshan_procio_record *)procio_buf;
+    int ret;
+
+    ret = darshan_log_put_mod(fd, DARSHAN_PROCIO_MOD, rec,
+        sizeof(struct darshan_procio_record), DARSHAN_PROCIO_VER);
+    if(ret < 0)
+        return(-1);
+
+    return(0);
+}
+
+static void darshan_log_print_procio_rec(void *file_rec, char *file_name,
+    char *mnt_pt, char *fs_type)
+{
+    int i;
+    struct darshan_procio_record *procio_rec =
+        (struct darshan_procio_record *)file_rec;
+
+    for(i=0; i<PROCIO_NUM_INDICES; i++)
+    {
+        DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+            procio_rec->base_rec.rank, procio_rec->base_rec.id,
+            procio_counter_names[i], procio_rec->counters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    for(i=0; i<PROCIO_F_NUM_INDICES; i++)
+    {
+        DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+            procio_rec->base_rec.rank, procio_rec->base_rec.id,
+            procio_f_counter_names[i], procio_rec->fcounters[i],
+            file_name, mnt_pt, fs_type);
+    }
+
+    return;
+}
+
+static void darshan_log_print_procio_description(int ver)
+{
+    printf("\n# description of PROCIO counters:\n");
+    printf("#   PROCIO_*: per-process I/O accounting from /proc/self/io, summed across all\n");
+    printf("#       processes. Values are deltas between Darshan startup and shutdown and\n");
+    printf("#       cover all I/O performed by the process (not just instrumented files),\n");
+    printf("#       including I/O by child processes that were reaped in that interval.\n");
+    printf("#   PROCIO_RCHAR, PROCIO_WCHAR: bytes passed to read/write system calls.\n");
+    printf("#   PROCIO_SYSCR, PROCIO_SYSCW: count of read/write system calls.\n");
+    printf("#   PROCIO_READ_BYTES, PROCIO_WRITE_BYTES: bytes fetched from/sent to storage.\n");
+    printf("#   PROCIO_CANCELLED_WRITE_BYTES: dirty page cache bytes discarded before write-back.\n");
+    printf("#   PROCIO_IOWAIT_TICKS: clock ticks spent waiting for block I/O (requires\n");
+    printf("#       kernel delay accounting).\n");
+    printf("#   PROCIO_CLK_TCK: clock ticks per second, for converting PROCIO_IOWAIT_TICKS.\n");
+    printf("#   PROCIO_SAMPLES: number of snapshots taken across all processes.\n");
+    printf("#   PROCIO_PROCS: number of processes contributing to the record.\n");
+    printf("#   PROCIO_F_START_TIMESTAMP, PROCIO_F_END_TIMESTAMP: time of first/last snapshot.\n");
+    printf("#   PROCIO_F_MIN_INTERVAL_HIT_RATIO: lowest page cache read hit ratio observed\n");
+    printf("#       between any two consecutive periodic snapshots.\n");
+    printf("#   NOTE: a value of -1 means the counter was not available on the system.\n");
+
+    return;
+}
+
+static void darshan_log_print_procio_rec_diff(void *file_rec1, char *file_name1,
+    void *file_rec2, char *file_name2)
+{
+    struct darshan_procio_record *file1 = (struct darshan_procio_record *)file_rec1;
+    struct darshan_procio_record *file2 = (struct darshan_procio_record *)file_rec2;
+    int i;
+
+    /* NOTE: we assume that both input records are the same module format version */
+
+    for(i=0; i<PROCIO_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file1->base_rec.rank, file1->base_rec.id, procio_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file2->base_rec.rank, file2->base_rec.id, procio_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+        else if(file1->counters[i] != file2->counters[i])
+        {
+            printf("- ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file1->base_rec.rank, file1->base_rec.id, procio_counter_names[i],
+                file1->counters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file2->base_rec.rank, file2->base_rec.id, procio_counter_names[i],
+                file2->counters[i], file_name2, "", "");
+        }
+    }
+
+    for(i=0; i<PROCIO_F_NUM_INDICES; i++)
+    {
+        if(!file2)
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file1->base_rec.rank, file1->base_rec.id, procio_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+
+        }
+        else if(!file1)
+        {
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file2->base_rec.rank, file2->base_rec.id, procio_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+        else if(file1->fcounters[i] != file2->fcounters[i])
+        {
+            printf("- ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file1->base_rec.rank, file1->base_rec.id, procio_f_counter_names[i],
+                file1->fcounters[i], file_name1, "", "");
+            printf("+ ");
+            DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_PROCIO_MOD],
+                file2->base_rec.rank, file2->base_rec.id, procio_f_counter_names[i],
+                file2->fcounters[i], file_name2, "", "");
+        }
+    }
+
+    return;
+}
+
+static void darshan_log_agg_procio_recs(void *rec, void *agg_rec, int init_flag)
+{
+    struct darshan_procio_record *procio_rec = (struct darshan_procio_record *)rec;
+    struct darshan_procio_record *agg_procio_rec = (struct darshan_procio_record *)agg_rec;
+    int i;
+
+    if(init_flag)
+    {
+        /* when initializing, just copy over the first record */
+        memcpy(agg_procio_rec, procio_rec, sizeof(struct darshan_procio_record));
+        return;
+    }
+
+    for(i = 0; i < PROCIO_NUM_INDICES; i++)
+    {
+        switch(i)
+        {
+            case PROCIO_RCHAR:
+            case PROCIO_WCHAR:
+            case PROCIO_SYSCR:
+            case PROCIO_SYSCW:
+            case PROCIO_READ_BYTES:
+            case PROCIO_WRITE_BYTES:
+            case PROCIO_CANCELLED_WRITE_BYTES:
+            case PROCIO_IOWAIT_TICKS:
+                /* sum, unless unavailable for either record */
+                if(procio_rec->counters[i] < 0 || agg_procio_rec->counters[i] < 0)
+                    agg_procio_rec->counters[i] = -1;
+                else
+                    agg_procio_rec->counters[i] += procio_rec->counters[i];
+                break;
+            case PROCIO_CLK_TCK:
+                /* max */
+                if(procio_rec->counters[i] > agg_procio_rec->counters[i])
+                    agg_procio_rec->counters[i] = procio_rec->counters[i];
+                break;
+            default:
+                /* sum */
+                agg_procio_rec->counters[i] += procio_rec->counters[i];
+                break;
+        }
+    }
+
+    for(i = 0; i < PROCIO_F_NUM_INDICES; i++)
+    {
+        switch(i)
+        {
+            case PROCIO_F_START_TIMESTAMP:
+                /* minimum */
+                if(procio_rec->fcounters[i] < agg_procio_rec->fcounters[i])
+                    agg_procio_rec->fcounters[i] = procio_rec->fcounters[i];
+                break;
+            case PROCIO_F_END_TIMESTAMP:
+                /* maximum */
+                if(procio_rec->fcounters[i] > agg_procio_rec->fcounters[i])
+                    agg_procio_rec->fcounters[i] = procio_rec->fcounters[i];
+                break;
+            case PROCIO_F_MIN_INTERVAL_HIT_RATIO:
+                /* minimum, ignoring records without interval samples */
+                if(procio_rec->fcounters[i] >= 0 &&
+                    (agg_procio_rec->fcounters[i] < 0 ||
+                     procio_rec->fcounters[i] < agg_procio_rec->fcounters[i]))
+                    agg_procio_rec->fcounters[i] = procio_rec->fcounters[i];
+                break;
+            default:
+                break;
+        }
+    }
+
+    return;
+}
+
+double darshan_procio_cache_hit_ratio(struct darshan_procio_record *rec)
+{
+    double ratio;
+
+    if(rec->counters[PROCIO_RCHAR] <= 0 || rec->counters[PROCIO_READ_BYTES] < 0)
+        return(-1);
+
+    /* readahead may fetch more from storage than the application asked for */
+    ratio = 1.0 - ((double)rec->counters[PROCIO_READ_BYTES] /
+        (double)rec->counters[PROCIO_RCHAR]);
+    if(ratio < 0)
+        ratio = 0;
+
+    return(ratio);
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,23 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_PROCIO_LOG_UTILS_H
+#define __DARSHAN_PROCIO_LOG_UTILS_H
+
+extern char *procio_counter_names[];
+extern char *procio_f_counter_names[];
+
+extern struct darshan_mod_logutil_funcs procio_logutils;
+
+/* darshan_procio_cache_hit_ratio()
+ *
+ * returns the estimated fraction of bytes read by the job that were
+ * satisfied from the page cache rather than storage, or -1 if this
+ * cannot be determined from the given record
+ */
+double darshan_procio_cache_hit_ratio(struct darshan_procio_record *rec);
+
+#endif
@@ -0,0 +1,498 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <inttypes.h>
+#include <getopt.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "uthash-1.9.2/src/uthash.h"
+
+#include "darshan-logutils.h"
+
+/* exit status when damage is found in an input log with --check */
+#define SALVAGE_DAMAGE_FOUND 2
+
+static char *region_status_str[] =
+{
+    "intact",
+    "truncated",
+    "invalid",
+    "corrupt"
+};
+
+void usage(char *exename)
+{
+    fprintf(stderr, "Usage: %s [options] <input_log> [<input_log> ...]\n", exename);
+    fprintf(stderr, "This utility recovers the complete records of damaged Darshan log files, such\n");
+    fprintf(stderr, "as truncated logs or the mmap log files left behind by a job that was killed,\n");
+    fprintf(stderr, "and writes them to a single valid output log file.\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "\t--output\tFull path of the output darshan log file (required unless --check is given).\n");
+    fprintf(stderr, "\t--check\t\tOnly report the damage found in the input logs.\n");
+    fprintf(stderr, "\t--job-end-time\tSet the output log's job end time (requires argument of seconds since Epoch).\n");
+
+    exit(1);
+}
+
+void parse_args(int argc, char **argv, char ***infile_list, int *n_files,
+    char **outlog_path, int *check_only, int64_t *job_end_time)
+{
+    int index;
+    char *check;
+    static struct option long_opts[] =
+    {
+        {"output", required_argument, NULL, 'o'},
+        {"check", no_argument, NULL, 'c'},
+        {"job-end-time", required_argument, NULL, 'e'},
+        {0, 0, 0, 0}
+    };
+
+    *check_only = 0;
+    *outlog_path = NULL;
+    *job_end_time = 0;
+
+    while(1)
+    {
+        int c = getopt_long(argc, argv, "", long_opts, &index);
+
+        if(c == -1) break;
+
+        switch(c)
+        {
+            case 'c':
+                *check_only = 1;
+                break;
+            case 'o':
+                *outlog_path = optarg;
+                break;
+            case 'e':
+                *job_end_time = strtol(optarg, &check, 10);
+                if(optarg == check)
+                {
+                    fprintf(stderr, "Error: unable to parse job end time value.\n");
+                    exit(1);
+                }
+                break;
+            case '?':
+            default:
+                usage(argv[0]);
+                break;
+        }
+    }
+
+    if((*outlog_path == NULL && !(*check_only)) || optind == argc)
+    {
+        usage(argv[0]);
+    }
+
+    *infile_list = &argv[optind];
+    *n_files = argc - optind;
+
+    return;
+}
+
+/* recover the records of one module from an input log, writing them to the
+ * output log if one is given
+ *
+ * returns 1 if the module's data is incomplete, 0 if it is not, and -1 if
+ * writing to the output log failed
+ */
+int salvage_mod_records(darshan_fd in_fd, struct darshan_log_damage *damage,
+    darshan_module_id mod_id, char *mod_buf, darshan_fd out_fd,
+    int *n_recs, int *n_dropped)
+{
+    struct darshan_base_record *base_rec;
+    int64_t rec_bytes = 0;
+    int partial = 0;
+    int ret;
+
+    *n_recs = 0;
+    *n_dropped = 0;
+
+    while((ret = mod_logutils[mod_id]->log_get_record(in_fd, (void **)&mod_buf)) == 1)
+    {
+        base_rec = (struct darshan_base_record *)mod_buf;
+        if(mod_logutils[mod_id]->log_sizeof_record)
+            rec_bytes += mod_logutils[mod_id]->log_sizeof_record(mod_buf);
+
+        /* records allocated in an mmap log but never filled in by the
+         * module are left zeroed and carry no record id
+         */
+        if(base_rec->id == 0)
+        {
+            (*n_dropped)++;
+            continue;
+        }
+
+        if(out_fd)
+        {
+            ret = mod_logutils[mod_id]->log_put_record(out_fd, mod_buf);
+            if(ret < 0)
+            {
+                fprintf(stderr,
+                    "Error: unable to write %s module record to output darshan log.\n",
+                    darshan_module_names[mod_id]);
+                return(-1);
+            }
+        }
+        (*n_recs)++;
+    }
+
+    /* the module's data is incomplete if the region was cut short, if
+     * a record could not be decoded, or if the records of an uncompressed
+     * log don't add up to the size of the region (checked for modules that
+     * can report their record sizes)
+     */
+    if(ret < 0 || damage->mod_status[mod_id] != DARSHAN_REGION_INTACT)
+        partial = 1;
+    else if(in_fd->comp_type == DARSHAN_NO_COMP &&
+        mod_logutils[mod_id]->log_sizeof_record &&
+        in_fd->mod_ver[mod_id] == darshan_module_versions[mod_id] &&
+        rec_bytes != (int64_t)in_fd->mod_map[mod_id].len)
+        partial = 1;
+
+    return(partial);
+}
+
+void free_name_hash(struct darshan_name_record_ref **hash)
+{
+    struct darshan_name_record_ref *ref, *tmp;
+
+    HASH_ITER(hlink, *hash, ref, tmp)
+    {
+        HASH_DELETE(hlink, *hash, ref);
+        free(ref->name_record);
+        free(ref);
+    }
+
+    return;
+}
+
+int main(int argc, char *argv[])
+{
+    char **infile_list;
+    int n_infiles;
+    int check_only;
+    int64_t job_end_time;
+    char *outlog_path;
+    darshan_fd in_fd, out_fd = NULL;
+    struct darshan_log_damage damage;
+    struct darshan_job in_job, out_job;
+    char out_exe[DARSHAN_EXE_LEN+1] = {0};
+    struct darshan_mnt_info *out_mnt_array = NULL;
+    int out_mnt_count = 0;
+    int have_job = 0;
+    int64_t last_mtime = 0;
+    struct darshan_name_record_ref *in_hash = NULL;
+    struct darshan_name_record_ref *out_hash = NULL;
+    struct darshan_name_record_ref *ref, *tmp, *found;
+    char *mod_buf;
+    int *valid_infile;
+    int damaged = 0;
+    int n_names;
+    int n_recs, n_dropped;
+    int tot_recs, tot_dropped;
+    int partial;
+    struct stat sbuf;
+    int i, j;
+    int ret;
+
+    /* grab command line arguments */
+    parse_args(argc, argv, &infile_list, &n_infiles, &outlog_path, &check_only,
+        &job_end_time);
+
+    valid_infile = malloc(n_infiles * sizeof(*valid_infile));
+    mod_buf = malloc(DEF_MOD_BUF_SIZE);
+    if(!valid_infile || !mod_buf)
+    {
+        fprintf(stderr, "Error: unable to allocate memory.\n");
+        return(1);
+    }
+
+    memset(&out_job, 0, sizeof(struct darshan_job));
+
+    /* first pass over the input logs:
+     *      - validate each log's header and region maps
+     *      - compose output job-level metadata structure (including exe & mount data)
+     *      - compose output record_id->file_name mapping from complete name records
+     */
+    for(i = 0; i < n_infiles; i++)
+    {
+        valid_infile[i] = 0;
+
+        in_fd = darshan_log_open_salvage(infile_list[i], &damage);
+        if(in_fd == NULL)
+        {
+            printf("# %s: unusable (no valid log header)\n", infile_list[i]);
+            damaged = 1;
+            continue;
+        }
+        valid_infile[i] = 1;
+
+        printf("# %s: %" PRId64 " bytes\n", infile_list[i], damage.file_size);
+        if(damage.checksum_type != DARSHAN_NO_CHECKSUM)
+            printf("#   header: %s\n", region_status_str[damage.header_status]);
+        if(damage.header_status != DARSHAN_REGION_INTACT ||
+           damage.job_status != DARSHAN_REGION_INTACT ||
+           damage.name_status != DARSHAN_REGION_INTACT)
+            damaged = 1;
+        for(j = 0; j < DARSHAN_MAX_MODS; j++)
+        {
+            if(damage.mod_status[j] != DARSHAN_REGION_INTACT)
+                damaged = 1;
+        }
+
+        /* read job-level metadata from the input file */
+        memset(&in_job, 0, sizeof(struct darshan_job));
+        ret = darshan_log_get_job(in_fd, &in_job);
+        printf("#   job data: %s%s\n", region_status_str[damage.job_status],
+            (ret < 0) ? ", unreadable" : "");
+        if(ret < 0)
+        {
+            damaged = 1;
+        }
+        else if(!have_job)
+        {
+            /* get job data, exe, & mounts directly from the first readable log */
+            memcpy(&out_job, &in_job, sizeof(struct darshan_job));
+            if(darshan_log_get_exe(in_fd, out_exe) < 0 ||
+               darshan_log_get_mounts(in_fd, &out_mnt_array, &out_mnt_count) < 0)
+            {
+                /* the job data is still usable without exe & mounts */
+                out_exe[0] = '\0';
+                out_mnt_count = 0;
+                damaged = 1;
+            }
+            have_job = 1;
+        }
+        else
+        {
+            /* potentially update job timestamps using remaining logs */
+            if((in_job.start_time_sec < out_job.start_time_sec) ||
+               ((in_job.start_time_sec == out_job.start_time_sec) &&
+                (in_job.start_time_nsec < out_job.start_time_nsec)))
+            {
+                out_job.start_time_sec = in_job.start_time_sec;
+                out_job.start_time_nsec = in_job.start_time_nsec;
+            }
+            if((in_job.end_time_sec > out_job.end_time_sec) ||
+               ((in_job.end_time_sec == out_job.end_time_sec) &&
+                (in_job.end_time_nsec > out_job.end_time_nsec)))
+            {
+                out_job.end_time_sec = in_job.end_time_sec;
+                out_job.end_time_nsec = in_job.end_time_nsec;
+            }
+        }
+
+        /* the last time an input was written is the best guess at when a
+         * killed job stopped doing I/O
+         */
+        if(stat(infile_list[i], &sbuf) == 0 && sbuf.st_mtime > last_mtime)
+            last_mtime = sbuf.st_mtime;
+
+        /* read every complete name record from the input log */
+        in_hash = NULL;
+        ret = darshan_log_get_namehash(in_fd, &in_hash);
+        n_names = HASH_CNT(hlink, in_hash);
+        printf("#   name records: %s, %d recovered\n",
+            region_status_str[damage.name_status], n_names);
+        if(ret < 0)
+            damaged = 1;
+
+        /* move name records that are not already in the output hash over */
+        HASH_ITER(hlink, in_hash, ref, tmp)
+        {
+            HASH_DELETE(hlink, in_hash, ref);
+            HASH_FIND(hlink, out_hash, &(ref->name_record->id),
+                sizeof(darshan_record_id), found);
+            if(!found)
+            {
+                HASH_ADD(hlink, out_hash, name_record->id,
+                    sizeof(darshan_record_id), ref);
+            }
+            else
+            {
+                if(strcmp(ref->name_record->name, found->name_record->name))
+                {
+                    fprintf(stderr,
+                        "Warning: conflicting names for record id %" PRIu64 ", keeping %s.\n",
+                        ref->name_record->id, found->name_record->name);
+                    damaged = 1;
+                }
+                free(ref->name_record);
+                free(ref);
+            }
+        }
+
+        /* check each module's records */
+        for(j = 0; j < DARSHAN_KNOWN_MODULE_COUNT; j++)
+        {
+            if(!mod_logutils[j]) continue;
+            if(in_fd->mod_map[j].len == 0 &&
+               damage.mod_status[j] == DARSHAN_REGION_INTACT)
+                continue;
+
+            partial = salvage_mod_records(in_fd, &damage, j, mod_buf, NULL,
+                &n_recs, &n_dropped);
+            printf("#   %s module: %s, %d records recovered",
+                darshan_module_names[j], region_status_str[damage.mod_status[j]],
+                n_recs);
+            if(n_dropped)
+                printf(", %d unused records dropped", n_dropped);
+            if(partial)
+            {
+                printf(", incomplete");
+                damaged = 1;
+            }
+            printf("\n");
+        }
+
+        darshan_log_close(in_fd);
+    }
+
+    if(check_only || !have_job)
+    {
+        if(!check_only)
+            fprintf(stderr, "Error: no job data could be recovered from the input logs.\n");
+        free(mod_buf);
+        free(valid_infile);
+        free(out_mnt_array);
+        free_name_hash(&out_hash);
+        if(!check_only)
+            return(1);
+        return(damaged ? SALVAGE_DAMAGE_FOUND : 0);
+    }
+
+    /* a job that was killed never recorded its end time */
+    if(job_end_time > 0)
+    {
+        out_job.end_time_sec = job_end_time;
+        out_job.end_time_nsec = 0; /* no nsec precision for manually specified end */
+    }
+    else if(out_job.end_time_sec < out_job.start_time_sec)
+    {
+        out_job.end_time_sec = (last_mtime > out_job.start_time_sec) ?
+            last_mtime : out_job.start_time_sec;
+        out_job.end_time_nsec = 0;
+    }
+
+    /* create the output log */
+    out_fd = darshan_log_create(outlog_path, DARSHAN_ZLIB_COMP, 0);
+    if(out_fd == NULL)
+    {
+        fprintf(stderr, "Error: unable to create output darshan log.\n");
+        free(mod_buf);
+        free(valid_infile);
+        return(1);
+    }
+
+    /* write the darshan job info, exe string, and mount data to output file */
+    ret = darshan_log_put_job(out_fd, &out_job);
+    if(ret < 0)
+    {
+        fprintf(stderr, "Error: unable to write job data to output darshan log.\n");
+        goto fail;
+    }
+
+    ret = darshan_log_put_exe(out_fd, out_exe);
+    if(ret < 0)
+    {
+        fprintf(stderr, "Error: unable to write exe string to output darshan log.\n");
+        goto fail;
+    }
+
+    ret = darshan_log_put_mounts(out_fd, out_mnt_array, out_mnt_count);
+    if(ret < 0)
+    {
+        fprintf(stderr, "Error: unable to write mount data to output darshan log.\n");
+        goto fail;
+    }
+
+    /* write the recovered table of records to output file */
+    ret = darshan_log_put_namehash(out_fd, out_hash);
+    if(ret < 0)
+    {
+        fprintf(stderr, "Error: unable to write record table to output darshan log.\n");
+        goto fail;
+    }
+
+    /* second pass: copy each module's recovered records to the output log,
+     * marking the module partial if any input held incomplete data for it
+     */
+    for(i = 0; i < DARSHAN_KNOWN_MODULE_COUNT; i++)
+    {
+        if(!mod_logutils[i]) continue;
+
+        tot_recs = tot_dropped = 0;
+        for(j = 0; j < n_infiles; j++)
+        {
+            if(!valid_infile[j]) continue;
+
+            in_fd = darshan_log_open_salvage(infile_list[j], &damage);
+            if(in_fd == NULL)
+            {
+                fprintf(stderr,
+                    "Error: unable to open input Darshan log file %s.\n",
+                    infile_list[j]);
+                goto fail;
+            }
+
+            if(DARSHAN_MOD_FLAG_ISSET(in_fd->partial_flag, i))
+                DARSHAN_MOD_FLAG_SET(out_fd->partial_flag, i);
+
+            partial = salvage_mod_records(in_fd, &damage, i, mod_buf, out_fd,
+                &n_recs, &n_dropped);
+            darshan_log_close(in_fd);
+            if(partial < 0)
+                goto fail;
+            if(partial)
+                DARSHAN_MOD_FLAG_SET(out_fd->partial_flag, i);
+            tot_recs += n_recs;
+            tot_dropped += n_dropped;
+        }
+
+        if(tot_recs || DARSHAN_MOD_FLAG_ISSET(out_fd->partial_flag, i))
+            printf("# output %s module: %d records%s\n", darshan_module_names[i],
+                tot_recs, DARSHAN_MOD_FLAG_ISSET(out_fd->partial_flag, i) ?
+                ", marked partial" : "");
+    }
+
+    darshan_log_close(out_fd);
+
+    free(mod_buf);
+    free(valid_infile);
+    free(out_mnt_array);
+    free_name_hash(&out_hash);
+
+    return(0);
+
+fail:
+    darshan_log_close(out_fd);
+    unlink(outlog_path);
+    free(mod_buf);
+    free(valid_infile);
+    free(out_mnt_array);
+    free_name_hash(&out_hash);
+    return(1);
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include "darshan-logutils.h"
+
+/* counter name strings for the SNAPSHOT module */
+#define X(a) #a,
+char *snapshot_counter_names[] = {
+    SNAPSHOT_COUNTERS
+};
+#undef X
+
+/* prototypes for each of the snapshot module's logutil functions */
+static int darshan_log_get_snapshot_record(darshan_fd fd, void** snapshot_buf_p);
+static int darshan_log_put_snapshot_record(darshan_fd fd, void* snapshot_buf);
+static void darshan_log_print_snapshot_record(void *file_rec,
+    char *file_name, char *mnt_pt, char *fs_type);
+static void darshan_log_print_snapshot_description(int ver);
+
+/* structure storing each function needed for implementing the darshan
+ * logutil interface. these functions are used for reading, writing, and
+ * printing module data in a consistent manner.
+ */
+struct darshan_mod_logutil_funcs snapshot_logutils =
+{
+    .log_get_record = &darshan_log_get_snapshot_record,
+    .log_put_record = &darshan_log_put_snapshot_record,
+    .log_print_record = &darshan_log_print_snapshot_record,
+    .log_print_description = &darshan_log_print_snapshot_description,
+    /* _diff and _agg are deliberately not implemented; as with the heatmap,
+     * snapshots are always reported per process
+     */
+    .log_print_diff = NULL,
+    .log_agg_records = NULL
+};
+
+/* number of counters captured in each snapshot of a record */
+static int snapshot_ncounters(struct darshan_snapshot_record *rec)
+{
+    int i, n = 0;
+
+    for(i = 0; i < SNAPSHOT_NUM_INDICES; i++)
+    {
+        if(rec->counter_mask & (((int64_t)1) << i))
+            n++;
+    }
+
+    return(n);
+}
+
+/* size of the arrays trailing a snapshot record */
+static size_t snapshot_trailing_size(struct darshan_snapshot_record *rec)
+{
+    return(rec->nsnapshots * (sizeof(double) +
+        snapshot_ncounters(rec) * sizeof(int64_t)));
+}
+
+/* retrieve a snapshot record from log file descriptor 'fd', storing the
+ * data in the buffer address pointed to by 'snapshot_buf_p'. Return 1 on
+ * successful record read, 0 on no more data, and -1 on error.
+ */
+static int darshan_log_get_snapshot_record(darshan_fd fd, void** snapshot_buf_p)
+{
+    struct darshan_snapshot_record *rec = *((struct darshan_snapshot_record **)snapshot_buf_p);
+    struct darshan_snapshot_record static_rec = {0};
+    void* trailing;
+    size_t trailing_size;
+    int ret;
+    int i;
+
+    if(fd->mod_map[DARSHAN_SNAPSHOT_MOD].len == 0)
+        return(0);
+
+    if(fd->mod_ver[DARSHAN_SNAPSHOT_MOD] == 0 ||
+        fd->mod_ver[DARSHAN_SNAPSHOT_MOD] > DARSHAN_SNAPSHOT_VER)
+    {
+        fprintf(stderr, "Error: Invalid SNAPSHOT module version number (got %d)\n",
+            fd->mod_ver[DARSHAN_SNAPSHOT_MOD]);
+        return(-1);
+    }
+
+    if(*snapshot_buf_p == NULL)
+        rec = &static_rec;
+
+    /* read base record; it is a fixed size */
+    ret = darshan_log_get_mod(fd, DARSHAN_SNAPSHOT_MOD, rec,
+        sizeof(struct darshan_snapshot_record));
+    if(ret < 0)
+        return(-1);
+    else if(ret < sizeof(struct darshan_snapshot_record))
+        return(0);
+
+    /* do byte swapping if necessary */
+    if(fd->swap_flag)
+    {
+        DARSHAN_BSWAP64(&rec->base_rec.id);
+        DARSHAN_BSWAP64(&rec->base_rec.rank);
+        DARSHAN_BSWAP64(&rec->interval_seconds);
+        DARSHAN_BSWAP64(&rec->counter_mask);
+        DARSHAN_BSWAP64(&rec->nsnapshots);
+        DARSHAN_BSWAP64(&rec->dropped);
+    }
+    if(rec->nsnapshots < 0)
+    {
+        fprintf(stderr, "Error: Invalid SNAPSHOT record (%" PRId64 " snapshots)\n",
+            rec->nsnapshots);
+        return(-1);
+    }
+
+    /* if buffer was provided by caller, then it is implied that it is
+     * DEF_MOD_BUF_SIZE bytes in size.  Make sure it is big enough, or if we
+     * are allocating the buffer malloc enough size */
+    trailing_size = snapshot_trailing_size(rec);
+    if(*snapshot_buf_p)
+    {
+        if(sizeof(*rec) + trailing_size > DEF_MOD_BUF_SIZE)
+        {
+            fprintf(stderr, "Error: SNAPSHOT record is %zu bytes, but DEF_MOD_BUF_SIZE is only %d bytes\n",
+                sizeof(*rec) + trailing_size, DEF_MOD_BUF_SIZE);
+            return(-1);
+        }
+    }
+    else
+    {
+        *snapshot_buf_p = malloc(sizeof(*rec) + trailing_size);
+        if(!(*snapshot_buf_p))
+            return(-1);
+        memcpy(*snapshot_buf_p, rec, sizeof(*rec));
+        rec = *snapshot_buf_p;
+    }
+
+    /* set pointer for trailing data */
+    trailing = (void*)((intptr_t)(*snapshot_buf_p) + sizeof(*rec));
+    ret = darshan_log_get_mod(fd, DARSHAN_SNAPSHOT_MOD, trailing, trailing_size);
+    if(ret < 0 || (size_t)ret < trailing_size)
+        return(-1);
+
+    /* set pointers and byteswap trailing data */
+    rec->times = (double*)((uintptr_t)rec + sizeof(*rec));
+    rec->deltas = (int64_t*)((uintptr_t)rec->times +
+        rec->nsnapshots * sizeof(double));
+    if(fd->swap_flag)
+    {
+        for(i = 0; i < rec->nsnapshots; i++)
+            DARSHAN_BSWAP64(&rec->times[i]);
+        for(i = 0; i < rec->nsnapshots * snapshot_ncounters(rec); i++)
+            DARSHAN_BSWAP64(&rec->deltas[i]);
+    }
+
+    return(1);
+}
+
+/* write the snapshot record stored in 'snapshot_buf' to log file descriptor
+ * 'fd'.  Return 0 on success, -1 on failure
+ */
+static int darshan_log_put_snapshot_record(darshan_fd fd, void* snapshot_buf)
+{
+    struct darshan_snapshot_record *rec = (struct darshan_snapshot_record *)snapshot_buf;
+    int ret;
+
+    /* append snapshot record to darshan log file */
+    ret = darshan_log_put_mod(fd, DARSHAN_SNAPSHOT_MOD, rec,
+        sizeof(struct darshan_snapshot_record) + snapshot_trailing_size(rec),
+        DARSHAN_SNAPSHOT_VER);
+    if(ret < 0)
+        return(-1);
+
+    return(0);
+}
+
+/* print all I/O data record statistics for the given snapshot record */
+static void darshan_log_print_snapshot_record(void *file_rec, char *file_name,
+    char *mnt_pt, char *fs_type)
+{
+    struct darshan_snapshot_record *snapshot_rec =
+        (struct darshan_snapshot_record *)file_rec;
+    char counter_name_buffer[256];
+    int ncounters = snapshot_ncounters(snapshot_rec);
+    int i, j, k;
+
+    DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_SNAPSHOT_MOD],
+        snapshot_rec->base_rec.rank, snapshot_rec->base_rec.id,
+        "SNAPSHOT_F_INTERVAL_SECONDS",
+        snapshot_rec->interval_seconds, file_name, mnt_pt, fs_type);
+    DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_SNAPSHOT_MOD],
+        snapshot_rec->base_rec.rank, snapshot_rec->base_rec.id,
+        "SNAPSHOT_DROPPED",
+        snapshot_rec->dropped, file_name, mnt_pt, fs_type);
+
+    for(i = 0; i < snapshot_rec->nsnapshots; i++)
+    {
+        snprintf(counter_name_buffer, 256, "SNAPSHOT_F_TIME_%d", i);
+        DARSHAN_F_COUNTER_PRINT(darshan_module_names[DARSHAN_SNAPSHOT_MOD],
+            snapshot_rec->base_rec.rank, snapshot_rec->base_rec.id,
+            counter_name_buffer,
+            snapshot_rec->times[i], file_name, mnt_pt, fs_type);
+        for(j = 0, k = 0; j < SNAPSHOT_NUM_INDICES; j++)
+        {
+            if(!(snapshot_rec->counter_mask & (((int64_t)1) << j)))
+                continue;
+            snprintf(counter_name_buffer, 256, "%s_%d",
+                snapshot_counter_names[j], i);
+            DARSHAN_D_COUNTER_PRINT(darshan_module_names[DARSHAN_SNAPSHOT_MOD],
+                snapshot_rec->base_rec.rank, snapshot_rec->base_rec.id,
+                counter_name_buffer,
+                snapshot_rec->deltas[i*ncounters + k], file_name, mnt_pt, fs_type);
+            k++;
+        }
+    }
+
+    return;
+}
+
+/* print out a description of the snapshot module record fields */
+static void darshan_log_print_snapshot_description(int ver)
+{
+    printf("\n# description of SNAPSHOT counters:\n");
+    printf("#   SNAPSHOT_F_INTERVAL_SECONDS: time duration of each snapshot interval\n");
+    printf("#   SNAPSHOT_DROPPED: number of earlier snapshots overwritten when the snapshot ring wrapped\n");
+    printf("#   SNAPSHOT_F_TIME_{*}: start time of the interval of each snapshot (relative to job start)\n");
+    printf("#   SNAPSHOT_OPENS_{*}: opens within the snapshot interval\n");
+    printf("#   SNAPSHOT_STATS_{*}: stats within the snapshot interval\n");
+    printf("#   SNAPSHOT_FSYNCS_{*}: fsyncs and fdatasyncs (POSIX) or fflushes (STDIO) within the snapshot interval\n");
+    printf("#   SNAPSHOT_SEEKS_{*}: seeks within the snapshot interval\n");
+    printf("#   SNAPSHOT_{READS|WRITES}_{*}: read and write operations within the snapshot interval\n");
+    printf("#   SNAPSHOT_BYTES_{READ|WRITTEN}_{*}: bytes read and written within the snapshot interval\n");
+    printf("#   NOTE: only the counters selected with DARSHAN_SNAPSHOT_COUNTERS are captured,\n");
+    printf("#         and intervals without activity are not recorded\n");
+
+    return;
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
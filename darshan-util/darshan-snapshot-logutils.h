@@ -0,0 +1,14 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_SNAPSHOT_LOG_UTILS_H
+#define __DARSHAN_SNAPSHOT_LOG_UTILS_H
+
+extern char *snapshot_counter_names[];
+
+extern struct darshan_mod_logutil_funcs snapshot_logutils;
+
+#endif
@@ -37,6 +37,7 @@ char *stdio_f_counter_names[] = {
 #undef X
 
 #define DARSHAN_STDIO_FILE_SIZE_1 240
+#define DARSHAN_STDIO_FILE_SIZE_2 248
 
 /* prototypes for each of the STDIO module's logutil functions */
 static int darshan_log_get_stdio_record(darshan_fd fd, void** stdio_buf_p);
@@ -177,12 +178,15 @@ static int darshan_log_get_stdio_record(darshan_fd fd, void** stdio_buf_p)
         int len;
 
         if(fd->mod_ver[DARSHAN_STDIO_MOD] == 1)
-        {
             rec_len = DARSHAN_STDIO_FILE_SIZE_1;
-            ret = darshan_log_get_mod(fd, DARSHAN_STDIO_MOD, scratch, rec_len);
-            if(ret != rec_len)
-                goto exit;
+        else
+            rec_len = DARSHAN_STDIO_FILE_SIZE_2;
+        ret = darshan_log_get_mod(fd, DARSHAN_STDIO_MOD, scratch, rec_len);
+        if(ret != rec_len)
+            goto exit;
 
+        if(fd->mod_ver[DARSHAN_STDIO_MOD] == 1)
+        {
             /* upconvert version 1 to version 2 in-place */
             dest_p = scratch + sizeof(struct darshan_base_record) +
                 (2 * sizeof(int64_t));
@@ -191,7 +195,23 @@ static int darshan_log_get_stdio_record(darshan_fd fd, void** stdio_buf_p)
             memmove(dest_p, src_p, len);
             /* set FDOPENS to -1 */
             *((int64_t *)src_p) = -1;
+            rec_len += sizeof(int64_t);
+        }
+        if(fd->mod_ver[DARSHAN_STDIO_MOD] <= 2)
+        {
+            /* upconvert version 2 to version 3 in-place */
+            src_p = scratch + sizeof(struct darshan_base_record) +
+                (STDIO_SETVBUFS * sizeof(int64_t));
+            dest_p = src_p + (5 * sizeof(int64_t));
+            len = rec_len - (src_p - scratch);
+            memmove(dest_p, src_p, len);
+            /* buffering was not instrumented; mark all new counters unknown */
+            for(i=0; i<5; i++)
+                ((int64_t *)src_p)[i] = -1;
         }
+        /* restore the on-disk length for the success check below */
+        rec_len = (fd->mod_ver[DARSHAN_STDIO_MOD] == 1) ?
+            DARSHAN_STDIO_FILE_SIZE_1 : DARSHAN_STDIO_FILE_SIZE_2;
 
         memcpy(file, scratch, sizeof(struct darshan_stdio_file));
     }
@@ -224,6 +244,9 @@ exit:
                 if((fd->mod_ver[DARSHAN_STDIO_MOD] == 1) &&
                     (i == STDIO_FDOPENS))
                     continue;
+                if((fd->mod_ver[DARSHAN_STDIO_MOD] <= 2) &&
+                    (i >= STDIO_SETVBUFS) && (i <= STDIO_POSIX_WRITES))
+                    continue;
                 DARSHAN_BSWAP64(&file->counters[i]);
             }
             for(i=0; i<STDIO_F_NUM_INDICES; i++)
@@ -288,6 +311,10 @@ static void darshan_log_print_stdio_description(int ver)
     printf("#   STDIO_MAX_BYTE_*: highest offset byte read and written.\n");
     printf("#   STDIO_*_RANK: rank of the processes that were the fastest and slowest at I/O (for shared files).\n");
     printf("#   STDIO_*_RANK_BYTES: bytes transferred by the fastest and slowest ranks (for shared files).\n");
+    printf("#   STDIO_SETVBUFS: number of calls to setvbuf(), setbuf(), setbuffer(), and setlinebuf().\n");
+    printf("#   STDIO_BUF_MODE: stream buffering mode (0 = unknown, 1 = full, 2 = line, 3 = unbuffered; most restrictive for shared files).\n");
+    printf("#   STDIO_BUF_SIZE: size of the stream buffer in bytes (smallest for shared files).\n");
+    printf("#   STDIO_POSIX_{READS|WRITES}: estimated read()/write() system calls issued by the stdio library (lower bound, -1 if unknown).\n");
     printf("#   STDIO_F_*_START_TIMESTAMP: timestamp of the first call to that type of function.\n");
     printf("#   STDIO_F_*_END_TIMESTAMP: timestamp of the completion of the last call to that type of function.\n");
     printf("#   STDIO_F_*_TIME: cumulative time spent in different types of functions.\n");
@@ -299,6 +326,11 @@ static void darshan_log_print_stdio_description(int ver)
         printf("\n# WARNING: STDIO module log format version 1 has the following limitations:\n");
         printf("# - No support for properly instrumenting fdopen operations (STDIO_FDOPENS)\n");
     }
+    if(ver <= 2)
+    {
+        printf("\n# WARNING: STDIO module log format version <=2 does not support the following counters:\n");
+        printf("# - STDIO_SETVBUFS, STDIO_BUF_MODE, STDIO_BUF_SIZE, STDIO_POSIX_READS, STDIO_POSIX_WRITES\n");
+    }
 
     if(ver >= 2)
     {
@@ -483,6 +515,18 @@ static void darshan_log_agg_stdio_records(void *rec, void *agg_rec, int init_fla
                 /* sum */
                 agg_stdio_rec->counters[i] += stdio_rec->counters[i];
                 break;
+            case STDIO_SETVBUFS:
+            case STDIO_POSIX_READS:
+            case STDIO_POSIX_WRITES:
+                /* sum, unless unknown */
+                if(init_flag)
+                    agg_stdio_rec->counters[i] = stdio_rec->counters[i];
+                else if(stdio_rec->counters[i] < 0 || agg_stdio_rec->counters[i] < 0)
+                    agg_stdio_rec->counters[i] = -1;
+                else
+                    agg_stdio_rec->counters[i] += stdio_rec->counters[i];
+                break;
+            case STDIO_BUF_MODE:
             case STDIO_MAX_BYTE_READ:
             case STDIO_MAX_BYTE_WRITTEN:
                 /* max */
@@ -491,6 +535,17 @@ static void darshan_log_agg_stdio_records(void *rec, void *agg_rec, int init_fla
                     agg_stdio_rec->counters[i] = stdio_rec->counters[i];
                 }
                 break;
+            case STDIO_BUF_SIZE:
+                /* minimum non-zero */
+                if((stdio_rec->counters[i] > 0)  &&
+                    ((agg_stdio_rec->counters[i] <= 0) ||
+                    (stdio_rec->counters[i] < agg_stdio_rec->counters[i])))
+                {
+                    agg_stdio_rec->counters[i] = stdio_rec->counters[i];
+                }
+                else if(init_flag)
+                    agg_stdio_rec->counters[i] = stdio_rec->counters[i];
+                break;
             case STDIO_FASTEST_RANK:
             case STDIO_FASTEST_RANK_BYTES:
             case STDIO_SLOWEST_RANK:
@@ -659,6 +714,19 @@ static void darshan_log_agg_stdio_records(void *rec, void *agg_rec, int init_fla
     return;
 }
 
+double darshan_stdio_posix_ops_per_op(struct darshan_stdio_file *rec)
+{
+    int64_t stdio_ops = rec->counters[STDIO_READS] +
+        rec->counters[STDIO_WRITES] + rec->counters[STDIO_FLUSHES];
+
+    if(stdio_ops <= 0 || rec->counters[STDIO_POSIX_READS] < 0 ||
+        rec->counters[STDIO_POSIX_WRITES] < 0)
+        return(-1);
+
+    return((double)(rec->counters[STDIO_POSIX_READS] +
+        rec->counters[STDIO_POSIX_WRITES]) / (double)stdio_ops);
+}
+
 /*
  * Local variables:
  *  c-indent-level: 4
@@ -15,4 +15,13 @@ extern char *stdio_f_counter_names[];
 
 extern struct darshan_mod_logutil_funcs stdio_logutils;
 
+/* darshan_stdio_posix_ops_per_op()
+ *
+ * returns the estimated number of read/write system calls issued by the
+ * stdio library per stdio read/write/flush operation for the given record
+ * (i.e., its syscall amplification ratio), or -1 if this cannot be
+ * determined from the given record
+ */
+double darshan_stdio_posix_ops_per_op(struct darshan_stdio_file *rec);
+
 #endif
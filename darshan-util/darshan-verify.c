@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "darshan-util-config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "darshan-logutils.h"
+
+/* exit status when at least one log is damaged or unreadable */
+#define VERIFY_DAMAGE_FOUND 2
+
+static char *region_status_str[] =
+{
+    "intact",
+    "truncated",
+    "invalid",
+    "corrupt"
+};
+
+void usage(char *exename)
+{
+    fprintf(stderr, "Usage: %s [options] [<log> ...]\n", exename);
+    fprintf(stderr, "This utility checks the integrity of Darshan log files without decompressing\n");
+    fprintf(stderr, "them, using the checksums of their header and regions where the logs carry\n");
+    fprintf(stderr, "them. Log paths are read from standard input, one per line, if none are given.\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "\t--quiet\t\t\tOnly report logs that are damaged or unreadable.\n");
+    fprintf(stderr, "\t--require-checksums\tReport logs without checksums as damaged.\n");
+
+    exit(1);
+}
+
+void parse_args(int argc, char **argv, char ***infile_list, int *n_files,
+    int *quiet, int *require_checksums)
+{
+    int index;
+    static struct option long_opts[] =
+    {
+        {"quiet", no_argument, NULL, 'q'},
+        {"require-checksums", no_argument, NULL, 'r'},
+        {0, 0, 0, 0}
+    };
+
+    *quiet = 0;
+    *require_checksums = 0;
+
+    while(1)
+    {
+        int c = getopt_long(argc, argv, "", long_opts, &index);
+
+        if(c == -1) break;
+
+        switch(c)
+        {
+            case 'q':
+                *quiet = 1;
+                break;
+            case 'r':
+                *require_checksums = 1;
+                break;
+            case '?':
+            default:
+                usage(argv[0]);
+                break;
+        }
+    }
+
+    *infile_list = &argv[optind];
+    *n_files = argc - optind;
+
+    return;
+}
+
+/* verify one log, printing its outcome
+ *
+ * returns 0 if the log is intact, 1 otherwise
+ */
+int verify_log(char *path, int quiet, int require_checksums)
+{
+    struct darshan_log_damage damage;
+    int ret;
+    int i;
+
+    ret = darshan_log_verify(path, &damage);
+    if(ret < 0)
+    {
+        printf("%s: unreadable\n", path);
+        return(1);
+    }
+
+    if(ret == 0)
+    {
+        if(damage.checksum_type == DARSHAN_NO_CHECKSUM)
+        {
+            if(require_checksums)
+            {
+                printf("%s: DAMAGED (no checksums)\n", path);
+                return(1);
+            }
+            if(!quiet)
+                printf("%s: OK (no checksums)\n", path);
+        }
+        else if(!quiet)
+            printf("%s: OK\n", path);
+        return(0);
+    }
+
+    printf("%s: DAMAGED", path);
+    if(damage.header_status != DARSHAN_REGION_INTACT)
+        printf(" header=%s", region_status_str[damage.header_status]);
+    if(damage.job_status != DARSHAN_REGION_INTACT)
+        printf(" job=%s", region_status_str[damage.job_status]);
+    if(damage.name_status != DARSHAN_REGION_INTACT)
+        printf(" names=%s", region_status_str[damage.name_status]);
+    for(i = 0; i < DARSHAN_MAX_MODS; i++)
+    {
+        if(damage.mod_status[i] == DARSHAN_REGION_INTACT)
+            continue;
+        if(i < DARSHAN_KNOWN_MODULE_COUNT)
+            printf(" %s=%s", darshan_module_names[i],
+                region_status_str[damage.mod_status[i]]);
+        else
+            printf(" module-%d=%s", i, region_status_str[damage.mod_status[i]]);
+    }
+    printf("\n");
+
+    return(1);
+}
+
+int main(int argc, char *argv[])
+{
+    char **infile_list;
+    int n_infiles;
+    int quiet;
+    int require_checksums;
+    char line[4096];
+    size_t len;
+    int damaged = 0;
+    int i;
+
+    /* grab command line arguments */
+    parse_args(argc, argv, &infile_list, &n_infiles, &quiet, &require_checksums);
+
+    if(n_infiles > 0)
+    {
+        for(i = 0; i < n_infiles; i++)
+            damaged |= verify_log(infile_list[i], quiet, require_checksums);
+    }
+    else
+    {
+        /* read log paths from stdin, e.g. the output of find */
+        while(fgets(line, sizeof(line), stdin))
+        {
+            len = strlen(line);
+            while(len > 0 && (line[len-1] == '\n' || line[len-1] == '\r'))
+                line[--len] = '\0';
+            if(len == 0)
+                continue;
+            damaged |= verify_log(line, quiet, require_checksums);
+        }
+    }
+
+    return(damaged ? VERIFY_DAMAGE_FOUND : 0);
+}
+
+/*
+ * Local variables:
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=8 sts=4 sw=4 expandtab
+ */
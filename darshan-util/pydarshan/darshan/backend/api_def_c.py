@@ -91,22 +91,22 @@ struct darshan_name_record
 struct darshan_posix_file
 {
     struct darshan_base_record base_rec;
-    int64_t counters[69];
-    double fcounters[17];
+    int64_t counters[117];
+    double fcounters[23];
 };
 
 struct darshan_stdio_file
 {
     struct darshan_base_record base_rec;
-    int64_t counters[14];
+    int64_t counters[19];
     double fcounters[15];
 };
 
 struct darshan_mpiio_file
 {
     struct darshan_base_record base_rec;
-    int64_t counters[51];
-    double fcounters[17];
+    int64_t counters[53];
+    double fcounters[21];
 };
 
 struct darshan_hdf5_file
@@ -120,14 +120,14 @@ struct darshan_hdf5_dataset
 {
     struct darshan_base_record base_rec;
     uint64_t file_rec_id;
-    int64_t counters[94];
+    int64_t counters[101];
     double fcounters[17];
 };
 
 struct darshan_pnetcdf_file
 {
     struct darshan_base_record base_rec;
-    int64_t counters[9];
+    int64_t counters[12];
     double fcounters[8];
 };
 
@@ -135,8 +135,8 @@ struct darshan_pnetcdf_var
 {
     struct darshan_base_record base_rec;
     uint64_t file_rec_id;
-    int64_t counters[120];
-    double fcounters[17];
+    int64_t counters[123];
+    double fcounters[19];
 };
 
 struct darshan_bgq_record
@@ -161,6 +161,27 @@ struct darshan_lustre_record
     int64_t *ost_ids;
 };
 
+struct darshan_procio_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[11];
+    double fcounters[3];
+};
+
+struct darshan_nfs_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[42];
+    double fcounters[42];
+};
+
+struct darshan_custom_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[6];
+    double fcounters[4];
+};
+
 struct darshan_heatmap_record
 {
     struct darshan_base_record base_rec;
@@ -170,6 +191,24 @@ struct darshan_heatmap_record
     int64_t *read_bins;        /* pointer to read bin array (trails write bin array in log */
 };
 
+struct darshan_snapshot_record
+{
+    struct darshan_base_record base_rec;
+    double  interval_seconds; /* time duration of each snapshot interval */
+    int64_t counter_mask;     /* bit i is set if counter i is captured */
+    int64_t nsnapshots;       /* number of snapshots */
+    int64_t dropped;          /* number of earlier snapshots lost when the ring wrapped */
+    double  *times;           /* pointer to interval start time array (trails struct in log) */
+    int64_t *deltas;          /* pointer to nsnapshots x captured counters delta array */
+};
+
+struct darshan_imbalance_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[44];
+    double fcounters[6];
+};
+
 
 struct dxt_file_record {
     struct darshan_base_record base_rec;
@@ -203,6 +242,15 @@ extern char *pnetcdf_var_counter_names[];
 extern char *pnetcdf_var_f_counter_names[];
 extern char *posix_counter_names[];
 extern char *posix_f_counter_names[];
+extern char *procio_counter_names[];
+extern char *procio_f_counter_names[];
+extern char *nfs_counter_names[];
+extern char *nfs_f_counter_names[];
+extern char *custom_counter_names[];
+extern char *custom_f_counter_names[];
+extern char *snapshot_counter_names[];
+extern char *imbalance_counter_names[];
+extern char *imbalance_f_counter_names[];
 extern char *stdio_counter_names[];
 extern char *stdio_f_counter_names[];
 
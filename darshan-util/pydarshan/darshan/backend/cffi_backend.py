@@ -70,6 +70,11 @@ _mod_names = [
     "APXC",
     "APMPI",
     "HEATMAP",
+    "PROCIO",
+    "NFS",
+    "CUSTOM",
+    "SNAPSHOT",
+    "IMBALANCE",
 ]
 def mod_name_to_idx(mod_name):
     return _mod_names.index(mod_name)
@@ -86,6 +91,11 @@ _structdefs = {
     "PNETCDF_FILE": "struct darshan_pnetcdf_file **",
     "PNETCDF_VAR": "struct darshan_pnetcdf_var **",
     "POSIX": "struct darshan_posix_file **",
+    "PROCIO": "struct darshan_procio_record **",
+    "NFS": "struct darshan_nfs_record **",
+    "CUSTOM": "struct darshan_custom_record **",
+    "SNAPSHOT": "struct darshan_snapshot_record **",
+    "IMBALANCE": "struct darshan_imbalance_record **",
     "STDIO": "struct darshan_stdio_file **",
     "APXC-HEADER": "struct darshan_apxc_header_record **",
     "APXC-PERF": "struct darshan_apxc_perf_record **",
@@ -336,6 +346,8 @@ def log_get_record(log, mod, dtype='numpy'):
         rec = _log_get_lustre_record(log, dtype=dtype)
     elif mod in ['HEATMAP']:
         rec = _log_get_heatmap_record(log)
+    elif mod in ['SNAPSHOT']:
+        rec = _log_get_snapshot_record(log)
     elif mod in ['DXT_POSIX', 'DXT_MPIIO']:
         rec = log_get_dxt_record(log, mod, dtype=dtype)
     else:
@@ -646,6 +658,63 @@ def log_get_dxt_record(log, mod_name, reads=True, writes=True, dtype='dict'):
     return rec
 
 
+# numpy layout of ``struct segment_info``
+dxt_segment_dtype = np.dtype([("offset", np.int64), ("length", np.int64),
+                              ("start_time", np.float64),
+                              ("end_time", np.float64)])
+
+
+def log_get_dxt_segments(log, mod_name):
+    """
+    Returns the next dxt darshan log record of a module with its
+    segments as numpy arrays, without creating a Python object per
+    segment as ``log_get_dxt_record()`` does.
+
+    Args:
+        log: Handle returned by darshan.open
+        mod_name (str): Name of the DXT module
+
+    Return:
+        dict: record with 'id', 'rank', 'hostname', and 'write_segments'
+        and 'read_segments' structured arrays of ``dxt_segment_dtype``,
+        or None when all records of the module have been read.
+
+    """
+
+    modules = log_get_modules(log)
+    if mod_name not in modules:
+        return None
+    mod_type = _structdefs[mod_name]
+
+    buf = ffi.new("void **")
+    r = libdutil.darshan_log_get_record(log['handle'], modules[mod_name]['idx'], buf)
+    if r < 1:
+        return None
+    filerec = ffi.cast(mod_type, buf)
+
+    rec = {}
+    rec['id'] = filerec[0].base_rec.id
+    rec['rank'] = filerec[0].base_rec.rank
+    rec['hostname'] = ffi.string(filerec[0].hostname).decode("utf-8")
+
+    wcnt = filerec[0].write_count
+    rcnt = filerec[0].read_count
+    seg_size = ffi.sizeof("struct segment_info")
+    assert seg_size == dxt_segment_dtype.itemsize
+
+    # the segments follow the record, writes first; copy them out
+    # before the record buffer is released
+    size_of = ffi.sizeof("struct dxt_file_record")
+    segbuf = ffi.buffer(ffi.cast("char *", buf[0]) + size_of,
+                        (wcnt + rcnt) * seg_size)
+    segments = np.frombuffer(segbuf, dtype=dxt_segment_dtype).copy()
+    rec['write_segments'] = segments[:wcnt]
+    rec['read_segments'] = segments[wcnt:]
+
+    libdutil.darshan_free(buf[0])
+    return rec
+
+
 def _log_get_heatmap_record(log):
     """
     Returns a dictionary holding a heatmap darshan log record.
@@ -695,6 +764,57 @@ def _log_get_heatmap_record(log):
     return rec
 
 
+def _log_get_snapshot_record(log):
+    """
+    Returns a dictionary holding a counter snapshot darshan log record.
+
+    Args:
+        log: Handle returned by darshan.open
+
+    Return:
+        dict: snapshot log record, with the names of the captured
+        ``counters``, the interval start ``times`` and the counter
+        ``deltas`` (one row per snapshot, one column per captured counter)
+    """
+
+    mod_name = "SNAPSHOT"
+
+    modules = log_get_modules(log)
+    if mod_name not in modules:
+        return None
+
+    mod_type = _structdefs[mod_name]
+
+    rec = {}
+    buf = ffi.new("void **")
+    r = libdutil.darshan_log_get_record(log['handle'], modules[mod_name]['idx'], buf)
+    if r < 1:
+        return None
+
+    filerec = ffi.cast(mod_type, buf)
+
+    rec['id'] = filerec[0].base_rec.id
+    rec['rank'] = filerec[0].base_rec.rank
+    rec['interval_seconds'] = filerec[0].interval_seconds
+    rec['dropped'] = filerec[0].dropped
+
+    names = counter_names(mod_name)
+    counter_mask = filerec[0].counter_mask
+    rec['counters'] = [name for i, name in enumerate(names) if counter_mask & (1 << i)]
+
+    nsnapshots = filerec[0].nsnapshots
+    ncounters = len(rec['counters'])
+    rec['times'] = np.copy(np.frombuffer(
+        ffi.buffer(filerec[0].times, ffi.sizeof("double") * nsnapshots),
+        dtype=np.float64))
+    rec['deltas'] = np.copy(np.frombuffer(
+        ffi.buffer(filerec[0].deltas, ffi.sizeof("int64_t") * nsnapshots * ncounters),
+        dtype=np.int64)).reshape(nsnapshots, ncounters)
+    libdutil.darshan_free(buf[0])
+
+    return rec
+
+
 def _df_to_rec(rec_dict, mod_name, rec_index_of_interest=None):
     """
     Pack the DataFrames-format PyDarshan data back into
@@ -0,0 +1,48 @@
+"""The `proctree` subcommand links the logs of forked and spawned
+non-MPI processes into process trees and totals each subtree.
+"""
+import sys
+import argparse
+
+from darshan.cli.rollup import find_logs
+from darshan.lib.proctree import read_process_info, process_tree, format_tree
+
+
+def setup_parser(parser=None):
+    parser.description = "Reconstruct the process trees of non-MPI workflows"
+
+    parser.add_argument('paths', nargs='+',
+                        help='darshan logs, or directories searched for them')
+    parser.add_argument('-j', '--jobs', type=int, default=1,
+                        help='number of logs read in parallel')
+    parser.add_argument('--csv', action='store_true',
+                        help='print one comma separated row per process')
+    parser.add_argument('--debug', help='', action='store_true')
+
+
+def main(args=None):
+
+    if args is None:
+        parser = argparse.ArgumentParser(description='')
+        setup_parser(parser)
+        args = parser.parse_args()
+
+    if args.debug:
+        print(args)
+
+    infos, errors = read_process_info(find_logs(args.paths), jobs=args.jobs)
+    for path, error in errors:
+        print(f"Error: failed to read {path}: {error}", file=sys.stderr)
+
+    tree = process_tree(infos)
+    if args.csv:
+        tree.to_csv(sys.stdout, index_label="index")
+    elif not tree.empty:
+        print(format_tree(tree))
+
+    if errors:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+"""The `rollup` subcommand folds Darshan logs into an incremental on-disk
+rollup keyed by executable, user and time window, and queries it.
+"""
+import os
+import sys
+import argparse
+
+import pandas as pd
+
+from darshan.lib.rollup import RollupStore
+
+
+def find_logs(paths):
+    """
+    Expand the given paths into Darshan logs, walking directories for
+    files ending in ``.darshan``.
+    """
+    for path in paths:
+        if not os.path.isdir(path):
+            yield path
+            continue
+        for dirpath, dirnames, filenames in os.walk(path):
+            dirnames.sort()
+            for filename in sorted(filenames):
+                if filename.endswith(".darshan"):
+                    yield os.path.join(dirpath, filename)
+
+
+def setup_parser(parser=None):
+    parser.description = "Maintain and query a rollup of many Darshan logs"
+
+    parser.add_argument('store', help='rollup database, created if it does not exist')
+    parser.add_argument('--debug', help='', action='store_true')
+
+    actions = parser.add_subparsers(dest='rollup_action', metavar='action')
+    actions.required = True
+
+    ingest = actions.add_parser('ingest', help='add new logs to the rollup')
+    ingest.add_argument('paths', nargs='+',
+                        help='darshan logs, or directories searched for them')
+    ingest.add_argument('-j', '--jobs', type=int, default=1,
+                        help='number of logs read in parallel')
+    ingest.add_argument('--window', type=int, default=86400,
+                        help='time window in seconds, when creating the rollup')
+
+    def add_query(name, help, by):
+        query = actions.add_parser(name, help=help)
+        query.add_argument('--by', default=by,
+                           help='comma separated grouping of exe, uid and window')
+        query.add_argument('--exe', help='only this executable')
+        query.add_argument('--uid', type=int, help='only this user id')
+        query.add_argument('--since', type=int,
+                           help='only windows starting at or after this time (seconds since epoch)')
+        query.add_argument('--until', type=int,
+                           help='only windows starting before this time (seconds since epoch)')
+        query.add_argument('--csv', action='store_true',
+                           help='print comma separated values')
+        return query
+
+    add_query('jobs', 'job totals', 'exe,uid,window')
+    counters = add_query('counters', 'summed module counters', 'exe')
+    counters.add_argument('module', help='module name, e.g. POSIX')
+    counters.add_argument('counters', nargs='*', help='counter names (default: all)')
+    histogram = add_query('histogram', 'power of 2 histogram of a job metric', 'exe')
+    histogram.add_argument('metric', choices=['nprocs', 'run_time', 'io_bytes'])
+    add_query('filesystems', 'per file system totals', 'exe')
+
+
+def main(args=None):
+
+    if args is None:
+        parser = argparse.ArgumentParser(description='')
+        setup_parser(parser)
+        args = parser.parse_args()
+
+    if args.debug:
+        print(args)
+
+    if args.rollup_action == 'ingest':
+        with RollupStore(args.store, window=args.window) as store:
+            result = store.ingest(find_logs(args.paths), jobs=args.jobs)
+            for path, error in result["errors"]:
+                print(f"Error: failed to read {path}: {error}", file=sys.stderr)
+            print(f"added {result['added']}, skipped {result['skipped']}, "
+                  f"failed {len(result['errors'])}; rollup holds {len(store)} logs")
+        if result["errors"]:
+            sys.exit(1)
+        return
+
+    if not os.path.exists(args.store):
+        sys.exit(f"Error: rollup {args.store} does not exist")
+
+    by = [field for field in args.by.split(",") if field]
+    query = {"by": by, "exe": args.exe, "uid": args.uid,
+             "since": args.since, "until": args.until}
+    with RollupStore(args.store) as store:
+        if args.rollup_action == 'jobs':
+            df = store.jobs(**query)
+        elif args.rollup_action == 'counters':
+            df = store.counters(args.module, args.counters, **query)
+        elif args.rollup_action == 'histogram':
+            df = store.histogram(args.metric, **query)
+        else:
+            df = store.filesystems(**query)
+
+    if args.csv:
+        df.to_csv(sys.stdout, index=False)
+    else:
+        with pd.option_context("display.max_rows", None,
+                               "display.max_columns", None,
+                               "display.width", None):
+            print(df.to_string(index=False))
+
+
+if __name__ == "__main__":
+    main()
@@ -2,12 +2,16 @@ import sys
 import os
 import io
 import base64
+import hashlib
 import argparse
 import datetime
+import tempfile
+import multiprocessing
+import concurrent.futures
 from collections import OrderedDict
 import importlib.resources as importlib_resources
 
-from typing import Any, Union, Callable
+from typing import Any, Union, Callable, List
 
 import pandas as pd
 from mako.template import Template
@@ -15,7 +19,12 @@ from mako.template import Template
 import darshan
 import darshan.cli
 from darshan.backend.cffi_backend import accumulate_records
+from darshan.log_utils import get_log_digest
 from darshan.lib.accum import log_file_count_summary_table, log_module_overview_table
+from darshan.lib.procio import log_procio_summary_table
+from darshan.lib.custom import custom_counters_df, log_custom_counters_table
+from darshan.lib.imbalance import imbalance_df, log_imbalance_table
+from darshan.lib.stdio_buffering import log_stdio_buffering_table
 from darshan.experimental.plots import (
     plot_dxt_heatmap,
     plot_io_cost,
@@ -29,6 +38,60 @@ from darshan.experimental.plots import (
 darshan.enable_experimental()
 
 
+# figures handed to worker processes by `ReportData.render_figures`; the
+# workers are forked, so they inherit these rather than having them pickled
+_figures_to_render: List["ReportFigure"] = []
+
+
+def _render_figure(index: int) -> str:
+    """
+    Generate one of `_figures_to_render` in a worker process.
+
+    Parameters
+    ----------
+    index : the index of the figure in `_figures_to_render`.
+
+    Returns
+    -------
+    The HTML for the figure.
+
+    """
+    fig = _figures_to_render[index]
+    fig.generate_fig()
+    return fig.fig_html
+
+
+def _normalize_fig_arg(arg: Any) -> str:
+    """
+    Produce a stable string representation of a figure function argument
+    for use in a figure cache key.
+
+    Parameters
+    ----------
+    arg : a figure function argument.
+
+    Returns
+    -------
+    A string that is the same for equal arguments across runs. Objects
+    derived from the log (reports, accumulated metrics) that have no
+    stable representation are reduced to their type name, as their
+    content is already covered by the log hash.
+
+    """
+    if arg is None or isinstance(arg, (str, int, float, bool)):
+        return repr(arg)
+    if isinstance(arg, dict):
+        items = sorted((str(k), _normalize_fig_arg(v)) for k, v in arg.items())
+        return "{" + ", ".join(f"{k}: {v}" for k, v in items) + "}"
+    if isinstance(arg, (list, tuple)):
+        return "[" + ", ".join(_normalize_fig_arg(v) for v in arg) + "]"
+    if isinstance(arg, (pd.DataFrame, pd.Series)):
+        digest = hashlib.sha256(
+            pd.util.hash_pandas_object(arg, index=True).values.tobytes())
+        return f"{type(arg).__name__}:{digest.hexdigest()}"
+    return type(arg).__name__
+
+
 class ReportFigure:
     """
     Stores info for each figure in `ReportData.register_figures`.
@@ -49,6 +112,9 @@ class ReportFigure:
 
     fig_grid_area : figure name corresponding to grid-area definitions specified in the CSS.
 
+    defer : if ``True``, the figure is not generated on creation; it is
+    left for `ReportData.render_figures` to generate instead.
+
     """
     def __init__(
         self,
@@ -64,6 +130,7 @@ class ReportFigure:
         # we have the option of changing the caption
         # text color for a warning/important standalone text
         text_only_color: str = "red",
+        defer: bool = False,
     ):
         self.section_title = section_title
         if not fig_title:
@@ -87,7 +154,7 @@ class ReportFigure:
         # text, which doesn't really have an image...
         self.fig_html = None
         self.text_only_color = text_only_color
-        if self.fig_func:
+        if self.fig_func and not defer:
             self.generate_fig()
 
     @staticmethod
@@ -109,6 +176,33 @@ class ReportFigure:
         encoded_fig = base64.b64encode(tmpfile.getvalue()).decode("utf-8")
         return encoded_fig
 
+    def cache_key(self, log_digest: str) -> str:
+        """
+        Compute the key for this figure in the figure cache.
+
+        Parameters
+        ----------
+        log_digest : digest of the log the figure is generated from
+        (see `get_log_digest`).
+
+        Returns
+        -------
+        A hex digest covering the log, the pydarshan version, and
+        everything that determines the figure's HTML.
+
+        """
+        func = self.fig_func
+        parts = [
+            log_digest,
+            darshan.__version__,
+            self.section_title,
+            self.fig_title,
+            str(self.fig_width),
+            f"{getattr(func, '__module__', '')}.{getattr(func, '__qualname__', repr(func))}",
+            _normalize_fig_arg(self.fig_args),
+        ]
+        return hashlib.sha256("\0".join(parts).encode("utf-8")).hexdigest()
+
     def generate_fig(self):
         """
         Generate a figure using the figure data.
@@ -137,12 +231,20 @@ class ReportData:
     ----------
     log_path: path to a darshan log file.
     enable_dxt_heatmap: flag indicating whether DXT heatmaps should be enabled
+    jobs: number of worker processes used to render figures; ``0`` uses
+    one per available CPU.
+    cache_dir: directory in which rendered figures are cached across runs,
+    keyed on the log contents and the figure parameters; ``None`` disables
+    the cache.
 
     """
-    def __init__(self, log_path: str, enable_dxt_heatmap: bool = False):
+    def __init__(self, log_path: str, enable_dxt_heatmap: bool = False,
+                 jobs: int = 1, cache_dir: Union[str, None] = None):
         # store the log path and use it to generate the report
         self.log_path = log_path
         self.enable_dxt_heatmap = enable_dxt_heatmap
+        self.jobs = jobs if jobs > 0 else (os.cpu_count() or 1)
+        self.cache_dir = cache_dir
         # store the report
         self.report = darshan.DarshanReport(log_path, read_all=False)
         # read only generic module data and heatmap data by default
@@ -158,8 +260,9 @@ class ReportData:
         # create the metadata and module tables
         self.get_metadata_table()
         self.get_module_table()
-        # register the report figures
+        # register the report figures and generate them
         self.register_figures()
+        self.render_figures()
         # use the figure data to build the report sections
         self.build_sections()
         # collect the CSS stylesheet
@@ -340,7 +443,7 @@ class ReportData:
                 "fig_width": 500,
             }
             # feed the dictionary into ReportFigure (step #3)
-            example_fig = ReportFigure(**fig_params)
+            example_fig = ReportFigure(**fig_params, defer=True)
             # add the ReportFigure to ReportData.figures (step #4)
             self.figures.append(example_fig)
 
@@ -399,6 +502,7 @@ class ReportData:
                                 fig_func=plot_dxt_heatmap.plot_heatmap,
                                 fig_args=dict(report=self.report, mod=mod, submodule=possible_submodule),
                                 fig_description=hmap_description,
+                                defer=True
                             )
                             hmap_grid[f"HEATMAP_{possible_submodule}"] = heatmap_fig
                     else:
@@ -409,6 +513,7 @@ class ReportData:
                                 fig_func=plot_dxt_heatmap.plot_heatmap,
                                 fig_args=dict(report=self.report, mod=mod),
                                 fig_description=hmap_description,
+                                defer=True
                             )
                             hmap_grid[mod] = heatmap_fig
                         else:
@@ -475,8 +580,13 @@ class ReportData:
             "fig_description": io_cost_description,
             "fig_width": 350,
         }
-        io_cost_fig = ReportFigure(**io_cost_params)
-        self.figures.append(io_cost_fig)
+        # the I/O cost graph has nothing to show for logs that only hold
+        # job-level or application-defined data (e.g., PROCIO, CUSTOM)
+        io_cost_mods = ["POSIX", "MPI-IO", "STDIO", "H5F", "H5D",
+                        "PNETCDF_FILE", "PNETCDF_VAR"]
+        if any(mod in self.report.modules for mod in io_cost_mods):
+            io_cost_fig = ReportFigure(**io_cost_params, defer=True)
+            self.figures.append(io_cost_fig)
 
         ################################
         ## Per-Module Statistics
@@ -521,7 +631,8 @@ class ReportData:
                                           mod_name=mod),
                             fig_width=805,
                             fig_description="",
-                            fig_grid_area="overview")
+                            fig_grid_area="overview",
+                            defer=True)
                     self.figures.append(mod_overview_fig)
 
                     file_count_summary_fig = ReportFigure(
@@ -532,7 +643,8 @@ class ReportData:
                                           mod_name=mod),
                             fig_width=805,
                             fig_description="",
-                            fig_grid_area="file_tbl")
+                            fig_grid_area="file_tbl",
+                            defer=True)
                     self.figures.append(file_count_summary_fig)
 
                     if mod == "POSIX":
@@ -545,10 +657,31 @@ class ReportData:
                                             "consecutive (offset immediately following previous offset) "
                                             "file operations. Note that, by definition, the sequential "
                                             "operations are inclusive of consecutive operations.",
-                            fig_width=350
+                            fig_width=350,
+                            defer=True
                         )
                         self.figures.append(access_pattern_fig)
 
+                    if mod == "STDIO":
+                        stdio_buffering_description = (
+                            "How effectively stream buffering coalesced stdio "
+                            "operations into read/write system calls, summed "
+                            "across all STDIO records. The system call count is "
+                            "estimated from the stream buffer state and is a "
+                            "lower bound; it is unavailable (N/A) in logs from "
+                            "older Darshan versions."
+                        )
+                        stdio_buffering_fig = ReportFigure(
+                            section_title=sect_title,
+                            fig_title="Buffering",
+                            fig_func=log_stdio_buffering_table,
+                            fig_args=dict(counters=acc.summary_record["counters"].iloc[0].to_dict()),
+                            fig_description=stdio_buffering_description,
+                            fig_width=500,
+                            defer=True
+                        )
+                        self.figures.append(stdio_buffering_fig)
+
             except (RuntimeError, KeyError):
                 # the module probably doesn't support derived metrics
                 # calculations, but the C code doesn't distinguish other
@@ -560,6 +693,67 @@ class ReportData:
                 # repo
                 pass
 
+            if mod == "PROCIO" and len(self.report.records[mod]) > 0:
+                procio_description = (
+                    "Job-wide page cache effectiveness, from the kernel's "
+                    "per-process I/O accounting summed across all processes. "
+                    "The read cache hit ratio is the fraction of bytes "
+                    "requested by read system calls that did not need to be "
+                    "fetched from storage. Note that these values include all "
+                    "I/O performed by the processes, not just instrumented files."
+                )
+                procio_fig = ReportFigure(
+                    section_title=sect_title,
+                    fig_title="Page Cache",
+                    fig_func=log_procio_summary_table,
+                    fig_args=dict(record=self.report.records[mod].to_dict()[0]),
+                    fig_description=procio_description,
+                    fig_width=500,
+                    defer=True
+                )
+                self.figures.append(procio_fig)
+
+            if mod == "CUSTOM" and len(self.report.records[mod]) > 0:
+                custom_description = (
+                    "Counters defined and updated by the application through "
+                    "the Darshan CUSTOM module interface. Values are summed "
+                    "across all ranks that registered the counter; the "
+                    "per-rank range shows the smallest and largest value "
+                    "accumulated by a single rank."
+                )
+                custom_fig = ReportFigure(
+                    section_title=sect_title,
+                    fig_title="Application Counters",
+                    fig_func=log_custom_counters_table,
+                    fig_args=dict(counters_df=custom_counters_df(self.report)),
+                    fig_description=custom_description,
+                    fig_width=805,
+                    defer=True
+                )
+                self.figures.append(custom_fig)
+
+            if mod == "IMBALANCE" and len(self.report.records[mod]) > 0:
+                imbalance_description = (
+                    "How the I/O time of files shared by all processes was "
+                    "spread across nodes (or ranks), for the files with the "
+                    "largest I/O time. The time of a node is that of its "
+                    "slowest process, and a node is identified by its lowest "
+                    "rank. Max/Mean is the ratio of the slowest to the mean "
+                    "time (1.00 when perfectly balanced), and Shape tells a "
+                    "few stragglers apart from a bimodal split or a long "
+                    "tail of slow nodes."
+                )
+                imbalance_fig = ReportFigure(
+                    section_title=sect_title,
+                    fig_title="Shared File Imbalance",
+                    fig_func=log_imbalance_table,
+                    fig_args=dict(imbalance=imbalance_df(self.report)),
+                    fig_description=imbalance_description,
+                    fig_width=805,
+                    defer=True
+                )
+                self.figures.append(imbalance_fig)
+
             if mod in ["POSIX", "MPI-IO", "H5D", "PNETCDF_VAR"]:
                 access_hist_description = (
                     "Histogram of read and write access sizes. The specific values "
@@ -573,7 +767,8 @@ class ReportData:
                     fig_args=dict(report=self.report, mod=mod),
                     fig_description=access_hist_description,
                     fig_width=350,
-                    fig_grid_area="acc_hist"
+                    fig_grid_area="acc_hist",
+                    defer=True
                 )
                 self.figures.append(access_hist_fig)
                 if mod == "MPI-IO":
@@ -590,7 +785,8 @@ class ReportData:
                     fig_args=dict(report=self.report, mod=mod),
                     fig_description=com_acc_tbl_description,
                     fig_width=350,
-                    fig_grid_area="common_acc_tbl"
+                    fig_grid_area="common_acc_tbl",
+                    defer=True
                 )
                 self.figures.append(com_acc_tbl_fig)
 
@@ -603,7 +799,8 @@ class ReportData:
                     fig_args=dict(report=self.report, mod=mod),
                     fig_description="Histogram of I/O operation frequency.",
                     fig_width=350,
-                    fig_grid_area="op_counts"
+                    fig_grid_area="op_counts",
+                    defer=True
                 )
                 self.figures.append(opcount_fig)
 
@@ -621,11 +818,70 @@ class ReportData:
                                 "target (e.g., file system "
                                 "mount point) and sorted by volume.",
                 fig_width=500,
+                defer=True
             )
             self.figures.append(data_access_by_cat_fig)
 
 
 
+    def render_figures(self):
+        """
+        Generates the registered figures that have not been generated
+        yet. Figures found in the cache are reused, and the rest are
+        rendered concurrently in forked worker processes when more than
+        one job was requested.
+        """
+        pending = [fig for fig in self.figures
+                   if fig.fig_func and fig.fig_html is None]
+        if not pending:
+            return
+
+        keys = {}
+        if self.cache_dir:
+            os.makedirs(self.cache_dir, exist_ok=True)
+            log_digest = get_log_digest(self.log_path)
+            to_render = []
+            for fig in pending:
+                key = fig.cache_key(log_digest)
+                cache_path = os.path.join(self.cache_dir, f"{key}.html")
+                if os.path.exists(cache_path):
+                    with open(cache_path, "r") as f:
+                        fig.fig_html = f.read()
+                else:
+                    keys[id(fig)] = cache_path
+                    to_render.append(fig)
+        else:
+            to_render = pending
+
+        global _figures_to_render
+        if (self.jobs > 1 and len(to_render) > 1 and
+                "fork" in multiprocessing.get_all_start_methods()):
+            _figures_to_render = to_render
+            try:
+                with concurrent.futures.ProcessPoolExecutor(
+                        max_workers=min(self.jobs, len(to_render)),
+                        mp_context=multiprocessing.get_context("fork")) as executor:
+                    results = list(executor.map(_render_figure,
+                                                range(len(to_render))))
+            finally:
+                _figures_to_render = []
+            for fig, fig_html in zip(to_render, results):
+                fig.fig_html = fig_html
+        else:
+            for fig in to_render:
+                fig.generate_fig()
+
+        # write through a temporary file so that concurrent report
+        # generators sharing the cache never see partial entries
+        for fig in to_render:
+            cache_path = keys.get(id(fig))
+            if cache_path is None:
+                continue
+            fd, tmp_path = tempfile.mkstemp(dir=self.cache_dir, suffix=".tmp")
+            with os.fdopen(fd, "w") as f:
+                f.write(fig.fig_html)
+            os.replace(tmp_path, cache_path)
+
     def build_sections(self):
         """
         Uses figure info to generate the unique sections
@@ -669,6 +925,20 @@ def setup_parser(parser: argparse.ArgumentParser):
         action="store_true",
         help="Enable DXT-based versions of I/O activity heatmaps."
     )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        default=1,
+        help="Number of worker processes used to render figures "
+             "(0 uses all available CPUs)."
+    )
+    parser.add_argument(
+        "--cache-dir",
+        type=str,
+        default=None,
+        help="Cache rendered figures in this directory and reuse them "
+             "for unchanged logs."
+    )
 
 
 def main(args: Union[Any, None] = None):
@@ -687,6 +957,9 @@ def main(args: Union[Any, None] = None):
 
     log_path = args.log_path
     enable_dxt_heatmap = args.enable_dxt_heatmap
+    # tolerate argument namespaces built before these options existed
+    jobs = getattr(args, "jobs", 1)
+    cache_dir = getattr(args, "cache_dir", None)
 
     if args.output is None:
         # if no output is provided, use the log file
@@ -699,7 +972,9 @@ def main(args: Union[Any, None] = None):
     # collect the report data to feed into the template
     report_data = ReportData(
         log_path=log_path,
-        enable_dxt_heatmap=enable_dxt_heatmap
+        enable_dxt_heatmap=enable_dxt_heatmap,
+        jobs=jobs,
+        cache_dir=cache_dir,
     )
 
     with importlib_resources.path(darshan.cli, "base.html") as base_path:
@@ -0,0 +1,65 @@
+from darshan.report import *
+
+from darshan.lib.timeline import MAX_INTERVALS, dxt_timeline
+
+def create_dxttimeline_streaming(self, width=1000, resolution=None,
+                                 max_items=MAX_INTERVALS, mode="append"):
+    """
+    Generate/update a bounded size timeline from the dxt tracing records
+    of the current report's log.
+
+    Unlike create_dxttimeline(), the segments are streamed from the log
+    in chunks and adjacent segments of a rank and file are merged into
+    one item, so memory use does not grow with the length of the trace.
+
+    Args:
+        width (int): Number of pixels spanning the job runtime, which sets
+                     the time resolution of the items (default: 1000)
+        resolution (float): Resolution in seconds, overriding width
+        max_items (int): Number of items above which the resolution
+                         is coarsened
+    """
+
+    df = dxt_timeline(self, width=width, resolution=resolution,
+                      max_intervals=max_items)
+
+    ctx = {'groups': [], 'items': [], 'resolution': df.attrs['resolution']}
+
+    start_time = datetime.datetime.fromtimestamp( self.data['metadata']['job']['start_time_sec'] )
+
+    names = self.name_table.paths(df['id'])
+    rids = ["%s:%d:%d" % (mod, rec_id, rank) for mod, rec_id, rank in
+            zip(df['module'], df['id'], df['rank'])]
+
+    # one group per record, ordered by its first interval
+    first = df.assign(rid=rids, name=names).groupby('rid', sort=False).first()
+    for rid, row in first.iterrows():
+        name = row['name'] if isinstance(row['name'], str) else str(row['id'])
+        ctx['groups'].append({
+            "id": rid,
+            "content": "[%s] " % (row['module']) + name[-84:],
+            "order": row['start'],
+        })
+
+    for i, (rid, op, start, end, count, nbytes) in enumerate(zip(
+            rids, df['operation'], df['start'], df['end'], df['count'], df['bytes'])):
+        ctx['items'].append({
+            "id": "%s:%d" % (rid, i),
+            "group": rid,
+            "start": (start_time + datetime.timedelta(seconds=start)).isoformat(),
+            "end": (start_time + datetime.timedelta(seconds=end)).isoformat(),
+            "limitSize": False,  # required to prevent rendering glitches
+            "className": op,
+            "data": {
+                "duration": end - start,
+                "start": start,
+                "count": int(count),
+                "size": int(nbytes),
+            }
+        })
+
+    # overwrite existing summary entry
+    if mode == "append":
+        self.summary['timeline'] = ctx
+
+    return ctx
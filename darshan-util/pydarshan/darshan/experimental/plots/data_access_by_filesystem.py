@@ -10,6 +10,7 @@ from typing import List, Dict, Optional, Any, Callable, Sequence
 import numpy as np
 import pandas as pd
 import darshan
+from darshan.lib.names import NameTable, as_record_ids, path_root, path_roots
 import matplotlib
 matplotlib.use('Agg')
 import matplotlib.pyplot as plt
@@ -149,7 +150,8 @@ def empty_series_handler(series, filesystem_roots: Sequence[str]):
 
 def rec_to_rw_counter_dfs_with_cols(report: Any,
                                     file_id_dict: Dict[int, str],
-                                    mod: str = 'POSIX'):
+                                    mod: str = 'POSIX',
+                                    name_table: Optional[NameTable] = None):
     """
     Filter a DarshanReport into two "counters" dataframes,
     each with read/write activity in each row (at least 1
@@ -168,6 +170,10 @@ def rec_to_rw_counter_dfs_with_cols(report: Any,
     mod: a string indicating the darshan module to use for parsing
          (default: ``POSIX``)
 
+    name_table: an optional ``NameTable`` to resolve file hashes with
+                (e.g., ``report.name_table``); by default one is built
+                from ``file_id_dict``
+
 
     Returns
     -------
@@ -183,7 +189,8 @@ def rec_to_rw_counter_dfs_with_cols(report: Any,
     # paths for each event
     df_reads, df_writes = add_filesystem_cols(df_reads=df_reads,
                                               df_writes=df_writes,
-                                              file_id_dict=file_id_dict)
+                                              file_id_dict=file_id_dict,
+                                              name_table=name_table)
     return df_reads, df_writes
 
 def rec_to_rw_counter_dfs(report: Any,
@@ -205,22 +212,23 @@ def rec_to_rw_counter_dfs(report: Any,
     -------
     tuple of form: (df_reads, df_writes)
     """
-    rec_counters = pd.DataFrame()
-    df_reads = pd.DataFrame()
-    df_writes = pd.DataFrame()
-    if "POSIX" in report.modules:
-        rec_counters = pd.concat(objs=(rec_counters, report.records["POSIX"].to_df()['counters']))
-        df_reads = pd.concat(objs=(df_reads, rec_counters.loc[rec_counters[f'POSIX_BYTES_READ'] >= 1]))
-        df_writes = pd.concat(objs=(df_writes, rec_counters.loc[rec_counters[f'POSIX_BYTES_WRITTEN'] >= 1]))
-    if "STDIO" in report.modules:
-        rec_counters = pd.concat(objs=(rec_counters, report.records["STDIO"].to_df()['counters']))
-        df_reads = pd.concat(objs=(df_reads, rec_counters.loc[rec_counters[f'STDIO_BYTES_READ'] >= 1]))
-        df_writes = pd.concat(objs=(df_writes, rec_counters.loc[rec_counters[f'STDIO_BYTES_WRITTEN'] >= 1]))
-    
+    reads = []
+    writes = []
+    for mod_name in ["POSIX", "STDIO"]:
+        if mod_name in report.modules:
+            rec_counters = report.records[mod_name].to_df()['counters']
+            # keep the (unsigned) file hashes exact through the
+            # concatenation below
+            rec_counters["id"] = as_record_ids(rec_counters["id"])
+            reads.append(rec_counters.loc[rec_counters[f'{mod_name}_BYTES_READ'] >= 1])
+            writes.append(rec_counters.loc[rec_counters[f'{mod_name}_BYTES_WRITTEN'] >= 1])
+    df_reads = pd.concat(reads) if reads else pd.DataFrame()
+    df_writes = pd.concat(writes) if writes else pd.DataFrame()
     return df_reads, df_writes
 
 
-def add_filesystem_cols(df_reads, df_writes, file_id_dict: Dict[int, str]):
+def add_filesystem_cols(df_reads, df_writes, file_id_dict: Dict[int, str],
+                        name_table: Optional[NameTable] = None):
     """
     Adds two columns to the input dataframes, one with
     the filepaths for each event, and the other with the
@@ -241,20 +249,23 @@ def add_filesystem_cols(df_reads, df_writes, file_id_dict: Dict[int, str]):
                   to string values corresponding to their respective
                   paths
 
+    name_table: an optional ``NameTable`` to resolve file hashes with
+                (e.g., ``report.name_table``); by default one is built
+                from ``file_id_dict``
+
     Returns
     -------
     A tuple of form ``(df_reads, df_writes)`` with
-    the modified dataframes.
+    the modified dataframes; the new columns are categorical.
     """
-
-    file_hashes, file_paths = convert_id_dict_to_arrays(file_id_dict=file_id_dict)
-    # add column with filepaths for each event
-    df_reads = df_reads.assign(filepath=df_reads['id'].map(lambda a: convert_file_id_to_path(a, file_hashes, file_paths)))
-    df_writes = df_writes.assign(filepath=df_writes['id'].map(lambda a: convert_file_id_to_path(a, file_hashes, file_paths)))
-
-    # add column with filesystem root paths for each event
-    df_reads = df_reads.assign(filesystem_root=df_reads['filepath'].map(lambda path: convert_file_path_to_root_path(path)))
-    df_writes = df_writes.assign(filesystem_root=df_writes['filepath'].map(lambda path: convert_file_path_to_root_path(path)))
+    if name_table is None:
+        name_table = NameTable(file_id_dict)
+
+    # add columns with filepaths and filesystem root paths for each event
+    df_reads = df_reads.assign(filepath=name_table.paths(df_reads['id']),
+                               filesystem_root=name_table.roots(df_reads['id']))
+    df_writes = df_writes.assign(filepath=name_table.paths(df_writes['id']),
+                                 filesystem_root=name_table.roots(df_writes['id']))
     return df_reads, df_writes
 
 
@@ -277,19 +288,7 @@ def convert_file_path_to_root_path(file_path: str) -> str:
     '/scratch1'
 
     """
-    path_parts = pathlib.Path(file_path).parts
-    filesystem_root = ''.join(path_parts[:2])
-    if filesystem_root.isdigit():
-        # this is probably an anonymized STD..
-        # stream, so make that clear
-        filesystem_root = f'anonymized\n({filesystem_root})'
-    if filesystem_root.startswith("//"):
-        # Shane indicates that these are individual files
-        # mounted on root
-        # see:
-        # https://github.com/darshan-hpc/darshan/pull/397#discussion_r769186581
-        filesystem_root = "/"
-    return filesystem_root
+    return path_root(file_path)
 
 
 def convert_id_dict_to_arrays(file_id_dict: Dict[int, str]):
@@ -375,11 +374,7 @@ def identify_filesystems(file_id_dict: Dict[int, str], verbose: bool = False) ->
     >>> filesystem_roots = identify_filesystems(file_id_dict=file_id_dict, verbose=True)
     filesystem_roots: ['/yellow', '/tmp']
     """
-    filesystem_roots = []
-    for file_id_hash, file_path in file_id_dict.items():
-        filesystem_root = convert_file_path_to_root_path(file_path=file_path)
-        if filesystem_root not in filesystem_roots:
-            filesystem_roots.append(filesystem_root)
+    filesystem_roots = list(pd.unique(path_roots(list(file_id_dict.values()))))
     if verbose:
         print("filesystem_roots:", filesystem_roots)
     return filesystem_roots
@@ -389,7 +384,8 @@ def unique_fs_rw_counter(report: Any,
                          file_id_dict: Dict[int, str],
                          processing_func: Callable,
                          mod: str = 'POSIX',
-                         verbose: bool = False):
+                         verbose: bool = False,
+                         name_table: Optional[NameTable] = None):
     """
     For each filesystem root path, apply the custom
     analysis specified by ``processing_func``.
@@ -420,6 +416,10 @@ def unique_fs_rw_counter(report: Any,
     verbose: if ``True``, print the calculated values of ``read_groups``
     and ``write_groups``
 
+    name_table: an optional ``NameTable`` to resolve file hashes with
+                (e.g., ``report.name_table``); by default one is built
+                from ``file_id_dict``
+
     Returns
     -------
     tuple of form: (read_groups, write_groups)
@@ -454,7 +454,8 @@ def unique_fs_rw_counter(report: Any,
     # filesystem root and filename data
     df_reads, df_writes = rec_to_rw_counter_dfs_with_cols(report=report,
                                                           file_id_dict=file_id_dict,
-                                                          mod=mod)
+                                                          mod=mod,
+                                                          name_table=name_table)
     read_groups, write_groups = processing_func(df_reads=df_reads,
                                                 df_writes=df_writes)
     # if either of the Series are effectively empty we want
@@ -635,21 +636,21 @@ def plot_with_report(report: darshan.DarshanReport,
     fig: matplotlib figure object
     """
     fig = plt.figure()
-    file_id_dict = report.data["name_records"]
-    allowed_file_id_dict = {}
+    name_table = report.name_table
 
     # only POSIX/STDIO entries allowed
+    allowed_ids = []
     for module in ["POSIX", "STDIO"]:
-        for key in ["counters", "fcounters"]:
-            try:
-                allowed_ids = report.records[module].to_df()[key]["id"]
-            except KeyError:
-                allowed_ids = []
-            for ident in allowed_ids:
-                allowed_file_id_dict[ident] = file_id_dict[ident]
-
-    filesystem_roots = identify_filesystems(file_id_dict=allowed_file_id_dict,
-                                            verbose=verbose)
+        if module in report.records:
+            allowed_ids.append(report.records[module].to_df()["counters"]["id"].to_numpy())
+    if allowed_ids:
+        allowed_ids = pd.unique(np.concatenate(allowed_ids))
+    allowed_file_id_dict = dict(zip(allowed_ids,
+                                    name_table.paths(allowed_ids).astype(object)))
+
+    filesystem_roots = name_table.unique_roots(allowed_ids)
+    if verbose:
+        print("filesystem_roots:", filesystem_roots)
     # NOTE: this is a bit ugly, STDIO and POSIX are both combined
     # automatically later in the control flow, so an API redesign
     # may be in order eventually
@@ -663,12 +664,14 @@ def plot_with_report(report: darshan.DarshanReport,
                                                           file_id_dict=allowed_file_id_dict,
                                                           processing_func=process_unique_files,
                                                           mod=default_mod,
-                                                          verbose=verbose)
+                                                          verbose=verbose,
+                                                          name_table=name_table)
     bytes_rd_series, bytes_wr_series = unique_fs_rw_counter(report=report,
                                                             filesystem_roots=filesystem_roots,
                                                             file_id_dict=allowed_file_id_dict,
                                                             processing_func=process_byte_counts,
-                                                            mod=default_mod, verbose=verbose)
+                                                            mod=default_mod, verbose=verbose,
+                                                            name_table=name_table)
     # reverse sort by total bytes IO per category
     sort_inds = (bytes_rd_series + bytes_wr_series).argsort()[::-1]
     if num_cats is None:
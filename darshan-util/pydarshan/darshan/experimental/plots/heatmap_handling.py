@@ -125,24 +125,27 @@ def get_rd_wr_dfs(
         # mypy can't tell that these keys are in fact
         # in the ``SegDict``, so just ignore the type
         seg_key = op_key + "_segments"
-        # create empty list to store each dataframe
+        # collect the non-empty segment dataframes and the rank
+        # and number of segments of their records
         df_list = []
-        # iterate over all records/dictionaries
+        ranks = []
+        counts = []
         for _dict in dict_list:
             # ignore for the same reason as above
             seg_df = _dict[seg_key]  # type: ignore
             if seg_df.size:
-                # drop unused columns from the dataframe
-                seg_df = seg_df.drop(columns=drop_columns)
-                # create new column for the ranks
-                seg_df["rank"] = _dict["rank"]
-                # add the dataframe to the list
                 df_list.append(seg_df)
+                ranks.append(_dict["rank"])
+                counts.append(len(seg_df))
 
         if df_list:
-            # concatenate the list of pandas dataframes into
-            # a single one with new row indices
-            rd_wr_dfs[op_key] = pd.concat(df_list, ignore_index=True)
+            # concatenate the list of pandas dataframes into a single
+            # one with new row indices, then drop unused columns and add
+            # the ranks for all events at once rather than per record
+            rd_wr_df = pd.concat(df_list, ignore_index=True)
+            rd_wr_df = rd_wr_df.drop(columns=drop_columns)
+            rd_wr_df["rank"] = np.repeat(np.asarray(ranks, dtype=np.int64), counts)
+            rd_wr_dfs[op_key] = rd_wr_df
         else:
             # if the list is empty assign an empty dataframe
             rd_wr_dfs[op_key] = pd.DataFrame()
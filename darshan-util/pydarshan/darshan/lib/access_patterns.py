@@ -0,0 +1,102 @@
+"""
+Helpers for the POSIX access pattern histograms: the signed distance
+between consecutive accesses to a file (``POSIX_DELTA_*``) and the reuse
+distance of each access (``POSIX_REUSE_*``). These are only collected
+when ``DARSHAN_POSIX_ACCESS_PATTERNS`` is set at runtime, and are ``-1``
+otherwise.
+"""
+
+from typing import Dict
+
+import pandas as pd
+
+
+# histogram buckets, in counter order (most backward delta first)
+DELTA_BUCKETS = [
+    "BACK_4G_PLUS", "BACK_256M_4G", "BACK_16M_256M", "BACK_1M_16M",
+    "BACK_64K_1M", "BACK_4K_64K", "BACK_0_4K", "ZERO",
+    "FWD_0_4K", "FWD_4K_64K", "FWD_64K_1M", "FWD_1M_16M",
+    "FWD_16M_256M", "FWD_256M_4G", "FWD_4G_PLUS",
+]
+REUSE_BUCKETS = ["1", "2_3", "4_7", "8_16"]
+
+DELTA_COUNTERS = ["POSIX_DELTA_" + b for b in DELTA_BUCKETS]
+REUSE_COUNTERS = ["POSIX_REUSE_" + b for b in REUSE_BUCKETS]
+
+
+def _merge(counters: pd.DataFrame, columns, buckets) -> pd.Series:
+    if not set(columns).issubset(counters.columns):
+        # log predates the access pattern histograms
+        return pd.Series(dtype="int64")
+    df = counters[columns]
+    # skip records for which the histograms were not collected
+    df = df[(df >= 0).all(axis=1)]
+    if df.empty:
+        return pd.Series(dtype="int64")
+    hist = df.sum(axis=0).astype("int64")
+    hist.index = buckets
+    return hist
+
+
+def delta_histogram(counters: pd.DataFrame) -> pd.Series:
+    """
+    Merge the offset delta histograms of a set of POSIX records.
+
+    Parameters
+    ----------
+    counters: POSIX integer counters with one row per record (e.g., the
+    ``counters`` DataFrame of ``report.records["POSIX"].to_df()``). Rows
+    for different ranks or files are merged bucket by bucket.
+
+    Returns
+    -------
+    A ``Series`` of access counts indexed by bucket name (``BACK_*``,
+    ``ZERO`` and ``FWD_*``), or an empty ``Series`` if no record holds
+    the histogram.
+
+    """
+    return _merge(counters, DELTA_COUNTERS, DELTA_BUCKETS)
+
+
+def reuse_histogram(counters: pd.DataFrame) -> pd.Series:
+    """
+    Merge the reuse distance histograms of a set of POSIX records, as for
+    ``delta_histogram()``. Buckets are indexed by the range of reuse
+    distances they hold (``1``, ``2_3``, ``4_7`` and ``8_16``).
+    """
+    return _merge(counters, REUSE_COUNTERS, REUSE_BUCKETS)
+
+
+def classify_accesses(counters: pd.DataFrame) -> Dict[str, float]:
+    """
+    Break the accesses of a set of POSIX records down by pattern.
+
+    Parameters
+    ----------
+    counters: POSIX integer counters with one row per record.
+
+    Returns
+    -------
+    A dictionary with the fractions of accesses that were ``sequential``
+    (starting where the previous access ended), ``strided`` (skipping
+    forward by less than 1 MiB), ``random`` (jumping forward by 1 MiB or
+    more) and ``backward``, and the fraction of accesses that were
+    ``reused`` (touching bytes accessed within the last 16 accesses).
+    The dictionary is empty if no record holds the histograms.
+
+    """
+    delta = delta_histogram(counters)
+    total = delta.sum() if not delta.empty else 0
+    if total == 0:
+        return {}
+    reuse = reuse_histogram(counters)
+    fwd_near = ["FWD_0_4K", "FWD_4K_64K", "FWD_64K_1M"]
+    fwd_far = ["FWD_1M_16M", "FWD_16M_256M", "FWD_256M_4G", "FWD_4G_PLUS"]
+    back = [b for b in DELTA_BUCKETS if b.startswith("BACK_")]
+    return {
+        "sequential": delta["ZERO"] / total,
+        "strided": delta[fwd_near].sum() / total,
+        "random": delta[fwd_far].sum() / total,
+        "backward": delta[back].sum() / total,
+        "reused": reuse.sum() / total,
+    }
@@ -0,0 +1,106 @@
+"""
+Helpers for working with the application-defined counters recorded
+by the Darshan CUSTOM module.
+"""
+
+import darshan
+from darshan.experimental.plots import plot_common_access_table
+
+darshan.enable_experimental()
+
+import numpy as np
+import pandas as pd
+
+
+# how each counter is combined across the records of a counter that
+# was registered by only some of the ranks (and therefore not reduced
+# at runtime)
+_combine_ops = {
+    "CUSTOM_INT_VALUE": "sum",
+    "CUSTOM_INT_UPDATES": "sum",
+    "CUSTOM_INT_RANK_MIN": "min",
+    "CUSTOM_INT_RANK_MAX": "max",
+    "CUSTOM_F_UPDATES": "sum",
+    "CUSTOM_RANKS": "sum",
+    "CUSTOM_F_VALUE": "sum",
+    "CUSTOM_F_RANK_MIN": "min",
+    "CUSTOM_F_RANK_MAX": "max",
+    "CUSTOM_F_REGISTER_TIMESTAMP": "min",
+}
+
+
+def custom_counters_df(report: darshan.DarshanReport,
+                       combine: bool = True) -> pd.DataFrame:
+    """
+    Gather the CUSTOM module records of a report into a single
+    dataframe, keyed by counter name.
+
+    Parameters
+    ----------
+    report: a ``darshan.DarshanReport`` with CUSTOM records.
+
+    combine: if ``True``, records for the same counter stored by
+    different ranks (counters that were not registered by every rank)
+    are combined into a single row, as they would have been had the
+    counter been shared by all ranks.
+
+    Returns
+    -------
+    A dataframe with a ``name`` column holding the counter name,
+    ``rank`` and ``id`` columns (``rank`` is -1 for counters reduced
+    across ranks), and one column per integer and floating point
+    CUSTOM counter. Rows are sorted by name.
+
+    """
+    recs = report.records["CUSTOM"].to_df()
+    df = recs["counters"].merge(recs["fcounters"], on=["rank", "id"])
+    df.insert(0, "name", np.asarray(report.name_table.paths(df["id"]), dtype=object))
+    if combine:
+        recs_cols = list(df.columns)
+        ops = {col: op for col, op in _combine_ops.items() if col in df.columns}
+        ops["rank"] = lambda ranks: ranks.iloc[0] if len(ranks) == 1 else -1
+        df = df.groupby(["name", "id"], as_index=False).agg(ops)[recs_cols]
+    return df.sort_values("name").reset_index(drop=True)
+
+
+def log_custom_counters_table(counters_df: pd.DataFrame):
+    """
+    Build the application counters table for the summary report.
+
+    Parameters
+    ----------
+    counters_df: a dataframe as returned by ``custom_counters_df()``.
+
+    Returns
+    -------
+    A ``DarshanReportTable`` with one row per counter, showing its
+    integer and floating point values and, for counters updated by
+    more than one rank, the smallest and largest per-rank values.
+
+    """
+    def _range(row, prefix, fmt):
+        if row["CUSTOM_RANKS"] < 2:
+            return ""
+        return (f"{row[prefix + '_RANK_MIN']:{fmt}} - "
+                f"{row[prefix + '_RANK_MAX']:{fmt}}")
+
+    rows = []
+    for _, row in counters_df.iterrows():
+        has_int = row["CUSTOM_INT_UPDATES"] > 0
+        has_float = row["CUSTOM_F_UPDATES"] > 0
+        rows.append({
+            "Counter": row["name"],
+            "Ranks": row["CUSTOM_RANKS"],
+            "Integer Value": f"{row['CUSTOM_INT_VALUE']:d}" if has_int else "",
+            "Integer Per-Rank Range":
+                _range(row, "CUSTOM_INT", "d") if has_int else "",
+            "Float Value": f"{row['CUSTOM_F_VALUE']:.6g}" if has_float else "",
+            "Float Per-Rank Range":
+                _range(row, "CUSTOM_F", ".6g") if has_float else "",
+        })
+    df = pd.DataFrame(rows, columns=["Counter", "Ranks", "Integer Value",
+                                     "Integer Per-Rank Range", "Float Value",
+                                     "Float Per-Rank Range"])
+    ret = plot_common_access_table.DarshanReportTable(df, index=False,
+                                                      border=0)
+    return ret
@@ -0,0 +1,156 @@
+"""
+Helpers for attributing I/O imbalance of shared files to nodes (or
+ranks), from the distributions recorded by the Darshan IMBALANCE module.
+"""
+
+from typing import Sequence
+
+import darshan
+from darshan.backend.cffi_backend import _mod_names
+from darshan.experimental.plots import plot_common_access_table
+
+darshan.enable_experimental()
+
+import numpy as np
+import pandas as pd
+import humanize
+
+
+# number of histogram bins (IMBALANCE_NUM_BINS) and slowest units
+# (IMBALANCE_NUM_SLOWEST) of a record
+NUM_BINS = 16
+NUM_SLOWEST = 4
+
+# units in bins at or above this one are within 25% of the slowest unit
+_FAST_BIN = 12
+
+
+def classify_distribution(bins: Sequence[int]) -> str:
+    """
+    Classify the shape of a distribution of per-unit I/O time.
+
+    Parameters
+    ----------
+    bins: the ``NUM_BINS`` histogram counts of a record, where bin ``i``
+    counts the units whose time falls within ``[i/16, (i+1)/16)`` of the
+    slowest unit.
+
+    Returns
+    -------
+    One of:
+
+    * ``"balanced"``: every unit is within 25% of the slowest one.
+    * ``"straggler"``: a few units (at most one in ten, and at least
+      one) are within 25% of the slowest, and all the others are well
+      below them.
+    * ``"bimodal"``: the units form two groups, each holding at least a
+      quarter of them, separated by at least a quarter of the range
+      without any unit.
+    * ``"long tail"``: any other spread of the units.
+
+    """
+    bins = np.asarray(bins, dtype=np.int64)
+    total = bins.sum()
+    top = bins[_FAST_BIN:].sum()
+    occupied = np.flatnonzero(bins)
+    # NOTE: units all fall in bin 0 if none of them spent any time
+    if total < 2 or top == total or len(occupied) == 1:
+        return "balanced"
+    if top <= max(1, total // 10):
+        return "straggler"
+
+    # look for the widest run of empty bins between occupied ones
+    gaps = np.diff(occupied) - 1
+    widest = int(np.argmax(gaps))
+    if gaps[widest] >= NUM_BINS // 4:
+        low = bins[:occupied[widest] + 1].sum()
+        if min(low, total - low) * 4 >= total:
+            return "bimodal"
+    return "long tail"
+
+
+def imbalance_df(report: darshan.DarshanReport) -> pd.DataFrame:
+    """
+    Summarize the IMBALANCE module records of a report.
+
+    Parameters
+    ----------
+    report: a ``darshan.DarshanReport`` with IMBALANCE records.
+
+    Returns
+    -------
+    A dataframe with one row per shared record, sorted by decreasing
+    ``max_time``, with columns:
+
+    * ``name``: the name of the shared record.
+    * ``module``: the module of the shared record (e.g. ``POSIX``).
+    * ``unit``: ``"node"`` or ``"rank"``, what the distribution is over.
+    * ``units``: the number of nodes (or ranks).
+    * ``max_time``, ``mean_time``: the largest and mean I/O time of a
+      unit, in seconds.
+    * ``imbalance``: ``max_time / mean_time`` (1 when perfectly
+      balanced).
+    * ``max_bytes``: the largest bytes moved by a unit.
+    * ``slowest``: the lowest rank of each of the slowest units,
+      slowest first.
+    * ``shape``: the ``classify_distribution()`` of the times.
+
+    """
+    recs = report.records["IMBALANCE"].to_df()
+    counters = recs["counters"]
+    fcounters = recs["fcounters"]
+    time_bins = [f"IMBALANCE_TIME_BIN_{i}" for i in range(NUM_BINS)]
+    slowest_ranks = [f"IMBALANCE_SLOWEST_{i + 1}_RANK" for i in range(NUM_SLOWEST)]
+
+    df = pd.DataFrame({
+        "name": np.asarray(report.name_table.paths(counters["id"]), dtype=object),
+        "module": [_mod_names[mod_id] for mod_id in counters["IMBALANCE_MODULE"]],
+        "unit": np.where(counters["IMBALANCE_BY_NODE"] != 0, "node", "rank"),
+        "units": counters["IMBALANCE_UNITS"],
+        "max_time": fcounters["IMBALANCE_F_MAX_TIME"],
+        "mean_time": fcounters["IMBALANCE_F_MEAN_TIME"],
+        "max_bytes": counters["IMBALANCE_MAX_BYTES"],
+    })
+    mean = df["mean_time"].where(df["mean_time"] > 0)
+    df.insert(6, "imbalance", (df["max_time"] / mean).fillna(1.0))
+    df["slowest"] = [[rank for rank in ranks if rank >= 0]
+                     for ranks in counters[slowest_ranks].to_numpy().tolist()]
+    df["shape"] = [classify_distribution(bins)
+                   for bins in counters[time_bins].to_numpy()]
+    return df.sort_values("max_time", ascending=False,
+                          kind="stable").reset_index(drop=True)
+
+
+def log_imbalance_table(imbalance: pd.DataFrame, max_rows: int = 10):
+    """
+    Build the shared file imbalance table for the summary report.
+
+    Parameters
+    ----------
+    imbalance: a dataframe as returned by ``imbalance_df()``.
+
+    max_rows: the number of shared records (those with the largest
+    I/O time) to show.
+
+    Returns
+    -------
+    A ``DarshanReportTable`` with one row per shared record.
+
+    """
+    rows = imbalance.head(max_rows)
+    df = pd.DataFrame({
+        "File": rows["name"],
+        "Module": rows["module"],
+        "Units": [f"{units} {unit}s" for units, unit in
+                  zip(rows["units"], rows["unit"])],
+        "Max Time": [f"{t:.4f} s" for t in rows["max_time"]],
+        "Max/Mean": [f"{r:.2f}" for r in rows["imbalance"]],
+        "Max Bytes": [humanize.naturalsize(b, binary=True, format="%.2f")
+                      for b in rows["max_bytes"]],
+        "Slowest (rank)": [", ".join(str(r) for r in ranks)
+                           for ranks in rows["slowest"]],
+        "Shape": rows["shape"],
+    })
+    ret = plot_common_access_table.DarshanReportTable(df, index=False,
+                                                      border=0)
+    return ret
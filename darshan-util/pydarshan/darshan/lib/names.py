@@ -0,0 +1,177 @@
+"""
+Vectorized resolution of record ids to names (file paths) and
+filesystem roots, shared by the plotting and aggregation code.
+
+Resolving names one record (or one I/O event) at a time in Python
+dominates report generation for logs with millions of records, so
+the ``NameTable`` of a report is built once from its name records
+and then maps whole arrays of record ids at a time.
+"""
+
+import pathlib
+from typing import Dict, Iterable, Sequence
+
+import numpy as np
+import pandas as pd
+
+
+def path_root(file_path: str) -> str:
+    """
+    Parameters
+    ----------
+
+    file_path: a string containing the absolute file path
+
+    Returns
+    -------
+    A string containing the root path.
+
+    Examples:
+    ---------
+
+    >>> path_root("/scratch1/scratchdirs/glock/testFile.00000046")
+    '/scratch1'
+
+    """
+    path_parts = pathlib.Path(file_path).parts
+    filesystem_root = ''.join(path_parts[:2])
+    if filesystem_root.isdigit():
+        # this is probably an anonymized STD..
+        # stream, so make that clear
+        filesystem_root = f'anonymized\n({filesystem_root})'
+    if filesystem_root.startswith("//"):
+        # Shane indicates that these are individual files
+        # mounted on root
+        # see:
+        # https://github.com/darshan-hpc/darshan/pull/397#discussion_r769186581
+        filesystem_root = "/"
+    return filesystem_root
+
+
+def path_roots(file_paths: Sequence[str]) -> np.ndarray:
+    """
+    Vectorized ``path_root()``.
+
+    Parameters
+    ----------
+
+    file_paths: a sequence of file paths.
+
+    Returns
+    -------
+    An object array with the root path of each of ``file_paths``.
+
+    """
+    paths = pd.Series(file_paths, dtype=object)
+    roots = np.empty(len(paths), dtype=object)
+    if not len(paths):
+        return roots
+    # plain absolute paths (no repeated separators or "." components,
+    # which pathlib would normalize) are split with string operations;
+    # anything else goes through pathlib one path at a time
+    simple = (paths.str.match(r"/[^/]") &
+              ~paths.str.contains(r"//|/\.(?:/|$)", regex=True)).to_numpy(dtype=bool)
+    roots[simple] = ("/" + paths[simple].str.split("/", n=2).str[1]).to_numpy()
+    for i in np.flatnonzero(~simple):
+        roots[i] = path_root(paths.iat[i])
+    return roots
+
+
+def as_record_ids(ids: Iterable) -> np.ndarray:
+    """
+    Convert record ids to an array of unsigned 64-bit integers.
+
+    Record ids are unsigned 64-bit hashes, but depending on their values
+    pandas may hold them as signed integers; those are reinterpreted.
+    """
+    if not isinstance(ids, (np.ndarray, pd.Series, pd.Index)):
+        # keep python integers exact rather than letting numpy
+        # infer a float type for values beyond the int64 range
+        ids = np.array(list(ids), dtype=object)
+    ids = np.asarray(ids)
+    if ids.dtype == np.uint64:
+        return ids
+    if ids.dtype.kind == "i":
+        return ids.astype(np.int64).view(np.uint64)
+    return np.array([int(i) for i in ids], dtype=np.uint64)
+
+
+class NameTable:
+    """
+    Lookup table from record ids to names and filesystem roots.
+
+    Parameters
+    ----------
+
+    name_records: a dictionary mapping record ids to names, typically
+    ``report.name_records``.
+
+    Examples
+    --------
+
+    >>> table = NameTable({1: "/home/a", 2: "/scratch/b", 3: "/home/c"})
+    >>> list(table.paths([3, 1, 4]))
+    ['/home/c', '/home/a', nan]
+    >>> list(table.roots([3, 1, 2]))
+    ['/home', '/home', '/scratch']
+
+    """
+    def __init__(self, name_records: Dict[int, str]):
+        ids = np.fromiter(name_records.keys(), dtype=np.uint64,
+                          count=len(name_records))
+        names = np.fromiter(name_records.values(), dtype=object,
+                            count=len(name_records))
+        order = np.argsort(ids, kind="stable")
+        self.ids = ids[order]
+        self._index = pd.Index(self.ids)
+        self._names = pd.Categorical(names[order])
+        self._roots = pd.Categorical(path_roots(names[order]))
+
+    def __len__(self) -> int:
+        return len(self.ids)
+
+    def positions(self, ids: Iterable) -> np.ndarray:
+        """
+        Positions of ``ids`` in the table, ``-1`` for unknown ids.
+        """
+        if not isinstance(ids, (np.ndarray, pd.Series, pd.Index)):
+            ids = as_record_ids(ids)
+        ids = np.asarray(ids)
+        if not len(self):
+            return np.full(len(ids), -1, dtype=np.intp)
+        if ids.dtype.kind == "f":
+            # ids that went through a float column (e.g., after a
+            # concatenation with missing values) have lost precision,
+            # so they are matched against the ids rounded the same way
+            fids = self.ids.astype(np.float64)
+            order = np.argsort(fids, kind="stable")
+            idx = np.minimum(np.searchsorted(fids[order], ids), len(fids) - 1)
+            return np.where(fids[order][idx] == ids, order[idx], -1)
+        return self._index.get_indexer(as_record_ids(ids))
+
+    def _take(self, cat: pd.Categorical, ids: Iterable) -> pd.Categorical:
+        pos = self.positions(ids)
+        codes = np.where(pos >= 0, cat.codes[pos], -1) if len(self) else pos
+        return pd.Categorical.from_codes(codes, dtype=cat.dtype)
+
+    def paths(self, ids: Iterable) -> pd.Categorical:
+        """
+        Names of the records with the given ``ids`` (missing for unknown
+        ids), as a categorical array aligned with ``ids``.
+        """
+        return self._take(self._names, ids)
+
+    def roots(self, ids: Iterable) -> pd.Categorical:
+        """
+        Filesystem roots (see ``path_root()``) of the records with the
+        given ``ids`` (missing for unknown ids), as a categorical array
+        aligned with ``ids``.
+        """
+        return self._take(self._roots, ids)
+
+    def unique_roots(self, ids: Iterable) -> list:
+        """
+        Unique filesystem roots of the records with the given ``ids``,
+        in order of first appearance.
+        """
+        return list(pd.unique(np.asarray(self.roots(ids).dropna(), dtype=object)))
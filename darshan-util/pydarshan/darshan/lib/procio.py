@@ -0,0 +1,89 @@
+"""
+Helpers for summarizing the job-level page cache statistics
+recorded by the Darshan PROCIO module (from ``/proc/self/io``).
+"""
+
+from typing import Any, Dict
+
+import darshan
+from darshan.experimental.plots import plot_common_access_table
+
+darshan.enable_experimental()
+
+import pandas as pd
+import humanize
+
+
+def cache_hit_ratio(counters: Dict[str, Any]) -> float:
+    """
+    Estimate the fraction of bytes read by the job that were
+    served from the page cache rather than storage.
+
+    Parameters
+    ----------
+    counters: dictionary of PROCIO integer counters.
+
+    Returns
+    -------
+    The ratio ``1 - PROCIO_READ_BYTES / PROCIO_RCHAR`` clamped to
+    ``[0, 1]``, or ``-1`` if it cannot be determined (no reads, or
+    the counters were unavailable at runtime).
+
+    """
+    rchar = counters["PROCIO_RCHAR"]
+    read_bytes = counters["PROCIO_READ_BYTES"]
+    if rchar <= 0 or read_bytes < 0:
+        return -1.0
+    # readahead may fetch more from storage than the application asked for
+    return max(0.0, 1.0 - (read_bytes / rchar))
+
+
+def log_procio_summary_table(record: Dict[str, Any]):
+    """
+    Build the page cache summary table for the summary report.
+
+    Parameters
+    ----------
+    record: a PROCIO record (as returned with ``dtype="dict"``),
+    holding ``counters`` and ``fcounters`` dictionaries.
+
+    Returns
+    -------
+    A ``DarshanReportTable`` summarizing the record.
+
+    """
+    counters = record["counters"]
+    fcounters = record["fcounters"]
+
+    def _size(val):
+        if val < 0:
+            return "N/A"
+        return humanize.naturalsize(val, binary=True, format="%.2f")
+
+    def _ratio(val):
+        if val < 0:
+            return "N/A"
+        return f"{val * 100:.2f}%"
+
+    rows = {
+        "bytes requested by reads (rchar)": _size(counters["PROCIO_RCHAR"]),
+        "bytes read from storage": _size(counters["PROCIO_READ_BYTES"]),
+        "read cache hit ratio": _ratio(cache_hit_ratio(counters)),
+        "lowest interval read cache hit ratio":
+            _ratio(fcounters["PROCIO_F_MIN_INTERVAL_HIT_RATIO"]),
+        "bytes requested by writes (wchar)": _size(counters["PROCIO_WCHAR"]),
+        "bytes written back to storage": _size(counters["PROCIO_WRITE_BYTES"]),
+        "cancelled write-back bytes": _size(counters["PROCIO_CANCELLED_WRITE_BYTES"]),
+    }
+    if counters["PROCIO_IOWAIT_TICKS"] >= 0 and counters["PROCIO_CLK_TCK"] > 0:
+        iowait = counters["PROCIO_IOWAIT_TICKS"] / counters["PROCIO_CLK_TCK"]
+        rows["block I/O wait time (all processes)"] = f"{iowait:.2f} s"
+    else:
+        rows["block I/O wait time (all processes)"] = "N/A"
+
+    df = pd.DataFrame.from_dict(rows, orient="index")
+    ret = plot_common_access_table.DarshanReportTable(df,
+                                                      col_space=300,
+                                                      border=0,
+                                                      header=False)
+    return ret
@@ -0,0 +1,258 @@
+"""
+Process trees of non-MPI workflows.
+
+In non-MPI mode, every process writes its own log: processes forked by an
+instrumented process record the PID they were forked from as the
+``fork_parent`` metadata entry, and newer logs also record the ``pid``
+and ``ppid`` (parent PID) of the process; older logs only hold the PID
+in the default log file name. These helpers link the logs of a workflow
+into a tree and total the I/O and timing of each subtree.
+"""
+
+import os
+import re
+import concurrent.futures
+from typing import Any, Dict, Iterable, List, Optional, Tuple
+
+import pandas as pd
+
+import darshan
+
+
+# modules whose traffic is totaled; MPI-IO traffic is also counted by POSIX
+PROCTREE_MODULES = ("POSIX", "STDIO")
+
+# <user>_<exe>_id<jobid>-<pid>_<date>-<random>.darshan
+_name_pid = re.compile(r"_id\d+-(\d+)_")
+
+
+def _meta_int(meta: Dict[str, str], key: str) -> Optional[int]:
+    try:
+        return int(meta[key])
+    except (KeyError, ValueError):
+        return None
+
+
+def process_info(path: str) -> Dict[str, Any]:
+    """
+    Read the process identity, timing and I/O totals of a log.
+
+    Parameters
+    ----------
+    path: path to the Darshan log.
+
+    Returns
+    -------
+    A dictionary holding the log ``path``, the program name (``exe``),
+    ``uid``, ``jobid``, ``nprocs``, the ``pid`` and parent PID (``ppid``)
+    of the process, whether it was ``forked`` by an instrumented process,
+    its ``start`` and ``end`` time (seconds since the epoch), and the
+    ``bytes_read``, ``bytes_written`` and ``io_time`` (read, write and
+    metadata time) summed over the POSIX and STDIO records of the log.
+    ``pid`` and ``ppid`` are ``None`` when the log does not record them.
+
+    """
+    with darshan.DarshanReport(path, read_all=False) as report:
+        job = report.metadata["job"]
+        meta = job["metadata"]
+        exe = report.metadata["exe"].split()
+        info = {
+            "path": os.path.abspath(path),
+            "exe": os.path.basename(exe[0]) if exe else "<unknown>",
+            "uid": int(job["uid"]),
+            "jobid": int(job["jobid"]),
+            "nprocs": int(job["nprocs"]),
+            "start": job["start_time_sec"] + job["start_time_nsec"] / 1e9,
+            "end": job["end_time_sec"] + job["end_time_nsec"] / 1e9,
+        }
+
+        pid = _meta_int(meta, "pid")
+        if pid is None:
+            match = _name_pid.search(os.path.basename(path))
+            if match:
+                pid = int(match.group(1))
+        fork_parent = _meta_int(meta, "fork_parent")
+        info["pid"] = pid
+        info["ppid"] = fork_parent if fork_parent is not None else _meta_int(meta, "ppid")
+        info["forked"] = fork_parent is not None
+
+        bytes_read = bytes_written = 0
+        io_time = 0.0
+        for mod in PROCTREE_MODULES:
+            if mod not in report.modules:
+                continue
+            report.mod_read_all_records(mod)
+            if mod not in report.records or len(report.records[mod]) == 0:
+                continue
+            recs = report.records[mod].to_df()
+            counters, fcounters = recs["counters"], recs["fcounters"]
+            bytes_read += int(counters[mod + "_BYTES_READ"].sum())
+            bytes_written += int(counters[mod + "_BYTES_WRITTEN"].sum())
+            for op in ("READ", "WRITE", "META"):
+                io_time += float(fcounters[f"{mod}_F_{op}_TIME"].sum())
+        info["bytes_read"] = bytes_read
+        info["bytes_written"] = bytes_written
+        info["io_time"] = io_time
+    return info
+
+
+def _process_info_or_error(path):
+    try:
+        return process_info(path)
+    except Exception as e:
+        return {"path": path, "error": str(e)}
+
+
+def read_process_info(paths: Iterable[str],
+                      jobs: int = 1) -> Tuple[List[Dict[str, Any]], List[Tuple[str, str]]]:
+    """
+    Read ``process_info()`` of many logs, with ``jobs`` processes in
+    parallel. Returns the list of process information and the list of
+    errors (path and message) of logs that could not be read.
+    """
+    paths = list(paths)
+    if jobs > 1 and len(paths) > 1:
+        with concurrent.futures.ProcessPoolExecutor(max_workers=jobs) as executor:
+            results = list(executor.map(_process_info_or_error, paths,
+                                        chunksize=16))
+    else:
+        results = [_process_info_or_error(path) for path in paths]
+    infos = [r for r in results if "error" not in r]
+    errors = [(r["path"], r["error"]) for r in results if "error" in r]
+    return infos, errors
+
+
+def process_tree(infos: Iterable[Dict[str, Any]]) -> pd.DataFrame:
+    """
+    Link processes to their parents and total each subtree.
+
+    A process is linked to the process of the same user whose ``pid`` is
+    its ``ppid``. As PIDs are reused, the parent is the latest such process
+    that started no later than the child, preferring processes of the same
+    job id; processes whose parent was not instrumented (or whose logs are
+    missing) are the roots of their own trees.
+
+    Parameters
+    ----------
+    infos: process information as returned by ``process_info()``.
+
+    Returns
+    -------
+    A ``DataFrame`` with one row per process, ordered by start time, that
+    adds to the process information the row index of the ``parent`` (-1
+    for roots), of the ``root`` of its tree and its ``depth`` in the tree,
+    and totals over the subtree rooted at each process: the number of
+    processes (``subtree_procs``), ``subtree_bytes_read``,
+    ``subtree_bytes_written``, ``subtree_io_time``, the latest end time
+    (``subtree_end``), and the ``critical_path_time`` from the start of
+    the process to the end of its subtree. ``critical_child`` is the row
+    index of the child whose subtree ends last, or -1 if the process
+    itself ends last (see ``critical_path()``).
+
+    """
+    df = pd.DataFrame(list(infos))
+    if df.empty:
+        return df
+    df = df.sort_values(["start", "path"], ignore_index=True)
+    df["pid"] = df["pid"].astype("Int64")
+    df["ppid"] = df["ppid"].astype("Int64")
+    n = len(df)
+
+    # candidate parents of each (uid, pid), in start order
+    by_pid: Dict[Tuple[int, int], List[int]] = {}
+    for i, (uid, pid) in enumerate(zip(df["uid"], df["pid"])):
+        if not pd.isna(pid):
+            by_pid.setdefault((uid, int(pid)), []).append(i)
+
+    parent = [-1] * n
+    for i, (uid, ppid, jobid) in enumerate(zip(df["uid"], df["ppid"], df["jobid"])):
+        if pd.isna(ppid):
+            continue
+        # parents are always earlier in start order, so the tree is acyclic
+        cands = [j for j in by_pid.get((uid, int(ppid)), []) if j < i]
+        same_job = [j for j in cands if df.at[j, "jobid"] == jobid]
+        cands = same_job or cands
+        if cands:
+            parent[i] = cands[-1]
+
+    root = list(range(n))
+    depth = [0] * n
+    for i in range(n):
+        if parent[i] >= 0:
+            root[i] = root[parent[i]]
+            depth[i] = depth[parent[i]] + 1
+
+    procs = [1] * n
+    bytes_read = df["bytes_read"].astype("int64").tolist()
+    bytes_written = df["bytes_written"].astype("int64").tolist()
+    io_time = df["io_time"].astype(float).tolist()
+    end = df["end"].astype(float).tolist()
+    critical_child = [-1] * n
+    # children come after their parents, so fold subtrees in reverse order
+    for i in range(n - 1, -1, -1):
+        p = parent[i]
+        if p < 0:
+            continue
+        procs[p] += procs[i]
+        bytes_read[p] += bytes_read[i]
+        bytes_written[p] += bytes_written[i]
+        io_time[p] += io_time[i]
+        if end[i] > end[p]:
+            end[p] = end[i]
+            critical_child[p] = i
+
+    df["parent"] = parent
+    df["root"] = root
+    df["depth"] = depth
+    df["subtree_procs"] = procs
+    df["subtree_bytes_read"] = bytes_read
+    df["subtree_bytes_written"] = bytes_written
+    df["subtree_io_time"] = io_time
+    df["subtree_end"] = end
+    df["critical_path_time"] = df["subtree_end"] - df["start"]
+    df["critical_child"] = critical_child
+    return df
+
+
+def critical_path(tree: pd.DataFrame, index: int) -> List[int]:
+    """
+    Row indices of the chain of processes, starting at row ``index`` of a
+    ``process_tree()``, that determines when its subtree ends.
+    """
+    path = [index]
+    while tree.at[path[-1], "critical_child"] >= 0:
+        path.append(int(tree.at[path[-1], "critical_child"]))
+    return path
+
+
+def format_tree(tree: pd.DataFrame) -> str:
+    """
+    Render a ``process_tree()`` as indented text, one process per line
+    with its subtree totals; processes on the critical path of their
+    tree are marked with ``*``.
+    """
+    children: Dict[int, List[int]] = {}
+    for i, p in enumerate(tree["parent"]):
+        children.setdefault(int(p), []).append(i)
+
+    lines = []
+
+    def _walk(i, on_path):
+        row = tree.iloc[i]
+        mark = "*" if on_path else " "
+        pid = "unknown" if pd.isna(row["pid"]) else row["pid"]
+        lines.append(
+            f"{mark} {'  ' * int(row['depth'])}{row['exe']} "
+            f"(pid {pid}{', forked' if row['forked'] else ''}): "
+            f"{int(row['subtree_procs'])} procs, "
+            f"{int(row['subtree_bytes_read'])} bytes read, "
+            f"{int(row['subtree_bytes_written'])} bytes written, "
+            f"{row['subtree_io_time']:.6f} s I/O, "
+            f"{row['critical_path_time']:.6f} s critical path")
+        for c in children.get(i, []):
+            _walk(c, on_path and c == row["critical_child"])
+
+    for r in children.get(-1, []):
+        lines.append(f"# job {tree.at[r, 'jobid']}, uid {tree.at[r, 'uid']}")
+        _walk(r, True)
+    return "\n".join(lines)
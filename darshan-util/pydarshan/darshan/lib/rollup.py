@@ -0,0 +1,455 @@
+"""
+An incremental, on-disk rollup of many Darshan logs.
+
+Each log is folded into aggregate module counters, job histograms and
+per-filesystem totals keyed by executable, user and time window. The
+rollup is kept in an SQLite database, so that new logs can be added as
+they arrive (by several ingesting processes at once, if need be) and
+trends can be queried without rereading the logs.
+"""
+
+import os
+import re
+import math
+import sqlite3
+import concurrent.futures
+from typing import Any, Dict, Iterable, List, Optional, Sequence, Tuple
+
+import numpy as np
+import pandas as pd
+
+import darshan
+from darshan.log_utils import get_log_digest
+
+
+ROLLUP_SCHEMA_VERSION = 1
+
+# modules whose counters are rolled up
+ROLLUP_MODULES = ("POSIX", "MPI-IO", "STDIO")
+
+# counters that are not meaningful when summed across files and jobs:
+# modes, alignments, offsets, timestamps, per-file access/stride tables
+# and rank statistics
+_skip_counters = re.compile(r"(MODE|RENAMED_FROM|ALIGNMENT$|TIME_SIZE|MAX_BYTE|"
+                            r"STRIDE\d|ACCESS\d|RANK|VARIANCE|TIMESTAMP|"
+                            r"_HINTS|_VIEWS|BUF_SIZE|F_MAX_)")
+
+# job-level quantities histogrammed per key, in power of 2 buckets
+_hist_metrics = ("nprocs", "run_time", "io_bytes")
+
+# columns queries may group by
+_group_fields = ("exe", "uid", "window", "module", "counter", "metric",
+                 "bucket", "mount", "fs_type")
+
+_schema = """
+CREATE TABLE IF NOT EXISTS meta (
+    key TEXT PRIMARY KEY,
+    value TEXT NOT NULL
+);
+CREATE TABLE IF NOT EXISTS logs (
+    log_id TEXT PRIMARY KEY,
+    path TEXT NOT NULL,
+    size INTEGER NOT NULL,
+    mtime INTEGER NOT NULL,
+    exe TEXT NOT NULL,
+    uid INTEGER NOT NULL,
+    window INTEGER NOT NULL
+);
+CREATE INDEX IF NOT EXISTS logs_by_path ON logs (path, size, mtime);
+CREATE TABLE IF NOT EXISTS jobs (
+    exe TEXT NOT NULL,
+    uid INTEGER NOT NULL,
+    window INTEGER NOT NULL,
+    logs INTEGER NOT NULL,
+    nprocs INTEGER NOT NULL,
+    run_time REAL NOT NULL,
+    io_bytes INTEGER NOT NULL,
+    PRIMARY KEY (exe, uid, window)
+);
+CREATE TABLE IF NOT EXISTS counters (
+    exe TEXT NOT NULL,
+    uid INTEGER NOT NULL,
+    window INTEGER NOT NULL,
+    module TEXT NOT NULL,
+    counter TEXT NOT NULL,
+    value REAL NOT NULL,
+    PRIMARY KEY (exe, uid, window, module, counter)
+);
+CREATE TABLE IF NOT EXISTS histograms (
+    exe TEXT NOT NULL,
+    uid INTEGER NOT NULL,
+    window INTEGER NOT NULL,
+    metric TEXT NOT NULL,
+    bucket INTEGER NOT NULL,
+    count INTEGER NOT NULL,
+    PRIMARY KEY (exe, uid, window, metric, bucket)
+);
+CREATE TABLE IF NOT EXISTS filesystems (
+    exe TEXT NOT NULL,
+    uid INTEGER NOT NULL,
+    window INTEGER NOT NULL,
+    module TEXT NOT NULL,
+    mount TEXT NOT NULL,
+    fs_type TEXT NOT NULL,
+    files INTEGER NOT NULL,
+    bytes_read INTEGER NOT NULL,
+    bytes_written INTEGER NOT NULL,
+    PRIMARY KEY (exe, uid, window, module, mount)
+);
+"""
+
+
+def hist_bucket(value: float) -> int:
+    """
+    Power of 2 histogram bucket for a value: bucket 0 holds values below
+    1, and bucket ``b > 0`` holds values in ``[2**(b-1), 2**b)``.
+    """
+    if value < 1:
+        return 0
+    return int(math.floor(math.log2(value))) + 1
+
+
+def _exe_name(exe: str) -> str:
+    # the exe string holds the whole command line; key on the program name
+    fields = exe.split()
+    if not fields:
+        return "<unknown>"
+    return os.path.basename(fields[0])
+
+
+def _mount_of(path: str, mounts: Sequence[Tuple[str, str]]) -> Tuple[str, str]:
+    # mounts are listed with the longest mount paths first
+    for mnt_path, fs_type in mounts:
+        if path == mnt_path or path.startswith(mnt_path.rstrip("/") + "/"):
+            return mnt_path, fs_type
+    return "<unknown>", "<unknown>"
+
+
+def summarize_log(path: str, window: int) -> Dict[str, Any]:
+    """
+    Read a log and reduce it to the quantities kept in a rollup.
+
+    Parameters
+    ----------
+    path: path to the Darshan log.
+
+    window: length of the rollup time windows, in seconds.
+
+    Returns
+    -------
+    A dictionary holding the log's key (``exe``, ``uid`` and ``window``,
+    the start of the time window the job started in), its ``log_id`` (the
+    digest of its contents, so that a log is only rolled up once even if it
+    is copied or renamed),
+    job-level quantities, and the summed ``counters``, per-filesystem
+    totals (``filesystems``) and histogram ``buckets`` of the log.
+
+    """
+    st = os.stat(path)
+    summary = {"log_id": get_log_digest(path), "path": os.path.abspath(path),
+               "size": st.st_size, "mtime": int(st.st_mtime)}
+
+    with darshan.DarshanReport(path, read_all=False) as report:
+        job = report.metadata["job"]
+        summary["exe"] = _exe_name(report.metadata["exe"])
+        summary["uid"] = int(job["uid"])
+        summary["window"] = int(job["start_time_sec"]) // window * window
+        summary["nprocs"] = int(job["nprocs"])
+        summary["run_time"] = float(job["run_time"])
+
+        mounts = sorted(report.mounts, key=lambda m: len(m[0]), reverse=True)
+        counters = {}
+        filesystems = {}
+        io_bytes = 0
+        for mod in ROLLUP_MODULES:
+            if mod not in report.modules:
+                continue
+            report.mod_read_all_records(mod)
+            if mod not in report.records or len(report.records[mod]) == 0:
+                continue
+            report.update_name_records(mod=mod)
+            recs = report.records[mod].to_df()
+            df = recs["counters"].merge(recs["fcounters"], on=["rank", "id"])
+            for col in df.columns[2:]:
+                if not _skip_counters.search(col):
+                    # -1 marks counters that were not collected
+                    valid = df[col][df[col] >= 0]
+                    counters[(mod, col)] = float(valid.sum())
+
+            if mod == "MPI-IO":
+                # MPI-IO traffic is also counted by the POSIX module
+                continue
+            bytes_read = df[mod + "_BYTES_READ"]
+            bytes_written = df[mod + "_BYTES_WRITTEN"]
+            io_bytes += int(bytes_read.sum() + bytes_written.sum())
+            names = np.asarray(report.name_table.paths(df["id"]), dtype=object)
+            for name, group in df.assign(name=names).groupby("name"):
+                if not name.startswith("/"):
+                    # standard streams and anonymized names
+                    continue
+                mnt, fs_type = _mount_of(name, mounts)
+                fs = filesystems.setdefault((mod, mnt, fs_type), [0, 0, 0])
+                fs[0] += 1
+                fs[1] += int(group[mod + "_BYTES_READ"].sum())
+                fs[2] += int(group[mod + "_BYTES_WRITTEN"].sum())
+
+    summary["io_bytes"] = io_bytes
+    summary["counters"] = counters
+    summary["filesystems"] = filesystems
+    summary["buckets"] = {metric: hist_bucket(summary[metric])
+                          for metric in _hist_metrics}
+    return summary
+
+
+def _summarize_log_or_error(args):
+    path, window = args
+    try:
+        return summarize_log(path, window)
+    except Exception as e:
+        return {"path": path, "error": str(e)}
+
+
+class RollupStore:
+    """
+    An on-disk rollup of Darshan logs, keyed by executable name, user id
+    and time window.
+
+    Parameters
+    ----------
+    path: path to the rollup database, created if it does not exist.
+
+    window: length of the time windows in seconds, used when the rollup
+    is created; an existing rollup keeps the window it was created with.
+
+    """
+
+    def __init__(self, path: str, window: int = 86400):
+        # a generous timeout lets concurrent ingesting processes queue up
+        # for the write lock rather than fail
+        self.conn = sqlite3.connect(path, timeout=600, isolation_level=None)
+        self.conn.execute("PRAGMA journal_mode=WAL")
+        self.conn.executescript(_schema)
+        self.conn.execute("INSERT OR IGNORE INTO meta VALUES ('version', ?)",
+                          (str(ROLLUP_SCHEMA_VERSION),))
+        self.conn.execute("INSERT OR IGNORE INTO meta VALUES ('window', ?)",
+                          (str(window),))
+        meta = dict(self.conn.execute("SELECT key, value FROM meta"))
+        if int(meta["version"]) != ROLLUP_SCHEMA_VERSION:
+            raise ValueError(f"{path}: unsupported rollup version {meta['version']}")
+        self.window = int(meta["window"])
+
+    def close(self):
+        self.conn.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __len__(self):
+        return self.conn.execute("SELECT COUNT(*) FROM logs").fetchone()[0]
+
+    def _seen(self, path: str) -> bool:
+        # cheap check that avoids rereading logs already rolled up from the
+        # same path; logs that moved are caught by their log_id instead
+        st = os.stat(path)
+        row = self.conn.execute(
+            "SELECT 1 FROM logs WHERE path = ? AND size = ? AND mtime = ?",
+            (os.path.abspath(path), st.st_size, int(st.st_mtime))).fetchone()
+        return row is not None
+
+    def add(self, summary: Dict[str, Any]) -> bool:
+        """
+        Fold a log summary, as returned by ``summarize_log()``, into the
+        rollup.
+
+        Returns
+        -------
+        ``True`` if the log was added, or ``False`` if it had already
+        been rolled up.
+
+        """
+        key = (summary["exe"], summary["uid"], summary["window"])
+        cur = self.conn.cursor()
+        cur.execute("BEGIN IMMEDIATE")
+        try:
+            cur.execute("INSERT INTO logs VALUES (?, ?, ?, ?, ?, ?, ?)",
+                        (summary["log_id"], summary["path"], summary["size"],
+                         summary["mtime"]) + key)
+        except sqlite3.IntegrityError:
+            cur.execute("ROLLBACK")
+            return False
+        try:
+            cur.execute(
+                "INSERT INTO jobs VALUES (?, ?, ?, 1, ?, ?, ?) "
+                "ON CONFLICT DO UPDATE SET logs = logs + 1, "
+                "nprocs = nprocs + excluded.nprocs, "
+                "run_time = run_time + excluded.run_time, "
+                "io_bytes = io_bytes + excluded.io_bytes",
+                key + (summary["nprocs"], summary["run_time"],
+                       summary["io_bytes"]))
+            cur.executemany(
+                "INSERT INTO counters VALUES (?, ?, ?, ?, ?, ?) "
+                "ON CONFLICT DO UPDATE SET value = value + excluded.value",
+                [key + (mod, counter, value)
+                 for (mod, counter), value in summary["counters"].items()])
+            cur.executemany(
+                "INSERT INTO histograms VALUES (?, ?, ?, ?, ?, 1) "
+                "ON CONFLICT DO UPDATE SET count = count + 1",
+                [key + (metric, bucket)
+                 for metric, bucket in summary["buckets"].items()])
+            cur.executemany(
+                "INSERT INTO filesystems VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?) "
+                "ON CONFLICT DO UPDATE SET files = files + excluded.files, "
+                "bytes_read = bytes_read + excluded.bytes_read, "
+                "bytes_written = bytes_written + excluded.bytes_written",
+                [key + (mod, mnt, fs_type) + tuple(totals)
+                 for (mod, mnt, fs_type), totals in summary["filesystems"].items()])
+        except BaseException:
+            cur.execute("ROLLBACK")
+            raise
+        cur.execute("COMMIT")
+        return True
+
+    def ingest(self, paths: Iterable[str], jobs: int = 1) -> Dict[str, Any]:
+        """
+        Roll up any of the given logs that are not already in the rollup.
+
+        Parameters
+        ----------
+        paths: paths to Darshan logs.
+
+        jobs: number of processes reading logs in parallel.
+
+        Returns
+        -------
+        A dictionary with the number of logs ``added``, the number
+        ``skipped`` because they were already rolled up, and the
+        ``errors`` (path and message) of logs that could not be read;
+        those are not recorded, so they are retried by a later ingest.
+
+        """
+        result = {"added": 0, "skipped": 0, "errors": []}
+        todo = []
+        for path in paths:
+            if self._seen(path):
+                result["skipped"] += 1
+            else:
+                todo.append((path, self.window))
+
+        def _fold(summary):
+            if "error" in summary:
+                result["errors"].append((summary["path"], summary["error"]))
+            elif self.add(summary):
+                result["added"] += 1
+            else:
+                result["skipped"] += 1
+
+        if jobs > 1 and len(todo) > 1:
+            with concurrent.futures.ProcessPoolExecutor(max_workers=jobs) as executor:
+                for summary in executor.map(_summarize_log_or_error, todo,
+                                            chunksize=16):
+                    _fold(summary)
+        else:
+            for args in todo:
+                _fold(_summarize_log_or_error(args))
+        return result
+
+    def _query(self, table: str, columns: str, group_by: Sequence[str],
+               exe: Optional[str], uid: Optional[int],
+               since: Optional[int], until: Optional[int],
+               extra: Optional[Tuple[str, Sequence[Any]]] = None) -> pd.DataFrame:
+        for field in group_by:
+            if field not in _group_fields:
+                raise ValueError(f"cannot group rollup by {field}")
+        where = []
+        params = []
+        for cond, value in (("exe = ?", exe), ("uid = ?", uid),
+                            ("window >= ?", since), ("window < ?", until)):
+            if value is not None:
+                where.append(cond)
+                params.append(value)
+        if extra is not None:
+            where.append(extra[0])
+            params.extend(extra[1])
+        sql = f"SELECT {', '.join(group_by)}, {columns} FROM {table}"
+        if where:
+            sql += " WHERE " + " AND ".join(where)
+        sql += f" GROUP BY {', '.join(group_by)} ORDER BY {', '.join(group_by)}"
+        return pd.read_sql_query(sql, self.conn, params=params)
+
+    def jobs(self, by: Sequence[str] = ("exe", "uid", "window"),
+             exe: Optional[str] = None, uid: Optional[int] = None,
+             since: Optional[int] = None,
+             until: Optional[int] = None) -> pd.DataFrame:
+        """
+        Job totals (number of logs, summed process counts, run times and
+        bytes moved) grouped by any of ``exe``, ``uid`` and ``window``,
+        optionally restricted to an executable, a user, and windows
+        starting in ``[since, until)``.
+        """
+        return self._query("jobs", "SUM(logs) AS logs, SUM(nprocs) AS nprocs, "
+                           "SUM(run_time) AS run_time, SUM(io_bytes) AS io_bytes",
+                           by, exe, uid, since, until)
+
+    def counters(self, module: str, counters: Optional[Sequence[str]] = None,
+                 by: Sequence[str] = ("exe", "uid", "window"),
+                 exe: Optional[str] = None, uid: Optional[int] = None,
+                 since: Optional[int] = None,
+                 until: Optional[int] = None) -> pd.DataFrame:
+        """
+        Summed counters of a module, one column per counter, grouped and
+        restricted as for ``jobs()``.
+        """
+        extra_sql = "module = ?"
+        extra_params = [module]
+        if counters:
+            extra_sql += f" AND counter IN ({', '.join('?' * len(counters))})"
+            extra_params += list(counters)
+        df = self._query("counters", "SUM(value) AS value",
+                         list(by) + ["counter"], exe, uid, since, until,
+                         (extra_sql, extra_params))
+        if df.empty:
+            return pd.DataFrame(columns=list(by))
+        df = df.pivot_table(index=list(by), columns="counter", values="value",
+                            aggfunc="sum", fill_value=0)
+        df.columns.name = None
+        # only the floating point counters need to stay floating point
+        for col in df.columns:
+            if "_F_" not in col:
+                df[col] = df[col].astype("int64")
+        return df.reset_index()
+
+    def histogram(self, metric: str, by: Sequence[str] = ("exe",),
+                  exe: Optional[str] = None, uid: Optional[int] = None,
+                  since: Optional[int] = None,
+                  until: Optional[int] = None) -> pd.DataFrame:
+        """
+        Number of jobs in each power of 2 bucket of ``metric`` (one of
+        ``nprocs``, ``run_time`` and ``io_bytes``), grouped and restricted
+        as for ``jobs()``. The ``low`` column holds each bucket's lower
+        bound.
+        """
+        if metric not in _hist_metrics:
+            raise ValueError(f"unknown histogram metric {metric}")
+        df = self._query("histograms", "SUM(count) AS jobs",
+                         list(by) + ["bucket"], exe, uid, since, until,
+                         ("metric = ?", [metric]))
+        df.insert(len(by) + 1, "low",
+                  [0 if b == 0 else 2 ** (b - 1) for b in df["bucket"]])
+        return df
+
+    def filesystems(self, by: Sequence[str] = ("exe",),
+                    exe: Optional[str] = None, uid: Optional[int] = None,
+                    since: Optional[int] = None,
+                    until: Optional[int] = None) -> pd.DataFrame:
+        """
+        Files accessed and bytes moved per module and file system mount,
+        grouped and restricted as for ``jobs()``.
+        """
+        return self._query("filesystems",
+                           "SUM(files) AS files, SUM(bytes_read) AS bytes_read, "
+                           "SUM(bytes_written) AS bytes_written",
+                           list(by) + ["module", "mount", "fs_type"],
+                           exe, uid, since, until)
@@ -0,0 +1,96 @@
+"""
+Helpers for summarizing how effectively STDIO stream buffering
+coalesced application operations into system calls.
+"""
+
+from typing import Any, Dict
+
+import darshan
+from darshan.experimental.plots import plot_common_access_table
+
+darshan.enable_experimental()
+
+import pandas as pd
+import humanize
+
+
+# values of the STDIO_BUF_MODE counter
+buf_mode_names = {
+    0: "unknown",
+    1: "fully buffered",
+    2: "line buffered",
+    3: "unbuffered",
+}
+
+
+def posix_ops_per_stdio_op(counters: Dict[str, Any]) -> float:
+    """
+    Estimate the system call amplification of STDIO streams.
+
+    Parameters
+    ----------
+    counters: dictionary of STDIO integer counters.
+
+    Returns
+    -------
+    The estimated number of read/write system calls issued by the
+    stdio library per stdio read, write, or flush operation, or
+    ``-1`` if it cannot be determined (no stdio operations, or a
+    log that predates the ``STDIO_POSIX_*`` counters).
+
+    """
+    stdio_ops = (counters["STDIO_READS"] + counters["STDIO_WRITES"] +
+                 counters["STDIO_FLUSHES"])
+    posix_reads = counters["STDIO_POSIX_READS"]
+    posix_writes = counters["STDIO_POSIX_WRITES"]
+    if stdio_ops <= 0 or posix_reads < 0 or posix_writes < 0:
+        return -1.0
+    return (posix_reads + posix_writes) / stdio_ops
+
+
+def log_stdio_buffering_table(counters: Dict[str, Any]):
+    """
+    Build the STDIO buffering summary table for the summary report.
+
+    Parameters
+    ----------
+    counters: dictionary of STDIO integer counters, typically those
+    of the record accumulated across all STDIO records in a log.
+
+    Returns
+    -------
+    A ``DarshanReportTable`` summarizing the record.
+
+    """
+    stdio_ops = (counters["STDIO_READS"] + counters["STDIO_WRITES"] +
+                 counters["STDIO_FLUSHES"])
+    ratio = posix_ops_per_stdio_op(counters)
+
+    rows = {"stdio operations": f"{int(stdio_ops)}"}
+    if ratio < 0:
+        rows["estimated system calls"] = "N/A"
+        rows["system calls per stdio operation"] = "N/A"
+        rows["average bytes per system call"] = "N/A"
+    else:
+        posix_ops = counters["STDIO_POSIX_READS"] + counters["STDIO_POSIX_WRITES"]
+        rows["estimated system calls"] = f"{int(posix_ops)}"
+        rows["system calls per stdio operation"] = f"{ratio:.4f}"
+        if posix_ops > 0:
+            total_bytes = counters["STDIO_BYTES_READ"] + counters["STDIO_BYTES_WRITTEN"]
+            rows["average bytes per system call"] = humanize.naturalsize(
+                total_bytes / posix_ops, binary=True, format="%.2f")
+        else:
+            rows["average bytes per system call"] = "N/A"
+    if counters["STDIO_SETVBUFS"] < 0:
+        rows["buffering changes (setvbuf and friends)"] = "N/A"
+    else:
+        rows["buffering changes (setvbuf and friends)"] = f"{int(counters['STDIO_SETVBUFS'])}"
+    rows["most restrictive buffering mode"] = buf_mode_names.get(
+        int(counters["STDIO_BUF_MODE"]), "unknown")
+
+    df = pd.DataFrame.from_dict(rows, orient="index")
+    ret = plot_common_access_table.DarshanReportTable(df,
+                                                      col_space=300,
+                                                      border=0,
+                                                      header=False)
+    return ret
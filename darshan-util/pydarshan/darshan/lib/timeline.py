@@ -0,0 +1,301 @@
+"""
+Streaming aggregation of DXT traces into bounded size timelines.
+
+DXT segments are read from the log in fixed size chunks of arrays, and
+adjacent segments of each module, file, rank and operation (a "lane")
+are merged into intervals at a target time resolution, which is
+coarsened as needed to keep the number of intervals bounded. Memory use
+thus depends on the chunk size, the interval bound and the largest
+single DXT record, but not on the length of the trace.
+"""
+
+from typing import Dict, Iterator, Optional, Sequence
+
+import darshan
+import darshan.backend.cffi_backend as backend
+
+import numpy as np
+import pandas as pd
+
+
+# the modules holding DXT traces, indexed by the module codes of chunks
+DXT_MODULES = ("DXT_POSIX", "DXT_MPIIO")
+
+# operation codes of segments
+READ = 0
+WRITE = 1
+
+# default number of segments per chunk (about 40 bytes each)
+CHUNK_SIZE = 1 << 18
+
+# default number of intervals kept before the resolution is coarsened
+MAX_INTERVALS = 100000
+
+_LANE_KEYS = ("module", "id", "rank", "op")
+
+
+def dxt_segment_chunks(log_path: str,
+                       mods: Sequence[str] = DXT_MODULES,
+                       chunk_size: int = CHUNK_SIZE,
+                       ) -> Iterator[Dict[str, np.ndarray]]:
+    """
+    Read the DXT segments of a log in chunks.
+
+    Parameters
+    ----------
+    log_path: path to a darshan log.
+
+    mods: the DXT modules to read segments from.
+
+    chunk_size: the maximum number of segments of a chunk.
+
+    Yields
+    ------
+    Dictionaries of equal length arrays, with one element per segment:
+
+    * ``module``: index of the module of the segment in ``DXT_MODULES``.
+    * ``id``: record id (``uint64``).
+    * ``rank``: rank of the record.
+    * ``op``: ``READ`` or ``WRITE``.
+    * ``start_time``, ``end_time``: in seconds since the job start.
+    * ``length``: bytes accessed.
+
+    """
+    log = backend.log_open(log_path)
+    if not bool(log["handle"]):
+        raise RuntimeError(f"Failed to open file {log_path}")
+
+    parts: list = []
+    size = 0
+
+    def flush():
+        return {key: np.concatenate([part[key] for part in parts])
+                for key in parts[0]}
+
+    try:
+        modules = backend.log_get_modules(log)
+        for mod in mods:
+            if mod not in modules:
+                continue
+            code = DXT_MODULES.index(mod)
+            rec = backend.log_get_dxt_segments(log, mod)
+            while rec is not None:
+                for op, key in ((WRITE, "write_segments"), (READ, "read_segments")):
+                    segs = rec[key]
+                    pos = 0
+                    # records larger than what is left of the
+                    # chunk are split across chunks
+                    while pos < len(segs):
+                        n = min(len(segs) - pos, chunk_size - size)
+                        seg = segs[pos:pos + n]
+                        parts.append({
+                            "module": np.full(n, code, dtype=np.int8),
+                            "id": np.full(n, rec["id"], dtype=np.uint64),
+                            "rank": np.full(n, rec["rank"], dtype=np.int64),
+                            "op": np.full(n, op, dtype=np.int8),
+                            "start_time": seg["start_time"],
+                            "end_time": seg["end_time"],
+                            "length": seg["length"],
+                        })
+                        pos += n
+                        size += n
+                        if size == chunk_size:
+                            yield flush()
+                            parts = []
+                            size = 0
+                rec = backend.log_get_dxt_segments(log, mod)
+        if parts:
+            yield flush()
+    finally:
+        backend.log_close(log)
+
+
+def _merge(lane: np.ndarray, start: np.ndarray, end: np.ndarray,
+           count: np.ndarray, nbytes: np.ndarray, resolution: float):
+    """
+    Merge the intervals of each lane that overlap or are separated by
+    at most ``resolution`` seconds.
+    """
+    order = np.lexsort((start, lane))
+    lane, start, end = lane[order], start[order], end[order]
+    count, nbytes = count[order], nbytes[order]
+    # latest end of the preceding intervals of the same lane
+    reach = pd.Series(end).groupby(lane).cummax().to_numpy()
+    new = np.ones(len(lane), dtype=bool)
+    new[1:] = ((lane[1:] != lane[:-1]) |
+               (start[1:] > reach[:-1] + resolution))
+    first = np.flatnonzero(new)
+    return (lane[first],
+            np.minimum.reduceat(start, first),
+            np.maximum.reduceat(end, first),
+            np.add.reduceat(count, first),
+            np.add.reduceat(nbytes, first))
+
+
+class TimelineAggregator:
+    """
+    Merge chunks of DXT segments into a bounded number of intervals.
+
+    Parameters
+    ----------
+    resolution: the largest gap, in seconds, between segments of a lane
+    that are merged into one interval; typically the time spanned by a
+    pixel of the rendered timeline.
+
+    max_intervals: the number of intervals above which the resolution
+    is doubled until at most half of them remain. Lanes are never merged
+    with each other, so a trace with more lanes keeps one interval each.
+
+    Examples
+    --------
+
+    >>> agg = TimelineAggregator(resolution=1.0)
+    >>> agg.add({"module": np.zeros(3, dtype=np.int8),
+    ...          "id": np.full(3, 7, dtype=np.uint64),
+    ...          "rank": np.zeros(3, dtype=np.int64),
+    ...          "op": np.full(3, WRITE, dtype=np.int8),
+    ...          "start_time": np.array([0.0, 0.5, 4.0]),
+    ...          "end_time": np.array([0.2, 1.0, 4.5]),
+    ...          "length": np.array([10, 10, 10])})
+    >>> agg.result()[["start", "end", "count", "bytes"]].values.tolist()
+    [[0.0, 1.0, 2.0, 20.0], [4.0, 4.5, 1.0, 10.0]]
+
+    """
+    def __init__(self, resolution: float, max_intervals: int = MAX_INTERVALS):
+        self.resolution = max(float(resolution), 0.0)
+        self.max_intervals = max_intervals
+        # lane of each (module, id, rank, op) key
+        self._lanes: Dict[tuple, int] = {}
+        # merged intervals, as arrays pending the next compaction
+        self._pending: list = []
+        self._size = 0
+
+    def _lane_ids(self, chunk: Dict[str, np.ndarray]) -> np.ndarray:
+        # only the distinct keys of the chunk are looked up
+        keys = pd.DataFrame({key: chunk[key] for key in _LANE_KEYS})
+        codes, uniques = pd.MultiIndex.from_frame(keys).factorize()
+        lanes = np.array([self._lanes.setdefault(tuple(int(k) for k in key),
+                                                 len(self._lanes))
+                          for key in uniques], dtype=np.int64)
+        return lanes[codes]
+
+    def add(self, chunk: Dict[str, np.ndarray]):
+        """
+        Add a chunk of segments, as yielded by ``dxt_segment_chunks()``.
+        """
+        # fields left out of the trace (see DXT_FIELDS) read back as -1;
+        # segments without a start time cannot be placed on the timeline
+        keep = chunk["start_time"] >= 0
+        if not keep.all():
+            chunk = {key: val[keep] for key, val in chunk.items()}
+        if not len(chunk["id"]):
+            return
+        start = chunk["start_time"].astype(np.float64)
+        end = chunk["end_time"].astype(np.float64)
+        merged = _merge(self._lane_ids(chunk),
+                        start,
+                        np.where(end >= 0, end, start),
+                        np.ones(len(chunk["id"]), dtype=np.int64),
+                        np.maximum(chunk["length"].astype(np.int64), 0),
+                        self.resolution)
+        self._pending.append(merged)
+        self._size += len(merged[0])
+        if self._size > self.max_intervals:
+            self._compact()
+            while (self._size > self.max_intervals // 2 and
+                   self._size > len(self._lanes)):
+                if self.resolution > 0:
+                    self.resolution *= 2
+                else:
+                    _, start, end, _, _ = self._pending[0]
+                    self.resolution = ((end.max() - start.min()) /
+                                       max(self.max_intervals, 1)) or 1e-6
+                self._compact()
+
+    def _compact(self):
+        if self._pending:
+            parts = list(zip(*self._pending))
+            merged = _merge(*[np.concatenate(part) for part in parts],
+                            resolution=self.resolution)
+            self._pending = [merged]
+            self._size = len(merged[0])
+
+    def result(self) -> pd.DataFrame:
+        """
+        Returns
+        -------
+        A dataframe with one row per interval, sorted by module, rank,
+        record id, operation and start time, with columns:
+
+        * ``module``: the DXT module name.
+        * ``id``: the record id.
+        * ``rank``: the rank of the record.
+        * ``operation``: ``"read"`` or ``"write"``.
+        * ``start``, ``end``: the interval bounds, in seconds since the
+          job start.
+        * ``count``: the number of segments merged into the interval.
+        * ``bytes``: the bytes accessed by those segments.
+
+        """
+        columns = ["module", "id", "rank", "operation", "start", "end",
+                   "count", "bytes"]
+        if not self._pending:
+            return pd.DataFrame(columns=columns)
+        self._compact()
+        lane, start, end, count, nbytes = self._pending[0]
+        module, ids, rank, op = (list(field) for field in zip(*self._lanes))
+        df = pd.DataFrame({
+            "module": np.asarray(DXT_MODULES, dtype=object)[module][lane],
+            "id": np.array(ids, dtype=np.uint64)[lane],
+            "rank": np.array(rank, dtype=np.int64)[lane],
+            "operation": np.where(np.array(op)[lane] == WRITE, "write", "read"),
+            "start": start,
+            "end": end,
+            "count": count,
+            "bytes": nbytes,
+        })
+        return df.sort_values(["module", "rank", "id", "operation", "start"],
+                              kind="stable").reset_index(drop=True)
+
+
+def dxt_timeline(report: darshan.DarshanReport,
+                 width: int = 1000,
+                 resolution: Optional[float] = None,
+                 max_intervals: int = MAX_INTERVALS,
+                 chunk_size: int = CHUNK_SIZE) -> pd.DataFrame:
+    """
+    Aggregate the DXT traces of a report into a bounded size timeline.
+
+    The segments are streamed from the report's log file, so the DXT
+    records do not need to be (and should not be) read into the report.
+
+    Parameters
+    ----------
+    report: a ``darshan.DarshanReport``.
+
+    width: the number of pixels spanning the job runtime; the resolution
+    is the runtime divided by ``width``.
+
+    resolution: the resolution in seconds, overriding ``width``.
+
+    max_intervals: the bound on the number of intervals, see
+    ``TimelineAggregator``.
+
+    chunk_size: the number of segments processed at a time.
+
+    Returns
+    -------
+    A dataframe as returned by ``TimelineAggregator.result()``, with a
+    ``resolution`` entry in its ``attrs`` giving the final resolution.
+
+    """
+    if resolution is None:
+        job = report.metadata["job"]
+        resolution = max(job["run_time"], 1.0) / max(width, 1)
+    agg = TimelineAggregator(resolution, max_intervals=max_intervals)
+    mods = [mod for mod in DXT_MODULES if mod in report.modules]
+    for chunk in dxt_segment_chunks(report.filename, mods, chunk_size):
+        agg.add(chunk)
+    df = agg.result()
+    df.attrs["resolution"] = agg.resolution
+    return df
@@ -13,6 +13,7 @@ else:
     import importlib.resources as importlib_resources # type: ignore
 
 import functools
+import hashlib
 import sys
 import os
 import glob
@@ -102,3 +103,24 @@ def get_log_path(filename: str) -> str:
             pytest.skip(err_msg)
         else:
             raise FileNotFoundError(err_msg)
+
+
+def get_log_digest(log_path: str) -> str:
+    """
+    Compute the SHA-256 digest of a log file's contents, which identifies
+    the log even if it is copied or renamed.
+
+    Parameters
+    ----------
+    log_path : path to a darshan log file.
+
+    Returns
+    -------
+    The hex digest of the log file.
+
+    """
+    sha = hashlib.sha256()
+    with open(log_path, "rb") as f:
+        for chunk in iter(lambda: f.read(1 << 20), b""):
+            sha.update(chunk)
+    return sha.hexdigest()
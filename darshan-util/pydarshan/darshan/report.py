@@ -10,6 +10,7 @@ interaction and aggregation of Darshan logs using Python.
 import darshan.backend.cffi_backend as backend
 
 from darshan.datatypes.heatmap import Heatmap
+from darshan.lib.names import NameTable
 
 import json
 import re
@@ -349,6 +350,8 @@ class DarshanReport(object):
         self._mounts = {}
         self.name_records = {}
         self._heatmaps = {}
+        self._snapshots = {}
+        self._name_table = None
 
         # initialize report/summary namespace
         self.summary_revision = 0       # counter to check if summary needs update (see data_revision)
@@ -393,6 +396,23 @@ class DarshanReport(object):
     def heatmaps(self):
         return self._heatmaps
 
+    @property
+    def snapshots(self):
+        return self._snapshots
+
+    @property
+    def name_table(self):
+        """
+        A ``darshan.lib.names.NameTable`` for resolving arrays of record
+        ids to names and filesystem roots. It is built once and only
+        rebuilt when name records have been added since.
+        """
+        names = self.name_records
+        if (self._name_table is None or self._name_table[0] is not names or
+                len(self._name_table[1]) != len(names)):
+            self._name_table = (names, NameTable(names))
+        return self._name_table[1]
+
 #    @property
 #    def counters(self):
 #        return self._counters
@@ -548,6 +568,8 @@ class DarshanReport(object):
             self.mod_read_all_apxc_records(dtype=dtype)
         if "HEATMAP" in self.data['modules']:
             self.read_all_heatmap_records()
+        if "SNAPSHOT" in self.data['modules']:
+            self.read_all_snapshot_records()
         
         return
 
@@ -635,6 +657,63 @@ class DarshanReport(object):
         self._heatmaps = heatmaps
 
 
+    def read_all_snapshot_records(self):
+        """
+        Read all counter snapshot records from darshan log as time series.
+
+        .. note::
+            As with heatmaps, the module that took the snapshots is encoded
+            in a name record ("snapshot:POSIX"). The time series of each
+            module are exposed through the report.snapshots property as a
+            DataFrame with one row per rank and snapshot interval, holding
+            the ``rank``, the interval start ``time`` (seconds since the
+            start of the job) and the change of each captured counter over
+            the interval. Intervals without activity are not stored in the
+            log and so have no row. The interval length and the number of
+            snapshots that were ``dropped`` by each rank when its snapshot
+            ring wrapped are kept in the DataFrame ``attrs``.
+
+        Args:
+            None
+
+        Return:
+            None
+        """
+
+        if "SNAPSHOT" not in self.data['modules']:
+            raise ModuleNotInDarshanLog("SNAPSHOT")
+
+        recs = []
+        rec = backend._log_get_snapshot_record(self.log)
+        while rec is not None:
+            recs.append(rec)
+            rec = backend._log_get_snapshot_record(self.log)
+
+        names = backend.log_lookup_name_records(self.log, [rec['id'] for rec in recs])
+
+        snapshots = {}
+        for rec in recs:
+            name = names.get(rec['id'], str(rec['id']))
+            mod = name.split(":")[-1]
+            snapshots.setdefault(mod, []).append(rec)
+
+        self._snapshots = {}
+        for mod, mod_recs in snapshots.items():
+            frames = []
+            for rec in mod_recs:
+                df = pd.DataFrame(rec['deltas'], columns=rec['counters'])
+                df.insert(0, "time", rec['times'])
+                df.insert(0, "rank", rec['rank'])
+                frames.append(df)
+            df = pd.concat(frames, ignore_index=True).fillna(0)
+            counters = [c for c in df.columns if c not in ("rank", "time")]
+            df[counters] = df[counters].astype(np.int64)
+            df = df.sort_values(["rank", "time"], ignore_index=True)
+            df.attrs["interval_seconds"] = mod_recs[0]['interval_seconds']
+            df.attrs["dropped"] = {rec['rank']: rec['dropped'] for rec in mod_recs}
+            self._snapshots[mod] = df
+
+
     def mod_read_all_records(self, mod, dtype=None, warnings=True):
         """
         Reads all generic records for module
@@ -647,7 +726,7 @@ class DarshanReport(object):
             None
 
         """
-        unsupported =  ['DXT_POSIX', 'DXT_MPIIO', 'LUSTRE', 'APMPI', 'APXC', 'HEATMAP']
+        unsupported =  ['DXT_POSIX', 'DXT_MPIIO', 'LUSTRE', 'APMPI', 'APXC', 'HEATMAP', 'SNAPSHOT']
 
         if mod in unsupported:
             if warnings:
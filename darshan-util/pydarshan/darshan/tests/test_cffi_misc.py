@@ -86,6 +86,11 @@ def test_log_get_generic_record(dtype):
             0, 4, 14, 0, 0, 0, 0, 0, 0, 16384, 0, 274743689216,
             274743691264, 0, 0, 10240, 4096, 0, 0, 134217728, 272, 544,
             328, 16384, 8, 2, 2, 597, 1073741824, 1312, 1073741824,
+            -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
         ]
     )
     expected_fcounter_vals = np.array(
@@ -94,7 +99,7 @@ def test_log_get_generic_record(dtype):
             3.936579942703247, 0.0, 115.0781660079956, 115.77035808563232,
             0.0, 100397.60042190552, 11.300841808319092, 0.0,
             17.940945863723755, 20.436099529266357, 85.47495031356812,
-            0.0, 0.0,
+            0.0, 0.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0,
         ]
     )
 
@@ -112,16 +117,16 @@ def test_log_get_generic_record(dtype):
 
     if dtype == "numpy":
         # check the length of the returned arrays are correct
-        assert rec["counters"].size == 69
-        assert rec["fcounters"].size == 17
+        assert rec["counters"].size == 117
+        assert rec["fcounters"].size == 23
         # collect the actual counter/fcounter values
         actual_counter_vals = rec["counters"]
         actual_fcounter_vals = rec["fcounters"]
 
     elif dtype == "dict":
         # check the length of the returned dictionaries are correct
-        assert len(rec["counters"]) == 69
-        assert len(rec["fcounters"]) == 17
+        assert len(rec["counters"]) == 117
+        assert len(rec["fcounters"]) == 23
         # collect the actual counter/fcounter key names
         actual_counter_names = list(rec["counters"].keys())
         actual_fcounter_names = list(rec["fcounters"].keys())
@@ -140,8 +145,8 @@ def test_log_get_generic_record(dtype):
         # make sure the dataframes are the expected shapes
         # the shapes are 2 larger than the arrays since the id/rank
         # columns are added to the dataframes
-        assert rec["counters"].shape == (1, 71)
-        assert rec["fcounters"].shape == (1, 19)
+        assert rec["counters"].shape == (1, 119)
+        assert rec["fcounters"].shape == (1, 25)
         # collect the actual counter/fcounter key names
         # don't include the id/rank columns
         actual_counter_names = list(rec["counters"].columns)[2:]
@@ -110,12 +110,12 @@ def test_identify_filesystems(capsys, file_id_dict, expected_root_paths, verbose
                           expected_df_reads_shape,
                           expected_df_writes_shape""", [
     (get_log_path("sample.darshan"),
-     (0, 87),
-     (3, 87),
+     (0, 140),
+     (3, 140),
     ),
     (get_log_path("sample-dxt-simple.darshan"),
-     (0, 73),
-     (2, 73),
+     (0, 121),
+     (2, 121),
     ),
     ])
 def test_rec_to_rw_counter_dfs_with_cols(log_path,
@@ -0,0 +1,66 @@
+import darshan
+from darshan.lib.access_patterns import (DELTA_BUCKETS, classify_accesses,
+                                         delta_histogram, reuse_histogram)
+from darshan.log_utils import get_log_path
+
+import pandas as pd
+import pytest
+
+
+@pytest.fixture
+def posix_counters():
+    # access_patterns.darshan was generated with DARSHAN_POSIX_ACCESS_PATTERNS
+    # set by a single process that wrote a file sequentially in 64 4 KiB
+    # blocks, read 1 KiB every 16 KiB forward and then backward, and then
+    # read the first 100 bytes 8 times
+    log_path = get_log_path("access_patterns.darshan")
+    with darshan.DarshanReport(log_path, read_all=True) as report:
+        return report.records["POSIX"].to_df()["counters"]
+
+
+def test_delta_histogram(posix_counters):
+    hist = delta_histogram(posix_counters)
+    assert list(hist.index) == DELTA_BUCKETS
+    # every read and write lands in exactly one bucket
+    assert hist.sum() == (posix_counters["POSIX_READS"].sum() +
+                          posix_counters["POSIX_WRITES"].sum())
+    assert hist["ZERO"] == 64
+    assert hist["FWD_4K_64K"] == 15
+    assert hist["BACK_4K_64K"] == 15
+    assert hist["BACK_64K_1M"] == 1
+    assert hist["BACK_0_4K"] == 9
+
+
+def test_reuse_histogram(posix_counters):
+    hist = reuse_histogram(posix_counters)
+    assert hist.to_dict() == {"1": 9, "2_3": 1, "4_7": 2, "8_16": 4}
+
+
+def test_merge_across_records(posix_counters):
+    # histograms of different ranks merge bucket by bucket, and records
+    # without histograms are left out
+    missing = posix_counters.copy()
+    missing.loc[:, "POSIX_DELTA_BACK_4G_PLUS":"POSIX_REUSE_8_16"] = -1
+    merged = pd.concat([posix_counters, posix_counters, missing])
+    assert (delta_histogram(merged) == 2 * delta_histogram(posix_counters)).all()
+    assert (reuse_histogram(merged) == 2 * reuse_histogram(posix_counters)).all()
+
+
+def test_classify_accesses(posix_counters):
+    fractions = classify_accesses(posix_counters)
+    assert fractions["sequential"] == pytest.approx(64 / 104)
+    assert fractions["strided"] == pytest.approx(15 / 104)
+    assert fractions["random"] == 0
+    assert fractions["backward"] == pytest.approx(25 / 104)
+    assert fractions["reused"] == pytest.approx(16 / 104)
+
+
+def test_not_collected():
+    # logs written without DARSHAN_POSIX_ACCESS_PATTERNS (or by older
+    # versions of Darshan) have no histograms
+    with darshan.DarshanReport(get_log_path("sample.darshan")) as report:
+        counters = report.records["POSIX"].to_df()["counters"]
+    assert (counters["POSIX_DELTA_ZERO"] == -1).all()
+    assert delta_histogram(counters).empty
+    assert reuse_histogram(counters).empty
+    assert classify_accesses(counters) == {}
@@ -0,0 +1,96 @@
+from unittest import mock
+
+import darshan
+from darshan.cli import summary
+from darshan.lib.custom import custom_counters_df, log_custom_counters_table
+from darshan.log_utils import get_log_path
+
+import pandas as pd
+
+import pytest
+
+
+@pytest.fixture
+def custom_report():
+    # custom.darshan was generated by the custom-counter-test regression
+    # case with 2 ranks of 4 threads, each thread adding 1000 integer
+    # increments to "app.checkpoints" and 1000 increments of 0.5 to
+    # "app.stage_seconds"; each rank added (rank + 1) * 100 to
+    # "app.rank_bytes", and only rank 0 registered "app.rank0_only"
+    log_path = get_log_path("custom.darshan")
+    with darshan.DarshanReport(log_path, read_all=True) as report:
+        assert "CUSTOM" in report.modules
+        yield report
+
+
+def test_custom_counters_df(custom_report):
+    df = custom_counters_df(custom_report).set_index("name")
+    assert list(df.index) == ["app.checkpoints", "app.rank0_only",
+                              "app.rank_bytes", "app.stage_seconds"]
+    assert df.columns[0] == "rank"
+    assert df.loc["app.checkpoints", "CUSTOM_INT_VALUE"] == 8000
+    assert df.loc["app.checkpoints", "CUSTOM_INT_UPDATES"] == 8000
+    assert df.loc["app.checkpoints", "CUSTOM_RANKS"] == 2
+    assert df.loc["app.checkpoints", "rank"] == -1
+    assert df.loc["app.stage_seconds", "CUSTOM_F_VALUE"] == pytest.approx(4000)
+    assert df.loc["app.stage_seconds", "CUSTOM_F_RANK_MAX"] == pytest.approx(2000)
+    assert df.loc["app.rank_bytes", "CUSTOM_INT_RANK_MIN"] == 100
+    assert df.loc["app.rank_bytes", "CUSTOM_INT_RANK_MAX"] == 200
+    assert df.loc["app.rank0_only", "rank"] == 0
+    assert df.loc["app.rank0_only", "CUSTOM_F_VALUE"] == pytest.approx(0.25)
+
+
+def test_custom_counters_df_combine(custom_report):
+    # split the reduced "app.rank_bytes" record into the two per-rank
+    # records that would have been stored had the counter not been
+    # registered by every rank
+    recs = custom_report.records["CUSTOM"].to_df()
+    rec_id = [k for k, v in custom_report.name_records.items()
+              if v == "app.rank_bytes"][0]
+    counters = recs["counters"][recs["counters"]["id"] == rec_id]
+    fcounters = recs["fcounters"][recs["fcounters"]["id"] == rec_id]
+    counters = pd.concat([counters, counters], ignore_index=True)
+    fcounters = pd.concat([fcounters, fcounters], ignore_index=True)
+    for rank, value in [(0, 100), (1, 200)]:
+        counters.loc[rank, ["rank", "CUSTOM_INT_VALUE", "CUSTOM_INT_UPDATES",
+                            "CUSTOM_INT_RANK_MIN", "CUSTOM_INT_RANK_MAX",
+                            "CUSTOM_RANKS"]] = [rank, value, 1, value, value, 1]
+        fcounters.loc[rank, "rank"] = rank
+
+    with mock.patch.object(custom_report.records["CUSTOM"], "to_df",
+                           return_value={"counters": counters,
+                                         "fcounters": fcounters}):
+        combined = custom_counters_df(custom_report)
+        uncombined = custom_counters_df(custom_report, combine=False)
+
+    assert list(uncombined["rank"]) == [0, 1]
+    assert len(combined) == 1
+    combined = combined.iloc[0]
+    assert combined["rank"] == -1
+    assert combined["CUSTOM_INT_VALUE"] == 300
+    assert combined["CUSTOM_INT_UPDATES"] == 2
+    assert combined["CUSTOM_INT_RANK_MIN"] == 100
+    assert combined["CUSTOM_INT_RANK_MAX"] == 200
+    assert combined["CUSTOM_RANKS"] == 2
+
+
+def test_log_custom_counters_table(custom_report):
+    df = log_custom_counters_table(custom_counters_df(custom_report)).df
+    df = df.set_index("Counter")
+    assert df.loc["app.checkpoints", "Integer Value"] == "8000"
+    assert df.loc["app.checkpoints", "Float Value"] == ""
+    assert df.loc["app.rank_bytes", "Integer Per-Rank Range"] == "100 - 200"
+    assert df.loc["app.stage_seconds", "Float Value"] == "4000"
+    # no per-rank range for a counter updated by a single rank
+    assert df.loc["app.rank0_only", "Integer Per-Rank Range"] == ""
+
+
+def test_custom_summary_section(tmpdir):
+    log_path = get_log_path("custom.darshan")
+    with tmpdir.as_cwd():
+        with mock.patch("sys.argv", ["", log_path, "--output=custom.html"]):
+            summary.main()
+        with open("custom.html") as html_report:
+            report_str = html_report.read()
+    assert "Application Counters" in report_str
+    assert "app.stage_seconds" in report_str
@@ -0,0 +1,87 @@
+from unittest import mock
+
+import darshan
+from darshan.cli import summary
+from darshan.lib.imbalance import (classify_distribution, imbalance_df,
+                                   log_imbalance_table)
+from darshan.log_utils import get_log_path
+
+import pytest
+
+
+@pytest.fixture
+def imbalance():
+    # imbalance.darshan was generated by the imbalance-test regression
+    # case on 2 ranks, with distributions taken across ranks; rank 1
+    # wrote 8000 bytes of the shared file and rank 0 wrote 1000
+    log_path = get_log_path("imbalance.darshan")
+    with darshan.DarshanReport(log_path, read_all=True) as report:
+        assert "IMBALANCE" in report.modules
+        df = imbalance_df(report)
+    return df
+
+
+def test_imbalance_counters():
+    log_path = get_log_path("imbalance.darshan")
+    with darshan.DarshanReport(log_path, read_all=True) as report:
+        records = report.records["IMBALANCE"].to_dict()
+    assert len(records) == 1
+    counters = records[0]["counters"]
+    assert records[0]["rank"] == -1
+    assert counters["IMBALANCE_UNITS"] == 2
+    assert counters["IMBALANCE_MAX_BYTES"] == 8000
+    assert counters["IMBALANCE_BYTES_BIN_2"] == 1
+    assert counters["IMBALANCE_BYTES_BIN_15"] == 1
+    assert sum(counters[f"IMBALANCE_TIME_BIN_{i}"] for i in range(16)) == 2
+    assert counters["IMBALANCE_SLOWEST_3_RANK"] == -1
+
+
+def test_imbalance_df(imbalance):
+    assert len(imbalance) == 1
+    row = imbalance.iloc[0]
+    assert row["name"].endswith("imbalance-test.tmp.dat")
+    assert row["module"] == "POSIX"
+    assert row["unit"] == "rank"
+    assert row["units"] == 2
+    assert row["max_bytes"] == 8000
+    assert row["imbalance"] == pytest.approx(row["max_time"] / row["mean_time"])
+    assert sorted(row["slowest"]) == [0, 1]
+
+
+@pytest.mark.parametrize("bins, expected", [
+    # a single unit is always balanced
+    ([0] * 15 + [1], "balanced"),
+    # no unit spent any time
+    ([4] + [0] * 15, "balanced"),
+    # every unit within 25% of the slowest
+    ([0] * 12 + [1, 2, 3, 10], "balanced"),
+    # one slow node among many fast ones
+    ([40, 10] + [0] * 13 + [1], "straggler"),
+    # two well separated groups of units
+    ([0, 0, 10, 5] + [0] * 8 + [0, 0, 8, 7], "bimodal"),
+    # units spread over the whole range
+    ([1] * 16, "long tail"),
+    # a small separated group is a tail rather than a mode
+    ([30, 5] + [0] * 10 + [0, 0, 4, 1], "long tail"),
+])
+def test_classify_distribution(bins, expected):
+    assert classify_distribution(bins) == expected
+
+
+def test_log_imbalance_table(imbalance):
+    df = log_imbalance_table(imbalance).df
+    assert list(df.columns) == ["File", "Module", "Units", "Max Time",
+                                "Max/Mean", "Max Bytes", "Slowest (rank)",
+                                "Shape"]
+    assert df["Units"].iloc[0] == "2 ranks"
+    assert df["Max Bytes"].iloc[0] == "7.81 KiB"
+
+
+def test_imbalance_summary_section(tmpdir):
+    log_path = get_log_path("imbalance.darshan")
+    with tmpdir.as_cwd():
+        with mock.patch("sys.argv", ["", log_path, "--output=imbalance.html"]):
+            summary.main()
+        with open("imbalance.html") as html_report:
+            report_str = html_report.read()
+    assert "Shared File Imbalance" in report_str
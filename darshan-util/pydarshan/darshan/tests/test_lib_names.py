@@ -0,0 +1,98 @@
+import darshan
+from darshan.lib.names import NameTable, as_record_ids, path_root, path_roots
+from darshan.log_utils import get_log_path
+
+import numpy as np
+import pandas as pd
+from numpy.testing import assert_array_equal
+
+import pytest
+
+
+@pytest.mark.parametrize("file_paths", [
+    [],
+    ["/scratch1/scratchdirs/glock/testFile.00000046"],
+    ["/home/user/a", "/home", "/", "//file", "///x/y"],
+    ["/home//user/a", "/./home/a", "/home/./a", "/home/."],
+    ["<STDOUT>", "<STDERR>", "12345", "relative/path", "file.dat"],
+])
+def test_path_roots(file_paths):
+    # the vectorized implementation must agree with the
+    # per path one, including its corner cases
+    expected = [path_root(path) for path in file_paths]
+    assert list(path_roots(file_paths)) == expected
+
+
+@pytest.mark.parametrize("ids, expected", [
+    (np.array([1, 2], dtype=np.uint64), [1, 2]),
+    (np.array([-1, 2], dtype=np.int64), [2**64 - 1, 2]),
+    ([2**63 + 5, 3], [2**63 + 5, 3]),
+])
+def test_as_record_ids(ids, expected):
+    actual = as_record_ids(ids)
+    assert actual.dtype == np.uint64
+    assert [int(i) for i in actual] == expected
+
+
+@pytest.fixture
+def name_table():
+    return NameTable({2**64 - 1: "/scratch/big",
+                      1: "/home/a",
+                      2**63 + 3: "/home/b",
+                      7: "<STDOUT>"})
+
+
+def test_name_table(name_table):
+    assert len(name_table) == 4
+    ids = [7, 2**63 + 3, 1, 12, 2**64 - 1]
+    paths = name_table.paths(ids)
+    assert isinstance(paths, pd.Categorical)
+    assert list(paths[[0, 1, 2, 4]]) == ["<STDOUT>", "/home/b", "/home/a",
+                                         "/scratch/big"]
+    assert pd.isna(paths[3])
+    roots = name_table.roots(ids)
+    assert list(roots[[1, 2, 4]]) == ["/home", "/home", "/scratch"]
+    assert name_table.unique_roots(ids) == ["<STDOUT>", "/home", "/scratch"]
+
+
+def test_name_table_signed_ids(name_table):
+    # pandas may hold ids that do not fit in an int64 as signed integers
+    ids = np.array([2**64 - 1, 2**63 + 3], dtype=np.uint64).view(np.int64)
+    assert list(name_table.paths(ids)) == ["/scratch/big", "/home/b"]
+
+
+def test_name_table_float_ids(name_table):
+    # ids that went through a float column are still resolved
+    ids = np.array([1, 2**63 + 3, 5], dtype=np.float64)
+    paths = name_table.paths(ids)
+    assert list(paths[:2]) == ["/home/a", "/home/b"]
+    assert pd.isna(paths[2])
+
+
+def test_name_table_empty():
+    table = NameTable({})
+    assert len(table) == 0
+    assert_array_equal(table.positions([1, 2]), [-1, -1])
+    assert pd.isna(table.paths([1])).all()
+    assert table.unique_roots([1, 2]) == []
+    assert len(table.paths([])) == 0
+
+
+def test_report_name_table():
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    with darshan.DarshanReport(log_path) as report:
+        table = report.name_table
+        # the table is built once per report
+        assert report.name_table is table
+        ids = list(report.name_records.keys())
+        assert list(table.paths(ids)) == list(report.name_records.values())
+        # uint64 ids above the int64 range resolve from counter dataframes
+        df = report.records["POSIX"].to_df()["counters"]
+        assert (as_record_ids(df["id"]) > 2**63).any()
+        names = table.paths(df["id"])
+        assert not pd.isna(names).any()
+        assert list(names) == [report.name_records[int(i)]
+                               for i in as_record_ids(df["id"])]
+        # the table is rebuilt when name records are replaced
+        report.name_records = dict(report.name_records)
+        assert report.name_table is not table
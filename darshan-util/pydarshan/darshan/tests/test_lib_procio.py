@@ -0,0 +1,69 @@
+from unittest import mock
+
+import darshan
+from darshan.cli import summary
+from darshan.lib.procio import cache_hit_ratio, log_procio_summary_table
+from darshan.log_utils import get_log_path
+
+import pytest
+
+
+@pytest.fixture
+def procio_record():
+    # procio.darshan was generated by a single process that read
+    # 4 MiB of a file with O_DIRECT and then the same 4 MiB again
+    # through the page cache
+    log_path = get_log_path("procio.darshan")
+    with darshan.DarshanReport(log_path, read_all=True) as report:
+        assert "PROCIO" in report.modules
+        records = report.records["PROCIO"].to_dict()
+    assert len(records) == 1
+    return records[0]
+
+
+def test_procio_counters(procio_record):
+    counters = procio_record["counters"]
+    fcounters = procio_record["fcounters"]
+    assert counters["PROCIO_READ_BYTES"] == 4194304
+    assert counters["PROCIO_RCHAR"] >= 2 * 4194304
+    assert counters["PROCIO_SAMPLES"] >= 2
+    assert counters["PROCIO_PROCS"] == 1
+    assert counters["PROCIO_CLK_TCK"] > 0
+    assert (fcounters["PROCIO_F_END_TIMESTAMP"] >=
+            fcounters["PROCIO_F_START_TIMESTAMP"])
+
+
+def test_cache_hit_ratio(procio_record):
+    assert cache_hit_ratio(procio_record["counters"]) == pytest.approx(0.5, abs=1e-3)
+
+
+@pytest.mark.parametrize("counters, expected", [
+    # no reads at all
+    ({"PROCIO_RCHAR": 0, "PROCIO_READ_BYTES": 0}, -1.0),
+    # storage counters unavailable
+    ({"PROCIO_RCHAR": 100, "PROCIO_READ_BYTES": -1}, -1.0),
+    # readahead pulled in more than was requested
+    ({"PROCIO_RCHAR": 100, "PROCIO_READ_BYTES": 400}, 0.0),
+    ({"PROCIO_RCHAR": 100, "PROCIO_READ_BYTES": 25}, 0.75),
+])
+def test_cache_hit_ratio_edge_cases(counters, expected):
+    assert cache_hit_ratio(counters) == pytest.approx(expected)
+
+
+def test_log_procio_summary_table(procio_record):
+    df = log_procio_summary_table(procio_record).df
+    values = df[0].to_dict()
+    assert values["bytes read from storage"] == "4.00 MiB"
+    assert values["read cache hit ratio"] == "50.00%"
+    assert len(df) == 8
+
+
+def test_procio_summary_section(tmpdir):
+    log_path = get_log_path("procio.darshan")
+    with tmpdir.as_cwd():
+        with mock.patch("sys.argv", ["", log_path, "--output=procio.html"]):
+            summary.main()
+        with open("procio.html") as html_report:
+            report_str = html_report.read()
+    assert "Page Cache" in report_str
+    assert "read cache hit ratio" in report_str
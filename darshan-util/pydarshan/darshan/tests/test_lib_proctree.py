@@ -0,0 +1,97 @@
+from unittest import mock
+
+import darshan.cli
+from darshan.lib.proctree import (process_info, read_process_info,
+                                  process_tree, critical_path, format_tree)
+from darshan.log_utils import get_log_path
+
+import pytest
+
+
+def _proc(pid, ppid, start, end, jobid=100, written=0, io_time=0.0,
+          forked=False, uid=1):
+    return {"path": f"/logs/{pid}-{start}.darshan", "exe": f"prog{pid}",
+            "uid": uid, "jobid": jobid, "nprocs": 1, "start": start,
+            "end": end, "pid": pid, "ppid": ppid, "forked": forked,
+            "bytes_read": 0, "bytes_written": written, "io_time": io_time}
+
+
+def test_process_info():
+    info = process_info(get_log_path("sample.darshan"))
+    assert info["exe"] == "vpicio_uni"
+    assert info["jobid"] == 4478544
+    assert info["nprocs"] == 2048
+    # neither the metadata nor the log name holds the pid
+    assert info["pid"] is None and info["ppid"] is None
+    assert not info["forked"]
+    assert info["end"] - info["start"] == 116
+    assert info["bytes_written"] > 0
+
+
+def test_read_process_info_errors(tmp_path):
+    bad = tmp_path / "bad.darshan"
+    bad.write_bytes(b"not a darshan log")
+    infos, errors = read_process_info([str(bad), get_log_path("sample.darshan")])
+    assert len(infos) == 1
+    assert [path for path, _ in errors] == [str(bad)]
+
+
+def test_process_tree():
+    # a shell (pid 10, parent not instrumented) forks 11 and spawns 12, and
+    # 12 forks 13; the logs come in no particular order
+    procs = [
+        _proc(13, 12, 4.0, 9.0, written=8, io_time=2.0, forked=True),
+        _proc(10, 1, 0.0, 6.0, written=1, io_time=0.5),
+        _proc(12, 10, 3.0, 5.0, jobid=12, written=4, io_time=1.0),
+        _proc(11, 10, 1.0, 2.0, written=2, forked=True),
+    ]
+    tree = process_tree(procs)
+    assert list(tree["pid"]) == [10, 11, 12, 13]
+    assert list(tree["parent"]) == [-1, 0, 0, 2]
+    assert list(tree["root"]) == [0, 0, 0, 0]
+    assert list(tree["depth"]) == [0, 1, 1, 2]
+    assert list(tree["subtree_procs"]) == [4, 1, 2, 1]
+    assert list(tree["subtree_bytes_written"]) == [15, 2, 12, 8]
+    assert list(tree["subtree_io_time"]) == [3.5, 0.0, 3.0, 2.0]
+    # the forked grandchild outlives everyone else
+    assert list(tree["subtree_end"]) == [9.0, 2.0, 9.0, 9.0]
+    assert list(tree["critical_path_time"]) == [9.0, 1.0, 6.0, 5.0]
+    assert critical_path(tree, 0) == [0, 2, 3]
+
+    text = format_tree(tree)
+    assert text.splitlines()[0] == "# job 100, uid 1"
+    assert "*     prog13 (pid 13, forked): 1 procs" in text
+    assert "  prog11 (pid 11, forked)" in text
+
+
+def test_process_tree_pid_reuse():
+    # pid 20 is reused: the child is linked to the latest process with its
+    # parent pid that started before it, and other users are ignored
+    procs = [
+        _proc(20, 1, 0.0, 1.0),
+        _proc(20, 1, 2.0, 5.0),
+        _proc(20, 1, 2.5, 5.0, uid=2),
+        _proc(21, 20, 3.0, 4.0),
+        _proc(22, 20, 3.5, 4.0, jobid=7),
+        _proc(23, None, 0.5, 1.0),
+    ]
+    tree = process_tree(procs)
+    rows = {(pid, start): i for i, (pid, start)
+            in enumerate(zip(tree["pid"], tree["start"]))}
+    assert tree.at[rows[(21, 3.0)], "parent"] == rows[(20, 2.0)]
+    assert tree.at[rows[(22, 3.5)], "parent"] == rows[(20, 2.0)]
+    assert tree.at[rows[(23, 0.5)], "parent"] == -1
+    assert (tree["parent"] == -1).sum() == 4
+
+
+def test_process_tree_empty():
+    assert process_tree([]).empty
+
+
+def test_cli(capsys):
+    with mock.patch("sys.argv", ["darshan", "proctree",
+                                 get_log_path("sample.darshan")]):
+        darshan.cli.main()
+    out = capsys.readouterr().out.splitlines()
+    assert out[0] == "# job 4478544, uid 69615"
+    assert out[1].startswith("* vpicio_uni (pid unknown): 1 procs")
@@ -0,0 +1,141 @@
+import shutil
+from unittest import mock
+
+import darshan
+import darshan.cli
+from darshan.lib.rollup import RollupStore, hist_bucket, summarize_log
+from darshan.log_utils import get_log_path
+
+import pytest
+
+
+LOGS = ["sample.darshan", "sample-dxt-simple.darshan", "procio.darshan"]
+
+
+@pytest.fixture
+def log_dir(tmp_path):
+    log_dir = tmp_path / "logs"
+    log_dir.mkdir()
+    for log in LOGS:
+        shutil.copy(get_log_path(log), log_dir / log)
+    return log_dir
+
+
+@pytest.fixture
+def store(tmp_path):
+    with RollupStore(str(tmp_path / "rollup.db")) as store:
+        yield store
+
+
+@pytest.mark.parametrize("value, expected", [
+    (0, 0), (0.5, 0), (1, 1), (2, 2), (3, 2), (4, 3), (1023, 10), (1024, 11),
+])
+def test_hist_bucket(value, expected):
+    assert hist_bucket(value) == expected
+
+
+def test_summarize_log():
+    summary = summarize_log(get_log_path("sample.darshan"), 86400)
+    assert summary["exe"] == "vpicio_uni"
+    assert summary["uid"] == 69615
+    assert summary["nprocs"] == 2048
+    assert summary["window"] % 86400 == 0
+    # counters are summed over all records of the log
+    with darshan.DarshanReport(get_log_path("sample.darshan")) as report:
+        df = report.records["POSIX"].to_df()["counters"]
+        assert (summary["counters"][("POSIX", "POSIX_OPENS")] ==
+                df["POSIX_OPENS"].sum())
+    # quantities that cannot be summed are left out
+    assert ("POSIX", "POSIX_MODE") not in summary["counters"]
+    assert ("POSIX", "POSIX_MAX_BYTE_WRITTEN") not in summary["counters"]
+    assert summary["filesystems"] == {
+        ("POSIX", "/scratch2", "lustre"): [1, 0, 2199023259968]}
+
+
+@pytest.mark.parametrize("jobs", [1, 2])
+def test_ingest_once(store, log_dir, tmp_path, jobs):
+    paths = [str(log_dir / log) for log in LOGS]
+    result = store.ingest(paths, jobs=jobs)
+    assert result == {"added": len(LOGS), "skipped": 0, "errors": []}
+    assert len(store) == len(LOGS)
+
+    # already rolled up, by path and by contents
+    moved = tmp_path / "moved.darshan"
+    shutil.copy(paths[0], moved)
+    result = store.ingest(paths + [str(moved)], jobs=jobs)
+    assert result == {"added": 0, "skipped": len(LOGS) + 1, "errors": []}
+    assert store.jobs()["logs"].sum() == len(LOGS)
+
+
+def test_ingest_error(store, tmp_path):
+    bad = tmp_path / "bad.darshan"
+    bad.write_bytes(b"not a darshan log")
+    result = store.ingest([str(bad), get_log_path("procio.darshan")])
+    assert result["added"] == 1
+    assert [path for path, _ in result["errors"]] == [str(bad)]
+    assert len(store) == 1
+
+
+def test_concurrent_stores(tmp_path, log_dir):
+    # two handles on the same rollup, as separate ingesting processes
+    # would have, each see the other's logs
+    path = str(tmp_path / "rollup.db")
+    with RollupStore(path) as a, RollupStore(path) as b:
+        assert a.ingest([str(log_dir / LOGS[0])])["added"] == 1
+        assert b.ingest([str(log_dir / log) for log in LOGS])["added"] == 2
+        assert len(a) == len(LOGS)
+
+
+def test_window_is_kept(tmp_path):
+    path = str(tmp_path / "rollup.db")
+    with RollupStore(path, window=3600) as store:
+        store.ingest([get_log_path("sample.darshan")])
+    with RollupStore(path) as store:
+        assert store.window == 3600
+        assert store.jobs()["window"].iloc[0] % 3600 == 0
+
+
+def test_queries(store):
+    store.ingest([get_log_path(log) for log in LOGS])
+    store.ingest([get_log_path("sample.darshan")])
+
+    jobs = store.jobs(by=["exe"])
+    assert list(jobs["exe"]) == sorted(jobs["exe"])
+    vpic = jobs[jobs["exe"] == "vpicio_uni"].iloc[0]
+    assert vpic["logs"] == 1
+    assert vpic["nprocs"] == 2048
+
+    df = store.counters("POSIX", ["POSIX_OPENS", "POSIX_F_WRITE_TIME"],
+                        exe="vpicio_uni")
+    assert list(df.columns) == ["exe", "uid", "window",
+                                "POSIX_F_WRITE_TIME", "POSIX_OPENS"]
+    assert df["POSIX_OPENS"].iloc[0] == 2049
+    assert store.counters("POSIX", exe="no-such-exe").empty
+
+    hist = store.histogram("nprocs", by=[])
+    assert hist["jobs"].sum() == len(LOGS)
+    assert set(hist.columns) == {"bucket", "low", "jobs"}
+    with pytest.raises(ValueError):
+        store.histogram("not-a-metric")
+
+    fs = store.filesystems(exe="vpicio_uni")
+    assert fs[["module", "mount", "fs_type", "files", "bytes_written"]].values.tolist() == [
+        ["POSIX", "/scratch2", "lustre", 1, 2199023259968]]
+
+    with pytest.raises(ValueError):
+        store.jobs(by=["uid; DROP TABLE logs"])
+
+
+def test_cli(tmp_path, log_dir, capsys):
+    path = str(tmp_path / "rollup.db")
+    with mock.patch("sys.argv", ["darshan", "rollup", path, "ingest",
+                                 "-j", "2", str(log_dir)]):
+        darshan.cli.main()
+    assert "added 3, skipped 0, failed 0" in capsys.readouterr().out
+
+    with mock.patch("sys.argv", ["darshan", "rollup", path, "counters",
+                                 "--csv", "--by", "exe", "POSIX", "POSIX_OPENS"]):
+        darshan.cli.main()
+    out = capsys.readouterr().out.splitlines()
+    assert out[0] == "exe,POSIX_OPENS"
+    assert "vpicio_uni,2049" in out
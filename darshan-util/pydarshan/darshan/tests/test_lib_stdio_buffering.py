@@ -0,0 +1,84 @@
+from unittest import mock
+
+import darshan
+from darshan.backend.cffi_backend import accumulate_records
+from darshan.cli import summary
+from darshan.lib.stdio_buffering import (log_stdio_buffering_table,
+                                         posix_ops_per_stdio_op)
+from darshan.log_utils import get_log_path
+
+import pytest
+
+
+def _stdio_records(log_name):
+    with darshan.DarshanReport(get_log_path(log_name), read_all=True) as report:
+        records = report.records["STDIO"].to_df()
+        nprocs = report.metadata["job"]["nprocs"]
+    return records, nprocs
+
+
+@pytest.fixture
+def stdio_buffering_records():
+    # stdio_buffering.darshan was generated by a single process that wrote
+    # 100 lines to an unbuffered stream, 1000 lines through a 1 KiB buffer
+    # set with setvbuf(), and then read the second file back with fgets()
+    records, _ = _stdio_records("stdio_buffering.darshan")
+    return records["counters"].set_index("id")
+
+
+def test_stdio_buffering_counters(stdio_buffering_records):
+    unbuffered = stdio_buffering_records[
+        stdio_buffering_records["STDIO_BUF_MODE"] == 3].iloc[0]
+    assert unbuffered["STDIO_WRITES"] == 100
+    assert unbuffered["STDIO_POSIX_WRITES"] == 100
+    assert unbuffered["STDIO_SETVBUFS"] == 1
+    assert unbuffered["STDIO_BUF_SIZE"] == 0
+
+    buffered = stdio_buffering_records[
+        stdio_buffering_records["STDIO_BUF_MODE"] == 1].iloc[0]
+    assert buffered["STDIO_WRITES"] == 1000
+    assert buffered["STDIO_BYTES_WRITTEN"] == 10000
+    # 10000 bytes drained from a 1 KiB buffer
+    assert buffered["STDIO_POSIX_WRITES"] == 10
+    # 10000 bytes refilled into the default 4 KiB read buffer
+    assert buffered["STDIO_POSIX_READS"] == 3
+
+
+@pytest.mark.parametrize("counters, expected", [
+    # no stdio operations at all
+    ({"STDIO_READS": 0, "STDIO_WRITES": 0, "STDIO_FLUSHES": 0,
+      "STDIO_POSIX_READS": 0, "STDIO_POSIX_WRITES": 0}, -1.0),
+    # log predates the STDIO_POSIX_* counters
+    ({"STDIO_READS": 10, "STDIO_WRITES": 0, "STDIO_FLUSHES": 0,
+      "STDIO_POSIX_READS": -1, "STDIO_POSIX_WRITES": -1}, -1.0),
+    ({"STDIO_READS": 10, "STDIO_WRITES": 5, "STDIO_FLUSHES": 5,
+      "STDIO_POSIX_READS": 1, "STDIO_POSIX_WRITES": 4}, 0.25),
+])
+def test_posix_ops_per_stdio_op(counters, expected):
+    assert posix_ops_per_stdio_op(counters) == pytest.approx(expected)
+
+
+@pytest.mark.parametrize("log_name, expected_calls, expected_ratio", [
+    ("stdio_buffering.darshan", "113", "0.0538"),
+    # STDIO records in older logs lack the buffering counters
+    ("sample.darshan", "N/A", "N/A"),
+])
+def test_log_stdio_buffering_table(log_name, expected_calls, expected_ratio):
+    records, nprocs = _stdio_records(log_name)
+    acc = accumulate_records(records, "STDIO", nprocs)
+    counters = acc.summary_record["counters"].iloc[0].to_dict()
+    values = log_stdio_buffering_table(counters).df[0].to_dict()
+    assert values["estimated system calls"] == expected_calls
+    assert values["system calls per stdio operation"] == expected_ratio
+    assert len(values) == 6
+
+
+def test_stdio_buffering_summary_section(tmpdir):
+    log_path = get_log_path("stdio_buffering.darshan")
+    with tmpdir.as_cwd():
+        with mock.patch("sys.argv", ["", log_path, "--output=stdio.html"]):
+            summary.main()
+        with open("stdio.html") as html_report:
+            report_str = html_report.read()
+    assert "Buffering" in report_str
+    assert "system calls per stdio operation" in report_str
@@ -0,0 +1,180 @@
+import darshan
+import darshan.backend.cffi_backend as backend
+from darshan.lib.timeline import (READ, WRITE, TimelineAggregator,
+                                  dxt_segment_chunks, dxt_timeline)
+from darshan.log_utils import get_log_path
+
+import numpy as np
+
+import pytest
+
+
+def _chunk(starts, ends, lengths, ids=None, ranks=None, ops=None, module=0):
+    n = len(starts)
+    return {"module": np.full(n, module, dtype=np.int8),
+            "id": np.asarray(ids if ids is not None else [1] * n, dtype=np.uint64),
+            "rank": np.asarray(ranks if ranks is not None else [0] * n, dtype=np.int64),
+            "op": np.asarray(ops if ops is not None else [WRITE] * n, dtype=np.int8),
+            "start_time": np.asarray(starts, dtype=np.float64),
+            "end_time": np.asarray(ends, dtype=np.float64),
+            "length": np.asarray(lengths, dtype=np.int64)}
+
+
+def _log_segments(log_path):
+    # total segments and bytes of a log, read without streaming
+    count = 0
+    nbytes = 0
+    with darshan.DarshanReport(log_path, read_all=False) as report:
+        for mod in ("DXT_POSIX", "DXT_MPIIO"):
+            report.mod_read_all_dxt_records(mod, dtype="dict", warnings=False)
+            for rec in report.records.get(mod, []):
+                for seg in rec["read_segments"] + rec["write_segments"]:
+                    count += 1
+                    nbytes += seg["length"]
+    return count, nbytes
+
+
+def test_merge_within_resolution():
+    agg = TimelineAggregator(resolution=1.0)
+    # the third segment is more than 1 s past the end of the first two,
+    # and unordered segments are merged all the same
+    agg.add(_chunk([0.5, 0.0, 3.0], [1.0, 0.2, 4.0], [2, 1, 4]))
+    df = agg.result()
+    assert df[["start", "end"]].values.tolist() == [[0.0, 1.0], [3.0, 4.0]]
+    assert df["count"].tolist() == [2, 1]
+    assert df["bytes"].tolist() == [3, 4]
+
+
+def test_merge_across_chunks():
+    agg = TimelineAggregator(resolution=0.5)
+    agg.add(_chunk([0.0, 1.0], [0.8, 1.2], [1, 1]))
+    agg.add(_chunk([1.5, 5.0], [2.0, 6.0], [1, 1]))
+    df = agg.result()
+    assert df[["start", "end", "count"]].values.tolist() == [[0.0, 2.0, 3],
+                                                              [5.0, 6.0, 1]]
+
+
+def test_lanes_not_merged():
+    # overlapping segments of different records, ranks and operations
+    # each stay in their own interval
+    agg = TimelineAggregator(resolution=10.0)
+    agg.add(_chunk([0.0] * 4, [1.0] * 4, [1] * 4,
+                   ids=[1, 2, 1, 1], ranks=[0, 0, 1, 0],
+                   ops=[WRITE, WRITE, WRITE, READ]))
+    agg.add(_chunk([0.0], [1.0], [1], module=1))
+    df = agg.result()
+    assert len(df) == 5
+    assert sorted(df["module"].unique()) == ["DXT_MPIIO", "DXT_POSIX"]
+    assert set(df["operation"]) == {"read", "write"}
+
+
+def test_large_ids():
+    agg = TimelineAggregator(resolution=1.0)
+    agg.add(_chunk([0.0], [1.0], [1], ids=[2**64 - 1]))
+    df = agg.result()
+    assert df["id"].dtype == np.uint64
+    assert int(df["id"].iloc[0]) == 2**64 - 1
+
+
+@pytest.mark.parametrize("resolution", [0.0, 0.01])
+def test_bounded_intervals(resolution):
+    # 10^5 disjoint segments on 2 lanes, streamed in chunks, are kept
+    # to at most max_intervals intervals by coarsening the resolution
+    max_intervals = 1000
+    agg = TimelineAggregator(resolution=resolution, max_intervals=max_intervals)
+    n = 100000
+    starts = np.arange(n, dtype=np.float64)
+    for first in range(0, n, 8192):
+        sl = slice(first, first + 8192)
+        agg.add(_chunk(starts[sl], starts[sl] + 0.5, np.ones(len(starts[sl])),
+                       ranks=np.arange(first, first + len(starts[sl])) % 2))
+        assert agg._size <= max_intervals
+    df = agg.result()
+    assert len(df) <= max_intervals
+    assert agg.resolution > resolution
+    assert df["count"].sum() == n
+    assert df["bytes"].sum() == n
+    assert df["start"].min() == 0.0
+    assert df["end"].max() == n - 0.5
+
+
+def test_empty():
+    agg = TimelineAggregator(resolution=1.0)
+    agg.add(_chunk([], [], []))
+    df = agg.result()
+    assert len(df) == 0
+    assert "operation" in df.columns
+
+
+@pytest.mark.parametrize("chunk_size", [1, 2, 1000])
+def test_dxt_segment_chunks(chunk_size):
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    chunks = list(dxt_segment_chunks(log_path, chunk_size=chunk_size))
+    assert all(0 < len(chunk["id"]) <= chunk_size for chunk in chunks)
+    count, nbytes = _log_segments(log_path)
+    assert sum(len(chunk["id"]) for chunk in chunks) == count
+    assert sum(int(chunk["length"].sum()) for chunk in chunks) == nbytes
+
+
+def test_log_get_dxt_segments():
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    log = backend.log_open(log_path)
+    rec = backend.log_get_dxt_segments(log, "DXT_POSIX")
+    backend.log_close(log)
+    log = backend.log_open(log_path)
+    expected = backend.log_get_dxt_record(log, "DXT_POSIX", dtype="dict")
+    backend.log_close(log)
+    assert rec["id"] == expected["id"]
+    assert rec["hostname"] == expected["hostname"]
+    for key in ("read_segments", "write_segments"):
+        assert len(rec[key]) == len(expected[key])
+        for seg, exp in zip(rec[key], expected[key]):
+            assert seg["offset"] == exp["offset"]
+            assert seg["length"] == exp["length"]
+            assert seg["start_time"] == exp["start_time"]
+            assert seg["end_time"] == exp["end_time"]
+
+
+def test_dxt_timeline():
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    with darshan.DarshanReport(log_path, read_all=False) as report:
+        df = dxt_timeline(report, width=100, chunk_size=1)
+        assert df.attrs["resolution"] == pytest.approx(
+            max(report.metadata["job"]["run_time"], 1.0) / 100)
+    count, nbytes = _log_segments(log_path)
+    assert df["count"].sum() == count
+    assert df["bytes"].sum() == nbytes
+    assert (df["start"] <= df["end"]).all()
+
+
+def test_create_dxttimeline_streaming():
+    darshan.enable_experimental()
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    with darshan.DarshanReport(log_path, read_all=False) as report:
+        ctx = report.create_dxttimeline_streaming(width=100)
+        assert report.summary["timeline"] is ctx
+    assert len(ctx["items"]) == 3
+    assert len(ctx["groups"]) == 3
+    groups = {group["id"] for group in ctx["groups"]}
+    assert all(item["group"] in groups for item in ctx["items"])
+    assert all("NEED FILENAME" not in group["content"]
+               for group in ctx["groups"])
+
+
+def test_unrecorded_fields():
+    # segments without times are dropped, and missing end times and
+    # lengths do not extend intervals or count bytes
+    agg = TimelineAggregator(resolution=0.0)
+    agg.add(_chunk([-1, 0.0, 2.0], [-1, -1, 3.0], [10, 20, -1]))
+    df = agg.result()
+    assert df[["start", "end", "count", "bytes"]].values.tolist() == [
+        [0.0, 0.0, 1, 20], [2.0, 3.0, 1, 0]]
+
+
+def test_dxt_timeline_fields():
+    # only the MPI-IO traces of this log have times
+    log_path = get_log_path("dxt_fields.darshan")
+    with darshan.DarshanReport(log_path, read_all=False) as report:
+        df = dxt_timeline(report, resolution=0.0)
+    assert set(df["module"]) == {"DXT_MPIIO"}
+    assert (df["end"] >= df["start"]).all()
@@ -37,3 +37,30 @@ def test_dxt_records(logfile, mod, expected_dict):
     log = backend.log_open(logfile)
     rec = backend.log_get_record(log, mod)
     assert rec == expected_dict
+
+
+def test_dxt_fields():
+    # the POSIX traces of this log only record offsets and lengths, and the
+    # MPI-IO traces record times at a precision of 1 microsecond
+    logfile = get_log_path("dxt_fields.darshan")
+    log = backend.log_open(logfile)
+    posix_segs = []
+    mpiio_segs = []
+    for mod, segs in (("DXT_POSIX", posix_segs), ("DXT_MPIIO", mpiio_segs)):
+        while True:
+            rec = backend.log_get_record(log, mod)
+            if rec is None:
+                break
+            segs.extend(rec["write_segments"] + rec["read_segments"])
+    backend.log_close(log)
+    assert posix_segs and mpiio_segs
+    for seg in posix_segs:
+        assert seg["offset"] >= 0
+        assert seg["length"] > 0
+        assert seg["start_time"] == -1
+        assert seg["end_time"] == -1
+    for seg in mpiio_segs:
+        assert seg["length"] > 0
+        assert 0 <= seg["start_time"] <= seg["end_time"]
+        for t in (seg["start_time"], seg["end_time"]):
+            assert t * 1e6 == pytest.approx(round(t * 1e6), abs=1e-6)
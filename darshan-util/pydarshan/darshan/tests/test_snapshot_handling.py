@@ -0,0 +1,73 @@
+import pytest
+import numpy as np
+from numpy.testing import assert_array_equal, assert_allclose
+
+import darshan
+import darshan.backend.cffi_backend as backend
+from darshan.log_utils import get_log_path
+
+
+@pytest.fixture
+def snapshot_report():
+    # snapshot.darshan was generated by the snapshot-test regression case
+    # with 2 ranks and 100 ms snapshot intervals capturing OPENS, STATS,
+    # FSYNCS, WRITES and BYTES_WRITTEN; each rank did 4 iterations, 300 ms
+    # apart, of an open, a 1000 byte pwrite, an fsync and an fstat of the
+    # same file, and rank 0 also created the file beforehand
+    log_path = get_log_path("snapshot.darshan")
+    with darshan.DarshanReport(log_path, read_all=True) as report:
+        assert "SNAPSHOT" in report.modules
+        yield report
+
+
+def test_snapshot_records(snapshot_report):
+    # only POSIX was used, so there is one time series per rank
+    assert list(snapshot_report.snapshots) == ["POSIX"]
+    df = snapshot_report.snapshots["POSIX"]
+    assert list(df.columns) == ["rank", "time", "SNAPSHOT_OPENS",
+                                "SNAPSHOT_STATS", "SNAPSHOT_FSYNCS",
+                                "SNAPSHOT_WRITES", "SNAPSHOT_BYTES_WRITTEN"]
+    assert df.attrs["interval_seconds"] == pytest.approx(0.1)
+    assert df.attrs["dropped"] == {0: 0, 1: 0}
+
+    for rank in (0, 1):
+        rank_df = df[df["rank"] == rank]
+        # one snapshot per iteration, in time order
+        assert len(rank_df) == 4
+        assert np.all(np.diff(rank_df["time"]) >= 0.2)
+        assert_array_equal(rank_df["SNAPSHOT_BYTES_WRITTEN"], [1000] * 4)
+        assert_array_equal(rank_df["SNAPSHOT_FSYNCS"], [1] * 4)
+        assert_array_equal(rank_df["SNAPSHOT_STATS"], [1] * 4)
+        # intervals start on multiples of the interval length
+        assert_allclose(rank_df["time"] / 0.1, np.round(rank_df["time"] / 0.1),
+                        atol=1e-3)
+
+    # rank 0 also created the file in its first interval
+    assert df.loc[df["rank"] == 0, "SNAPSHOT_OPENS"].tolist() == [2, 1, 1, 1]
+
+
+def test_snapshot_totals_match_counters(snapshot_report):
+    # with no snapshots dropped, the snapshots add up to the record totals
+    df = snapshot_report.snapshots["POSIX"]
+    counters = snapshot_report.records["POSIX"].to_df()["counters"]
+    for name in ("OPENS", "STATS", "FSYNCS", "WRITES", "BYTES_WRITTEN"):
+        assert df[f"SNAPSHOT_{name}"].sum() == counters[f"POSIX_{name}"].sum()
+
+
+def test_snapshot_backend_record():
+    log_path = get_log_path("snapshot.darshan")
+    log = backend.log_open(log_path)
+    try:
+        rec = backend.log_get_record(log, "SNAPSHOT")
+        assert rec["counters"] == ["SNAPSHOT_OPENS", "SNAPSHOT_STATS",
+                                   "SNAPSHOT_FSYNCS", "SNAPSHOT_WRITES",
+                                   "SNAPSHOT_BYTES_WRITTEN"]
+        assert rec["deltas"].shape == (len(rec["times"]), 5)
+        assert rec["dropped"] == 0
+    finally:
+        backend.log_close(log)
+
+
+def test_snapshot_not_in_generic_records(snapshot_report):
+    # snapshot records are variable size and are only exposed as time series
+    assert "SNAPSHOT" not in snapshot_report.records
@@ -98,13 +98,13 @@ def test_main_with_args(tmpdir, argv):
 
 @pytest.mark.parametrize(
     "argv, expected_img_count, expected_table_count", [
-        (["noposix.darshan"], 3, 4),
-        (["noposix.darshan", "--output=test.html"], 3, 4),
+        (["noposix.darshan"], 3, 5),
+        (["noposix.darshan", "--output=test.html"], 3, 5),
         (["sample-dxt-simple.darshan"], 7, 8),
         (["sample-dxt-simple.darshan", "--output=test.html"], 7, 8),
         (["sample-dxt-simple.darshan", "--enable_dxt_heatmap"], 9, 8),
         (["nonmpi_dxt_anonymized.darshan"], 6, 7),
-        (["ior_hdf5_example.darshan"], 10, 11),
+        (["ior_hdf5_example.darshan"], 10, 12),
         ([None], 0, 0),
     ]
 )
@@ -625,3 +625,55 @@ def test_issue_717():
             fig_args=dict(report=report),
         )
     assert not "alt= width" in fig.fig_html
+
+
+def test_parallel_render_matches_serial():
+    # figures rendered in worker processes should be identical to
+    # those rendered serially, and keep their registration order
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    serial = summary.ReportData(log_path=log_path)
+    parallel = summary.ReportData(log_path=log_path, jobs=3)
+    assert len(serial.figures) == len(parallel.figures)
+    for serial_fig, parallel_fig in zip(serial.figures, parallel.figures):
+        assert serial_fig.fig_title == parallel_fig.fig_title
+        assert serial_fig.fig_html == parallel_fig.fig_html
+
+
+def test_figure_cache(tmpdir):
+    log_path = get_log_path("sample-dxt-simple.darshan")
+    cache_dir = str(tmpdir.join("cache"))
+    first = summary.ReportData(log_path=log_path, cache_dir=cache_dir)
+    rendered = [fig for fig in first.figures if fig.fig_func]
+    assert len(os.listdir(cache_dir)) == len(rendered)
+
+    # a second report for the same log is built entirely from the cache
+    with mock.patch.object(summary.ReportFigure, "generate_fig",
+                           side_effect=AssertionError("cache miss")):
+        second = summary.ReportData(log_path=log_path, cache_dir=cache_dir)
+    for first_fig, second_fig in zip(first.figures, second.figures):
+        assert first_fig.fig_html == second_fig.fig_html
+
+    # a different log does not reuse the cached figures
+    other_path = get_log_path("noposix.darshan")
+    summary.ReportData(log_path=other_path, cache_dir=cache_dir)
+    assert len(os.listdir(cache_dir)) > len(rendered)
+
+
+def test_figure_cache_key():
+    # the key depends on the log and on the figure parameters
+    fig_args = dict(report=None, mod="POSIX", record=pd.DataFrame({"a": [1, 2]}))
+    fig = summary.ReportFigure(
+        section_title="Section",
+        fig_title="Title",
+        fig_func=plot_with_report,
+        fig_args=fig_args,
+        defer=True,
+    )
+    assert fig.fig_html is None
+    key = fig.cache_key("log-digest")
+    assert key == fig.cache_key("log-digest")
+    assert key != fig.cache_key("other-digest")
+    fig.fig_args = dict(fig_args, mod="MPI-IO")
+    assert key != fig.cache_key("log-digest")
+    fig.fig_args = dict(fig_args, record=pd.DataFrame({"a": [1, 3]}))
+    assert key != fig.cache_key("log-digest")
@@ -248,11 +248,12 @@ int main(int argc, char **argv)
  */
 static void posix_set_dummy_record(void* buffer) {
     struct darshan_posix_file* pfile = buffer;
+    int i;
 
     /* This function must be updated (or at least checked) if the posix
      * module log format changes
      */
-    munit_assert_int(DARSHAN_POSIX_VER, ==, 4);
+    munit_assert_int(DARSHAN_POSIX_VER, ==, 8);
 
     pfile->base_rec.id = 15574190512568163195UL;
     pfile->base_rec.rank = 0;
@@ -335,6 +336,40 @@ static void posix_set_dummy_record(void* buffer) {
     pfile->counters[POSIX_SLOWEST_RANK] = 0;
     pfile->counters[POSIX_SLOWEST_RANK_BYTES] = 0;
 #endif
+    pfile->counters[POSIX_AIO_READS] = 2;
+    pfile->counters[POSIX_AIO_WRITES] = 2;
+    pfile->counters[POSIX_AIO_DIRECT_READS] = 2;
+    pfile->counters[POSIX_AIO_DIRECT_WRITES] = 0;
+    for(i = POSIX_DELTA_BACK_4G_PLUS; i <= POSIX_REUSE_8_16; i++)
+        pfile->counters[i] = 0;
+    pfile->counters[POSIX_DELTA_ZERO] = 14;
+    pfile->counters[POSIX_DELTA_FWD_4K_64K] = 2;
+    pfile->counters[POSIX_REUSE_1] = 3;
+    pfile->counters[POSIX_FADVISES] = 1;
+    pfile->counters[POSIX_FADVISE_DONTNEEDS] = 1;
+    pfile->counters[POSIX_FADVISE_BYTES] = 4096;
+    pfile->counters[POSIX_MADVISES] = -1;
+    pfile->counters[POSIX_MADVISE_BYTES] = -1;
+    pfile->counters[POSIX_READAHEADS] = 0;
+    pfile->counters[POSIX_READAHEAD_BYTES] = 0;
+    pfile->counters[POSIX_FALLOCATES] = 1;
+    pfile->counters[POSIX_FALLOCATE_BYTES] = 1048576;
+    pfile->counters[POSIX_TRUNCATES] = 1;
+    pfile->counters[POSIX_TRUNCATES_TO_ZERO] = 1;
+    pfile->counters[POSIX_SYNC_FILE_RANGES] = 0;
+    pfile->counters[POSIX_SYNC_FILE_RANGE_BYTES] = 0;
+    pfile->counters[POSIX_OPENS_DIRECT] = 2;
+    pfile->counters[POSIX_OPENS_SYNC] = 0;
+    pfile->counters[POSIX_OPENS_DSYNC] = 0;
+    pfile->counters[POSIX_OPENS_APPEND] = 0;
+    pfile->counters[POSIX_OPENS_TRUNC] = 1;
+    pfile->counters[POSIX_OPENS_CREAT] = 1;
+    pfile->counters[POSIX_SETFLS] = 0;
+    pfile->counters[POSIX_DIRECT_READS] = 2;
+    pfile->counters[POSIX_DIRECT_WRITES] = 0;
+    pfile->counters[POSIX_DIRECT_UNALIGNED_READS] = 1;
+    pfile->counters[POSIX_DIRECT_UNALIGNED_WRITES] = 0;
+    pfile->counters[POSIX_DIRECT_FAILURES] = 0;
 
     pfile->fcounters[POSIX_F_OPEN_START_TIMESTAMP] = 0.008787;
     pfile->fcounters[POSIX_F_READ_START_TIMESTAMP] = 0.079433;
@@ -360,6 +395,12 @@ static void posix_set_dummy_record(void* buffer) {
 #endif
     pfile->fcounters[POSIX_F_VARIANCE_RANK_TIME] = 0.000090;
     pfile->fcounters[POSIX_F_VARIANCE_RANK_BYTES] = 0.000000;
+    pfile->fcounters[POSIX_F_FADVISE_TIME] = 0.000012;
+    pfile->fcounters[POSIX_F_MADVISE_TIME] = -1;
+    pfile->fcounters[POSIX_F_READAHEAD_TIME] = 0;
+    pfile->fcounters[POSIX_F_FALLOCATE_TIME] = 0.000150;
+    pfile->fcounters[POSIX_F_TRUNCATE_TIME] = 0.000020;
+    pfile->fcounters[POSIX_F_SYNC_FILE_RANGE_TIME] = 0;
 
     return;
 }
@@ -373,7 +414,7 @@ static void stdio_set_dummy_record(void* buffer) {
     /* This function must be updated (or at least checked) if the stdio
      * module log format changes
      */
-    munit_assert_int(DARSHAN_STDIO_VER, ==, 2);
+    munit_assert_int(DARSHAN_STDIO_VER, ==, 3);
 
     sfile->base_rec.id = 552491373643638544UL;
     sfile->base_rec.rank = 0;
@@ -392,6 +433,11 @@ static void stdio_set_dummy_record(void* buffer) {
     sfile->counters[STDIO_FASTEST_RANK_BYTES] = 0;
     sfile->counters[STDIO_SLOWEST_RANK] = 0;
     sfile->counters[STDIO_SLOWEST_RANK_BYTES] = 0;
+    sfile->counters[STDIO_SETVBUFS] = 0;
+    sfile->counters[STDIO_BUF_MODE] = STDIO_BUF_MODE_FULL;
+    sfile->counters[STDIO_BUF_SIZE] = 4096;
+    sfile->counters[STDIO_POSIX_READS] = 0;
+    sfile->counters[STDIO_POSIX_WRITES] = 4096;
 
     sfile->fcounters[STDIO_F_META_TIME] = 0.000126;
     sfile->fcounters[STDIO_F_WRITE_TIME] = 0.008228;
@@ -422,7 +468,7 @@ static void mpiio_set_dummy_record(void* buffer)
     /* This function must be updated (or at least checked) if the mpiio
      * module log format changes
      */
-    munit_assert_int(DARSHAN_MPIIO_VER, ==, 3);
+    munit_assert_int(DARSHAN_MPIIO_VER, ==, 4);
 
     mfile->base_rec.id = 15574190512568163195UL;
     mfile->base_rec.rank = 0;
@@ -512,6 +558,12 @@ static void mpiio_set_dummy_record(void* buffer)
     mfile->fcounters[MPIIO_F_VARIANCE_RANK_TIME] = 0;
     mfile->fcounters[MPIIO_F_VARIANCE_RANK_BYTES] = 0;
 #endif
+    mfile->counters[MPIIO_NB_READ_COMPLETIONS] = 0;
+    mfile->counters[MPIIO_NB_WRITE_COMPLETIONS] = 4;
+    mfile->fcounters[MPIIO_F_NB_READ_TIME] = 0;
+    mfile->fcounters[MPIIO_F_NB_WRITE_TIME] = 0.050000;
+    mfile->fcounters[MPIIO_F_NB_WAIT_TIME] = 0.020000;
+    mfile->fcounters[MPIIO_F_NB_OVERLAP_TIME] = 0.030000;
 
     return;
 }
@@ -528,7 +580,7 @@ static void posix_validate_double_dummy_record(void* buffer, struct darshan_deri
     /* This function must be updated (or at least checked) if the posix
      * module log format changes
      */
-    munit_assert_int(DARSHAN_POSIX_VER, ==, 4);
+    munit_assert_int(DARSHAN_POSIX_VER, ==, 8);
 
     /* check base record */
     if(shared_file_flag)
@@ -543,6 +595,22 @@ static void posix_validate_double_dummy_record(void* buffer, struct darshan_deri
     munit_assert_int64(pfile->counters[POSIX_MMAPS], ==, -1);
     /* stay set */
     munit_assert_int64(pfile->counters[POSIX_MODE], ==, 436);
+    /* double */
+    munit_assert_int64(pfile->counters[POSIX_AIO_READS], ==, 4);
+    munit_assert_int64(pfile->counters[POSIX_AIO_DIRECT_READS], ==, 4);
+    munit_assert_int64(pfile->counters[POSIX_AIO_DIRECT_WRITES], ==, 0);
+    munit_assert_int64(pfile->counters[POSIX_DELTA_ZERO], ==, 28);
+    munit_assert_int64(pfile->counters[POSIX_DELTA_FWD_4K_64K], ==, 4);
+    munit_assert_int64(pfile->counters[POSIX_DELTA_BACK_0_4K], ==, 0);
+    munit_assert_int64(pfile->counters[POSIX_REUSE_1], ==, 6);
+    munit_assert_int64(pfile->counters[POSIX_FADVISE_DONTNEEDS], ==, 2);
+    munit_assert_int64(pfile->counters[POSIX_FALLOCATE_BYTES], ==, 2097152);
+    munit_assert_int64(pfile->counters[POSIX_TRUNCATES_TO_ZERO], ==, 2);
+    /* stay set at -1 */
+    munit_assert_int64(pfile->counters[POSIX_MADVISES], ==, -1);
+    /* double */
+    munit_assert_int64(pfile->counters[POSIX_OPENS_DIRECT], ==, 4);
+    munit_assert_int64(pfile->counters[POSIX_DIRECT_UNALIGNED_READS], ==, 2);
 
     /* "fastest" behavior should change depending on if records are shared
      * or not
@@ -592,7 +660,7 @@ static void stdio_validate_double_dummy_record(void* buffer, struct darshan_deri
     /* This function must be updated (or at least checked) if the stdio
      * module log format changes
      */
-    munit_assert_int(DARSHAN_STDIO_VER, ==, 2);
+    munit_assert_int(DARSHAN_STDIO_VER, ==, 3);
 
     /* check base record */
     if(shared_file_flag)
@@ -607,6 +675,10 @@ static void stdio_validate_double_dummy_record(void* buffer, struct darshan_deri
     munit_assert_int64(sfile->counters[STDIO_MAX_BYTE_WRITTEN], ==, 16777215);
     /* double */
     munit_assert_int64(sfile->counters[STDIO_BYTES_WRITTEN], ==, 33554432);
+    munit_assert_int64(sfile->counters[STDIO_POSIX_WRITES], ==, 8192);
+    /* stay set */
+    munit_assert_int64(sfile->counters[STDIO_BUF_MODE], ==, STDIO_BUF_MODE_FULL);
+    munit_assert_int64(sfile->counters[STDIO_BUF_SIZE], ==, 4096);
 
     /* "fastest" behavior should change depending on if records are shared
      * or not
@@ -656,7 +728,7 @@ static void mpiio_validate_double_dummy_record(void* buffer, struct darshan_deri
     /* This function must be updated (or at least checked) if the mpiio
      * module log format changes
      */
-    munit_assert_int(DARSHAN_MPIIO_VER, ==, 3);
+    munit_assert_int(DARSHAN_MPIIO_VER, ==, 4);
 
     /* check base record */
     if(shared_file_flag)
@@ -687,6 +759,11 @@ static void mpiio_validate_double_dummy_record(void* buffer, struct darshan_deri
     /* variance should be cleared right now */
     munit_assert_int64(mfile->fcounters[MPIIO_F_VARIANCE_RANK_TIME], ==, 0);
 
+    /* double */
+    munit_assert_int64(mfile->counters[MPIIO_NB_WRITE_COMPLETIONS], ==, 8);
+    munit_assert_double_equal(mfile->fcounters[MPIIO_F_NB_WAIT_TIME], .040000, 6);
+    munit_assert_double_equal(mfile->fcounters[MPIIO_F_NB_OVERLAP_TIME], .060000, 6);
+
     /* check derived metrics */
     /* byte values should match regardless, just different values for count
      * depending on if the records refer to a shared file or not
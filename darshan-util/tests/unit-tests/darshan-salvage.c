@@ -0,0 +1,625 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include "munit/munit.h"
+
+#include <darshan-logutils.h>
+
+#define NRECS 64
+/* enough incompressible records for the POSIX region to span several
+ * compressed chunks
+ */
+#define LARGE_NRECS 4096
+#define MMAP_NAME_MEM 8192
+
+static MunitResult open_intact_log(const MunitParameter params[], void* data);
+static MunitResult open_truncated_log(const MunitParameter params[], void* data);
+static MunitResult salvage_truncated_log(const MunitParameter params[], void* data);
+static MunitResult verify_corrupt_log(const MunitParameter params[], void* data);
+static MunitResult read_corrupt_large_region(const MunitParameter params[], void* data);
+static void* test_context_setup(const MunitParameter params[], void* user_data);
+static void test_context_tear_down(void *data);
+
+static void write_zlib_fixture(const char *path);
+static void write_mmap_fixture(const char *path);
+static void write_large_fixture(const char *path);
+static void truncate_fixture(const char *path, const char *cut, const char *out_path);
+static void corrupt_fixture(const char *path, const char *region, const char *out_path);
+static int count_names(darshan_fd fd);
+static int count_posix_records(darshan_fd fd);
+
+
+/* test definition */
+static char* fixture_params[] = {"zlib", "mmap", NULL};
+static char* cut_params[] = {"names", "records", NULL};
+/* only compressed logs carry checksums */
+static char* checksum_fixture_params[] = {"zlib", NULL};
+static char* region_params[] = {"header", "job", "names", "records", NULL};
+static char* end_region_params[] = {"records-end", NULL};
+
+static MunitParameterEnum intact_params[]
+    = {{"fixture", fixture_params}, {NULL, NULL}};
+static MunitParameterEnum truncated_params[]
+    = {{"fixture", fixture_params}, {"cut", cut_params}, {NULL, NULL}};
+static MunitParameterEnum corrupt_params[]
+    = {{"fixture", checksum_fixture_params}, {"region", region_params},
+       {NULL, NULL}};
+static MunitParameterEnum corrupt_large_params[]
+    = {{"fixture", checksum_fixture_params}, {"region", end_region_params},
+       {NULL, NULL}};
+
+static MunitTest tests[]
+    = {{"/open-intact-log", open_intact_log,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE,
+        intact_params},
+       {"/open-truncated-log", open_truncated_log,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE,
+        truncated_params},
+       {"/salvage-truncated-log", salvage_truncated_log,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE,
+        truncated_params},
+       {"/verify-corrupt-log", verify_corrupt_log,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE,
+        corrupt_params},
+       {"/read-corrupt-large-region", read_corrupt_large_region,
+        test_context_setup, test_context_tear_down, MUNIT_TEST_OPTION_NONE,
+        corrupt_large_params},
+       {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL}};
+
+static const MunitSuite test_suite = {
+    "/darshan-salvage", tests, NULL, 1, MUNIT_SUITE_OPTION_NONE
+};
+
+struct test_context {
+    char dir[64];
+    char log_path[128];
+    char cut_path[128];
+    char out_path[128];
+    int mmap_flag;
+};
+
+static void* test_context_setup(const MunitParameter params[], void* user_data)
+{
+    (void) user_data;
+
+    const char* fixture = munit_parameters_get(params, "fixture");
+
+    struct test_context* ctx = calloc(1, sizeof(*ctx));
+    munit_assert_not_null(ctx);
+
+    strcpy(ctx->dir, "/tmp/darshan-salvage-XXXXXX");
+    munit_assert_not_null(mkdtemp(ctx->dir));
+    snprintf(ctx->log_path, sizeof(ctx->log_path), "%s/in.darshan", ctx->dir);
+    snprintf(ctx->cut_path, sizeof(ctx->cut_path), "%s/cut.darshan", ctx->dir);
+    snprintf(ctx->out_path, sizeof(ctx->out_path), "%s/out.darshan", ctx->dir);
+
+    ctx->mmap_flag = (strcmp(fixture, "mmap") == 0);
+    if(ctx->mmap_flag)
+        write_mmap_fixture(ctx->log_path);
+    else
+        write_zlib_fixture(ctx->log_path);
+
+    return ctx;
+}
+
+static void test_context_tear_down(void *data)
+{
+    struct test_context *ctx = (struct test_context*)data;
+
+    unlink(ctx->log_path);
+    unlink(ctx->cut_path);
+    unlink(ctx->out_path);
+    rmdir(ctx->dir);
+    free(ctx);
+}
+
+/* an undamaged log opens with every region intact and all of its data */
+static MunitResult open_intact_log(const MunitParameter params[], void* data)
+{
+    struct test_context* ctx = (struct test_context*)data;
+    struct darshan_log_damage damage;
+    struct darshan_job job;
+    darshan_fd fd;
+    int i;
+
+    fd = darshan_log_open_salvage(ctx->log_path, &damage);
+    munit_assert_not_null(fd);
+
+    munit_assert_int(damage.checksum_type, ==,
+        ctx->mmap_flag ? DARSHAN_NO_CHECKSUM : DARSHAN_CRC32_CHECKSUM);
+    munit_assert_int(damage.header_status, ==, DARSHAN_REGION_INTACT);
+    munit_assert_int(damage.job_status, ==, DARSHAN_REGION_INTACT);
+    munit_assert_int(damage.name_status, ==, DARSHAN_REGION_INTACT);
+    for(i = 0; i < DARSHAN_MAX_MODS; i++)
+        munit_assert_int(damage.mod_status[i], ==, DARSHAN_REGION_INTACT);
+
+    munit_assert_int(darshan_log_get_job(fd, &job), ==, 0);
+    munit_assert_int(job.nprocs, ==, 1);
+    munit_assert_int(count_names(fd), ==, NRECS);
+    /* the mmap fixture ends with a record that was never filled in */
+    munit_assert_int(count_posix_records(fd), ==,
+        ctx->mmap_flag ? NRECS + 1 : NRECS);
+
+    darshan_log_close(fd);
+
+    return MUNIT_OK;
+}
+
+/* a truncated log opens with the damaged regions flagged, and only the
+ * complete names and records ahead of the cut are returned
+ */
+static MunitResult open_truncated_log(const MunitParameter params[], void* data)
+{
+    struct test_context* ctx = (struct test_context*)data;
+    const char* cut = munit_parameters_get(params, "cut");
+    struct darshan_log_damage damage;
+    struct darshan_job job;
+    darshan_fd fd;
+    int n_names, n_recs;
+
+    truncate_fixture(ctx->log_path, cut, ctx->cut_path);
+
+    /* the log can no longer be read in full */
+    fd = darshan_log_open(ctx->cut_path);
+    munit_assert_not_null(fd);
+    munit_assert_int(count_posix_records(fd), <, NRECS);
+    darshan_log_close(fd);
+
+    fd = darshan_log_open_salvage(ctx->cut_path, &damage);
+    munit_assert_not_null(fd);
+    munit_assert_int(damage.job_status, ==, DARSHAN_REGION_INTACT);
+    munit_assert_int(darshan_log_get_job(fd, &job), ==, 0);
+
+    n_names = count_names(fd);
+    n_recs = count_posix_records(fd);
+    if(strcmp(cut, "names") == 0)
+    {
+        munit_assert_int(damage.name_status, ==, DARSHAN_REGION_TRUNCATED);
+        munit_assert_int(damage.mod_status[DARSHAN_POSIX_MOD], ==,
+            DARSHAN_REGION_INVALID);
+        munit_assert_int(n_names, >, 0);
+        munit_assert_int(n_names, <, NRECS);
+        munit_assert_int(n_recs, ==, 0);
+    }
+    else
+    {
+        munit_assert_int(damage.name_status, ==, DARSHAN_REGION_INTACT);
+        munit_assert_int(damage.mod_status[DARSHAN_POSIX_MOD], ==,
+            DARSHAN_REGION_TRUNCATED);
+        munit_assert_int(n_names, ==, NRECS);
+        munit_assert_int(n_recs, <, NRECS);
+        /* uncompressed records are recovered up to the last complete one */
+        if(ctx->mmap_flag)
+            munit_assert_int(n_recs, ==, (NRECS + 1) / 2);
+    }
+
+    darshan_log_close(fd);
+
+    return MUNIT_OK;
+}
+
+/* the darshan-salvage tool writes a valid log holding every recovered name
+ * and record, with the damaged module marked partial
+ */
+static MunitResult salvage_truncated_log(const MunitParameter params[], void* data)
+{
+    struct test_context* ctx = (struct test_context*)data;
+    const char* cut = munit_parameters_get(params, "cut");
+    struct darshan_log_damage damage;
+    struct darshan_job job;
+    char cmd[512];
+    darshan_fd fd;
+    int n_names, n_recs;
+
+    /* the tool is built alongside this test in the darshan-util directory */
+    if(access("./darshan-salvage", X_OK) != 0)
+        return MUNIT_SKIP;
+
+    truncate_fixture(ctx->log_path, cut, ctx->cut_path);
+
+    fd = darshan_log_open_salvage(ctx->cut_path, &damage);
+    munit_assert_not_null(fd);
+    n_names = count_names(fd);
+    n_recs = count_posix_records(fd);
+    darshan_log_close(fd);
+
+    snprintf(cmd, sizeof(cmd), "./darshan-salvage --output %s %s > /dev/null",
+        ctx->out_path, ctx->cut_path);
+    munit_assert_int(system(cmd), ==, 0);
+
+    /* the output log must read back in full */
+    fd = darshan_log_open(ctx->out_path);
+    munit_assert_not_null(fd);
+    munit_assert_int(darshan_log_get_job(fd, &job), ==, 0);
+    munit_assert_int(job.end_time_sec, >=, job.start_time_sec);
+    munit_assert_true(DARSHAN_MOD_FLAG_ISSET(fd->partial_flag, DARSHAN_POSIX_MOD));
+    munit_assert_int(count_names(fd), ==, n_names);
+    munit_assert_int(count_posix_records(fd), ==, n_recs);
+    darshan_log_close(fd);
+
+    return MUNIT_OK;
+}
+
+/* a log with a corrupted byte in one region is flagged by its checksums,
+ * and a regular read of that region fails rather than returning bad data
+ */
+static MunitResult verify_corrupt_log(const MunitParameter params[], void* data)
+{
+    struct test_context* ctx = (struct test_context*)data;
+    const char* region = munit_parameters_get(params, "region");
+    struct darshan_log_damage damage;
+    struct darshan_name_record_ref *hash = NULL;
+    struct darshan_job job;
+    darshan_fd fd;
+    int i;
+
+    munit_assert_int(darshan_log_verify(ctx->log_path, &damage), ==, 0);
+
+    corrupt_fixture(ctx->log_path, region, ctx->cut_path);
+
+    munit_assert_int(darshan_log_verify(ctx->cut_path, &damage), ==, 1);
+    munit_assert_int(damage.checksum_type, ==, DARSHAN_CRC32_CHECKSUM);
+    munit_assert_int(damage.header_status, ==, strcmp(region, "header") == 0 ?
+        DARSHAN_REGION_CORRUPT : DARSHAN_REGION_INTACT);
+    munit_assert_int(damage.job_status, ==, strcmp(region, "job") == 0 ?
+        DARSHAN_REGION_CORRUPT : DARSHAN_REGION_INTACT);
+    munit_assert_int(damage.name_status, ==, strcmp(region, "names") == 0 ?
+        DARSHAN_REGION_CORRUPT : DARSHAN_REGION_INTACT);
+    munit_assert_int(damage.mod_status[DARSHAN_POSIX_MOD], ==,
+        strcmp(region, "records") == 0 ?
+        DARSHAN_REGION_CORRUPT : DARSHAN_REGION_INTACT);
+    for(i = 0; i < DARSHAN_MAX_MODS; i++)
+    {
+        if(i != DARSHAN_POSIX_MOD)
+            munit_assert_int(damage.mod_status[i], ==, DARSHAN_REGION_INTACT);
+    }
+
+    fd = darshan_log_open(ctx->cut_path);
+    if(strcmp(region, "header") == 0)
+    {
+        munit_assert_null(fd);
+        return MUNIT_OK;
+    }
+    munit_assert_not_null(fd);
+    if(strcmp(region, "job") == 0)
+        munit_assert_int(darshan_log_get_job(fd, &job), <, 0);
+    else if(strcmp(region, "names") == 0)
+        munit_assert_int(darshan_log_get_namehash(fd, &hash), <, 0);
+    else
+        munit_assert_int(count_posix_records(fd), <, NRECS);
+    darshan_log_close(fd);
+
+    return MUNIT_OK;
+}
+
+/* a region too large to be decompressed in one pass is checked in full
+ * before any of it is returned, so damage near its end keeps even the
+ * first record from being read
+ */
+static MunitResult read_corrupt_large_region(const MunitParameter params[], void* data)
+{
+    struct test_context* ctx = (struct test_context*)data;
+    const char* region = munit_parameters_get(params, "region");
+    struct darshan_posix_file *file = NULL;
+    darshan_fd fd;
+    int count = 0;
+
+    write_large_fixture(ctx->log_path);
+
+    fd = darshan_log_open(ctx->log_path);
+    munit_assert_not_null(fd);
+    munit_assert_int(fd->mod_map[DARSHAN_POSIX_MOD].len, >, 1024*1024);
+    while(mod_logutils[DARSHAN_POSIX_MOD]->log_get_record(fd, (void **)&file) == 1)
+        count++;
+    munit_assert_int(count, ==, LARGE_NRECS);
+    darshan_log_close(fd);
+
+    corrupt_fixture(ctx->log_path, region, ctx->cut_path);
+
+    fd = darshan_log_open(ctx->cut_path);
+    munit_assert_not_null(fd);
+    munit_assert_int(mod_logutils[DARSHAN_POSIX_MOD]->log_get_record(fd,
+        (void **)&file), <, 0);
+    darshan_log_close(fd);
+    free(file);
+
+    return MUNIT_OK;
+}
+
+int main(int argc, char **argv)
+{
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
+
+/* fill in the POSIX record and name for the i'th file of a fixture */
+static void set_fixture_record(int i, struct darshan_posix_file *file,
+    char *name, int name_len)
+{
+    memset(file, 0, sizeof(*file));
+    file->base_rec.id = 1000 + i;
+    file->base_rec.rank = 0;
+    file->counters[POSIX_OPENS] = i + 1;
+    file->counters[POSIX_READS] = 7 * i;
+    file->counters[POSIX_BYTES_READ] = 4096 * i + 13;
+    file->fcounters[POSIX_F_READ_TIME] = 0.5 * i;
+    snprintf(name, name_len, "/salvage/test/file-%d", i);
+}
+
+/* write a complete, compressed log in the format written by darshan-core
+ * at shutdown
+ */
+static void write_zlib_fixture(const char *path)
+{
+    struct darshan_job job;
+    struct darshan_posix_file files[NRECS];
+    struct darshan_name_record_ref refs[NRECS];
+    struct darshan_name_record_ref *hash = NULL;
+    struct darshan_name_record_ref *ref;
+    char name[64];
+    char exe[] = "salvage-test";
+    darshan_fd fd;
+    int i;
+
+    memset(&job, 0, sizeof(job));
+    job.start_time_sec = 100;
+    job.end_time_sec = 200;
+    job.nprocs = 1;
+
+    for(i = 0; i < NRECS; i++)
+    {
+        set_fixture_record(i, &files[i], name, sizeof(name));
+        ref = &refs[i];
+        ref->name_record = malloc(sizeof(darshan_record_id) + strlen(name) + 1);
+        munit_assert_not_null(ref->name_record);
+        ref->name_record->id = files[i].base_rec.id;
+        strcpy(ref->name_record->name, name);
+        HASH_ADD(hlink, hash, name_record->id, sizeof(darshan_record_id), ref);
+    }
+
+    fd = darshan_log_create(path, DARSHAN_ZLIB_COMP, 0);
+    munit_assert_not_null(fd);
+    munit_assert_int(darshan_log_put_job(fd, &job), ==, 0);
+    munit_assert_int(darshan_log_put_exe(fd, exe), ==, 0);
+    munit_assert_int(darshan_log_put_mounts(fd, NULL, 0), ==, 0);
+    munit_assert_int(darshan_log_put_namehash(fd, hash), ==, 0);
+    for(i = 0; i < NRECS; i++)
+        munit_assert_int(mod_logutils[DARSHAN_POSIX_MOD]->log_put_record(fd,
+            &files[i]), ==, 0);
+    darshan_log_close(fd);
+
+    HASH_CLEAR(hlink, hash);
+    for(i = 0; i < NRECS; i++)
+        free(refs[i].name_record);
+}
+
+/* write a compressed log whose POSIX records hold random counters, so that
+ * the region does not shrink below the size of a single compressed chunk
+ */
+static void write_large_fixture(const char *path)
+{
+    struct darshan_job job;
+    struct darshan_posix_file file;
+    char exe[] = "salvage-test";
+    darshan_fd fd;
+    int i;
+
+    memset(&job, 0, sizeof(job));
+    job.start_time_sec = 100;
+    job.end_time_sec = 200;
+    job.nprocs = 1;
+
+    fd = darshan_log_create(path, DARSHAN_ZLIB_COMP, 0);
+    munit_assert_not_null(fd);
+    munit_assert_int(darshan_log_put_job(fd, &job), ==, 0);
+    munit_assert_int(darshan_log_put_exe(fd, exe), ==, 0);
+    munit_assert_int(darshan_log_put_mounts(fd, NULL, 0), ==, 0);
+    munit_assert_int(darshan_log_put_namehash(fd, NULL), ==, 0);
+    for(i = 0; i < LARGE_NRECS; i++)
+    {
+        munit_rand_memory(sizeof(file), (munit_uint8_t *)&file);
+        file.base_rec.id = 1000 + i;
+        file.base_rec.rank = 0;
+        munit_assert_int(mod_logutils[DARSHAN_POSIX_MOD]->log_put_record(fd,
+            &file), ==, 0);
+    }
+    darshan_log_close(fd);
+}
+
+/* write an uncompressed log laid out like the mmap log of a job that was
+ * killed before shutdown: the job end time is never set, the name record
+ * region is followed by unused space, and the POSIX region ends with a
+ * record that was allocated but not yet filled in
+ */
+static void write_mmap_fixture(const char *path)
+{
+    struct darshan_header *hdr;
+    struct darshan_job *job;
+    struct darshan_posix_file *files;
+    struct darshan_name_record *name_rec;
+    char name[64];
+    char *buf, *name_p;
+    size_t size;
+    int fdes;
+    int i;
+
+    size = sizeof(*hdr) + sizeof(*job) + DARSHAN_EXE_LEN + 1 + MMAP_NAME_MEM +
+        (NRECS + 1) * sizeof(struct darshan_posix_file);
+    buf = calloc(1, size);
+    munit_assert_not_null(buf);
+
+    hdr = (struct darshan_header *)buf;
+    job = (struct darshan_job *)(buf + sizeof(*hdr));
+    name_p = (char *)job + sizeof(*job) + DARSHAN_EXE_LEN + 1;
+    files = (struct darshan_posix_file *)(name_p + MMAP_NAME_MEM);
+
+    strcpy(hdr->version_string, DARSHAN_LOG_VERSION);
+    hdr->magic_nr = DARSHAN_MAGIC_NR;
+    hdr->comp_type = DARSHAN_NO_COMP;
+    hdr->name_map.off = name_p - buf;
+    hdr->mod_map[DARSHAN_POSIX_MOD].off = (char *)files - buf;
+    hdr->mod_map[DARSHAN_POSIX_MOD].len =
+        (NRECS + 1) * sizeof(struct darshan_posix_file);
+    hdr->mod_ver[DARSHAN_POSIX_MOD] = DARSHAN_POSIX_VER;
+
+    job->start_time_sec = 100;
+    job->nprocs = 1;
+    strcpy((char *)job + sizeof(*job), "salvage-test");
+
+    for(i = 0; i < NRECS; i++)
+    {
+        set_fixture_record(i, &files[i], name, sizeof(name));
+        name_rec = (struct darshan_name_record *)(name_p + hdr->name_map.len);
+        name_rec->id = files[i].base_rec.id;
+        strcpy(name_rec->name, name);
+        hdr->name_map.len += sizeof(darshan_record_id) + strlen(name) + 1;
+    }
+    munit_assert_int(hdr->name_map.len, <=, MMAP_NAME_MEM);
+
+    fdes = open(path, O_CREAT|O_WRONLY|O_TRUNC, 0644);
+    munit_assert_int(fdes, >=, 0);
+    munit_assert_int(write(fdes, buf, size), ==, size);
+    close(fdes);
+    free(buf);
+}
+
+/* copy a fixture, cutting it off halfway through the given region */
+static void truncate_fixture(const char *path, const char *cut, const char *out_path)
+{
+    struct darshan_log_map map;
+    darshan_fd fd;
+    char *buf;
+    int64_t size;
+    int fdes;
+
+    fd = darshan_log_open(path);
+    munit_assert_not_null(fd);
+    if(strcmp(cut, "names") == 0)
+        map = fd->name_map;
+    else
+        map = fd->mod_map[DARSHAN_POSIX_MOD];
+    darshan_log_close(fd);
+    size = map.off + map.len / 2;
+
+    buf = malloc(size);
+    munit_assert_not_null(buf);
+    fdes = open(path, O_RDONLY);
+    munit_assert_int(fdes, >=, 0);
+    munit_assert_int(read(fdes, buf, size), ==, size);
+    close(fdes);
+
+    fdes = open(out_path, O_CREAT|O_WRONLY|O_TRUNC, 0644);
+    munit_assert_int(fdes, >=, 0);
+    munit_assert_int(write(fdes, buf, size), ==, size);
+    close(fdes);
+    free(buf);
+}
+
+/* copy a fixture, flipping the bits of a byte in the given region; the
+ * header is altered in the version of an unused module, which leaves it
+ * readable, and "records-end" alters the last chunk of the POSIX region
+ */
+static void corrupt_fixture(const char *path, const char *region, const char *out_path)
+{
+    struct darshan_log_map map;
+    darshan_fd fd;
+    char *buf;
+    int64_t size, off;
+    int fdes;
+
+    fd = darshan_log_open(path);
+    munit_assert_not_null(fd);
+    if(strcmp(region, "job") == 0)
+        map = fd->job_map;
+    else if(strcmp(region, "names") == 0)
+        map = fd->name_map;
+    else
+        map = fd->mod_map[DARSHAN_POSIX_MOD];
+    darshan_log_close(fd);
+    if(strcmp(region, "header") == 0)
+        off = offsetof(struct darshan_header, mod_ver[DARSHAN_MAX_MODS-1]);
+    else if(strcmp(region, "records-end") == 0)
+        off = map.off + map.len - 64;
+    else
+        off = map.off + map.len / 2;
+
+    fdes = open(path, O_RDONLY);
+    munit_assert_int(fdes, >=, 0);
+    size = lseek(fdes, 0, SEEK_END);
+    munit_assert_int(off, <, size);
+    buf = malloc(size);
+    munit_assert_not_null(buf);
+    munit_assert_int(pread(fdes, buf, size, 0), ==, size);
+    close(fdes);
+
+    buf[off] ^= 0xff;
+
+    fdes = open(out_path, O_CREAT|O_WRONLY|O_TRUNC, 0644);
+    munit_assert_int(fdes, >=, 0);
+    munit_assert_int(write(fdes, buf, size), ==, size);
+    close(fdes);
+    free(buf);
+}
+
+/* count the name records of a log, checking that each is the expected name
+ * for its record id
+ */
+static int count_names(darshan_fd fd)
+{
+    struct darshan_name_record_ref *hash = NULL;
+    struct darshan_name_record_ref *ref, *tmp;
+    struct darshan_posix_file file;
+    char name[64];
+    int count = 0;
+
+    if(darshan_log_get_namehash(fd, &hash) < 0)
+        return(-1);
+
+    HASH_ITER(hlink, hash, ref, tmp)
+    {
+        set_fixture_record(ref->name_record->id - 1000, &file, name, sizeof(name));
+        munit_assert_string_equal(ref->name_record->name, name);
+        count++;
+
+        HASH_DELETE(hlink, hash, ref);
+        free(ref->name_record);
+        free(ref);
+    }
+
+    return(count);
+}
+
+/* count the POSIX records of a log, checking that each one that is filled
+ * in holds the expected counters for its record id
+ */
+static int count_posix_records(darshan_fd fd)
+{
+    struct darshan_posix_file *file = NULL;
+    struct darshan_posix_file expected;
+    char name[64];
+    int count = 0;
+
+    while(mod_logutils[DARSHAN_POSIX_MOD]->log_get_record(fd, (void **)&file) == 1)
+    {
+        count++;
+        if(file->base_rec.id == 0)
+            continue;
+
+        set_fixture_record(file->base_rec.id - 1000, &expected, name, sizeof(name));
+        munit_assert_int(memcmp(file->counters, expected.counters,
+            sizeof(expected.counters)), ==, 0);
+        munit_assert_double(file->fcounters[POSIX_F_READ_TIME], ==,
+            expected.fcounters[POSIX_F_READ_TIME]);
+    }
+    free(file);
+
+    return(count);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_CUSTOM_LOG_FORMAT_H
+#define __DARSHAN_CUSTOM_LOG_FORMAT_H
+
+/* current CUSTOM log format version */
+#define DARSHAN_CUSTOM_VER 1
+
+/* NOTE: each CUSTOM record is an application-defined counter, named by the
+ * application when it is registered (see darshan-custom.h).  A counter may
+ * be incremented by integer and/or floating point values; the two are kept
+ * separately.  Per-rank minimum/maximum values are only meaningful for
+ * counters registered by more than one rank.
+ */
+#define CUSTOM_COUNTERS \
+    /* sum of all integer increments */\
+    X(CUSTOM_INT_VALUE) \
+    /* number of integer increments */\
+    X(CUSTOM_INT_UPDATES) \
+    /* smallest integer value accumulated by a single rank */\
+    X(CUSTOM_INT_RANK_MIN) \
+    /* largest integer value accumulated by a single rank */\
+    X(CUSTOM_INT_RANK_MAX) \
+    /* number of floating point increments */\
+    X(CUSTOM_F_UPDATES) \
+    /* number of ranks that registered the counter */\
+    X(CUSTOM_RANKS) \
+    /* end of counters */\
+    X(CUSTOM_NUM_INDICES)
+
+#define CUSTOM_F_COUNTERS \
+    /* sum of all floating point increments */\
+    X(CUSTOM_F_VALUE) \
+    /* smallest floating point value accumulated by a single rank */\
+    X(CUSTOM_F_RANK_MIN) \
+    /* largest floating point value accumulated by a single rank */\
+    X(CUSTOM_F_RANK_MAX) \
+    /* timestamp of the first registration of the counter */\
+    X(CUSTOM_F_REGISTER_TIMESTAMP) \
+    /* end of counters */\
+    X(CUSTOM_F_NUM_INDICES)
+
+#define X(a) a,
+/* integer counters for the CUSTOM module */
+enum darshan_custom_indices
+{
+    CUSTOM_COUNTERS
+};
+
+/* floating point counters for the CUSTOM module */
+enum darshan_custom_f_indices
+{
+    CUSTOM_F_COUNTERS
+};
+#undef X
+
+/* the darshan_custom_record structure holds the value of a single
+ * application-defined counter:
+ *      - a darshan_base_record structure, which contains the record id & rank
+ *      - integer counters (integer value, update counts, per-rank extremes)
+ *      - floating point counters (floating point value, per-rank extremes,
+ *        registration timestamp)
+ */
+struct darshan_custom_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[CUSTOM_NUM_INDICES];
+    double fcounters[CUSTOM_F_NUM_INDICES];
+};
+
+#endif /* __DARSHAN_CUSTOM_LOG_FORMAT_H */
@@ -7,8 +7,8 @@
 #define __DARSHAN_DXT_LOG_FORMAT_H
 
 /* current DXT log format version */
-#define DXT_POSIX_VER 1
-#define DXT_MPIIO_VER 2
+#define DXT_POSIX_VER 2
+#define DXT_MPIIO_VER 3
 
 #define HOSTNAME_SIZE 64
 
@@ -26,6 +26,30 @@ typedef struct segment_info {
 #define X(a) a,
 #undef X
 
+/* segment_info fields, as flagged in a dxt_segment_format */
+#define DXT_SEG_OFFSET      0x1
+#define DXT_SEG_LENGTH      0x2
+#define DXT_SEG_START_TIME  0x4
+#define DXT_SEG_END_TIME    0x8
+#define DXT_SEG_ALL_FIELDS  0xf
+
+/* since DXT_POSIX_VER 2 and DXT_MPIIO_VER 3, the segments of a record are
+ * stored in a compact encoding, described by a dxt_segment_format stored
+ * between the dxt_file_record and its segments:
+ *      - only the fields flagged in 'fields' are stored, in segment_info
+ *        order; fields that are not stored read back as -1
+ *      - offsets, lengths and integer times take 4 bytes (unsigned), or
+ *        8 bytes (signed) if flagged in 'wide'
+ *      - times are doubles (in seconds) if 'time_res_ns' is 0, and are
+ *        otherwise integer multiples of 'time_res_ns' nanoseconds, with the
+ *        end time stored relative to the start time if both are stored
+ */
+struct dxt_segment_format {
+    uint32_t fields;
+    uint32_t wide;
+    uint32_t time_res_ns;
+};
+
 /* file record structure for DXT files. a record is created and stored for
  * every DXT file opened by the original application. For the DXT module,
  * the record includes:
@@ -9,7 +9,7 @@
 
 /* current HDF5 log format versions */
 #define DARSHAN_H5F_VER 3
-#define DARSHAN_H5D_VER 2
+#define DARSHAN_H5D_VER 3
 
 #define H5D_MAX_NDIMS 5
 
@@ -157,6 +157,20 @@
     X(H5D_FASTEST_RANK_BYTES) \
     X(H5D_SLOWEST_RANK) \
     X(H5D_SLOWEST_RANK_BYTES) \
+    /* size (in bytes) and number of hash table slots of the dataset's */\
+    /* raw data chunk cache (chunked datasets only) */\
+    X(H5D_CHUNK_CACHE_NBYTES) \
+    X(H5D_CHUNK_CACHE_NSLOTS) \
+    /* number of filters in the dataset's filter pipeline */\
+    X(H5D_FILTERS) \
+    /* flag indicating whether the filter pipeline compresses data */\
+    X(H5D_COMPRESSION) \
+    /* estimated number of chunks touched by reads and writes */\
+    X(H5D_CHUNKS_READ) \
+    X(H5D_CHUNKS_WRITTEN) \
+    /* number of reads/writes touching more chunk data than fits in the */\
+    /* chunk cache (or touching chunks larger than the cache) */\
+    X(H5D_CHUNK_CACHE_OVERFLOWS) \
     /* end of counters */\
     X(H5D_NUM_INDICES)
 
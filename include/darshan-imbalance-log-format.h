@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_IMBALANCE_LOG_FORMAT_H
+#define __DARSHAN_IMBALANCE_LOG_FORMAT_H
+
+/* current IMBALANCE log format version */
+#define DARSHAN_IMBALANCE_VER 1
+
+/* number of histogram bins for the distributions of time and bytes */
+#define IMBALANCE_NUM_BINS 16
+
+/* number of slowest units (nodes or ranks) recorded */
+#define IMBALANCE_NUM_SLOWEST 4
+
+/* NOTE: the distributions are taken over "units", which are either the
+ * nodes of the job (the default) or its individual ranks.  The I/O time of
+ * a node is that of its slowest rank, and its bytes are summed over its
+ * ranks.  Bin i of a histogram counts the units whose value falls within
+ * [i/IMBALANCE_NUM_BINS, (i+1)/IMBALANCE_NUM_BINS) of the largest value
+ * (the last bin includes the largest value itself).
+ */
+#define IMBALANCE_COUNTERS \
+    /* module of the shared record the distributions are taken from */\
+    X(IMBALANCE_MODULE) \
+    /* 1 if units are nodes, 0 if units are ranks */\
+    X(IMBALANCE_BY_NODE) \
+    /* number of units that accessed the shared record */\
+    X(IMBALANCE_UNITS) \
+    /* largest number of bytes read and written by a unit */\
+    X(IMBALANCE_MAX_BYTES) \
+    /* histogram of unit I/O (read, write and meta) time */\
+    X(IMBALANCE_TIME_BIN_0) \
+    X(IMBALANCE_TIME_BIN_1) \
+    X(IMBALANCE_TIME_BIN_2) \
+    X(IMBALANCE_TIME_BIN_3) \
+    X(IMBALANCE_TIME_BIN_4) \
+    X(IMBALANCE_TIME_BIN_5) \
+    X(IMBALANCE_TIME_BIN_6) \
+    X(IMBALANCE_TIME_BIN_7) \
+    X(IMBALANCE_TIME_BIN_8) \
+    X(IMBALANCE_TIME_BIN_9) \
+    X(IMBALANCE_TIME_BIN_10) \
+    X(IMBALANCE_TIME_BIN_11) \
+    X(IMBALANCE_TIME_BIN_12) \
+    X(IMBALANCE_TIME_BIN_13) \
+    X(IMBALANCE_TIME_BIN_14) \
+    X(IMBALANCE_TIME_BIN_15) \
+    /* histogram of unit bytes read and written */\
+    X(IMBALANCE_BYTES_BIN_0) \
+    X(IMBALANCE_BYTES_BIN_1) \
+    X(IMBALANCE_BYTES_BIN_2) \
+    X(IMBALANCE_BYTES_BIN_3) \
+    X(IMBALANCE_BYTES_BIN_4) \
+    X(IMBALANCE_BYTES_BIN_5) \
+    X(IMBALANCE_BYTES_BIN_6) \
+    X(IMBALANCE_BYTES_BIN_7) \
+    X(IMBALANCE_BYTES_BIN_8) \
+    X(IMBALANCE_BYTES_BIN_9) \
+    X(IMBALANCE_BYTES_BIN_10) \
+    X(IMBALANCE_BYTES_BIN_11) \
+    X(IMBALANCE_BYTES_BIN_12) \
+    X(IMBALANCE_BYTES_BIN_13) \
+    X(IMBALANCE_BYTES_BIN_14) \
+    X(IMBALANCE_BYTES_BIN_15) \
+    /* lowest rank of the slowest units, slowest first (-1 if none) */\
+    X(IMBALANCE_SLOWEST_1_RANK) \
+    X(IMBALANCE_SLOWEST_2_RANK) \
+    X(IMBALANCE_SLOWEST_3_RANK) \
+    X(IMBALANCE_SLOWEST_4_RANK) \
+    /* bytes read and written by the slowest units */\
+    X(IMBALANCE_SLOWEST_1_BYTES) \
+    X(IMBALANCE_SLOWEST_2_BYTES) \
+    X(IMBALANCE_SLOWEST_3_BYTES) \
+    X(IMBALANCE_SLOWEST_4_BYTES) \
+    /* end of counters */\
+    X(IMBALANCE_NUM_INDICES)
+
+#define IMBALANCE_F_COUNTERS \
+    /* largest I/O time of a unit */\
+    X(IMBALANCE_F_MAX_TIME) \
+    /* mean I/O time of the units */\
+    X(IMBALANCE_F_MEAN_TIME) \
+    /* I/O time of the slowest units */\
+    X(IMBALANCE_F_SLOWEST_1_TIME) \
+    X(IMBALANCE_F_SLOWEST_2_TIME) \
+    X(IMBALANCE_F_SLOWEST_3_TIME) \
+    X(IMBALANCE_F_SLOWEST_4_TIME) \
+    /* end of counters */\
+    X(IMBALANCE_F_NUM_INDICES)
+
+#define X(a) a,
+/* integer counters for the IMBALANCE module */
+enum darshan_imbalance_indices
+{
+    IMBALANCE_COUNTERS
+};
+
+/* floating point counters for the IMBALANCE module */
+enum darshan_imbalance_f_indices
+{
+    IMBALANCE_F_COUNTERS
+};
+#undef X
+
+/* the darshan_imbalance_record structure holds the distribution across
+ * nodes (or ranks) of the I/O time and bytes of a record shared by all
+ * ranks of the job, as observed by the shared record reduction of the
+ * POSIX, MPI-IO or STDIO module:
+ *      - a darshan_base_record structure, with the id of the shared record
+ *        (so that it shares its name) and a rank of -1
+ *      - integer counters (histograms, slowest units and their bytes)
+ *      - floating point counters (largest, mean and slowest unit times)
+ */
+struct darshan_imbalance_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[IMBALANCE_NUM_INDICES];
+    double fcounters[IMBALANCE_F_NUM_INDICES];
+};
+
+#endif /* __DARSHAN_IMBALANCE_LOG_FORMAT_H */
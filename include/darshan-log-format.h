@@ -24,7 +24,7 @@
  * log format version, NOT when a new version of a module record is
  * introduced -- we have module-specific versions to handle that
  */
-#define DARSHAN_LOG_VERSION "3.41"
+#define DARSHAN_LOG_VERSION "3.42"
 
 /* magic number for validating output files and checking byte order */
 #define DARSHAN_MAGIC_NR 6567223
@@ -64,6 +64,27 @@ struct darshan_log_map
     uint64_t len;
 };
 
+/* checksum method used on darshan log file regions */
+enum darshan_checksum_type
+{
+    DARSHAN_NO_CHECKSUM,
+    DARSHAN_CRC32_CHECKSUM,
+};
+
+/* checksums of each region of a Darshan log, computed over the data as
+ * stored in the file (i.e., in *compressed* terms), so that logs can be
+ * verified without being decompressed. The header checksum is computed
+ * over the header with this field zeroed.
+ */
+struct darshan_log_checksums
+{
+    uint32_t type;
+    uint32_t header;
+    uint32_t job;
+    uint32_t name;
+    uint32_t mod[DARSHAN_MAX_MODS];
+};
+
 /* the darshan header stores critical metadata needed for correctly
  * reading the contents of the corresponding Darshan log
  */
@@ -76,6 +97,8 @@ struct darshan_header
     struct darshan_log_map name_map;
     struct darshan_log_map mod_map[DARSHAN_MAX_MODS];
     uint32_t mod_ver[DARSHAN_MAX_MODS];
+    /* NOTE: region checksums added at log ver 3.42 */
+    struct darshan_log_checksums checksums;
 };
 
 /* job-level metadata stored for this application */
@@ -129,6 +152,11 @@ struct darshan_base_record
 #include "darshan-apmpi-log-format.h"
 #endif
 #include "darshan-heatmap-log-format.h"
+#include "darshan-procio-log-format.h"
+#include "darshan-nfs-log-format.h"
+#include "darshan-custom-log-format.h"
+#include "darshan-snapshot-log-format.h"
+#include "darshan-imbalance-log-format.h"
 
 /* X-macro for keeping module ordering consistent */
 /* NOTE: first val used to define module enum values,
@@ -175,7 +203,12 @@ struct darshan_base_record
     X(DARSHAN_MDHIM_MOD,    "MDHIM",      DARSHAN_MDHIM_VER,     &mdhim_logutils) \
     X(DARSHAN_APXC_MOD,     "APXC", 	  __APXC_VER,            __apxc_logutils) \
     X(DARSHAN_APMPI_MOD,    "APMPI",      __APMPI_VER,           __apmpi_logutils) \
-    X(DARSHAN_HEATMAP_MOD,  "HEATMAP",    DARSHAN_HEATMAP_VER,   &heatmap_logutils)
+    X(DARSHAN_HEATMAP_MOD,  "HEATMAP",    DARSHAN_HEATMAP_VER,   &heatmap_logutils) \
+    X(DARSHAN_PROCIO_MOD,   "PROCIO",     DARSHAN_PROCIO_VER,    &procio_logutils) \
+    X(DARSHAN_NFS_MOD,      "NFS",        DARSHAN_NFS_VER,       &nfs_logutils) \
+    X(DARSHAN_CUSTOM_MOD,   "CUSTOM",     DARSHAN_CUSTOM_VER,    &custom_logutils) \
+    X(DARSHAN_SNAPSHOT_MOD, "SNAPSHOT",   DARSHAN_SNAPSHOT_VER,  &snapshot_logutils) \
+    X(DARSHAN_IMBALANCE_MOD, "IMBALANCE", DARSHAN_IMBALANCE_VER, &imbalance_logutils)
 
 /* unique identifiers to distinguish between available darshan modules */
 /* NOTES: - valid ids range from [0...DARSHAN_MAX_MODS-1]
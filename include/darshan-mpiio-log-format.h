@@ -8,7 +8,7 @@
 #define __DARSHAN_MPIIO_LOG_FORMAT_H
 
 /* current MPI-IO log format version */
-#define DARSHAN_MPIIO_VER 3
+#define DARSHAN_MPIIO_VER 4
 
 /* TODO: maybe use a counter to track cases in which a derived datatype is used? */
 
@@ -87,6 +87,9 @@
     X(MPIIO_FASTEST_RANK_BYTES) \
     X(MPIIO_SLOWEST_RANK) \
     X(MPIIO_SLOWEST_RANK_BYTES) \
+    /* count of nonblocking reads/writes whose completion was observed */\
+    X(MPIIO_NB_READ_COMPLETIONS) \
+    X(MPIIO_NB_WRITE_COMPLETIONS) \
     /* end of counters */\
     X(MPIIO_NUM_INDICES)
 
@@ -124,6 +127,13 @@
     /* NOTE: for shared records only */\
     X(MPIIO_F_VARIANCE_RANK_TIME) \
     X(MPIIO_F_VARIANCE_RANK_BYTES) \
+    /* cumulative time nonblocking reads/writes were outstanding (post to completion) */\
+    X(MPIIO_F_NB_READ_TIME) \
+    X(MPIIO_F_NB_WRITE_TIME) \
+    /* cumulative time blocked in MPI_Wait/MPI_Test calls completing nonblocking I/O */\
+    X(MPIIO_F_NB_WAIT_TIME) \
+    /* cumulative time between posting nonblocking I/O and the call that completed it */\
+    X(MPIIO_F_NB_OVERLAP_TIME) \
     /* end of counters*/\
     X(MPIIO_F_NUM_INDICES)
 
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_NFS_LOG_FORMAT_H
+#define __DARSHAN_NFS_LOG_FORMAT_H
+
+/* current NFS log format version */
+#define DARSHAN_NFS_VER 1
+
+/* NOTE: NFS client statistics are kept by the kernel per mount, not per
+ * process, so all event, byte, and RPC counters are deltas between the
+ * /proc/self/mountstats snapshots taken at Darshan initialization and
+ * shutdown time and include activity by any process on the node that used
+ * the mount.  Counters that could not be determined (e.g., because the
+ * mount was remounted during the job) are set to -1.
+ */
+#define NFS_COUNTERS \
+    /* NFS protocol major version of the mount */\
+    X(NFS_VERSION) \
+    /* number of processes on the node that contributed to this record */\
+    X(NFS_PROCS) \
+    /* number of /proc/self/mountstats snapshots taken */\
+    X(NFS_SAMPLES) \
+    /* cached inode attribute revalidations */\
+    X(NFS_INODE_REVALIDATES) \
+    /* cached directory entry revalidations */\
+    X(NFS_DENTRY_REVALIDATES) \
+    /* page cache invalidations due to changed file data */\
+    X(NFS_DATA_INVALIDATES) \
+    /* attribute cache invalidations */\
+    X(NFS_ATTR_INVALIDATES) \
+    /* bytes read/written by applications through the page cache */\
+    X(NFS_NORMAL_READ_BYTES) \
+    X(NFS_NORMAL_WRITE_BYTES) \
+    /* bytes read/written by applications with O_DIRECT */\
+    X(NFS_DIRECT_READ_BYTES) \
+    X(NFS_DIRECT_WRITE_BYTES) \
+    /* bytes read from/written to the server by READ/WRITE RPCs */\
+    X(NFS_SERVER_READ_BYTES) \
+    X(NFS_SERVER_WRITE_BYTES) \
+    /* total RPCs issued, across all operation types */\
+    X(NFS_RPC_OPS) \
+    /* total RPC retransmissions */\
+    X(NFS_RPC_RETRANS) \
+    /* total major RPC timeouts */\
+    X(NFS_RPC_TIMEOUTS) \
+    /* total bytes sent/received by RPCs (including headers) */\
+    X(NFS_RPC_BYTES_SENT) \
+    X(NFS_RPC_BYTES_RECV) \
+    /* RPCs issued for file attribute retrievals */\
+    X(NFS_GETATTR_OPS) \
+    /* retransmissions of GETATTR RPCs */\
+    X(NFS_GETATTR_RETRANS) \
+    /* RPCs issued for file attribute updates */\
+    X(NFS_SETATTR_OPS) \
+    /* retransmissions of SETATTR RPCs */\
+    X(NFS_SETATTR_RETRANS) \
+    /* RPCs issued for path name lookups */\
+    X(NFS_LOOKUP_OPS) \
+    /* retransmissions of LOOKUP RPCs */\
+    X(NFS_LOOKUP_RETRANS) \
+    /* RPCs issued for access permission checks */\
+    X(NFS_ACCESS_OPS) \
+    /* retransmissions of ACCESS RPCs */\
+    X(NFS_ACCESS_RETRANS) \
+    /* RPCs issued for data reads */\
+    X(NFS_READ_OPS) \
+    /* retransmissions of READ RPCs */\
+    X(NFS_READ_RETRANS) \
+    /* RPCs issued for data writes */\
+    X(NFS_WRITE_OPS) \
+    /* retransmissions of WRITE RPCs */\
+    X(NFS_WRITE_RETRANS) \
+    /* RPCs issued for commits of unstable writes */\
+    X(NFS_COMMIT_OPS) \
+    /* retransmissions of COMMIT RPCs */\
+    X(NFS_COMMIT_RETRANS) \
+    /* RPCs issued for NFSv4 file opens */\
+    X(NFS_OPEN_OPS) \
+    /* retransmissions of OPEN RPCs */\
+    X(NFS_OPEN_RETRANS) \
+    /* RPCs issued for NFSv4 file closes */\
+    X(NFS_CLOSE_OPS) \
+    /* retransmissions of CLOSE RPCs */\
+    X(NFS_CLOSE_RETRANS) \
+    /* RPCs issued for file creations */\
+    X(NFS_CREATE_OPS) \
+    /* retransmissions of CREATE RPCs */\
+    X(NFS_CREATE_RETRANS) \
+    /* RPCs issued for file removals */\
+    X(NFS_REMOVE_OPS) \
+    /* retransmissions of REMOVE RPCs */\
+    X(NFS_REMOVE_RETRANS) \
+    /* RPCs issued for directory reads (including READDIRPLUS) */\
+    X(NFS_READDIR_OPS) \
+    /* retransmissions of READDIR RPCs */\
+    X(NFS_READDIR_RETRANS) \
+    /* end of counters */\
+    X(NFS_NUM_INDICES)
+
+#define NFS_F_COUNTERS \
+    /* timestamp of the earliest initial snapshot */\
+    X(NFS_F_START_TIMESTAMP) \
+    /* timestamp of the latest final snapshot */\
+    X(NFS_F_END_TIMESTAMP) \
+    /* highest RPC rate (RPCs per second) observed over any sampling interval */\
+    X(NFS_F_MAX_RPC_RATE) \
+    /* cumulative queue, round trip, and total execution time of all RPCs */\
+    X(NFS_F_RPC_QUEUE_TIME) \
+    X(NFS_F_RPC_RTT_TIME) \
+    X(NFS_F_RPC_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of GETATTR RPCs */\
+    X(NFS_F_GETATTR_QUEUE_TIME) \
+    X(NFS_F_GETATTR_RTT_TIME) \
+    X(NFS_F_GETATTR_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of SETATTR RPCs */\
+    X(NFS_F_SETATTR_QUEUE_TIME) \
+    X(NFS_F_SETATTR_RTT_TIME) \
+    X(NFS_F_SETATTR_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of LOOKUP RPCs */\
+    X(NFS_F_LOOKUP_QUEUE_TIME) \
+    X(NFS_F_LOOKUP_RTT_TIME) \
+    X(NFS_F_LOOKUP_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of ACCESS RPCs */\
+    X(NFS_F_ACCESS_QUEUE_TIME) \
+    X(NFS_F_ACCESS_RTT_TIME) \
+    X(NFS_F_ACCESS_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of READ RPCs */\
+    X(NFS_F_READ_QUEUE_TIME) \
+    X(NFS_F_READ_RTT_TIME) \
+    X(NFS_F_READ_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of WRITE RPCs */\
+    X(NFS_F_WRITE_QUEUE_TIME) \
+    X(NFS_F_WRITE_RTT_TIME) \
+    X(NFS_F_WRITE_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of COMMIT RPCs */\
+    X(NFS_F_COMMIT_QUEUE_TIME) \
+    X(NFS_F_COMMIT_RTT_TIME) \
+    X(NFS_F_COMMIT_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of OPEN RPCs */\
+    X(NFS_F_OPEN_QUEUE_TIME) \
+    X(NFS_F_OPEN_RTT_TIME) \
+    X(NFS_F_OPEN_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of CLOSE RPCs */\
+    X(NFS_F_CLOSE_QUEUE_TIME) \
+    X(NFS_F_CLOSE_RTT_TIME) \
+    X(NFS_F_CLOSE_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of CREATE RPCs */\
+    X(NFS_F_CREATE_QUEUE_TIME) \
+    X(NFS_F_CREATE_RTT_TIME) \
+    X(NFS_F_CREATE_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of REMOVE RPCs */\
+    X(NFS_F_REMOVE_QUEUE_TIME) \
+    X(NFS_F_REMOVE_RTT_TIME) \
+    X(NFS_F_REMOVE_EXEC_TIME) \
+    /* cumulative queue, round trip, and total execution time of READDIR RPCs */\
+    X(NFS_F_READDIR_QUEUE_TIME) \
+    X(NFS_F_READDIR_RTT_TIME) \
+    X(NFS_F_READDIR_EXEC_TIME) \
+    /* end of counters */\
+    X(NFS_F_NUM_INDICES)
+
+#define X(a) a,
+/* integer counters for the NFS module */
+enum darshan_nfs_indices
+{
+    NFS_COUNTERS
+};
+
+/* floating point counters for the NFS module */
+enum darshan_nfs_f_indices
+{
+    NFS_F_COUNTERS
+};
+#undef X
+
+/* the darshan_nfs_record structure encompasses the NFS client statistics
+ * of a single NFS mount, identified by its mount point.  One record is
+ * stored per mount for each node that ran the job:
+ *      - a darshan_base_record structure, which contains the record id & rank
+ *      - integer counters (events, bytes, and RPC counts)
+ *      - floating point counters (timestamps, sampled RPC rate, RPC times)
+ */
+struct darshan_nfs_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[NFS_NUM_INDICES];
+    double fcounters[NFS_F_NUM_INDICES];
+};
+
+#endif /* __DARSHAN_NFS_LOG_FORMAT_H */
@@ -8,8 +8,8 @@
 #define __DARSHAN_PNETCDF_LOG_FORMAT_H
 
 /* current PnetCDF log format version */
-#define DARSHAN_PNETCDF_FILE_VER 3
-#define DARSHAN_PNETCDF_VAR_VER 1
+#define DARSHAN_PNETCDF_FILE_VER 4
+#define DARSHAN_PNETCDF_VAR_VER 2
 
 #define PNETCDF_VAR_MAX_NDIMS 5
 
@@ -33,6 +33,12 @@
     X(PNETCDF_FILE_BYTES_WRITTEN) \
     /* count of file wait failures */\
     X(PNETCDF_FILE_WAIT_FAILURES) \
+    /* max number of nonblocking requests pending at once */\
+    X(PNETCDF_FILE_NB_MAX_PENDING) \
+    /* largest buffer size attached for buffered (bput) writes */\
+    X(PNETCDF_FILE_BUFFER_ATTACH_SIZE) \
+    /* max bytes of buffered (bput) writes pending at once */\
+    X(PNETCDF_FILE_BPUT_MAX_PENDING_BYTES) \
     /* end of counters */\
     X(PNETCDF_FILE_NUM_INDICES)
 
@@ -233,6 +239,11 @@
     X(PNETCDF_VAR_FASTEST_RANK_BYTES) \
     X(PNETCDF_VAR_SLOWEST_RANK) \
     X(PNETCDF_VAR_SLOWEST_RANK_BYTES) \
+    /* bytes of nonblocking reads/writes completed by wait operations */\
+    X(PNETCDF_VAR_NB_WAIT_BYTES_READ) \
+    X(PNETCDF_VAR_NB_WAIT_BYTES_WRITTEN) \
+    /* max number of nonblocking requests pending at once */\
+    X(PNETCDF_VAR_NB_MAX_PENDING) \
     /* end of counters*/\
     X(PNETCDF_VAR_NUM_INDICES)
 
@@ -271,6 +282,9 @@
     /* NOTE: for shared records only */\
     X(PNETCDF_VAR_F_VARIANCE_RANK_TIME) \
     X(PNETCDF_VAR_F_VARIANCE_RANK_BYTES) \
+    /* share of wait time spent completing nonblocking reads/writes */\
+    X(PNETCDF_VAR_F_NB_READ_WAIT_TIME) \
+    X(PNETCDF_VAR_F_NB_WRITE_WAIT_TIME) \
     /* end of counters*/\
     X(PNETCDF_VAR_F_NUM_INDICES)
 
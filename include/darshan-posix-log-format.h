@@ -7,7 +7,7 @@
 #define __DARSHAN_POSIX_LOG_FORMAT_H
 
 /* current POSIX log format version */
-#define DARSHAN_POSIX_VER 4
+#define DARSHAN_POSIX_VER 8
 
 #define POSIX_COUNTERS \
     /* count of posix opens (INCLUDING fileno and dup operations) */\
@@ -113,6 +113,78 @@
     X(POSIX_FASTEST_RANK_BYTES) \
     X(POSIX_SLOWEST_RANK) \
     X(POSIX_SLOWEST_RANK_BYTES) \
+    /* count of reads/writes completed through asynchronous interfaces */\
+    X(POSIX_AIO_READS) \
+    X(POSIX_AIO_WRITES) \
+    /* count of asynchronous reads/writes issued to O_DIRECT descriptors */\
+    X(POSIX_AIO_DIRECT_READS) \
+    X(POSIX_AIO_DIRECT_WRITES) \
+    /* NOTE: the access pattern histograms below are only collected if \
+     * DARSHAN_POSIX_ACCESS_PATTERNS is set, and are -1 otherwise */\
+    /* histogram of the signed distance from the end of the previous access \
+     * to the start of each read/write, in power of 16 buckets; BACK buckets \
+     * are for accesses that start before the end of the previous access */\
+    X(POSIX_DELTA_BACK_4G_PLUS) \
+    X(POSIX_DELTA_BACK_256M_4G) \
+    X(POSIX_DELTA_BACK_16M_256M) \
+    X(POSIX_DELTA_BACK_1M_16M) \
+    X(POSIX_DELTA_BACK_64K_1M) \
+    X(POSIX_DELTA_BACK_4K_64K) \
+    X(POSIX_DELTA_BACK_0_4K) \
+    X(POSIX_DELTA_ZERO) \
+    X(POSIX_DELTA_FWD_0_4K) \
+    X(POSIX_DELTA_FWD_4K_64K) \
+    X(POSIX_DELTA_FWD_64K_1M) \
+    X(POSIX_DELTA_FWD_1M_16M) \
+    X(POSIX_DELTA_FWD_16M_256M) \
+    X(POSIX_DELTA_FWD_256M_4G) \
+    X(POSIX_DELTA_FWD_4G_PLUS) \
+    /* histogram of reuse distances: the number of accesses since the most \
+     * recent one that touched any of the same bytes, looking back at most \
+     * POSIX_REUSE_WINDOW accesses */\
+    X(POSIX_REUSE_1) \
+    X(POSIX_REUSE_2_3) \
+    X(POSIX_REUSE_4_7) \
+    X(POSIX_REUSE_8_16) \
+    /* count of posix_fadvise calls, of those with POSIX_FADV_DONTNEED, \
+     * and bytes covered by them */\
+    X(POSIX_FADVISES) \
+    X(POSIX_FADVISE_DONTNEEDS) \
+    X(POSIX_FADVISE_BYTES) \
+    /* count of madvise calls on mappings of the file and bytes covered */\
+    X(POSIX_MADVISES) \
+    X(POSIX_MADVISE_BYTES) \
+    /* count of readahead calls and bytes requested */\
+    X(POSIX_READAHEADS) \
+    X(POSIX_READAHEAD_BYTES) \
+    /* count of fallocate/posix_fallocate calls and bytes covered */\
+    X(POSIX_FALLOCATES) \
+    X(POSIX_FALLOCATE_BYTES) \
+    /* count of truncate/ftruncate calls, and of those truncating to 0 */\
+    X(POSIX_TRUNCATES) \
+    X(POSIX_TRUNCATES_TO_ZERO) \
+    /* count of sync_file_range calls and bytes covered */\
+    X(POSIX_SYNC_FILE_RANGES) \
+    X(POSIX_SYNC_FILE_RANGE_BYTES) \
+    /* count of opens with O_DIRECT, O_SYNC, O_DSYNC (but not O_SYNC), \
+     * O_APPEND, O_TRUNC, and O_CREAT */\
+    X(POSIX_OPENS_DIRECT) \
+    X(POSIX_OPENS_SYNC) \
+    X(POSIX_OPENS_DSYNC) \
+    X(POSIX_OPENS_APPEND) \
+    X(POSIX_OPENS_TRUNC) \
+    X(POSIX_OPENS_CREAT) \
+    /* count of fcntl(F_SETFL) calls changing the file status flags */\
+    X(POSIX_SETFLS) \
+    /* count of reads and writes while the file was in O_DIRECT mode */\
+    X(POSIX_DIRECT_READS) \
+    X(POSIX_DIRECT_WRITES) \
+    /* count of O_DIRECT reads and writes with a buffer, offset, or \
+     * length not aligned to POSIX_DIRECT_ALIGNMENT, and of O_DIRECT \
+     * reads and writes that failed with EINVAL */\
+    X(POSIX_DIRECT_UNALIGNED_READS) \
+    X(POSIX_DIRECT_UNALIGNED_WRITES) \
+    X(POSIX_DIRECT_FAILURES) \
     /* end of counters */\
     X(POSIX_NUM_INDICES)
 
@@ -150,9 +222,23 @@
     /* NOTE: for shared records only */\
     X(POSIX_F_VARIANCE_RANK_TIME) \
     X(POSIX_F_VARIANCE_RANK_BYTES) \
+    /* cumulative time spent in page cache hint and space management calls */\
+    X(POSIX_F_FADVISE_TIME) \
+    X(POSIX_F_MADVISE_TIME) \
+    X(POSIX_F_READAHEAD_TIME) \
+    X(POSIX_F_FALLOCATE_TIME) \
+    X(POSIX_F_TRUNCATE_TIME) \
+    X(POSIX_F_SYNC_FILE_RANGE_TIME) \
     /* end of counters */\
     X(POSIX_F_NUM_INDICES)
 
+/* number of preceding accesses searched for POSIX_REUSE_* */
+#define POSIX_REUSE_WINDOW 16
+/* alignment, in bytes, that O_DIRECT reads and writes are checked against;
+ * the logical block size required by most devices
+ */
+#define POSIX_DIRECT_ALIGNMENT 512
+
 #define X(a) a,
 /* integer statistics for POSIX file records */
 enum darshan_posix_indices
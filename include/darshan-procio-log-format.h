@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_PROCIO_LOG_FORMAT_H
+#define __DARSHAN_PROCIO_LOG_FORMAT_H
+
+/* current PROCIO log format version */
+#define DARSHAN_PROCIO_VER 1
+
+/* NOTE: all integer counters other than PROCIO_SAMPLES and PROCIO_PROCS are
+ * deltas between the /proc/self/io (and /proc/self/stat) snapshots taken at
+ * Darshan initialization and shutdown time.  Counters that could not be
+ * captured on a given system are set to -1.
+ */
+#define PROCIO_COUNTERS \
+    /* bytes passed to read-style system calls (includes page cache hits) */\
+    X(PROCIO_RCHAR) \
+    /* bytes passed to write-style system calls */\
+    X(PROCIO_WCHAR) \
+    /* count of read-style system calls */\
+    X(PROCIO_SYSCR) \
+    /* count of write-style system calls */\
+    X(PROCIO_SYSCW) \
+    /* bytes actually fetched from the storage layer */\
+    X(PROCIO_READ_BYTES) \
+    /* bytes sent to the storage layer (page cache write-back) */\
+    X(PROCIO_WRITE_BYTES) \
+    /* dirty bytes discarded before write-back (e.g., truncation) */\
+    X(PROCIO_CANCELLED_WRITE_BYTES) \
+    /* clock ticks spent waiting on block I/O (delayacct_blkio_ticks) */\
+    X(PROCIO_IOWAIT_TICKS) \
+    /* clock ticks per second on the system, for converting iowait ticks */\
+    X(PROCIO_CLK_TCK) \
+    /* number of /proc/self/io snapshots taken */\
+    X(PROCIO_SAMPLES) \
+    /* number of processes that contributed to this record */\
+    X(PROCIO_PROCS) \
+    /* end of counters */\
+    X(PROCIO_NUM_INDICES)
+
+#define PROCIO_F_COUNTERS \
+    /* timestamp of the initial snapshot */\
+    X(PROCIO_F_START_TIMESTAMP) \
+    /* timestamp of the final snapshot */\
+    X(PROCIO_F_END_TIMESTAMP) \
+    /* lowest page cache read hit ratio observed over any sampling interval */\
+    X(PROCIO_F_MIN_INTERVAL_HIT_RATIO) \
+    /* end of counters */\
+    X(PROCIO_F_NUM_INDICES)
+
+#define X(a) a,
+/* integer counters for the PROCIO module */
+enum darshan_procio_indices
+{
+    PROCIO_COUNTERS
+};
+
+/* floating point counters for the PROCIO module */
+enum darshan_procio_f_indices
+{
+    PROCIO_F_COUNTERS
+};
+#undef X
+
+/* the darshan_procio_record structure holds job-level page cache and
+ * storage I/O statistics as reported by the Linux kernel for each process.
+ * A single record is stored per log, reduced across all ranks:
+ *      - a darshan_base_record structure, which contains the record id & rank
+ *      - integer counters (byte and system call deltas, iowait ticks)
+ *      - floating point counters (timestamps, interval hit ratio)
+ */
+struct darshan_procio_record
+{
+    struct darshan_base_record base_rec;
+    int64_t counters[PROCIO_NUM_INDICES];
+    double fcounters[PROCIO_F_NUM_INDICES];
+};
+
+#endif /* __DARSHAN_PROCIO_LOG_FORMAT_H */
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 University of Chicago.
+ * See COPYRIGHT notice in top-level directory.
+ *
+ */
+
+#ifndef __DARSHAN_SNAPSHOT_LOG_FORMAT_H
+#define __DARSHAN_SNAPSHOT_LOG_FORMAT_H
+
+/* current SNAPSHOT log format version */
+#define DARSHAN_SNAPSHOT_VER 1
+
+/* counters that may be captured in each snapshot; which of them are
+ * captured is selected at runtime (see counter_mask below)
+ */
+#define SNAPSHOT_COUNTERS \
+    /* opens (including creat, mkstemp, fopen and friends) */\
+    X(SNAPSHOT_OPENS) \
+    /* stat, lstat, fstat and friends */\
+    X(SNAPSHOT_STATS) \
+    /* fsync and fdatasync (POSIX) or fflush (STDIO) */\
+    X(SNAPSHOT_FSYNCS) \
+    /* seeks */\
+    X(SNAPSHOT_SEEKS) \
+    /* read operations */\
+    X(SNAPSHOT_READS) \
+    /* write operations */\
+    X(SNAPSHOT_WRITES) \
+    /* bytes read */\
+    X(SNAPSHOT_BYTES_READ) \
+    /* bytes written */\
+    X(SNAPSHOT_BYTES_WRITTEN) \
+    /* end of counters */\
+    X(SNAPSHOT_NUM_INDICES)
+
+#define X(a) a,
+/* counters that may be captured by the SNAPSHOT module */
+enum darshan_snapshot_indices
+{
+    SNAPSHOT_COUNTERS
+};
+#undef X
+
+/* record structure for a per-rank time series of counter snapshots.  There
+ * is one per rank for each module that registers snapshots.  Each snapshot
+ * holds the change in the captured counters over one interval; intervals
+ * with no activity are not stored.  Each record is variable size according
+ * to the nsnapshots field and the number of captured counters.
+ */
+struct darshan_snapshot_record
+{
+    struct darshan_base_record base_rec;
+    double  interval_seconds; /* time duration of each snapshot interval */
+    int64_t counter_mask;     /* bit i is set if counter i is captured */
+    int64_t nsnapshots;       /* number of snapshots */
+    int64_t dropped;          /* number of earlier snapshots lost when the ring wrapped */
+    double  *times;           /* pointer to interval start time array (trails struct in log) */
+    int64_t *deltas;          /* pointer to nsnapshots x captured counters array of
+                               * counter deltas, one row per snapshot (trails time
+                               * array in log) */
+};
+
+#endif /* __DARSHAN_SNAPSHOT_LOG_FORMAT_H */
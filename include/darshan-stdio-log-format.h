@@ -8,7 +8,7 @@
 #define __DARSHAN_STDIO_LOG_FORMAT_H
 
 /* current log format version, to support backwards compatibility */
-#define DARSHAN_STDIO_VER 2
+#define DARSHAN_STDIO_VER 3
 
 #define STDIO_COUNTERS \
     /* count of fopens (INCLUDING fdopen operations)  */\
@@ -36,6 +36,16 @@
     X(STDIO_FASTEST_RANK_BYTES) \
     X(STDIO_SLOWEST_RANK) \
     X(STDIO_SLOWEST_RANK_BYTES) \
+    /* count of setvbuf/setbuf/setbuffer/setlinebuf calls */\
+    X(STDIO_SETVBUFS) \
+    /* buffering mode of the stream (see STDIO_BUF_MODE_* below) */\
+    X(STDIO_BUF_MODE) \
+    /* size of the stream buffer in bytes */\
+    X(STDIO_BUF_SIZE) \
+    /* estimated number of read/write system calls issued by the stdio */\
+    /* library on behalf of the stream (-1 if unknown) */\
+    X(STDIO_POSIX_READS) \
+    X(STDIO_POSIX_WRITES) \
     /* end of counters */\
     X(STDIO_NUM_INDICES)
 
@@ -72,6 +82,14 @@
     /* end of counters */\
     X(STDIO_F_NUM_INDICES)
 
+/* values for the STDIO_BUF_MODE counter; larger values are more restrictive,
+ * so the most restrictive mode observed is retained when records are combined
+ */
+#define STDIO_BUF_MODE_UNKNOWN 0
+#define STDIO_BUF_MODE_FULL    1
+#define STDIO_BUF_MODE_LINE    2
+#define STDIO_BUF_MODE_NONE    3
+
 #define X(a) a,
 /* integer counters for the "STDIO" module */
 enum darshan_stdio_indices